@@ -152,6 +152,8 @@ extern "C"{
     #define ETH_43_GMAC_SID_SETCORRECTIONTIME       0x1A
     /*! @brief Service ID of Eth_43_GMAC_SetGlobalTime */
     #define ETH_43_GMAC_SID_SETGLOBALTIME           0x1B
+    /*! @brief Service ID of Eth_43_GMAC_GetTxTimeStampOverflows */
+    #define ETH_43_GMAC_SID_GETTXTIMESTAMPOVERFLOWS 0x5F
 #endif
 
 #if STD_ON == ETH_43_GMAC_GET_TXSTATS_API
@@ -886,6 +888,24 @@ Std_ReturnType Eth_43_GMAC_GetIngressTimeStamp ( \
                                 Eth_TimeStampQualType *TimeQualPtr, \
                                 Eth_TimeStampType *TimeStampPtr \
                                              );
+
+/**
+* @brief         Reads the number of egress time stamps lost on a Tx FIFO.
+* @details       A time stamp is lost when it is overwritten in the full time stamp queue
+*                before being read back by Eth_43_GMAC_GetEgressTimeStamp().
+* @api
+* @param[in]     CtrlIdx Index of the controller.
+* @param[in]     FifoIdx Index of the Tx FIFO.
+* @param[out]    OverflowsPtr Number of the lost time stamps since the initialization.
+* @return        Error status
+* @retval        E_OK: the number was read.
+* @retval        E_NOT_OK: development error was detected.
+*/
+Std_ReturnType Eth_43_GMAC_GetTxTimeStampOverflows ( \
+                                uint8 CtrlIdx, \
+                                uint8 FifoIdx, \
+                                uint32 *OverflowsPtr \
+                                                 );
 /**
 * @brief         Returns a time value out of the HW registers according to the capability of the HW.
 * @note          If the hardware timestamp timer's resolution is lower than the Eth_TimeStampType
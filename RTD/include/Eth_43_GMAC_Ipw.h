@@ -107,6 +107,16 @@ extern const Eth_43_GMAC_Ipw_CtrlConfigType *Eth_43_GMAC_Ipw_apxInternalCfg[ETH_
 /*==================================================================================================
                                        DEFINES AND MACROS
 ==================================================================================================*/
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+/**
+* @brief        Depth of the egress timestamp queue of each Tx FIFO.
+* @details      Bounds the number of timestamped frames confirmed on one FIFO whose timestamps
+*               were not read back yet. The oldest entry is overwritten on overflow. Must be below 255.
+*/
+#ifndef ETH_43_GMAC_IPW_TX_TS_QUEUE_LEN
+#define ETH_43_GMAC_IPW_TX_TS_QUEUE_LEN         (8U)
+#endif
+#endif
 
 /*==================================================================================================
                                              ENUMS
@@ -323,11 +333,21 @@ extern void Eth_43_GMAC_Ipw_GetEgressTimeStamp  ( \
 
 extern void Eth_43_GMAC_Ipw_GetIngressTimeStamp ( \
                                         const uint8 CtrlIdx, \
-                                        const uint8 FifoIdx, \
                                         const uint8 *FrameData, \
                                         Eth_TimeStampQualType *TimeQual, \
                                         Eth_TimeStampType *TimeStamp \
                                         );
+
+/**
+* @brief        Returns the number of egress timestamps lost on the given Tx FIFO.
+* @details      A timestamp is lost when it is overwritten in the full queue before being read back.
+* @param[in]    CtrlIdx Index of the controller
+* @param[in]    FifoIdx Index of the Tx FIFO
+*/
+extern uint32 Eth_43_GMAC_Ipw_GetTxTimeStampOverflows ( \
+                                        const uint8 CtrlIdx, \
+                                        const uint8 FifoIdx \
+                                        );
 #endif
 
 #if (STD_ON == ETH_43_GMAC_DEM_EVENT_DETECT)
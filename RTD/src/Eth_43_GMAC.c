@@ -1360,13 +1360,12 @@ Std_ReturnType Eth_43_GMAC_GetIngressTimeStamp ( \
                                        )
 
 {
-    const Eth_43_GMAC_CtrlCfgType *Eth_43_GMAC_Controller = NULL_PTR;
     const uint8 *FrameData;
-    uint8 FifoIdx;
     Std_ReturnType ReturnStatus = (Std_ReturnType)E_NOT_OK;
-    uint32 PartitionId = Eth_43_GMAC_GetUserID();
 
 #if STD_ON == ETH_43_GMAC_DEV_ERROR_DETECT
+    uint32 PartitionId = Eth_43_GMAC_GetUserID();
+
     if ((Std_ReturnType)E_OK == Eth_43_GMAC_Local_CheckEthHLDEntry(PartitionId, CtrlIdx, ETH_43_GMAC_SID_GETINGRESSTIMESTAMP))
     {
         if ((NULL_PTR == DataPtr) || (NULL_PTR == TimeQualPtr) || (NULL_PTR == TimeStampPtr))
@@ -1381,18 +1380,8 @@ Std_ReturnType Eth_43_GMAC_GetIngressTimeStamp ( \
             /* Move the pointer back to the position of the frame header (note the index sign) */
             FrameData = (const uint8 *)(FrameData - (const uint8 *)ETH_43_GMAC_FRAME_PAYLOAD_OFFSET);
 
-            Eth_43_GMAC_Controller = Eth_43_GMAC_apxInternalCfg[PartitionId]->Eth_43_GMAC_apCtrlConfig[CtrlIdx];
-
             *TimeQualPtr = ETH_UNCERTAIN;
-
-            for ( \
-                 FifoIdx = 0U; \
-                 (FifoIdx < Eth_43_GMAC_Controller->Eth_43_GMAC_pIngressConfig->FifoCount) && (*TimeQualPtr == ETH_UNCERTAIN); \
-                 ++FifoIdx \
-                )
-            {
-                Eth_43_GMAC_Ipw_GetIngressTimeStamp(CtrlIdx, FifoIdx, FrameData, TimeQualPtr, TimeStampPtr);
-            }
+            Eth_43_GMAC_Ipw_GetIngressTimeStamp(CtrlIdx, FrameData, TimeQualPtr, TimeStampPtr);
 
             if (ETH_VALID == *TimeQualPtr)
             {
@@ -1405,6 +1394,41 @@ Std_ReturnType Eth_43_GMAC_GetIngressTimeStamp ( \
 
     return ReturnStatus;
 }
+
+/*================================================================================================*/
+Std_ReturnType Eth_43_GMAC_GetTxTimeStampOverflows ( \
+                                uint8 CtrlIdx, \
+                                uint8 FifoIdx, \
+                                uint32 *OverflowsPtr \
+                                                 )
+{
+    Std_ReturnType ReturnStatus = (Std_ReturnType)E_NOT_OK;
+
+#if STD_ON == ETH_43_GMAC_DEV_ERROR_DETECT
+    uint32 PartitionId = Eth_43_GMAC_GetUserID();
+
+    if ((Std_ReturnType)E_OK == Eth_43_GMAC_Local_CheckEthHLDEntry(PartitionId, CtrlIdx, ETH_43_GMAC_SID_GETTXTIMESTAMPOVERFLOWS))
+    {
+        if (FifoIdx >= Eth_43_GMAC_apxInternalCfg[PartitionId]->Eth_43_GMAC_apCtrlConfig[CtrlIdx]->Eth_43_GMAC_pEgressConfig->FifoCount)
+        {
+            (void)Det_ReportError(ETH_43_GMAC_MODULE_ID, ETH_43_GMAC_DRIVER_INSTANCE, ETH_43_GMAC_SID_GETTXTIMESTAMPOVERFLOWS, ETH_43_GMAC_E_INV_PARAM);
+        }
+        else if (NULL_PTR == OverflowsPtr)
+        {
+            (void)Det_ReportError(ETH_43_GMAC_MODULE_ID, ETH_43_GMAC_DRIVER_INSTANCE, ETH_43_GMAC_SID_GETTXTIMESTAMPOVERFLOWS, ETH_43_GMAC_E_PARAM_POINTER);
+        }
+        else
+        {
+#endif /* ETH_43_GMAC_DEV_ERROR_DETECT  */
+            *OverflowsPtr = Eth_43_GMAC_Ipw_GetTxTimeStampOverflows(CtrlIdx, FifoIdx);
+            ReturnStatus = (Std_ReturnType)E_OK;
+#if STD_ON == ETH_43_GMAC_DEV_ERROR_DETECT
+        }
+    }
+#endif /* ETH_43_GMAC_DEV_ERROR_DETECT  */
+
+    return ReturnStatus;
+}
 #endif /* ETH_43_GMAC_GLOBAL_TIME_API */
 
 /*================================================================================================*/
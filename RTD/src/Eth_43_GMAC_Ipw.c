@@ -109,7 +109,23 @@ extern "C"{
 /*==================================================================================================
 *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
 ==================================================================================================*/
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+/** @brief Egress timestamp of one confirmed frame, tagged with the buffer index it belongs to */
+typedef struct
+{
+    Gmac_Ip_TimestampType Timestamp;
+    Eth_BufIdxType BufIdx;
+    boolean Valid;
+} Eth_43_GMAC_Ipw_TxTsEntryType;
 
+/** @brief Bounded queue of egress timestamps of one Tx FIFO */
+typedef struct
+{
+    Eth_43_GMAC_Ipw_TxTsEntryType Entries[ETH_43_GMAC_IPW_TX_TS_QUEUE_LEN];
+    uint32 Overflows;
+    uint8 Head;
+} Eth_43_GMAC_Ipw_TxTsQueueType;
+#endif
 
 /*==================================================================================================
 *                                       LOCAL MACROS
@@ -123,6 +139,10 @@ extern "C"{
 #define ETH_IPW_IP_EMAC                         (0U)
 #define ETH_IPW_IP_GMAC                         (1U)
 
+/* Egress timestamp slot of a buffer: not requested, requested and not confirmed yet, otherwise queue position + 1 */
+#define ETH_43_GMAC_IPW_TX_TS_SLOT_NONE                 ((uint8)0U)
+#define ETH_43_GMAC_IPW_TX_TS_SLOT_REQUESTED            ((uint8)0xFFU)
+
 /*==================================================================================================
 *                                      LOCAL CONSTANTS
 ==================================================================================================*/
@@ -178,6 +198,15 @@ static Gmac_Ip_RxInfoType Eth_43_GMAC_Ipw_axRxFrameInfo[ETH_43_GMAC_MAX_CTRLIDX_
 /* Make Eth_43_GMAC_Transmit reentrant for different FIFOs so we need (Gmac_Ip_TxInfoType) for each FIFO */
 static Gmac_Ip_TxInfoType Eth_43_GMAC_Ipw_axTxFrameInfo[ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED][ETH_43_GMAC_MAX_TXFIFO_SUPPORTED];
 
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+/* Egress timestamps stay queued per FIFO until read back, so several frames may be confirmed before the first read */
+static Eth_43_GMAC_Ipw_TxTsQueueType Eth_43_GMAC_Ipw_axTxTsQueue[ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED][ETH_43_GMAC_MAX_TXFIFO_SUPPORTED];
+/* Position of the egress timestamp of each buffer in the queue of its FIFO, see ETH_43_GMAC_IPW_TX_TS_SLOT_xxx */
+static uint8 Eth_43_GMAC_Ipw_au8TxTsSlot[ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED][ETH_43_GMAC_MAX_TXFIFO_SUPPORTED * ETH_43_GMAC_MAX_TXBUFF_SUPPORTED];
+/* FIFO of the last received frame, the ingress timestamp is read for that frame within RxIndication */
+static uint8 Eth_43_GMAC_Ipw_au8RxLastFifo[ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED];
+#endif
+
 #define ETH_43_GMAC_STOP_SEC_VAR_CLEARED_UNSPECIFIED
 #include "Eth_43_GMAC_MemMap.h"
 
@@ -238,6 +267,10 @@ static inline boolean Eth_43_GMAC_Ipw_Local_IsOpenFilterPattern(const uint8 *Phy
 static inline boolean Eth_43_GMAC_Ipw_Local_IsCloseFilterPattern(const uint8 *PhyAddr);
 static inline boolean Eth_43_GMAC_Ipw_Local_IsMulticastAddress(const uint8 *PhyAddr);
 #endif
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+static inline void Eth_43_GMAC_Ipw_Local_ResetTxTsQueue(Eth_43_GMAC_Ipw_TxTsQueueType *Queue);
+static inline void Eth_43_GMAC_Ipw_Local_PushTxTimeStamp(const uint8 CtrlIdx, const uint8 FifoIdx, const Eth_BufIdxType BufIdx);
+#endif
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS
 ==================================================================================================*/
@@ -266,6 +299,44 @@ static inline boolean Eth_43_GMAC_Ipw_Local_IsMulticastAddress(const uint8 *PhyA
     return (1U == (PhyAddr[0] & 1U));
 }
 #endif
+
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+static inline void Eth_43_GMAC_Ipw_Local_ResetTxTsQueue(Eth_43_GMAC_Ipw_TxTsQueueType *Queue)
+{
+    uint8 EntryIdx;
+
+    for (EntryIdx = 0U; EntryIdx < ETH_43_GMAC_IPW_TX_TS_QUEUE_LEN; ++EntryIdx)
+    {
+        Queue->Entries[EntryIdx].Valid = FALSE;
+    }
+    Queue->Overflows = 0U;
+    Queue->Head = 0U;
+}
+
+/* Store the egress timestamp of a confirmed frame, the oldest unread entry is overwritten when the queue is full */
+static inline void Eth_43_GMAC_Ipw_Local_PushTxTimeStamp(const uint8 CtrlIdx, const uint8 FifoIdx, const Eth_BufIdxType BufIdx)
+{
+    Eth_43_GMAC_Ipw_TxTsQueueType *Queue = &Eth_43_GMAC_Ipw_axTxTsQueue[CtrlIdx][FifoIdx];
+    Eth_43_GMAC_Ipw_TxTsEntryType *Entry = &Queue->Entries[Queue->Head];
+
+    if (Entry->Valid)
+    {
+        /* The buffer may have been provided and marked again since, its new mark stays */
+        if ((uint8)(Queue->Head + 1U) == Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][Entry->BufIdx])
+        {
+            Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][Entry->BufIdx] = ETH_43_GMAC_IPW_TX_TS_SLOT_NONE;
+        }
+        Queue->Overflows++;
+    }
+
+    Entry->Timestamp = Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].Timestamp;
+    Entry->BufIdx = BufIdx;
+    Entry->Valid = TRUE;
+    Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][BufIdx] = (uint8)(Queue->Head + 1U);
+
+    Queue->Head = (uint8)((Queue->Head + 1U) % ETH_43_GMAC_IPW_TX_TS_QUEUE_LEN);
+}
+#endif
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
@@ -374,6 +445,9 @@ Eth_RxStatusType Eth_43_GMAC_Ipw_ReceiveFrame ( \
         *FrameData   = Eth_43_GMAC_Ipw_axRxFrameBuffer[CtrlIdx][FifoIdx].Data;
         *FrameLength = Eth_43_GMAC_Ipw_axRxFrameInfo[CtrlIdx][FifoIdx].PktLen;
         *FrameHasError = ((0U != Eth_43_GMAC_Ipw_axRxFrameInfo[CtrlIdx][FifoIdx].ErrMask)? ((boolean)TRUE) : ((boolean)FALSE));
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+        Eth_43_GMAC_Ipw_au8RxLastFifo[CtrlIdx] = FifoIdx;
+#endif
 
         RxStatus = ETH_RECEIVED;
 
@@ -634,17 +708,17 @@ void Eth_43_GMAC_Ipw_EnableEgressTimeStamp( \
                                 Eth_BufIdxType BufIdx \
                                      )
 {
-    /* Prevent MISRA, compiler warnings */
-    (void)CtrlIdx;
-    (void)BufIdx;
+    /* The timestamp is queued at the Tx confirmation of the buffer */
+    Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][BufIdx] = ETH_43_GMAC_IPW_TX_TS_SLOT_REQUESTED;
 }
 
 /*================================================================================================*/
 /**
 * @brief        Get values of timer at the time transmit a message.
-* @details      Reads back the egress time stamp on a dedicated message object.
-*               It must be called within the TxConfirmation() function.
+* @details      Reads back the egress time stamp queued for the given buffer and releases the queue entry.
+*               The time stamp is only available when it was enabled for the buffer before the transmission.
 * @param[in]    CtrlIdx Index of controller to be update the filter
+* @param[in]    BufIdx Index of the transmitted buffer
 * @param[out]   TimeQual Quality of HW time stamp, e.g. based on current drift.
 * @param[out]   TimeStamp current time stamp.
 */
@@ -656,38 +730,82 @@ void Eth_43_GMAC_Ipw_GetEgressTimeStamp  ( \
                                  )
 {
     const uint8 FifoIdx = Eth_43_GMAC_axTxBufferIdxMap[CtrlIdx][BufIdx].FifoIdx;
-    if ((0U == Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].Timestamp.seconds) &&
-        (0U == Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].Timestamp.nanoseconds))
-    {
-        *TimeQual= ETH_INVALID;
-    }
-    else
+    const uint8 Slot = Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][BufIdx];
+    Eth_43_GMAC_Ipw_TxTsEntryType *Entry;
+
+    *TimeQual = ETH_INVALID;
+
+    if ((ETH_43_GMAC_IPW_TX_TS_SLOT_NONE != Slot) && (ETH_43_GMAC_IPW_TX_TS_SLOT_REQUESTED != Slot))
     {
-        TimeStamp->nanoseconds = Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].Timestamp.nanoseconds;
-        TimeStamp->seconds     = Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].Timestamp.seconds;
-        TimeStamp->secondsHi   = Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].Timestamp.secondsHi;
+        Entry = &Eth_43_GMAC_Ipw_axTxTsQueue[CtrlIdx][FifoIdx].Entries[Slot - 1U];
 
-        *TimeQual = ETH_VALID;
+        if ((Entry->Valid) && (BufIdx == Entry->BufIdx))
+        {
+            if ((0U != Entry->Timestamp.seconds) || (0U != Entry->Timestamp.nanoseconds))
+            {
+                TimeStamp->nanoseconds = Entry->Timestamp.nanoseconds;
+                TimeStamp->seconds     = Entry->Timestamp.seconds;
+                TimeStamp->secondsHi   = Entry->Timestamp.secondsHi;
+
+                *TimeQual = ETH_VALID;
+            }
+
+            /* Each time stamp is read back once */
+            Entry->Valid = FALSE;
+        }
+
+        Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][BufIdx] = ETH_43_GMAC_IPW_TX_TS_SLOT_NONE;
     }
 }
 
+/*================================================================================================*/
+/**
+* @brief        Returns the number of egress timestamps lost on the given Tx FIFO.
+* @details      A timestamp is lost when it is overwritten in the full queue before being read back.
+* @param[in]    CtrlIdx Index of the controller
+* @param[in]    FifoIdx Index of the Tx FIFO
+*/
+uint32 Eth_43_GMAC_Ipw_GetTxTimeStampOverflows ( \
+                                    const uint8 CtrlIdx, \
+                                    const uint8 FifoIdx \
+                                 )
+{
+    return Eth_43_GMAC_Ipw_axTxTsQueue[CtrlIdx][FifoIdx].Overflows;
+}
+
 /*================================================================================================*/
 /**
 * @brief        Get values of timer at the time receive a message.
 * @details      Reads back the ingress time stamp on a dedicated message object.
-*               It must be called within the RxIndication() function.
+*               It must be called within the RxIndication() function. The FIFO of the last
+*               received frame is checked first, the other FIFOs only when the frame is not found there.
 * @param[in]    CtrlIdx Index of controller to be update the filter
+* @param[in]    FrameData Pointer to the received frame data
 * @param[out]   TimeQualPtr Quality of HW time stamp, e.g. based on current drift.
 * @param[out]   TimeStampPtr current time stamp.
 */
 void Eth_43_GMAC_Ipw_GetIngressTimeStamp ( \
                                     const uint8 CtrlIdx, \
-                                    const uint8 FifoIdx, \
                                     const uint8 *FrameData, \
                                     Eth_TimeStampQualType *TimeQual, \
                                     Eth_TimeStampType *TimeStamp \
                                  )
 {
+    uint8 FifoIdx = Eth_43_GMAC_Ipw_au8RxLastFifo[CtrlIdx];
+    uint8 Counter;
+
+    if (FrameData != Eth_43_GMAC_Ipw_axRxFrameBuffer[CtrlIdx][FifoIdx].Data)
+    {
+        for (Counter = 0U; Counter < ETH_43_GMAC_MAX_RXFIFO_SUPPORTED; ++Counter)
+        {
+            if (FrameData == Eth_43_GMAC_Ipw_axRxFrameBuffer[CtrlIdx][Counter].Data)
+            {
+                FifoIdx = Counter;
+                break;
+            }
+        }
+    }
+
     if (FrameData == Eth_43_GMAC_Ipw_axRxFrameBuffer[CtrlIdx][FifoIdx].Data)
     {
         if ((0U == Eth_43_GMAC_Ipw_axRxFrameInfo[CtrlIdx][FifoIdx].Timestamp.seconds) &&
@@ -812,6 +930,18 @@ Std_ReturnType Eth_43_GMAC_Ipw_ConfigureController  ( \
         Eth_43_GMAC_Ipw_axRxFrameBuffer[CtrlIdx][Counter].Data = NULL_PTR;
     }
 
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+    Eth_43_GMAC_Ipw_au8RxLastFifo[CtrlIdx] = 0U;
+    for (Counter = 0U; Counter < ETH_43_GMAC_MAX_TXFIFO_SUPPORTED; ++Counter)
+    {
+        Eth_43_GMAC_Ipw_Local_ResetTxTsQueue(&Eth_43_GMAC_Ipw_axTxTsQueue[CtrlIdx][Counter]);
+    }
+    for (Counter = 0U; Counter < (ETH_43_GMAC_MAX_TXFIFO_SUPPORTED * ETH_43_GMAC_MAX_TXBUFF_SUPPORTED); ++Counter)
+    {
+        Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][Counter] = ETH_43_GMAC_IPW_TX_TS_SLOT_NONE;
+    }
+#endif
+
     Eth_43_GMAC_Ipw_axFirstTxBufferIdxInFifo[CtrlIdx][0U] = 0U;
 #if (ETH_43_GMAC_MAX_TXFIFO_SUPPORTED > 1U)
     for (Counter = 1U; Counter < IpwCtrlCfg->Eth_43_GMAC_Ipw_pGmacCtrlConfig->Gmac_pCtrlConfig->TxRingCount; ++Counter)
@@ -954,6 +1084,10 @@ BufReq_ReturnType Eth_43_GMAC_Ipw_ProvideTxBuffer (  \
     if (GMAC_STATUS_SUCCESS == Status)
     {
         *BufferIdx = Eth_43_GMAC_Ipw_axFirstTxBufferIdxInFifo[CtrlIdx][FifoIdx] + BufferIdxWithinFifo;
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+        /* A stale timestamp of the previous user of the buffer must not be returned */
+        Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][*BufferIdx] = ETH_43_GMAC_IPW_TX_TS_SLOT_NONE;
+#endif
 
         /* In case internal buffers are enabled on all controllers, assign the data buffer address returned from the driver.*/
         #if (STD_OFF == ETH_43_GMAC_HAS_EXTERNAL_TX_BUFFERS)
@@ -1035,6 +1169,9 @@ BufReq_ReturnType Eth_43_GMAC_Ipw_ProvideTxMultiBuffer( const uint8 u8CtrlIdx, \
     {
         /* Generate a unique buffer id */
         *pBufferIdx = Eth_43_GMAC_Ipw_axFirstTxBufferIdxInFifo[u8CtrlIdx][u8FifoIdx] + u16BufferIdxWithinFifo;
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+        Eth_43_GMAC_Ipw_au8TxTsSlot[u8CtrlIdx][*pBufferIdx] = ETH_43_GMAC_IPW_TX_TS_SLOT_NONE;
+#endif
     }
 
     switch (status)
@@ -1467,10 +1604,17 @@ void Eth_43_GMAC_Ipw_ReportTransmission(
 #endif
             if (GMAC_STATUS_SUCCESS == GmacStatus)
             {
+                BufIdx   = (Eth_BufIdxType)((sint32)(Iter - Eth_43_GMAC_axTxBufferIdxMap[CtrlIdx]));
+#if (STD_ON == ETH_43_GMAC_GLOBAL_TIME_API)
+                /* Queue the egress timestamp before the confirmation, so it can be read back from within it */
+                if (ETH_43_GMAC_IPW_TX_TS_SLOT_REQUESTED == Eth_43_GMAC_Ipw_au8TxTsSlot[CtrlIdx][BufIdx])
+                {
+                    Eth_43_GMAC_Ipw_Local_PushTxTimeStamp(CtrlIdx, FifoIdx, BufIdx);
+                }
+#endif
                 /*If the frame was successfully transmitted call the TxConfirmation in case this option is enabled for it*/
                 if (Iter->bTxConfirmation)
                 {
-                    BufIdx   = (Eth_BufIdxType)((sint32)(Iter - Eth_43_GMAC_axTxBufferIdxMap[CtrlIdx]));
                     FrameHasError = ((0U == Eth_43_GMAC_Ipw_axTxFrameInfo[CtrlIdx][FifoIdx].ErrMask)? ((boolean)FALSE) : ((boolean)TRUE));
                     TxResult = ((FALSE == FrameHasError)? ((Std_ReturnType)E_OK) : ((Std_ReturnType)E_NOT_OK));
 
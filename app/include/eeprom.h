@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef EEPROM_H
+#define EEPROM_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Period of EEPROM_Task [ms]. */
+#define NVM_POLL_PERIOD_MS              (5u)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes all components necessary for
+ *                  simulated EEPROM in data flash.
+ *
+ * @details         This function prepares cache data entries, enables MemmAcc
+ *                  and Fee and loads the newest valid journal record.
+*/
+void EEPROM_Init(void);
+
+/*!
+ * @brief           Task executing the queued EEPROM reads and writes.
+ *
+ * @details         To be run every NVM_POLL_PERIOD_MS.
+*/
+void EEPROM_Task(void);
+
+/*!
+ * @brief           Callback function for EEPROM write.
+*/
+uint8_t EEPROM_Write_CB(uint8_t u8PdelayMachine,
+                        gptp_def_nvm_data_t eNvmDataType,
+                        float64_t f64Value,
+                        gptp_def_mem_write_stat *peWriteStat);
+
+/*!
+ * @brief           Callback function for EEPROM read.
+*/
+uint8_t EEPROM_Read_CB(uint8_t u8PdelayMachine,
+                       gptp_def_nvm_data_t eNvmDataType,
+                       float64_t *f64Value);
+
+/*!
+ * @brief           Callback function for asynchronous EEPROM read.
+ *
+ * @details         The read is queued and serviced by EEPROM_Task, the
+ *                  gPTP stack runs with the default values meanwhile.
+*/
+uint8_t EEPROM_Read_Req_CB(uint8_t u8PdelayMachine,
+                           gptp_def_nvm_data_t eNvmDataType);
+
+/*******************************************************************************
+ * Guard End
+ ******************************************************************************/
+
+#endif /* EEPROM_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
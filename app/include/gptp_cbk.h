@@ -101,6 +101,21 @@ uint8_t GPTP_NVMReadCB(uint8_t u8PdelayMachine,
                        gptp_def_nvm_data_t eNvmDataType, 
                        float64_t *pf64Value);
 
+/*!
+ * @brief           This functions requests data from the NVM.
+ *
+ * @details         This function is an example of callback which is called
+ *                  from gPTP stack directly. The data is delivered later
+ *                  by GPTP_NvmReadDone.
+ *
+ * @param[in]       u8PdelayMachine PDelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ *
+ * @return          Error status.
+*/
+uint8_t GPTP_NVMReadReqCB(uint8_t u8PdelayMachine,
+                          gptp_def_nvm_data_t eNvmDataType);
+
 /*!
  * @brief           This functions occurs when new error in gPTP stack
  *                  is registered.
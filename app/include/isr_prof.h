@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef ISR_PROF_H
+#define ISR_PROF_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+#include "gptp_port_platform.h"
+#include "sched.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Maximal count of the profiled stages, the scheduler tasks. */
+#ifndef ISR_PROF_STAGES_MAX
+#define ISR_PROF_STAGES_MAX             (8u)
+#endif /* ISR_PROF_STAGES_MAX */
+
+/*! @brief Stage index reading the whole main loop pass. */
+#define ISR_PROF_STAGE_TOTAL            (0xFFu)
+
+/*! @brief Count of the histogram bins. */
+#define ISR_PROF_HIST_BINS              (16u)
+
+/*! @brief Upper bound of the first histogram bin as power of two, each next
+           bin doubles it [cycles]. */
+#define ISR_PROF_HIST_FIRST_SHIFT       (8u)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Execution time statistics of a stage.
+ */
+typedef struct
+{
+    /*! Name of the stage, NULL for the whole pass. */
+    const char                          *cpcName;
+    /*! Count of the stage executions. */
+    uint32_t                            u32Count;
+    /*! Minimal, average and maximal execution time [cycles]. */
+    uint32_t                            u32MinCycles;
+    uint32_t                            u32AvgCycles;
+    uint32_t                            u32MaxCycles;
+    /*! Count of the executions per bin, bin i holds the times below
+        2^(ISR_PROF_HIST_FIRST_SHIFT + i) cycles not counted by the previous
+        bins, the last bin is not bounded. */
+    uint32_t                            au32Hist[ISR_PROF_HIST_BINS];
+}isr_prof_stats_t;
+
+/*!
+ * @brief Overrun statistics of the main loop passes.
+ */
+typedef struct
+{
+    /*! Count of the profiled passes. */
+    uint32_t                            u32Ticks;
+    /*! Count of the passes longer than the period. */
+    uint32_t                            u32Overruns;
+    /*! Pass number of the last overrun. */
+    uint32_t                            u32LastOverrunTick;
+    /*! Period of the scheduler tick [cycles]. */
+    uint32_t                            u32PeriodCycles;
+}isr_prof_overrun_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes the profiler.
+ *
+ * @details         Starts the cycle counter and clears all the statistics.
+ *                  The stages are the scheduler tasks, named by the task
+ *                  configuration.
+ *
+ * @param[in]       cprTasks Pointer to the tasks passed to SCHED_Init, must
+ *                  stay valid.
+ * @param[in]       u8TaskCount Count of the tasks, at most ISR_PROF_STAGES_MAX
+ *                  are profiled.
+ * @param[in]       u32PeriodCycles Period of the scheduler tick [cycles].
+*/
+void ISR_PROF_Init(const sched_task_t *cprTasks,
+                   uint8_t u8TaskCount,
+                   uint32_t u32PeriodCycles);
+
+/*!
+ * @brief           This function starts the profiled main loop pass.
+ *
+ * @details         Called from the main loop before the first SCHED_Run of
+ *                  the pass. Applies the pending reset.
+*/
+void ISR_PROF_TickStart(void);
+
+/*!
+ * @brief           This function ends the profiled stage.
+ *
+ * @details         Called after every SCHED_Run of the pass with the index of
+ *                  the task run. The stage lasted from the previous stage end
+ *                  or the pass start. SCHED_TASK_NONE is not profiled.
+ *
+ * @param[in]       u8Stage Stage index.
+*/
+void ISR_PROF_StageEnd(uint8_t u8Stage);
+
+/*!
+ * @brief           This function ends the profiled main loop pass.
+ *
+ * @details         Called from the main loop after the last SCHED_Run of
+ *                  the pass. Counts an overrun in case the pass is longer
+ *                  than the period and publishes the statistics for
+ *                  the readers.
+ *
+ * @return          true in case the pass overran the period.
+*/
+bool ISR_PROF_TickEnd(void);
+
+/*!
+ * @brief           This function reads the stage statistics.
+ *
+ * @details         Provides the statistics published by the last
+ *                  ISR_PROF_TickEnd. Safe to call from a task, i.e. inside
+ *                  the pass, or from an interrupt, never waits.
+ *
+ * @param[in]       u8Stage Stage index or ISR_PROF_STAGE_TOTAL.
+ * @param[out]      prStats Pointer to the statistics placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The statistics were provided.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_API_ILLEGAL_PORT_NUM: Unknown stage.
+*/
+gptp_err_type_t ISR_PROF_Read(uint8_t u8Stage,
+                              isr_prof_stats_t *prStats);
+
+/*!
+ * @brief           This function reads the overrun statistics.
+ *
+ * @details         Provides the statistics published by the last
+ *                  ISR_PROF_TickEnd, callable from any context.
+ *
+ * @param[out]      prOverrun Pointer to the statistics placeholder.
+*/
+void ISR_PROF_OverrunRead(isr_prof_overrun_t *prOverrun);
+
+/*!
+ * @brief           This function resets all the statistics.
+ *
+ * @details         The reset is applied at the next pass start and published
+ *                  at its end, so it is safe to call from any context.
+*/
+void ISR_PROF_Reset(void);
+
+/*******************************************************************************
+ * Guard End
+ ******************************************************************************/
+
+#endif /* ISR_PROF_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef SCHED_H
+#define SCHED_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+#include "gptp_port_platform.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Maximal count of the scheduled tasks. */
+#ifndef SCHED_TASKS_MAX
+#define SCHED_TASKS_MAX                 (8u)
+#endif /* SCHED_TASKS_MAX */
+
+/*! @brief No task was run. */
+#define SCHED_TASK_NONE                 (0xFFu)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Task function, runs to completion.
+ */
+typedef void (*sched_task_fn_t)(void);
+
+/*!
+ * @brief Task configuration.
+ */
+typedef struct
+{
+    /*! Name of the task. */
+    const char                          *cpcName;
+    /*! Task function. */
+    sched_task_fn_t                     pfTask;
+    /*! Maximal time from the post to the start of the task [us]. */
+    uint32_t                            u32DeadlineUs;
+}sched_task_t;
+
+/*!
+ * @brief Task statistics.
+ */
+typedef struct
+{
+    /*! Count of the task runs. */
+    uint32_t                            u32Runs;
+    /*! Count of the runs started after the deadline. */
+    uint32_t                            u32Misses;
+    /*! Maximal time from the post to the start of the task [us]. */
+    uint32_t                            u32MaxLatencyUs;
+}sched_stats_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes the scheduler.
+ *
+ * @details         The task index is its priority, the task 0 is the most
+ *                  urgent one. Starts the cycle counter measuring
+ *                  the latencies.
+ *
+ * @param[in]       cprTasks Task table, must stay valid.
+ * @param[in]       u8TaskCount Count of the tasks, at most SCHED_TASKS_MAX.
+*/
+void SCHED_Init(const sched_task_t *cprTasks,
+                uint8_t u8TaskCount);
+
+/*!
+ * @brief           This function posts the task.
+ *
+ * @details         Callable from interrupts. A task posted again before it
+ *                  started runs once, the latency counts from the first post.
+ *
+ * @param[in]       u8Task Task index.
+*/
+void SCHED_Post(uint8_t u8Task);
+
+/*!
+ * @brief           This function checks for the posted tasks.
+ *
+ * @return          true in case any task is posted.
+*/
+bool SCHED_Pending(void);
+
+/*!
+ * @brief           This function runs the most urgent posted task.
+ *
+ * @details         The task is cleared before it runs, so a post made
+ *                  meanwhile runs it again. Call from the main loop only,
+ *                  repeatedly until SCHED_TASK_NONE is returned. A task
+ *                  posted while another one runs waits for its completion
+ *                  only, never behind the less urgent posted tasks.
+ *
+ * @return          Index of the task run or SCHED_TASK_NONE.
+*/
+uint8_t SCHED_Run(void);
+
+/*!
+ * @brief           This function reads the task statistics.
+ *
+ * @param[in]       u8Task Task index.
+ * @param[out]      prStats Pointer to the statistics placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The statistics were provided.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_API_ILLEGAL_PORT_NUM: Unknown task.
+*/
+gptp_err_type_t SCHED_StatsGet(uint8_t u8Task,
+                               sched_stats_t *prStats);
+
+/*!
+ * @brief           This function clears the statistics of all tasks.
+*/
+void SCHED_StatsClear(void);
+
+/*******************************************************************************
+ * Guard End
+ ******************************************************************************/
+
+#endif /* SCHED_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,587 @@
+/*
+ *  Copyright 2017, 2019-2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/**
+ * @file eeprom.c
+ *
+ * @details Pdelay and rate ratio storage for the gPTP stack in the simulated
+ *          EEPROM (Fee). All per-port entries are cached in RAM and committed
+ *          as one journal record, alternately into two Fee blocks.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "eeprom.h"
+#include "MemAcc.h"
+#include "Schm_MemAcc.h"
+#include "Schm_Fee.h"
+#include "Fee.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define PDELAY_IDX_OFFSET               (0x0)
+#define RRATIO_IDX_OFFSET               (0x1)
+
+#define PORT_COUNT                      (1u)
+#define PORT_DATA_ENTRY_SIZE            (8u)
+/* In our case pdelay & rratio are written per port. */
+#define PORT_DATA_ENTRY_COUNT           (2u)
+
+/* Minimum interval between two journal commits, changes made meanwhile
+   are coalesced into the next record. */
+#define NVM_JOURNAL_COMMIT_INTERVAL_MS  (60000u)
+/* Journal record: sequence number, all per-port entries and CRC-32.
+   Must match FeeBlockSize of both journal blocks. */
+#define NVM_JOURNAL_SEQ_SIZE            (4u)
+#define NVM_JOURNAL_CRC_SIZE            (4u)
+#define NVM_JOURNAL_RECORD_SIZE         (NVM_JOURNAL_SEQ_SIZE + \
+                                         (PORT_COUNT * PORT_DATA_ENTRY_COUNT * PORT_DATA_ENTRY_SIZE) + \
+                                         NVM_JOURNAL_CRC_SIZE)
+/* Records are written alternately into two blocks, so a failed write
+   never destroys the last committed record. */
+#define NVM_JOURNAL_BLOCK_COUNT         (2u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+typedef enum {
+    WRITE_PENDING,
+    WRITE_IN_PROGRESS,
+    WRITE_COMPLETE
+} write_state_t;
+
+typedef enum {
+    READ_IDLE,
+    READ_PENDING
+} read_state_t;
+
+typedef struct {
+    uint8_t au8Data[PORT_DATA_ENTRY_SIZE];
+    write_state_t eState;
+    read_state_t eReadState;
+} gptp_nvm_data_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint32_t EEPROM_Crc32(const uint8_t *cpu8Data,
+                             const uint32_t cu32Length);
+static uint32_t EEPROM_Get_U32(const uint8_t *cpu8Data);
+static void EEPROM_Set_U32(uint8_t *pu8Data,
+                           const uint32_t cu32Value);
+static void EEPROM_Journal_Load(void);
+static void EEPROM_Enqueue_Write(const uint8_t cu8Port, 
+                                 const uint8_t cu8Offset,
+                                 const uint32_t cu32Length,
+                                 const uint8_t *cpu8Data);
+static void EEPROM_Write_Poll(void);
+static void EEPROM_Enqueue_Read(const uint8_t cu8Port,
+                                const uint8_t cu8Offset);
+static void EEPROM_Read_Poll(void);
+static uint8_t EEPROM_Read(const uint8_t cu8Port, 
+                           const uint8_t cu8Offset,
+                           const uint32_t cu32Length,
+                           uint8_t *pu8Data);
+static void EEPROM_Poll(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static gptp_nvm_data_t              sarPerPortData[PORT_COUNT * PORT_DATA_ENTRY_COUNT];
+static MemIf_StatusType             seMemStatus = MEMIF_IDLE;
+
+static const uint16_t               cau16JournalBlock[NVM_JOURNAL_BLOCK_COUNT] =
+{
+    FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_0,
+    FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_1
+};
+/* Record being written, the Fee driver reads it until the job finishes. */
+static uint8_t                      sau8JournalRecord[NVM_JOURNAL_RECORD_SIZE];
+static uint32_t                     su32JournalSequence = 0u;
+static uint8_t                      su8JournalBlockNext = 0u;
+static uint32_t                     su32JournalHoldOffMs = 0u;
+/* A journal record is being written, its result is not evaluated yet. */
+static boolean                      sbJournalCommitBusy = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes all components necessary for
+ *                  simulated EEPROM in data flash.
+ *
+ * @details         This function prepares cache data entries, enables MemmAcc
+ *                  and Fee and loads the newest valid journal record.
+*/
+void EEPROM_Init(void)
+{
+    const float64_t cf64NotStored = ((float64_t)0.0f / (float64_t)0.0f);
+    uint32_t u32PortCacheEntry;
+    uint32_t u32PortDataEntry;
+
+    /* No record loaded and no commit running yet. */
+    su32JournalSequence = 0u;
+    su8JournalBlockNext = 0u;
+    su32JournalHoldOffMs = 0u;
+    sbJournalCommitBusy = false;
+
+    /* Prepare cache default values, NaN marks the data not stored yet. */
+    for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+    {
+        sarPerPortData[u32PortCacheEntry].eState = WRITE_COMPLETE;
+        sarPerPortData[u32PortCacheEntry].eReadState = READ_IDLE;
+
+        for (u32PortDataEntry = 0u; u32PortDataEntry < PORT_DATA_ENTRY_SIZE; u32PortDataEntry++)
+        {
+            sarPerPortData[u32PortCacheEntry].au8Data[u32PortDataEntry] = ((const uint8_t*)&cf64NotStored)[u32PortDataEntry];
+        }
+    }
+
+    /* Init MemAcc. */
+    MemAcc_Init(NULL_PTR);
+
+    /* Init Fee. */
+    Fee_Init(NULL_PTR);
+
+    /* Perform init Fee driver. */
+    do
+    {
+        EEPROM_Poll();
+    } while (MEMIF_IDLE != seMemStatus);
+
+    EEPROM_Journal_Load();
+}
+
+/*!
+ * @brief           This function calculates CRC-32 (IEEE 802.3) of the data.
+ *
+ * @param[in]       cpu8Data Data to be checked.
+ * @param[in]       cu32Length Data length.
+ *
+ * @return          CRC-32 of the data.
+*/
+static uint32_t EEPROM_Crc32(const uint8_t *cpu8Data,
+                             const uint32_t cu32Length)
+{
+    uint32_t u32Crc = 0xFFFFFFFFu;
+    uint32_t u32Idx;
+    uint8_t  u8Bit;
+
+    for (u32Idx = 0u; u32Idx < cu32Length; u32Idx++)
+    {
+        u32Crc ^= cpu8Data[u32Idx];
+        for (u8Bit = 0u; u8Bit < 8u; u8Bit++)
+        {
+            u32Crc = (u32Crc >> 1u) ^ (0xEDB88320u & (0u - (u32Crc & 1u)));
+        }
+    }
+
+    return ~u32Crc;
+}
+
+/*!
+ * @brief           This function reads little-endian 32-bit value.
+ *
+ * @param[in]       cpu8Data Data to be read.
+ *
+ * @return          32-bit value.
+*/
+static uint32_t EEPROM_Get_U32(const uint8_t *cpu8Data)
+{
+    return ((uint32_t)cpu8Data[0u]) | ((uint32_t)cpu8Data[1u] << 8u) |
+           ((uint32_t)cpu8Data[2u] << 16u) | ((uint32_t)cpu8Data[3u] << 24u);
+}
+
+/*!
+ * @brief           This function writes little-endian 32-bit value.
+ *
+ * @param[out]      pu8Data Data to be written.
+ * @param[in]       cu32Value 32-bit value.
+*/
+static void EEPROM_Set_U32(uint8_t *pu8Data,
+                           const uint32_t cu32Value)
+{
+    pu8Data[0u] = (uint8_t)cu32Value;
+    pu8Data[1u] = (uint8_t)(cu32Value >> 8u);
+    pu8Data[2u] = (uint8_t)(cu32Value >> 16u);
+    pu8Data[3u] = (uint8_t)(cu32Value >> 24u);
+}
+
+/*!
+ * @brief           This function loads the newest valid journal record.
+ *
+ * @details         Both journal blocks are read, records with a wrong CRC
+ *                  are ignored. The record with the newer sequence number
+ *                  fills the cache and the next commit goes into the other
+ *                  block. Runs once at startup, before the gPTP stack.
+*/
+static void EEPROM_Journal_Load(void)
+{
+    uint8_t  au8Record[NVM_JOURNAL_RECORD_SIZE];
+    boolean  bFound = false;
+    uint32_t u32Sequence;
+    uint32_t u32PortCacheEntry;
+    uint32_t u32PortDataEntry;
+    uint8_t  u8Block;
+
+    for (u8Block = 0u; u8Block < NVM_JOURNAL_BLOCK_COUNT; u8Block++)
+    {
+        if (E_OK == Fee_Read(cau16JournalBlock[u8Block], 0u, au8Record, NVM_JOURNAL_RECORD_SIZE))
+        {
+            do
+            {
+                EEPROM_Poll();
+            } while (MEMIF_IDLE != seMemStatus);
+
+            u32Sequence = EEPROM_Get_U32(au8Record);
+            /* Blank or inconsistent block and torn write fail the check. */
+            if ((MEMIF_JOB_OK == Fee_GetJobResult()) &&
+                (EEPROM_Crc32(au8Record, NVM_JOURNAL_RECORD_SIZE - NVM_JOURNAL_CRC_SIZE) ==
+                 EEPROM_Get_U32(&au8Record[NVM_JOURNAL_RECORD_SIZE - NVM_JOURNAL_CRC_SIZE])) &&
+                (!bFound || (0 < (int32_t)(u32Sequence - su32JournalSequence))))
+            {
+                bFound = true;
+                su32JournalSequence = u32Sequence;
+                su8JournalBlockNext = (uint8_t)((u8Block + 1u) % NVM_JOURNAL_BLOCK_COUNT);
+
+                for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+                {
+                    for (u32PortDataEntry = 0u; u32PortDataEntry < PORT_DATA_ENTRY_SIZE; u32PortDataEntry++)
+                    {
+                        sarPerPortData[u32PortCacheEntry].au8Data[u32PortDataEntry] =
+                            au8Record[NVM_JOURNAL_SEQ_SIZE + (u32PortCacheEntry * PORT_DATA_ENTRY_SIZE) + u32PortDataEntry];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * @brief           This function queues up data to be written to EEPROM.
+ * 
+ * @param[in]       cu8Port Port ID.
+ * @param[in]       cu8Offset EEPROM address offset.
+ * @param[in]       cu32Length Data length.
+ * @param[in]       cpu8Data Data to be enqueued.
+*/
+static void EEPROM_Enqueue_Write(const uint8_t cu8Port,
+                                 const uint8_t cu8Offset,
+                                 const uint32_t cu32Length,
+                                 const uint8_t *cpu8Data)
+{
+    const uint32_t cu32Idx = (PORT_DATA_ENTRY_COUNT * cu8Port) + cu8Offset;
+    uint32_t       u32Entry;
+
+    if ((cu32Length <= PORT_DATA_ENTRY_SIZE) &&
+        (cu32Idx < (PORT_COUNT * PORT_DATA_ENTRY_COUNT)))
+    {
+        for (u32Entry = 0u; u32Entry < cu32Length; u32Entry++)
+        {
+            sarPerPortData[cu32Idx].au8Data[u32Entry] = cpu8Data[u32Entry];
+        }
+        sarPerPortData[cu32Idx].eState = WRITE_PENDING;
+    }
+}
+
+/*!
+ * @brief           Commits the journal record to EEPROM.
+ *
+ * @details         All entries changed since the last commit are coalesced
+ *                  into one record holding every entry, written into one
+ *                  Fee block. Commits are at least
+ *                  NVM_JOURNAL_COMMIT_INTERVAL_MS apart, a failed commit is
+ *                  retried after the interval.
+*/
+static void EEPROM_Write_Poll(void)
+{
+    boolean  bIsWritePending = false;
+    boolean  bCommitFailed = false;
+    uint32_t u32PortCacheEntry;
+    uint32_t u32PortDataEntry;
+
+    if (su32JournalHoldOffMs > NVM_POLL_PERIOD_MS)
+    {
+        su32JournalHoldOffMs -= NVM_POLL_PERIOD_MS;
+    }
+    else
+    {
+        su32JournalHoldOffMs = 0u;
+    }
+
+    EEPROM_Poll();
+    if (MEMIF_IDLE == seMemStatus)
+    {
+        /* Clear status of previous commit. Entries changed while it was
+           written are pending again and go into the next record. */
+        if (sbJournalCommitBusy)
+        {
+            sbJournalCommitBusy = false;
+            bCommitFailed = (MEMIF_JOB_OK != Fee_GetJobResult());
+
+            /* Failed commit is retried into the same block, keeping the
+               last committed record intact. */
+            if (!bCommitFailed)
+            {
+                su8JournalBlockNext = (uint8_t)((su8JournalBlockNext + 1u) % NVM_JOURNAL_BLOCK_COUNT);
+            }
+        }
+        for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+        {
+            if (WRITE_IN_PROGRESS == sarPerPortData[u32PortCacheEntry].eState)
+            {
+                sarPerPortData[u32PortCacheEntry].eState = bCommitFailed ? WRITE_PENDING : WRITE_COMPLETE;
+            }
+            if (WRITE_PENDING == sarPerPortData[u32PortCacheEntry].eState)
+            {
+                bIsWritePending = true;
+            }
+        }
+
+        /* Write all cache entries as one record. */
+        if (bIsWritePending && (0u == su32JournalHoldOffMs))
+        {
+            su32JournalSequence++;
+            EEPROM_Set_U32(sau8JournalRecord, su32JournalSequence);
+            for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+            {
+                for (u32PortDataEntry = 0u; u32PortDataEntry < PORT_DATA_ENTRY_SIZE; u32PortDataEntry++)
+                {
+                    sau8JournalRecord[NVM_JOURNAL_SEQ_SIZE + (u32PortCacheEntry * PORT_DATA_ENTRY_SIZE) + u32PortDataEntry] =
+                        sarPerPortData[u32PortCacheEntry].au8Data[u32PortDataEntry];
+                }
+                if (WRITE_PENDING == sarPerPortData[u32PortCacheEntry].eState)
+                {
+                    sarPerPortData[u32PortCacheEntry].eState = WRITE_IN_PROGRESS;
+                }
+            }
+            EEPROM_Set_U32(&sau8JournalRecord[NVM_JOURNAL_RECORD_SIZE - NVM_JOURNAL_CRC_SIZE],
+                           EEPROM_Crc32(sau8JournalRecord, NVM_JOURNAL_RECORD_SIZE - NVM_JOURNAL_CRC_SIZE));
+
+            su32JournalHoldOffMs = NVM_JOURNAL_COMMIT_INTERVAL_MS;
+            if (E_OK == Fee_Write(cau16JournalBlock[su8JournalBlockNext], sau8JournalRecord))
+            {
+                sbJournalCommitBusy = true;
+            }
+            else
+            {
+                /* Retry after the commit interval. */
+                for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+                {
+                    if (WRITE_IN_PROGRESS == sarPerPortData[u32PortCacheEntry].eState)
+                    {
+                        sarPerPortData[u32PortCacheEntry].eState = WRITE_PENDING;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * @brief           This function queues up a read from EEPROM.
+ *
+ * @details         The data is delivered to the gPTP stack by
+ *                  EEPROM_Read_Poll, a repeated request is served once.
+ *
+ * @param[in]       cu8Port Port ID.
+ * @param[in]       cu8Offset EEPROM address offset.
+*/
+static void EEPROM_Enqueue_Read(const uint8_t cu8Port,
+                                const uint8_t cu8Offset)
+{
+    const uint32_t cu32Idx = (PORT_DATA_ENTRY_COUNT * cu8Port) + cu8Offset;
+
+    if (cu32Idx < (PORT_COUNT * PORT_DATA_ENTRY_COUNT))
+    {
+        sarPerPortData[cu32Idx].eReadState = READ_PENDING;
+    }
+}
+
+/*!
+ * @brief           Executes queued reads from EEPROM.
+ *
+ * @details         The journal is loaded into the cache at startup and the
+ *                  cache holds the newest data since, so the queued reads
+ *                  are served from it without the flash access.
+*/
+static void EEPROM_Read_Poll(void)
+{
+    uint32_t  u32PortCacheEntry;
+    uint32_t  u32PortDataEntry;
+    float64_t f64Value;
+
+    for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+    {
+        if (READ_PENDING == sarPerPortData[u32PortCacheEntry].eReadState)
+        {
+            sarPerPortData[u32PortCacheEntry].eReadState = READ_IDLE;
+
+            for (u32PortDataEntry = 0u; u32PortDataEntry < PORT_DATA_ENTRY_SIZE; u32PortDataEntry++)
+            {
+                ((uint8_t*)&f64Value)[u32PortDataEntry] = sarPerPortData[u32PortCacheEntry].au8Data[u32PortDataEntry];
+            }
+
+            (void)GPTP_NvmReadDone((uint8_t)(u32PortCacheEntry / PORT_DATA_ENTRY_COUNT),
+                                   (PDELAY_IDX_OFFSET == (u32PortCacheEntry % PORT_DATA_ENTRY_COUNT)) ? GPTP_DEF_NVM_PDELAY : GPTP_DEF_NVM_RRATIO,
+                                   f64Value, true);
+        }
+    }
+}
+
+/*!
+ * @brief           This function reads data from EEPROM.
+ * 
+ * @details         The data is served from the cache holding the newest
+ *                  journal record.
+ *
+ * @param[in]       cu8Port Port ID.
+ * @param[in]       cu8Offset EEPROM address offset.
+ * @param[in]       cu32Length Data length.
+ * @param[out]      pu8Data Data to be read.
+ *
+ * @return          0 on success.
+*/
+static uint8_t EEPROM_Read(const uint8_t cu8Port,
+                           const uint8_t cu8Offset,
+                           const uint32_t cu32Length,
+                           uint8_t *pu8Data)
+{
+    uint8_t        u8Ret = 0u;
+    const uint32_t cu32Idx = (PORT_DATA_ENTRY_COUNT * cu8Port) + cu8Offset;
+    uint32_t       u32Entry;
+
+    if ((cu32Length > PORT_DATA_ENTRY_SIZE) ||
+        (cu32Idx >= (PORT_COUNT * PORT_DATA_ENTRY_COUNT)))
+    {
+        u8Ret = 1u;
+    }
+    else
+    {
+        for (u32Entry = 0u; u32Entry < cu32Length; u32Entry++)
+        {
+            pu8Data[u32Entry] = sarPerPortData[cu32Idx].au8Data[u32Entry];
+        }
+    }
+
+    return u8Ret;
+}
+
+/*!
+ * @brief           Executes actual EEPROM command.
+ *
+ * @details         This function call Fls/Fee main functions to execute
+ *                  necessary actions.
+*/
+static void EEPROM_Poll(void)
+{
+    Fee_MainFunction();
+    MemAcc_MainFunction();
+    seMemStatus = Fee_GetStatus();
+}
+
+/*!
+ * @brief           Task executing the queued EEPROM reads and writes.
+ *
+ * @details         Posted every NVM_POLL_PERIOD_MS, the least urgent task.
+*/
+void EEPROM_Task(void)
+{
+    EEPROM_Read_Poll();
+    EEPROM_Write_Poll();
+}
+
+/*!
+ * @brief           Callback function for EEPROM write.
+*/
+uint8_t EEPROM_Write_CB(uint8_t u8PdelayMachine,
+                        gptp_def_nvm_data_t eNvmDataType,
+                        float64_t f64Value,
+                        gptp_def_mem_write_stat *peWriteStat)
+{
+    uint8_t u8Offset = eNvmDataType == GPTP_DEF_NVM_PDELAY ? PDELAY_IDX_OFFSET : RRATIO_IDX_OFFSET;
+    uint8_t au8Data[PORT_DATA_ENTRY_SIZE];
+    uint8_t u8Idx;
+
+    if (GPTP_DEF_MEM_WRITE_INIT == *peWriteStat)
+    {
+        for (u8Idx = 0u; u8Idx < PORT_DATA_ENTRY_SIZE; u8Idx++)
+        {
+           au8Data[u8Idx] = ((uint8_t*)&f64Value)[u8Idx];
+        }
+
+        EEPROM_Enqueue_Write(u8PdelayMachine, u8Offset, PORT_DATA_ENTRY_SIZE,
+                             au8Data);
+
+        *peWriteStat = GPTP_DEF_MEM_WRITE_FINISH;
+    }
+
+    return 0u;
+}
+
+/*!
+ * @brief           Callback function for EEPROM read.
+*/
+uint8_t EEPROM_Read_CB(uint8_t u8PdelayMachine,
+                       gptp_def_nvm_data_t eNvmDataType,
+                       float64_t *f64Value)
+{
+    uint8_t u8Status;
+    uint8_t u8Offset = eNvmDataType == GPTP_DEF_NVM_PDELAY ? PDELAY_IDX_OFFSET : RRATIO_IDX_OFFSET;
+    uint8_t au8Data[PORT_DATA_ENTRY_SIZE];
+    uint8_t u8Idx;
+
+    u8Status = EEPROM_Read(u8PdelayMachine, u8Offset, PORT_DATA_ENTRY_SIZE,
+                           au8Data);
+
+    for (u8Idx = 0u; u8Idx < PORT_DATA_ENTRY_SIZE; u8Idx++)
+    {
+       ((uint8_t*)f64Value)[u8Idx] = au8Data[u8Idx];
+    }
+
+   return u8Status;
+}
+
+/*!
+ * @brief           Callback function for asynchronous EEPROM read.
+ *
+ * @details         The read is queued and serviced by EEPROM_Read_Poll, the
+ *                  gPTP stack runs with the default values meanwhile.
+*/
+uint8_t EEPROM_Read_Req_CB(uint8_t u8PdelayMachine,
+                           gptp_def_nvm_data_t eNvmDataType)
+{
+    uint8_t u8Status = 1u;
+    uint8_t u8Offset = eNvmDataType == GPTP_DEF_NVM_PDELAY ? PDELAY_IDX_OFFSET : RRATIO_IDX_OFFSET;
+
+    if (u8PdelayMachine < PORT_COUNT)
+    {
+        EEPROM_Enqueue_Read(u8PdelayMachine, u8Offset);
+        u8Status = 0u;
+    }
+
+    return u8Status;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
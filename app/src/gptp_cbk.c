@@ -23,6 +23,7 @@
 
 #include "gptp_cbk.h"
 #include "gptp_err.h"
+#include "eeprom.h"
 
 /*******************************************************************************
  * Definitions
@@ -38,13 +39,7 @@
  * Prototypes
  ******************************************************************************/
 
-extern uint8_t EEPROM_Write_CB(uint8_t u8PdelayMachine,
-                               gptp_def_nvm_data_t eNvmDataType,
-                               float64_t f64Value,
-                               gptp_def_mem_write_stat *peWriteStat);
-extern uint8_t EEPROM_Read_CB(uint8_t u8PdelayMachine,
-                              gptp_def_nvm_data_t eNvmDataType,
-                              float64_t *f64Value);
+/* None */
 
 /*******************************************************************************
  * Code
@@ -129,6 +124,24 @@ uint8_t GPTP_NVMReadCB(uint8_t u8PdelayMachine,
     return EEPROM_Read_CB(u8PdelayMachine, eNvmDataType, pf64Value);
 }
 
+/*!
+ * @brief           This functions requests data from the NVM.
+ *
+ * @details         This function is an example of callback which is called
+ *                  from gPTP stack directly. The data is delivered later
+ *                  by GPTP_NvmReadDone.
+ *
+ * @param[in]       u8PdelayMachine PDelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ *
+ * @return          Error status.
+*/
+uint8_t GPTP_NVMReadReqCB(uint8_t u8PdelayMachine,
+                          gptp_def_nvm_data_t eNvmDataType)
+{
+    return EEPROM_Read_Req_CB(u8PdelayMachine, eNvmDataType);
+}
+
 /*!
  * @brief           This functions occurs when new error in gPTP stack
  *                  is registered.
@@ -0,0 +1,421 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/**
+ * @file isr_prof.c
+ *
+ * @details Execution time profiler of the main loop passes of the task
+ *          scheduler (sched.h), the stages are the tasks run by SCHED_Run.
+ *          Times come from GPTP_PORT_CycleCounterGet, the DWT cycle counter on
+ *          target and the monotonic clock on the Linux host.
+ *
+ *          The pass only updates the statistics, an update costs two counter
+ *          reads and a fixed count of steps. Averages are computed on read.
+ *          At the end of the pass the statistics are copied to the published
+ *          buffer the readers do not use and the buffers are swapped. Tasks
+ *          read within the pass and interrupts preempt it, so a reader never
+ *          sees the buffer being written and never waits for the pass.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "isr_prof.h"
+#include "gptp_err.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Accumulated execution times of a stage.
+ */
+typedef struct
+{
+    uint32_t                            u32Count;
+    uint32_t                            u32MinCycles;
+    uint32_t                            u32MaxCycles;
+    uint64_t                            u64SumCycles;
+    uint32_t                            au32Hist[ISR_PROF_HIST_BINS];
+}isr_prof_acc_t;
+
+/*!
+ * @brief Statistics published at the end of a pass.
+ */
+typedef struct
+{
+    isr_prof_acc_t                      arStageAcc[ISR_PROF_STAGES_MAX];
+    isr_prof_acc_t                      rTotalAcc;
+    uint32_t                            u32Ticks;
+    uint32_t                            u32Overruns;
+    uint32_t                            u32LastOverrunTick;
+}isr_prof_pub_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void ISR_PROF_AccClear(isr_prof_acc_t *prAcc);
+static void ISR_PROF_AccAdd(isr_prof_acc_t *prAcc,
+                            uint32_t u32Cycles);
+static void ISR_PROF_AccCopy(volatile isr_prof_acc_t *prDst,
+                             const isr_prof_acc_t *cprSrc);
+static void ISR_PROF_ResetApply(void);
+static void ISR_PROF_Publish(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const sched_task_t           *scprTasks = NULL;
+static uint8_t                      su8StageCount = 0u;
+static uint32_t                     su32PeriodCycles = 0u;
+
+/* Statistics, written by the main loop pass only. */
+static isr_prof_acc_t               sarStageAcc[ISR_PROF_STAGES_MAX];
+static isr_prof_acc_t               srTotalAcc;
+static uint32_t                     su32Ticks = 0u;
+static uint32_t                     su32Overruns = 0u;
+static uint32_t                     su32LastOverrunTick = 0u;
+
+/* Cycle counter at the pass start and at the last stage end. */
+static uint32_t                     su32TickStart = 0u;
+static uint32_t                     su32StageMark = 0u;
+
+/* Published statistics, the readers use the buffer su8PubIdx. */
+static volatile isr_prof_pub_t      sarPub[2u];
+static volatile uint8_t             su8PubIdx = 0u;
+static volatile bool                sbResetPending = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function clears the accumulated execution times.
+ *
+ * @param[out]      prAcc Pointer to the accumulated times.
+*/
+static void ISR_PROF_AccClear(isr_prof_acc_t *prAcc)
+{
+    uint8_t u8Bin;
+
+    prAcc->u32Count = 0u;
+    prAcc->u32MinCycles = 0xFFFFFFFFu;
+    prAcc->u32MaxCycles = 0u;
+    prAcc->u64SumCycles = 0u;
+    for (u8Bin = 0u; u8Bin < ISR_PROF_HIST_BINS; u8Bin++)
+    {
+        prAcc->au32Hist[u8Bin] = 0u;
+    }
+}
+
+/*!
+ * @brief           This function accumulates the execution time.
+ *
+ * @details         The bin is the position of the most significant bit,
+ *                  found in five steps.
+ *
+ * @param[in,out]   prAcc Pointer to the accumulated times.
+ * @param[in]       u32Cycles Execution time [cycles].
+*/
+static void ISR_PROF_AccAdd(isr_prof_acc_t *prAcc,
+                            uint32_t u32Cycles)
+{
+    uint32_t u32Rest;
+    uint8_t  u8Msb;
+    uint8_t  u8Shift;
+    uint8_t  u8Bin;
+
+    u8Bin = 0u;
+    if (0u != (u32Cycles >> ISR_PROF_HIST_FIRST_SHIFT))
+    {
+        u32Rest = u32Cycles;
+        u8Msb = 0u;
+        for (u8Shift = 16u; 0u < u8Shift; u8Shift >>= 1u)
+        {
+            if (0u != (u32Rest >> u8Shift))
+            {
+                u32Rest >>= u8Shift;
+                u8Msb += u8Shift;
+            }
+        }
+
+        u8Bin = (uint8_t)(u8Msb - ISR_PROF_HIST_FIRST_SHIFT + 1u);
+        if (ISR_PROF_HIST_BINS <= u8Bin)
+        {
+            u8Bin = (uint8_t)(ISR_PROF_HIST_BINS - 1u);
+        }
+    }
+
+    prAcc->au32Hist[u8Bin]++;
+    prAcc->u32Count++;
+    prAcc->u64SumCycles += u32Cycles;
+    if (u32Cycles < prAcc->u32MinCycles)
+    {
+        prAcc->u32MinCycles = u32Cycles;
+    }
+    if (u32Cycles > prAcc->u32MaxCycles)
+    {
+        prAcc->u32MaxCycles = u32Cycles;
+    }
+}
+
+/*!
+ * @brief           This function copies the accumulated execution times.
+ *
+ * @param[out]      prDst Pointer to the published times.
+ * @param[in]       cprSrc Pointer to the accumulated times.
+*/
+static void ISR_PROF_AccCopy(volatile isr_prof_acc_t *prDst,
+                             const isr_prof_acc_t *cprSrc)
+{
+    uint8_t u8Bin;
+
+    prDst->u32Count = cprSrc->u32Count;
+    prDst->u32MinCycles = cprSrc->u32MinCycles;
+    prDst->u32MaxCycles = cprSrc->u32MaxCycles;
+    prDst->u64SumCycles = cprSrc->u64SumCycles;
+    for (u8Bin = 0u; u8Bin < ISR_PROF_HIST_BINS; u8Bin++)
+    {
+        prDst->au32Hist[u8Bin] = cprSrc->au32Hist[u8Bin];
+    }
+}
+
+/*!
+ * @brief           This function clears all the statistics.
+*/
+static void ISR_PROF_ResetApply(void)
+{
+    uint8_t u8Stage;
+
+    for (u8Stage = 0u; u8Stage < ISR_PROF_STAGES_MAX; u8Stage++)
+    {
+        ISR_PROF_AccClear(&sarStageAcc[u8Stage]);
+    }
+    ISR_PROF_AccClear(&srTotalAcc);
+    su32Ticks = 0u;
+    su32Overruns = 0u;
+    su32LastOverrunTick = 0u;
+    sbResetPending = false;
+}
+
+/*!
+ * @brief           This function publishes the statistics.
+ *
+ * @details         Writes the buffer not used by the readers, then swaps
+ *                  the buffers. Called from the main loop only.
+*/
+static void ISR_PROF_Publish(void)
+{
+    volatile isr_prof_pub_t *prPub;
+    uint8_t                 u8Idx;
+    uint8_t                 u8Stage;
+
+    u8Idx = (uint8_t)(su8PubIdx ^ 1u);
+    prPub = &sarPub[u8Idx];
+
+    for (u8Stage = 0u; u8Stage < su8StageCount; u8Stage++)
+    {
+        ISR_PROF_AccCopy(&prPub->arStageAcc[u8Stage], &sarStageAcc[u8Stage]);
+    }
+    ISR_PROF_AccCopy(&prPub->rTotalAcc, &srTotalAcc);
+    prPub->u32Ticks = su32Ticks;
+    prPub->u32Overruns = su32Overruns;
+    prPub->u32LastOverrunTick = su32LastOverrunTick;
+
+    su8PubIdx = u8Idx;
+}
+
+/*!
+ * @brief           This function initializes the profiler.
+ *
+ * @param[in]       cprTasks Pointer to the scheduler tasks.
+ * @param[in]       u8TaskCount Count of the tasks.
+ * @param[in]       u32PeriodCycles Period of the scheduler tick [cycles].
+*/
+void ISR_PROF_Init(const sched_task_t *cprTasks,
+                   uint8_t u8TaskCount,
+                   uint32_t u32PeriodCycles)
+{
+    GPTP_PORT_CycleCounterInit();
+
+    scprTasks = cprTasks;
+    su8StageCount = (u8TaskCount < ISR_PROF_STAGES_MAX) ? u8TaskCount : (uint8_t)ISR_PROF_STAGES_MAX;
+    su32PeriodCycles = u32PeriodCycles;
+
+    ISR_PROF_ResetApply();
+    ISR_PROF_Publish();
+}
+
+/*!
+ * @brief           This function starts the profiled main loop pass.
+*/
+void ISR_PROF_TickStart(void)
+{
+    su32TickStart = GPTP_PORT_CycleCounterGet();
+    su32StageMark = su32TickStart;
+
+    if (true == sbResetPending)
+    {
+        ISR_PROF_ResetApply();
+    }
+}
+
+/*!
+ * @brief           This function ends the profiled stage.
+ *
+ * @param[in]       u8Stage Stage index.
+*/
+void ISR_PROF_StageEnd(uint8_t u8Stage)
+{
+    uint32_t u32Now;
+
+    u32Now = GPTP_PORT_CycleCounterGet();
+
+    if (u8Stage < su8StageCount)
+    {
+        ISR_PROF_AccAdd(&sarStageAcc[u8Stage], u32Now - su32StageMark);
+    }
+    su32StageMark = u32Now;
+}
+
+/*!
+ * @brief           This function ends the profiled main loop pass.
+ *
+ * @return          true in case the pass overran the period.
+*/
+bool ISR_PROF_TickEnd(void)
+{
+    uint32_t u32Cycles;
+    bool     bOverrun;
+
+    u32Cycles = GPTP_PORT_CycleCounterGet() - su32TickStart;
+
+    ISR_PROF_AccAdd(&srTotalAcc, u32Cycles);
+    su32Ticks++;
+
+    bOverrun = (u32Cycles > su32PeriodCycles);
+    if (true == bOverrun)
+    {
+        su32Overruns++;
+        su32LastOverrunTick = su32Ticks;
+    }
+
+    ISR_PROF_Publish();
+
+    return bOverrun;
+}
+
+/*!
+ * @brief           This function reads the stage statistics.
+ *
+ * @param[in]       u8Stage Stage index or ISR_PROF_STAGE_TOTAL.
+ * @param[out]      prStats Pointer to the statistics placeholder.
+ *
+ * @return          Error status.
+*/
+gptp_err_type_t ISR_PROF_Read(uint8_t u8Stage,
+                              isr_prof_stats_t *prStats)
+{
+    gptp_err_type_t         eError;
+    volatile isr_prof_pub_t *prPub;
+    volatile isr_prof_acc_t *prAcc;
+    uint64_t                u64SumCycles;
+    uint8_t                 u8Bin;
+
+    if (NULL == prStats)
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else if ((ISR_PROF_STAGE_TOTAL != u8Stage) && (u8Stage >= su8StageCount))
+    {
+        eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+    }
+    else
+    {
+        prPub = &sarPub[su8PubIdx];
+        if (ISR_PROF_STAGE_TOTAL == u8Stage)
+        {
+            prAcc = &prPub->rTotalAcc;
+            prStats->cpcName = NULL;
+        }
+        else
+        {
+            prAcc = &prPub->arStageAcc[u8Stage];
+            prStats->cpcName = scprTasks[u8Stage].cpcName;
+        }
+
+        prStats->u32Count = prAcc->u32Count;
+        prStats->u32MinCycles = prAcc->u32MinCycles;
+        prStats->u32MaxCycles = prAcc->u32MaxCycles;
+        u64SumCycles = prAcc->u64SumCycles;
+        for (u8Bin = 0u; u8Bin < ISR_PROF_HIST_BINS; u8Bin++)
+        {
+            prStats->au32Hist[u8Bin] = prAcc->au32Hist[u8Bin];
+        }
+
+        if (0u == prStats->u32Count)
+        {
+            prStats->u32MinCycles = 0u;
+            prStats->u32AvgCycles = 0u;
+        }
+        else
+        {
+            prStats->u32AvgCycles = (uint32_t)(u64SumCycles / prStats->u32Count);
+        }
+
+        eError = GPTP_ERR_OK;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function reads the overrun statistics.
+ *
+ * @param[out]      prOverrun Pointer to the statistics placeholder.
+*/
+void ISR_PROF_OverrunRead(isr_prof_overrun_t *prOverrun)
+{
+    volatile isr_prof_pub_t *prPub;
+
+    if (NULL != prOverrun)
+    {
+        prPub = &sarPub[su8PubIdx];
+
+        prOverrun->u32Ticks = prPub->u32Ticks;
+        prOverrun->u32Overruns = prPub->u32Overruns;
+        prOverrun->u32LastOverrunTick = prPub->u32LastOverrunTick;
+        prOverrun->u32PeriodCycles = su32PeriodCycles;
+    }
+}
+
+/*!
+ * @brief           This function resets all the statistics.
+*/
+void ISR_PROF_Reset(void)
+{
+    sbResetPending = true;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -33,12 +33,19 @@
 #include "gptp_port_platform.h"
 #include "s32k344_gptp_config.h"
 #include "Clock_Ip.h"
-#include "Schm_MemAcc.h"
-#include "Schm_Fee.h"
-#include "Fee.h"
 #include "EthTrcv.h"
 #include "EthIf_Cbk.h"
 #include "Gpt.h"
+#include "sched.h"
+#include "eeprom.h"
+#ifdef GPTP_ETH_IRQ_DISPATCH
+#include "Platform.h"
+#include "Gmac_Ip_Irq.h"
+#include "Eth_43_GMAC_Internal.h"
+#endif /* GPTP_ETH_IRQ_DISPATCH */
+#ifdef GPTP_ISR_PROFILE
+#include "isr_prof.h"
+#endif /* GPTP_ISR_PROFILE */
 
 /*******************************************************************************
  * Definitions
@@ -47,48 +54,60 @@
 #define MILLISECOND_IN_NS               (1000000U)
 #define PIT0_1KHZ_CNT                   (PIT_FREQUENCY/1000u)
 
-#define PDELAY_IDX_OFFSET               (0x0)
-#define RRATIO_IDX_OFFSET               (0x1)
-
-#define PORT_COUNT                      (1u)
-#define PORT_DATA_ENTRY_SIZE            (8u)
-/* In our case pdelay & rratio are written per port. */
-#define PORT_DATA_ENTRY_COUNT           (2u)
+/* Deadlines of the tasks, from the post to the start [us]. */
+#define TASK_ETH_DEADLINE_US            (250u)
+#define TASK_GPTP_TIMER_DEADLINE_US     (1000u)
+#define TASK_LINK_STATUS_DEADLINE_US    (2000u)
+#define TASK_NVM_DEADLINE_US            (5000u)
+
+#ifdef GPTP_ETH_IRQ_DISPATCH
+/* GMAC instance of the gPTP Eth controller. */
+#define ETH_GMAC_INSTANCE               (0u)
+/* GMAC DMA channel interrupt lines (all channels share one line per
+   direction on S32K344). */
+#define ETH_GMAC_TX_IRQ                 (EMAC_1_IRQn)
+#define ETH_GMAC_RX_IRQ                 (EMAC_2_IRQn)
+/* Frames are dispatched from the GMAC interrupts, polling only recovers
+   events which did not raise an interrupt (e.g. RX buffer unavailable). */
+#define ETH_POLL_PERIOD_MS              (50u)
+#else
+#define ETH_POLL_PERIOD_MS              (2u)
+#endif /* GPTP_ETH_IRQ_DISPATCH */
+
+#ifdef GPTP_ISR_PROFILE
+/* Pass of the main loop longer than the PIT period delays the tasks. */
+#define ISR_PROF_PERIOD_CYCLES          (GPTP_PORT_CYCLE_FREQ_HZ / 1000u)
+#endif /* GPTP_ISR_PROFILE */
 
 /*******************************************************************************
  * Data types
  ******************************************************************************/
 
+/* Tasks of the application, the most urgent first. */
 typedef enum {
-    WRITE_PENDING,
-    WRITE_IN_PROGRESS,
-    WRITE_COMPLETE
-} write_state_t;
-
-typedef struct {
-    uint8_t au8Data[PORT_DATA_ENTRY_SIZE];
-    uint8_t u8Offset;
-    write_state_t eState;
-} gptp_nvm_data_t;
+    TASK_ETH_RX = 0,
+    TASK_ETH_TX,
+    TASK_GPTP_TIMER,
+    TASK_LINK_STATUS,
+    TASK_NVM,
+    TASK_COUNT
+} app_task_t;
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
-static void EEPROM_Init(void);
-static void EEPROM_Enqueue_Write(const uint8_t cu8Port, 
-                                 const uint8_t cu8Offset,
-                                 const uint32_t cu32Length,
-                                 const uint8_t *cpu8Data);
-static void EEPROM_Write_Poll(void);
-static uint8_t EEPROM_Read(const uint8_t cu8Port, 
-                           const uint8_t cu8Offset,
-                           const uint32_t cu32Length,
-                           uint8_t *pu8Data);
-static void EEPROM_Poll(void);
-static void Eth_Poll(void);
+static void Eth_PollRequest(void);
+static void Eth_RxDrain(uint8 u8FifoIdx);
+static void Eth_RxTask(void);
+static void Eth_TxTask(void);
 static void Eth_PollLinkStatus(void);
 static void Eth_Configure_1PPS_Output(uint8_t u8PPSCtrl);
+#ifdef GPTP_ETH_IRQ_DISPATCH
+static void Eth_RxChCallback(const uint8 u8Instance, const uint8 u8Channel);
+static void Eth_TxChCallback(const uint8 u8Instance, const uint8 u8Channel);
+static void Eth_IrqDispatchInit(void);
+#endif /* GPTP_ETH_IRQ_DISPATCH */
 
 void Poll_Gptp_Eth(void);
 
@@ -98,206 +117,120 @@ void Poll_Gptp_Eth(void);
 
 extern const Eth_43_GMAC_ConfigType Eth_43_GMAC_xPredefinedConfig;
 
-static gptp_nvm_data_t              sarPerPortData[PORT_COUNT * PORT_DATA_ENTRY_COUNT];
-static MemIf_StatusType             seMemStatus = MEMIF_IDLE;
+/* Tasks in the priority order. RX and TX confirmation carry the timestamps,
+   flash and link status work never delays them by more than one task run. */
+static const sched_task_t           carTasks[TASK_COUNT] =
+{
+    {"Eth_RxTask",         Eth_RxTask,          TASK_ETH_DEADLINE_US},
+    {"Eth_TxTask",         Eth_TxTask,          TASK_ETH_DEADLINE_US},
+    {"GPTP_TimerPeriodic", GPTP_TimerPeriodic,  TASK_GPTP_TIMER_DEADLINE_US},
+    {"Eth_PollLinkStatus", Eth_PollLinkStatus,  TASK_LINK_STATUS_DEADLINE_US},
+    {"EEPROM_Task",        EEPROM_Task,         TASK_NVM_DEADLINE_US}
+};
+
+#ifdef GPTP_ETH_IRQ_DISPATCH
+/* Deferred work per FIFO, set from the GMAC interrupt or by the fallback
+   poll, cleared by the task right before the FIFO is drained. */
+static volatile uint8_t             sau8EthRxPending[ETH_43_GMAC_MAX_RXFIFO_SUPPORTED];
+static volatile uint8_t             sau8EthTxPending[ETH_43_GMAC_MAX_TXFIFO_SUPPORTED];
+#endif /* GPTP_ETH_IRQ_DISPATCH */
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
 /*!
- * @brief           This function initializes all components necessary for
- *                  simulated EEPROM in data flash.
+ * @brief           This function requests polling of the ethernet peripheral.
  *
- * @details         This function prepares cache data entries, enables MemmAcc
- *                  and Fee.
+ * @details         Called from Poll_Gptp_Eth every ETH_POLL_PERIOD_MS. In
+ *                  the IRQ dispatch mode it only recovers events which did
+ *                  not raise an interrupt (e.g. RX buffer unavailable).
 */
-static void EEPROM_Init(void)
+static void Eth_PollRequest(void)
 {
-    uint32_t u32PortCacheEntry;
-    uint32_t u32PortDataEntry;
+#ifdef GPTP_ETH_IRQ_DISPATCH
+    uint8 u8FifoIdx;
 
-    /* Prepare cache default values. */
-    for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
+    for (u8FifoIdx = 0u; u8FifoIdx < ETH_43_GMAC_MAX_RXFIFO_SUPPORTED; u8FifoIdx++)
     {
-        sarPerPortData[u32PortCacheEntry].eState = WRITE_COMPLETE;
-        sarPerPortData[u32PortCacheEntry].u8Offset = PORT_DATA_ENTRY_SIZE * u32PortCacheEntry;
-
-        for (u32PortDataEntry = 0u; u32PortDataEntry < PORT_DATA_ENTRY_SIZE; u32PortDataEntry++)
-        {
-            sarPerPortData[u32PortCacheEntry].au8Data[u32PortDataEntry] = 0u;
-        }
+        sau8EthRxPending[u8FifoIdx] = 1u;
     }
-
-    /* Init MemAcc. */
-    MemAcc_Init(NULL_PTR);
-
-    /* Init Fee. */
-    Fee_Init(NULL_PTR);
-
-    /* Perform init Fee driver. */
-    do
+    for (u8FifoIdx = 0u; u8FifoIdx < ETH_43_GMAC_MAX_TXFIFO_SUPPORTED; u8FifoIdx++)
     {
-        EEPROM_Poll();
-    } while (MEMIF_IDLE != seMemStatus);
-}
-
-/*!
- * @brief           This function queues up data to be written to EEPROM.
- * 
- * @param[in]       cu8Port Port ID.
- * @param[in]       cu8Offset EEPROM address offset.
- * @param[in]       cu32Length Data length.
- * @param[in]       cpu8Data Data to be enqueued.
-*/
-static void EEPROM_Enqueue_Write(const uint8_t cu8Port,
-                                 const uint8_t cu8Offset,
-                                 const uint32_t cu32Length,
-                                 const uint8_t *cpu8Data)
-{
-    const uint32_t cu32Idx = (PORT_DATA_ENTRY_COUNT * cu8Port) + cu8Offset;
-    uint32_t       u32Entry;
-
-    if ((cu32Length <= PORT_DATA_ENTRY_SIZE) &&
-        (cu32Idx < (PORT_COUNT * PORT_DATA_ENTRY_COUNT)))
-    {
-        for (u32Entry = 0u; u32Entry < cu32Length; u32Entry++)
-        {
-            sarPerPortData[cu32Idx].au8Data[u32Entry] = cpu8Data[u32Entry];
-        }
-        sarPerPortData[cu32Idx].eState = WRITE_PENDING;
+        sau8EthTxPending[u8FifoIdx] = 1u;
     }
+#endif /* GPTP_ETH_IRQ_DISPATCH */
+
+    SCHED_Post((uint8_t)TASK_ETH_RX);
+    SCHED_Post((uint8_t)TASK_ETH_TX);
 }
 
 /*!
- * @brief           Executes actual write to EEPROM.
+ * @brief           This function drains the RX FIFO.
+ *
+ * @details         The received frames are passed to the gPTP stack by
+ *                  EthIf_RxIndication from the context of this function.
  *
- * @details         This function goes through the cache entry and executes
- *                  write above the first entry which has a WRITE_PENING state.
+ * @param[in]       u8FifoIdx RX FIFO index.
 */
-static void EEPROM_Write_Poll(void)
+static void Eth_RxDrain(uint8 u8FifoIdx)
 {
-    boolean  bIsWriteInProgress = false;
-    uint32_t u32PortCacheEntry;
-    uint16_t u16BlockNumber;
+    Eth_RxStatusType rRxStatus;
 
-    EEPROM_Poll();
-    if (MEMIF_IDLE == seMemStatus)
+    do
     {
-        /* Clear status of previous write. */
-        for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
-        {
-            if (WRITE_IN_PROGRESS == sarPerPortData[u32PortCacheEntry].eState)
-            {
-                sarPerPortData[u32PortCacheEntry].eState = WRITE_COMPLETE;
-            }
-        }
-        /* Write data from cache entry. */
-        for (u32PortCacheEntry = 0u; u32PortCacheEntry < (PORT_COUNT * PORT_DATA_ENTRY_COUNT); u32PortCacheEntry++)
-        {
-            if ((WRITE_PENDING == sarPerPortData[u32PortCacheEntry].eState) &&
-                !bIsWriteInProgress)
-            {
-                bIsWriteInProgress = true;
-                /* In case of necessity handle error. */
-                u16BlockNumber = sarPerPortData[u32PortCacheEntry].u8Offset == PDELAY_IDX_OFFSET ? FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_0 : FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_1;
-                Fee_Write(u16BlockNumber, sarPerPortData[u32PortCacheEntry].au8Data);
-                sarPerPortData[u32PortCacheEntry].eState = WRITE_IN_PROGRESS;
-            }
-        }
-    }
+        Eth_43_GMAC_Receive(EthConf_EthCtrlConfig_EthCtrlConfig_0, u8FifoIdx,
+                            &rRxStatus);
+    } while (ETH_NOT_RECEIVED != rRxStatus);
 }
 
 /*!
- * @brief           This function reads data from EEPROM.
- * 
- * @param[in]       cu8Port Port ID.
- * @param[in]       cu8Offset EEPROM address offset.
- * @param[in]       cu32Length Data length.
- * @param[out]      pu8Data Data to be read.
+ * @brief           Task receiving the frames.
  *
- * @return          0 on success.
+ * @details         Drains the RX FIFOs, in the IRQ dispatch mode only those
+ *                  which signalled reception. A flag set again while its FIFO
+ *                  is being drained is served by the next run.
 */
-static uint8_t EEPROM_Read(const uint8_t cu8Port,
-                           const uint8_t cu8Offset,
-                           const uint32_t cu32Length,
-                           uint8_t *pu8Data)
+static void Eth_RxTask(void)
 {
-    uint8_t        u8Ret = 0u;
-    const uint32_t cu32Idx = (PORT_DATA_ENTRY_COUNT * cu8Port) + cu8Offset;
-    uint32_t       u32Entry;
-    uint16_t       u16BlockNumber;
+    uint8 u8FifoIdx;
 
-    if (cu32Idx >= (PORT_COUNT * PORT_DATA_ENTRY_COUNT))
-    {
-        u8Ret = 1u;
-    }
-    else
+    for (u8FifoIdx = 0u; u8FifoIdx < ETH_43_GMAC_MAX_RXFIFO_SUPPORTED; u8FifoIdx++)
     {
-        /* If data is about to be written or is being written at the moment,
-           get the value from cache. */
-        if ((WRITE_IN_PROGRESS == sarPerPortData[cu32Idx].eState) ||
-            (WRITE_PENDING == sarPerPortData[cu32Idx].eState))
-        {
-            for (u32Entry = 0u; u32Entry < cu32Length; u32Entry++)
-            {
-                pu8Data[u32Entry] = sarPerPortData[cu32Idx].au8Data[u32Entry];
-            }
-        }
-        else
+#ifdef GPTP_ETH_IRQ_DISPATCH
+        if (0u != sau8EthRxPending[u8FifoIdx])
         {
-            u16BlockNumber = sarPerPortData[cu32Idx].u8Offset == PDELAY_IDX_OFFSET ? FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_0 : FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_1;
-
-            /* Read data block. */
-            Fee_Read(u16BlockNumber, 0u, pu8Data, cu32Length);
-
-            /* Perform read data form Block 0. */
-            do
-            {
-                EEPROM_Poll();
-            } while (MEMIF_IDLE != seMemStatus);
+            sau8EthRxPending[u8FifoIdx] = 0u;
+            Eth_RxDrain(u8FifoIdx);
         }
+#else
+        Eth_RxDrain(u8FifoIdx);
+#endif /* GPTP_ETH_IRQ_DISPATCH */
     }
-
-    return u8Ret;
 }
 
 /*!
- * @brief           Executes actual EEPROM command.
+ * @brief           Task confirming the transmitted frames.
  *
- * @details         This function call Fls/Fee main functions to execute
- *                  necessary actions.
+ * @details         The egress timestamps are passed to the gPTP stack by
+ *                  EthIf_TxConfirmation from the context of this function.
 */
-static void EEPROM_Poll(void)
+static void Eth_TxTask(void)
 {
-    Fee_MainFunction();
-    MemAcc_MainFunction();
-    seMemStatus = Fee_GetStatus();
-}
+#ifdef GPTP_ETH_IRQ_DISPATCH
+    uint8 u8FifoIdx;
 
-/*!
- * @brief           This function polls ethernet peripheral for events.
- *
- * @details         This function polls ethernet peripheral for following
- *                  events:
- *                      - RX frame received
- *                      - TX frame transmission completed
- *                      - Link state changed
- *                  When such event happens, corresponding EthIf_ Cbk function
- *                  is called from the context of this function.
-*/
-static void Eth_Poll(void)
-{
-    uint8            u8FifoIdx;
-    Eth_RxStatusType rRxStatus;
- 
-    for (u8FifoIdx = 0u; u8FifoIdx < ETH_43_GMAC_MAX_RXFIFO_SUPPORTED; u8FifoIdx++)
+    for (u8FifoIdx = 0u; u8FifoIdx < ETH_43_GMAC_MAX_TXFIFO_SUPPORTED; u8FifoIdx++)
     {
-        Eth_43_GMAC_Receive(EthConf_EthCtrlConfig_EthCtrlConfig_0, u8FifoIdx,
-                            &rRxStatus);
+        if (0u != sau8EthTxPending[u8FifoIdx])
+        {
+            sau8EthTxPending[u8FifoIdx] = 0u;
+            Eth_43_GMAC_ReportTransmission(EthConf_EthCtrlConfig_EthCtrlConfig_0, u8FifoIdx);
+        }
     }
-
+#else
     Eth_43_GMAC_TxConfirmation(EthConf_EthCtrlConfig_EthCtrlConfig_0);
+#endif /* GPTP_ETH_IRQ_DISPATCH */
 }
 
 /*!
@@ -348,84 +281,107 @@ static void Eth_Configure_1PPS_Output(uint8_t u8PPSCtrl)
     Gmac_apxBases[0]->MAC_PPS_CONTROL |= GMAC_MAC_PPS_CONTROL_PPSCTRL_PPSCMD(u8PPSCtrl);
 }
 
+#ifdef GPTP_ETH_IRQ_DISPATCH
 /*!
- * @brief           Callback function for EEPROM write.
+ * @brief           GMAC receive channel interrupt callback.
+ *
+ * @details         Only records the deferred work, the FIFO is drained by
+ *                  Eth_RxTask. RX FIFOs map 1:1 to DMA channels.
 */
-uint8_t EEPROM_Write_CB(uint8_t u8PdelayMachine,
-                        gptp_def_nvm_data_t eNvmDataType,
-                        float64_t f64Value,
-                        gptp_def_mem_write_stat *peWriteStat)
+static void Eth_RxChCallback(const uint8 u8Instance, const uint8 u8Channel)
 {
-    uint8_t u8Offset = eNvmDataType == GPTP_DEF_NVM_PDELAY ? PDELAY_IDX_OFFSET : RRATIO_IDX_OFFSET;
-    uint8_t au8Data[PORT_DATA_ENTRY_SIZE];
-    uint8_t u8Idx;
+    (void)u8Instance;
 
-    if (GPTP_DEF_MEM_WRITE_INIT == *peWriteStat)
+    if (u8Channel < ETH_43_GMAC_MAX_RXFIFO_SUPPORTED)
     {
-        for (u8Idx = 0u; u8Idx < PORT_DATA_ENTRY_SIZE; u8Idx++)
-        {
-           au8Data[u8Idx] = ((uint8_t*)&f64Value)[u8Idx];
-        }
+        sau8EthRxPending[u8Channel] = 1u;
+        SCHED_Post((uint8_t)TASK_ETH_RX);
+    }
+}
 
-        EEPROM_Enqueue_Write(u8PdelayMachine, u8Offset, PORT_DATA_ENTRY_SIZE,
-                             au8Data);
+/*!
+ * @brief           GMAC transmit channel interrupt callback.
+ *
+ * @details         Only records the deferred work, the FIFO is confirmed by
+ *                  Eth_TxTask. TX FIFOs map 1:1 to DMA channels.
+*/
+static void Eth_TxChCallback(const uint8 u8Instance, const uint8 u8Channel)
+{
+    (void)u8Instance;
 
-        *peWriteStat = GPTP_DEF_MEM_WRITE_FINISH;
+    if (u8Channel < ETH_43_GMAC_MAX_TXFIFO_SUPPORTED)
+    {
+        sau8EthTxPending[u8Channel] = 1u;
+        SCHED_Post((uint8_t)TASK_ETH_TX);
     }
-
-    return 0u;
 }
 
 /*!
- * @brief           Callback function for EEPROM read.
+ * @brief           This function enables the GMAC RX/TX completion interrupts.
+ *
+ * @details         The Eth driver is configured for polling, so the channel
+ *                  callbacks and the DMA interrupt enables are installed here,
+ *                  after the controller has been initialized.
 */
-uint8_t EEPROM_Read_CB(uint8_t u8PdelayMachine,
-                       gptp_def_nvm_data_t eNvmDataType,
-                       float64_t *f64Value)
+static void Eth_IrqDispatchInit(void)
 {
-    uint8_t u8Status;
-    uint8_t u8Offset = eNvmDataType == GPTP_DEF_NVM_PDELAY ? PDELAY_IDX_OFFSET : RRATIO_IDX_OFFSET;
-    uint8_t au8Data[PORT_DATA_ENTRY_SIZE];
-    uint8_t u8Idx;
-
-    u8Status = EEPROM_Read(u8PdelayMachine, u8Offset, PORT_DATA_ENTRY_SIZE,
-                           au8Data);
+    uint8 u8Channel;
 
-    for (u8Idx = 0u; u8Idx < PORT_DATA_ENTRY_SIZE; u8Idx++)
+    for (u8Channel = 0u; u8Channel < FEATURE_GMAC_NUM_CHANNELS; u8Channel++)
     {
-       ((uint8_t*)f64Value)[u8Idx] = au8Data[u8Idx];
+        Gmac_apxState[ETH_GMAC_INSTANCE]->RxChCallback[u8Channel] = Eth_RxChCallback;
+        Gmac_apxState[ETH_GMAC_INSTANCE]->TxChCallback[u8Channel] = Eth_TxChCallback;
+        Gmac_apxChBases[ETH_GMAC_INSTANCE][u8Channel]->DMA_INTERRUPT_ENABLE |= GMAC_DMA_CH0_INTERRUPT_ENABLE_NIE_MASK |
+                                                                              GMAC_DMA_CH0_INTERRUPT_ENABLE_RIE_MASK |
+                                                                              GMAC_DMA_CH0_INTERRUPT_ENABLE_TIE_MASK;
     }
 
-   return u8Status;
+    (void)Platform_InstallIrqHandler(ETH_GMAC_RX_IRQ, GMAC0_CH_RX_IRQHandler, NULL_PTR);
+    (void)Platform_InstallIrqHandler(ETH_GMAC_TX_IRQ, GMAC0_CH_TX_IRQHandler, NULL_PTR);
+    (void)Platform_SetIrq(ETH_GMAC_RX_IRQ, TRUE);
+    (void)Platform_SetIrq(ETH_GMAC_TX_IRQ, TRUE);
 }
+#endif /* GPTP_ETH_IRQ_DISPATCH */
 
 /*!
- * @brief           This function calls periodically Eth and GPTP services.
+ * @brief           This function posts the periodic Eth and GPTP services.
+ *
+ * @details         The services run as tasks from the main loop, see carTasks.
+ *                  The interrupt only posts them, so the GMAC completion
+ *                  interrupts are never delayed by a long running service.
 */
 void Poll_Gptp_Eth(void)
 {
     static volatile uint64_t u64PitIsrCountMs = 0;
 
-    /* Increment 1ms = 1000000 ns. */
+#ifndef GPTP_PORT_STM_TIMEBASE
+    /* Increment 1ms = 1000000 ns. The STM time base is sampled by the tasks
+       instead, the sampling is not reentrant. */
     GPTP_PORT_IncFreeRunningTimer(MILLISECOND_IN_NS);
+#endif /* GPTP_PORT_STM_TIMEBASE */
 
-    /*  Poll GPTP TimerPeriodic every 9ms. */
+    /*  Post GPTP TimerPeriodic every 9ms. */
     if (0U == (u64PitIsrCountMs % 9u))
     {
-        GPTP_TimerPeriodic();
+        SCHED_Post((uint8_t)TASK_GPTP_TIMER);
     }
 
-    /* Poll EEPROM write function every 5 ms. */
-    if (0U == (u64PitIsrCountMs % 5u))
+    /* Post EEPROM read and write functions every 5 ms. */
+    if (0U == (u64PitIsrCountMs % NVM_POLL_PERIOD_MS))
     {
-        EEPROM_Write_Poll();
+        SCHED_Post((uint8_t)TASK_NVM);
     }
 
-    /*  Poll Ethernet interface every 2ms. */
+    /*  Post link status every 2ms. */
     if (0U == (u64PitIsrCountMs % 2u))
     {
-        Eth_PollLinkStatus();
-        Eth_Poll();
+        SCHED_Post((uint8_t)TASK_LINK_STATUS);
+    }
+
+    /*  Poll Ethernet interface (fallback only in the IRQ dispatch mode). */
+    if (0U == (u64PitIsrCountMs % ETH_POLL_PERIOD_MS))
+    {
+        Eth_PollRequest();
     }
 
     u64PitIsrCountMs++;
@@ -436,6 +392,8 @@ void Poll_Gptp_Eth(void)
 */
 int main(void)
 {
+    uint8_t u8Task;
+
     /* Initialize HW peripherals. */
     device_init();
 
@@ -445,18 +403,59 @@ int main(void)
     /* Configure 1PPS output to 1Hz / 50% duty cycle. */
     Eth_Configure_1PPS_Output(1);
 
+#ifdef GPTP_PORT_STM_TIMEBASE
+    /* Start the STM counter used as the gPTP FreeRunning time base. */
+    GPTP_PORT_StmTimebaseInit();
+#endif /* GPTP_PORT_STM_TIMEBASE */
+
     /* Initialize GPTP stack. */
     gptp_err_type_t err = GPTP_GptpInit(&rGptpCfgParams);
     DevAssert(GPTP_ERR_OK == err);
 
+    /* Tasks posted by the interrupts, run from the main loop. */
+    SCHED_Init(carTasks, (uint8_t)TASK_COUNT);
+
+#ifdef GPTP_ETH_IRQ_DISPATCH
+    /* React to RX/TX completion instead of waiting for the next poll. */
+    Eth_IrqDispatchInit();
+#endif /* GPTP_ETH_IRQ_DISPATCH */
+
+#ifdef GPTP_ISR_PROFILE
+    /* Measure the tasks run per main loop pass. */
+    ISR_PROF_Init(carTasks, (uint8_t)TASK_COUNT, ISR_PROF_PERIOD_CYCLES);
+#endif /* GPTP_ISR_PROFILE */
+
     /* Start IRQ-mode GPT timer 1kHz. */
     Gpt_StartTimer(GptConf_GptChannelConfiguration_GptChannelConfiguration_0, PIT0_1KHZ_CNT);
 
     while (true)
     {
-        /* Nothing to be called within the endless loop
-         * (Poll_Gptp_Eth-Callback controlled application). */
-        EXECUTE_WAIT();
+        if (true == SCHED_Pending())
+        {
+#ifdef GPTP_ISR_PROFILE
+            ISR_PROF_TickStart();
+#endif /* GPTP_ISR_PROFILE */
+            /* Run the posted tasks, the most urgent one first. */
+            do
+            {
+                u8Task = SCHED_Run();
+#ifdef GPTP_ISR_PROFILE
+                ISR_PROF_StageEnd(u8Task);
+#endif /* GPTP_ISR_PROFILE */
+            } while (SCHED_TASK_NONE != u8Task);
+#ifdef GPTP_ISR_PROFILE
+            (void)ISR_PROF_TickEnd();
+#endif /* GPTP_ISR_PROFILE */
+        }
+
+        /* Sleep unless a task was posted meanwhile. A pending interrupt
+         * wakes the core up even when masked, it is served after resume. */
+        OsIf_SuspendAllInterrupts();
+        if (false == SCHED_Pending())
+        {
+            EXECUTE_WAIT();
+        }
+        OsIf_ResumeAllInterrupts();
     }
 
     return 0;
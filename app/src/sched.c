@@ -0,0 +1,216 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/**
+ * @file sched.c
+ *
+ * @details Cooperative run-to-completion scheduler with fixed priorities.
+ *          Interrupts only post tasks, the main loop runs them one at a time,
+ *          always the most urgent posted one first. Latencies are measured
+ *          by GPTP_PORT_CycleCounterGet from the first post to the start.
+ *
+ *          The pending flags are bytes written by a single store, so a post
+ *          from an interrupt never races with the clear in the main loop.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "sched.h"
+#include "gptp_err.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Cycle counter ticks per microsecond. */
+#define SCHED_CYCLES_PER_US             (GPTP_PORT_CYCLE_FREQ_HZ / 1000000u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const sched_task_t           *scprTasks = NULL;
+static uint8_t                      su8TaskCount = 0u;
+
+/* Set by the post, cleared right before the task runs. */
+static volatile uint8_t             sau8Pending[SCHED_TASKS_MAX];
+/* Cycle counter at the first post. */
+static volatile uint32_t            sau32PostCycles[SCHED_TASKS_MAX];
+
+/* Statistics, accessed from the main loop only. */
+static sched_stats_t                sarStats[SCHED_TASKS_MAX];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes the scheduler.
+ *
+ * @param[in]       cprTasks Task table.
+ * @param[in]       u8TaskCount Count of the tasks.
+*/
+void SCHED_Init(const sched_task_t *cprTasks,
+                uint8_t u8TaskCount)
+{
+    uint8_t u8Task;
+
+    GPTP_PORT_CycleCounterInit();
+
+    scprTasks = cprTasks;
+    su8TaskCount = (u8TaskCount < SCHED_TASKS_MAX) ? u8TaskCount : (uint8_t)SCHED_TASKS_MAX;
+
+    for (u8Task = 0u; u8Task < SCHED_TASKS_MAX; u8Task++)
+    {
+        sau8Pending[u8Task] = 0u;
+    }
+
+    SCHED_StatsClear();
+}
+
+/*!
+ * @brief           This function posts the task.
+ *
+ * @param[in]       u8Task Task index.
+*/
+void SCHED_Post(uint8_t u8Task)
+{
+    if ((u8Task < su8TaskCount) && (0u == sau8Pending[u8Task]))
+    {
+        sau32PostCycles[u8Task] = GPTP_PORT_CycleCounterGet();
+        sau8Pending[u8Task] = 1u;
+    }
+}
+
+/*!
+ * @brief           This function checks for the posted tasks.
+ *
+ * @return          true in case any task is posted.
+*/
+bool SCHED_Pending(void)
+{
+    uint8_t u8Task;
+    bool    bPending = false;
+
+    for (u8Task = 0u; (u8Task < su8TaskCount) && (false == bPending); u8Task++)
+    {
+        bPending = (0u != sau8Pending[u8Task]);
+    }
+
+    return bPending;
+}
+
+/*!
+ * @brief           This function runs the most urgent posted task.
+ *
+ * @return          Index of the task run or SCHED_TASK_NONE.
+*/
+uint8_t SCHED_Run(void)
+{
+    uint8_t  u8Task;
+    uint32_t u32LatencyUs;
+
+    for (u8Task = 0u; u8Task < su8TaskCount; u8Task++)
+    {
+        if (0u != sau8Pending[u8Task])
+        {
+            break;
+        }
+    }
+
+    if (u8Task < su8TaskCount)
+    {
+        u32LatencyUs = (GPTP_PORT_CycleCounterGet() - sau32PostCycles[u8Task]) / SCHED_CYCLES_PER_US;
+        sau8Pending[u8Task] = 0u;
+
+        sarStats[u8Task].u32Runs++;
+        if (u32LatencyUs > scprTasks[u8Task].u32DeadlineUs)
+        {
+            sarStats[u8Task].u32Misses++;
+        }
+        if (u32LatencyUs > sarStats[u8Task].u32MaxLatencyUs)
+        {
+            sarStats[u8Task].u32MaxLatencyUs = u32LatencyUs;
+        }
+
+        scprTasks[u8Task].pfTask();
+    }
+    else
+    {
+        u8Task = SCHED_TASK_NONE;
+    }
+
+    return u8Task;
+}
+
+/*!
+ * @brief           This function reads the task statistics.
+ *
+ * @param[in]       u8Task Task index.
+ * @param[out]      prStats Pointer to the statistics placeholder.
+ *
+ * @return          Error status.
+*/
+gptp_err_type_t SCHED_StatsGet(uint8_t u8Task,
+                               sched_stats_t *prStats)
+{
+    gptp_err_type_t eError;
+
+    if (NULL == prStats)
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else if (u8Task >= su8TaskCount)
+    {
+        eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+    }
+    else
+    {
+        *prStats = sarStats[u8Task];
+        eError = GPTP_ERR_OK;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function clears the statistics of all tasks.
+*/
+void SCHED_StatsClear(void)
+{
+    uint8_t u8Task;
+
+    for (u8Task = 0u; u8Task < SCHED_TASKS_MAX; u8Task++)
+    {
+        sarStats[u8Task].u32Runs = 0u;
+        sarStats[u8Task].u32Misses = 0u;
+        sarStats[u8Task].u32MaxLatencyUs = 0u;
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,403 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/**
+ * @file eeprom_test.c
+ *
+ * @details Host test of the EEPROM journal (eeprom.c) against a stubbed Fee
+ *          driver. The stub keeps the two journal blocks in RAM, finishes
+ *          every job after a few main function calls and can fail the next
+ *          write, leaving a torn block behind.
+ *
+ *          Checked: the blank boot, coalescing of the updates into one
+ *          commit, an update while a commit is written, the retry of
+ *          a failed commit into the same block and the boot with a torn
+ *          newest record.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -Iapp/test/stub -Iapp/include
+ *              -Igptp_stack/port/linux -Igptp_stack/port
+ *              -Igptp_stack/gptp_core/include app/src/eeprom.c
+ *              app/test/eeprom_test.c -o eeprom_test
+ *
+ *          Usage: eeprom_test
+ *
+ *          Exits with EXIT_FAILURE if any check fails.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eeprom.h"
+#include "MemAcc.h"
+#include "Schm_MemAcc.h"
+#include "Fee.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Journal record size, must match NVM_JOURNAL_RECORD_SIZE. */
+#define EEPROM_TEST_RECORD_SIZE         (24u)
+/*! Fee blocks, indexed by the block number. */
+#define EEPROM_TEST_BLOCKS              (3u)
+/*! Main function calls until a Fee job finishes. */
+#define EEPROM_TEST_FEE_LATENCY         (3u)
+/*! Maximal count of the logged writes. */
+#define EEPROM_TEST_WRITES_MAX          (16u)
+/*! Minimum interval between two journal commits [ms]. */
+#define EEPROM_TEST_INTERVAL_MS         (60000u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Stubbed Fee driver.
+ */
+typedef struct
+{
+    uint8_t                             au8Flash[EEPROM_TEST_BLOCKS][EEPROM_TEST_RECORD_SIZE];
+    boolean                             abWritten[EEPROM_TEST_BLOCKS];
+    /*! Running job, 0 if idle. */
+    uint8_t                             u8Busy;
+    boolean                             bJobWrite;
+    uint16                              u16Block;
+    uint8                               *pu8ReadBuffer;
+    const uint8                         *cpu8WriteBuffer;
+    MemIf_JobResultType                 eResult;
+    /*! The next write fails and tears the block. */
+    boolean                             bFailNextWrite;
+    /*! Blocks of the started writes. */
+    uint16                              au16Writes[EEPROM_TEST_WRITES_MAX];
+    uint32_t                            u32Writes;
+}eeprom_test_fee_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void EEPROM_TEST_Check(boolean bPassed,
+                              const char *pcCheck);
+static void EEPROM_TEST_FlashErase(void);
+static void EEPROM_TEST_Run(uint32_t u32Ms);
+static void EEPROM_TEST_Write(gptp_def_nvm_data_t eType,
+                              float64_t f64Value);
+static float64_t EEPROM_TEST_Read(gptp_def_nvm_data_t eType);
+static uint32_t EEPROM_TEST_Sequence(uint16 u16Block);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static eeprom_test_fee_t                srFee;
+static uint32_t                         su32Failed = 0u;
+/*! Value and count of the asynchronous reads delivered to the stack. */
+static float64_t                        sf64ReadDone = 0.0;
+static uint32_t                         su32ReadsDone = 0u;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void MemAcc_Init(const MemAcc_ConfigType *ConfigPtr)
+{
+    (void)ConfigPtr;
+}
+
+void MemAcc_MainFunction(void)
+{
+}
+
+void Fee_Init(const Fee_ConfigType *ConfigPtr)
+{
+    (void)ConfigPtr;
+    srFee.u8Busy = 0u;
+    srFee.eResult = MEMIF_JOB_OK;
+}
+
+Std_ReturnType Fee_Read(uint16 BlockNumber, uint16 BlockOffset, uint8 *DataBufferPtr, uint16 Length)
+{
+    Std_ReturnType eRet = E_NOT_OK;
+
+    if ((0u == srFee.u8Busy) && (BlockNumber < EEPROM_TEST_BLOCKS) &&
+        (0u == BlockOffset) && (EEPROM_TEST_RECORD_SIZE == Length))
+    {
+        srFee.u8Busy = EEPROM_TEST_FEE_LATENCY;
+        srFee.bJobWrite = false;
+        srFee.u16Block = BlockNumber;
+        srFee.pu8ReadBuffer = DataBufferPtr;
+        srFee.eResult = MEMIF_JOB_PENDING;
+        eRet = E_OK;
+    }
+
+    return eRet;
+}
+
+Std_ReturnType Fee_Write(uint16 BlockNumber, const uint8 *DataBufferPtr)
+{
+    Std_ReturnType eRet = E_NOT_OK;
+
+    if ((0u == srFee.u8Busy) && (BlockNumber < EEPROM_TEST_BLOCKS))
+    {
+        srFee.u8Busy = EEPROM_TEST_FEE_LATENCY;
+        srFee.bJobWrite = true;
+        srFee.u16Block = BlockNumber;
+        srFee.cpu8WriteBuffer = DataBufferPtr;
+        srFee.eResult = MEMIF_JOB_PENDING;
+        if (srFee.u32Writes < EEPROM_TEST_WRITES_MAX)
+        {
+            srFee.au16Writes[srFee.u32Writes] = BlockNumber;
+        }
+        srFee.u32Writes++;
+        eRet = E_OK;
+    }
+
+    return eRet;
+}
+
+MemIf_StatusType Fee_GetStatus(void)
+{
+    return (0u == srFee.u8Busy) ? MEMIF_IDLE : MEMIF_BUSY;
+}
+
+MemIf_JobResultType Fee_GetJobResult(void)
+{
+    return srFee.eResult;
+}
+
+/*!
+ * @brief           Finishes the Fee job after EEPROM_TEST_FEE_LATENCY calls.
+ *
+ * @details         The record is taken from the buffer at the end of the job,
+ *                  as the driver reads it until the job finishes.
+*/
+void Fee_MainFunction(void)
+{
+    if (0u != srFee.u8Busy)
+    {
+        srFee.u8Busy--;
+        if (0u == srFee.u8Busy)
+        {
+            srFee.eResult = MEMIF_JOB_OK;
+            if (srFee.bJobWrite && srFee.bFailNextWrite)
+            {
+                /* Interrupted write, the block is left inconsistent */
+                srFee.bFailNextWrite = false;
+                memset(srFee.au8Flash[srFee.u16Block], 0xA5, EEPROM_TEST_RECORD_SIZE);
+                srFee.abWritten[srFee.u16Block] = true;
+                srFee.eResult = MEMIF_JOB_FAILED;
+            }
+            else if (srFee.bJobWrite)
+            {
+                memcpy(srFee.au8Flash[srFee.u16Block], srFee.cpu8WriteBuffer, EEPROM_TEST_RECORD_SIZE);
+                srFee.abWritten[srFee.u16Block] = true;
+            }
+            else if (srFee.abWritten[srFee.u16Block])
+            {
+                memcpy(srFee.pu8ReadBuffer, srFee.au8Flash[srFee.u16Block], EEPROM_TEST_RECORD_SIZE);
+            }
+            else
+            {
+                srFee.eResult = MEMIF_BLOCK_INVALID;
+            }
+        }
+    }
+}
+
+/*!
+ * @brief           Asynchronous read completion of the stack, records the value.
+*/
+gptp_err_type_t GPTP_NvmReadDone(uint8_t u8PdelayMachine,
+                                 gptp_def_nvm_data_t eNvmDataType,
+                                 float64_t f64Value,
+                                 bool bReadOk)
+{
+    (void)u8PdelayMachine;
+    (void)eNvmDataType;
+    sf64ReadDone = bReadOk ? f64Value : 0.0;
+    su32ReadsDone++;
+
+    return GPTP_ERR_OK;
+}
+
+/*!
+ * @brief           This function reports the check.
+ * @param[in]       bPassed Result of the check.
+ * @param[in]       pcCheck Description of the check.
+*/
+static void EEPROM_TEST_Check(boolean bPassed,
+                              const char *pcCheck)
+{
+    printf("%s %s\n", bPassed ? "pass" : "FAIL", pcCheck);
+    if (!bPassed)
+    {
+        su32Failed++;
+    }
+}
+
+/*!
+ * @brief           This function erases both journal blocks and the write log.
+*/
+static void EEPROM_TEST_FlashErase(void)
+{
+    memset(&srFee, 0, sizeof(srFee));
+}
+
+/*!
+ * @brief           This function runs EEPROM_Task for the given time.
+ * @param[in]       u32Ms Time [ms], rounded down to NVM_POLL_PERIOD_MS.
+*/
+static void EEPROM_TEST_Run(uint32_t u32Ms)
+{
+    uint32_t u32Tick;
+
+    for (u32Tick = 0u; u32Tick < (u32Ms / NVM_POLL_PERIOD_MS); u32Tick++)
+    {
+        EEPROM_Task();
+    }
+}
+
+/*!
+ * @brief           This function stores the value as the stack does.
+ * @param[in]       eType NVM data type.
+ * @param[in]       f64Value Value to be stored.
+*/
+static void EEPROM_TEST_Write(gptp_def_nvm_data_t eType,
+                              float64_t f64Value)
+{
+    gptp_def_mem_write_stat eStat = GPTP_DEF_MEM_WRITE_INIT;
+
+    (void)EEPROM_Write_CB(0u, eType, f64Value, &eStat);
+}
+
+/*!
+ * @brief           This function reads the value as the stack does.
+ * @param[in]       eType NVM data type.
+ * @return          Value read.
+*/
+static float64_t EEPROM_TEST_Read(gptp_def_nvm_data_t eType)
+{
+    float64_t f64Value = 0.0;
+
+    (void)EEPROM_Read_CB(0u, eType, &f64Value);
+
+    return f64Value;
+}
+
+/*!
+ * @brief           This function returns the sequence number of the record.
+ * @param[in]       u16Block Fee block number.
+ * @return          Sequence number, 0 for the blank block.
+*/
+static uint32_t EEPROM_TEST_Sequence(uint16 u16Block)
+{
+    const uint8_t *cpu8Record = srFee.au8Flash[u16Block];
+
+    return srFee.abWritten[u16Block] ?
+           (((uint32_t)cpu8Record[0u]) | ((uint32_t)cpu8Record[1u] << 8u) |
+            ((uint32_t)cpu8Record[2u] << 16u) | ((uint32_t)cpu8Record[3u] << 24u)) : 0u;
+}
+
+int main(void)
+{
+    float64_t f64Value;
+
+    /* Blank boot, nothing stored reads as NaN */
+    EEPROM_TEST_FlashErase();
+    EEPROM_Init();
+    f64Value = EEPROM_TEST_Read(GPTP_DEF_NVM_PDELAY);
+    EEPROM_TEST_Check(f64Value != f64Value, "blank boot reads NaN");
+    (void)EEPROM_Read_Req_CB(0u, GPTP_DEF_NVM_RRATIO);
+    EEPROM_TEST_Run(NVM_POLL_PERIOD_MS);
+    EEPROM_TEST_Check((1u == su32ReadsDone) && (sf64ReadDone != sf64ReadDone),
+                      "blank boot delivers NaN to the asynchronous read");
+
+    /* Coalescing, the updates within the interval go into one record */
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 100.0);
+    EEPROM_TEST_Write(GPTP_DEF_NVM_RRATIO, 1.5);
+    EEPROM_TEST_Run(100u);
+    EEPROM_TEST_Check((1u == srFee.u32Writes) && (1u == EEPROM_TEST_Sequence(1u)),
+                      "first commit writes one record into block 1");
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 101.0);
+    EEPROM_TEST_Run(1000u);
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 102.0);
+    EEPROM_TEST_Write(GPTP_DEF_NVM_RRATIO, 1.6);
+    EEPROM_TEST_Run(EEPROM_TEST_INTERVAL_MS - 2000u);
+    EEPROM_TEST_Check(1u == srFee.u32Writes, "no commit within the interval");
+    EEPROM_TEST_Run(2000u);
+    EEPROM_TEST_Check((2u == srFee.u32Writes) && (2u == EEPROM_TEST_Sequence(2u)) &&
+                      (1u == EEPROM_TEST_Sequence(1u)),
+                      "coalesced commit writes one record into block 2");
+    EEPROM_Init();
+    EEPROM_TEST_Check((102.0 == EEPROM_TEST_Read(GPTP_DEF_NVM_PDELAY)) &&
+                      (1.6 == EEPROM_TEST_Read(GPTP_DEF_NVM_RRATIO)),
+                      "boot loads the newest record");
+
+    /* Update while the commit is written, the commit still finishes */
+    EEPROM_TEST_FlashErase();
+    EEPROM_Init();
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 200.0);
+    EEPROM_TEST_Run(NVM_POLL_PERIOD_MS);
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 201.0);
+    EEPROM_TEST_Run(EEPROM_TEST_INTERVAL_MS + 100u);
+    EEPROM_TEST_Check((2u == srFee.u32Writes) && (1u == srFee.au16Writes[0u]) && (2u == srFee.au16Writes[1u]),
+                      "update during a commit goes into the other block");
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 202.0);
+    srFee.bFailNextWrite = true;
+    EEPROM_TEST_Run(EEPROM_TEST_INTERVAL_MS + 100u);
+    EEPROM_TEST_Check((3u == srFee.u32Writes) && (1u == srFee.au16Writes[2u]),
+                      "commits keep alternating the blocks");
+    EEPROM_Init();
+    EEPROM_TEST_Check(201.0 == EEPROM_TEST_Read(GPTP_DEF_NVM_PDELAY),
+                      "torn write keeps the record of the other block");
+
+    /* Failed commit is retried into the same block */
+    EEPROM_TEST_FlashErase();
+    EEPROM_Init();
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 300.0);
+    EEPROM_TEST_Run(100u);
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 301.0);
+    srFee.bFailNextWrite = true;
+    EEPROM_TEST_Run(EEPROM_TEST_INTERVAL_MS);
+    EEPROM_TEST_Check((2u == srFee.u32Writes) && (2u == srFee.au16Writes[1u]), "second commit fails");
+    EEPROM_TEST_Run(EEPROM_TEST_INTERVAL_MS);
+    EEPROM_TEST_Check((3u == srFee.u32Writes) && (2u == srFee.au16Writes[2u]) && (1u == EEPROM_TEST_Sequence(1u)),
+                      "failed commit is retried into the same block");
+    EEPROM_Init();
+    EEPROM_TEST_Check(301.0 == EEPROM_TEST_Read(GPTP_DEF_NVM_PDELAY), "boot loads the retried record");
+
+    /* Torn newest record, the boot falls back to the older one */
+    srFee.au8Flash[2u][EEPROM_TEST_RECORD_SIZE - 1u] ^= 0xFFu;
+    EEPROM_Init();
+    EEPROM_TEST_Check(300.0 == EEPROM_TEST_Read(GPTP_DEF_NVM_PDELAY), "boot with a torn newest record loads the older one");
+    EEPROM_TEST_Write(GPTP_DEF_NVM_PDELAY, 302.0);
+    EEPROM_TEST_Run(100u);
+    EEPROM_TEST_Check((4u == srFee.u32Writes) && (2u == srFee.au16Writes[3u]),
+                      "next commit overwrites the torn record");
+
+    printf("%u check(s) failed\n", su32Failed);
+
+    return (0u == su32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/* Host stub of the Fee driver API used by eeprom.c, implemented by the test. */
+
+#ifndef FEE_H
+#define FEE_H
+
+#include "Std_Types.h"
+
+#define FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_0       (1U)
+#define FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_1       (2U)
+
+typedef uint8                           Fee_ConfigType;
+
+typedef enum
+{
+    MEMIF_UNINIT = 0,
+    MEMIF_IDLE,
+    MEMIF_BUSY,
+    MEMIF_BUSY_INTERNAL
+}MemIf_StatusType;
+
+typedef enum
+{
+    MEMIF_JOB_OK = 0,
+    MEMIF_JOB_FAILED,
+    MEMIF_JOB_PENDING,
+    MEMIF_JOB_CANCELED,
+    MEMIF_BLOCK_INCONSISTENT,
+    MEMIF_BLOCK_INVALID
+}MemIf_JobResultType;
+
+void Fee_Init(const Fee_ConfigType *ConfigPtr);
+Std_ReturnType Fee_Read(uint16 BlockNumber, uint16 BlockOffset, uint8 *DataBufferPtr, uint16 Length);
+Std_ReturnType Fee_Write(uint16 BlockNumber, const uint8 *DataBufferPtr);
+MemIf_StatusType Fee_GetStatus(void);
+MemIf_JobResultType Fee_GetJobResult(void);
+void Fee_MainFunction(void);
+
+#endif /* FEE_H */
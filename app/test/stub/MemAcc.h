@@ -0,0 +1,26 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/* Host stub of the MemAcc driver API used by eeprom.c. */
+
+#ifndef MEMACC_H
+#define MEMACC_H
+
+#include "Std_Types.h"
+
+typedef uint8                           MemAcc_ConfigType;
+
+void MemAcc_Init(const MemAcc_ConfigType *ConfigPtr);
+
+#endif /* MEMACC_H */
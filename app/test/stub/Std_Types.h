@@ -0,0 +1,32 @@
+/*
+ *  Copyright 2024 NXP
+ *
+ *  NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only
+ *  be used strictly in accordance with the applicable license terms. By
+ *  expressly accepting such terms or by downloading, installing, activating
+ *  and/or otherwise using the software, you are agreeing that you have read,
+ *  and that you agree to comply with and are bound by, such license terms. If
+ *  you do not agree to be bound by the applicable license terms, then you may
+ *  not retain, install, activate or otherwise use the software.
+ *
+ *  This file contains sample code only. It is not part of the production code deliverables.
+ */
+
+/* Host stub of the AUTOSAR standard types used by eeprom.c. */
+
+#ifndef STD_TYPES_H
+#define STD_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef bool                            boolean;
+typedef uint8_t                         uint8;
+typedef uint16_t                        uint16;
+typedef uint8_t                         Std_ReturnType;
+
+#define E_OK                            ((Std_ReturnType)0x00U)
+#define E_NOT_OK                        ((Std_ReturnType)0x01U)
+#define NULL_PTR                        ((void *)0)
+
+#endif /* STD_TYPES_H */
@@ -92,6 +92,7 @@ instance:
       - pfDomSelectionCB: 'GPTP_DomainSelectionCB'
       - pfNvmWriteCallback: 'GPTP_NVMWriteCB'
       - pfNvmReadCallback: 'GPTP_NVMReadCB'
+      - pfNvmReadReqCallback: 'GPTP_NVMReadReqCB'
       - pfErrNotifyCallback: 'GPTP_ErrorNotifyCB'
       - pfSynNotifyCallback: 'GPTP_SyncNotifyCB'
       - GptpDefMapTable:
@@ -312,6 +313,7 @@ gptp_def_init_params_t                  rGptpCfgParams =
     .rPtpStackCallBacks.pfDomSelectionCB = GPTP_DomainSelectionCB,
     .rPtpStackCallBacks.pfNvmWriteCB = GPTP_NVMWriteCB,
     .rPtpStackCallBacks.pfNvmReadCB = GPTP_NVMReadCB,
+    .rPtpStackCallBacks.pfNvmReadReqCB = GPTP_NVMReadReqCB,
     .rPtpStackCallBacks.pfErrNotify = GPTP_ErrorNotifyCB,
     .rPtpStackCallBacks.pfSynNotify = GPTP_SyncNotifyCB
 };
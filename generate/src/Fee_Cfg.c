@@ -115,7 +115,7 @@ const Fee_BlockConfigType Fee_BlockConfig[FEE_CRT_CFG_NR_OF_BLOCKS] =
     /*FeeBlockConfiguration_0*/
     {
         FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_0, /* FeeBlockNumber symbol */
-        8U, /* FeeBlockSize */
+        24U, /* FeeBlockSize */
         0U, /* FeeClusterGroup */
         (boolean)FALSE, /* FeeImmediateData */
         FEE_PROJECT_RESERVED /* Fee Block Assignment to a project */
@@ -123,7 +123,7 @@ const Fee_BlockConfigType Fee_BlockConfig[FEE_CRT_CFG_NR_OF_BLOCKS] =
     /*FeeBlockConfiguration_1*/
     {
         FeeConf_FeeBlockConfiguration_FeeBlockConfiguration_1, /* FeeBlockNumber symbol */
-        8U, /* FeeBlockSize */
+        24U, /* FeeBlockSize */
         0U, /* FeeClusterGroup */
         (boolean)FALSE, /* FeeImmediateData */
         FEE_PROJECT_RESERVED /* Fee Block Assignment to a project */
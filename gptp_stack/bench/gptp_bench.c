@@ -0,0 +1,1501 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_bench.c
+ *
+ * @details Host micro-benchmarks of the gPTP core hot path. The core runs on
+ *          the simulated Linux platform as a bridge: gPTP port 0 is the slave
+ *          port of every domain, the remaining ports are master ports. A fake
+ *          neighbour behind each port answers Pdelay requests and the fake GM
+ *          behind port 0 sends Sync/Follow_Up, so the measured functions run
+ *          on a converged network.
+ *
+ *          Each benchmark reports nanoseconds per call and, where the Linux
+ *          perf counters are accessible, user space instructions retired per
+ *          call. Results are written as JSON to stdout or to the -o file.
+ *
+ *          Build (16 ports need the larger limits):
+ *
+ *          gcc -std=gnu99 -O2 -DGPTP_DEF_PORTS_MAX=16u
+ *              -DGPTP_PORT_SIM_CTRL_MAX=16u
+ *              -DGPTP_PORT_SIM_QUEUE_LEN=128u -Igptp_stack/port/linux
+ *              -Igptp_stack/port -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c
+ *              gptp_stack/bench/gptp_bench.c -o gptp_bench -lm
+ *
+ *          Optional -DGPTP_BENCH_REVISION=\"<git hash>\" tags the report.
+ *          A second build with -DGPTP_PORT_NO_BSWAP gives the byte by byte
+ *          frame serialization as the baseline of the frame_* results.
+ *          With -DGPTP_TX_TEMPLATES, frame_build measures the template patch,
+ *          the first call of each case builds the template.
+ *
+ *          Usage: gptp_bench [-n calls] [-r repetitions] [-f filter] [-o file]
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif /* __linux__ */
+
+#include "gptp.h"
+#include "gptp_def.h"
+#include "gptp_frame.h"
+#include "gptp_pi.h"
+#include "gptp_kf.h"
+#include "gptp_sync.h"
+#include "gptp_pdelay.h"
+#include "gptp_timer.h"
+#include "gptp_signaling.h"
+#include "gptp_port.h"
+#include "gptp_port_platform.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#ifndef GPTP_BENCH_REVISION
+#define GPTP_BENCH_REVISION             "unknown"
+#endif
+
+/*! Maximal count of gPTP ports of the benchmarked bridge. */
+#define GPTP_BENCH_PORTS_MAX            (16u)
+/*! Maximal count of gPTP domains of the benchmarked bridge. */
+#define GPTP_BENCH_DOMAINS_MAX          (4u)
+/*! Default count of measured calls per repetition. */
+#define GPTP_BENCH_CALLS_DEF            (20000u)
+/*! Default count of repetitions. */
+#define GPTP_BENCH_REPS_DEF             (5u)
+/*! Calls timed together for the benchmarks without per-call preparation. */
+#define GPTP_BENCH_WINDOW_CALLS         (16u)
+/*! Count of empty windows used for the overhead calibration. */
+#define GPTP_BENCH_CALIB_WINDOWS        (10000u)
+/*! Simulated time the network runs before each benchmark. */
+#define GPTP_BENCH_WARMUP_MS            (10000u)
+/*! GPTP_TimerPeriodic period, same as in the sample application. */
+#define GPTP_BENCH_TIMER_PERIOD_MS      (9u)
+/*! Sync interval of the fake GM (log -3). */
+#define GPTP_BENCH_SYNC_PERIOD_MS       (125u)
+/*! Pdelay interval of the fake neighbours (log 0). */
+#define GPTP_BENCH_PDELAY_PERIOD_MS     (1000u)
+/*! Nanoseconds in one millisecond. */
+#define GPTP_BENCH_NS_IN_MS             (1000000u)
+/*! Oscillator error of the bridge. */
+#define GPTP_BENCH_DRIFT_PPB            (10000)
+/*! Clock ID of the bridge (all ports). */
+#define GPTP_BENCH_LOCAL_CLOCK_ID       (0x020000FFFE000001u)
+/*! Clock ID of the fake GM and neighbours. */
+#define GPTP_BENCH_NBR_CLOCK_ID         (0x001122FFFE334455u)
+/*! MAC address of the fake GM and neighbours. */
+#define GPTP_BENCH_NBR_MAC              (0x001122334455u)
+/*! VLAN TCI used by the VLAN variants (priority 7, VID 2). */
+#define GPTP_BENCH_VLAN_TCI             (0xE002u)
+/*! Size of the frame buffers. */
+#define GPTP_BENCH_FRAME_LEN            (128u)
+/*! Length of the Ethernet header including VLAN tag. */
+#define GPTP_BENCH_ETH_VLAN_HDR_LEN     (GPTP_DEF_ETH_II_LEN + GPTP_DEF_ETH_VLAN_LEN)
+/*! Count of pseudo-random time errors fed to the PI controller. */
+#define GPTP_BENCH_PI_ERRORS            (256u)
+/*! Count of benchmarked message types. */
+#define GPTP_BENCH_MSG_TYPES            (6u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Benchmark case.
+ */
+typedef struct
+{
+    /*! Benchmarked function group. */
+    const char                          *pcName;
+    /*! Variant within the group. */
+    const char                          *pcVariant;
+    /*! VLAN tagged frames. */
+    bool                                bVlan;
+    /*! Count of gPTP ports of the bridge. */
+    uint8_t                             u8Ports;
+    /*! Count of gPTP domains of the bridge. */
+    uint8_t                             u8Domains;
+    /*! Untimed preparation of one call, calls are timed one by one if set. */
+    void                                (*pfPrepare)(uint32_t u32Call);
+    /*! Measured call. */
+    void                                (*pfCall)(uint32_t u32Call);
+    /*! Untimed network service after each timed window. */
+    void                                (*pfService)(void);
+}gptp_bench_case_t;
+
+/*!
+ * @brief Benchmark result.
+ */
+typedef struct
+{
+    /*! Median of the per-call time over all windows [ns]. */
+    float64_t                           f64NsMedian;
+    /*! Mean per-call time [ns]. */
+    float64_t                           f64NsMean;
+    /*! Lowest per-call time of a window [ns]. */
+    float64_t                           f64NsMin;
+    /*! Mean count of instructions per call, negative if not measured. */
+    float64_t                           f64Instructions;
+}gptp_bench_result_t;
+
+/*!
+ * @brief Message type description.
+ */
+typedef struct
+{
+    /*! Message type. */
+    gptp_def_msg_type_t                 eMsgType;
+    /*! Name in the report. */
+    const char                          *pcName;
+}gptp_bench_msg_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint64_t GPTP_BENCH_NowNs(void);
+static int GPTP_BENCH_PerfOpen(void);
+static uint64_t GPTP_BENCH_PerfRead(void);
+static void GPTP_BENCH_Put(uint8_t *pu8Dst, uint64_t u64Value, uint8_t u8Bytes);
+static uint16_t GPTP_BENCH_FrameCraft(uint8_t *pu8Frame,
+                                      gptp_def_msg_type_t eMsgType,
+                                      uint8_t u8Domain,
+                                      uint16_t u16SequenceId,
+                                      uint64_t u64TimeNs,
+                                      const gptp_def_clock_port_id_t *cprRequesting);
+static void GPTP_BENCH_RxDataSet(gptp_def_rx_data_t *prRxData,
+                                 const uint8_t *cpu8Frame,
+                                 uint8_t u8Port);
+static void GPTP_BENCH_NetPush(uint8_t u8Port,
+                               gptp_def_msg_type_t eMsgType,
+                               uint8_t u8Domain,
+                               uint16_t u16SequenceId,
+                               const gptp_def_clock_port_id_t *cprRequesting);
+static bool GPTP_BENCH_NetReqGet(const gptp_port_sim_frame_t *cprFrame,
+                                 uint16_t *pu16SequenceId,
+                                 gptp_def_clock_port_id_t *prRequesting);
+static void GPTP_BENCH_NetService(void);
+static void GPTP_BENCH_NetAdvance(uint32_t u32Ms, bool bTimer);
+static void GPTP_BENCH_Setup(uint8_t u8Ports, uint8_t u8Domains, bool bVlan);
+static void GPTP_BENCH_ParseCall(uint32_t u32Call);
+static void GPTP_BENCH_BuildCall(uint32_t u32Call);
+static void GPTP_BENCH_HdrDecodeCall(uint32_t u32Call);
+static void GPTP_BENCH_HdrEncodeCall(uint32_t u32Call);
+static void GPTP_BENCH_PiCall(uint32_t u32Call);
+static void GPTP_BENCH_SyncPrepare(uint32_t u32Call);
+static void GPTP_BENCH_SyncCall(uint32_t u32Call);
+static void GPTP_BENCH_SyncService(void);
+static void GPTP_BENCH_PdelayPrepare(uint32_t u32Call);
+static void GPTP_BENCH_PdelayCall(uint32_t u32Call);
+static void GPTP_BENCH_TimerPrepare(uint32_t u32Call);
+static void GPTP_BENCH_TimerCall(uint32_t u32Call);
+static int GPTP_BENCH_Compare(const void *cpvA, const void *cpvB);
+static void GPTP_BENCH_Calibrate(void);
+static void GPTP_BENCH_Run(const gptp_bench_case_t *cprCase,
+                           gptp_bench_result_t *prResult);
+static void GPTP_BENCH_Report(FILE *prOut,
+                              const gptp_bench_case_t *cprCase,
+                              const gptp_bench_result_t *cprResult,
+                              bool bFirst);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const gptp_bench_msg_t scarMsgTypes[GPTP_BENCH_MSG_TYPES] =
+{
+    {GPTP_DEF_MSG_TYPE_SYNC, "sync"},
+    {GPTP_DEF_MSG_TYPE_FOLLOW_UP, "follow_up"},
+    {GPTP_DEF_MSG_TYPE_PD_REQ, "pdelay_req"},
+    {GPTP_DEF_MSG_TYPE_PD_RESP, "pdelay_resp"},
+    {GPTP_DEF_MSG_TYPE_PD_RESP_FUP, "pdelay_resp_fup"},
+    {GPTP_DEF_MSG_TYPE_SIGNALING, "signaling"}
+};
+
+static const uint8_t scau8Ports[] = {1u, 4u, 16u};
+static const uint8_t scau8Domains[] = {1u, 2u, 4u};
+
+static const gptp_def_pi_controller_conf_t scrPiConf = {100000u, 1.0, 12.0};
+static const gptp_def_kf_conf_t scrKfConf = {1.0, 1.0, 1000.0, 0.3, 100000u};
+
+/* Bridge configuration and run-time data */
+static gptp_def_port_t                  sarPort[GPTP_BENCH_PORTS_MAX];
+static gptp_def_domain_t                sarDomain[GPTP_BENCH_DOMAINS_MAX];
+static gptp_def_pdelay_t                sarPdelay[GPTP_BENCH_PORTS_MAX];
+static gptp_def_sync_t                  sarSync[GPTP_BENCH_DOMAINS_MAX][GPTP_BENCH_PORTS_MAX];
+static gptp_def_map_table_t             sarMapTable[GPTP_BENCH_PORTS_MAX];
+static gptp_def_tx_frame_map_t          sarMapSync[GPTP_BENCH_DOMAINS_MAX][GPTP_BENCH_PORTS_MAX];
+static gptp_def_tx_frame_map_t          sarMapFup[GPTP_BENCH_DOMAINS_MAX][GPTP_BENCH_PORTS_MAX];
+static gptp_def_tx_frame_map_t          sarMapSig[GPTP_BENCH_DOMAINS_MAX];
+static gptp_def_tx_frame_map_t          sarMapReq[GPTP_BENCH_PORTS_MAX];
+static gptp_def_tx_frame_map_t          sarMapResp[GPTP_BENCH_PORTS_MAX];
+static gptp_def_tx_frame_map_t          sarMapReFu[GPTP_BENCH_PORTS_MAX];
+static gptp_def_init_params_sync_t      sarSyncInit[GPTP_BENCH_DOMAINS_MAX][GPTP_BENCH_PORTS_MAX];
+static gptp_def_init_params_domain_t    sarDomainInit[GPTP_BENCH_DOMAINS_MAX];
+static gptp_def_init_params_pdel_t      sarPdelayInit[GPTP_BENCH_PORTS_MAX];
+static gptp_def_init_params_t           srInit;
+#ifdef GPTP_COUNTERS
+static gptp_def_countes_port_t          sarCntrsPort[GPTP_BENCH_PORTS_MAX];
+static gptp_def_countes_dom_t           sarCntrsDom[GPTP_BENCH_DOMAINS_MAX][GPTP_BENCH_PORTS_MAX];
+#endif /* GPTP_COUNTERS */
+
+/* Fake network state */
+static uint8_t                          su8Ports;
+static uint8_t                          su8Domains;
+static bool                             sbVlan;
+static uint32_t                         su32NetMs;
+static uint16_t                         sau16GmSeq[GPTP_BENCH_DOMAINS_MAX];
+static uint16_t                         su16NbrSeq;
+
+/* Measured call context */
+static gptp_def_data_t                  *sprGptp;
+static uint8_t                          sau8Frame[GPTP_BENCH_FRAME_LEN];
+static gptp_def_rx_data_t               srRxData;
+static gptp_def_tx_data_t               srTxData;
+static gptp_frame_hdr_t                 srHdr;
+static uint8_t                          su8TxPort;
+static gptp_def_pi_controller_t         srPi;
+static gptp_def_kf_t                    srKf;
+static int32_t                          sas32PiErrors[GPTP_BENCH_PI_ERRORS];
+static uint8_t                          su8CallDomain;
+static uint8_t                          su8CallPort;
+
+/* Measurement */
+static int                              ssPerfFd = -1;
+static uint32_t                         su32Calls = GPTP_BENCH_CALLS_DEF;
+static uint32_t                         su32Reps = GPTP_BENCH_REPS_DEF;
+static float64_t                        sf64OverheadNs;
+static float64_t                        sf64OverheadInstr;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns monotonic time.
+ * @return          Time in nanoseconds.
+*/
+static uint64_t GPTP_BENCH_NowNs(void)
+{
+    struct timespec rTs;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &rTs);
+
+    return ((uint64_t)rTs.tv_sec * (uint64_t)GPTP_DEF_NS_IN_SECONDS) + (uint64_t)rTs.tv_nsec;
+}
+
+/*!
+ * @brief           This function opens the instructions retired counter.
+ * @details         Only user space instructions of the calling thread are
+ *                  counted.
+ * @return          File descriptor, negative if the counter is not accessible.
+*/
+static int GPTP_BENCH_PerfOpen(void)
+{
+    int sFd;
+
+    sFd = -1;
+
+#ifdef __linux__
+    struct perf_event_attr rAttr;
+
+    memset(&rAttr, 0, sizeof(rAttr));
+    rAttr.type = PERF_TYPE_HARDWARE;
+    rAttr.size = sizeof(rAttr);
+    rAttr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    rAttr.disabled = 1u;
+    rAttr.exclude_kernel = 1u;
+    rAttr.exclude_hv = 1u;
+
+    sFd = (int)syscall(SYS_perf_event_open, &rAttr, 0, -1, -1, 0);
+    if (0 <= sFd)
+    {
+        (void)ioctl(sFd, PERF_EVENT_IOC_RESET, 0);
+        (void)ioctl(sFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif /* __linux__ */
+
+    return sFd;
+}
+
+/*!
+ * @brief           This function reads the instructions retired counter.
+ * @return          Counter value.
+*/
+static uint64_t GPTP_BENCH_PerfRead(void)
+{
+    uint64_t u64Value;
+
+    u64Value = 0u;
+
+    if (sizeof(u64Value) != read(ssPerfFd, &u64Value, sizeof(u64Value)))
+    {
+        u64Value = 0u;
+    }
+
+    return u64Value;
+}
+
+/*!
+ * @brief           This function stores value in the network byte order.
+ * @param[out]      pu8Dst Destination.
+ * @param[in]       u64Value Value.
+ * @param[in]       u8Bytes Count of bytes stored.
+*/
+static void GPTP_BENCH_Put(uint8_t *pu8Dst,
+                           uint64_t u64Value,
+                           uint8_t u8Bytes)
+{
+    uint8_t u8Idx;
+
+    for (u8Idx = u8Bytes; u8Idx > 0u; u8Idx--)
+    {
+        pu8Dst[u8Idx - 1u] = (uint8_t)(u64Value & 0xFFu);
+        u64Value >>= 8u;
+    }
+}
+
+/*!
+ * @brief           This function builds a frame sent by the fake neighbour.
+ *
+ * @param[out]      pu8Frame Frame buffer, GPTP_BENCH_FRAME_LEN bytes.
+ * @param[in]       eMsgType Message type.
+ * @param[in]       u8Domain Domain number.
+ * @param[in]       u16SequenceId Sequence ID.
+ * @param[in]       u64TimeNs Timestamp carried in the message body.
+ * @param[in]       cprRequesting Requesting port identity (Pdelay response
+ *                  messages only).
+ *
+ * @return          Frame length including the Ethernet header.
+*/
+static uint16_t GPTP_BENCH_FrameCraft(uint8_t *pu8Frame,
+                                      gptp_def_msg_type_t eMsgType,
+                                      uint8_t u8Domain,
+                                      uint16_t u16SequenceId,
+                                      uint64_t u64TimeNs,
+                                      const gptp_def_clock_port_id_t *cprRequesting)
+{
+    uint8_t  *pu8Ptp;
+    uint16_t u16MsgLen;
+    uint8_t  u8Control;
+    int8_t   s8LogPeriod;
+
+    memset(pu8Frame, 0, GPTP_BENCH_FRAME_LEN);
+    GPTP_BENCH_Put(&pu8Frame[0], GPTP_DEF_ETH_PTP_MAC_MULTICAST, 6u);
+    GPTP_BENCH_Put(&pu8Frame[6], GPTP_BENCH_NBR_MAC, 6u);
+
+    if (true == sbVlan)
+    {
+        GPTP_BENCH_Put(&pu8Frame[GPTP_FR_ETH_TYPE_OFFSET], GPTP_FR_ETH_TYPE_VLAN, 2u);
+        GPTP_BENCH_Put(&pu8Frame[GPTP_DEF_ETH_II_LEN], GPTP_BENCH_VLAN_TCI, 2u);
+        GPTP_BENCH_Put(&pu8Frame[GPTP_DEF_ETH_II_LEN + 2u], GPTP_FR_ETH_TYPE_PTP, 2u);
+        pu8Ptp = &pu8Frame[GPTP_BENCH_ETH_VLAN_HDR_LEN];
+    }
+    else
+    {
+        GPTP_BENCH_Put(&pu8Frame[GPTP_FR_ETH_TYPE_OFFSET], GPTP_FR_ETH_TYPE_PTP, 2u);
+        pu8Ptp = &pu8Frame[GPTP_DEF_ETH_II_LEN];
+    }
+
+    switch (eMsgType)
+    {
+        case GPTP_DEF_MSG_TYPE_SYNC:
+            u16MsgLen = GPTP_DEF_SYNC_MSG_LEN;
+            u8Control = GPTP_FR_CONTROL_SYNC;
+            s8LogPeriod = -3;
+            /* Two-step flag */
+            pu8Ptp[6] = 0x02u;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
+            u16MsgLen = GPTP_DEF_FOLLOW_UP_MSG_LEN;
+            u8Control = GPTP_FR_CONTROL_FOLLOW_UP;
+            s8LogPeriod = -3;
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_DEF_SYNC_MSG_LEN], GPTP_FR_FUP_TLV_TYPE, 2u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_DEF_SYNC_MSG_LEN + 2u], GPTP_FR_FUP_TLV_FIELD_LEN, 2u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_DEF_SYNC_MSG_LEN + 4u], GPTP_FR_FUP_TLV_ORGANIZATION_ID, 3u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_DEF_SYNC_MSG_LEN + 7u], GPTP_FR_FUP_TLV_ORG_SUB_TYPE, 3u);
+        break;
+
+        case GPTP_DEF_MSG_TYPE_PD_REQ:
+            u16MsgLen = GPTP_DEF_PDELAY_REQ_MSG_LEN;
+            u8Control = GPTP_FR_CONTROL_OTHER;
+            s8LogPeriod = 0;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_PD_RESP:
+        case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
+            u16MsgLen = GPTP_DEF_PDELAY_RESP_MSG_LEN;
+            u8Control = GPTP_FR_CONTROL_OTHER;
+            s8LogPeriod = (int8_t)GPTP_FR_LOG_MSG_PERIOD_STOP;
+            if (GPTP_DEF_MSG_TYPE_PD_RESP == eMsgType)
+            {
+                /* Two-step flag */
+                pu8Ptp[6] = 0x02u;
+            }
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_RQ_CLK_ID_OFFSET], cprRequesting->u64ClockId, 8u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_RQ_PORT_ID_OFFSET], cprRequesting->u16PortId, 2u);
+        break;
+
+        default:
+            /* Signaling - message interval request, Sync interval 250 ms */
+            u16MsgLen = GPTP_DEF_SIGNALING_MSG_LEN;
+            u8Control = GPTP_FR_CONTROL_OTHER;
+            s8LogPeriod = (int8_t)GPTP_FR_LOG_MSG_PERIOD_STOP;
+            memset(&pu8Ptp[GPTP_FR_TS_S_OFFSET], 0xFF, 10u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_TS_S_OFFSET + 10u], GPTP_FR_SIG_TLV_TYPE, 2u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_TS_S_OFFSET + 12u], GPTP_FR_SIG_TLV_FIELD_LEN, 2u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_TS_S_OFFSET + 14u], GPTP_FR_SIG_TLV_ORGANIZATION_ID, 3u);
+            GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_SIG_ORG_SUBTYPE_OFFSET + 1u], GPTP_FR_SIG_TLV_OSUB_T_MSG_INT, 3u);
+            pu8Ptp[GPTP_FR_SIG_TIME_SYNC_OFFSET - 1u] = (uint8_t)GPTP_DEF_SIG_TLV_NOT_CHANGE;
+            pu8Ptp[GPTP_FR_SIG_TIME_SYNC_OFFSET] = (uint8_t)(-2);
+            pu8Ptp[GPTP_FR_SIG_TIME_SYNC_OFFSET + 1u] = (uint8_t)GPTP_DEF_SIG_TLV_NOT_CHANGE;
+        break;
+    }
+
+    pu8Ptp[GPTP_FR_MSG_ID_OFFSET] = (uint8_t)((uint8_t)GPTP_DEF_TRANSPORT_SPEC_1 | (uint8_t)eMsgType);
+    pu8Ptp[1] = 2u;
+    GPTP_BENCH_Put(&pu8Ptp[2], u16MsgLen, 2u);
+    pu8Ptp[GPTP_FR_DOMAIN_NUM] = u8Domain;
+    GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_SC_CLK_ID_OFFSET], GPTP_BENCH_NBR_CLOCK_ID, 8u);
+    GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_SC_PORT_ID_OFFSET], 1u, 2u);
+    GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_SEQ_ID_OFFSET], u16SequenceId, 2u);
+    pu8Ptp[GPTP_FR_SEQ_ID_OFFSET + 2u] = u8Control;
+    pu8Ptp[GPTP_FR_MSG_PER_LOG_OFFSET] = (uint8_t)s8LogPeriod;
+
+    if ((GPTP_DEF_MSG_TYPE_FOLLOW_UP == eMsgType) ||
+        (GPTP_DEF_MSG_TYPE_PD_RESP == eMsgType) ||
+        (GPTP_DEF_MSG_TYPE_PD_RESP_FUP == eMsgType))
+    {
+        GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_TS_S_OFFSET], u64TimeNs / GPTP_DEF_NS_IN_SECONDS, 6u);
+        GPTP_BENCH_Put(&pu8Ptp[GPTP_FR_TS_NS_OFFSET], u64TimeNs % GPTP_DEF_NS_IN_SECONDS, 4u);
+    }
+
+    return (uint16_t)((uint16_t)(pu8Ptp - pu8Frame) + u16MsgLen);
+}
+
+/*!
+ * @brief           This function fills RX data the way the port layer does.
+ * @param[out]      prRxData RX data.
+ * @param[in]       cpu8Frame Full Ethernet frame.
+ * @param[in]       u8Port Receiving gPTP port.
+*/
+static void GPTP_BENCH_RxDataSet(gptp_def_rx_data_t *prRxData,
+                                 const uint8_t *cpu8Frame,
+                                 uint8_t u8Port)
+{
+    gptp_def_timestamp_t rNow;
+
+    rNow = GPTP_PORT_SimClockGet();
+
+    prRxData->u8PtpPort = u8Port;
+    prRxData->u32TsSec = (uint32_t)rNow.u64TimeStampS;
+    prRxData->u32TsNsec = rNow.u32TimeStampNs;
+    prRxData->cpu8RxData = &cpu8Frame[GPTP_DEF_ETH_II_LEN];
+    prRxData->u16EthType = (uint16_t)(((uint16_t)cpu8Frame[GPTP_FR_ETH_TYPE_OFFSET] << 8u) |
+                                      (uint16_t)cpu8Frame[GPTP_FR_ETH_TYPE_OFFSET + 1u]);
+    prRxData->u64SourceMac = GPTP_BENCH_NBR_MAC;
+}
+
+/*!
+ * @brief           This function sends a frame from the fake neighbour.
+ * @details         The body timestamp is the neighbour time, i.e. the free
+ *                  running time of the simulation.
+ * @param[in]       u8Port Receiving gPTP port.
+ * @param[in]       eMsgType Message type.
+ * @param[in]       u8Domain Domain number.
+ * @param[in]       u16SequenceId Sequence ID.
+ * @param[in]       cprRequesting Requesting port identity.
+*/
+static void GPTP_BENCH_NetPush(uint8_t u8Port,
+                               gptp_def_msg_type_t eMsgType,
+                               uint8_t u8Domain,
+                               uint16_t u16SequenceId,
+                               const gptp_def_clock_port_id_t *cprRequesting)
+{
+    uint8_t  au8Frame[GPTP_BENCH_FRAME_LEN];
+    uint16_t u16Len;
+
+    u16Len = GPTP_BENCH_FrameCraft(au8Frame, eMsgType, u8Domain, u16SequenceId,
+                                   GPTP_PORT_GetFreeRunningTimer(), cprRequesting);
+    (void)GPTP_PORT_SimRxPush(u8Port, au8Frame, u16Len);
+}
+
+/*!
+ * @brief           This function checks whether the bridge sent Pdelay_Req.
+ * @param[in]       cprFrame Frame taken from the simulated wire.
+ * @param[out]      pu16SequenceId Sequence ID of the request.
+ * @param[out]      prRequesting Source port identity of the request.
+ * @return          true in case of Pdelay_Req.
+*/
+static bool GPTP_BENCH_NetReqGet(const gptp_port_sim_frame_t *cprFrame,
+                                 uint16_t *pu16SequenceId,
+                                 gptp_def_clock_port_id_t *prRequesting)
+{
+    const uint8_t *cpu8Ptp;
+    uint8_t       u8Idx;
+    bool          bReq;
+
+    cpu8Ptp = &cprFrame->au8Data[GPTP_DEF_ETH_II_LEN];
+    if ((((uint16_t)cprFrame->au8Data[GPTP_FR_ETH_TYPE_OFFSET] << 8u) | cprFrame->au8Data[GPTP_FR_ETH_TYPE_OFFSET + 1u]) == GPTP_FR_ETH_TYPE_VLAN)
+    {
+        cpu8Ptp = &cprFrame->au8Data[GPTP_BENCH_ETH_VLAN_HDR_LEN];
+    }
+
+    bReq = ((uint8_t)GPTP_DEF_MSG_TYPE_PD_REQ == (cpu8Ptp[GPTP_FR_MSG_ID_OFFSET] & 0x0Fu));
+
+    if (true == bReq)
+    {
+        *pu16SequenceId = (uint16_t)(((uint16_t)cpu8Ptp[GPTP_FR_SEQ_ID_OFFSET] << 8u) | cpu8Ptp[GPTP_FR_SEQ_ID_OFFSET + 1u]);
+        prRequesting->u64ClockId = 0u;
+        for (u8Idx = 0u; u8Idx < 8u; u8Idx++)
+        {
+            prRequesting->u64ClockId = (prRequesting->u64ClockId << 8u) | cpu8Ptp[GPTP_FR_SC_CLK_ID_OFFSET + u8Idx];
+        }
+        prRequesting->u16PortId = (uint16_t)(((uint16_t)cpu8Ptp[GPTP_FR_SC_PORT_ID_OFFSET] << 8u) | cpu8Ptp[GPTP_FR_SC_PORT_ID_OFFSET + 1u]);
+    }
+
+    return bReq;
+}
+
+/*!
+ * @brief           This function delivers all pending frames and confirmations.
+ * @details         Pdelay requests of the bridge are answered by the fake
+ *                  neighbour, other transmitted frames are dropped.
+*/
+static void GPTP_BENCH_NetService(void)
+{
+    static gptp_port_sim_frame_t srFrame;
+    gptp_def_clock_port_id_t     rRequesting;
+    uint16_t                     u16SequenceId;
+    bool                         bFrames;
+
+    do
+    {
+        GPTP_PORT_SimPoll();
+
+        bFrames = false;
+        while (true == GPTP_PORT_SimTxPop(&srFrame))
+        {
+            bFrames = true;
+            if (true == GPTP_BENCH_NetReqGet(&srFrame, &u16SequenceId, &rRequesting))
+            {
+                GPTP_BENCH_NetPush(srFrame.u8CtrlIdx, GPTP_DEF_MSG_TYPE_PD_RESP, 0u, u16SequenceId, &rRequesting);
+                GPTP_BENCH_NetPush(srFrame.u8CtrlIdx, GPTP_DEF_MSG_TYPE_PD_RESP_FUP, 0u, u16SequenceId, &rRequesting);
+            }
+        }
+    } while (true == bFrames);
+}
+
+/*!
+ * @brief           This function runs the fake network.
+ * @param[in]       u32Ms Simulated time to run [ms].
+ * @param[in]       bTimer Call GPTP_TimerPeriodic in the application period.
+*/
+static void GPTP_BENCH_NetAdvance(uint32_t u32Ms,
+                                  bool bTimer)
+{
+    uint32_t u32Step;
+    uint8_t  u8Idx;
+
+    for (u32Step = 0u; u32Step < u32Ms; u32Step++)
+    {
+        GPTP_PORT_IncFreeRunningTimer(GPTP_BENCH_NS_IN_MS);
+        su32NetMs++;
+
+        if ((true == bTimer) && (0u == (su32NetMs % GPTP_BENCH_TIMER_PERIOD_MS)))
+        {
+            GPTP_TimerPeriodic();
+        }
+
+        if (0u == (su32NetMs % GPTP_BENCH_SYNC_PERIOD_MS))
+        {
+            for (u8Idx = 0u; u8Idx < su8Domains; u8Idx++)
+            {
+                GPTP_BENCH_NetPush(0u, GPTP_DEF_MSG_TYPE_SYNC, u8Idx, sau16GmSeq[u8Idx], NULL);
+                GPTP_BENCH_NetPush(0u, GPTP_DEF_MSG_TYPE_FOLLOW_UP, u8Idx, sau16GmSeq[u8Idx], NULL);
+                sau16GmSeq[u8Idx]++;
+                GPTP_BENCH_NetService();
+            }
+        }
+
+        if (0u == (su32NetMs % GPTP_BENCH_PDELAY_PERIOD_MS))
+        {
+            for (u8Idx = 0u; u8Idx < su8Ports; u8Idx++)
+            {
+                GPTP_BENCH_NetPush(u8Idx, GPTP_DEF_MSG_TYPE_PD_REQ, 0u, su16NbrSeq, NULL);
+            }
+            su16NbrSeq++;
+        }
+
+        GPTP_BENCH_NetService();
+    }
+}
+
+/*!
+ * @brief           This function initializes the bridge and lets it converge.
+ * @param[in]       u8Ports Count of gPTP ports.
+ * @param[in]       u8Domains Count of gPTP domains.
+ * @param[in]       bVlan VLAN tagged frames.
+*/
+static void GPTP_BENCH_Setup(uint8_t u8Ports,
+                             uint8_t u8Domains,
+                             bool bVlan)
+{
+    gptp_def_init_params_pdel_t   *prPdel;
+    gptp_def_init_params_domain_t *prDom;
+    gptp_def_init_params_sync_t   *prSync;
+    gptp_err_type_t               eErr;
+    uint8_t                       u8Port;
+    uint8_t                       u8Dom;
+
+    su8Ports = u8Ports;
+    su8Domains = u8Domains;
+    sbVlan = bVlan;
+    su32NetMs = 0u;
+    su16NbrSeq = 0u;
+    memset(sau16GmSeq, 0, sizeof(sau16GmSeq));
+
+    memset(sarPort, 0, sizeof(sarPort));
+    memset(sarDomain, 0, sizeof(sarDomain));
+    memset(sarPdelay, 0, sizeof(sarPdelay));
+    memset(sarSync, 0, sizeof(sarSync));
+    memset(sarPdelayInit, 0, sizeof(sarPdelayInit));
+    memset(sarDomainInit, 0, sizeof(sarDomainInit));
+    memset(sarSyncInit, 0, sizeof(sarSyncInit));
+    memset(&srInit, 0, sizeof(srInit));
+
+    GPTP_PORT_SimInit();
+    GPTP_PORT_SimClockDriftSet(GPTP_BENCH_DRIFT_PPB);
+
+    for (u8Port = 0u; u8Port < u8Ports; u8Port++)
+    {
+        GPTP_PORT_SimLinkSet(u8Port, true);
+
+        sarMapTable[u8Port].u8SwitchPort = u8Port;
+        sarMapTable[u8Port].u8Switch = 0u;
+
+        prPdel = &sarPdelayInit[u8Port];
+        prPdel->bPdelayInitiatorEnabled = true;
+        prPdel->s8PdelIntervalLogInit = 0;
+        prPdel->s8PdelIntervalLogOper = 0;
+        prPdel->u64NeighborPropDelayThreshNs = 20000u;
+        prPdel->u16MeasurementsTillSlowDown = 50u;
+        prPdel->u16PdelLostReponsesAllowedCnt = 3u;
+        prPdel->u64ClockId = GPTP_BENCH_LOCAL_CLOCK_ID;
+        prPdel->prFrameMapReq = &sarMapReq[u8Port];
+        prPdel->prFrameMapResp = &sarMapResp[u8Port];
+        prPdel->prFrameMapReFu = &sarMapReFu[u8Port];
+    }
+
+    for (u8Dom = 0u; u8Dom < u8Domains; u8Dom++)
+    {
+        for (u8Port = 0u; u8Port < u8Ports; u8Port++)
+        {
+            /* Machine index equals the port, port 0 is the slave port */
+            prSync = &sarSyncInit[u8Dom][u8Port];
+            prSync->u8GptpPort = u8Port;
+            prSync->bMachineRole = (0u != u8Port);
+            prSync->s8SyncIntervalLog = -3;
+            prSync->prFrameMapSync = &sarMapSync[u8Dom][u8Port];
+            prSync->prFrameMapFup = &sarMapFup[u8Dom][u8Port];
+        }
+
+        prDom = &sarDomainInit[u8Dom];
+        prDom->u8DomainNumber = u8Dom;
+        prDom->u8NumberOfSyncMachines = u8Ports;
+        prDom->u8RefDomForSynced = u8Dom;
+        prDom->u8StartupTimeoutS = 10u;
+        prDom->u8SyncReceiptTimeoutCnt = 3u;
+        prDom->u16VlanTci = GPTP_BENCH_VLAN_TCI;
+        prDom->u32SyncOutlierThrNs = 100000u;
+        prDom->u8OutlierIgnoreCnt = 2u;
+        prDom->bDomainIsGm = false;
+        prDom->pcrDomainSyncMachinesPtr = sarSyncInit[u8Dom];
+        prDom->prSync = sarSync[u8Dom];
+        prDom->prFrameMapSign = &sarMapSig[u8Dom];
+#ifdef GPTP_COUNTERS
+        prDom->prCntrsDom = sarCntrsDom[u8Dom];
+#endif /* GPTP_COUNTERS */
+    }
+
+    srInit.u8EthFramePrio = 7u;
+    srInit.u8GptpDomainsCount = u8Domains;
+    srInit.u16VlanTci = GPTP_BENCH_VLAN_TCI;
+    srInit.u8GptpPortsCount = u8Ports;
+    srInit.bSignalingEnabled = true;
+    srInit.bVlanEnabled = bVlan;
+    srInit.pcrPortMapTable = sarMapTable;
+    srInit.pcrPdelayMachinesParam = sarPdelayInit;
+    srInit.pcrDomainsSyncsParam = sarDomainInit;
+    srInit.rSynLockParam.i64SynTrigOfst = 60;
+    srInit.rSynLockParam.i64UnsTrigOfst = 100;
+    srInit.rSynLockParam.u16SynTrigCnt = 2u;
+    srInit.rSynLockParam.u16UnsTrigCnt = 4u;
+    srInit.f64PdelAvgWeight = 0.9;
+    srInit.f64RratioAvgWeight = 0.9;
+    srInit.f64RratioMaxDev = 0.01;
+    srInit.f64PdelayNvmWriteThr = 40.0;
+    srInit.f64RratioNvmWriteThr = 0.0000001;
+    srInit.paPort = sarPort;
+    srInit.paDomain = sarDomain;
+    srInit.paPdelay = sarPdelay;
+    srInit.rPIControllerConfig = scrPiConf;
+    srInit.u64PIControllerMaxThreshold = 50000u;
+    srInit.rPtpStackCallBacks.pfNvmWriteCB = GPTP_PORT_SimNvmWriteCB;
+    srInit.rPtpStackCallBacks.pfNvmReadCB = GPTP_PORT_SimNvmReadCB;
+#ifdef GPTP_COUNTERS
+    srInit.prCntrsPort = sarCntrsPort;
+#endif /* GPTP_COUNTERS */
+
+    eErr = GPTP_GptpInit(&srInit);
+    if (GPTP_ERR_OK != eErr)
+    {
+        fprintf(stderr, "gptp_bench: GPTP_GptpInit failed (%d)\n", (int)eErr);
+        exit(EXIT_FAILURE);
+    }
+
+    sprGptp = GPTP_GetMainStrPtr();
+
+    GPTP_BENCH_NetAdvance(GPTP_BENCH_WARMUP_MS, true);
+}
+
+/*!
+ * @brief           Measured call - GPTP_FRAME_ParseRx.
+ * @details         The sequence ID changes every call, so the duplicate
+ *                  detection of the Pdelay messages does not kick in.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_ParseCall(uint32_t u32Call)
+{
+    gptp_def_msg_type_t eMsgType;
+    uint8_t             u8Domain;
+    uint8_t             u8Machine;
+    uint8_t             *pu8Seq;
+
+    pu8Seq = (uint8_t *)&srRxData.cpu8RxData[(sbVlan ? GPTP_DEF_ETH_VLAN_LEN : 0u) + GPTP_FR_SEQ_ID_OFFSET];
+    pu8Seq[0] = (uint8_t)(u32Call >> 8u);
+    pu8Seq[1] = (uint8_t)u32Call;
+
+    (void)GPTP_FRAME_ParseRx(srRxData, sprGptp, &eMsgType, &u8Domain, &u8Machine);
+}
+
+/*!
+ * @brief           Measured call - GPTP_FRAME_BuildTx.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_BuildCall(uint32_t u32Call)
+{
+    srTxData.u16SequenceId = (uint16_t)u32Call;
+
+    GPTP_FRAME_BuildTx(sprGptp, &srTxData, 0u, su8TxPort);
+}
+
+/*!
+ * @brief           Measured call - GPTP_FRAME_HdrDecode.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_HdrDecodeCall(uint32_t u32Call)
+{
+    /* The header follows the 14 byte Ethernet header, so it is not word aligned */
+    sau8Frame[GPTP_DEF_ETH_II_LEN + GPTP_FR_SEQ_ID_OFFSET + 1u] = (uint8_t)u32Call;
+
+    GPTP_FRAME_HdrDecode(&sau8Frame[GPTP_DEF_ETH_II_LEN], &srHdr);
+}
+
+/*!
+ * @brief           Measured call - GPTP_FRAME_HdrEncode.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_HdrEncodeCall(uint32_t u32Call)
+{
+    srHdr.u16SequenceId = (uint16_t)u32Call;
+
+    GPTP_FRAME_HdrEncode(&sau8Frame[GPTP_DEF_ETH_II_LEN], &srHdr);
+}
+
+/*!
+ * @brief           Measured call - GPTP_PI_Update.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_PiCall(uint32_t u32Call)
+{
+    (void)GPTP_PI_Update(&srPi, -3, sas32PiErrors[u32Call % GPTP_BENCH_PI_ERRORS]);
+}
+
+/*!
+ * @brief           Measured call - GPTP_KF_Update.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_KfCall(uint32_t u32Call)
+{
+    (void)GPTP_KF_Update(&srKf, -3, sas32PiErrors[u32Call % GPTP_BENCH_PI_ERRORS]);
+}
+
+/*!
+ * @brief           Preparation of GPTP_SYNC_SyncMachine call.
+ * @details         The Sync message goes through the full receive path,
+ *                  the Follow_Up is only parsed, so the measured call is
+ *                  the Follow_Up processing of the slave machine (offset,
+ *                  rate ratio and servo update).
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_SyncPrepare(uint32_t u32Call)
+{
+    uint64_t u64OriginNs;
+    uint16_t u16Seq;
+
+    su8CallDomain = (uint8_t)(u32Call % su8Domains);
+    u16Seq = sau16GmSeq[su8CallDomain];
+    sau16GmSeq[su8CallDomain]++;
+
+    GPTP_PORT_IncFreeRunningTimer(((uint64_t)GPTP_BENCH_SYNC_PERIOD_MS * GPTP_BENCH_NS_IN_MS) / su8Domains);
+
+    u64OriginNs = GPTP_PORT_GetFreeRunningTimer();
+    GPTP_BENCH_NetPush(0u, GPTP_DEF_MSG_TYPE_SYNC, su8CallDomain, u16Seq, NULL);
+    GPTP_BENCH_NetService();
+
+    (void)GPTP_BENCH_FrameCraft(sau8Frame, GPTP_DEF_MSG_TYPE_FOLLOW_UP, su8CallDomain, u16Seq, u64OriginNs, NULL);
+    GPTP_BENCH_RxDataSet(&srRxData, sau8Frame, 0u);
+    GPTP_BENCH_ParseCall(u16Seq);
+}
+
+/*!
+ * @brief           Measured call - GPTP_SYNC_SyncMachine.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_SyncCall(uint32_t u32Call)
+{
+    (void)u32Call;
+
+    GPTP_SYNC_SyncMachine(sprGptp, su8CallDomain,
+                          sprGptp->prPerDomainParams[su8CallDomain].u8SlaveMachineId,
+                          GPTP_DEF_CALL_PTP_RECEIVED);
+}
+
+/*!
+ * @brief           Network service after GPTP_SYNC_SyncMachine call.
+ * @details         Forwards the Sync to the master ports as GPTP_MsgReceive
+ *                  would do.
+*/
+static void GPTP_BENCH_SyncService(void)
+{
+    GPTP_TIMER_SyncsSendNonGm(sprGptp, &sprGptp->prPerDomainParams[su8CallDomain], GPTP_DEF_CALL_PTP_RECEIVED);
+    GPTP_BENCH_NetService();
+}
+
+/*!
+ * @brief           Preparation of GPTP_PDELAY_PdelayMachine call.
+ * @details         Pdelay_Req and Pdelay_Resp go through the full path,
+ *                  the Pdelay_Resp_Follow_Up is only parsed, so the measured
+ *                  call is the path delay and neighbor rate ratio calculation.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_PdelayPrepare(uint32_t u32Call)
+{
+    static gptp_port_sim_frame_t srFrame;
+    gptp_def_clock_port_id_t     rRequesting;
+    uint16_t                     u16Seq;
+    uint16_t                     u16ReqSeq;
+    bool                         bReq;
+
+    su8CallPort = (uint8_t)(u32Call % su8Ports);
+
+    GPTP_PORT_IncFreeRunningTimer(((uint64_t)GPTP_BENCH_SYNC_PERIOD_MS * GPTP_BENCH_NS_IN_MS) / su8Ports);
+
+    GPTP_PDELAY_PdelayMachine(sprGptp, &sprGptp->prPdelayMachines[su8CallPort], GPTP_DEF_CALL_INITIATE);
+
+    /* Egress timestamp of the request, handed over as the periodic
+       function would do */
+    GPTP_PORT_SimPoll();
+    GPTP_PORT_ProcessMapEntry(sprGptp->prPdelayMachines[su8CallPort].rTxDataReq.prFrameMap);
+
+    bReq = false;
+    u16ReqSeq = 0u;
+    while (true == GPTP_PORT_SimTxPop(&srFrame))
+    {
+        if ((su8CallPort == srFrame.u8CtrlIdx) &&
+            (true == GPTP_BENCH_NetReqGet(&srFrame, &u16Seq, &rRequesting)))
+        {
+            bReq = true;
+            u16ReqSeq = u16Seq;
+        }
+    }
+
+    if (true == bReq)
+    {
+        GPTP_BENCH_NetPush(su8CallPort, GPTP_DEF_MSG_TYPE_PD_RESP, 0u, u16ReqSeq, &rRequesting);
+        GPTP_PORT_SimPoll();
+    }
+
+    (void)GPTP_BENCH_FrameCraft(sau8Frame, GPTP_DEF_MSG_TYPE_PD_RESP_FUP, 0u, u16ReqSeq,
+                                GPTP_PORT_GetFreeRunningTimer(), &rRequesting);
+    GPTP_BENCH_RxDataSet(&srRxData, sau8Frame, su8CallPort);
+    GPTP_BENCH_ParseCall(u16ReqSeq);
+}
+
+/*!
+ * @brief           Measured call - GPTP_PDELAY_PdelayMachine.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_PdelayCall(uint32_t u32Call)
+{
+    (void)u32Call;
+
+    GPTP_PDELAY_PdelayMachine(sprGptp, &sprGptp->prPdelayMachines[su8CallPort], GPTP_DEF_CALL_PTP_RECEIVED);
+}
+
+/*!
+ * @brief           Preparation of GPTP_TIMER_TimerPeriodic call.
+ * @details         Runs the network for one application timer period.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_TimerPrepare(uint32_t u32Call)
+{
+    (void)u32Call;
+
+    GPTP_BENCH_NetAdvance(GPTP_BENCH_TIMER_PERIOD_MS, false);
+}
+
+/*!
+ * @brief           Measured call - GPTP_TIMER_TimerPeriodic.
+ * @param[in]       u32Call Call index.
+*/
+static void GPTP_BENCH_TimerCall(uint32_t u32Call)
+{
+    (void)u32Call;
+
+    GPTP_TIMER_TimerPeriodic(sprGptp);
+}
+
+/*!
+ * @brief           qsort comparator of float64_t.
+*/
+static int GPTP_BENCH_Compare(const void *cpvA,
+                              const void *cpvB)
+{
+    float64_t f64A;
+    float64_t f64B;
+
+    f64A = *(const float64_t *)cpvA;
+    f64B = *(const float64_t *)cpvB;
+
+    return (f64A > f64B) - (f64A < f64B);
+}
+
+/*!
+ * @brief           This function runs one benchmark case.
+ *
+ * @details         Calls without preparation are timed in windows of
+ *                  GPTP_BENCH_WINDOW_CALLS, calls with preparation one by one.
+ *                  The calibrated cost of an empty window is subtracted.
+ *                  Instructions are counted in a separate pass, so reading
+ *                  the counter does not disturb the timing.
+ *
+ * @param[in]       cprCase Benchmark case.
+ * @param[out]      prResult Result.
+*/
+static void GPTP_BENCH_Run(const gptp_bench_case_t *cprCase,
+                           gptp_bench_result_t *prResult)
+{
+    float64_t *pf64Samples;
+    float64_t f64Sum;
+    uint64_t  u64T0;
+    uint64_t  u64T1;
+    uint64_t  u64Instr;
+    uint32_t  u32Window;
+    uint32_t  u32Windows;
+    uint32_t  u32Sample;
+    uint32_t  u32Rep;
+    uint32_t  u32W;
+    uint32_t  u32K;
+    uint32_t  u32Call;
+
+    u32Window = (NULL == cprCase->pfPrepare) ? GPTP_BENCH_WINDOW_CALLS : 1u;
+    u32Windows = (su32Calls + u32Window - 1u) / u32Window;
+    pf64Samples = malloc(sizeof(float64_t) * u32Windows * su32Reps);
+    if (NULL == pf64Samples)
+    {
+        fprintf(stderr, "gptp_bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    u32Sample = 0u;
+    u32Call = 0u;
+    f64Sum = 0.0;
+
+    for (u32Rep = 0u; u32Rep < su32Reps; u32Rep++)
+    {
+        for (u32W = 0u; u32W < u32Windows; u32W++)
+        {
+            if (NULL != cprCase->pfPrepare)
+            {
+                cprCase->pfPrepare(u32Call);
+            }
+
+            u64T0 = GPTP_BENCH_NowNs();
+            for (u32K = 0u; u32K < u32Window; u32K++)
+            {
+                cprCase->pfCall(u32Call + u32K);
+            }
+            u64T1 = GPTP_BENCH_NowNs();
+
+            u32Call += u32Window;
+            pf64Samples[u32Sample] = ((float64_t)(u64T1 - u64T0) - sf64OverheadNs) / (float64_t)u32Window;
+            f64Sum += pf64Samples[u32Sample];
+            u32Sample++;
+
+            if (NULL != cprCase->pfService)
+            {
+                cprCase->pfService();
+            }
+        }
+    }
+
+    qsort(pf64Samples, u32Sample, sizeof(float64_t), GPTP_BENCH_Compare);
+    prResult->f64NsMedian = pf64Samples[u32Sample / 2u];
+    prResult->f64NsMin = pf64Samples[0];
+    prResult->f64NsMean = f64Sum / (float64_t)u32Sample;
+    prResult->f64Instructions = -1.0;
+
+    if (0 <= ssPerfFd)
+    {
+        u64Instr = 0u;
+        for (u32W = 0u; u32W < u32Windows; u32W++)
+        {
+            if (NULL != cprCase->pfPrepare)
+            {
+                cprCase->pfPrepare(u32Call);
+            }
+
+            u64T0 = GPTP_BENCH_PerfRead();
+            for (u32K = 0u; u32K < u32Window; u32K++)
+            {
+                cprCase->pfCall(u32Call + u32K);
+            }
+            u64T1 = GPTP_BENCH_PerfRead();
+
+            u32Call += u32Window;
+            u64Instr += u64T1 - u64T0;
+
+            if (NULL != cprCase->pfService)
+            {
+                cprCase->pfService();
+            }
+        }
+
+        prResult->f64Instructions = ((float64_t)u64Instr - (sf64OverheadInstr * (float64_t)u32Windows)) /
+                                    ((float64_t)u32Windows * (float64_t)u32Window);
+    }
+
+    free(pf64Samples);
+}
+
+/*!
+ * @brief           This function calibrates the cost of an empty window.
+*/
+static void GPTP_BENCH_Calibrate(void)
+{
+    uint64_t u64T0;
+    uint64_t u64T1;
+    uint64_t u64Min;
+    uint32_t u32Idx;
+
+    u64Min = UINT64_MAX;
+    for (u32Idx = 0u; u32Idx < GPTP_BENCH_CALIB_WINDOWS; u32Idx++)
+    {
+        u64T0 = GPTP_BENCH_NowNs();
+        u64T1 = GPTP_BENCH_NowNs();
+        if ((u64T1 - u64T0) < u64Min)
+        {
+            u64Min = u64T1 - u64T0;
+        }
+    }
+    sf64OverheadNs = (float64_t)u64Min;
+
+    if (0 <= ssPerfFd)
+    {
+        u64Min = UINT64_MAX;
+        for (u32Idx = 0u; u32Idx < GPTP_BENCH_CALIB_WINDOWS; u32Idx++)
+        {
+            u64T0 = GPTP_BENCH_PerfRead();
+            u64T1 = GPTP_BENCH_PerfRead();
+            if ((u64T1 - u64T0) < u64Min)
+            {
+                u64Min = u64T1 - u64T0;
+            }
+        }
+        sf64OverheadInstr = (float64_t)u64Min;
+    }
+}
+
+/*!
+ * @brief           This function writes one result as JSON object.
+ * @param[in]       prOut Output stream.
+ * @param[in]       cprCase Benchmark case.
+ * @param[in]       cprResult Result.
+ * @param[in]       bFirst First result of the report.
+*/
+static void GPTP_BENCH_Report(FILE *prOut,
+                              const gptp_bench_case_t *cprCase,
+                              const gptp_bench_result_t *cprResult,
+                              bool bFirst)
+{
+    fprintf(prOut, "%s\n    {\"name\": \"%s\", \"variant\": \"%s\", \"vlan\": %s, "
+                   "\"ports\": %u, \"domains\": %u, \"calls\": %u, "
+                   "\"ns_per_call\": %.2f, \"ns_per_call_mean\": %.2f, \"ns_per_call_min\": %.2f, ",
+            (true == bFirst) ? "" : ",",
+            cprCase->pcName, cprCase->pcVariant, (true == cprCase->bVlan) ? "true" : "false",
+            cprCase->u8Ports, cprCase->u8Domains, su32Calls * su32Reps,
+            cprResult->f64NsMedian, cprResult->f64NsMean, cprResult->f64NsMin);
+
+    if (0.0 <= cprResult->f64Instructions)
+    {
+        fprintf(prOut, "\"instructions_per_call\": %.1f}", cprResult->f64Instructions);
+    }
+    else
+    {
+        fprintf(prOut, "\"instructions_per_call\": null}");
+    }
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           Entry point of the benchmark suite.
+*/
+int main(int argc, char *argv[])
+{
+    gptp_bench_case_t   rCase;
+    gptp_bench_result_t rResult;
+    gptp_def_clock_port_id_t rRequesting;
+    gptp_def_tx_data_t  *prTx;
+    const char          *pcFilter;
+    FILE                *prOut;
+    char                acName[96];
+    uint32_t            u32Seed;
+    uint32_t            u32Idx;
+    uint8_t             u8Msg;
+    uint8_t             u8Vlan;
+    uint8_t             u8P;
+    uint8_t             u8D;
+    uint8_t             u8Group;
+    bool                bFirst;
+    int                 sOpt;
+
+    pcFilter = NULL;
+    prOut = stdout;
+
+    while (-1 != (sOpt = getopt(argc, argv, "n:r:f:o:")))
+    {
+        switch (sOpt)
+        {
+            case 'n':
+                su32Calls = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'r':
+                su32Reps = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'f':
+                pcFilter = optarg;
+            break;
+
+            case 'o':
+                prOut = fopen(optarg, "w");
+                if (NULL == prOut)
+                {
+                    perror(optarg);
+                    return EXIT_FAILURE;
+                }
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n calls] [-r repetitions] [-f filter] [-o file]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((0u == su32Calls) || (0u == su32Reps))
+    {
+        fprintf(stderr, "gptp_bench: calls and repetitions must be non-zero\n");
+        return EXIT_FAILURE;
+    }
+
+    ssPerfFd = GPTP_BENCH_PerfOpen();
+    GPTP_BENCH_Calibrate();
+
+    /* Pseudo-random time errors within +-2 us for the servo */
+    u32Seed = 12345u;
+    for (u32Idx = 0u; u32Idx < GPTP_BENCH_PI_ERRORS; u32Idx++)
+    {
+        u32Seed = (u32Seed * 1103515245u) + 12345u;
+        sas32PiErrors[u32Idx] = (int32_t)((u32Seed >> 8u) % 4001u) - 2000;
+    }
+
+    fprintf(prOut, "{\n  \"suite\": \"gptp_bench\",\n  \"revision\": \"%s\",\n", GPTP_BENCH_REVISION);
+    fprintf(prOut, "  \"build\": {\"fixed_point\": %s, \"tx_zero_copy\": %s, \"counters\": %s, \"word_serialization\": %s, \"tx_templates\": %s},\n",
+#ifdef GPTP_FIXED_POINT
+            "true",
+#else
+            "false",
+#endif /* GPTP_FIXED_POINT */
+#ifdef GPTP_TX_ZERO_COPY
+            "true",
+#else
+            "false",
+#endif /* GPTP_TX_ZERO_COPY */
+#ifdef GPTP_COUNTERS
+            "true",
+#else
+            "false",
+#endif /* GPTP_COUNTERS */
+#ifdef GPTP_PORT_HTON32
+            "true",
+#else
+            "false",
+#endif /* GPTP_PORT_HTON32 */
+#ifdef GPTP_TX_TEMPLATES
+            "true"
+#else
+            "false"
+#endif /* GPTP_TX_TEMPLATES */
+            );
+    fprintf(prOut, "  \"calls\": %u,\n  \"repetitions\": %u,\n  \"perf_counters\": %s,\n",
+            su32Calls, su32Reps, (0 <= ssPerfFd) ? "true" : "false");
+    fprintf(prOut, "  \"timer_overhead_ns\": %.1f,\n  \"results\": [", sf64OverheadNs);
+
+    bFirst = true;
+
+    /* Frame parsing and building on a two-port bridge, single domain */
+    for (u8Vlan = 0u; u8Vlan < 2u; u8Vlan++)
+    {
+        for (u8Msg = 0u; u8Msg < GPTP_BENCH_MSG_TYPES; u8Msg++)
+        {
+            for (u8Group = 0u; u8Group < 2u; u8Group++)
+            {
+                memset(&rCase, 0, sizeof(rCase));
+                rCase.pcName = (0u == u8Group) ? "frame_parse" : "frame_build";
+                rCase.pcVariant = scarMsgTypes[u8Msg].pcName;
+                rCase.bVlan = (1u == u8Vlan);
+                rCase.u8Ports = 2u;
+                rCase.u8Domains = 1u;
+                rCase.pfCall = (0u == u8Group) ? GPTP_BENCH_ParseCall : GPTP_BENCH_BuildCall;
+
+                (void)snprintf(acName, sizeof(acName), "%s/%s%s", rCase.pcName, rCase.pcVariant,
+                               (true == rCase.bVlan) ? "/vlan" : "");
+                if ((NULL != pcFilter) && (NULL == strstr(acName, pcFilter)))
+                {
+                    continue;
+                }
+
+                GPTP_BENCH_Setup(rCase.u8Ports, rCase.u8Domains, rCase.bVlan);
+
+                if (0u == u8Group)
+                {
+                    /* Sync/Follow_Up arrive on the slave port, Signaling on
+                       the master port */
+                    rRequesting.u64ClockId = GPTP_BENCH_LOCAL_CLOCK_ID;
+                    rRequesting.u16PortId = 1u;
+                    (void)GPTP_BENCH_FrameCraft(sau8Frame, scarMsgTypes[u8Msg].eMsgType, 0u, 0u,
+                                                GPTP_PORT_GetFreeRunningTimer(), &rRequesting);
+                    GPTP_BENCH_RxDataSet(&srRxData, sau8Frame,
+                                         (GPTP_DEF_MSG_TYPE_SIGNALING == scarMsgTypes[u8Msg].eMsgType) ? 1u : 0u);
+                }
+                else
+                {
+                    /* Transmit data as last prepared by the stack */
+                    su8TxPort = 0u;
+                    switch (scarMsgTypes[u8Msg].eMsgType)
+                    {
+                        case GPTP_DEF_MSG_TYPE_SYNC:
+                            su8TxPort = 1u;
+                            prTx = &sprGptp->prPerDomainParams[0].prSyncMachines[1].rTxDataSyn;
+                        break;
+
+                        case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
+                            su8TxPort = 1u;
+                            prTx = &sprGptp->prPerDomainParams[0].prSyncMachines[1].rTxDataFup;
+                        break;
+
+                        case GPTP_DEF_MSG_TYPE_PD_REQ:
+                            prTx = &sprGptp->prPdelayMachines[0].rTxDataReq;
+                        break;
+
+                        case GPTP_DEF_MSG_TYPE_PD_RESP:
+                            prTx = &sprGptp->prPdelayMachines[0].rTxDataResp;
+                        break;
+
+                        case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
+                            prTx = &sprGptp->prPdelayMachines[0].rTxDataReFu;
+                        break;
+
+                        default:
+                            GPTP_SIGNALING_SendSignaling(sprGptp, 0u, -2);
+                            GPTP_BENCH_NetService();
+                            prTx = &sprGptp->prPerDomainParams[0].rTxDataSig;
+                        break;
+                    }
+
+                    srTxData = *prTx;
+                    srTxData.pau8TxBuffPtr = sau8Frame;
+#ifdef GPTP_TX_TEMPLATES
+                    /* Template is built into the bench buffer by the first call */
+                    srTxData.bTemplateValid = false;
+#endif /* GPTP_TX_TEMPLATES */
+                }
+
+                GPTP_BENCH_Run(&rCase, &rResult);
+                GPTP_BENCH_Report(prOut, &rCase, &rResult, bFirst);
+                bFirst = false;
+            }
+        }
+    }
+
+    /* PTP common header alone, Sync header of the fake GM */
+    for (u8Group = 0u; u8Group < 2u; u8Group++)
+    {
+        memset(&rCase, 0, sizeof(rCase));
+        rCase.pcName = "frame_hdr";
+        rCase.pcVariant = (0u == u8Group) ? "decode" : "encode";
+        rCase.u8Ports = 1u;
+        rCase.u8Domains = 1u;
+        rCase.pfCall = (0u == u8Group) ? GPTP_BENCH_HdrDecodeCall : GPTP_BENCH_HdrEncodeCall;
+
+        (void)snprintf(acName, sizeof(acName), "%s/%s", rCase.pcName, rCase.pcVariant);
+        if ((NULL != pcFilter) && (NULL == strstr(acName, pcFilter)))
+        {
+            continue;
+        }
+
+        (void)GPTP_BENCH_FrameCraft(sau8Frame, GPTP_DEF_MSG_TYPE_SYNC, 0u, 0u, 0u, NULL);
+        GPTP_FRAME_HdrDecode(&sau8Frame[GPTP_DEF_ETH_II_LEN], &srHdr);
+        GPTP_BENCH_Run(&rCase, &rResult);
+        GPTP_BENCH_Report(prOut, &rCase, &rResult, bFirst);
+        bFirst = false;
+    }
+
+    /* PI servo update */
+    memset(&rCase, 0, sizeof(rCase));
+    rCase.pcName = "pi_update";
+    rCase.pcVariant = "default";
+    rCase.u8Ports = 1u;
+    rCase.u8Domains = 1u;
+    rCase.pfCall = GPTP_BENCH_PiCall;
+    if ((NULL == pcFilter) || (NULL != strstr("pi_update/default", pcFilter)))
+    {
+        GPTP_PI_Init(&srPi, &scrPiConf);
+        GPTP_BENCH_Run(&rCase, &rResult);
+        GPTP_BENCH_Report(prOut, &rCase, &rResult, bFirst);
+        bFirst = false;
+    }
+
+    /* Kalman servo update */
+    memset(&rCase, 0, sizeof(rCase));
+    rCase.pcName = "kf_update";
+    rCase.pcVariant = "default";
+    rCase.u8Ports = 1u;
+    rCase.u8Domains = 1u;
+    rCase.pfCall = GPTP_BENCH_KfCall;
+    if ((NULL == pcFilter) || (NULL != strstr("kf_update/default", pcFilter)))
+    {
+        GPTP_KF_Init(&srKf, &scrKfConf);
+        GPTP_BENCH_Run(&rCase, &rResult);
+        GPTP_BENCH_Report(prOut, &rCase, &rResult, bFirst);
+        bFirst = false;
+    }
+
+    /* State machines and the periodic timer over the bridge sizes */
+    for (u8Group = 0u; u8Group < 3u; u8Group++)
+    {
+        for (u8P = 0u; u8P < (uint8_t)(sizeof(scau8Ports) / sizeof(scau8Ports[0])); u8P++)
+        {
+            for (u8D = 0u; u8D < (uint8_t)(sizeof(scau8Domains) / sizeof(scau8Domains[0])); u8D++)
+            {
+                memset(&rCase, 0, sizeof(rCase));
+                rCase.u8Ports = scau8Ports[u8P];
+                rCase.u8Domains = scau8Domains[u8D];
+
+                switch (u8Group)
+                {
+                    case 0u:
+                        rCase.pcName = "sync_machine";
+                        rCase.pcVariant = "follow_up_rx";
+                        rCase.pfPrepare = GPTP_BENCH_SyncPrepare;
+                        rCase.pfCall = GPTP_BENCH_SyncCall;
+                        rCase.pfService = GPTP_BENCH_SyncService;
+                    break;
+
+                    case 1u:
+                        rCase.pcName = "pdelay_machine";
+                        rCase.pcVariant = "resp_fup_rx";
+                        rCase.pfPrepare = GPTP_BENCH_PdelayPrepare;
+                        rCase.pfCall = GPTP_BENCH_PdelayCall;
+                        rCase.pfService = GPTP_BENCH_NetService;
+                    break;
+
+                    default:
+                        rCase.pcName = "timer_periodic";
+                        rCase.pcVariant = "tick";
+                        rCase.pfPrepare = GPTP_BENCH_TimerPrepare;
+                        rCase.pfCall = GPTP_BENCH_TimerCall;
+                        rCase.pfService = GPTP_BENCH_NetService;
+                    break;
+                }
+
+                (void)snprintf(acName, sizeof(acName), "%s/%s/p%u/d%u", rCase.pcName, rCase.pcVariant,
+                               rCase.u8Ports, rCase.u8Domains);
+                if ((NULL != pcFilter) && (NULL == strstr(acName, pcFilter)))
+                {
+                    continue;
+                }
+
+                GPTP_BENCH_Setup(rCase.u8Ports, rCase.u8Domains, false);
+                GPTP_BENCH_Run(&rCase, &rResult);
+                GPTP_BENCH_Report(prOut, &rCase, &rResult, bFirst);
+                bFirst = false;
+            }
+        }
+    }
+
+    fprintf(prOut, "\n  ]\n}\n");
+
+    if (stdout != prOut)
+    {
+        (void)fclose(prOut);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,453 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_chain.c
+ *
+ * @details End-to-end synchronization accuracy of a GM -> bridge(s) -> slave
+ *          chain on the simulated network (gptp_port_simnet.h). Every node
+ *          runs its own stack instance and oscillator, the links between
+ *          the neighbours have the configured delay, asymmetry, jitter and
+ *          loss. After the warm-up, the true time error of every node to
+ *          the GM is sampled every 10 ms and reported as JSON to stdout or
+ *          to the -o file. The lock time of a node is the time from the start
+ *          after which its time error stays within the -L threshold until
+ *          the end of the run, the -S option selects the clock servo.
+ *          With -N, the nodes read the NVM asynchronously (pfNvmReadReqCB),
+ *          the reads are completed from the given time after the start on,
+ *          the reads of the -M node are never completed.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -Igptp_stack/port/linux -Igptp_stack/port
+ *              -Igptp_stack/gptp_core/include -Igptp_stack/test
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c gptp_stack/test/gptp_test_node.c
+ *              gptp_stack/bench/gptp_chain.c -o gptp_chain -lm
+ *
+ *          Usage: gptp_chain [-b bridges] [-t seconds] [-w warm-up seconds]
+ *                            [-d delay ns] [-a asymmetry ns] [-j jitter ns]
+ *                            [-l loss ppm] [-f max frequency offset ppb]
+ *                            [-W wander ppb] [-S pi|kf] [-L lock ns]
+ *                            [-N NVM read ms] [-M node without NVM read]
+ *                            [-s seed] [-o file]
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gptp.h"
+#include "gptp_def.h"
+#include "gptp_port_platform.h"
+#include "gptp_port_simnet.h"
+#include "gptp_test_node.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#ifndef GPTP_BENCH_REVISION
+#define GPTP_BENCH_REVISION             "unknown"
+#endif
+/*! Maximal count of the chain nodes (GM, bridges, slave). */
+#define GPTP_CHAIN_NODES_MAX            (GPTP_PORT_SIMNET_NODES_MAX)
+/*! gPTP ports of a node, the slave port 0 and the master port 1. */
+#define GPTP_CHAIN_PORTS                (GPTP_TEST_NODE_PORTS_MAX)
+/*! Default count of the bridges. */
+#define GPTP_CHAIN_BRIDGES_DEF          (1u)
+/*! Default measured time [s]. */
+#define GPTP_CHAIN_TIME_S_DEF           (60u)
+/*! Default warm-up time [s]. */
+#define GPTP_CHAIN_WARMUP_S_DEF         (30u)
+/*! Default link propagation delay [ns]. */
+#define GPTP_CHAIN_DELAY_NS_DEF         (500u)
+/*! Default maximal oscillator frequency offset [ppb]. */
+#define GPTP_CHAIN_FREQ_PPB_DEF         (50000u)
+/*! Clock identity base of the nodes. */
+#define GPTP_CHAIN_CLOCK_ID             (0x020000FFFE010000u)
+/*! Maximal initial PTP clock offset of the nodes [ns]. */
+#define GPTP_CHAIN_INIT_OFFSET_NS       (1000000000u)
+#define GPTP_CHAIN_NS_IN_S              (1000000000u)
+/*! Default lock threshold of the time error [ns]. */
+#define GPTP_CHAIN_LOCK_NS_DEF          (100u)
+/*! Period of the lock check and of the NVM read service [ns]. */
+#define GPTP_CHAIN_LOCK_STEP_NS         (10000000u)
+#define GPTP_CHAIN_NS_IN_MS             (1000000u)
+/*! No node, the NVM reads of all the nodes are completed. */
+#define GPTP_CHAIN_NODE_NONE            (0xFFu)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Configuration and run-time data of a chain node.
+ */
+typedef struct
+{
+    gptp_test_node_t                    rNode;
+    /*! True time of the last lock check out of the threshold [ns]. */
+    uint64_t                            u64UnlockedNs;
+    /*! The time error was ever out of the threshold. */
+    bool                                bEverUnlocked;
+}gptp_chain_node_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint32_t GPTP_CHAIN_Rand(uint32_t *pu32Seed);
+static void GPTP_CHAIN_Run(uint8_t u8Nodes,
+                           uint64_t u64DurationNs,
+                           uint64_t u64LockNs);
+static bool GPTP_CHAIN_NvmReadPending(const gptp_chain_node_t *cprNode);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static gptp_chain_node_t                sarNodes[GPTP_CHAIN_NODES_MAX];
+/*! The asynchronous NVM reads are used. */
+static bool                             sbNvmAsync = false;
+/*! True time the asynchronous NVM reads are completed from [ns]. */
+static uint64_t                         su64NvmReadNs = 0u;
+/*! Node whose NVM reads are never completed. */
+static uint8_t                          su8NvmMissingNode = GPTP_CHAIN_NODE_NONE;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns a pseudo-random number.
+ * @param[in,out]   pu32Seed Pointer to the generator state.
+ * @return          Number in the range 0 - 0xFFFFFF.
+*/
+static uint32_t GPTP_CHAIN_Rand(uint32_t *pu32Seed)
+{
+    *pu32Seed = (*pu32Seed * 1103515245u) + 12345u;
+
+    return *pu32Seed >> 8u;
+}
+
+/*!
+ * @brief           This function runs the network and checks the lock of the nodes.
+ * @details         The pending asynchronous NVM reads are completed after
+ *                  every check, from su64NvmReadNs on.
+ * @param[in]       u8Nodes Count of the nodes.
+ * @param[in]       u64DurationNs Run time [ns].
+ * @param[in]       u64LockNs Lock threshold of the time error [ns].
+*/
+static void GPTP_CHAIN_Run(uint8_t u8Nodes,
+                           uint64_t u64DurationNs,
+                           uint64_t u64LockNs)
+{
+    uint64_t u64EndNs;
+    int64_t  s64ErrNs;
+    uint8_t  u8Node;
+    gptp_port_sim_node_t *prPrevious;
+
+    u64EndNs = GPTP_PORT_SimNetTimeGet() + u64DurationNs;
+
+    while (GPTP_PORT_SimNetTimeGet() < u64EndNs)
+    {
+        GPTP_PORT_SimNetRun(((u64EndNs - GPTP_PORT_SimNetTimeGet()) < GPTP_CHAIN_LOCK_STEP_NS) ?
+                            (u64EndNs - GPTP_PORT_SimNetTimeGet()) : GPTP_CHAIN_LOCK_STEP_NS);
+
+        for (u8Node = 1u; u8Node < u8Nodes; u8Node++)
+        {
+            s64ErrNs = GPTP_PORT_SimNetTimeErrorGet(u8Node);
+            if (((0 > s64ErrNs) ? (uint64_t)-s64ErrNs : (uint64_t)s64ErrNs) > u64LockNs)
+            {
+                sarNodes[u8Node].u64UnlockedNs = GPTP_PORT_SimNetTimeGet();
+                sarNodes[u8Node].bEverUnlocked = true;
+            }
+        }
+
+        if ((true == sbNvmAsync) && (GPTP_PORT_SimNetTimeGet() >= su64NvmReadNs))
+        {
+            for (u8Node = 0u; u8Node < u8Nodes; u8Node++)
+            {
+                if (su8NvmMissingNode != u8Node)
+                {
+                    prPrevious = GPTP_PORT_SimNodeSelect(&sarNodes[u8Node].rNode.rNet.rSim);
+                    GPTP_PORT_SimNvmReadService();
+                    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * @brief           This function checks the asynchronous NVM reads of a node.
+ * @param[in]       cprNode Pointer to the node.
+ * @return          true if a read of the node is not completed.
+*/
+static bool GPTP_CHAIN_NvmReadPending(const gptp_chain_node_t *cprNode)
+{
+    const gptp_def_data_t *cprGptp;
+    bool                  bPending;
+    uint8_t               u8Machine;
+
+    cprGptp = &cprNode->rNode.rNet.rGptp;
+    bPending = false;
+
+    for (u8Machine = 0u; u8Machine < cprGptp->rPerDeviceParams.u8NumberOfPdelayMachines; u8Machine++)
+    {
+        if ((GPTP_DEF_MEM_READ_PENDING == cprGptp->prPdelayMachines[u8Machine].rPdelayNvmReadStat) ||
+            (GPTP_DEF_MEM_READ_PENDING == cprGptp->prPdelayMachines[u8Machine].rRratioNvmReadStat))
+        {
+            bPending = true;
+        }
+    }
+
+    return bPending;
+}
+
+int main(int argc, char *argv[])
+{
+    gptp_port_simnet_conf_t  rConf;
+    gptp_port_simnet_osc_t   rOsc;
+    gptp_port_simnet_link_t  rLink;
+    gptp_port_simnet_stats_t rStats;
+    gptp_err_type_t          eErr;
+    FILE                     *prOut;
+    uint32_t                 u32Bridges;
+    uint32_t                 u32TimeS;
+    uint32_t                 u32WarmupS;
+    uint32_t                 u32FreqPpb;
+    uint32_t                 u32Seed;
+    uint32_t                 u32LockNs;
+    float64_t                f64WanderPpb;
+    float64_t                f64LockS;
+    gptp_def_servo_type_t    eServo;
+    uint8_t                  u8Nodes;
+    uint8_t                  u8Node;
+    int                      sOpt;
+
+    prOut = stdout;
+    u32Bridges = GPTP_CHAIN_BRIDGES_DEF;
+    u32TimeS = GPTP_CHAIN_TIME_S_DEF;
+    u32WarmupS = GPTP_CHAIN_WARMUP_S_DEF;
+    u32FreqPpb = GPTP_CHAIN_FREQ_PPB_DEF;
+    f64WanderPpb = 1.0;
+    u32LockNs = GPTP_CHAIN_LOCK_NS_DEF;
+    eServo = GPTP_DEF_SERVO_PI;
+    memset(&rConf, 0, sizeof(rConf));
+    memset(&rLink, 0, sizeof(rLink));
+    rConf.u64Seed = 1u;
+    rLink.u32DelayNs = GPTP_CHAIN_DELAY_NS_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "b:t:w:d:a:j:l:f:W:S:L:N:M:s:o:")))
+    {
+        switch (sOpt)
+        {
+            case 'b':
+                u32Bridges = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 't':
+                u32TimeS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'w':
+                u32WarmupS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'd':
+                rLink.u32DelayNs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'a':
+                rLink.s32AsymmetryNs = (int32_t)strtol(optarg, NULL, 0);
+            break;
+
+            case 'j':
+                rLink.u32JitterNs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'l':
+                rLink.u32LossPpm = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'f':
+                u32FreqPpb = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'W':
+                f64WanderPpb = strtod(optarg, NULL);
+            break;
+
+            case 'S':
+                if (0 == strcmp(optarg, "kf"))
+                {
+                    eServo = GPTP_DEF_SERVO_KALMAN;
+                }
+                else if (0 == strcmp(optarg, "pi"))
+                {
+                    eServo = GPTP_DEF_SERVO_PI;
+                }
+                else
+                {
+                    fprintf(stderr, "gptp_chain: unknown servo %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+            break;
+
+            case 'L':
+                u32LockNs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'N':
+                sbNvmAsync = true;
+                rConf.bNvmReadByApp = true;
+                su64NvmReadNs = (uint64_t)strtoul(optarg, NULL, 0) * GPTP_CHAIN_NS_IN_MS;
+            break;
+
+            case 'M':
+                su8NvmMissingNode = (uint8_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 's':
+                rConf.u64Seed = strtoull(optarg, NULL, 0);
+            break;
+
+            case 'o':
+                prOut = fopen(optarg, "w");
+                if (NULL == prOut)
+                {
+                    perror(optarg);
+                    return EXIT_FAILURE;
+                }
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-b bridges] [-t seconds] [-w warm-up seconds] [-d delay ns] "
+                        "[-a asymmetry ns] [-j jitter ns] [-l loss ppm] [-f max frequency offset ppb] "
+                        "[-W wander ppb] [-S pi|kf] [-L lock ns] [-N NVM read ms] [-M node without NVM read] "
+                        "[-s seed] [-o file]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((u32Bridges + 2u) > GPTP_CHAIN_NODES_MAX)
+    {
+        fprintf(stderr, "gptp_chain: at most %u bridges\n", GPTP_CHAIN_NODES_MAX - 2u);
+        return EXIT_FAILURE;
+    }
+
+    u8Nodes = (uint8_t)(u32Bridges + 2u);
+    u32Seed = (uint32_t)rConf.u64Seed;
+    GPTP_PORT_SimNetInit(&rConf);
+
+    for (u8Node = 0u; u8Node < u8Nodes; u8Node++)
+    {
+        /* Two ports for the bridges, one for the GM and the slave. */
+        memset(&sarNodes[u8Node], 0, sizeof(sarNodes[u8Node]));
+        GPTP_TEST_NODE_Setup(&sarNodes[u8Node].rNode, GPTP_CHAIN_CLOCK_ID + u8Node,
+                             ((0u == u8Node) || ((u8Nodes - 1u) == u8Node)) ? 1u : GPTP_CHAIN_PORTS,
+                             (0u == u8Node), eServo);
+        if (true == sbNvmAsync)
+        {
+            sarNodes[u8Node].rNode.rInit.rPtpStackCallBacks.pfNvmReadReqCB = GPTP_PORT_SimNvmReadReqCB;
+        }
+
+        rOsc.s32FreqOffsetPpb = (0u == u32FreqPpb) ? 0 :
+                                (int32_t)(GPTP_CHAIN_Rand(&u32Seed) % ((2u * u32FreqPpb) + 1u)) - (int32_t)u32FreqPpb;
+        rOsc.f64WanderPpb = f64WanderPpb;
+        rOsc.s64InitOffsetNs = (int64_t)(GPTP_CHAIN_Rand(&u32Seed) % GPTP_CHAIN_INIT_OFFSET_NS);
+
+        eErr = GPTP_PORT_SimNetNodeAdd(&sarNodes[u8Node].rNode.rNet, &rOsc, &sarNodes[u8Node].rNode.rInit, NULL);
+        if (GPTP_ERR_OK != eErr)
+        {
+            fprintf(stderr, "gptp_chain: node %u initialization failed (%d)\n", u8Node, (int)eErr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Master port of the upstream node to the slave port 0 of the next one. */
+    for (u8Node = 1u; u8Node < u8Nodes; u8Node++)
+    {
+        rLink.u8NodeA = (uint8_t)(u8Node - 1u);
+        rLink.u8CtrlA = (1u == u8Node) ? 0u : 1u;
+        rLink.u8NodeB = u8Node;
+        rLink.u8CtrlB = 0u;
+        eErr = GPTP_PORT_SimNetLinkAdd(&rLink);
+        if (GPTP_ERR_OK != eErr)
+        {
+            fprintf(stderr, "gptp_chain: link to node %u failed (%d)\n", u8Node, (int)eErr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    GPTP_CHAIN_Run(u8Nodes, (uint64_t)u32WarmupS * GPTP_CHAIN_NS_IN_S, u32LockNs);
+    GPTP_PORT_SimNetStatsClear();
+    GPTP_CHAIN_Run(u8Nodes, (uint64_t)u32TimeS * GPTP_CHAIN_NS_IN_S, u32LockNs);
+
+    fprintf(prOut, "{\n  \"suite\": \"gptp_chain\",\n  \"revision\": \"%s\",\n", GPTP_BENCH_REVISION);
+    fprintf(prOut, "  \"config\": {\"bridges\": %u, \"time_s\": %u, \"warmup_s\": %u, \"delay_ns\": %u, "
+            "\"asymmetry_ns\": %d, \"jitter_ns\": %u, \"loss_ppm\": %u, \"freq_ppb\": %u, "
+            "\"wander_ppb\": %.3f, \"servo\": \"%s\", \"lock_ns\": %u, \"nvm_read_ms\": %lld, "
+            "\"nvm_missing_node\": %d, \"seed\": %llu},\n",
+            u32Bridges, u32TimeS, u32WarmupS, rLink.u32DelayNs, (int)rLink.s32AsymmetryNs,
+            rLink.u32JitterNs, rLink.u32LossPpm, u32FreqPpb, f64WanderPpb,
+            (GPTP_DEF_SERVO_KALMAN == eServo) ? "kf" : "pi", u32LockNs,
+            (true == sbNvmAsync) ? (long long)(su64NvmReadNs / GPTP_CHAIN_NS_IN_MS) : -1LL,
+            (GPTP_CHAIN_NODE_NONE == su8NvmMissingNode) ? -1 : (int)su8NvmMissingNode,
+            (unsigned long long)rConf.u64Seed);
+    fprintf(prOut, "  \"lost_frames\": %u,\n  \"nodes\": [", GPTP_PORT_SimNetLostGet());
+
+    for (u8Node = 0u; u8Node < u8Nodes; u8Node++)
+    {
+        (void)GPTP_PORT_SimNetStatsGet(u8Node, &rStats);
+
+        /* Not locked when out of the threshold at the end of the run, -1 */
+        f64LockS = 0.0;
+        if (true == sarNodes[u8Node].bEverUnlocked)
+        {
+            f64LockS = (GPTP_PORT_SimNetTimeGet() == sarNodes[u8Node].u64UnlockedNs) ? -1.0 :
+                       ((float64_t)sarNodes[u8Node].u64UnlockedNs / (float64_t)GPTP_CHAIN_NS_IN_S);
+        }
+
+        fprintf(prOut, "%s\n    {\"node\": %u, \"role\": \"%s\", \"synced\": %s, \"lock_s\": %.2f, \"samples\": %u, "
+                "\"mean_ns\": %.1f, \"rms_ns\": %.1f, \"min_ns\": %lld, \"max_ns\": %lld, "
+                "\"nvm_read_pending\": %s, \"nvm_pdelay_ns\": %.1f}",
+                (0u == u8Node) ? "" : ",", u8Node,
+                (0u == u8Node) ? "gm" : (((u8Nodes - 1u) == u8Node) ? "slave" : "bridge"),
+                (true == sarNodes[u8Node].rNode.rNet.rGptp.rPerDeviceParams.bSynced) ? "true" : "false",
+                f64LockS, rStats.u32Samples, rStats.f64MeanNs, rStats.f64RmsNs,
+                (long long)rStats.s64MinNs, (long long)rStats.s64MaxNs,
+                (true == GPTP_CHAIN_NvmReadPending(&sarNodes[u8Node])) ? "true" : "false",
+                sarNodes[u8Node].rNode.rNet.rSim.af64Nvm[0u][GPTP_DEF_NVM_PDELAY]);
+    }
+    fprintf(prOut, "\n  ]\n}\n");
+
+    if (stdout != prOut)
+    {
+        (void)fclose(prOut);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -133,6 +133,46 @@ void GPTP_TimerPeriodic(void);
  */
 gptp_err_error_t GPTP_ErrReadIndex(uint16_t u16ErrIndex);
 
+/*!
+ *
+ * @brief     This function provides access to the error log in chronological order.
+ *
+ * @details   This function returns error detail stored at the log position,
+ *            position 0 is the oldest stored log. Count of stored logs
+ *            is provided by GPTP_ErrLogCountGet.
+ *
+ * @param[in] u16ErrPos Error log position.
+ * @return    Error logged at the position.
+ *
+ */
+gptp_err_error_t GPTP_ErrReadOldest(uint16_t u16ErrPos);
+
+/*!
+ *
+ * @brief     This function returns count of logs stored in the error log.
+ *
+ * @return    Count of stored logs, 0 if the stack is not initialized.
+ *
+ */
+uint16_t GPTP_ErrLogCountGet(void);
+
+/*!
+ *
+ * @brief     This function enables or disables coalescing of the repeated error.
+ *
+ * @details   Repeated error of the enabled type from the same port and domain
+ *            updates the latest log of the type (last occurence time, count)
+ *            instead of evicting older logs. Can be called before the stack
+ *            initialization.
+ *
+ * @param[in] eError Error type.
+ * @param[in] bEnable Coalescing enabled - flag.
+ * @return    GPTP_ERR_OK or GPTP_ERR_E_ILLEGAL_ERR_TYPE.
+ *
+ */
+gptp_err_type_t GPTP_ErrCoalesceSet(gptp_err_type_t eError,
+                                    bool bEnable);
+
 /*! @} */
 
 /*!
@@ -234,6 +274,261 @@ gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
  */
 gptp_err_type_t GPTP_CurrentOffsetGet(gptp_def_timestamp_sig_t *rOffset);
 
+/*!
+ *
+ * @brief       This function provides the holdover status of the local clock
+ *
+ * @details     The function provides the frequency model of the local clock and the
+ *              estimated bound of the time error accumulated in the holdover. While
+ *              the clock is synchronized, the remaining time within the specification
+ *              is given for a holdover starting now.
+ *
+ * @param[out]  prInfo Pointer to the holdover status.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_HoldoverInfoGet(gptp_def_holdover_info_t *prInfo);
+
+/*!
+ *
+ * @brief       This function delivers the value of the asynchronous NVM read
+ *
+ * @details     The function completes the read requested by the pfNvmReadReqCB
+ *              callback. It is to be called from the same context as
+ *              GPTP_TimerPeriodic, not from within the request callback.
+ *              Completion without a pending request is ignored.
+ *
+ * @param[in]   u8PdelayMachine Pdelay machine index passed to the request callback.
+ * @param[in]   eNvmDataType NVM data type passed to the request callback.
+ * @param[in]   f64Value Value read from the NVM.
+ * @param[in]   bReadOk false if the NVM read failed, the value is ignored then.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_NvmReadDone(uint8_t u8PdelayMachine,
+                                 gptp_def_nvm_data_t eNvmDataType,
+                                 float64_t f64Value,
+                                 bool bReadOk);
+
+/*! @} */
+
+/*!
+ * @name Multiple stack instances
+ * @{
+ */
+
+/*!
+ *
+ * @brief      This function initializes the gPTP stack instance.
+ *
+ * @details    The instance is the main data structure provided by the caller, zero
+ *             initialized before the first call. Each API call with the instance
+ *             parameter binds the instance for its duration, the functions without
+ *             the instance parameter called meanwhile (port layer, callbacks) act
+ *             on the bound instance, otherwise on the default one. The functions
+ *             without the instance parameter above are the same as the instance
+ *             functions called with the default instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]  prInitParams Pointer to structure containing initial parameters
+ *
+ * @return     gPTP error code.
+ */
+gptp_err_type_t GPTP_GptpInitInst(gptp_def_data_t *prGptp,
+                                  const gptp_def_init_params_t *prInitParams);
+
+/*!
+ *
+ * @brief   This function handles the time stamps generated by the message transmission of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u8Port gPTP port number from which the time stamp is received.
+ * @param[in] u32TxTsS Tx time stamp value, seconds part.
+ * @param[in] u32TxTsNs Tx time stamp value, nano seconds part.
+ * @param[in] u8FrameId Id of frame, which generated the time stamp.
+ */
+void GPTP_TimeStampHandlerInst(gptp_def_data_t *prGptp,
+                               uint8_t u8Port,
+                               uint32_t u32TxTsS,
+                               uint32_t u32TxTsNs,
+                               uint8_t u8FrameId);
+
+/*!
+ *
+ * @brief   This function updates the TX frame table of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u8Port gPTP port number received the time stamp.
+ * @param[in] u32BufferIndex Index of the frame buffer.
+ * @param[in] u32TsSeconds Egress time stamp - seconds.
+ * @param[in] u32TsNanoseconds Egress time stamp - nano seconds.
+ */
+void GPTP_UpdateTimestampEntryInst(gptp_def_data_t *prGptp,
+                                   uint8_t u8Port,
+                                   uint32_t u32BufferIndex,
+                                   uint32_t u32TsSeconds,
+                                   uint32_t u32TsNanoseconds);
+
+/*!
+ *
+ * @brief   This function receives the gPTP message by the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] rRxData structure containing all the necessary gPTP data for processing.
+ */
+void GPTP_MsgReceiveInst(gptp_def_data_t *prGptp,
+                         gptp_def_rx_data_t rRxData);
+
+/*!
+ *
+ * @brief   This function increments internal software timer of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ */
+void GPTP_TimerPeriodicInst(gptp_def_data_t *prGptp);
+
+/*!
+ *
+ * @brief   This function notifies the "link up" event to the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u8Switch  Number of the respective switch.
+ * @param[in] u8Port    Number of the respective port on switch.
+ */
+void GPTP_LinkUpNotifyInst(gptp_def_data_t *prGptp,
+                           uint8_t u8Switch,
+                           uint8_t u8Port);
+
+/*!
+ *
+ * @brief   This function notifies the "link down" event to the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u8Switch  Number of the respective switch.
+ * @param[in] u8Port    Number of the respective port on switch.
+ */
+void GPTP_LinkDownNotifyInst(gptp_def_data_t *prGptp,
+                             uint8_t u8Switch,
+                             uint8_t u8Port);
+
+/*!
+ *
+ * @brief       This function provides current offset of the instance to GM
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[out]  rOffset Pointer to the Timestamp value of current GM offset.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_CurrentOffsetGetInst(gptp_def_data_t *prGptp,
+                                          gptp_def_timestamp_sig_t *rOffset);
+
+/*!
+ *
+ * @brief       This function delivers the value of the asynchronous NVM read to the instance
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u8PdelayMachine Pdelay machine index passed to the request callback.
+ * @param[in]   eNvmDataType NVM data type passed to the request callback.
+ * @param[in]   f64Value Value read from the NVM.
+ * @param[in]   bReadOk false if the NVM read failed, the value is ignored then.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_NvmReadDoneInst(gptp_def_data_t *prGptp,
+                                     uint8_t u8PdelayMachine,
+                                     gptp_def_nvm_data_t eNvmDataType,
+                                     float64_t f64Value,
+                                     bool bReadOk);
+
+/*!
+ *
+ * @brief     This function provides access to the error log of the instance.
+ *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u16ErrIndex Error log index.
+ * @return    Error logged at the index.
+ */
+gptp_err_error_t GPTP_ErrReadIndexInst(gptp_def_data_t *prGptp,
+                                       uint16_t u16ErrIndex);
+
+/*!
+ *
+ * @brief     This function provides access to the error log of the instance in chronological order.
+ *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u16ErrPos Error log position.
+ * @return    Error logged at the position.
+ */
+gptp_err_error_t GPTP_ErrReadOldestInst(gptp_def_data_t *prGptp,
+                                        uint16_t u16ErrPos);
+
+/*!
+ *
+ * @brief     This function returns count of logs stored in the error log of the instance.
+ *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @return    Count of stored logs, 0 if the stack is not initialized.
+ */
+uint16_t GPTP_ErrLogCountGetInst(gptp_def_data_t *prGptp);
+
+/*!
+ *
+ * @brief     This function enables or disables coalescing of the repeated error of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] eError Error type.
+ * @param[in] bEnable Coalescing enabled - flag.
+ * @return    GPTP_ERR_OK or GPTP_ERR_E_ILLEGAL_ERR_TYPE.
+ */
+gptp_err_type_t GPTP_ErrCoalesceSetInst(gptp_def_data_t *prGptp,
+                                        gptp_err_type_t eError,
+                                        bool bEnable);
+
+/*!
+ *
+ * @brief       This function gets current sync interval of the instance.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u8Domain Domain number.
+ * @param[in]   u8Machine Sync machine index.
+ * @param[out]  s8SyncInterval Pointer to sync interval variable.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_SyncIntervalGetInst(gptp_def_data_t *prGptp,
+                                         uint8_t u8Domain,
+                                         uint8_t u8Machine,
+                                         int8_t *s8SyncInterval);
+
+/*!
+ *
+ * @brief       This function sets sync interval of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u8Domain Domain number.
+ * @param[in]   u8Machine Sync machine index.
+ * @param[in]   s8SyncInterval New sync interval.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_SyncIntervalSetInst(gptp_def_data_t *prGptp,
+                                         uint8_t u8Domain,
+                                         uint8_t u8Machine,
+                                         int8_t s8SyncInterval);
+
+/*!
+ *
+ * @brief       This function provides the holdover status of the instance.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[out]  prInfo Pointer to the holdover status.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_HoldoverInfoGetInst(gptp_def_data_t *prGptp,
+                                         gptp_def_holdover_info_t *prInfo);
+
 /*! @} */
 
 /*!
@@ -271,6 +566,9 @@ void GPTP_MsgTransmit(gptp_def_tx_data_t *prTxData,
  *
  * @brief       Get pointer to the main structure holding gPTP states and configuration.
  *
+ * @details     Within an API call, the instance being processed is returned,
+ *              otherwise the default instance.
+ *
  * @return      Pointer to the main gPTP structure.
  */
 gptp_def_data_t* GPTP_GetMainStrPtr(void);
@@ -308,6 +606,93 @@ gptp_err_type_t GPTP_GetStatsValue(uint16_t u16Domain,
  * @return      gPTP error code.
  */
 gptp_err_type_t GPTP_ClearStats(void);
+
+/*!
+ *
+ * @brief       This function gets the gPTP latency histogram.
+ *
+ * @details     The function copies the respective latency histogram. Port histograms
+ *              are read with the domain 0xFFFF, the Sync residence time histogram
+ *              is read by the domain number and the sync machine of the domain.
+ *
+ * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port histogram.
+ * @param[in]   u8Port Port number, or sync machine for the domain histogram.
+ * @param[in]   eHist gPTP latency histogram.
+ * @param[out]  prHist Pointer to the histogram copy.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_GetHistogram(uint16_t u16Domain,
+                                  uint8_t u8Port,
+                                  gptp_def_hist_id_t eHist,
+                                  gptp_def_histogram_t *prHist);
+
+/*!
+ *
+ * @brief       This function clears all gPTP latency histograms
+ *
+ * @details     The function clears port and domain latency histograms, the
+ *              counters are not affected.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_ClearHistograms(void);
+
+/*!
+ *
+ * @brief       This function gets value of the gPTP counter of the instance.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port counter value.
+ * @param[in]   u8Port Port number.
+ * @param[in]   rCntr gPTP Counter.
+ * @param[out]  u32Value Pointer to the uint32_t value providing counter value.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_GetStatsValueInst(gptp_def_data_t *prGptp,
+                                       uint16_t u16Domain,
+                                       uint8_t u8Port,
+                                       gptp_def_counters_t rCntr,
+                                       uint32_t *u32Value);
+
+/*!
+ *
+ * @brief       This function clears all gPTP counters of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_ClearStatsInst(gptp_def_data_t *prGptp);
+
+/*!
+ *
+ * @brief       This function gets the gPTP latency histogram of the instance.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port histogram.
+ * @param[in]   u8Port Port number, or sync machine for the domain histogram.
+ * @param[in]   eHist gPTP latency histogram.
+ * @param[out]  prHist Pointer to the histogram copy.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_GetHistogramInst(gptp_def_data_t *prGptp,
+                                      uint16_t u16Domain,
+                                      uint8_t u8Port,
+                                      gptp_def_hist_id_t eHist,
+                                      gptp_def_histogram_t *prHist);
+
+/*!
+ *
+ * @brief       This function clears all gPTP latency histograms of the instance.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_ClearHistogramsInst(gptp_def_data_t *prGptp);
 #endif /* GPTP_COUNTERS */
 /*! @} */
 
@@ -39,6 +39,8 @@
  */
 /*! ETH II length */
 #define GPTP_DEF_ETH_II_LEN             14u
+/*! MAC address length */
+#define GPTP_DEF_MAC_ADDR_LEN           6u
 /*! gPTP Sync message length */
 #define GPTP_DEF_SYNC_MSG_LEN           44u
 /*! gPTP Pdelay request message length */
@@ -107,6 +109,11 @@
 #define GPTP_DEF_TX_BUF_LEN_SIGNL       (((GPTP_DEF_SIGNALING_MSG_LEN + GPTP_DEF_ETH_II_LEN) + GPTP_DEF_HEAD_TRAIL_LEN) + GPTP_DEF_ETH_VLAN_LEN)
 /*! @} */
 
+/* TX frame templates are kept in the per machine TX buffers, which do not exist with the zero-copy TX */
+#if defined(GPTP_TX_TEMPLATES) && defined(GPTP_TX_ZERO_COPY)
+    #error "GPTP_TX_TEMPLATES can not be combined with GPTP_TX_ZERO_COPY"
+#endif
+
 /*!
  * @name Various bit masks (count of low bits "L", count of high bits "H")
  * @{
@@ -219,6 +226,57 @@
 /*! Maximum start-up timeout [s] */
 #define GPTP_DEF_STARTUP_TIMEOUT_MAX    20
 
+/*! Count of domain numbers on wire (0-255) */
+#define GPTP_DEF_DOMAIN_NUM_CNT         256u
+/*! Lookup table entry not assigned */
+#define GPTP_DEF_LOOKUP_NONE            0xFFu
+/*! Maximum count of gPTP ports covered by the sync machine lookup */
+#ifndef GPTP_DEF_PORTS_MAX
+#define GPTP_DEF_PORTS_MAX              8u
+#endif
+/*! Maximum count of samples of the least-squares rate ratio window (at most 32) */
+#ifndef GPTP_DEF_RRATIO_LSQ_WIN_MAX
+#define GPTP_DEF_RRATIO_LSQ_WIN_MAX     16u
+#endif
+#if (GPTP_DEF_RRATIO_LSQ_WIN_MAX < 3u) || (GPTP_DEF_RRATIO_LSQ_WIN_MAX > 32u)
+#error "GPTP_DEF_RRATIO_LSQ_WIN_MAX must be in the range 3 to 32"
+#endif
+/*! Maximum count of offsets in the Sync offset filter window (at most 23, the drifts of all pairs are counted in 8 bits) */
+#ifndef GPTP_DEF_OFS_FILT_WIN_MAX
+#define GPTP_DEF_OFS_FILT_WIN_MAX       15u
+#endif
+#if (GPTP_DEF_OFS_FILT_WIN_MAX < 3u) || (GPTP_DEF_OFS_FILT_WIN_MAX > 23u)
+#error "GPTP_DEF_OFS_FILT_WIN_MAX must be in the range 3 to 23"
+#endif
+/*! Count of the averaged frequency corrections in the holdover history */
+#ifndef GPTP_DEF_HOLD_HIST_LEN
+#define GPTP_DEF_HOLD_HIST_LEN          32u
+#endif
+/*! Default averaging interval of the holdover history [s] */
+#define GPTP_DEF_HOLD_SAMPLE_S_DEF      8u
+
+/*! Magic of the trace stream, "GPTR" in the byte order */
+#define GPTP_DEF_TRACE_MAGIC            0x52545047u
+/*! Version of the trace format */
+#define GPTP_DEF_TRACE_VERSION          2u
+/*! Length of the trace stream header (magic, version, record header length) */
+#define GPTP_DEF_TRACE_HDR_LEN          8u
+/*! Length of the common trace record header */
+#define GPTP_DEF_TRACE_REC_LEN          20u
+/*! Length of the received frame record extension (Ethertype, source MAC) */
+#define GPTP_DEF_TRACE_RX_LEN           8u
+/*! Length of the egress timestamp record extension (buffer index, message type, domain number, sequence ID) */
+#define GPTP_DEF_TRACE_TX_LEN           8u
+/*! Maximum recorded length of the received gPTP data, longer data are truncated */
+#ifndef GPTP_DEF_TRACE_PAYLOAD_MAX
+#define GPTP_DEF_TRACE_PAYLOAD_MAX      256u
+#endif
+
+/*! Length of the error buffer */
+#define GPTP_ERR_LOG_LENGTH            32u
+/*! Count of words of the error coalescing mask */
+#define GPTP_ERR_COALESCE_WORDS        ((((uint16_t)GPTP_ERR_NUMBER_OF_ERRS) + 31u) / 32u)
+
 /*! Signaling message value for stop sending */
 #define GPTP_DEF_SIG_TLV_STOP_SENDING   127
 /*! Signaling message value for setting to initial value */
@@ -233,6 +291,11 @@
 /*! Count of nanoseconds in 10 miliseconds */
 #define GPTP_DEF_10_MS_IN_NS            10000000u
 
+/*! Timer wheel slot width as power of two of nanoseconds (2^23 ns ~ 8.4 ms) */
+#define GPTP_DEF_TIMER_WHEEL_SHIFT      23u
+/*! Count of timer wheel slots (power of two, 128 slots span ~1.07 s) */
+#define GPTP_DEF_TIMER_WHEEL_SLOTS      128u
+
 /*! First sequence ID for Pdelay messages */
 #define GPTP_DEF_PDELAY_FIRST_SEQ_ID    0x0100u
 /*! First sequence ID for Sync messages */
@@ -252,6 +315,12 @@
 #define GPTP_COUNTERS_DOM_CNT           6u
 /*! Count of counters defined by IEEE */
 #define GPTP_IEEE_COUNTERS_CNT          18u
+/*! Count of latency histogram bins */
+#define GPTP_DEF_HIST_BINS              24u
+/*! Upper bound of the first latency histogram bin as power of two, each next bin doubles it [ns] */
+#define GPTP_DEF_HIST_FIRST_SHIFT       10u
+/*! Count of port latency histograms */
+#define GPTP_DEF_HIST_PORT_CNT          4u
 /*! @} */
 
 /*!
@@ -300,6 +369,22 @@ typedef enum
     /*! This counter is not used, no Announce messages allowed */
     ieee8021AsPortStatTxAnnounce,
 }gptp_def_counters_t;
+
+/*!
+ * @brief gPTP latency histograms
+ */
+typedef enum
+{   /*! Pdelay initiator turnaround, Pdelay request egress to Pdelay response ingress (port) */
+    GPTP_DEF_HIST_TURNAROUND_INIT = 0,
+    /*! Pdelay responder turnaround, Pdelay request ingress to Pdelay response egress (port) */
+    GPTP_DEF_HIST_TURNAROUND_RESP,
+    /*! Message ingress timestamp to the dispatch by GPTP_MsgReceive, corrected time (port) */
+    GPTP_DEF_HIST_RX_DISPATCH,
+    /*! Message handover to the driver to its egress timestamp, corrected time (port) */
+    GPTP_DEF_HIST_TX_EGRESS,
+    /*! Sync residence time, Sync receipt on the slave to Follow Up transmission on the master (domain) */
+    GPTP_DEF_HIST_RESIDENCE,
+}gptp_def_hist_id_t;
 #endif /* GPTP_COUNTERS */
 /*! @} */
 
@@ -334,6 +419,31 @@ typedef enum
     GPTP_DEF_CALL_ON_TIMESTAMP
 }gptp_def_sm_call_type_t;
 
+/*!
+ * @brief Internal timer types, in the order of processing within the periodic function
+ */
+typedef enum
+{
+    /*! Pdelay request transmission due */
+    GPTP_DEF_TIMER_PDELAY_SEND = 0,
+    /*! Sync transmission due */
+    GPTP_DEF_TIMER_SYNC_SEND,
+    /*! Sync interval check for signaling */
+    GPTP_DEF_TIMER_SYNC_CHECK,
+    /*! Pdelay initiator turnaround time check */
+    GPTP_DEF_TIMER_TURNAROUND_INIT,
+    /*! Pdelay responder turnaround time check */
+    GPTP_DEF_TIMER_TURNAROUND_RESP,
+    /*! Sync residence time check */
+    GPTP_DEF_TIMER_RESIDENCE,
+    /*! Sync receipt timeout */
+    GPTP_DEF_TIMER_RECEIPT_TIMEOUT,
+    /*! Synchronization status calculation */
+    GPTP_DEF_TIMER_SYNC_STAT,
+    /*! Count of timer types */
+    GPTP_DEF_TIMER_TYPES_CNT
+}gptp_def_timer_type_t;
+
 /*!
  * @brief Timestamp vs. buffer index map entry status  
  */
@@ -465,6 +575,17 @@ typedef enum
     GPTP_DEF_MEM_WRITE_FINISH
 }gptp_def_mem_write_stat;
 
+ /*!
+ * @brief NVM reader states
+ */
+typedef enum
+{
+    /*! No NVM read outstanding */
+    GPTP_DEF_MEM_READ_IDLE,
+    /*! NVM read requested, waiting for GPTP_NvmReadDone */
+    GPTP_DEF_MEM_READ_PENDING
+}gptp_def_mem_read_stat;
+
  /*!
  * @brief NVM Data type
  */
@@ -476,6 +597,41 @@ typedef enum
     GPTP_DEF_NVM_RRATIO
 }gptp_def_nvm_data_t;
 
+ /*!
+ * @brief Neighbor rate ratio estimator
+ */
+typedef enum
+{
+    /*! Ratio of consecutive timestamp differences, exponentially averaged */
+    GPTP_DEF_RRATIO_ESTIM_EWMA = 0,
+    /*! Least-squares line fit over a sliding window of timestamps */
+    GPTP_DEF_RRATIO_ESTIM_LSQ
+}gptp_def_rratio_estim_t;
+
+ /*!
+ * @brief Sync offset filter
+ */
+typedef enum
+{
+    /*! Offsets are not filtered */
+    GPTP_DEF_OFS_FILT_NONE = 0,
+    /*! Median of the window */
+    GPTP_DEF_OFS_FILT_MEDIAN,
+    /*! Offset of the least delayed Sync of the window (the maximum of GM minus local time) */
+    GPTP_DEF_OFS_FILT_MIN_DELAY
+}gptp_def_ofs_filt_type_t;
+
+ /*!
+ * @brief Clock servo of the domain
+ */
+typedef enum
+{
+    /*! Fixed-gain PI controller */
+    GPTP_DEF_SERVO_PI = 0,
+    /*! Two-state (phase, frequency) Kalman filter */
+    GPTP_DEF_SERVO_KALMAN
+}gptp_def_servo_type_t;
+
 /*!
  * @brief Clock and port ID structure
  */
@@ -509,6 +665,287 @@ typedef struct
     int32_t                             s32TimeStampNs;
 }gptp_def_timestamp_sig_t;
 
+/*! @brief List of gPTP errors <p>
+    Prefix GPTP_ERR_I, Initialize errors category<p>
+    Prefix GPTP_ERR_A, Arithmetic errors category<p>
+    Prefix GPTP_ERR_C, Conversion errors category<p>
+    Prefix GPTP_ERR_T, Time-stamp errors category<p>
+    Prefix GPTP_ERR_M, Message errors category<p>
+    Prefix GPTP_ERR_N, NVM related error category<p>
+    Prefix GPTP_ERR_P, Pdelay errors category<p>
+    Prefix GPTP_ERR_S, Sync errors category<p>
+    Prefix GPTP_ERR_L, Limit errors category<p>
+    Prefix GPTP_ERR_F, Function call category<p>
+    Prefix GPTP_ERR_API, API category<p>
+    Prefix GPTP_ERR_V, Variable error category<p>
+    Prefix GPTP_ERR_E, Error management category<p>
+    Prefix GPTP_ERR_O, Outside situation category<p>*/
+typedef enum
+{
+    /*! No error */
+    GPTP_ERR_OK = 0,
+
+    /* Prefix GPTP_ERR_I, Initialize errors category */
+    /*! Stack not initialized */
+    GPTP_ERR_I_NOT_INITIALIZED,
+    /*! Count of initialized gPTP ports is zero */
+    GPTP_ERR_I_NO_PORT_INITIALIZED,
+    /*! Count of initialized Domains is zero */
+    GPTP_ERR_I_NO_DOM_INITIALIZED,
+    /*! Too many Sync slaves under one domain */
+    GPTP_ERR_I_TOO_MANY_SLAV_DOM,
+    /*! Too many Sync state machines under the domain (not enough gPTP ports) */
+    GPTP_ERR_I_TOO_MANY_SYNCS_DOM,
+    /*! No Slave machine for non Grand Master domain */
+    GPTP_ERR_I_NO_SLAVE_NON_GM_DOM,
+    /*! Slave Sync state machine initialized for Grand Master domain*/
+    GPTP_ERR_I_SLAVE_ON_GM_DOMAIN,
+    /*! Pdelay initiator not enabled for the slave sync machine */
+    GPTP_ERR_I_NO_PDELAY_FOR_SLAVE,
+    /*! Start-up time-out for Bridge is too long */
+    GPTP_ERR_I_START_TOUT_TOO_LONG,
+    /*! Source port MAC address not available */
+    GPTP_ERR_I_NO_SOURCE_MAC,
+    /*! Unable to get link status */
+    GPTP_ERR_I_NO_LINK_STATUS,
+    /*! Pointer to gPTP counters is NULL */
+    GPTP_ERR_I_COUNTERS_NULL_PTR,
+    /*! Pointer to port mapping structure is NULL */
+    GPTP_ERR_I_PORT_MAP_NULL_PTR,
+    /*! Pointer to port structure is NULL */
+    GPTP_ERR_I_PORT_STRCT_NULL_PTR,
+    /*! Pointer to Domain structure is NULL */
+    GPTP_ERR_I_DOM_STRCT_NULL_PTR,
+    /*! Pointer to Pdelay structure is NULL */
+    GPTP_ERR_I_PD_STRCT_NULL_PTR,
+    /*! Pointer to Sync structure under the Domain is NULL */
+    GPTP_ERR_I_SYNC_STRCT_NULL_PTR,
+    /*! Pdelay interval out of range */
+    GPTP_ERR_I_PDEL_INTERVAL_OOR,
+    /*! Sync interval out of range */
+    GPTP_ERR_I_SYNC_INTERVAL_OOR,
+    /*! Initialized Synchronized Grand Master on non Grand Master domain */
+    GPTP_ERR_I_SYNCED_GM_ON_NON_GM,
+    /*! The same domain number used twice */
+    GPTP_ERR_I_DOM_NUM_USED_TWICE,
+    /*! Reference domain for synced GM is not initialized */
+    GPTP_ERR_I_DOM_TO_REF_NOT_INIT,
+    /*! Count of gPTP ports exceeds the GPTP_DEF_PORTS_MAX */
+    GPTP_ERR_I_TOO_MANY_PORTS,
+
+    /* Prefix GPTP_ERR_A, Arithmetic errors category */
+    /*! Division by zero attempt */
+    GPTP_ERR_A_DIV_BY_0_ATTEMPT,
+
+    /* Prefix GPTP_ERR_C, Conversion errors category */
+    /*! Times stamp is incorrect to perform the calculation */
+    GPTP_ERR_C_TS_INCORRECT,
+
+    /* Prefix GPTP_ERR_T, Timestamp errors category */
+    /*! The time stamp is not registered */
+    GPTP_ERR_T_TS_NOT_REGISTERED,
+    /*! Unexpected time stamp received on the port */
+    GPTP_ERR_T_TS_NOT_IDENTIFIED,
+    /*! Incorrect Sync domain index (out of range) */
+    GPTP_ERR_T_SYNC_DOMAIN_INDEX,
+    /*! Incorrect Sync machine index (out of range) */
+    GPTP_ERR_T_SYNC_MACHINE_INDEX,
+    /*! Incorrect Pdelay machine index (out of range) */
+    GPTP_ERR_T_PDEL_MACHINE_INDEX,
+    /*! Incorrect frame id received for time-stamp handler*/
+    GPTP_ERR_T_FRAME_ID_ERROR,
+
+    /* Prefix GPTP_ERR_M, Message errors category */
+    /*! Double reception of the Pdelay response */
+    GPTP_ERR_M_PDEL_RESP_DBL_RCVD,
+    /*! Unknown message type received */
+    GPTP_ERR_M_MESSAGE_ID_INVALID,
+    /*! The time stamp doesn't match with send message */
+    GPTP_ERR_M_IDENTIFIERS_MISMATCH,
+    /*! Transport specific byte is not 1 */
+    GPTP_ERR_M_TRANSPORT_SPECIFIC,
+    /*! Sync message received on master sync machine */
+    GPTP_ERR_M_SYNC_ON_MASTER_RCVD,
+    /*! Follow Up message received on master sync machine */
+    GPTP_ERR_M_FUP_ON_MASTER_RCVD,
+    /*! Follow Up message received on Grand Master domain */
+    GPTP_ERR_M_SYNC_ON_GM_RCVD,
+    /*! Follow Up message received on Grand Master domain */
+    GPTP_ERR_M_FUP_ON_GM_RCVD,
+    /*! Sync message received for unknown domain */
+    GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN,
+    /*! Sync message received for unknown Sync machine */
+    GPTP_ERR_M_SYNC_MACHINE_UNKNOWN,
+    /*! Pdelay message received for unknown Pdelay machine */
+    GPTP_ERR_M_PDEL_MACHINE_UNKNOWN,
+    /*! Pointer to TX buffer is null */
+    GPTP_ERR_M_MSG_BUFF_PTR_NULL,
+    /*! No ETH type PTP in the incoming frame */
+    GPTP_ERR_M_NO_ETH_TYPE_PTP,
+    /*! No ETH type VLAN in the incoming frame */
+    GPTP_ERR_M_NO_ETH_TYPE_VLAN,
+
+    /* Prefix GPTP_ERR_N, NVM related error category */
+    /*! Unable to read data from NVM */
+    GPTP_ERR_N_UNABLE_NVM_READ,
+    /*! Unable to write data to the NVM */
+    GPTP_ERR_N_UNABLE_NVM_WRITE,
+
+    /* Prefix GPTP_ERR_P, Pdelay errors category */
+    /*! Lost Pdelay responses exceeded count of allowed lost responses */
+    GPTP_ERR_P_TOO_MANY_LOST_RESPS,
+    /*! Pdelay response timestamps far from the estimated neighbor rate ratio */
+    GPTP_ERR_P_RRATIO_OUTLIER,
+
+    /* Prefix GPTP_ERR_PI, PI controller errors category */
+    /*! Missing or incorrect configuration for PI Controller */
+    GPTP_ERR_PI_INCORRECT_CFG,
+    /*! Missing or incorrect configuration for Kalman servo */
+    GPTP_ERR_PI_KF_INCORRECT_CFG,
+
+    /* Prefix GPTP_ERR_S, Sync errors category */
+    /*! Lost GM, no incoming Sync messages */
+    GPTP_ERR_S_LOSS_OF_SYNC,
+    /*! State machine state error */
+    GPTP_ERR_S_MACHINE_STATE,
+    /*! Incorrect Time stamp for the follow-up message */
+    GPTP_ERR_S_INCORRECT_TS,
+    /*! Sync receipt time-out exceeded */
+    GPTP_ERR_S_RECEIPT_TIMEOUT,
+    /*! Estimated holdover time error exceeded the specification */
+    GPTP_ERR_S_HOLDOVER_OUT_OF_SPEC,
+
+    /* Prefix GPTP_ERR_L, Limit errors category */
+    /*! Residence time is too long */
+    GPTP_ERR_L_TOO_LONG_RESIDENCE,
+    /*! Turnaround time is too long on the Pdelay initiator - other side responds late */
+    GPTP_ERR_L_TOO_LONG_TURN_INIT,
+    /*! Turnaround time is too long on the Pdelay responder - the stack responds late */
+    GPTP_ERR_L_TOO_LONG_TURN_RESP,
+
+    /* Prefix GPTP_ERR_F, function category */
+    /*! Pointer to function is null */
+    GPTP_ERR_F_NULL_PTR,
+    /*! Function for reading time error */
+    GPTP_ERR_F_TIME_READ,
+    /*! Function for sending ptp frame error */
+    GPTP_ERR_F_FRAME_SEND,
+    /*! Function for updating ptp results error */
+    GPTP_ERR_F_UPDATE_PTP,
+
+    /* Prefix GPTP_ERR_API, API category */
+    /*! Unknown domain number used in API call */
+    GPTP_ERR_API_UNKNOWN_DOMAIN,
+    /*! Illegal machine ID used in API call */
+    GPTP_ERR_API_ILLEGAL_MACHINE_ID,
+    /*! Illegal port number used in API call */
+    GPTP_ERR_API_ILLEGAL_PORT_NUM,
+    /*! Illegal counter used in API call */
+    GPTP_ERR_API_ILLEGAL_CNTR_ID,
+
+    /* Prefix GPTP_ERR_V, variable error */
+    /*! Pointer to variable is null */
+    GPTP_ERR_V_NULL_PTR,
+
+    /*! Grand Master for the particular domain stopped working and the sync
+    messages from the up-stream gPTP bridge are still comming to the Slave port */
+    /* Prefix GPTP_ERR_O, Outside situation category */
+    GPTP_ERR_O_DOMAIN_GM_FAILURE,
+
+    /*! Reading of the error log with illegal index */
+    /* Prefix GPTP_ERR_E, error management category */
+    GPTP_ERR_E_READ_INDEX_TOO_HIGH,
+    /*! Illegal error type used in error management API call */
+    GPTP_ERR_E_ILLEGAL_ERR_TYPE,
+
+    /*! Overal number of gPTP errors  */
+    GPTP_ERR_NUMBER_OF_ERRS
+}gptp_err_type_t;
+
+/*!
+ * @brief Error log read structure
+ */
+typedef struct
+{   /*! Error type */
+    gptp_err_type_t                 eErrorType;
+    /*! gPTP port of the error occurence */
+    uint8_t                         u8RespGptpPortIndex;
+    /*! gPTP domain index of the error occurence */
+    uint8_t                         u8RespGptpDomainIndex;
+    /*! Sequence ID of message causing the error event (if applicable) */
+    uint16_t                        u16RespMsgSeqId;
+    /*! Time of the error occurence (local of global, depends on the error type */
+    gptp_def_timestamp_t            rLogTime;
+    /*! Time of the first occurence of the coalesced error, equal to rLogTime if not coalesced */
+    gptp_def_timestamp_t            rFirstLogTime;
+    /*! Count of the occurences coalesced in the log entry (saturates at 65535) */
+    uint16_t                        u16Count;
+    /*! Fresh log flag. Reports if the particular error log has been read before or if it is fresh new. Fresh = true */
+    bool                            bFreshLog;
+}gptp_err_error_t;
+
+/*!
+ * @brief Least-squares neighbor rate ratio estimator
+ */
+typedef struct
+{
+    /*! Local time of the samples relative to the origin [2^12 ns] */
+    int64_t                             as64X[GPTP_DEF_RRATIO_LSQ_WIN_MAX];
+    /*! Neighbor minus local time of the samples relative to the origin [ns] */
+    int64_t                             as64Y[GPTP_DEF_RRATIO_LSQ_WIN_MAX];
+    /*! Anchor of the sums - local time [2^12 ns] */
+    int64_t                             s64AnchorX;
+    /*! Anchor of the sums - neighbor minus local time [ns] */
+    int64_t                             s64AnchorY;
+    /*! Sum of x - anchor */
+    int64_t                             s64SumX;
+    /*! Sum of y - anchor */
+    int64_t                             s64SumY;
+    /*! Sum of squares of x - anchor */
+    int64_t                             s64SumXX;
+    /*! Sum of products of x - anchor and y - anchor */
+    int64_t                             s64SumXY;
+    /*! Local time of the origin [ns] */
+    uint64_t                            u64OriginLocalNs;
+    /*! Neighbor minus local time of the origin [ns] */
+    int64_t                             s64OriginOffsetNs;
+    /*! Local time of the last accepted sample [ns] */
+    uint64_t                            u64LastLocalNs;
+    /*! Slope of the fitted line in Q32 */
+    int64_t                             s64SlopeQ32;
+    /*! Estimated neighbor rate ratio */
+    float64_t                           f64RateRatio;
+    /*! Average absolute residual of the accepted samples [ns] */
+    uint32_t                            u32ResidAvgNs;
+    /*! Index of the oldest sample */
+    uint8_t                             u8Head;
+    /*! Count of samples in the window */
+    uint8_t                             u8Count;
+    /*! Count of consecutive rejected samples */
+    uint8_t                             u8Rejected;
+    /*! Estimated neighbor rate ratio valid - flag */
+    bool                                bRatioValid;
+}gptp_def_nrr_lsq_t;
+
+/*!
+ * @brief Sync offset filter window
+ */
+typedef struct
+{
+    /*! Sync receipt time on the uncorrected local clock [ns] */
+    int64_t                             as64RxRawNs[GPTP_DEF_OFS_FILT_WIN_MAX];
+    /*! GM minus uncorrected local time at the Sync receipt [ns] */
+    int64_t                             as64RawOffsetNs[GPTP_DEF_OFS_FILT_WIN_MAX];
+    /*! Corrected minus uncorrected local time at the newest Sync receipt [ns] */
+    int64_t                             s64PhaseNs;
+    /*! Median drift of the window in Q32, updated with every added Sync */
+    int64_t                             s64DriftQ32;
+    /*! Index of the oldest Sync */
+    uint8_t                             u8Head;
+    /*! Count of Syncs in the window */
+    uint8_t                             u8Count;
+}gptp_def_ofs_filt_t;
+
 /*!
  * @brief The structure gathering RX data
  */
@@ -527,6 +964,54 @@ typedef struct
     /* Source MAC address. */
     uint64_t                            u64SourceMac;
 }gptp_def_rx_data_t;
+
+/*!
+ * @brief Trace record types
+ */
+typedef enum
+{
+    /*! Start of the trace, FreeRunning time of GPTP_TRACE_Start */
+    GPTP_DEF_TRACE_REC_START = 1,
+    /*! Received gPTP frame with the ingress timestamp */
+    GPTP_DEF_TRACE_REC_RX,
+    /*! Egress timestamp of a transmitted frame */
+    GPTP_DEF_TRACE_REC_TX,
+    /*! Call of GPTP_TimerPeriodic */
+    GPTP_DEF_TRACE_REC_TICK
+}gptp_def_trace_rec_type_t;
+
+/*!
+ * @brief Decoded trace record
+ */
+typedef struct
+{
+    /*! Record type */
+    gptp_def_trace_rec_type_t           eType;
+    /*! gPTP port of the received or transmitted frame */
+    uint8_t                             u8PtpPort;
+    /*! FreeRunning time of the record [ns] */
+    uint64_t                            u64FreeRunNs;
+    /*! Ingress or egress timestamp - seconds */
+    uint32_t                            u32TsSec;
+    /*! Ingress or egress timestamp - nano seconds */
+    uint32_t                            u32TsNsec;
+    /*! Buffer index of the transmitted frame */
+    uint32_t                            u32BufferIndex;
+    /*! Message type of the transmitted frame, GPTP_DEF_MSG_TYPE_UNKNOWN if not identified */
+    gptp_def_msg_type_t                 eMsgType;
+    /*! Domain number of the transmitted Sync, 0 for Pdelay messages */
+    uint8_t                             u8DomainNumber;
+    /*! Sequence ID of the transmitted frame */
+    uint16_t                            u16SequenceId;
+    /*! Ethertype of the received frame */
+    uint16_t                            u16EthType;
+    /*! Source MAC address of the received frame */
+    uint64_t                            u64SourceMac;
+    /*! Length of the received gPTP data */
+    uint16_t                            u16Length;
+    /*! Pointer to the received gPTP data within the trace */
+    const uint8_t                       *cpu8Data;
+}gptp_def_trace_rec_t;
 /*! @} */
 
 /*!
@@ -640,6 +1125,10 @@ typedef uint8_t (*gptp_nvm_write_callback_t)(uint8_t u8PdelayMachine, gptp_def_n
  * @brief Callback function for NVM read access
  */
 typedef uint8_t (*gptp_nvm_read_callback_t)(uint8_t u8PdelayMachine, gptp_def_nvm_data_t eNvmDataType, float64_t *pf64Value);
+/*!
+ * @brief Callback function for asynchronous NVM read request, the value is delivered by GPTP_NvmReadDone
+ */
+typedef uint8_t (*gptp_nvm_read_req_callback_t)(uint8_t u8PdelayMachine, gptp_def_nvm_data_t eNvmDataType);
 /*!
  * @brief Callback function for error event notification
  */
@@ -648,6 +1137,10 @@ typedef void (*gptp_err_notify_t)(void);
  * @brief Callback function for synchronization notification.
  */
 typedef void (*gptp_syn_notify_t)(gptp_def_syn_lock_state_type_t eSyncLockState);
+/*!
+ * @brief Callback function writing the trace stream, called once per record
+ */
+typedef void (*gptp_trace_write_callback_t)(const uint8_t *cpu8Data, uint16_t u16Length);
 
 #ifdef GPTP_TIME_VALIDATION
 /*!
@@ -679,6 +1172,8 @@ typedef struct
     gptp_nvm_write_callback_t           pfNvmWriteCB;
     /*! Callback function for NVM read access */
     gptp_nvm_read_callback_t            pfNvmReadCB;
+    /*! Callback function for asynchronous NVM read request, pfNvmReadCB is not used when set */
+    gptp_nvm_read_req_callback_t        pfNvmReadReqCB;
     /*! Callback function for Error notification */
     gptp_err_notify_t                   pfErrNotify;
     /*! Callback function for synchronization notification. */
@@ -701,6 +1196,20 @@ typedef struct
  * @{
  */
 #ifdef GPTP_COUNTERS
+/*!
+ * @brief gPTP latency histogram, log-scale bins
+ */
+typedef struct
+{
+    /*! Count of latencies per bin, bin i holds the latencies below 2^(GPTP_DEF_HIST_FIRST_SHIFT + i) ns
+        not counted by the previous bins, the last bin is not bounded */
+    uint32_t    au32Bins[GPTP_DEF_HIST_BINS];
+    /*! Count of all the latencies */
+    uint32_t    u32Count;
+    /*! Maximal latency [ns] */
+    uint64_t    u64MaxNs;
+}gptp_def_histogram_t;
+
 /*!
  * @brief gPTP INTERNAL stucture - gPTP port mapping to the ports on switch
  */
@@ -708,6 +1217,8 @@ typedef struct
 {
     /*! Array of uint32_t - port counters */
     uint32_t    u32CountersPort[GPTP_COUNTERS_PORT_CNT];
+    /*! Port latency histograms, indexed by gptp_def_hist_id_t */
+    gptp_def_histogram_t arHistPort[GPTP_DEF_HIST_PORT_CNT];
 }gptp_def_countes_port_t;
 /*!
  * @brief gPTP INTERNAL stucture - gPTP port mapping to the ports on switch
@@ -716,6 +1227,8 @@ typedef struct
 {
     /*! Array of uint32_t - domain counters */
     uint32_t    u32CountersDom[GPTP_COUNTERS_DOM_CNT];
+    /*! Sync residence time histogram of the machine */
+    gptp_def_histogram_t rHistResidence;
 }gptp_def_countes_dom_t;
 #endif /* GPTP_COUNTERS */
 
@@ -792,6 +1305,10 @@ typedef struct
     uint8_t                             u8DomainId;
     /*! Sync machine acting as GM - flag */
     bool                                bSyncActingGm;
+#ifdef GPTP_COUNTERS
+    /*! Corrected time of the handover to the driver, 0 if not measured [ns] */
+    uint64_t                            u64EnqueueNs;
+#endif /* GPTP_COUNTERS */
 }gptp_def_frame_id_element_t;
 
 /*!
@@ -928,6 +1445,14 @@ typedef struct
     bool                                bSyncActingGm;
     /*! Pointer to array of TX buffer */
     uint8_t                             *pau8TxBuffPtr;
+#ifdef GPTP_TX_TEMPLATES
+    /*! Flag if the TX buffer holds a complete frame of eMsgId, only the volatile fields are patched then */
+    bool                                bTemplateValid;
+#endif /* GPTP_TX_TEMPLATES */
+#ifdef GPTP_TX_ZERO_COPY
+    /*! Index of the driver TX buffer pau8TxBuffPtr points into */
+    uint32_t                            u32BufferIndex;
+#endif /* GPTP_TX_ZERO_COPY */
     /*! Pointer to TX Cmd structure */
     void                                *pvTxCmd;
     /*! Pointer to Buffer index map for corresponding machine */
@@ -936,6 +1461,40 @@ typedef struct
     uint64_t                            u64DestMac;
 }gptp_def_tx_data_t;
 
+/*!
+ * @brief gPTP INTERNAL stucture - Timer wheel entry
+ */
+typedef struct gptp_def_timer_s
+{
+    /*! Next entry in the slot (ready) list */
+    struct gptp_def_timer_s             *prNext;
+    /*! Pointer to the link pointing to this entry, NULL if the entry is not armed */
+    struct gptp_def_timer_s             **pprPrev;
+    /*! Timer wheel the entry belongs to */
+    struct gptp_def_timer_wheel_s       *prWheel;
+    /*! Wake-up time (freerunning timebase) */
+    uint64_t                            u64WakeNs;
+    /*! Timer type */
+    gptp_def_timer_type_t               eType;
+    /*! Port or domain index of the owner */
+    uint8_t                             u8Index;
+    /*! Sync machine index of the owner */
+    uint8_t                             u8Machine;
+}gptp_def_timer_t;
+
+/*!
+ * @brief gPTP INTERNAL stucture - Timer wheel
+ */
+typedef struct gptp_def_timer_wheel_s
+{
+    /*! Wheel slots - lists of armed entries hashed by the wake-up tick */
+    gptp_def_timer_t                    *aprSlots[GPTP_DEF_TIMER_WHEEL_SLOTS];
+    /*! Lists of expired entries per timer type */
+    gptp_def_timer_t                    *aprReady[GPTP_DEF_TIMER_TYPES_CNT];
+    /*! First tick not yet fully checked */
+    uint64_t                            u64NextTick;
+}gptp_def_timer_wheel_t;
+
 /*!
  * @brief gPTP INTERNAL stucture - Pdelay machine
  */
@@ -998,6 +1557,10 @@ typedef struct
     gptp_def_mem_write_stat             rPdelayNvmWriteStat;
     /*! State machine for NVM writing Rate Ratio */
     gptp_def_mem_write_stat             rRratioNvmWriteStat;
+    /*! State of the asynchronous NVM read of Pdelay */
+    gptp_def_mem_read_stat              rPdelayNvmReadStat;
+    /*! State of the asynchronous NVM read of Rate Ratio */
+    gptp_def_mem_read_stat              rRratioNvmReadStat;
     /*! Structure containing Pdelay response follow-up TX data */
     gptp_def_tx_data_t                  rTxDataReFu;
     /*! Structure containing Pdelay response TX data */
@@ -1046,18 +1609,28 @@ typedef struct
     float64_t                           f64PdelayToWrite;
     /*! Rate ratio value to write into the NVM */
     float64_t                           f64RratioToWrite;
+    /*! Pdelay value last read from or written into the NVM */
+    float64_t                           f64PdelayNvm;
+    /*! Rate ratio value last read from or written into the NVM */
+    float64_t                           f64RratioNvm;
     /*! Pointer to clock ID */
     uint64_t                            *pu64ClockId;
+#ifndef GPTP_TX_ZERO_COPY
     /*! Array Pdelay request message buffer */
     uint8_t                             au8SendBuffPdelReq[GPTP_DEF_TX_BUF_LEN_PD_RQ];
+#endif /* GPTP_TX_ZERO_COPY */
     /*! Initial pdelay interval in log format */
     int8_t                              s8InitPdelayIntervalLog;
+#ifndef GPTP_TX_ZERO_COPY
     /*! Array Pdelay response message buffer */
     uint8_t                             au8SendBuffPdelResp[GPTP_DEF_TX_BUF_LEN_PD_RSP];
+#endif /* GPTP_TX_ZERO_COPY */
     /*! Operational pdelay interval in log format */
     int8_t                              s8OperPdelayIntervalLog;
+#ifndef GPTP_TX_ZERO_COPY
     /*! Array Pdelay response follow-up message buffer */
     uint8_t                             au8SendBuffPdelRespFup[GPTP_DEF_TX_BUF_LEN_PD_FUP];
+#endif /* GPTP_TX_ZERO_COPY */
     /*! Current pdelay interval in log format */
     int8_t                              s8PdelayIntervalLog;
     /*! Pdelay timer Pdelay request send due */
@@ -1068,6 +1641,12 @@ typedef struct
     uint64_t                            u64TurnaroundMeasStartPtpNsInit;
     /*! Start time of turnaround measurement on the responder side */
     uint64_t                            u64TurnaroundMeasStartPtpNsResp;
+    /*! Pdelay request transmission timer */
+    gptp_def_timer_t                    rTimerPdelaySend;
+    /*! Initiator turnaround time check timer */
+    gptp_def_timer_t                    rTimerTurnaroundInit;
+    /*! Responder turnaround time check timer */
+    gptp_def_timer_t                    rTimerTurnaroundResp;
     /* Source MAC address. */
     uint64_t                            u64SourceMac;
 #ifdef GPTP_TIME_VALIDATION
@@ -1080,6 +1659,8 @@ typedef struct
     /*! Global timestamp of Time validation on responder side */
     gptp_def_timestamp_t                rReferenceGlobalTimestampResp;
 #endif /* GPTP_TIME_VALIDATION */
+    /*! Least-squares neighbor rate ratio estimator */
+    gptp_def_nrr_lsq_t                  rRratioLsq;
     /*! Delay asymmetry for corresponding port [ns] */
     int16_t                             s16DelayAsymmetry;
 }gptp_def_pdelay_t;
@@ -1139,6 +1720,10 @@ typedef struct
     uint64_t                            u64TimerSyncSendDue;
     /*! Residence measurement start time */
     uint64_t                            u64ResidenceMeasStartPtpNs;
+    /*! Sync transmission timer */
+    gptp_def_timer_t                    rTimerSyncSend;
+    /*! Residence time check timer */
+    gptp_def_timer_t                    rTimerResidence;
     /*! Pointer to neighbor propagation delay for corresponding port */
     float64_t                           *pf64NeighborPropDelay;
     /*! Pointer to neighbor rate ratio for corresponding port */
@@ -1151,14 +1736,18 @@ typedef struct
     gptp_def_tx_data_t                  rTxDataSyn;
     /*! Propagatio ndelay in */
     uint32_t                            u32MeanPropDelay;
+#ifndef GPTP_TX_ZERO_COPY
     /*! Sync send buffer */
     uint8_t                             au8SendBuffSync[GPTP_DEF_TX_BUF_LEN_SYNC];
+#endif /* GPTP_TX_ZERO_COPY */
     /*! TR timestamp sequence ID */
     uint16_t                            u16TsTsSeqId;
     /*! Count of currently skipped syncs if the transmission is slower than reception */
     uint8_t                             u8SkippedSyncs;
+#ifndef GPTP_TX_ZERO_COPY
     /*! Follow-up send buffer */
     uint8_t                             au8SendBuffFup[GPTP_DEF_TX_BUF_LEN_FUP];
+#endif /* GPTP_TX_ZERO_COPY */
     /*! Sequence ID */
     uint16_t                            u16SequenceId;
     /*! Current sync interval in log format */
@@ -1180,6 +1769,185 @@ typedef struct
     float64_t                           f64NatFreqRatio;
 }gptp_def_pi_controller_conf_t;
 
+/*!
+ * @brief gPTP INTERNAL stucture - PI Controller context structure
+ */
+typedef struct
+{
+    /*! Current error value (input value of PI Controller) - int32_t */
+    int32_t                             s32error;
+    /*! Current calculated proportional value - int32_t */
+    int32_t                             s32proportional;
+    /*! Current calculated integrational value - int32_t */
+    int32_t                             s32integrational;
+    /*! Current calculated output value of PI Controller - int32_t */
+    int32_t                             s32calculated;
+#ifdef GPTP_FIXED_POINT
+    /*! Natural frequency times the sync interval (2*PI / ratio) in Q16 - int64_t */
+    int64_t                             s64WDtQ16;
+    /*! Natural frequency times the sync interval in ns (2*PI*1e9 / ratio) in Q16 - int64_t */
+    int64_t                             s64WDtNsQ16;
+    /*! Doubled damping ratio in Q16 - int64_t */
+    int64_t                             s64Damping2Q16;
+    /*! Current calculated proportional gain of PI Controller in Q16 - int64_t */
+    int64_t                             s64KpQ16;
+    /*! Current calculated integrational gain multiplied by the sync interval in Q16 - int64_t */
+    int64_t                             s64KiDtQ16;
+#else
+    /*! Current calculated proportional gain of PI Controller - float64_t */
+    float64_t                           f64Kp;
+    /*! Current calculated integrational gain of PI Controller - float64_t */
+    float64_t                           f64Ki;
+#endif /* GPTP_FIXED_POINT */
+    /*! Narrow band (halved natural frequency) used in the last update - flag */
+    bool                                bNarrowBand;
+    /*! PI Controller configuration structure - const pointer to struct */
+    const gptp_def_pi_controller_conf_t *prConfiguration;
+}gptp_def_pi_controller_t;
+
+/*!
+ * @brief gPTP INTERNAL stucture - Kalman filter servo configuration structure
+ */
+typedef struct
+{
+    /*! Process noise of the phase (white frequency noise of the oscillator) [ns^2/s] - float64_t */
+    float64_t                           f64PhaseNoise;
+    /*! Process noise of the frequency (random walk of the frequency) [ppb^2/s] - float64_t */
+    float64_t                           f64FreqNoise;
+    /*! Measurement noise of the Sync offset [ns^2], 0 leaves the Kalman servo unconfigured - float64_t */
+    float64_t                           f64MeasNoise;
+    /*! Part of the estimated phase removed in one Sync interval, (0, 1] - float64_t */
+    float64_t                           f64PhaseGain;
+    /*! Limit of the estimated frequency (max positive/negative value) [PPB], 0 for no limit - uint32_t */
+    uint32_t                            u32FreqLimit;
+}gptp_def_kf_conf_t;
+
+/*!
+ * @brief gPTP INTERNAL stucture - Kalman filter servo context structure
+ *
+ * The covariance is kept normalized - divided by the measurement noise, with
+ * the frequency in ns per Sync interval, so it does not depend on the units.
+ */
+typedef struct
+{
+    /*! Current error value (input value of the servo) - int32_t */
+    int32_t                             s32error;
+    /*! Current calculated output value of the servo - int32_t */
+    int32_t                             s32calculated;
+    /*! Count of measurements since the clear, saturated at 2 - uint8_t */
+    uint8_t                             u8Samples;
+#ifdef GPTP_FIXED_POINT
+    /*! Estimated phase error in Q16 [ns] - int64_t */
+    int64_t                             s64PhaseQ16;
+    /*! Estimated frequency error in Q16 [ppb] - int64_t */
+    int64_t                             s64FreqQ16;
+    /*! Normalized covariance of the phase in Q32 - int64_t */
+    int64_t                             s64P00Q32;
+    /*! Normalized covariance of the phase and frequency in Q32 - int64_t */
+    int64_t                             s64P01Q32;
+    /*! Normalized covariance of the frequency in Q32 - int64_t */
+    int64_t                             s64P11Q32;
+    /*! Normalized phase process noise per second in Q32 - int64_t */
+    int64_t                             s64Q0Q32;
+    /*! Normalized frequency process noise per second cubed in Q32 - int64_t */
+    int64_t                             s64Q1Q32;
+    /*! Phase gain in Q32 - int64_t */
+    int64_t                             s64PhaseGainQ32;
+#else
+    /*! Estimated phase error [ns] - float64_t */
+    float64_t                           f64Phase;
+    /*! Estimated frequency error [ppb] - float64_t */
+    float64_t                           f64Freq;
+    /*! Normalized covariance of the phase - float64_t */
+    float64_t                           f64P00;
+    /*! Normalized covariance of the phase and frequency - float64_t */
+    float64_t                           f64P01;
+    /*! Normalized covariance of the frequency - float64_t */
+    float64_t                           f64P11;
+#endif /* GPTP_FIXED_POINT */
+    /*! Kalman servo configuration structure - const pointer to struct */
+    const gptp_def_kf_conf_t            *prConfiguration;
+}gptp_def_kf_t;
+
+/*!
+ * @brief gPTP INTERNAL stucture - Holdover frequency model
+ *
+ * While the clock is synchronized, the applied frequency correction is averaged
+ * over the sample interval and kept in the history. The frequency and its drift
+ * (aging) are fitted over the history and extrapolated while the Sync is lost.
+ */
+typedef struct
+{
+    /*! Sample times, middle of the averaging interval (free running) [ns] */
+    uint64_t                            au64TimeNs[GPTP_DEF_HOLD_HIST_LEN];
+    /*! Average frequency correction over the interval in Q8 [ppb] */
+    int32_t                             as32FreqQ8[GPTP_DEF_HOLD_HIST_LEN];
+    /*! Index of the oldest sample */
+    uint8_t                             u8Head;
+    /*! Count of samples */
+    uint8_t                             u8Count;
+    /*! Averaging interval [ns] */
+    uint64_t                            u64SampleNs;
+    /*! First correction time of the running average [ns] */
+    uint64_t                            u64AvgStartNs;
+    /*! Last correction time of the running average [ns] */
+    uint64_t                            u64AvgLastNs;
+    /*! Sum of the corrections of the running average [ppb] */
+    int64_t                             s64AvgSumPpb;
+    /*! Count of the corrections of the running average */
+    uint32_t                            u32AvgCnt;
+    /*! The fit below is valid */
+    bool                                bFitValid;
+    /*! Reference time of the fit, mean of the sample times [ns] */
+    uint64_t                            u64FitRefNs;
+    /*! Fitted frequency correction at the reference time [ppb] */
+    float64_t                           f64FreqPpb;
+    /*! Fitted drift of the frequency correction [ppb/s] */
+    float64_t                           f64AgingPpbS;
+    /*! Standard error of the fitted frequency correction [ppb] */
+    float64_t                           f64FreqSdPpb;
+    /*! Standard error of the fitted drift [ppb/s] */
+    float64_t                           f64AgingSdPpbS;
+    /*! Last applied frequency correction, tracked or holdover [ppb] */
+    int32_t                             s32LastPpb;
+    /*! Local clock is in holdover */
+    bool                                bActive;
+    /*! Time error bound above the specification has been reported in this holdover */
+    bool                                bSpecReported;
+    /*! Holdover entry time [ns] */
+    uint64_t                            u64EntryNs;
+    /*! Absolute offset to the GM at the holdover entry [ns] */
+    uint64_t                            u64EntryOffsetNs;
+    /*! Time of the last applied holdover correction [ns] */
+    uint64_t                            u64LastApplyNs;
+    /*! Time error specification of the holdover [ns], 0 for no check */
+    uint32_t                            u32SpecNs;
+}gptp_def_holdover_t;
+
+/*!
+ * @brief Holdover status
+ */
+typedef struct
+{
+    /*! Local clock is in holdover */
+    bool                                bActive;
+    /*! Frequency model is fitted, otherwise the averaged last correction is applied */
+    bool                                bModelValid;
+    /*! Time spent in the holdover [ns] */
+    uint64_t                            u64DurationNs;
+    /*! Frequency correction applied (in holdover) or extrapolated for now [ppb] */
+    int32_t                             s32FreqPpb;
+    /*! Fitted drift of the frequency correction [ppb/hour] */
+    int32_t                             s32AgingPpbPerHour;
+    /*! Estimated bound (3 sigma) of the time error accumulated in the holdover [ns],
+        all ones without the frequency model */
+    uint64_t                            u64TimeErrorBoundNs;
+    /*! Remaining time of the holdover until the bound exceeds the specification [ns],
+        for a holdover started now when the clock is synchronized. All ones
+        when the bound does not grow, 0 without the specification or the model */
+    uint64_t                            u64WithinSpecNs;
+}gptp_def_holdover_info_t;
+
 /*!
  * @brief gPTP INTERNAL stucture - Synchronization notification parameters.
  */
@@ -1238,6 +2006,16 @@ typedef struct
     float64_t                           f64PdelAvgWeight;
     /*! Rate ratio filter weight */
     float64_t                           f64RratioAvgWeight;
+    /*! Neighbor rate ratio estimator */
+    gptp_def_rratio_estim_t             eRratioEstimator;
+    /*! Count of samples of the least-squares rate ratio window */
+    uint8_t                             u8RratioLsqWindow;
+#ifdef GPTP_FIXED_POINT
+    /*! Pdelay filter weight in Q16 */
+    uint32_t                            u32PdelAvgWeightQ16;
+    /*! Rate ratio filter weight in Q16 */
+    uint32_t                            u32RratioAvgWeightQ16;
+#endif /* GPTP_FIXED_POINT */
     /*! Rate ratio maximum allowed deviation */
     float64_t                           f64RratioMaxDev;
     /*! Threshold for Pdelay writing into the NVM */
@@ -1246,8 +2024,12 @@ typedef struct
     float64_t                           f64RratioNvmWriteThr;
     /*! Corrected clock rate ratio */
     float64_t                           f64CorrClockRateRatio;
+    /*! Frequency correction applied to the local clock [ppb] */
+    int32_t                             s32ClockAdjPpb;
     /*! Frame ID table carrying transmitted frames details */
     gptp_def_frame_id_element_t         arFrameIdTable[256];
+    /*! Domain index by domain number on wire */
+    uint8_t                             au8DomainLookup[GPTP_DEF_DOMAIN_NUM_CNT];
     /*! Last reported GM offset to the synchronization mechanism */
     gptp_def_timestamp_sig_t            rReportedOffset;
     /*! Estimated offset of local clock to the GM clock */
@@ -1256,10 +2038,18 @@ typedef struct
     gptp_def_timestamp_t                rLastFreeRunRef;
     /*! PI Controller configuration structure */
     gptp_def_pi_controller_conf_t       rPIControllerConfig;
+    /*! Kalman servo configuration structure */
+    gptp_def_kf_conf_t                  rKalmanConfig;
     /*! Data structure containing all synchronization notification parameters. */
     gptp_def_params_syn_lock_t          rSynLockParam;
     /*! PI Controller maximum threshold - creates PI Controller action band */
     uint64_t                            u64PIControllerMaxThreshold;
+    /*! Holdover frequency model of the local clock */
+    gptp_def_holdover_t                 rHoldover;
+#ifdef GPTP_COUNTERS
+    /*! Corrected time since which the timestamps are not ambiguous due to the last clock step [ns] */
+    uint64_t                            u64StepValidFromNs;
+#endif /* GPTP_COUNTERS */
 }gptp_def_device_t;
 
 /*!
@@ -1290,6 +2080,10 @@ typedef struct
     bool                                bDomainIsGm;
     /*! If the sync is acting  */
     bool                                bSyncActingGm;
+#ifdef GPTP_USE_PRINTF
+    /*! Acting Grand Master state reported on the console - flag */
+    bool                                bActingGmReported;
+#endif /* GPTP_USE_PRINTF */
     /*! Synced GM - flag */
     bool                                bSyncedGm;
     /*! GM failure already reported - flag */
@@ -1332,18 +2126,40 @@ typedef struct
     uint64_t                            u64TimerSyncCheckDue;
     /*! Sync receipt timeout due */
     uint64_t                            u64TimerSyncReceiptTimeoutDue;
+    /*! Sync interval check timer */
+    gptp_def_timer_t                    rTimerSyncCheck;
+    /*! Sync receipt timeout timer */
+    gptp_def_timer_t                    rTimerReceiptTimeout;
+    /*! PI Controller servoing the local clock to the domain GM */
+    gptp_def_pi_controller_t            rPi;
+    /*! Servo of the local clock */
+    gptp_def_servo_type_t               eServoType;
+    /*! Kalman servo of the local clock, used instead of the PI Controller */
+    gptp_def_kf_t                       rKf;
     /*! Threshold for the Sync outlier reception */
     uint32_t                            u32SyncOutlierThrNs;
+    /*! Sync offset filter */
+    gptp_def_ofs_filt_type_t            eOfsFiltType;
+    /*! Count of offsets in the Sync offset filter window */
+    uint8_t                             u8OfsFiltWindow;
+    /*! Interquartile range multiple of the adaptive outlier threshold, 0 for the fixed threshold */
+    uint8_t                             u8OfsFiltIqrGain;
+    /*! Sync offset filter window */
+    gptp_def_ofs_filt_t                 rOfsFilt;
     /*! Structure containing data for signaling transmission */
     gptp_def_tx_data_t                  rTxDataSig;
+#ifndef GPTP_TX_ZERO_COPY
     /*! Signaling send buffer */
     uint8_t                             au8SendBuffSig[GPTP_DEF_TX_BUF_LEN_SIGNL];
+#endif /* GPTP_TX_ZERO_COPY */
     /*! Vlan information */
     uint16_t                            u16VlanTci;
     /*! Sync interval of incoming Sync messages */
     int8_t                              s8SyncIntervalLogRcvd;
     /*! Pointer to array od Sync machine structures */
     gptp_def_sync_t                     *prSyncMachines;
+    /*! Sync machine index by gPTP port */
+    uint8_t                             au8SyncMachineLookup[GPTP_DEF_PORTS_MAX];
     /*! Last valid GM time plus correction */
     gptp_def_timestamp_t                rLastValidGmPlusCor;
     /*! Last valid Timestamp from GM plus correction */
@@ -1356,6 +2172,23 @@ typedef struct
 #endif /* GPTP_COUNTERS */
 }gptp_def_domain_t;
 
+/*!
+ * @brief Error log of the stack instance
+ */
+typedef struct
+{
+    /*! Circular log, u16Head points to the latest log */
+    gptp_err_error_t                    arLog[GPTP_ERR_LOG_LENGTH];
+    /*! Slot of the latest log */
+    uint16_t                            u16Head;
+    /*! Count of valid logs */
+    uint16_t                            u16Count;
+    /*! Slot of the latest log per error type */
+    uint16_t                            au16LastSlot[GPTP_ERR_NUMBER_OF_ERRS];
+    /*! Error types with coalescing enabled */
+    uint32_t                            au32Coalesce[GPTP_ERR_COALESCE_WORDS];
+}gptp_def_err_log_t;
+
 /*!
  * @brief gPTP INTERNAL stucture - Main data structure containing all the instance data
  */
@@ -1373,14 +2206,22 @@ typedef struct
     gptp_def_pdelay_t                   *prPdelayMachines;
     /*! Data structure containing pointers to all callback functions */
     gptp_def_cb_funcs_t                 rPtpStackCallBacks;
+    /*! Error log of the instance */
+    gptp_def_err_log_t                  rErrLog;
 #ifdef GPTP_COUNTERS
     /*! Pointer to port specific counters */
     gptp_def_countes_port_t             *prCntrsPort;
 #endif /* GPTP_COUNTERS */
     /*! Sync status calculation due */
     uint64_t                            u64SyncStatCalcDue;
+    /*! Synchronization status calculation timer */
+    gptp_def_timer_t                    rTimerSyncStat;
+    /*! Timer wheel holding all the armed internal timers */
+    gptp_def_timer_wheel_t              rTimerWheel;
     /*! Local clock is to be updated - flag */
     bool                                bLocClkToUpdate;
+    /*! Port layer data of the instance, see GPTP_GetMainStrPtr */
+    void                                *pvPortCtx;
     /*! gPTP stack initialized - flag */
     bool                                bGptpInitialized;
 }gptp_def_data_t;
@@ -1475,6 +2316,16 @@ typedef struct
     uint32_t                            u32SyncOutlierThrNs;
     /*! Count of consecutive outliers to drop */
     uint8_t                             u8OutlierIgnoreCnt;
+    /*! Sync offset filter applied before the local clock update (none by default) */
+    gptp_def_ofs_filt_type_t            eOfsFiltType;
+    /*! Count of offsets in the Sync offset filter window (0 for the maximum) */
+    uint8_t                             u8OfsFiltWindow;
+    /*! Adaptive outlier threshold - the Sync offset is an outlier when it is further
+        than this multiple of the interquartile range of the window from the quartiles.
+        0 keeps the fixed threshold u32SyncOutlierThrNs */
+    uint8_t                             u8OfsFiltIqrGain;
+    /*! Servo of the local clock, the Kalman servo needs rKalmanConfig */
+    gptp_def_servo_type_t               eServoType;
     /*! Synchronized Grand Master transmits Corrected time, instead of free running. */
     bool                                bSyncedGm;
     /*! Domain is Grand Master = true / domain is not Grand Master = false */
@@ -1524,6 +2375,10 @@ typedef struct
     float64_t                           f64PdelAvgWeight;
     /*! Rate ratio averaging filter weight */
     float64_t                           f64RratioAvgWeight;
+    /*! Neighbor rate ratio estimator (the exponential average by default) */
+    gptp_def_rratio_estim_t             eRratioEstimator;
+    /*! Count of samples of the least-squares rate ratio window (0 for the maximum) */
+    uint8_t                             u8RratioLsqWindow;
     /*! Rate ratio maximum deviation */
     float64_t                           f64RratioMaxDev;
     /*! Pdelay NVM threshold - if current pdelay is different of the threshold, the value in the NVM is updated */
@@ -1538,14 +2393,23 @@ typedef struct
     gptp_def_pdelay_t                   *paPdelay;
     /*! PI Controller configuration structure */
     gptp_def_pi_controller_conf_t       rPIControllerConfig;
+    /*! Kalman servo configuration structure, shared by the domains selecting the Kalman servo */
+    gptp_def_kf_conf_t                  rKalmanConfig;
     /*! PI Controller maximum threshold - creates PI Controller action band */
     uint64_t                            u64PIControllerMaxThreshold;
+    /*! Averaging interval of the holdover frequency history [s], 0 for GPTP_DEF_HOLD_SAMPLE_S_DEF */
+    uint8_t                             u8HoldoverSampleS;
+    /*! Time error specification of the holdover [ns], GPTP_ERR_S_HOLDOVER_OUT_OF_SPEC
+        is registered when the estimated bound exceeds it, 0 for no check */
+    uint32_t                            u32HoldoverSpecNs;
     /*! Data structure containing pointers to all callback functions */
     gptp_def_cb_funcs_t                 rPtpStackCallBacks;
 #ifdef GPTP_COUNTERS
     /*! Pointer to port counters array */
     gptp_def_countes_port_t             *prCntrsPort;
 #endif /* GPTP_COUNTERS */
+    /*! Port layer data of the instance, NULL if the port layer serves a single instance */
+    void                                *pvPortCtx;
 }gptp_def_init_params_t;
 /*! @} */
 
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#ifndef GPTP_FILT
+    #define GPTP_FILT
+
+#include "gptp_def.h"
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief   This function empties the Sync offset filter window.
+ *
+ * @param[out] prFilt Pointer to the filter window (one per domain).
+ */
+void GPTP_FILT_Reset(gptp_def_ofs_filt_t *prFilt);
+
+/*!
+ * @brief   This function adds the Sync to the window, the oldest one is dropped
+ *          when the window is full.
+ *
+ * @details The frequency correction applied since the previous Sync is
+ *          integrated, so the window keeps GM minus uncorrected local time,
+ *          which the servo does not change. The window restarts if the receipt
+ *          time does not advance or the Syncs are too far apart.
+ *
+ * @param[in,out] prFilt Pointer to the filter window.
+ * @param[in] u8Window Count of Syncs in the window.
+ * @param[in] s64RxNs Sync receipt time on the local clock [ns].
+ * @param[in] s64OffsetNs GM minus local time at the Sync receipt [ns].
+ * @param[in] s32FreqAdjPpb Frequency correction of the local clock since the previous Sync [ppb].
+ */
+void GPTP_FILT_Add(gptp_def_ofs_filt_t *prFilt,
+                   uint8_t u8Window,
+                   int64_t s64RxNs,
+                   int64_t s64OffsetNs,
+                   int32_t s32FreqAdjPpb);
+
+/*!
+ * @brief   This function returns the filtered offset at the newest Sync receipt.
+ *
+ * @details Every Sync of the window is moved to the newest receipt time along
+ *          the median drift of the window, so the filter does not delay the
+ *          servo loop. The median or the least delayed Sync (the maximum of
+ *          GM minus local time, queuing only delays the Sync) is returned,
+ *          the newest Sync for GPTP_DEF_OFS_FILT_NONE.
+ *
+ * @param[in] prFilt Pointer to the filter window.
+ * @param[in] eType Filter type.
+ * @param[out] ps64OffsetNs Filtered GM minus local time [ns].
+ * @return true if the window is not empty, false otherwise.
+ */
+bool GPTP_FILT_Output(const gptp_def_ofs_filt_t *prFilt,
+                      gptp_def_ofs_filt_type_t eType,
+                      int64_t *ps64OffsetNs);
+
+/*!
+ * @brief   This function calculates the adaptive outlier fences for the next Sync.
+ *
+ * @details The offset below Q1 - k * IQR or above Q3 + k * IQR is an outlier,
+ *          where Q1 and Q3 are the quartiles of the window moved to the receipt
+ *          time and IQR = Q3 - Q1. The margin k * IQR has a floor, so a window
+ *          of equal offsets does not reject every new one.
+ *
+ * @param[in] prFilt Pointer to the filter window.
+ * @param[in] u8Gain Multiple k of the interquartile range.
+ * @param[in] s64RxNs Sync receipt time on the local clock [ns].
+ * @param[in] s32FreqAdjPpb Frequency correction of the local clock since the previous Sync [ppb].
+ * @param[out] ps64LowNs Lower fence of GM minus local time [ns].
+ * @param[out] ps64HighNs Upper fence of GM minus local time [ns].
+ * @return true if the window holds enough Syncs for the quartiles, false otherwise.
+ */
+bool GPTP_FILT_IqrFences(const gptp_def_ofs_filt_t *prFilt,
+                         uint8_t u8Gain,
+                         int64_t s64RxNs,
+                         int32_t s32FreqAdjPpb,
+                         int64_t *ps64LowNs,
+                         int64_t *ps64HighNs);
+
+#endif /* GPTP_FILT */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -28,6 +28,7 @@
 #define GPTP_FR_ETH_TYPE_VLAN                       0x8100u
 
 /* Ethernet frame field ofssets */
+#define GPTP_FR_SRC_MAC_OFFSET                      6u
 #define GPTP_FR_ETH_TYPE_OFFSET                     12u
 #define GPTP_FR_MSG_ID_OFFSET                       0u
 #define GPTP_FR_DOMAIN_NUM                          4u
@@ -35,6 +36,7 @@
 #define GPTP_FR_SC_CLK_ID_OFFSET                    20u
 #define GPTP_FR_SC_PORT_ID_OFFSET                   28u
 #define GPTP_FR_SEQ_ID_OFFSET                       30u
+#define GPTP_FR_CONTROL_OFFSET                      32u
 #define GPTP_FR_MSG_PER_LOG_OFFSET                  33u
 #define GPTP_FR_TS_S_OFFSET                         34u
 #define GPTP_FR_TS_NS_OFFSET                        40u
@@ -48,6 +50,9 @@
 #define GPTP_FR_LAST_GM_PHASE_CHANGE_L              64u
 #define GPTP_FR_SCALED_LAST_GM_F_CHANGE             72u
 
+/* PTP common header length */
+#define GPTP_FR_HDR_LEN                             34u
+
 /* Follow up TLV length field */
 #define GPTP_FR_FUP_TLV_FIELD_LEN                   28u
 /* Follow up TLV type */
@@ -81,6 +86,22 @@
 /* All other messages */
 #define GPTP_FR_CONTROL_OTHER                       0x05
 
+/*! PTP common header, field by field as carried on the wire */
+typedef struct
+{
+    uint8_t  u8MsgIdTs;         /*!< Transport specific (upper nibble) and message type (lower nibble) */
+    uint8_t  u8Version;         /*!< Reserved (upper nibble) and PTP version (lower nibble) */
+    uint16_t u16MsgLength;      /*!< Message length */
+    uint8_t  u8DomainNum;       /*!< Domain number on wire */
+    uint16_t u16Flags;          /*!< Flags */
+    uint64_t u64Correction;     /*!< Correction field [2^-16 ns] */
+    uint64_t u64SrcClockId;     /*!< Source clock identity */
+    uint16_t u16SrcPortId;      /*!< Source port number, as on wire (1-based) */
+    uint16_t u16SequenceId;     /*!< Sequence id */
+    uint8_t  u8Control;         /*!< Control field */
+    int8_t   s8LogMsgPeriod;    /*!< Log message period */
+} gptp_frame_hdr_t;
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -104,10 +125,34 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                                    uint8_t *pu8DomainRcvd,
                                    uint8_t *pu8MachineRcvd);
 
+/*!
+ * @brief The function decodes the PTP common header.
+ *
+ * All fields of the 34 byte header are read in one pass.
+ *
+ * @param[in] cpu8Hdr Pointer to the first byte of the PTP header, no alignment required
+ * @param[out] prHdr Decoded header
+ */
+void GPTP_FRAME_HdrDecode(const uint8_t *cpu8Hdr,
+                          gptp_frame_hdr_t *prHdr);
+
+/*!
+ * @brief The function encodes the PTP common header.
+ *
+ * All 34 bytes of the header, reserved fields included, are written in one pass.
+ *
+ * @param[out] pu8Hdr Pointer to the first byte of the PTP header, no alignment required
+ * @param[in] cprHdr Header to be encoded
+ */
+void GPTP_FRAME_HdrEncode(uint8_t *pu8Hdr,
+                          const gptp_frame_hdr_t *cprHdr);
+
 /*!
  * @brief The function builds PTP ethernet frame to send
  *
- * The function builds PTP ethernet frame to send
+ * The function builds PTP ethernet frame to send. With GPTP_TX_TEMPLATES
+ * defined, the complete frame is built only once into the machine TX buffer,
+ * the following calls patch just the fields which differ between transmissions.
  *
  * @param[in] prGptp pointe to global data structure
  * @param[in] ptxData pointer to tx data buffer
@@ -120,6 +165,20 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
                         const uint8_t u8Domain,
                         const uint8_t u8Port);
 
+#ifdef GPTP_TX_TEMPLATES
+/*!
+ * @brief The function invalidates the TX frame templates of the gPTP port
+ *
+ * Templates of the Pdelay machine of the port, of all Sync machines on the port
+ * and the Signaling templates of all domains are rebuilt on the next transmission.
+ *
+ * @param[in] prGptp pointer to global data structure
+ * @param[in] u8Port gPTP port number
+ */
+void GPTP_FRAME_TemplatesInvalidate(const gptp_def_data_t *prGptp,
+                                    const uint8_t u8Port);
+#endif /* GPTP_TX_TEMPLATES */
+
 #endif /* GPTP_FRAME */
 /*******************************************************************************
  * EOF
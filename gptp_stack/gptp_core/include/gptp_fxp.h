@@ -0,0 +1,153 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#ifndef GPTP_FXP
+    #define GPTP_FXP
+
+#include "gptp_def.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*!
+ * @name Fixed-point formats
+ * @details Rate ratios are kept in signed Q32.32, nanosecond intervals
+ *          (path delay, correction), filter weights and PI gains in signed
+ *          Q48.16. Both fit into
+ *          the float64_t mantissa, so a float64_t holding a value produced
+ *          by this module converts back without any loss.
+ * @{
+ */
+/*! Count of fractional bits of the Q32.32 format (rate ratio) */
+#define GPTP_FXP_Q32_FRAC_BITS          32u
+/*! Count of fractional bits of the Q48.16 format (nanoseconds, weights, gains) */
+#define GPTP_FXP_Q16_FRAC_BITS          16u
+/*! 1.0 in the Q32.32 format */
+#define GPTP_FXP_Q32_ONE                (4294967296)
+/*! 1.0 in the Q48.16 format */
+#define GPTP_FXP_Q16_ONE                (65536)
+/*! Steps of the cumulative scaled rate offset (2^-41) in one Q32.32 step */
+#define GPTP_FXP_CS_RATE_SCALE          (512)
+/*! @} */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#ifdef GPTP_FIXED_POINT
+
+/*!
+ * @brief   This function converts float64_t to Q32.32.
+ *
+ * @param[in] f64Value Value to be converted.
+ * @return Value rounded to the nearest Q32.32 step.
+ */
+int64_t GPTP_FXP_Float64ToQ32(float64_t f64Value);
+
+/*!
+ * @brief   This function converts Q32.32 to float64_t.
+ *
+ * @param[in] s64Value Value in Q32.32.
+ * @return Exact float64_t image of the value.
+ */
+float64_t GPTP_FXP_Q32ToFloat64(int64_t s64Value);
+
+/*!
+ * @brief   This function converts float64_t to Q48.16.
+ *
+ * @param[in] f64Value Value to be converted.
+ * @return Value rounded to the nearest Q48.16 step.
+ */
+int64_t GPTP_FXP_Float64ToQ16(float64_t f64Value);
+
+/*!
+ * @brief   This function converts Q48.16 to float64_t.
+ *
+ * @param[in] s64Value Value in Q48.16.
+ * @return Exact float64_t image of the value.
+ */
+float64_t GPTP_FXP_Q16ToFloat64(int64_t s64Value);
+
+/*!
+ * @brief   This function converts the averaging weight to Q16.
+ *
+ * @details The weight is clamped to the <0.0, 1.0> range.
+ *
+ * @param[in] f64Weight Weight of the previous average.
+ * @return Weight in Q16.
+ */
+uint32_t GPTP_FXP_Float64ToWeight(float64_t f64Weight);
+
+/*!
+ * @brief   This function calculates ratio of two intervals.
+ *
+ * @param[in] u64Numerator Numerator interval [ns].
+ * @param[in] u64Denominator Denominator interval [ns], must be non-zero and
+ *            below 2^47.
+ * @return u64Numerator / u64Denominator in Q32.32, truncated.
+ */
+int64_t GPTP_FXP_RatioCalc(uint64_t u64Numerator,
+                           uint64_t u64Denominator);
+
+/*!
+ * @brief   This function multiplies a value by the rate ratio.
+ *
+ * @param[in] s64Value Value in any fixed-point format.
+ * @param[in] s64Ratio Rate ratio in Q32.32.
+ * @return s64Value * s64Ratio in the format of s64Value, rounded.
+ */
+int64_t GPTP_FXP_RatioMul(int64_t s64Value,
+                          int64_t s64Ratio);
+
+/*!
+ * @brief   This function divides a value by the rate ratio.
+ *
+ * @param[in] s64Value Value in any fixed-point format.
+ * @param[in] s64Ratio Rate ratio in Q32.32, must be non-zero and its absolute
+ *            value below 2^47.
+ * @return s64Value / s64Ratio in the format of s64Value, truncated.
+ */
+int64_t GPTP_FXP_RatioDiv(int64_t s64Value,
+                          int64_t s64Ratio);
+
+/*!
+ * @brief   This function applies exponential averaging.
+ *
+ * @details Result is (w * s64Average) + ((1 - w) * s64Sample) computed as
+ *          s64Average + ((1 - w) * (s64Sample - s64Average)).
+ *
+ * @param[in] s64Average Previous average in any fixed-point format.
+ * @param[in] s64Sample New sample in the same format.
+ * @param[in] u32WeightQ16 Weight of the previous average in Q16.
+ * @return New average, rounded.
+ */
+int64_t GPTP_FXP_Average(int64_t s64Average,
+                         int64_t s64Sample,
+                         uint32_t u32WeightQ16);
+
+/*!
+ * @brief   This function multiplies a value by the Q16 gain.
+ *
+ * @param[in] s32Value Value to be multiplied.
+ * @param[in] s64GainQ16 Gain in Q16, its absolute value must be below 2^32.
+ * @return s32Value * s64GainQ16 rounded towards zero and saturated to int32_t.
+ */
+int32_t GPTP_FXP_GainMul(int32_t s32Value,
+                         int64_t s64GainQ16);
+
+#endif /* GPTP_FIXED_POINT */
+
+#endif /* GPTP_FXP */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#ifndef GPTP_HOLD
+    #define GPTP_HOLD
+
+#include "gptp_def.h"
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief   This function initializes the holdover frequency model.
+ *
+ * @param[out] prHold Pointer to the holdover model.
+ * @param[in] u8SampleS Averaging interval of the history [s], 0 for GPTP_DEF_HOLD_SAMPLE_S_DEF.
+ * @param[in] u32SpecNs Time error specification of the holdover [ns], 0 for no check.
+ */
+void GPTP_HOLD_Init(gptp_def_holdover_t *prHold,
+                    uint8_t u8SampleS,
+                    uint32_t u32SpecNs);
+
+/*!
+ * @brief   This function records the frequency correction applied to the local clock.
+ *
+ * @details Any correction ends the holdover. Only corrections of the synchronized
+ *          clock are averaged into the history, each full averaging interval
+ *          refits the frequency and its drift.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @param[in] s32Ppb Applied frequency correction [ppb].
+ * @param[in] bSynced The clock is synchronized and the correction is not a clock step.
+ */
+void GPTP_HOLD_Track(gptp_def_holdover_t *prHold,
+                     uint64_t u64TimeNs,
+                     int32_t s32Ppb,
+                     bool bSynced);
+
+/*!
+ * @brief   This function returns the frequency correction to be applied in the holdover.
+ *
+ * @details The first call after the last correction starts the holdover.
+ *          Without the fitted model, the fallback correction is returned.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @param[in] s32FallbackPpb Correction applied without the fitted model [ppb].
+ * @param[in] u64OffsetNs Absolute offset to the GM at the holdover start [ns].
+ * @return Frequency correction [ppb].
+ */
+int32_t GPTP_HOLD_Enter(gptp_def_holdover_t *prHold,
+                        uint64_t u64TimeNs,
+                        int32_t s32FallbackPpb,
+                        uint64_t u64OffsetNs);
+
+/*!
+ * @brief   This function checks whether the holdover correction is to be updated.
+ *
+ * @param[in] cprHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @return true in the holdover with the fitted model, once per averaging interval.
+ */
+bool GPTP_HOLD_ApplyDue(const gptp_def_holdover_t *cprHold,
+                        uint64_t u64TimeNs);
+
+/*!
+ * @brief   This function checks the time error bound against the specification.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @return true once per holdover, when the bound exceeds the specification.
+ */
+bool GPTP_HOLD_SpecExceeded(gptp_def_holdover_t *prHold,
+                            uint64_t u64TimeNs);
+
+/*!
+ * @brief   This function provides the holdover status.
+ *
+ * @param[in] cprHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @param[out] prInfo Pointer to the holdover status.
+ */
+void GPTP_HOLD_InfoGet(const gptp_def_holdover_t *cprHold,
+                       uint64_t u64TimeNs,
+                       gptp_def_holdover_info_t *prInfo);
+
+#endif /* GPTP_HOLD */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -152,6 +152,77 @@ gptp_err_type_t GPTP_INTERNAL_GetStatsValue(const gptp_def_data_t *prGptp,
  */
 void GPTP_INTERNAL_ClearStats(const gptp_def_data_t *prGptp);
 
+/*!
+ * @brief Port latency histogram update function.
+ *
+ * This function adds the latency into the port histogram.
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ * @param[in] u8Port Respective gPTP port.
+ * @param[in] eHist Port histogram to update.
+ * @param[in] u64StartNs Start of the latency [ns].
+ * @param[in] u64EndNs End of the latency [ns].
+ */
+void GPTP_INTERNAL_PortHistAdd(const gptp_def_data_t *prGptp,
+                               uint8_t u8Port,
+                               gptp_def_hist_id_t eHist,
+                               uint64_t u64StartNs,
+                               uint64_t u64EndNs);
+
+/*!
+ * @brief Sync residence time histogram update function.
+ *
+ * This function adds the residence time into the histogram of the sync machine.
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ * @param[in] u8Domain Respective gPTP domain index.
+ * @param[in] u8Machine Respective sync machine of the domain.
+ * @param[in] u64StartNs Start of the residence [ns].
+ * @param[in] u64EndNs End of the residence [ns].
+ */
+void GPTP_INTERNAL_DomainHistAdd(const gptp_def_data_t *prGptp,
+                                 uint8_t u8Domain,
+                                 uint8_t u8Machine,
+                                 uint64_t u64StartNs,
+                                 uint64_t u64EndNs);
+
+/*!
+ *
+ * @brief       This function gets the latency histogram.
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ * @param[in] u16Domain Domain number (uint16). Value 0xFFFF reads port histogram.
+ * @param[in] u8Port Port number or sync machine of the domain.
+ * @param[in] eHist gPTP latency histogram.
+ * @param[out] prHist Pointer to the histogram copy.
+ */
+gptp_err_type_t GPTP_INTERNAL_GetHistogram(const gptp_def_data_t *prGptp,
+                                           uint16_t u16Domain,
+                                           uint8_t u8Port,
+                                           gptp_def_hist_id_t eHist,
+                                           gptp_def_histogram_t *prHist);
+
+/*!
+ * @brief Histograms clear
+ *
+ * This function clears all the gPTP latency histograms
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ */
+void GPTP_INTERNAL_ClearHistograms(const gptp_def_data_t *prGptp);
+
+/*!
+ * @brief Clock step notification
+ *
+ * This function restarts the latency measurements against the hardware
+ * timestamps after a time step of the local clock.
+ *
+ * @param[in,out] prGptp Pointer to global gPTP data structure.
+ * @param[in] s64StepNs Applied time step [ns].
+ */
+void GPTP_INTERNAL_ClockStepped(gptp_def_data_t *prGptp,
+                                int64_t s64StepNs);
+
 #endif /* GPTP_COUNTERS */
 
 #ifdef GPTP_USE_PRINTF
@@ -373,6 +444,79 @@ int32_t GPTP_INTERNAL_Float64ToInt32(float64_t f64Number);
  */
 uint64_t GPTP_INTERNAL_AbsInt64ToUint64(int64_t s64Number);
 
+/*!
+ * @brief The function finds domain index by the domain number.
+ *
+ * This function translates domain number on wire to the domain index using
+ * the lookup table built at the initialization.
+ *
+ * @param[in] cprGptp Pointer to global gPTP data structure.
+ * @param[in] u8DomainNumber Domain number on wire.
+ * @param[out] pu8DomainIndex Pointer to the domain index.
+ * @return    true in case the domain is found.
+ */
+bool GPTP_INTERNAL_DomainLookup(const gptp_def_data_t *cprGptp,
+                                uint8_t u8DomainNumber,
+                                uint8_t *pu8DomainIndex);
+
+/*!
+ * @brief The function finds sync machine of the domain by the gPTP port.
+ *
+ * This function finds sync machine index of the domain running on the gPTP
+ * port using the lookup table built at the initialization.
+ *
+ * @param[in] cprDomain Pointer to respective domain structure.
+ * @param[in] u8Port gPTP port.
+ * @param[out] pu8Machine Pointer to the sync machine index.
+ * @return    true in case the sync machine is found.
+ */
+bool GPTP_INTERNAL_SyncMachineLookup(const gptp_def_domain_t *cprDomain,
+                                     uint8_t u8Port,
+                                     uint8_t *pu8Machine);
+
+/*!
+ * @brief The function clears the clock servo of the domain.
+ *
+ * This function clears the PI Controller or the Kalman servo, the one
+ * selected for the domain.
+ *
+ * @param[in,out] prDomain Pointer to respective domain structure.
+ */
+void GPTP_INTERNAL_ServoClear(gptp_def_domain_t *prDomain);
+
+/*!
+ * @brief The function updates the clock servo of the domain.
+ *
+ * This function passes the error to the PI Controller or the Kalman servo,
+ * the one selected for the domain.
+ *
+ * @param[in,out] prDomain Pointer to respective domain structure.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @return    New correction value [PPB].
+ */
+int32_t GPTP_INTERNAL_ServoUpdate(gptp_def_domain_t *prDomain,
+                                  int8_t s8SyncInterval,
+                                  int32_t s32ErrorNs);
+
+/*!
+ * @brief The function keeps the clock servo of the domain not steering the clock.
+ *
+ * This function aligns the PI Controller or the Kalman servo, the one
+ * selected for the domain, to the correction applied by the servo of
+ * the domain steering the clock, so the switchover to this domain continues
+ * from the current frequency of the clock.
+ *
+ * @param[in,out] prDomain Pointer to respective domain structure.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @param[in] s32AppliedPpb Correction applied to the local clock [PPB].
+ */
+void GPTP_INTERNAL_ServoTrack(gptp_def_domain_t *prDomain,
+                              int8_t s8SyncInterval,
+                              int32_t s32ErrorNs,
+                              int32_t s32AppliedPpb);
+
 #endif /* GPTP_INTERNAL */
 /*******************************************************************************
  * EOF
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#ifndef GPTP_KF
+    #define GPTP_KF
+
+#include "gptp_def.h"
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief   This function checks the Kalman servo configuration.
+ *
+ * @param[in] prConfiguration Pointer to the Kalman servo configuration structure.
+ * @return true if the configuration can be used by GPTP_KF_Init.
+ */
+bool GPTP_KF_ConfigValid(const gptp_def_kf_conf_t *prConfiguration);
+
+/*!
+ *
+ * @brief   This function initializes the Kalman servo.
+ *
+ * @details This function initializes the Kalman servo and cleans all variables.
+ *
+ * @param[out] prKf Pointer to the Kalman servo context (one per domain).
+ * @param[in] prConfiguration Pointer to the Kalman servo configuration structure,
+ *            NULL leaves the servo unconfigured.
+ */
+void GPTP_KF_Init(gptp_def_kf_t *prKf,
+                  const gptp_def_kf_conf_t *prConfiguration);
+
+/*!
+ *
+ * @brief   This function cleans the state of the Kalman servo.
+ *
+ * @details The phase and frequency are estimated again from the next two
+ *          measurements.
+ *
+ * @param[in,out] prKf Pointer to the Kalman servo context.
+ */
+void GPTP_KF_Clear(gptp_def_kf_t *prKf);
+
+/*!
+ *
+ * @brief   This function calculates correction value as PPB to reach the setpoint.
+ *
+ * @details The phase and frequency error are estimated by a two-state Kalman
+ *          filter, the previous output is the known control input of the model.
+ *          The output cancels the estimated frequency error and removes the
+ *          configured part of the estimated phase error in one Sync interval.
+ *          The interface matches GPTP_PI_Update.
+ *
+ * @param[in,out] prKf Pointer to the Kalman servo context.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @return New correction value [PPB].
+ */
+int32_t GPTP_KF_Update(gptp_def_kf_t *prKf,
+                       int8_t s8SyncInterval,
+                       int32_t s32ErrorNs);
+
+/*!
+ *
+ * @brief   This function runs the Kalman servo on the correction applied by another servo.
+ *
+ * @details The applied correction is the control input of the model instead of
+ *          the own output, so the servo continues from the current frequency
+ *          of the clock once its output is applied.
+ *
+ * @param[in,out] prKf Pointer to the Kalman servo context.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @param[in] s32AppliedPpb Correction applied to the clock [PPB].
+ * @return Applied correction value [PPB].
+ */
+int32_t GPTP_KF_Track(gptp_def_kf_t *prKf,
+                      int8_t s8SyncInterval,
+                      int32_t s32ErrorNs,
+                      int32_t s32AppliedPpb);
+
+#endif /* GPTP_KF */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#ifndef GPTP_NRR
+    #define GPTP_NRR
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief   This function restarts the least-squares neighbor rate ratio estimator.
+ *
+ * @details All samples are dropped, the ratio is not valid until the window
+ *          collects enough samples again.
+ *
+ * @param[out] prLsq Pointer to the estimator context (one per Pdelay machine).
+ */
+void GPTP_NRR_Reset(gptp_def_nrr_lsq_t *prLsq);
+
+/*!
+ * @brief   This function adds one pair of Pdelay response timestamps to the estimator.
+ *
+ * @details The line (t3 - t4) = a + b * t4 is fitted over the sliding window,
+ *          the neighbor rate ratio is 1 + b. The sums of the fit are kept
+ *          centered around the window mean, so a sample is added and the
+ *          oldest one removed in constant time with exact integer arithmetic.
+ *          A sample far from the current line is not added. Several such
+ *          samples in a row restart the estimator, as the neighbor clock has
+ *          most likely stepped.
+ *
+ * @param[in,out] prLsq Pointer to the estimator context.
+ * @param[in] u8Window Count of samples in the window.
+ * @param[in] u64T4Ns Pdelay response receipt time (local clock) [ns].
+ * @param[in] u64T3Ns Pdelay response origin time (neighbor clock) [ns].
+ * @return GPTP_ERR_P_RRATIO_OUTLIER if the sample has been rejected,
+ *         GPTP_ERR_OK otherwise.
+ */
+gptp_err_type_t GPTP_NRR_Update(gptp_def_nrr_lsq_t *prLsq,
+                                uint8_t u8Window,
+                                uint64_t u64T4Ns,
+                                uint64_t u64T3Ns);
+
+#endif /* GPTP_NRR */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -38,6 +38,23 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                                gptp_def_pdelay_t *prPdelMachine,
                                const gptp_def_sm_call_type_t eCallType);
 
+/*!
+ * @brief NVM read completion function
+ *
+ * This function takes over the value delivered by the asynchronous NVM read. Until the
+ * Pdelay measurement is stabilized, the valid stored value replaces the default one the
+ * machine runs with. The stabilized measurement is compared with the stored value instead.
+ *
+ * @param[in] prGptp Pointer to global gPTP structure.
+ * @param[in] prPdelMachine Pointer to Pdelay state machine structure.
+ * @param[in] eNvmDataType NVM data type read.
+ * @param[in] f64Value Value read from the NVM, NaN if the read failed.
+ */
+void GPTP_PDELAY_NvmReadDone(const gptp_def_data_t *prGptp,
+                             gptp_def_pdelay_t *prPdelMachine,
+                             gptp_def_nvm_data_t eNvmDataType,
+                             float64_t f64Value);
+
 #endif /* GPTP_PDELAY */
 /*******************************************************************************
  * EOF
@@ -15,31 +15,6 @@
 
 #include "gptp_def.h"
 
-/*******************************************************************************
- * Definitions
- ******************************************************************************/
-
-/*!
- * @brief GPTP PI Controller context structore.
- */
-typedef struct
-{
-    /*! Current error value (input value of PI Controller) - int32_t */
-    int32_t s32error;
-    /*! Current calculated proportional value - int32_t */
-    int32_t s32proportional;
-    /*! Current calculated integrational value - int32_t */
-    int32_t s32integrational;
-    /*! Current calculated output value of PI Controller - int32_t */
-    int32_t s32calculated;
-    /*! Current calculated proportional gain of PI Controller - float64_t */
-    float64_t f64Kp;
-    /*! Current calculated integrational gain of PI Controller - float64_t */
-    float64_t f64Ki;
-    /*! PI Controller configuration structure - const pointer to struct */
-    const gptp_def_pi_controller_conf_t *prConfiguration;
-}gptp_pi_controller_t;
-
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -50,9 +25,11 @@ typedef struct
  *
  * @details This function initializes PI Controller and cleans all variables.
  *
+ * @param[out] prPi Pointer to the PI controller context (one per domain).
  * @param[in] prConfiguration Pointer to the PI controller configuration structure.
  */
-void GPTP_PI_Init(const gptp_def_pi_controller_conf_t *prConfiguration);
+void GPTP_PI_Init(gptp_def_pi_controller_t *prPi,
+                  const gptp_def_pi_controller_conf_t *prConfiguration);
 
 /*!
  *
@@ -60,8 +37,9 @@ void GPTP_PI_Init(const gptp_def_pi_controller_conf_t *prConfiguration);
  * 
  * @details This function cleans the integrational part of PI Controller, which also contains historical data.
  * 
+ * @param[in,out] prPi Pointer to the PI controller context.
  */
-void GPTP_PI_Clear(void);
+void GPTP_PI_Clear(gptp_def_pi_controller_t *prPi);
 
 /*!
  *
@@ -71,13 +49,32 @@ void GPTP_PI_Clear(void);
  *          then correction based on proportional and integral terms of controller is applied.
  *          
  * 
+ * @param[in,out] prPi Pointer to the PI controller context.
  * @param[in] s8SyncInterval Current Sync interval.
  * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
  * @return New correction value [PPB].
  */
-int32_t GPTP_PI_Update(int8_t s8SyncInterval,
+int32_t GPTP_PI_Update(gptp_def_pi_controller_t *prPi,
+                       int8_t s8SyncInterval,
                        int32_t s32ErrorNs);
 
+/*!
+ *
+ * @brief   This function aligns PI Controller to the correction applied by another servo.
+ *
+ * @details The integrational part takes over the applied correction, so the controller
+ *          continues from the current frequency of the clock once its output is applied.
+ *          The error is only stored, it is measured against the clock steered by the other servo.
+ *
+ * @param[in,out] prPi Pointer to the PI controller context.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @param[in] s32AppliedPpb Correction applied to the clock [PPB].
+ * @return Applied correction value [PPB].
+ */
+int32_t GPTP_PI_Track(gptp_def_pi_controller_t *prPi,
+                      int32_t s32ErrorNs,
+                      int32_t s32AppliedPpb);
+
 #endif /* GPTP_PI */
 /*******************************************************************************
  * EOF
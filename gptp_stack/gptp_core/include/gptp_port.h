@@ -94,7 +94,8 @@ void GPTP_PORT_ValueNvmWrite(gptp_def_pdelay_t *prPdelMachine,
  *
  * @brief   This function reads data from the NVM.
  *
- * @details This function reads data from the NVM using flash driver.
+ * @details This function reads data from the NVM using flash driver. With the
+ *          asynchronous read callback, the value is NaN until GPTP_NvmReadDone.
  *
  * @param[in] prPdelMachine Pointer to respective Pdelay machine.
  * @param[in] eNvmDataType NVM data type to access.
@@ -104,11 +105,39 @@ void GPTP_PORT_ValueNvmRead(gptp_def_pdelay_t *prPdelMachine,
                             gptp_def_nvm_data_t eNvmDataType,
                             const gptp_def_data_t *cprGptp);
 
+#ifdef GPTP_TX_ZERO_COPY
+/*!
+ *
+ * @brief   This function provides driver TX buffer for the PTP message.
+ *
+ * @details This function requests TX buffer from the ENET driver, so the frame
+ *          can be built directly in the driver memory. The returned pointer
+ *          points to the frame start (Ethernet header), the payload starts
+ *          GPTP_DEF_ETH_II_LEN bytes later in the driver provided buffer.
+ *
+ * @param[in] u8Port gPTP port on which the PTP message is to be transmitted.
+ * @param[in] u8FramePrio Eth frame priority.
+ * @param[in] u16FrameLength Requested frame length including Ethernet header.
+ * @param[out] ppu8Frame Pointer to the frame start placeholder.
+ * @param[out] pu32BufferIndex Pointer to the driver buffer index placeholder.
+ *
+ * @return GPTP_ERR_OK in case the buffer is provided.
+ */
+gptp_err_type_t GPTP_PORT_MsgBufferGet(uint8_t u8Port,
+                                       uint8_t u8FramePrio,
+                                       uint16_t u16FrameLength,
+                                       uint8_t **ppu8Frame,
+                                       uint32_t *pu32BufferIndex);
+
+#endif /* GPTP_TX_ZERO_COPY */
 /*!
  *
  * @brief   This function sends PTP message.
  *
- * @details This function sends PTP message using the ENET driver.
+ * @details This function sends PTP message using the ENET driver. With
+ *          GPTP_TX_ZERO_COPY defined, the frame is already built in the buffer
+ *          provided by GPTP_PORT_MsgBufferGet and it is only handed over
+ *          for transmission.
  *
  * @param[in] u8Port gPTP port on which the PTP message is transmitted.
  * @param[in] u8FramePrio Eth frame priority.
@@ -192,7 +221,8 @@ gptp_err_type_t GPTP_PORT_UpdateLocalClock(gptp_def_data_t *prGptp,
  * @brief      This function stabilizes the local clock.
  *
  * @details    This function stabilizes the local clock running. The stabilized clock runs at the
- *             current rate ratio. It prevents clock from drifting, in case of Grand Master loss.
+ *             frequency extrapolated by the holdover model. It prevents clock from drifting, in case
+ *             of Grand Master loss. The stack calls it again while the holdover lasts.
  *
  * @param[in]  cpf64RateRatio Rate Ratio.
  *
@@ -69,6 +69,15 @@ void GPTP_TIMER_TimerPeriodic(gptp_def_data_t *prGptp);
  */
 void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp);
 
+/*!
+ * @brief The function arms internal timer.
+ *
+ * @param[in] Pointer to the timer entry.
+ * @param[in] Wake-up time (freerunning timebase).
+ */
+void GPTP_TIMER_TimerArm(gptp_def_timer_t *prTimer,
+                         const uint64_t u64WakeNs);
+
 #endif /* GPTP_TIMER */
 /*******************************************************************************
  * EOF
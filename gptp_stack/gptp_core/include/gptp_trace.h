@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#ifndef GPTP_TRACE
+    #define GPTP_TRACE
+
+#include "gptp_def.h"
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#ifdef GPTP_TRACE_CAPTURE
+
+/*!
+ * @brief   This function starts the trace capture.
+ *
+ * @details Writes the stream header and the start record. Only the events of
+ *          the traced instance are recorded. For a bit-exact replay, start
+ *          the capture before the initialization of the instance.
+ *
+ * @param[in] cprGptp Pointer to the traced stack instance, NULL for the default instance.
+ * @param[in] pfWrite Callback writing the trace stream, NULL stops the capture.
+ */
+void GPTP_TRACE_Start(const gptp_def_data_t *cprGptp,
+                      gptp_trace_write_callback_t pfWrite);
+
+/*!
+ * @brief   This function stops the trace capture.
+ */
+void GPTP_TRACE_Stop(void);
+
+/*!
+ * @brief   This function records the received gPTP frame.
+ *
+ * @details Called by the port layer right before the frame is passed to
+ *          the stack.
+ *
+ * @param[in] cprGptp Pointer to the receiving stack instance.
+ * @param[in] cprRxData Pointer to the received data as passed to the stack.
+ * @param[in] u16Length Length of the received gPTP data.
+ */
+void GPTP_TRACE_Rx(const gptp_def_data_t *cprGptp,
+                   const gptp_def_rx_data_t *cprRxData,
+                   uint16_t u16Length);
+
+/*!
+ * @brief   This function records the egress timestamp.
+ *
+ * @details Called by the port layer right before the timestamp is passed to
+ *          the stack. The message type, the domain number and the sequence ID
+ *          of the frame are recorded along with the buffer index.
+ *
+ * @param[in] cprGptp Pointer to the transmitting stack instance.
+ * @param[in] u8Port gPTP port transmitted the frame.
+ * @param[in] u32BufferIndex Index of the frame buffer.
+ * @param[in] u32TsSeconds Egress time stamp - seconds.
+ * @param[in] u32TsNanoseconds Egress time stamp - nano seconds.
+ */
+void GPTP_TRACE_Tx(const gptp_def_data_t *cprGptp,
+                   uint8_t u8Port,
+                   uint32_t u32BufferIndex,
+                   uint32_t u32TsSeconds,
+                   uint32_t u32TsNanoseconds);
+
+/*!
+ * @brief   This function records the call of the periodic function.
+ *
+ * @param[in] cprGptp Pointer to the stack instance.
+ */
+void GPTP_TRACE_Tick(const gptp_def_data_t *cprGptp);
+
+#endif /* GPTP_TRACE_CAPTURE */
+
+/*!
+ * @brief   This function returns the buffer index of the frame transmitted by the instance.
+ *
+ * @details Finds the frame of the recorded egress timestamp among the frames
+ *          transmitted by the instance by its port, message type, domain number
+ *          and sequence ID.
+ *
+ * @param[in] cprGptp Pointer to the stack instance.
+ * @param[in] cprRec Pointer to the egress timestamp record.
+ * @return Buffer index of the frame, GPTP_DEF_BUFF_INDEX_CLOSED if the instance
+ *         did not transmit the frame.
+ */
+uint32_t GPTP_TRACE_TxBufferIndex(const gptp_def_data_t *cprGptp,
+                                  const gptp_def_trace_rec_t *cprRec);
+
+/*!
+ * @brief   This function checks the trace stream header.
+ *
+ * @param[in] cpu8Trace Pointer to the trace stream.
+ * @param[in] u32Length Length of the trace stream.
+ * @return Error status.
+ * @retval GPTP_ERR_OK The stream header is valid, the records start at GPTP_DEF_TRACE_HDR_LEN.
+ * @retval GPTP_ERR_V_NULL_PTR Invalid input arguments.
+ * @retval GPTP_ERR_M_MESSAGE_ID_INVALID Unknown stream format or version.
+ */
+gptp_err_type_t GPTP_TRACE_HeaderCheck(const uint8_t *cpu8Trace,
+                                       uint32_t u32Length);
+
+/*!
+ * @brief   This function decodes the next trace record.
+ *
+ * @details Records of unknown types are skipped. The decoded record points
+ *          into the trace stream. The stream ends when the offset reaches
+ *          its length.
+ *
+ * @param[in] cpu8Trace Pointer to the trace stream.
+ * @param[in] u32Length Length of the trace stream.
+ * @param[in,out] pu32Offset Offset of the record, moved to the next record.
+ * @param[out] prRec Pointer to the decoded record.
+ * @return Error status.
+ * @retval GPTP_ERR_OK The record was decoded.
+ * @retval GPTP_ERR_V_NULL_PTR Invalid input arguments.
+ * @retval GPTP_ERR_M_MESSAGE_ID_INVALID Truncated or malformed record, or the end of the stream.
+ */
+gptp_err_type_t GPTP_TRACE_Decode(const uint8_t *cpu8Trace,
+                                  uint32_t u32Length,
+                                  uint32_t *pu32Offset,
+                                  gptp_def_trace_rec_t *prRec);
+
+#endif /* GPTP_TRACE */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -26,6 +26,11 @@
 #include "gptp_signaling.h"
 #include "gptp_internal.h"
 #include "gptp_pi.h"
+#include "gptp_kf.h"
+#include "gptp_fxp.h"
+#include "gptp_filt.h"
+#include "gptp_hold.h"
+#include "gptp_trace.h"
 
 /*******************************************************************************
  * Variables
@@ -41,11 +46,26 @@ static gptp_def_data_t          rGptpDataStruct =
     .rProductDetails.au8ProdDesc = GPTP_PORT_PRODUCT_DESCRIPTION
 };
 
+/* Product details of the instances passed to GPTP_GptpInitInst */
+static const gptp_def_prod_detail_t crProductDetails =
+{
+    .cpu8ManId = cau8ManId,
+    .cpu8ProdRev = cau8ProductRev,
+    .au8ProdDesc = GPTP_PORT_PRODUCT_DESCRIPTION
+};
+
+/* Instance processed by the API call in progress, the default instance otherwise */
+static gptp_def_data_t          *prGptpBound = &rGptpDataStruct;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 static uint8_t GPTP_FrameIdReset(uint8_t *FrameId,
                                  uint8_t u8Value);
+#ifdef GPTP_TX_ZERO_COPY
+static uint16_t GPTP_TxBufferLengthGet(gptp_def_msg_type_t eMsgId);
+#endif /* GPTP_TX_ZERO_COPY */
+static gptp_def_data_t *GPTP_InstanceBind(gptp_def_data_t *prGptp);
 
 /*******************************************************************************
  * Code
@@ -74,6 +94,84 @@ static uint8_t GPTP_FrameIdReset(uint8_t *FrameId,
     return u8TempId;
 }
 
+#ifdef GPTP_TX_ZERO_COPY
+/*!
+ *
+ * @brief   This function returns the TX buffer length for the message type.
+ *
+ * @details The returned length covers the whole frame including Ethernet
+ *          header and optional VLAN tag, so it is the worst case length
+ *          the frame builder may write into the driver buffer.
+ *
+ * @param[in] eMsgId Type of the transmitted message.
+ * @returns   Frame buffer length in bytes, 0 for the unsupported message type.
+ *
+ */
+static uint16_t GPTP_TxBufferLengthGet(gptp_def_msg_type_t eMsgId)
+{
+    uint16_t u16Length;
+
+    switch (eMsgId)
+    {
+        case GPTP_DEF_MSG_TYPE_SYNC:
+            u16Length = GPTP_DEF_TX_BUF_LEN_SYNC;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
+            u16Length = GPTP_DEF_TX_BUF_LEN_FUP;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_PD_REQ:
+            u16Length = GPTP_DEF_TX_BUF_LEN_PD_RQ;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_PD_RESP:
+            u16Length = GPTP_DEF_TX_BUF_LEN_PD_RSP;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
+            u16Length = GPTP_DEF_TX_BUF_LEN_PD_FUP;
+        break;
+
+        case GPTP_DEF_MSG_TYPE_SIGNALING:
+            u16Length = GPTP_DEF_TX_BUF_LEN_SIGNL;
+        break;
+
+        default:
+            u16Length = 0u;
+        break;
+    }
+
+    return u16Length;
+}
+#endif /* GPTP_TX_ZERO_COPY */
+
+/*!
+ *
+ * @brief   This function binds the stack instance to the API call in progress.
+ *
+ * @details The bound instance is used by the functions without the instance
+ *          parameter and is provided to the port layer by GPTP_GetMainStrPtr.
+ *          The caller restores the previously bound instance at its return.
+ *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @returns   Pointer to the bound instance.
+ *
+ */
+static gptp_def_data_t *GPTP_InstanceBind(gptp_def_data_t *prGptp)
+{
+    if (NULL == prGptp)
+    {
+        prGptpBound = &rGptpDataStruct;
+    }
+    else
+    {
+        prGptpBound = prGptp;
+    }
+
+    return prGptpBound;
+}
+
 /*!
  *
  * @brief      This function sends the gPTP message
@@ -97,125 +195,154 @@ void GPTP_MsgTransmit(gptp_def_tx_data_t *prTxData,
                       const uint8_t u8MachineNum,
                       const uint8_t u8DomainNum)
 {
+    gptp_def_data_t      *prGptp;
     uint8_t              u8TempFrameId;
     gptp_err_type_t      eErr;
 
+    prGptp = prGptpBound;
+
     switch (prTxData->eMsgId)
     {
         case GPTP_DEF_MSG_TYPE_SYNC:
-            if (GPTP_DEF_FID_SYNC_MAX > rGptpDataStruct.rPerDeviceParams.u8NextFrameIdSync)
+            if (GPTP_DEF_FID_SYNC_MAX > prGptp->rPerDeviceParams.u8NextFrameIdSync)
             {
-                u8TempFrameId = rGptpDataStruct.rPerDeviceParams.u8NextFrameIdSync;
-                rGptpDataStruct.rPerDeviceParams.u8NextFrameIdSync++;
+                u8TempFrameId = prGptp->rPerDeviceParams.u8NextFrameIdSync;
+                prGptp->rPerDeviceParams.u8NextFrameIdSync++;
             }
 
             else
             {
-                u8TempFrameId = GPTP_FrameIdReset(&rGptpDataStruct.rPerDeviceParams.u8NextFrameIdSync, GPTP_DEF_FID_SYNC_START);
+                u8TempFrameId = GPTP_FrameIdReset(&prGptp->rPerDeviceParams.u8NextFrameIdSync, GPTP_DEF_FID_SYNC_START);
             }
 
             /* Store Frame frame information to the frame ID table, to the NextFrameId index  */
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = u8Port;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = prTxData->eMsgId;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = prTxData->u16SequenceId;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = u8MachineNum;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = u8DomainNum;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = prTxData->bSyncActingGm;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = u8Port;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = prTxData->eMsgId;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = prTxData->u16SequenceId;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = u8MachineNum;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = u8DomainNum;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = prTxData->bSyncActingGm;
         break;
 
         case GPTP_DEF_MSG_TYPE_PD_REQ:
-            if ((GPTP_DEF_FID_PDREQ_START <= rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdReq) && \
-               (GPTP_DEF_FID_PDREQ_MAX > rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdReq))
+            if ((GPTP_DEF_FID_PDREQ_START <= prGptp->rPerDeviceParams.u8NextFrameIdPdReq) && \
+               (GPTP_DEF_FID_PDREQ_MAX > prGptp->rPerDeviceParams.u8NextFrameIdPdReq))
             {
-                u8TempFrameId = rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdReq;
-                rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdReq++;
+                u8TempFrameId = prGptp->rPerDeviceParams.u8NextFrameIdPdReq;
+                prGptp->rPerDeviceParams.u8NextFrameIdPdReq++;
             }
 
             else
             {
-                u8TempFrameId = GPTP_FrameIdReset(&rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdReq, GPTP_DEF_FID_PDREQ_START);
+                u8TempFrameId = GPTP_FrameIdReset(&prGptp->rPerDeviceParams.u8NextFrameIdPdReq, GPTP_DEF_FID_PDREQ_START);
             }
 
             /* Store Frame frame information to the frame ID table, to the NextFrameId index  */
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = u8Port;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = prTxData->eMsgId;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = prTxData->u16SequenceId;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = u8MachineNum;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = u8DomainNum;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = false;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = u8Port;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = prTxData->eMsgId;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = prTxData->u16SequenceId;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = u8MachineNum;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = u8DomainNum;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = false;
         break;
 
         case GPTP_DEF_MSG_TYPE_PD_RESP:
-            u8TempFrameId = rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp;
-            if ((GPTP_DEF_FID_PDRESP_START <= rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp) && \
-               (GPTP_DEF_FID_PDRESP_MAX > rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp))
+            u8TempFrameId = prGptp->rPerDeviceParams.u8NextFrameIdPdResp;
+            if ((GPTP_DEF_FID_PDRESP_START <= prGptp->rPerDeviceParams.u8NextFrameIdPdResp) && \
+               (GPTP_DEF_FID_PDRESP_MAX > prGptp->rPerDeviceParams.u8NextFrameIdPdResp))
             {
-                u8TempFrameId = rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp;
-                rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp++;
+                u8TempFrameId = prGptp->rPerDeviceParams.u8NextFrameIdPdResp;
+                prGptp->rPerDeviceParams.u8NextFrameIdPdResp++;
             }
 
             else
             {
-                u8TempFrameId = GPTP_FrameIdReset(&rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp, GPTP_DEF_FID_PDRESP_START);
+                u8TempFrameId = GPTP_FrameIdReset(&prGptp->rPerDeviceParams.u8NextFrameIdPdResp, GPTP_DEF_FID_PDRESP_START);
             }
 
             /* Store Frame frame information to the frame ID table, to the NextFrameId index  */
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = u8Port;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = prTxData->eMsgId;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = prTxData->u16SequenceId;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = u8MachineNum;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = u8DomainNum;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = false;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = u8Port;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = prTxData->eMsgId;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = prTxData->u16SequenceId;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = u8MachineNum;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = u8DomainNum;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = false;
         break;
 
         default:
             u8TempFrameId = 255u;
             /* Store Frame frame information to the frame ID table, to the NextFrameId index  */
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = 0u;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = 65535u;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = 0u;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = 0u;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = false;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8Port = 0u;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u16SequenceId = 65535u;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8MachineId = 0u;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u8DomainId = 0u;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].bSyncActingGm = false;
         break;
     }
 
+#ifdef GPTP_TX_ZERO_COPY
+    /* Frame is serialized directly into the driver TX buffer */
+    prTxData->pau8TxBuffPtr = NULL;
+    eErr = GPTP_PORT_MsgBufferGet(u8Port, prGptp->rPerDeviceParams.u8EthFramePrio,
+                                  GPTP_TxBufferLengthGet(prTxData->eMsgId),
+                                  &prTxData->pau8TxBuffPtr, &prTxData->u32BufferIndex);
+    if (GPTP_ERR_OK != eErr)
+    {
+        prTxData->pau8TxBuffPtr = NULL;
+    }
+#endif /* GPTP_TX_ZERO_COPY */
+
     if (NULL != prTxData->pau8TxBuffPtr)
     {
-        GPTP_FRAME_BuildTx(&rGptpDataStruct, prTxData, u8DomainNum, u8Port);
-        eErr = GPTP_PORT_MsgSend(u8Port, rGptpDataStruct.rPerDeviceParams.u8EthFramePrio, prTxData, u8TempFrameId);
+        GPTP_FRAME_BuildTx(prGptp, prTxData, u8DomainNum, u8Port);
+#ifdef GPTP_COUNTERS
+        /* Handover to the driver starts the egress latency of the timestamped messages,
+           in the corrected time as the egress timestamp */
+        prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u64EnqueueNs = 0u;
+        if (255u != u8TempFrameId)
+        {
+            prGptp->rPerDeviceParams.arFrameIdTable[u8TempFrameId].u64EnqueueNs = GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_CORRECTED));
+        }
+#endif /* GPTP_COUNTERS */
+        eErr = GPTP_PORT_MsgSend(u8Port, prGptp->rPerDeviceParams.u8EthFramePrio, prTxData, u8TempFrameId);
         if (GPTP_ERR_OK != eErr)
         {
             GPTP_ERR_Register(u8Port, u8DomainNum, eErr, prTxData->u16SequenceId);
         }
 
+#ifdef GPTP_TX_ZERO_COPY
+        /* The buffer is owned by the driver since now */
+        prTxData->pau8TxBuffPtr = NULL;
+#endif /* GPTP_TX_ZERO_COPY */
+
 #ifdef GPTP_COUNTERS
         switch (prTxData->eMsgId)
         {
             case GPTP_DEF_MSG_TYPE_SYNC:
-                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, u8Port, ieee8021AsPortStatTxSyncCount);
-                GPTP_INTERNAL_IncrementDomainStats(&rGptpDataStruct, u8DomainNum, u8MachineNum, ieee8021AsPortStatTxSyncCount);
+                GPTP_INTERNAL_IncrementPortStats(prGptp, u8Port, ieee8021AsPortStatTxSyncCount);
+                GPTP_INTERNAL_IncrementDomainStats(prGptp, u8DomainNum, u8MachineNum, ieee8021AsPortStatTxSyncCount);
             break;
 
             case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
-                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, u8Port, ieee8021AsPortStatTxFollowUpCount);
-                GPTP_INTERNAL_IncrementDomainStats(&rGptpDataStruct, u8DomainNum, u8MachineNum, ieee8021AsPortStatTxFollowUpCount);
+                GPTP_INTERNAL_IncrementPortStats(prGptp, u8Port, ieee8021AsPortStatTxFollowUpCount);
+                GPTP_INTERNAL_IncrementDomainStats(prGptp, u8DomainNum, u8MachineNum, ieee8021AsPortStatTxFollowUpCount);
             break;
 
             case GPTP_DEF_MSG_TYPE_PD_REQ:
-                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, u8Port, ieee8021AsPortStatTxPdelayRequest);
+                GPTP_INTERNAL_IncrementPortStats(prGptp, u8Port, ieee8021AsPortStatTxPdelayRequest);
             break;
 
             case GPTP_DEF_MSG_TYPE_PD_RESP:
-                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, u8Port, ieee8021AsPortStatTxPdelayResponse);
+                GPTP_INTERNAL_IncrementPortStats(prGptp, u8Port, ieee8021AsPortStatTxPdelayResponse);
             break;
 
             case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
-                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, u8Port, ieee8021AsPortStatTxPdelayResponseFollowUp);
+                GPTP_INTERNAL_IncrementPortStats(prGptp, u8Port, ieee8021AsPortStatTxPdelayResponseFollowUp);
             break;
 
             case GPTP_DEF_MSG_TYPE_ANNOUNCE:
-                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, u8Port, ieee8021AsPortStatTxAnnounce);
+                GPTP_INTERNAL_IncrementPortStats(prGptp, u8Port, ieee8021AsPortStatTxAnnounce);
             break;
 
             default:
@@ -239,6 +366,7 @@ void GPTP_MsgTransmit(gptp_def_tx_data_t *prTxData,
  *             to initialize the internal gPTP structures. The function checks the current link status.
  *             For all "up" links which are used for gPTP, it starts the gPTP software timer.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in]  prInitParams Pointer to structure containing initial parameters
  *
  * @return     gPTP error code.
@@ -251,12 +379,14 @@ void GPTP_MsgTransmit(gptp_def_tx_data_t *prTxData,
  * @ requirements 120454
  * @ requirements 341436
  */
-gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
+gptp_err_type_t GPTP_GptpInitInst(gptp_def_data_t *prGptp,
+                                  const gptp_def_init_params_t *prInitParams)
 {
+    gptp_def_data_t                         *prGptpPrev;
     gptp_err_type_t                         eError;
     gptp_err_type_t                         eErrorTmp;
-    static bool                             bLinkStat;
-    static uint64_t                         u64PortMac;
+    bool                                    bLinkStat;
+    uint64_t                                u64PortMac;
     uint8_t                                 u8Port;
     uint8_t                                 u8NumberOfPorts;
     uint8_t                                 u8Machine;
@@ -274,41 +404,71 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
     const gptp_def_init_params_domain_t     *prDomainInit;
     const gptp_def_init_params_pdel_t       *prPdelayInit;
     const gptp_def_init_params_sync_t       *prSyncInit;
+    const gptp_def_pi_controller_conf_t     *prPiConfig;
+    const gptp_def_kf_conf_t                *prKfConfig;
     uint8_t                                 au8MacAddr[6];
 
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
     /* Error initial value */
     eError = GPTP_ERR_OK;
 
+    /* Instances other than the default one are provided with product details at the first initialization */
+    if (NULL == prGptp->rProductDetails.cpu8ManId)
+    {
+        prGptp->rProductDetails = crProductDetails;
+    }
+    prGptp->pvPortCtx = prInitParams->pvPortCtx;
+
     /* Initialize error notification callback function before the Error management is initialized */
-    rGptpDataStruct.rPtpStackCallBacks.pfErrNotify = prInitParams->rPtpStackCallBacks.pfErrNotify;
+    prGptp->rPtpStackCallBacks.pfErrNotify = prInitParams->rPtpStackCallBacks.pfErrNotify;
 
     /* Init Err management and error log clear */
-    GPTP_ERR_MgmtInit(&rGptpDataStruct);
+    GPTP_ERR_MgmtInit();
     GPTP_ERR_LogClear();
 
     /* Initialize Integral windup limit, there is no need to check value (0 avoids windup functionality) */
-    rGptpDataStruct.rPerDeviceParams.rPIControllerConfig.u32IntegralWindupLimit = prInitParams->rPIControllerConfig.u32IntegralWindupLimit;
+    prGptp->rPerDeviceParams.rPIControllerConfig.u32IntegralWindupLimit = prInitParams->rPIControllerConfig.u32IntegralWindupLimit;
 
     /* Initialize damping ratio for PI Controller, there is no need to check value (0 can ignore P term calculation) */
-    rGptpDataStruct.rPerDeviceParams.rPIControllerConfig.f64DampingRatio = prInitParams->rPIControllerConfig.f64DampingRatio;
+    prGptp->rPerDeviceParams.rPIControllerConfig.f64DampingRatio = prInitParams->rPIControllerConfig.f64DampingRatio;
 
     /* Check natural frequency ratio, because dividing by 0 occur exception */
     if ((0.0 > prInitParams->rPIControllerConfig.f64NatFreqRatio) || (0.0 < prInitParams->rPIControllerConfig.f64NatFreqRatio))
     {
         /* Initialize natural frequency ratio for PI Controller */
-        rGptpDataStruct.rPerDeviceParams.rPIControllerConfig.f64NatFreqRatio = prInitParams->rPIControllerConfig.f64NatFreqRatio;
+        prGptp->rPerDeviceParams.rPIControllerConfig.f64NatFreqRatio = prInitParams->rPIControllerConfig.f64NatFreqRatio;
 
-        /* Initialize PI Controller */
-        GPTP_PI_Init(&rGptpDataStruct.rPerDeviceParams.rPIControllerConfig);
+        /* PI Controllers of all the domains share the configuration */
+        prPiConfig = &prGptp->rPerDeviceParams.rPIControllerConfig;
     }
     else
     {
+        /* PI Controllers stay unconfigured */
+        prPiConfig = NULL;
+
         /* Register error -  missing configuration */
         GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_PI_INCORRECT_CFG, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
+    /* Kalman servo configuration is optional, domains selecting it without one use the PI Controller */
+    prGptp->rPerDeviceParams.rKalmanConfig = prInitParams->rKalmanConfig;
+    prKfConfig = NULL;
+    if (true == GPTP_KF_ConfigValid(&prGptp->rPerDeviceParams.rKalmanConfig))
+    {
+        prKfConfig = &prGptp->rPerDeviceParams.rKalmanConfig;
+    }
+
+    /* Holdover frequency model starts with an empty history */
+    GPTP_HOLD_Init(&prGptp->rPerDeviceParams.rHoldover, prInitParams->u8HoldoverSampleS, prInitParams->u32HoldoverSpecNs);
+
+    /* Reset sync lock */
+    GPTP_INTERNAL_ResetSyncLock(prGptp);
+
     /* Initialize PI Controler maximum threshold */
-    rGptpDataStruct.rPerDeviceParams.u64PIControllerMaxThreshold = prInitParams->u64PIControllerMaxThreshold;
+    prGptp->rPerDeviceParams.u64PIControllerMaxThreshold = prInitParams->u64PIControllerMaxThreshold;
     
     /* Register multicast MAC */
     au8MacAddr[0] = (uint8_t)((uint64_t)GPTP_DEF_ETH_PTP_MAC_MULTICAST >> 40u) & 255u;
@@ -328,10 +488,17 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NO_PORT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
+    /* Sync machine lookup table covers limited count of ports */
+    if ((uint8_t)GPTP_DEF_PORTS_MAX < prInitParams->u8GptpPortsCount)
+    {
+        eError = GPTP_ERR_I_TOO_MANY_PORTS;
+        GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_TOO_MANY_PORTS, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+    }
+
     if (GPTP_ERR_OK == eError)
     {
-        rGptpDataStruct.rPerDeviceParams.u8PortsCount = prInitParams->u8GptpPortsCount;
-        u8NumberOfPorts = rGptpDataStruct.rPerDeviceParams.u8PortsCount;
+        prGptp->rPerDeviceParams.u8PortsCount = prInitParams->u8GptpPortsCount;
+        u8NumberOfPorts = prGptp->rPerDeviceParams.u8PortsCount;
 
         if (NULL != prInitParams->pcrPortMapTable)
         {
@@ -349,7 +516,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 #ifdef GPTP_COUNTERS
     if (NULL != prInitParams->prCntrsPort)
     {
-        rGptpDataStruct.prCntrsPort = prInitParams->prCntrsPort;
+        prGptp->prCntrsPort = prInitParams->prCntrsPort;
     }
     else
     {
@@ -361,7 +528,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 #ifdef GPTP_TIME_VALIDATION
     if (NULL != prInitParams->rPtpStackCallBacks.pfTimeBaseProvideNotifSlave)
     {
-        rGptpDataStruct.rPtpStackCallBacks.pfTimeBaseProvideNotifSlave = prInitParams->rPtpStackCallBacks.pfTimeBaseProvideNotifSlave;
+        prGptp->rPtpStackCallBacks.pfTimeBaseProvideNotifSlave = prInitParams->rPtpStackCallBacks.pfTimeBaseProvideNotifSlave;
     }
     else
     {
@@ -371,7 +538,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 
     if (NULL != prInitParams->rPtpStackCallBacks.pfTimeBaseProvideNotifMaster)
     {
-        rGptpDataStruct.rPtpStackCallBacks.pfTimeBaseProvideNotifMaster = prInitParams->rPtpStackCallBacks.pfTimeBaseProvideNotifMaster;
+        prGptp->rPtpStackCallBacks.pfTimeBaseProvideNotifMaster = prInitParams->rPtpStackCallBacks.pfTimeBaseProvideNotifMaster;
     }
     else
     {
@@ -381,7 +548,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 
     if (NULL != prInitParams->rPtpStackCallBacks.pfSetPdelayInitiatorData)
     {
-        rGptpDataStruct.rPtpStackCallBacks.pfSetPdelayInitiatorData = prInitParams->rPtpStackCallBacks.pfSetPdelayInitiatorData;
+        prGptp->rPtpStackCallBacks.pfSetPdelayInitiatorData = prInitParams->rPtpStackCallBacks.pfSetPdelayInitiatorData;
     }
     else
     {
@@ -391,7 +558,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 
     if (NULL != prInitParams->rPtpStackCallBacks.pfSetPdelayResponderData)
     {
-        rGptpDataStruct.rPtpStackCallBacks.pfSetPdelayResponderData = prInitParams->rPtpStackCallBacks.pfSetPdelayResponderData;
+        prGptp->rPtpStackCallBacks.pfSetPdelayResponderData = prInitParams->rPtpStackCallBacks.pfSetPdelayResponderData;
     }
     else
     {
@@ -402,9 +569,9 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 
     if ((NULL != prInitParams->paPort) && (NULL != prInitParams->paDomain) && (NULL != prInitParams->paPdelay))
     {
-        rGptpDataStruct.prPerPortParams = prInitParams->paPort;
-        rGptpDataStruct.prPerDomainParams = prInitParams->paDomain;
-        rGptpDataStruct.prPdelayMachines = prInitParams->paPdelay;
+        prGptp->prPerPortParams = prInitParams->paPort;
+        prGptp->prPerDomainParams = prInitParams->paDomain;
+        prGptp->prPdelayMachines = prInitParams->paPdelay;
     }
     else
     {
@@ -433,7 +600,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         {
             if (NULL != prInitParams->pcrDomainsSyncsParam[u8Domain].prSync)
             {
-                rGptpDataStruct.prPerDomainParams[u8Domain].prSyncMachines = prInitParams->pcrDomainsSyncsParam[u8Domain].prSync;
+                prGptp->prPerDomainParams[u8Domain].prSyncMachines = prInitParams->pcrDomainsSyncsParam[u8Domain].prSync;
             }
             else
             {
@@ -489,58 +656,79 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
     }
 
     /* Per devide params initilize */
-    rGptpDataStruct.rPerDeviceParams.u8EthFramePrio = prInitParams->u8EthFramePrio;
-    rGptpDataStruct.rPerDeviceParams.f64PdelAvgWeight = prInitParams->f64PdelAvgWeight;
-    rGptpDataStruct.rPerDeviceParams.f64RratioAvgWeight = prInitParams->f64RratioAvgWeight;
-    rGptpDataStruct.rPerDeviceParams.f64RratioMaxDev = prInitParams->f64RratioMaxDev;
-    rGptpDataStruct.rPerDeviceParams.f64PdelayNvmWriteThr = prInitParams->f64PdelayNvmWriteThr;
-    rGptpDataStruct.rPerDeviceParams.f64RratioNvmWriteThr = prInitParams->f64RratioNvmWriteThr;
-    rGptpDataStruct.rPerDeviceParams.u8NextFrameIdSync = 0u;
-    rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdReq = 100u;
-    rGptpDataStruct.rPerDeviceParams.u8NextFrameIdPdResp = 175u;
-    rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains = prInitParams->u8GptpDomainsCount;
-    rGptpDataStruct.rPerDeviceParams.u8NumberOfPdelayMachines = rGptpDataStruct.rPerDeviceParams.u8PortsCount;
-    rGptpDataStruct.rPerDeviceParams.bSdoIdCompatibilityMode = prInitParams->bSdoIdCompatibilityMode;
-    rGptpDataStruct.rPerDeviceParams.bVlanEnabled = prInitParams->bVlanEnabled;
-    rGptpDataStruct.rPerDeviceParams.u16VlanTci = prInitParams->u16VlanTci;
-    rGptpDataStruct.rPerDeviceParams.bSignalingEnabled = prInitParams->bSignalingEnabled;
-    rGptpDataStruct.rPerDeviceParams.rEstimGmOffset.s64TimeStampS = 0;
-    rGptpDataStruct.rPerDeviceParams.rEstimGmOffset.s32TimeStampNs = 0;
-    rGptpDataStruct.rPerDeviceParams.f64CorrClockRateRatio = 1.0;
-    rGptpDataStruct.rPerDeviceParams.bEverUpdated = false;
-    rGptpDataStruct.rPerDeviceParams.bEstimGmOffsetCalculated = false;
-    rGptpDataStruct.rPerDeviceParams.rSynLockParam = prInitParams->rSynLockParam;
-    rGptpDataStruct.rPtpStackCallBacks.pfDomSelectionCB = prInitParams->rPtpStackCallBacks.pfDomSelectionCB;
-    rGptpDataStruct.rPtpStackCallBacks.pfNvmWriteCB = prInitParams->rPtpStackCallBacks.pfNvmWriteCB;
-    rGptpDataStruct.rPtpStackCallBacks.pfNvmReadCB = prInitParams->rPtpStackCallBacks.pfNvmReadCB;
-    rGptpDataStruct.rPtpStackCallBacks.pfErrNotify = prInitParams->rPtpStackCallBacks.pfErrNotify;
-    rGptpDataStruct.rPtpStackCallBacks.pfSynNotify = prInitParams->rPtpStackCallBacks.pfSynNotify;
+    prGptp->rPerDeviceParams.u8EthFramePrio = prInitParams->u8EthFramePrio;
+    prGptp->rPerDeviceParams.f64PdelAvgWeight = prInitParams->f64PdelAvgWeight;
+    prGptp->rPerDeviceParams.f64RratioAvgWeight = prInitParams->f64RratioAvgWeight;
+#ifdef GPTP_FIXED_POINT
+    prGptp->rPerDeviceParams.u32PdelAvgWeightQ16 = GPTP_FXP_Float64ToWeight(prInitParams->f64PdelAvgWeight);
+    prGptp->rPerDeviceParams.u32RratioAvgWeightQ16 = GPTP_FXP_Float64ToWeight(prInitParams->f64RratioAvgWeight);
+#endif /* GPTP_FIXED_POINT */
+    prGptp->rPerDeviceParams.eRratioEstimator = prInitParams->eRratioEstimator;
+    prGptp->rPerDeviceParams.u8RratioLsqWindow = prInitParams->u8RratioLsqWindow;
+    if ((0u == prInitParams->u8RratioLsqWindow) || (GPTP_DEF_RRATIO_LSQ_WIN_MAX < prInitParams->u8RratioLsqWindow))
+    {
+        prGptp->rPerDeviceParams.u8RratioLsqWindow = GPTP_DEF_RRATIO_LSQ_WIN_MAX;
+    }
+    prGptp->rPerDeviceParams.f64RratioMaxDev = prInitParams->f64RratioMaxDev;
+    prGptp->rPerDeviceParams.f64PdelayNvmWriteThr = prInitParams->f64PdelayNvmWriteThr;
+    prGptp->rPerDeviceParams.f64RratioNvmWriteThr = prInitParams->f64RratioNvmWriteThr;
+    prGptp->rPerDeviceParams.u8NextFrameIdSync = 0u;
+    prGptp->rPerDeviceParams.u8NextFrameIdPdReq = 100u;
+    prGptp->rPerDeviceParams.u8NextFrameIdPdResp = 175u;
+    prGptp->rPerDeviceParams.u8NumberOfDomains = prInitParams->u8GptpDomainsCount;
+    prGptp->rPerDeviceParams.u8NumberOfPdelayMachines = prGptp->rPerDeviceParams.u8PortsCount;
+    prGptp->rPerDeviceParams.bSdoIdCompatibilityMode = prInitParams->bSdoIdCompatibilityMode;
+    prGptp->rPerDeviceParams.bVlanEnabled = prInitParams->bVlanEnabled;
+    prGptp->rPerDeviceParams.u16VlanTci = prInitParams->u16VlanTci;
+    prGptp->rPerDeviceParams.bSignalingEnabled = prInitParams->bSignalingEnabled;
+    prGptp->rPerDeviceParams.rEstimGmOffset.s64TimeStampS = 0;
+    prGptp->rPerDeviceParams.rEstimGmOffset.s32TimeStampNs = 0;
+    prGptp->rPerDeviceParams.f64CorrClockRateRatio = 1.0;
+    prGptp->rPerDeviceParams.s32ClockAdjPpb = 0;
+    prGptp->rPerDeviceParams.bEverUpdated = false;
+#ifdef GPTP_COUNTERS
+    prGptp->rPerDeviceParams.u64StepValidFromNs = 0u;
+#endif /* GPTP_COUNTERS */
+    prGptp->rPerDeviceParams.bEstimGmOffsetCalculated = false;
+    prGptp->rPerDeviceParams.rSynLockParam = prInitParams->rSynLockParam;
+    prGptp->rPtpStackCallBacks.pfDomSelectionCB = prInitParams->rPtpStackCallBacks.pfDomSelectionCB;
+    prGptp->rPtpStackCallBacks.pfNvmWriteCB = prInitParams->rPtpStackCallBacks.pfNvmWriteCB;
+    prGptp->rPtpStackCallBacks.pfNvmReadCB = prInitParams->rPtpStackCallBacks.pfNvmReadCB;
+    prGptp->rPtpStackCallBacks.pfNvmReadReqCB = prInitParams->rPtpStackCallBacks.pfNvmReadReqCB;
+    prGptp->rPtpStackCallBacks.pfErrNotify = prInitParams->rPtpStackCallBacks.pfErrNotify;
+    prGptp->rPtpStackCallBacks.pfSynNotify = prInitParams->rPtpStackCallBacks.pfSynNotify;
+
+    /* Clean domain lookup table */
+    for (u16Clean = 0u; u16Clean < GPTP_DEF_DOMAIN_NUM_CNT; u16Clean++)
+    {
+        prGptp->rPerDeviceParams.au8DomainLookup[u16Clean] = GPTP_DEF_LOOKUP_NONE;
+    }
 
     /* Clean frame ID table */
     for (u16Clean = 0u; u16Clean < 256u; u16Clean++)
     {
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u16Clean].u8Port = (uint8_t)0xFFu;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u16Clean].u8MachineId = 0u;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u16Clean].u8DomainId = 0u;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u16Clean].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u16Clean].u16SequenceId = 0u;
+        prGptp->rPerDeviceParams.arFrameIdTable[u16Clean].u8Port = (uint8_t)0xFFu;
+        prGptp->rPerDeviceParams.arFrameIdTable[u16Clean].u8MachineId = 0u;
+        prGptp->rPerDeviceParams.arFrameIdTable[u16Clean].u8DomainId = 0u;
+        prGptp->rPerDeviceParams.arFrameIdTable[u16Clean].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
+        prGptp->rPerDeviceParams.arFrameIdTable[u16Clean].u16SequenceId = 0u;
     }
 
     /* Port Init */
     for (u8Port = 0u; u8Port < u8NumberOfPorts; u8Port++)
     {
-        rGptpDataStruct.prPerPortParams[u8Port].u8PortId = u8Port;
+        prGptp->prPerPortParams[u8Port].u8PortId = u8Port;
         if (GPTP_ERR_OK == GPTP_PORT_ObtainPortMac(u8Port, &u64PortMac))
         {
-            rGptpDataStruct.prPerPortParams[u8Port].rSourceMac.u48Mac = (u64PortMac & (uint64_t)GPTP_DEF_BIT_MASK_16L_48H);
+            prGptp->prPerPortParams[u8Port].rSourceMac.u48Mac = (u64PortMac & (uint64_t)GPTP_DEF_BIT_MASK_16L_48H);
 
             prPdelayInit = &prInitParams->pcrPdelayMachinesParam[u8Port];
-            rGptpDataStruct.prPerPortParams[u8Port].u64ClockId = prPdelayInit->u64ClockId;
+            prGptp->prPerPortParams[u8Port].u64ClockId = prPdelayInit->u64ClockId;
 
             if (0u == u8Port)
             {
                 /* Copy Unique identifier to the structure product details */
-                GPTP_INTERNAL_CpyMac(&rGptpDataStruct, u64PortMac);
+                GPTP_INTERNAL_CpyMac(prGptp, u64PortMac);
             }
 
         }
@@ -553,13 +741,13 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 
 #ifdef GPTP_USE_PRINTF
     /* Print product details to console */
-    GPTP_INTERNAL_PrintDetails(&rGptpDataStruct);
+    GPTP_INTERNAL_PrintDetails(prGptp);
 #endif
 
     /* Pdelay machines initialization */
     for (u8Port = 0u; u8Port < u8NumberOfPorts; u8Port++)
     {
-        prPdelay = &rGptpDataStruct.prPdelayMachines[u8Port];
+        prPdelay = &prGptp->prPdelayMachines[u8Port];
 
         prPdelayInit = &prInitParams->pcrPdelayMachinesParam[u8Port];
 
@@ -597,12 +785,17 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         prPdelay->f64RratioToWrite = 0.0;
         prPdelay->rPdelayNvmWriteStat = GPTP_DEF_MEM_WRITE_STOP;
         prPdelay->rRratioNvmWriteStat = GPTP_DEF_MEM_WRITE_STOP;
+        prPdelay->rPdelayNvmReadStat = GPTP_DEF_MEM_READ_IDLE;
+        prPdelay->rRratioNvmReadStat = GPTP_DEF_MEM_READ_IDLE;
+        /* Content of the NVM is not known until it is read */
+        prPdelay->f64PdelayNvm = ((float64_t)0.0f / (float64_t)0.0f);
+        prPdelay->f64RratioNvm = ((float64_t)0.0f / (float64_t)0.0f);
 
         /* Init the pointer - port enabled from the port structure */
-        prPdelay->pbPortEnabled = &rGptpDataStruct.prPerPortParams[u8Port].bPortEnabled;
+        prPdelay->pbPortEnabled = &prGptp->prPerPortParams[u8Port].bPortEnabled;
 
         /* Init the pointer - Clock id of the port */
-        prPdelay->pu64ClockId = &rGptpDataStruct.prPerPortParams[u8Port].u64ClockId;
+        prPdelay->pu64ClockId = &prGptp->prPerPortParams[u8Port].u64ClockId;
         prPdelay->u32NvmAddressPdelay = prPdelayInit->u32NvmAddressPdelay;
         prPdelay->u32NvmAddressRratio = prPdelayInit->u32NvmAddressRratio;
         prPdelay->s16DelayAsymmetry = prPdelayInit->s16DelayAsymmetry;
@@ -614,7 +807,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         }
 
         /* Load pdelay value from the NVM */
-        GPTP_PORT_ValueNvmRead(prPdelay, GPTP_DEF_NVM_PDELAY, &rGptpDataStruct);
+        GPTP_PORT_ValueNvmRead(prPdelay, GPTP_DEF_NVM_PDELAY, prGptp);
         prPdelay->bPdelayValueValid = GPTP_INTERNAL_PdelayCheck(prPdelay->u8GptpPort,
                                                                 (float64_t)prPdelay->u64NeighborPropDelayThreshNs,
                                                                 prPdelay->f64NeighborPropDelay);
@@ -626,8 +819,8 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         }
 
         /* Load neighbor rate ratio value from the NVM */
-        GPTP_PORT_ValueNvmRead(prPdelay, GPTP_DEF_NVM_RRATIO, &rGptpDataStruct);
-        prPdelay->bNeighborRateRatioValid = GPTP_INTERNAL_RateRratioCheck(rGptpDataStruct.rPerDeviceParams.f64RratioMaxDev, \
+        GPTP_PORT_ValueNvmRead(prPdelay, GPTP_DEF_NVM_RRATIO, prGptp);
+        prPdelay->bNeighborRateRatioValid = GPTP_INTERNAL_RateRratioCheck(prGptp->rPerDeviceParams.f64RratioMaxDev, \
                                                                           &prPdelay->f64NeighborRateRatio);
 
         prPdelay->bPdelAveragerInitialized = false;
@@ -661,12 +854,12 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
     }
 
     /* Flag signalizing if there is a Clock Slave Domain - if the local clock is intended to be update */
-    rGptpDataStruct.bLocClkToUpdate = false;
+    prGptp->bLocClkToUpdate = false;
 
     /* Domains initialization */
-    for (u8Domain = 0u; u8Domain < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+    for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
     {
-        prDomain = &rGptpDataStruct.prPerDomainParams[u8Domain];
+        prDomain = &prGptp->prPerDomainParams[u8Domain];
 
         prDomainInit = &prInitParams->pcrDomainsSyncsParam[u8Domain];
 
@@ -684,11 +877,29 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
 
         prDomain->u8DomainIndex = u8Domain;
         prDomain->u8DomainNumber = prDomainInit->u8DomainNumber;
+        /* Domain number used twice is reported by the init parameters check, the first one is looked up */
+        if (GPTP_DEF_LOOKUP_NONE == prGptp->rPerDeviceParams.au8DomainLookup[prDomain->u8DomainNumber])
+        {
+            prGptp->rPerDeviceParams.au8DomainLookup[prDomain->u8DomainNumber] = u8Domain;
+        }
+
+        for (u8Port = 0u; u8Port < GPTP_DEF_PORTS_MAX; u8Port++)
+        {
+            prDomain->au8SyncMachineLookup[u8Port] = GPTP_DEF_LOOKUP_NONE;
+        }
         prDomain->bRcvdSyncUsedForLocalClk = false;
         prDomain->u8NumberOfSyncsPerDom = prDomainInit->u8NumberOfSyncMachines;
         prDomain->bDomainIsGm = prDomainInit->bDomainIsGm;
         prDomain->u32SyncOutlierThrNs = prDomainInit->u32SyncOutlierThrNs;
         prDomain->u8OutlierIgnoreCnt = prDomainInit->u8OutlierIgnoreCnt;
+        prDomain->eOfsFiltType = prDomainInit->eOfsFiltType;
+        prDomain->u8OfsFiltWindow = prDomainInit->u8OfsFiltWindow;
+        if ((0u == prDomainInit->u8OfsFiltWindow) || (GPTP_DEF_OFS_FILT_WIN_MAX < prDomainInit->u8OfsFiltWindow))
+        {
+            prDomain->u8OfsFiltWindow = GPTP_DEF_OFS_FILT_WIN_MAX;
+        }
+        prDomain->u8OfsFiltIqrGain = prDomainInit->u8OfsFiltIqrGain;
+        GPTP_FILT_Reset(&prDomain->rOfsFilt);
         prDomain->rLastValidGmPlusCor.u64TimeStampS = 0u;
         prDomain->rLastValidGmPlusCor.u32TimeStampNs = 0u;
         prDomain->rLastValidTsOfGmPlusCor.u64TimeStampS = 0u;
@@ -700,13 +911,30 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         prDomain->bGmFailureReported = false;
         prDomain->bSyncValidEverReceived = false;
 
+        /* Initialize PI Controller and Kalman servo of the domain */
+        GPTP_PI_Init(&prDomain->rPi, prPiConfig);
+        GPTP_KF_Init(&prDomain->rKf, prKfConfig);
+        prDomain->eServoType = GPTP_DEF_SERVO_PI;
+        if (GPTP_DEF_SERVO_KALMAN == prDomainInit->eServoType)
+        {
+            if (NULL != prKfConfig)
+            {
+                prDomain->eServoType = GPTP_DEF_SERVO_KALMAN;
+            }
+            else
+            {
+                /* Register error -  missing configuration */
+                GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, u8Domain, GPTP_ERR_PI_KF_INCORRECT_CFG, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+            }
+        }
+
         /* If the domain is non GM */
         if (false == prDomain->bDomainIsGm)
         {
             GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_INFO, ("gptp: Initializing Domain %u as Bridge.\n", prDomain->u8DomainNumber));
 
             /* Local clock is expected to be updated */
-            rGptpDataStruct.bLocClkToUpdate = true;
+            prGptp->bLocClkToUpdate = true;
 
             /* At the start-up, the non GM domain is advancing correction */
             prDomain->bSyncActingGm = true;
@@ -728,12 +956,15 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         }
 
         prDomain->bSyncedGm = prDomainInit->bSyncedGm;
+#ifdef GPTP_USE_PRINTF
+        prDomain->bActingGmReported = false;
+#endif /* GPTP_USE_PRINTF */
 
         /* If domain is synced GM */
         if (true == prDomainInit->bSyncedGm)
         {
             /* Check all domains to find matching domain number */
-            for (u8Seek = 0u; u8Seek < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8Seek++)
+            for (u8Seek = 0u; u8Seek < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Seek++)
             {
                 if (prDomainInit->u8RefDomForSynced == prInitParams->pcrDomainsSyncsParam[u8Seek].u8DomainNumber)
                 {
@@ -798,14 +1029,20 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
             /* Check if accessing "valid" port - index < maximum number of ports */
             if (prSync->u8GptpPort < u8NumberOfPorts)
             {
+                /* Sync machine lookup by the gPTP port, the first machine on the port is looked up */
+                if ((prSync->u8GptpPort < GPTP_DEF_PORTS_MAX) &&
+                    (GPTP_DEF_LOOKUP_NONE == prDomain->au8SyncMachineLookup[prSync->u8GptpPort]))
+                {
+                    prDomain->au8SyncMachineLookup[prSync->u8GptpPort] = u8Machine;
+                }
                 /* Init the pointer - path delay on the corresponding port */
-                prSync->pf64NeighborPropDelay = &rGptpDataStruct.prPdelayMachines[prSync->u8GptpPort].f64NeighborPropDelay;
+                prSync->pf64NeighborPropDelay = &prGptp->prPdelayMachines[prSync->u8GptpPort].f64NeighborPropDelay;
                 /* Init the pointer - path Neighbor Rate Ratio on the corresponding port */
-                prSync->pf64NeighborRateRatio = &rGptpDataStruct.prPdelayMachines[prSync->u8GptpPort].f64NeighborRateRatio;
+                prSync->pf64NeighborRateRatio = &prGptp->prPdelayMachines[prSync->u8GptpPort].f64NeighborRateRatio;
                 /* Init the pointer - port enabled from the port structure */
-                prSync->pbPortEnabled = &rGptpDataStruct.prPerPortParams[prSync->u8GptpPort].bPortEnabled;
+                prSync->pbPortEnabled = &prGptp->prPerPortParams[prSync->u8GptpPort].bPortEnabled;
                 /* Init the pointer - delay assymetry on the corresponding port */
-                prSync->ps16DelayAsymmetry = &rGptpDataStruct.prPdelayMachines[prSync->u8GptpPort].s16DelayAsymmetry;
+                prSync->ps16DelayAsymmetry = &prGptp->prPdelayMachines[prSync->u8GptpPort].s16DelayAsymmetry;
             }
             else
             {
@@ -843,7 +1080,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
                            initiator */
                         if (prSync->u8GptpPort < u8NumberOfPorts)
                         {
-                            if (false == rGptpDataStruct.prPdelayMachines[prSync->u8GptpPort].bPdelayInitiatorEnabled)
+                            if (false == prGptp->prPdelayMachines[prSync->u8GptpPort].bPdelayInitiatorEnabled)
                             {
                                 eError = GPTP_ERR_I_NO_PDELAY_FOR_SLAVE;
                                 GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_I_NO_PDELAY_FOR_SLAVE, GPTP_ERR_SEQ_ID_NOT_SPECIF);
@@ -905,7 +1142,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
     if (GPTP_ERR_OK == eError)
     {
     /* Init timers */
-        GPTP_TIMER_TimerInit(&rGptpDataStruct);
+        GPTP_TIMER_TimerInit(prGptp);
     }
 
     /* Dummy read of the Link status */
@@ -913,6 +1150,10 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
     {
         /* Dummy status read ignores return value */
         (void)GPTP_PORT_GetLinkStatus(u8Port, &bLinkStat);
+#ifdef GPTP_TX_TEMPLATES
+        /* Frame templates are built upon the first transmission */
+        GPTP_FRAME_TemplatesInvalidate(prGptp, u8Port);
+#endif /* GPTP_TX_TEMPLATES */
     }
 
     /* If no error */
@@ -921,8 +1162,8 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
         /* Port Init */
         for (u8Port = 0u; u8Port < u8NumberOfPorts; u8Port++)
         {
-            prPdelay = &rGptpDataStruct.prPdelayMachines[u8Port];
-            prPort= &rGptpDataStruct.prPerPortParams[u8Port];
+            prPdelay = &prGptp->prPdelayMachines[u8Port];
+            prPort= &prGptp->prPerPortParams[u8Port];
 
             /* If the link is up */
             if (GPTP_ERR_OK != GPTP_PORT_GetLinkStatus(u8Port, &bLinkStat))
@@ -942,9 +1183,9 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
                 prPdelay->bTimerPdelayTimerEnabled = true;
 
                 /* Sync machines */
-                for (u8Domain = 0u; u8Domain < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+                for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
                 {
-                    prDomain = &rGptpDataStruct.prPerDomainParams[u8Domain];
+                    prDomain = &prGptp->prPerDomainParams[u8Domain];
                     for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
                     {
                         prSync = &prDomain->prSyncMachines[u8Machine];
@@ -966,9 +1207,9 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
                 prPdelay->bTimerPdelayTimerEnabled = false;
 
                 /* Sync machines */
-                for (u8Domain = 0u; u8Domain < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+                for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
                 {
-                    prDomain = &rGptpDataStruct.prPerDomainParams[u8Domain];
+                    prDomain = &prGptp->prPerDomainParams[u8Domain];
                     for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
                     {
                         prSync = &prDomain->prSyncMachines[u8Machine];
@@ -983,25 +1224,42 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
     }
 
     /* Reset sync lock and report to the app. */
-    GPTP_INTERNAL_ResetSyncLock(&rGptpDataStruct);
+    GPTP_INTERNAL_ResetSyncLock(prGptp);
 
     /* If no error */
     if (GPTP_ERR_OK == eError)
     {
-        rGptpDataStruct.bGptpInitialized = true;
+        prGptp->bGptpInitialized = true;
 
         GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_STATE, ("gptp: Initialization of gPTP stack version "));
         GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_STATE, (GPTP_DEF_GPTP_REV));
         GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_STATE, (" complete\n"));
 
 #ifdef GPTP_COUNTERS
-        GPTP_INTERNAL_ClearStats(&rGptpDataStruct);
+        GPTP_INTERNAL_ClearStats(prGptp);
+        GPTP_INTERNAL_ClearHistograms(prGptp);
 #endif /* GPTP_COUNTERS */
 
     }
+
+    prGptpBound = prGptpPrev;
+
     return eError;
 }
 
+/*!
+ *
+ * @brief      This function initializes the default instance of the gPTP stack.
+ *
+ * @param[in]  prInitParams Pointer to structure containing initial parameters
+ *
+ * @return     gPTP error code.
+ */
+gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
+{
+    return GPTP_GptpInitInst(&rGptpDataStruct, prInitParams);
+}
+
 /*!
  *
  * @brief   This function handles the time stamps generated by the gPTP message transmission.
@@ -1010,6 +1268,7 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
  *          The time stamp values are stored to the internal gPTP structures by the port number
  *          and frame ID for the future use.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] u8Port gPTP port number from which the time stamp is received.
  * @param[in] u32TxTsS Tx time stamp value, seconds part.
  * @param[in] u32TxTsNs Tx time stamp value, nano seconds part.
@@ -1018,113 +1277,135 @@ gptp_err_type_t GPTP_GptpInit(const gptp_def_init_params_t *prInitParams)
  * @ requirements 529199
  * @ requirements 529201
  */
-void GPTP_TimeStampHandler(uint8_t u8Port,
-                           uint32_t u32TxTsS,
-                           uint32_t u32TxTsNs,
-                           uint8_t u8FrameId)
+void GPTP_TimeStampHandlerInst(gptp_def_data_t *prGptp,
+                               uint8_t u8Port,
+                               uint32_t u32TxTsS,
+                               uint32_t u32TxTsNs,
+                               uint8_t u8FrameId)
 {
+    gptp_def_data_t                *prGptpPrev;
     const gptp_def_domain_t        *prDomain;
     uint8_t                        u8Domain;
     uint8_t                        u8Frame;
     uint8_t                        u8Machine;
     gptp_def_sync_t                *prSyncMachine;
     gptp_def_pdelay_t              *prPdelayMachine;
+#ifdef GPTP_COUNTERS
+    gptp_def_timestamp_t           rTxTs;
+#endif /* GPTP_COUNTERS */
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
 
     /* Process timestamps only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
         u8Frame = u8FrameId;
 
         /* Process timestamp */
-        if (rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8Port == u8Port)
+        if (prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8Port == u8Port)
         {
-            u8Machine = rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId;
-            u8Domain =  rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId;
+            u8Machine = prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId;
+            u8Domain =  prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId;
+
+#ifdef GPTP_COUNTERS
+            /* Handover before the last clock step is not comparable with the egress timestamp */
+            if ((0u != prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u64EnqueueNs) &&
+                (prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u64EnqueueNs >= prGptp->rPerDeviceParams.u64StepValidFromNs))
+            {
+                rTxTs.u64TimeStampS = (uint64_t)u32TxTsS;
+                rTxTs.u32TimeStampNs = u32TxTsNs;
+                GPTP_INTERNAL_PortHistAdd(prGptp, u8Port, GPTP_DEF_HIST_TX_EGRESS,
+                                          prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u64EnqueueNs, GPTP_INTERNAL_TsToU64(rTxTs));
+                prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u64EnqueueNs = 0u;
+            }
+#endif /* GPTP_COUNTERS */
 
-            switch (rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].eMsgType)
+            switch (prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].eMsgType)
             {
                 case GPTP_DEF_MSG_TYPE_SYNC:
                     if (u8Frame < GPTP_DEF_FID_SYNC_MAX)
                     {
-                        if (u8Domain < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains)
+                        if (u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains)
                         {
-                            prDomain = &rGptpDataStruct.prPerDomainParams[u8Domain];
+                            prDomain = &prGptp->prPerDomainParams[u8Domain];
                             if (u8Machine < prDomain->u8NumberOfSyncsPerDom)
                             {
                                 prSyncMachine = &prDomain->prSyncMachines[u8Machine];
                                 prSyncMachine->rTsTs.u64TimeStampS = (uint64_t)u32TxTsS;
                                 prSyncMachine->rTsTs.u32TimeStampNs = u32TxTsNs;
                                 prSyncMachine->bTsTsRegistred = true;
-                                prSyncMachine->u16TsTsSeqId = rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId;
-                                prSyncMachine->bSyncActingGm = rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].bSyncActingGm;
-                                GPTP_SYNC_SyncMachine(&rGptpDataStruct, u8Domain, u8Machine, GPTP_DEF_CALL_ON_TIMESTAMP);
+                                prSyncMachine->u16TsTsSeqId = prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId;
+                                prSyncMachine->bSyncActingGm = prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].bSyncActingGm;
+                                GPTP_SYNC_SyncMachine(prGptp, u8Domain, u8Machine, GPTP_DEF_CALL_ON_TIMESTAMP);
                             }
                             else
                             {
-                                GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_SYNC_MACHINE_INDEX, rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                                GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_SYNC_MACHINE_INDEX, prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                             }
                         }
                         else
                         {
-                            GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_SYNC_DOMAIN_INDEX, rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                            GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_SYNC_DOMAIN_INDEX, prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                         }
                     }
 
                     else
                     {
-                        GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_FRAME_ID_ERROR, rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                        GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_FRAME_ID_ERROR, prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                     }
                 break;
 
                 case GPTP_DEF_MSG_TYPE_PD_REQ:
                     if ((u8Frame >= GPTP_DEF_FID_PDREQ_START) && (u8Frame < GPTP_DEF_FID_PDREQ_MAX))
                     {
-                        if (u8Machine < rGptpDataStruct.rPerDeviceParams.u8NumberOfPdelayMachines)
+                        if (u8Machine < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines)
                         {
-                            prPdelayMachine = &rGptpDataStruct.prPdelayMachines[u8Machine];
+                            prPdelayMachine = &prGptp->prPdelayMachines[u8Machine];
                             prPdelayMachine->rT1Ts.u64TimeStampS = (uint64_t)u32TxTsS;
                             prPdelayMachine->rT1Ts.u32TimeStampNs = u32TxTsNs;
                             prPdelayMachine->bT1TsRegistred = true;
-                            prPdelayMachine->u16T1TsSeqId = rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId;
+                            prPdelayMachine->u16T1TsSeqId = prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId;
                             /* Running the same code sequence as if it is called upon the message received */
-                            GPTP_PDELAY_PdelayMachine(&rGptpDataStruct, prPdelayMachine, GPTP_DEF_CALL_PTP_RECEIVED);
+                            GPTP_PDELAY_PdelayMachine(prGptp, prPdelayMachine, GPTP_DEF_CALL_PTP_RECEIVED);
                         }
                         else
                         {
                             GPTP_ERR_Register(u8Machine, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_T_PDEL_MACHINE_INDEX, \
-                                              rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                                              prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                         }
                     }
 
                     else
                     {
                         GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_FRAME_ID_ERROR, \
-                                          rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                                          prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                     }
                 break;
 
                 case GPTP_DEF_MSG_TYPE_PD_RESP:
                     if ((u8Frame >= GPTP_DEF_FID_PDRESP_START) && (u8Frame < GPTP_DEF_FID_PDRESP_MAX))
                     {
-                        if (u8Machine < rGptpDataStruct.rPerDeviceParams.u8NumberOfPdelayMachines)
+                        if (u8Machine < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines)
                         {
-                            prPdelayMachine = &rGptpDataStruct.prPdelayMachines[u8Machine];
+                            prPdelayMachine = &prGptp->prPdelayMachines[u8Machine];
                             prPdelayMachine->rT3Ts.u64TimeStampS = (uint64_t)u32TxTsS;
                             prPdelayMachine->rT3Ts.u32TimeStampNs = u32TxTsNs;
                             prPdelayMachine->bT3TsRegistred = true;
-                            prPdelayMachine->u16T3TsSeqId = rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId;
-                            GPTP_PDELAY_PdelayMachine(&rGptpDataStruct, prPdelayMachine, GPTP_DEF_CALL_ON_TIMESTAMP);
+                            prPdelayMachine->u16T3TsSeqId = prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId;
+                            GPTP_PDELAY_PdelayMachine(prGptp, prPdelayMachine, GPTP_DEF_CALL_ON_TIMESTAMP);
                         }
                         else
                         {
                             GPTP_ERR_Register(u8Machine, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_T_PDEL_MACHINE_INDEX, \
-                                              rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                                              prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                         }
                     }
 
                     else
                     {
-                        GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_FRAME_ID_ERROR, rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+                        GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_T_FRAME_ID_ERROR, prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
                     }
                 break;
 
@@ -1133,32 +1414,51 @@ void GPTP_TimeStampHandler(uint8_t u8Port,
             }
 #ifdef GPTP_MIRROR_PORT
             /* Mark frame ID entry used in case the switch is mirroring gPTP messages */
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8Port = (uint8_t)0xFFu;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId = (uint8_t)0xFFu;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId  = (uint8_t)0xFFu;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId = 0u;
-            rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].bSyncActingGm = false;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8Port = (uint8_t)0xFFu;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId = (uint8_t)0xFFu;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId  = (uint8_t)0xFFu;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId = 0u;
+            prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].bSyncActingGm = false;
         }
 #else
         }
         /* Port ID does not match, register error */
         else
         {
-            GPTP_ERR_Register(rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId, \
-                rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId, GPTP_ERR_T_TS_NOT_IDENTIFIED, \
-                rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
+            GPTP_ERR_Register(prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId, \
+                prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId, GPTP_ERR_T_TS_NOT_IDENTIFIED, \
+                prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId);
         }
 
         /* Mark frame ID entry used in normal operation */
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8Port = (uint8_t)0xFFu;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId = (uint8_t)0xFFu;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId  = (uint8_t)0xFFu;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId = 0u;
-        rGptpDataStruct.rPerDeviceParams.arFrameIdTable[u8Frame].bSyncActingGm = false;
+        prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8Port = (uint8_t)0xFFu;
+        prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8MachineId = (uint8_t)0xFFu;
+        prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u8DomainId  = (uint8_t)0xFFu;
+        prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
+        prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].u16SequenceId = 0u;
+        prGptp->rPerDeviceParams.arFrameIdTable[u8Frame].bSyncActingGm = false;
 #endif /* GPTP_MIRROR_PORT */
     }
+
+    prGptpBound = prGptpPrev;
+}
+
+/*!
+ *
+ * @brief   This function handles the time stamps of the default instance.
+ *
+ * @param[in] u8Port gPTP port number from which the time stamp is received.
+ * @param[in] u32TxTsS Tx time stamp value, seconds part.
+ * @param[in] u32TxTsNs Tx time stamp value, nano seconds part.
+ * @param[in] u8FrameId Id of frame, which generated the time stamp.
+ */
+void GPTP_TimeStampHandler(uint8_t u8Port,
+                           uint32_t u32TxTsS,
+                           uint32_t u32TxTsNs,
+                           uint8_t u8FrameId)
+{
+    GPTP_TimeStampHandlerInst(&rGptpDataStruct, u8Port, u32TxTsS, u32TxTsNs, u8FrameId);
 }
 
 /*!
@@ -1168,6 +1468,7 @@ void GPTP_TimeStampHandler(uint8_t u8Port,
  * @details This function updates the TX frame table with the time stamp and port ID
  *          value for particular entry.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] u8Port gPTP port number received the time stamp.
  * @param[in] u32BufferIndex Index of the frame buffer.
  * @param[in] u32TsSeconds Egress time stamp - seconds.
@@ -1176,21 +1477,27 @@ void GPTP_TimeStampHandler(uint8_t u8Port,
  * @ requirements 535652
  * @ requirements 529199
  */
-void GPTP_UpdateTimestampEntry(uint8_t u8Port,
-                               uint32_t u32BufferIndex,
-                               uint32_t u32TsSeconds,
-                               uint32_t u32TsNanoseconds)
+void GPTP_UpdateTimestampEntryInst(gptp_def_data_t *prGptp,
+                                   uint8_t u8Port,
+                                   uint32_t u32BufferIndex,
+                                   uint32_t u32TsSeconds,
+                                   uint32_t u32TsNanoseconds)
 {
+    gptp_def_data_t         *prGptpPrev;
     const gptp_def_pdelay_t *prPdelay;
     const gptp_def_domain_t *prDomain;
     const gptp_def_sync_t   *prSync;
     uint8_t u8Domain;
     uint8_t u8Machine;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
     
     /* Store Timestamp entry only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
-        prPdelay = &rGptpDataStruct.prPdelayMachines[u8Port];
+        prPdelay = &prGptp->prPdelayMachines[u8Port];
 
         if (prPdelay->rTxDataReq.prFrameMap->u32BufferIndex == u32BufferIndex)
         {
@@ -1209,9 +1516,9 @@ void GPTP_UpdateTimestampEntry(uint8_t u8Port,
         }
         
         /* Search in each domain */
-        for (u8Domain = 0u; u8Domain < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+        for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
         {
-            prDomain = &rGptpDataStruct.prPerDomainParams[u8Domain];
+            prDomain = &prGptp->prPerDomainParams[u8Domain];
             
             /* Search in each sync machine */ 
             for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
@@ -1230,6 +1537,25 @@ void GPTP_UpdateTimestampEntry(uint8_t u8Port,
             }
         }
     }
+
+    prGptpBound = prGptpPrev;
+}
+
+/*!
+ *
+ * @brief   This function updates the TX frame table of the default instance.
+ *
+ * @param[in] u8Port gPTP port number received the time stamp.
+ * @param[in] u32BufferIndex Index of the frame buffer.
+ * @param[in] u32TsSeconds Egress time stamp - seconds.
+ * @param[in] u32TsNanoseconds Egress time stamp - nano seconds.
+ */
+void GPTP_UpdateTimestampEntry(uint8_t u8Port,
+                               uint32_t u32BufferIndex,
+                               uint32_t u32TsSeconds,
+                               uint32_t u32TsNanoseconds)
+{
+    GPTP_UpdateTimestampEntryInst(&rGptpDataStruct, u8Port, u32BufferIndex, u32TsSeconds, u32TsNanoseconds);
 }
 
 /*!
@@ -1239,6 +1565,7 @@ void GPTP_UpdateTimestampEntry(uint8_t u8Port,
  * @details This function inspects the gPTP message type and extracts the gPTP data from
  *          the message.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] rRxData structure containing all the necessary gPTP data for processing.
  *
  * @ requirements 529199
@@ -1246,29 +1573,49 @@ void GPTP_UpdateTimestampEntry(uint8_t u8Port,
  * @ requirements 152455
  * @ requirements 120457
  */
-void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
+void GPTP_MsgReceiveInst(gptp_def_data_t *prGptp,
+                         gptp_def_rx_data_t rRxData)
 {
-    static uint8_t                 u8RcvdForMachine;
-    static uint8_t                 u8RcvdForDomain;
-    static gptp_def_msg_type_t     rMsgTypeRcvd;
+    gptp_def_data_t                *prGptpPrev;
+    uint8_t                        u8RcvdForMachine;
+    uint8_t                        u8RcvdForDomain;
+    gptp_def_msg_type_t            rMsgTypeRcvd;
     gptp_err_type_t                eError;
     gptp_def_domain_t              *prDomain;
     gptp_def_sync_t                *prSyncMachine;
     gptp_def_pdelay_t              *prPdelayMachine;
+#ifdef GPTP_COUNTERS
+    gptp_def_timestamp_t           rRxTs;
+#endif /* GPTP_COUNTERS */
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
 
     /* Process received message only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
-        eError = GPTP_FRAME_ParseRx(rRxData, &rGptpDataStruct, &rMsgTypeRcvd, &u8RcvdForDomain, &u8RcvdForMachine);
+#ifdef GPTP_COUNTERS
+        /* Ingress timestamp to the dispatch, both in the corrected time. The
+           timestamps taken before the last clock step are skipped. */
+        rRxTs.u64TimeStampS = (uint64_t)rRxData.u32TsSec;
+        rRxTs.u32TimeStampNs = rRxData.u32TsNsec;
+        if (GPTP_INTERNAL_TsToU64(rRxTs) >= prGptp->rPerDeviceParams.u64StepValidFromNs)
+        {
+            GPTP_INTERNAL_PortHistAdd(prGptp, rRxData.u8PtpPort, GPTP_DEF_HIST_RX_DISPATCH,
+                                      GPTP_INTERNAL_TsToU64(rRxTs), GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_CORRECTED)));
+        }
+#endif /* GPTP_COUNTERS */
+        eError = GPTP_FRAME_ParseRx(rRxData, prGptp, &rMsgTypeRcvd, &u8RcvdForDomain, &u8RcvdForMachine);
 
         if (GPTP_ERR_OK == eError)
         {
-            prPdelayMachine = &rGptpDataStruct.prPdelayMachines[u8RcvdForMachine];
+            prPdelayMachine = &prGptp->prPdelayMachines[u8RcvdForMachine];
             switch (rMsgTypeRcvd)
             {
                 case GPTP_DEF_MSG_TYPE_SYNC:
                 case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
-                    prDomain = &rGptpDataStruct.prPerDomainParams[u8RcvdForDomain];
+                    prDomain = &prGptp->prPerDomainParams[u8RcvdForDomain];
                     prSyncMachine = &prDomain->prSyncMachines[u8RcvdForMachine];
 
                     /* Domain which receives sync message, can't be GM */
@@ -1277,13 +1624,13 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
                         /* Check if the received sync / fup is for slave machine of the domain */
                         if (prDomain->u8SlaveMachineId == u8RcvdForMachine)
                         {
-                            GPTP_SYNC_SyncMachine(&rGptpDataStruct, u8RcvdForDomain, u8RcvdForMachine, GPTP_DEF_CALL_PTP_RECEIVED);
+                            GPTP_SYNC_SyncMachine(prGptp, u8RcvdForDomain, u8RcvdForMachine, GPTP_DEF_CALL_PTP_RECEIVED);
 
                             /* If followup received */
                             if (GPTP_DEF_MSG_TYPE_FOLLOW_UP == rMsgTypeRcvd)
                             {
                                 /* Send sync messages on non GM domain (bridge) */
-                                GPTP_TIMER_SyncsSendNonGm(&rGptpDataStruct, prDomain, GPTP_DEF_CALL_PTP_RECEIVED);
+                                GPTP_TIMER_SyncsSendNonGm(prGptp, prDomain, GPTP_DEF_CALL_PTP_RECEIVED);
                             }
                         }
                         else
@@ -1296,8 +1643,8 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
                                 /* Register error - sync received on master machine */
                                 GPTP_ERR_Register(u8RcvdForMachine, u8RcvdForDomain, GPTP_ERR_M_SYNC_ON_MASTER_RCVD, GPTP_ERR_SEQ_ID_NOT_SPECIF);
 #ifdef GPTP_COUNTERS
-                                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
-                                GPTP_INTERNAL_IncrementDomainStats(&rGptpDataStruct, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
+                                GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
+                                GPTP_INTERNAL_IncrementDomainStats(prGptp, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
 #endif /* GPTP_COUNTERS */
                             }
 
@@ -1309,8 +1656,8 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
                                 /* Register error - fup received on master port */
                                 GPTP_ERR_Register(u8RcvdForMachine, u8RcvdForDomain, GPTP_ERR_M_FUP_ON_MASTER_RCVD, GPTP_ERR_SEQ_ID_NOT_SPECIF);
 #ifdef GPTP_COUNTERS
-                                GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
-                                GPTP_INTERNAL_IncrementDomainStats(&rGptpDataStruct, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
+                                GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
+                                GPTP_INTERNAL_IncrementDomainStats(prGptp, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
 #endif /* GPTP_COUNTERS */
                             }
                         }
@@ -1327,8 +1674,8 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
                             /* Register error - sync received by Grand Master */
                             GPTP_ERR_Register(u8RcvdForMachine, u8RcvdForDomain, GPTP_ERR_M_SYNC_ON_GM_RCVD, GPTP_ERR_SEQ_ID_NOT_SPECIF);
 #ifdef GPTP_COUNTERS
-                            GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
-                            GPTP_INTERNAL_IncrementDomainStats(&rGptpDataStruct, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
+                            GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
+                            GPTP_INTERNAL_IncrementDomainStats(prGptp, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
 #endif /* GPTP_COUNTERS */
                         }
 
@@ -1340,8 +1687,8 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
                             /* Register error - fup received by Grand Master */
                             GPTP_ERR_Register(u8RcvdForMachine, u8RcvdForDomain, GPTP_ERR_M_FUP_ON_GM_RCVD, GPTP_ERR_SEQ_ID_NOT_SPECIF);
 #ifdef GPTP_COUNTERS
-                            GPTP_INTERNAL_IncrementPortStats(&rGptpDataStruct, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
-                            GPTP_INTERNAL_IncrementDomainStats(&rGptpDataStruct, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
+                            GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
+                            GPTP_INTERNAL_IncrementDomainStats(prGptp, u8RcvdForDomain, u8RcvdForMachine, ieee8021AsPortStatRxPTPPacketDiscard);
 #endif /* GPTP_COUNTERS */
                         }
                     }
@@ -1353,11 +1700,11 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
                     /* fallthrough */
                 case GPTP_DEF_MSG_TYPE_PD_RESP:
                 case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
-                    GPTP_PDELAY_PdelayMachine(&rGptpDataStruct, prPdelayMachine, GPTP_DEF_CALL_PTP_RECEIVED);
+                    GPTP_PDELAY_PdelayMachine(prGptp, prPdelayMachine, GPTP_DEF_CALL_PTP_RECEIVED);
                 break;
 
                 case GPTP_DEF_MSG_TYPE_SIGNALING:
-                    GPTP_SIGNALING_RxSignaling(&rGptpDataStruct, u8RcvdForDomain, u8RcvdForMachine);
+                    GPTP_SIGNALING_RxSignaling(prGptp, u8RcvdForDomain, u8RcvdForMachine);
                 break;
 
                 default:
@@ -1365,6 +1712,19 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
             }
         }
     }
+
+    prGptpBound = prGptpPrev;
+}
+
+/*!
+ *
+ * @brief   This function receives the gPTP message by the default instance.
+ *
+ * @param[in] rRxData structure containing all the necessary gPTP data for processing.
+ */
+void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
+{
+    GPTP_MsgReceiveInst(&rGptpDataStruct, rRxData);
 }
 
 /*!
@@ -1376,6 +1736,7 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
  *          and configures the gPTP stack accordingly (enables software timers,
  *          reset sync and pdelay intervals).
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] u8Switch  Number of the respective switch.
  * @param[in] u8Port    Number of the respective port on switch.
  *
@@ -1383,22 +1744,42 @@ void GPTP_MsgReceive(gptp_def_rx_data_t rRxData)
  * @ requirements 529202
  * @ requirements 529203
  */
-void GPTP_LinkUpNotify(uint8_t u8Switch,
-                       uint8_t u8Port)
+void GPTP_LinkUpNotifyInst(gptp_def_data_t *prGptp,
+                           uint8_t u8Switch,
+                           uint8_t u8Port)
 {
+    gptp_def_data_t *prGptpPrev;
+    uint8_t        u8GptpPort;
 
-    static uint8_t u8GptpPort;
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
 
     u8GptpPort = 0u;
 
     /* Call function only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
         if (GPTP_ERR_OK == GPTP_PORT_PortLookup(&u8GptpPort, u8Port, u8Switch))
         {
-            GPTP_INTERNAL_LinkUp(u8GptpPort, &rGptpDataStruct);
+            GPTP_INTERNAL_LinkUp(u8GptpPort, prGptp);
         }
     }
+
+    prGptpBound = prGptpPrev;
+}
+
+/*!
+ *
+ * @brief   This function notifies the "link up" event to the default instance.
+ *
+ * @param[in] u8Switch  Number of the respective switch.
+ * @param[in] u8Port    Number of the respective port on switch.
+ */
+void GPTP_LinkUpNotify(uint8_t u8Switch,
+                       uint8_t u8Port)
+{
+    GPTP_LinkUpNotifyInst(&rGptpDataStruct, u8Switch, u8Port);
 }
 
 /*!
@@ -1410,27 +1791,49 @@ void GPTP_LinkUpNotify(uint8_t u8Switch,
  *          and configures the port accordingly (disables software timers, resets
  *          sync and pdelay state machines).
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] u8Switch  Number of the respective switch.
  * @param[in] u8Port    Number of the respective port on switch.
  *
  * @ requirements 529199
  * @ requirements 529204
  */
-void GPTP_LinkDownNotify(uint8_t u8Switch,
-                         uint8_t u8Port)
+void GPTP_LinkDownNotifyInst(gptp_def_data_t *prGptp,
+                             uint8_t u8Switch,
+                             uint8_t u8Port)
 {
-    static uint8_t u8GptpPort;
+    gptp_def_data_t *prGptpPrev;
+    uint8_t        u8GptpPort;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
 
     u8GptpPort = 0u;
 
     /* Call function only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
         if (GPTP_ERR_OK == GPTP_PORT_PortLookup(&u8GptpPort, u8Port, u8Switch))
         {
-            GPTP_INTERNAL_LinkDown(u8GptpPort, &rGptpDataStruct);
+            GPTP_INTERNAL_LinkDown(u8GptpPort, prGptp);
         }
     }
+
+    prGptpBound = prGptpPrev;
+}
+
+/*!
+ *
+ * @brief   This function notifies the "link down" event to the default instance.
+ *
+ * @param[in] u8Switch  Number of the respective switch.
+ * @param[in] u8Port    Number of the respective port on switch.
+ */
+void GPTP_LinkDownNotify(uint8_t u8Switch,
+                         uint8_t u8Port)
+{
+    GPTP_LinkDownNotifyInst(&rGptpDataStruct, u8Switch, u8Port);
 }
 
 /*!
@@ -1440,16 +1843,39 @@ void GPTP_LinkDownNotify(uint8_t u8Switch,
  * @details This function should be called once upon certain period.
  *          Recommended call period is 10ms.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ *
  * @ requirements 529199
  * @ requirements 529205
  */
-void GPTP_TimerPeriodic(void)
+void GPTP_TimerPeriodicInst(gptp_def_data_t *prGptp)
 {
+    gptp_def_data_t *prGptpPrev;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+#ifdef GPTP_TRACE_CAPTURE
+    GPTP_TRACE_Tick(prGptp);
+#endif /* GPTP_TRACE_CAPTURE */
+
     /* Call periodic function only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
-        GPTP_TIMER_TimerPeriodic(&rGptpDataStruct);
+        GPTP_TIMER_TimerPeriodic(prGptp);
     }
+
+    prGptpBound = prGptpPrev;
+}
+
+/*!
+ *
+ * @brief   This function increments software timer of the default instance.
+ */
+void GPTP_TimerPeriodic(void)
+{
+    GPTP_TimerPeriodicInst(&rGptpDataStruct);
 }
 
 /*!
@@ -1459,18 +1885,25 @@ void GPTP_TimerPeriodic(void)
  * @details   This function provides access to the error log. The function
  *            returns error detail stored at the log index.
  *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] u16ErrIndex Error log index.
  * @return    Error logged at the index.
  *
  * @ requirements 529199
  * @ requirements 529206
  */
-gptp_err_error_t GPTP_ErrReadIndex(uint16_t u16ErrIndex)
+gptp_err_error_t GPTP_ErrReadIndexInst(gptp_def_data_t *prGptp,
+                                       uint16_t u16ErrIndex)
 {
+    gptp_def_data_t  *prGptpPrev;
     gptp_err_error_t rErrorDetail;
 
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
     /* Call error read function only if the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
         rErrorDetail = GPTP_ERR_ReadIndex(u16ErrIndex);
     }
@@ -1483,62 +1916,231 @@ gptp_err_error_t GPTP_ErrReadIndex(uint16_t u16ErrIndex)
         rErrorDetail.u8RespGptpDomainIndex = 0u;
         rErrorDetail.rLogTime.u64TimeStampS = 0u;
         rErrorDetail.rLogTime.u32TimeStampNs = 0u;
+        rErrorDetail.rFirstLogTime.u64TimeStampS = 0u;
+        rErrorDetail.rFirstLogTime.u32TimeStampNs = 0u;
+        rErrorDetail.u16Count = 0u;
         rErrorDetail.u16RespMsgSeqId = 0u;
         rErrorDetail.bFreshLog = false;
 
         GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
+    prGptpBound = prGptpPrev;
+
     return rErrorDetail;
 }
 
 /*!
  *
- * @brief       This function gets current sync ingerval from the specified domain/sync machine
+ * @brief       This function provides access to the error log of the bound instance.
  *
- * @details     The function provides current sync interval of the respective sync machine,
- *              for both - Master sync machines and Slave sync machines.
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
  *
- * @param[in]   u8Domain Domain number on which the sync interval is updated.
- * @param[in]   u8Machine Sync machine index on which the sync interval is updated.
- * @param[out]  s8SyncInterval Pointer to sync interval variable.
+ * @param[in] u16ErrIndex Error log index.
+ * @return    Error logged at the index.
+ */
+gptp_err_error_t GPTP_ErrReadIndex(uint16_t u16ErrIndex)
+{
+    return GPTP_ErrReadIndexInst(prGptpBound, u16ErrIndex);
+}
+
+/*!
  *
- * @return      gPTP error code.
+ * @brief     This function provides access to the error log in chronological order.
  *
- * @ requirements 529199
- * @ requirements 529207
+ * @details   This function returns error detail stored at the log position,
+ *            position 0 is the oldest stored log. Count of stored logs
+ *            is provided by GPTP_ErrLogCountGet.
+ *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] u16ErrPos Error log position.
+ * @return    Error logged at the position.
  */
-gptp_err_type_t GPTP_SyncIntervalGet(uint8_t u8Domain,
-                                     uint8_t u8Machine,
-                                     int8_t *s8SyncInterval)
+gptp_err_error_t GPTP_ErrReadOldestInst(gptp_def_data_t *prGptp,
+                                        uint16_t u16ErrPos)
 {
-    const gptp_def_domain_t     *prDomain;
-    gptp_err_type_t             eError;
-    uint8_t                     u8DomainNum;
-    uint8_t                     u8DomainSeek;
-    bool                        bDomainFound;
+    gptp_def_data_t  *prGptpPrev;
+    gptp_err_error_t rErrorDetail;
 
-    eError = GPTP_ERR_OK;
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
 
-    /* If the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    /* Call error read function only if the gPTP is initialized */
+    if (true == prGptp->bGptpInitialized)
     {
-        bDomainFound = false;
-        /* Search for domain number */
-        for (u8DomainSeek = 0u; u8DomainSeek < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8DomainSeek++)
-        {
-            prDomain = &rGptpDataStruct.prPerDomainParams[u8DomainSeek];
-            if (u8Domain == prDomain->u8DomainNumber)
-            {
-                bDomainFound = true;
-                u8DomainNum = u8Domain;
-            }
-        }
+        rErrorDetail = GPTP_ERR_ReadOldest(u16ErrPos);
+    }
+
+    /* Stack not initialized */
+    else
+    {
+        rErrorDetail.eErrorType = GPTP_ERR_I_NOT_INITIALIZED;
+        rErrorDetail.u8RespGptpPortIndex = 0u;
+        rErrorDetail.u8RespGptpDomainIndex = 0u;
+        rErrorDetail.rLogTime.u64TimeStampS = 0u;
+        rErrorDetail.rLogTime.u32TimeStampNs = 0u;
+        rErrorDetail.rFirstLogTime.u64TimeStampS = 0u;
+        rErrorDetail.rFirstLogTime.u32TimeStampNs = 0u;
+        rErrorDetail.u16Count = 0u;
+        rErrorDetail.u16RespMsgSeqId = 0u;
+        rErrorDetail.bFreshLog = false;
+
+        GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+    }
+
+    prGptpBound = prGptpPrev;
+
+    return rErrorDetail;
+}
+
+/*!
+ *
+ * @brief       This function provides access to the error log of the bound instance in chronological order.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[in] u16ErrPos Error log position.
+ * @return    Error logged at the position.
+ */
+gptp_err_error_t GPTP_ErrReadOldest(uint16_t u16ErrPos)
+{
+    return GPTP_ErrReadOldestInst(prGptpBound, u16ErrPos);
+}
+
+/*!
+ *
+ * @brief     This function returns count of logs stored in the error log.
+ *
+ * @param[in] prGptp Pointer to the stack instance, NULL for the default instance.
+ *
+ * @return    Count of stored logs, 0 if the stack is not initialized.
+ */
+uint16_t GPTP_ErrLogCountGetInst(gptp_def_data_t *prGptp)
+{
+    gptp_def_data_t *prGptpPrev;
+    uint16_t u16Count;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    u16Count = 0u;
+
+    if (true == prGptp->bGptpInitialized)
+    {
+        u16Count = GPTP_ERR_LogCountGet();
+    }
+
+    prGptpBound = prGptpPrev;
+
+    return u16Count;
+}
+
+/*!
+ *
+ * @brief       This function returns count of logs stored in the error log of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @return    Count of stored logs, 0 if the stack is not initialized.
+ */
+uint16_t GPTP_ErrLogCountGet(void)
+{
+    return GPTP_ErrLogCountGetInst(prGptpBound);
+}
+
+/*!
+ *
+ * @brief     This function enables or disables coalescing of the repeated error.
+ *
+ * @details   Repeated error of the enabled type from the same port and domain
+ *            updates the latest log of the type (last occurence time, count)
+ *            instead of evicting older logs.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in] eError Error type.
+ * @param[in] bEnable Coalescing enabled - flag.
+ * @return    GPTP_ERR_OK or GPTP_ERR_E_ILLEGAL_ERR_TYPE.
+ */
+gptp_err_type_t GPTP_ErrCoalesceSetInst(gptp_def_data_t *prGptp,
+                                        gptp_err_type_t eError,
+                                        bool bEnable)
+{
+    gptp_def_data_t *prGptpPrev;
+    gptp_err_type_t eErr;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    (void)GPTP_InstanceBind(prGptp);
+
+    eErr = GPTP_ERR_CoalesceSet(eError, bEnable);
+
+    prGptpBound = prGptpPrev;
+
+    return eErr;
+}
+
+/*!
+ *
+ * @brief       This function enables or disables coalescing of the repeated error of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[in] eError Error type.
+ * @param[in] bEnable Coalescing enabled - flag.
+ * @return    GPTP_ERR_OK or GPTP_ERR_E_ILLEGAL_ERR_TYPE.
+ */
+gptp_err_type_t GPTP_ErrCoalesceSet(gptp_err_type_t eError,
+                                    bool bEnable)
+{
+    return GPTP_ErrCoalesceSetInst(prGptpBound, eError, bEnable);
+}
+
+/*!
+ *
+ * @brief       This function gets current sync ingerval from the specified domain/sync machine
+ *
+ * @details     The function provides current sync interval of the respective sync machine,
+ *              for both - Master sync machines and Slave sync machines.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u8Domain Domain number on which the sync interval is updated.
+ * @param[in]   u8Machine Sync machine index on which the sync interval is updated.
+ * @param[out]  s8SyncInterval Pointer to sync interval variable.
+ *
+ * @return      gPTP error code.
+ *
+ * @ requirements 529199
+ * @ requirements 529207
+ */
+gptp_err_type_t GPTP_SyncIntervalGetInst(gptp_def_data_t *prGptp,
+                                         uint8_t u8Domain,
+                                         uint8_t u8Machine,
+                                         int8_t *s8SyncInterval)
+{
+    gptp_def_data_t             *prGptpPrev;
+    const gptp_def_domain_t     *prDomain;
+    gptp_err_type_t             eError;
+    uint8_t                     u8DomainNum;
+    bool                        bDomainFound;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    eError = GPTP_ERR_OK;
+
+    /* If the gPTP is initialized */
+    if (true == prGptp->bGptpInitialized)
+    {
+        /* Search for domain number */
+        bDomainFound = GPTP_INTERNAL_DomainLookup(prGptp, u8Domain, &u8DomainNum);
 
         /* If domain number found */
         if (true == bDomainFound)
         {
-            prDomain = &rGptpDataStruct.prPerDomainParams[u8DomainNum];
+            prDomain = &prGptp->prPerDomainParams[u8DomainNum];
             /* Check if machine ID is valid (lower than max number of sync machines under the domain) */
             if (u8Machine < prDomain->u8NumberOfSyncsPerDom)
             {
@@ -1567,10 +2169,30 @@ gptp_err_type_t GPTP_SyncIntervalGet(uint8_t u8Domain,
         GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
+    prGptpBound = prGptpPrev;
+
     /* Return error */
     return eError;
 }
 
+/*!
+ *
+ * @brief       This function gets current sync interval of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[in]   u8Domain Domain number on which the sync interval is updated.
+ * @param[in]   u8Machine Sync machine index on which the sync interval is updated.
+ * @param[out]  s8SyncInterval Pointer to sync interval variable.
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_SyncIntervalGet(uint8_t u8Domain,
+                                     uint8_t u8Machine,
+                                     int8_t *s8SyncInterval)
+{
+    return GPTP_SyncIntervalGetInst(prGptpBound, u8Domain, u8Machine, s8SyncInterval);
+}
+
 /*!
  *
  * @brief     This function sets sync interval for the specified domain/sync machine
@@ -1579,6 +2201,7 @@ gptp_err_type_t GPTP_SyncIntervalGet(uint8_t u8Domain,
  *            sync machine, the API transmits signaling message with sync interval update
  *            request.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in] u8Domain Domain number on which the sync interval is updated.
  * @param[in] u8Machine Sync machine index on which the sync interval is updated.
  * @param[in] s8SyncInterval New sync interval.
@@ -1588,38 +2211,33 @@ gptp_err_type_t GPTP_SyncIntervalGet(uint8_t u8Domain,
  * @ requirements 529199
  * @ requirements 529208
  */
-gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
-                                     uint8_t u8Machine,
-                                     int8_t s8SyncInterval)
+gptp_err_type_t GPTP_SyncIntervalSetInst(gptp_def_data_t *prGptp,
+                                         uint8_t u8Domain,
+                                         uint8_t u8Machine,
+                                         int8_t s8SyncInterval)
 {
+    gptp_def_data_t             *prGptpPrev;
     const gptp_def_domain_t     *prDomain;
     gptp_err_type_t             eError;
     uint8_t                     u8DomainNum;
-    uint8_t                     u8DomainSeek;
     bool                        bDomainFound;
 
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
     eError = GPTP_ERR_OK;
 
     /* If the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
-        bDomainFound = false;
-
         /* Search for domain number */
-        for (u8DomainSeek = 0u; u8DomainSeek < rGptpDataStruct.rPerDeviceParams.u8NumberOfDomains; u8DomainSeek++)
-        {
-            prDomain = &rGptpDataStruct.prPerDomainParams[u8DomainSeek];
-            if (u8Domain == prDomain->u8DomainNumber)
-            {
-                bDomainFound = true;
-                u8DomainNum = u8Domain;
-            }
-        }
+        bDomainFound = GPTP_INTERNAL_DomainLookup(prGptp, u8Domain, &u8DomainNum);
 
         /* If domain number found */
         if (true == bDomainFound)
         {
-            prDomain = &rGptpDataStruct.prPerDomainParams[u8DomainNum];
+            prDomain = &prGptp->prPerDomainParams[u8DomainNum];
             /* Check if machine ID is valid (lower than max number of sync machines under the domain) */
             if (u8Machine < prDomain->u8NumberOfSyncsPerDom)
             {
@@ -1631,12 +2249,14 @@ gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
                 {
                     /* Update sync interval for the defined domain / machine */
                     prDomain->prSyncMachines[u8Machine].s8SyncIntervalLog = s8SyncInterval;
+                    /* Check the sync due again with the updated interval */
+                    GPTP_TIMER_TimerArm(&prDomain->prSyncMachines[u8Machine].rTimerSyncSend, prDomain->prSyncMachines[u8Machine].u64TimerSyncSendDue);
                 }
                 /* Slave machine */
                 else
                 {
                     /* Transmit signaling message to the upstream Master port, requesting sync interval update */
-                    GPTP_SIGNALING_SendSignaling(&rGptpDataStruct, u8DomainNum, s8SyncInterval);
+                    GPTP_SIGNALING_SendSignaling(prGptp, u8DomainNum, s8SyncInterval);
                 }
             }
             else
@@ -1661,10 +2281,30 @@ gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
         GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
+    prGptpBound = prGptpPrev;
+
     /* Return error */
     return eError;
 }
 
+/*!
+ *
+ * @brief       This function sets sync interval of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[in] u8Domain Domain number on which the sync interval is updated.
+ * @param[in] u8Machine Sync machine index on which the sync interval is updated.
+ * @param[in] s8SyncInterval New sync interval.
+ * @return    gPTP error code.
+ */
+gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
+                                     uint8_t u8Machine,
+                                     int8_t s8SyncInterval)
+{
+    return GPTP_SyncIntervalSetInst(prGptpBound, u8Domain, u8Machine, s8SyncInterval);
+}
+
 /*!
  *
  * @brief       This function provides current offset to GM
@@ -1672,6 +2312,7 @@ gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
  * @details     The function provides current offset of the local clock to the Grand Master.
  *              If the local clock is not updated after startup, the retur value is 0x0x7FFFFFFF.
  *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[Out]  rOffset Pointer to the Timestamp value of current GM offset.
  *
  * @return      gPTP error code.
@@ -1679,19 +2320,25 @@ gptp_err_type_t GPTP_SyncIntervalSet(uint8_t u8Domain,
  * @ requirements 529199
  * @ requirements 529209
  */
-gptp_err_type_t GPTP_CurrentOffsetGet(gptp_def_timestamp_sig_t *rOffset)
+gptp_err_type_t GPTP_CurrentOffsetGetInst(gptp_def_data_t *prGptp,
+                                          gptp_def_timestamp_sig_t *rOffset)
 {
+    gptp_def_data_t             *prGptpPrev;
     gptp_err_type_t             eError;
 
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
     eError = GPTP_ERR_OK;
 
     /* If the gPTP is initialized */
-    if (true == rGptpDataStruct.bGptpInitialized)
+    if (true == prGptp->bGptpInitialized)
     {
-        if ((true == rGptpDataStruct.rPerDeviceParams.bEverUpdated) && 
-            (true == rGptpDataStruct.rPerDeviceParams.bEstimGmOffsetCalculated))
+        if ((true == prGptp->rPerDeviceParams.bEverUpdated) && 
+            (true == prGptp->rPerDeviceParams.bEstimGmOffsetCalculated))
         {
-            *rOffset = rGptpDataStruct.rPerDeviceParams.rEstimGmOffset;
+            *rOffset = prGptp->rPerDeviceParams.rEstimGmOffset;
         }
         else
         {
@@ -1707,20 +2354,186 @@ gptp_err_type_t GPTP_CurrentOffsetGet(gptp_def_timestamp_sig_t *rOffset)
         GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
+    prGptpBound = prGptpPrev;
+
     /* Return error */
     return eError;
 }
 
+/*!
+ *
+ * @brief       This function returns the current GM offset of the default instance.
+ *
+ * @param[Out]  rOffset Pointer to the Timestamp value of current GM offset.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_CurrentOffsetGet(gptp_def_timestamp_sig_t *rOffset)
+{
+    return GPTP_CurrentOffsetGetInst(&rGptpDataStruct, rOffset);
+}
+
+/*!
+ *
+ * @brief       This function provides the holdover status of the local clock
+ *
+ * @details     The function provides the frequency model of the local clock and the
+ *              estimated bound of the time error accumulated in the holdover.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[out]  prInfo Pointer to the holdover status.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_HoldoverInfoGetInst(gptp_def_data_t *prGptp,
+                                         gptp_def_holdover_info_t *prInfo)
+{
+    gptp_def_data_t             *prGptpPrev;
+    gptp_err_type_t             eError;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    eError = GPTP_ERR_OK;
+
+    /* If the gPTP is initialized */
+    if (true == prGptp->bGptpInitialized)
+    {
+        GPTP_HOLD_InfoGet(&prGptp->rPerDeviceParams.rHoldover,
+                          GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING)), prInfo);
+    }
+
+    else
+    {
+        /* Stack not initialized */
+        eError = GPTP_ERR_I_NOT_INITIALIZED;
+        GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+    }
+
+    prGptpBound = prGptpPrev;
+
+    /* Return error */
+    return eError;
+}
+
+/*!
+ *
+ * @brief       This function provides the holdover status of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[out]  prInfo Pointer to the holdover status.
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_HoldoverInfoGet(gptp_def_holdover_info_t *prInfo)
+{
+    return GPTP_HoldoverInfoGetInst(prGptpBound, prInfo);
+}
+
+/*!
+ *
+ * @brief       This function delivers the value of the asynchronous NVM read
+ *
+ * @details     The function completes the read requested by the pfNvmReadReqCB
+ *              callback. It is to be called from the same context as
+ *              GPTP_TimerPeriodic, not from within the request callback.
+ *              Completion without a pending request is ignored.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u8PdelayMachine Pdelay machine index passed to the request callback.
+ * @param[in]   eNvmDataType NVM data type passed to the request callback.
+ * @param[in]   f64Value Value read from the NVM.
+ * @param[in]   bReadOk false if the NVM read failed, the value is ignored then.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_NvmReadDoneInst(gptp_def_data_t *prGptp,
+                                     uint8_t u8PdelayMachine,
+                                     gptp_def_nvm_data_t eNvmDataType,
+                                     float64_t f64Value,
+                                     bool bReadOk)
+{
+    gptp_def_data_t             *prGptpPrev;
+    gptp_err_type_t             eError;
+    float64_t                   f64Read;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    eError = GPTP_ERR_OK;
+
+    /* If the gPTP is initialized */
+    if (true == prGptp->bGptpInitialized)
+    {
+        /* Check if machine ID is valid (lower than number of Pdelay machines) */
+        if (u8PdelayMachine < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines)
+        {
+            f64Read = f64Value;
+            if (false == bReadOk)
+            {
+                /* Assign NaN value. */
+                f64Read = ((float64_t)0.0f / (float64_t)0.0f);
+                GPTP_ERR_Register(u8PdelayMachine, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_N_UNABLE_NVM_READ, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+            }
+
+            GPTP_PDELAY_NvmReadDone(prGptp, &prGptp->prPdelayMachines[u8PdelayMachine], eNvmDataType, f64Read);
+        }
+        else
+        {
+            /* In case of invalid Pdelay machine ID, report error */
+            eError = GPTP_ERR_API_ILLEGAL_MACHINE_ID;
+            GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_API_ILLEGAL_MACHINE_ID, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+    }
+
+    else
+    {
+        /* Stack not initialized */
+        eError = GPTP_ERR_I_NOT_INITIALIZED;
+        GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_I_NOT_INITIALIZED, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+    }
+
+    prGptpBound = prGptpPrev;
+
+    /* Return error */
+    return eError;
+}
+
+/*!
+ *
+ * @brief       This function delivers the value of the asynchronous NVM read
+ *              to the default instance.
+ *
+ * @param[in]   u8PdelayMachine Pdelay machine index passed to the request callback.
+ * @param[in]   eNvmDataType NVM data type passed to the request callback.
+ * @param[in]   f64Value Value read from the NVM.
+ * @param[in]   bReadOk false if the NVM read failed, the value is ignored then.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_NvmReadDone(uint8_t u8PdelayMachine,
+                                 gptp_def_nvm_data_t eNvmDataType,
+                                 float64_t f64Value,
+                                 bool bReadOk)
+{
+    return GPTP_NvmReadDoneInst(&rGptpDataStruct, u8PdelayMachine, eNvmDataType, f64Value, bReadOk);
+}
+
 /*!
  *
  * @brief      Get pointer to the main structure holding gPTP states and configuration.
  *
+ * @details    Within an API call, the instance being processed is returned,
+ *             otherwise the default instance.
+ *
  * @return      Pointer to the main gPTP structure.
  *
  */
 gptp_def_data_t* GPTP_GetMainStrPtr(void)
 {
-    return &rGptpDataStruct;
+    return prGptpBound;
 }
 
 #ifdef GPTP_COUNTERS
@@ -1730,6 +2543,7 @@ gptp_def_data_t* GPTP_GetMainStrPtr(void)
  *
  * @details     The function reads the value of respective gPTP counter.
  *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
  * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port counter value.
  * @param[in]   u8Port Port number.
  * @param[in]   rCntr gPTP Counter.
@@ -1739,17 +2553,23 @@ gptp_def_data_t* GPTP_GetMainStrPtr(void)
  *
  * @ requirements 529199
  */
-gptp_err_type_t GPTP_GetStatsValue(uint16_t u16Domain,
-                                   uint8_t u8Port,
-                                   gptp_def_counters_t rCntr,
-                                   uint32_t *u32Value)
+gptp_err_type_t GPTP_GetStatsValueInst(gptp_def_data_t *prGptp,
+                                       uint16_t u16Domain,
+                                       uint8_t u8Port,
+                                       gptp_def_counters_t rCntr,
+                                       uint32_t *u32Value)
 {
+    gptp_def_data_t *prGptpPrev;
     gptp_err_type_t eErr;
 
-    if (true == rGptpDataStruct.bGptpInitialized)
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    if (true == prGptp->bGptpInitialized)
     {
         /* If the stack is initialized */
-        eErr = GPTP_INTERNAL_GetStatsValue(&rGptpDataStruct, u16Domain, u8Port, rCntr, u32Value);
+        eErr = GPTP_INTERNAL_GetStatsValue(prGptp, u16Domain, u8Port, rCntr, u32Value);
     }
 
     else
@@ -1757,28 +2577,58 @@ gptp_err_type_t GPTP_GetStatsValue(uint16_t u16Domain,
         /* Stack not initialized */
         eErr = GPTP_ERR_I_NOT_INITIALIZED;
     }
+
+    prGptpBound = prGptpPrev;
+
     return eErr;
 }
 
+/*!
+ *
+ * @brief       This function gets value of the gPTP counter of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port counter value.
+ * @param[in]   u8Port Port number.
+ * @param[in]   rCntr gPTP Counter.
+ * @param[out]  u32Value Pointer to the uint32_t value providing counter value.
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_GetStatsValue(uint16_t u16Domain,
+                                   uint8_t u8Port,
+                                   gptp_def_counters_t rCntr,
+                                   uint32_t *u32Value)
+{
+    return GPTP_GetStatsValueInst(prGptpBound, u16Domain, u8Port, rCntr, u32Value);
+}
+
 /*!
  *
  * @brief       This function clears all gPTP counters
  *
  * @details     The function clears gPTP counters. Domain and Port counters.
  *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ *
  * @return      gPTP error code.
  *
  * @ requirements 529199
  */
-gptp_err_type_t GPTP_ClearStats(void)
+gptp_err_type_t GPTP_ClearStatsInst(gptp_def_data_t *prGptp)
 {
+    gptp_def_data_t     *prGptpPrev;
     gptp_err_type_t     eErr;
 
-    if (true == rGptpDataStruct.bGptpInitialized)
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    if (true == prGptp->bGptpInitialized)
     {
         /* If the stack is initialized */
         eErr = GPTP_ERR_OK;
-        GPTP_INTERNAL_ClearStats(&rGptpDataStruct);
+        GPTP_INTERNAL_ClearStats(prGptp);
 
         GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_INFO, ("gptp: gPTP stats (counters) cleared. \n"));
     }
@@ -1789,9 +2639,148 @@ gptp_err_type_t GPTP_ClearStats(void)
         eErr = GPTP_ERR_I_NOT_INITIALIZED;
     }
 
+    prGptpBound = prGptpPrev;
+
+    return eErr;
+}
+
+/*!
+ *
+ * @brief       This function clears all gPTP counters of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_ClearStats(void)
+{
+    return GPTP_ClearStatsInst(prGptpBound);
+}
+
+/*!
+ *
+ * @brief       This function gets the gPTP latency histogram.
+ *
+ * @details     The function copies the respective latency histogram. Port histograms
+ *              are read with the domain 0xFFFF, the Sync residence time histogram
+ *              is read by the domain number and the sync machine of the domain.
+ *
+ * @param[in]   prGptp Pointer to the stack instance, NULL for the default instance.
+ * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port histogram.
+ * @param[in]   u8Port Port number, or sync machine for the domain histogram.
+ * @param[in]   eHist gPTP latency histogram.
+ * @param[out]  prHist Pointer to the histogram copy.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_GetHistogramInst(gptp_def_data_t *prGptp,
+                                      uint16_t u16Domain,
+                                      uint8_t u8Port,
+                                      gptp_def_hist_id_t eHist,
+                                      gptp_def_histogram_t *prHist)
+{
+    gptp_def_data_t *prGptpPrev;
+    gptp_err_type_t eErr;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    if (true != prGptp->bGptpInitialized)
+    {
+        /* Stack not initialized */
+        eErr = GPTP_ERR_I_NOT_INITIALIZED;
+    }
+
+    else if (NULL == prHist)
+    {
+        eErr = GPTP_ERR_F_NULL_PTR;
+        GPTP_ERR_Register(u8Port, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_F_NULL_PTR, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+    }
+
+    else
+    {
+        eErr = GPTP_INTERNAL_GetHistogram(prGptp, u16Domain, u8Port, eHist, prHist);
+    }
+
+    prGptpBound = prGptpPrev;
+
     return eErr;
 }
 
+/*!
+ *
+ * @brief       This function gets the gPTP latency histogram of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @param[in]   u16Domain Domain number (uint16). Value 0xFFFF reads port histogram.
+ * @param[in]   u8Port Port number, or sync machine for the domain histogram.
+ * @param[in]   eHist gPTP latency histogram.
+ * @param[out]  prHist Pointer to the histogram copy.
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_GetHistogram(uint16_t u16Domain,
+                                  uint8_t u8Port,
+                                  gptp_def_hist_id_t eHist,
+                                  gptp_def_histogram_t *prHist)
+{
+    return GPTP_GetHistogramInst(prGptpBound, u16Domain, u8Port, eHist, prHist);
+}
+
+/*!
+ *
+ * @brief       This function clears all gPTP latency histograms
+ *
+ * @details     The function clears port and domain latency histograms, the
+ *              counters are not affected.
+ *
+ * @param[in,out] prGptp Pointer to the stack instance, NULL for the default instance.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_ClearHistogramsInst(gptp_def_data_t *prGptp)
+{
+    gptp_def_data_t     *prGptpPrev;
+    gptp_err_type_t     eErr;
+
+    /* Bind the instance for the port layer and the context-free API */
+    prGptpPrev = prGptpBound;
+    prGptp = GPTP_InstanceBind(prGptp);
+
+    if (true == prGptp->bGptpInitialized)
+    {
+        /* If the stack is initialized */
+        eErr = GPTP_ERR_OK;
+        GPTP_INTERNAL_ClearHistograms(prGptp);
+
+        GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_INFO, ("gptp: gPTP latency histograms cleared. \n"));
+    }
+
+    else
+    {
+        /* Stack not initialized */
+        eErr = GPTP_ERR_I_NOT_INITIALIZED;
+    }
+
+    prGptpBound = prGptpPrev;
+
+    return eErr;
+}
+
+/*!
+ *
+ * @brief       This function clears all gPTP latency histograms of the bound instance.
+ *
+ * @details     The function acts on the bound instance, see GPTP_GptpInitInst.
+ *
+ * @return      gPTP error code.
+ */
+gptp_err_type_t GPTP_ClearHistograms(void)
+{
+    return GPTP_ClearHistogramsInst(prGptpBound);
+}
+
 #endif /* GPTP_COUNTERS */
 /*******************************************************************************
  * EOF
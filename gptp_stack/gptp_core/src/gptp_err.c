@@ -17,34 +17,45 @@
 
 #include "gptp_def.h"
 #include "gptp_err.h"
+#include "gptp.h"
 #include "gptp_port.h"
 #include "gptp_internal.h"
 
-#ifdef GPTP_USE_PRINTF
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+#ifdef GPTP_USE_PRINTF
 #define GPTP_ERR_DBG_MSG_MAX_LEN         80u
 
 #endif /*GPTP_USE_PRINTF*/
+/*! No log of the error type stored */
+#define GPTP_ERR_SLOT_NONE               0xFFFFu
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
-static gptp_err_error_t         rErrorLog[GPTP_ERR_LOG_LENGTH];
-static gptp_err_notify_t        pfErrorNotify = NULL;
-
 #ifdef GPTP_USE_PRINTF
 static char aas8GptpErrDescription[GPTP_ERR_NUMBER_OF_ERRS][GPTP_ERR_DBG_MSG_MAX_LEN];
+#endif /*GPTP_USE_PRINTF*/
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
+#ifdef GPTP_USE_PRINTF
 static void GPTP_ERR_MsgCopy(char cDest[GPTP_ERR_DBG_MSG_MAX_LEN], const char cSource[GPTP_ERR_DBG_MSG_MAX_LEN]);
+#endif /*GPTP_USE_PRINTF*/
+
+static void GPTP_ERR_EntryClear(gptp_err_error_t *prEntry,
+                                gptp_err_type_t eError);
+
+static gptp_def_err_log_t *GPTP_ERR_LogGet(void);
+
+static gptp_err_error_t GPTP_ERR_ReadSlot(uint16_t u16Slot);
 
 /*******************************************************************************
  * Local Functions
  ******************************************************************************/
+#ifdef GPTP_USE_PRINTF
 /*!
  * @brief The function copies debug messages.
  *
@@ -62,6 +73,57 @@ static void GPTP_ERR_MsgCopy(char cDest[GPTP_ERR_DBG_MSG_MAX_LEN], const char cS
 }
 #endif /*GPTP_USE_PRINTF*/
 
+/*!
+ * @brief The function clears error log entry.
+ *
+ * @param[out] Pointer to the log entry.
+ * @param[in]  Error type to be filled in.
+ */
+static void GPTP_ERR_EntryClear(gptp_err_error_t *prEntry,
+                                gptp_err_type_t eError)
+{
+    prEntry->eErrorType = eError;
+    prEntry->u8RespGptpPortIndex = (uint8_t)0xFFu;
+    prEntry->u8RespGptpDomainIndex = (uint8_t)0xFFu;
+    prEntry->rLogTime.u64TimeStampS = 0u;
+    prEntry->rLogTime.u32TimeStampNs = 0u;
+    prEntry->rFirstLogTime.u64TimeStampS = 0u;
+    prEntry->rFirstLogTime.u32TimeStampNs = 0u;
+    prEntry->u16Count = 0u;
+    prEntry->u16RespMsgSeqId = 0u;
+    prEntry->bFreshLog = false;
+}
+
+/*!
+ * @brief The function returns error log of the bound stack instance.
+ *
+ * @return  Pointer to the error log.
+ */
+static gptp_def_err_log_t *GPTP_ERR_LogGet(void)
+{
+    return &GPTP_GetMainStrPtr()->rErrLog;
+}
+
+/*!
+ * @brief The function reads error log slot.
+ *
+ * The function reads the log stored in the slot and clears its fresh flag.
+ *
+ * @param[in] Slot of the circular log.
+ * @return  Error details read from the log.
+ */
+static gptp_err_error_t GPTP_ERR_ReadSlot(uint16_t u16Slot)
+{
+    gptp_def_err_log_t  *prLog;
+    gptp_err_error_t    eError;
+
+    prLog = GPTP_ERR_LogGet();
+    eError = prLog->arLog[u16Slot];
+    prLog->arLog[u16Slot].bFreshLog = false;
+
+    return eError;
+}
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -70,15 +132,14 @@ static void GPTP_ERR_MsgCopy(char cDest[GPTP_ERR_DBG_MSG_MAX_LEN], const char cS
  * @brief The function initializes error management.
  *
  * The function initializes error detail text for console print (if preprocessor 
- * enabled) and initializes error notification callback function pointer.
+ * enabled). The error log and the error notification callback function pointer
+ * are kept by the stack instance.
  *
  * @ requirements 529199
  * @ requirements 536298
  */
-void GPTP_ERR_MgmtInit(const gptp_def_data_t *prGptp)
+void GPTP_ERR_MgmtInit(void)
 {
-    pfErrorNotify = prGptp->rPtpStackCallBacks.pfErrNotify;
-    
 #ifdef GPTP_USE_PRINTF
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_OK], "No error");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_I_NOT_INITIALIZED], "gPTP stack not initialized");
@@ -103,6 +164,7 @@ void GPTP_ERR_MgmtInit(const gptp_def_data_t *prGptp)
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_I_SYNCED_GM_ON_NON_GM], "Initialized Synchronized Grand Master on non Grand Master domain");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_I_DOM_NUM_USED_TWICE], "The same domain number used twice");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_I_DOM_TO_REF_NOT_INIT], "Reference domain for synced GM is not initialized");
+    GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_I_TOO_MANY_PORTS], "Count of gPTP ports exceeds the lookup table size");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_A_DIV_BY_0_ATTEMPT], "Division by zero attempt");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_C_TS_INCORRECT], "Times stamp is incorrect to perform the calculation");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_T_TS_NOT_REGISTERED], "The time stamp is not registered");
@@ -128,11 +190,14 @@ void GPTP_ERR_MgmtInit(const gptp_def_data_t *prGptp)
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_N_UNABLE_NVM_READ], "Unable to read data from NVM");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_N_UNABLE_NVM_WRITE], "Unable to write data to the NVM");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_P_TOO_MANY_LOST_RESPS], "Lost Pdelay responses exceeded count of allowed lost responses");
+    GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_P_RRATIO_OUTLIER], "Pdelay response timestamps far from the estimated neighbor rate ratio");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_PI_INCORRECT_CFG], "Missing or incorrect configuration for PI Controller");
+    GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_PI_KF_INCORRECT_CFG], "Missing or incorrect configuration for Kalman servo");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_S_LOSS_OF_SYNC], "Lost GM, no incoming Sync messages");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_S_MACHINE_STATE], "State machine state error");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_S_INCORRECT_TS], "Incorrect Time stamp for the follow-up message");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_S_RECEIPT_TIMEOUT], "Sync receipt time-out exceeded");
+    GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_S_HOLDOVER_OUT_OF_SPEC], "Estimated holdover time error exceeded the specification");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_L_TOO_LONG_RESIDENCE], "Residence time is too long");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_L_TOO_LONG_TURN_INIT], "Turnaround time is too long on the Pdelay initiator - other side responds late");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_L_TOO_LONG_TURN_RESP], "Turnaround time is too long on the Pdelay responder - the stack responds late");
@@ -147,38 +212,50 @@ void GPTP_ERR_MgmtInit(const gptp_def_data_t *prGptp)
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_V_NULL_PTR], "Pointer to variable is null");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_O_DOMAIN_GM_FAILURE], "Grand Master failure");
     GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_E_READ_INDEX_TOO_HIGH], "Reading of the error log with illegal index");
+    GPTP_ERR_MsgCopy(aas8GptpErrDescription[GPTP_ERR_E_ILLEGAL_ERR_TYPE], "Illegal error type used in error management API call");
 #endif /*GPTP_USE_PRINTF*/
 }
 
 /*!
  * @brief The function clears error log.
  *
- * The function clears error log of the gPTP stack
+ * The function clears error log of the gPTP stack. Coalescing settings
+ * are kept.
  *
  * @ requirements 529199
  * @ requirements 529214
  */
 void GPTP_ERR_LogClear(void)
 {
-    uint16_t u16Sweep;
+    gptp_def_err_log_t  *prLog;
+    uint16_t            u16Sweep;
+
+    prLog = GPTP_ERR_LogGet();
 
     for (u16Sweep = 0u; u16Sweep < GPTP_ERR_LOG_LENGTH; u16Sweep++)
     {
-        rErrorLog[u16Sweep].eErrorType = GPTP_ERR_OK;
-        rErrorLog[u16Sweep].u8RespGptpPortIndex = (uint8_t)0xFFu;
-        rErrorLog[u16Sweep].u8RespGptpDomainIndex = (uint8_t)0xFFu;
-        rErrorLog[u16Sweep].rLogTime.u64TimeStampS = 0u;
-        rErrorLog[u16Sweep].rLogTime.u32TimeStampNs = 0u;
-        rErrorLog[u16Sweep].u16RespMsgSeqId = 0u;
-        rErrorLog[u16Sweep].bFreshLog = false;
+        GPTP_ERR_EntryClear(&prLog->arLog[u16Sweep], GPTP_ERR_OK);
+    }
+
+    for (u16Sweep = 0u; u16Sweep < (uint16_t)GPTP_ERR_NUMBER_OF_ERRS; u16Sweep++)
+    {
+        prLog->au16LastSlot[u16Sweep] = GPTP_ERR_SLOT_NONE;
     }
+
+    prLog->u16Head = 0u;
+    prLog->u16Count = 0u;
 }
 
 /*!
  * @brief The function writes error log.
  *
- * The function writes error into the error log. The fresh log is written to the index 0.
- * Previous logs are shifted towards the end of the log.
+ * The function writes error into the error log. The fresh log is read at the index 0,
+ * previous logs at the higher indexes. The log is circular, the oldest log is
+ * overwritten when the log is full.
+ *
+ * If coalescing is enabled for the error type and the latest log of the same type
+ * comes from the same port and domain, that log is updated (last time, sequence ID,
+ * count) instead of writing a new one, so it keeps its position in the log.
  *
  * @param[in] Port information - on which port the error occurred (if applicable).
  * @param[in] Domain information - on which domain the error occured (if applicable).
@@ -193,18 +270,70 @@ void GPTP_ERR_Register(uint8_t u8Port,
                        gptp_err_type_t eError,
                        uint16_t u16SeqId)
 {
-    uint16_t    u16Sweep;
+    gptp_def_data_t     *prGptp;
+    gptp_def_err_log_t  *prLog;
+    gptp_err_error_t    *prEntry;
+    uint16_t            u16Slot;
+    bool                bCoalesced;
+
+    prGptp = GPTP_GetMainStrPtr();
+    prLog = &prGptp->rErrLog;
+    bCoalesced = false;
+    u16Slot = GPTP_ERR_SLOT_NONE;
+
+    if (GPTP_ERR_NUMBER_OF_ERRS > eError)
+    {
+        u16Slot = prLog->au16LastSlot[(uint16_t)eError];
+
+        /* Coalesce with the latest log of the same error, if it is still stored */
+        if ((0u != (prLog->au32Coalesce[((uint16_t)eError) / 32u] & (1UL << (((uint16_t)eError) % 32u)))) && \
+            (GPTP_ERR_SLOT_NONE != u16Slot))
+        {
+            prEntry = &prLog->arLog[u16Slot];
+            if ((eError == prEntry->eErrorType) && (u8Port == prEntry->u8RespGptpPortIndex) && \
+                (u8Domain == prEntry->u8RespGptpDomainIndex))
+            {
+                bCoalesced = true;
+            }
+        }
+    }
+
+    if (false == bCoalesced)
+    {
+        /* O(1) insertion - move the head over the oldest log */
+        prLog->u16Head = (uint16_t)((prLog->u16Head + 1u) % GPTP_ERR_LOG_LENGTH);
+        if (GPTP_ERR_LOG_LENGTH > prLog->u16Count)
+        {
+            prLog->u16Count++;
+        }
+
+        u16Slot = prLog->u16Head;
+        prEntry = &prLog->arLog[u16Slot];
+        prEntry->eErrorType = eError;
+        prEntry->u8RespGptpPortIndex = u8Port;
+        prEntry->u8RespGptpDomainIndex = u8Domain;
+        prEntry->rLogTime = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_CORRECTED);
+        prEntry->rFirstLogTime = prEntry->rLogTime;
+        prEntry->u16Count = 1u;
 
-    for (u16Sweep = GPTP_ERR_LOG_LENGTH - 1u; u16Sweep >= 1u; u16Sweep--)
+        if (GPTP_ERR_NUMBER_OF_ERRS > eError)
+        {
+            prLog->au16LastSlot[(uint16_t)eError] = u16Slot;
+        }
+    }
+
+    else
     {
-        rErrorLog[u16Sweep] = rErrorLog[(u16Sweep - 1u)];
+        prEntry = &prLog->arLog[u16Slot];
+        prEntry->rLogTime = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_CORRECTED);
+        if (0xFFFFu > prEntry->u16Count)
+        {
+            prEntry->u16Count++;
+        }
     }
-    rErrorLog[0u].eErrorType = eError;
-    rErrorLog[0u].u8RespGptpPortIndex = u8Port;
-    rErrorLog[0u].u8RespGptpDomainIndex = u8Domain;
-    rErrorLog[0u].rLogTime = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_CORRECTED);
-    rErrorLog[0u].u16RespMsgSeqId = u16SeqId;
-    rErrorLog[0u].bFreshLog = true;
+
+    prEntry->u16RespMsgSeqId = u16SeqId;
+    prEntry->bFreshLog = true;
 
 #ifdef GPTP_USE_PRINTF
     GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_ERROR, ("gptp: Error ID %d: %s", eError, aas8GptpErrDescription[(uint16_t) eError]));
@@ -226,12 +355,12 @@ void GPTP_ERR_Register(uint8_t u8Port,
         GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_ERROR, (", Sequence ID: %u", u16SeqId));
     }
     GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_ERROR, (", Time:"));
-    GPTP_PRINTF_TIME_UNSIG(GPTP_DEBUG_MSGTYPE_ERROR, rErrorLog[0u].rLogTime);
+    GPTP_PRINTF_TIME_UNSIG(GPTP_DEBUG_MSGTYPE_ERROR, prEntry->rLogTime);
 #endif
 
-    if (NULL != pfErrorNotify)
+    if (NULL != prGptp->rPtpStackCallBacks.pfErrNotify)
     {
-        pfErrorNotify();
+        prGptp->rPtpStackCallBacks.pfErrNotify();
     }
 }
 
@@ -239,6 +368,7 @@ void GPTP_ERR_Register(uint8_t u8Port,
  * @brief The function reads error log.
  *
  * The function reads error from the error log on the specified index.
+ * Index 0 is the latest log, the index is translated to the circular log slot.
  *
  * @param[in] Error log index which will be read.
  * @return  Error details read from the log.
@@ -252,24 +382,90 @@ gptp_err_error_t GPTP_ERR_ReadIndex(uint16_t u16ErrIndex)
 
     if (GPTP_ERR_LOG_LENGTH > u16ErrIndex)
     {
-        eError = rErrorLog[u16ErrIndex];
-        rErrorLog[u16ErrIndex].bFreshLog = false;
+        eError = GPTP_ERR_ReadSlot((uint16_t)((GPTP_ERR_LogGet()->u16Head + GPTP_ERR_LOG_LENGTH - u16ErrIndex) % GPTP_ERR_LOG_LENGTH));
+    }
+
+    else
+    {
+        GPTP_ERR_EntryClear(&eError, GPTP_ERR_E_READ_INDEX_TOO_HIGH);
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief The function reads error log in chronological order.
+ *
+ * The function reads error from the error log on the specified position,
+ * position 0 is the oldest stored log.
+ *
+ * @param[in] Error log position which will be read.
+ * @return  Error details read from the log.
+ */
+gptp_err_error_t GPTP_ERR_ReadOldest(uint16_t u16ErrPos)
+{
+    gptp_err_error_t    eError;
+    uint16_t            u16Count;
+
+    u16Count = GPTP_ERR_LogGet()->u16Count;
+    if (u16Count > u16ErrPos)
+    {
+        eError = GPTP_ERR_ReadIndex((uint16_t)(u16Count - 1u - u16ErrPos));
     }
 
     else
     {
-        eError.eErrorType = GPTP_ERR_E_READ_INDEX_TOO_HIGH;
-        eError.u8RespGptpPortIndex = (uint8_t)0xFFu;
-        eError.u8RespGptpDomainIndex = (uint8_t)0xFFu;
-        eError.rLogTime.u64TimeStampS = 0u;
-        eError.rLogTime.u32TimeStampNs = 0u;
-        eError.u16RespMsgSeqId = 0u;
-        eError.bFreshLog = false;
+        GPTP_ERR_EntryClear(&eError, GPTP_ERR_E_READ_INDEX_TOO_HIGH);
     }
 
     return eError;
 }
 
+/*!
+ * @brief The function returns count of stored error logs.
+ *
+ * @return  Count of valid logs, GPTP_ERR_LOG_LENGTH at most.
+ */
+uint16_t GPTP_ERR_LogCountGet(void)
+{
+    return GPTP_ERR_LogGet()->u16Count;
+}
+
+/*!
+ * @brief The function enables coalescing of the repeated error.
+ *
+ * @param[in] Error type.
+ * @param[in] Coalescing enabled - flag.
+ * @return  GPTP_ERR_OK or GPTP_ERR_E_ILLEGAL_ERR_TYPE.
+ */
+gptp_err_type_t GPTP_ERR_CoalesceSet(gptp_err_type_t eError,
+                                     bool bEnable)
+{
+    gptp_err_type_t eErr;
+
+    if ((GPTP_ERR_OK != eError) && (GPTP_ERR_NUMBER_OF_ERRS > eError))
+    {
+        if (true == bEnable)
+        {
+            GPTP_ERR_LogGet()->au32Coalesce[((uint16_t)eError) / 32u] |= (1UL << (((uint16_t)eError) % 32u));
+        }
+
+        else
+        {
+            GPTP_ERR_LogGet()->au32Coalesce[((uint16_t)eError) / 32u] &= ~(1UL << (((uint16_t)eError) % 32u));
+        }
+
+        eErr = GPTP_ERR_OK;
+    }
+
+    else
+    {
+        eErr = GPTP_ERR_E_ILLEGAL_ERR_TYPE;
+    }
+
+    return eErr;
+}
+
 /*******************************************************************************
  * EOF
  ******************************************************************************/
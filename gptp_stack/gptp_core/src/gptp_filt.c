@@ -0,0 +1,446 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+#include "gptp_internal.h"
+#include "gptp_filt.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Count of Syncs needed for the quartiles */
+#define FILT_IQR_MIN_SAMPLES            5u
+/* Minimal margin of the outlier fences [ns] */
+#define FILT_IQR_MIN_MARGIN_NS          100
+/* Drift is kept in Q32 */
+#define FILT_DRIFT_Q32_SHIFT            32u
+/* Maximum drift between the clocks in Q32, ~0.4 % */
+#define FILT_DRIFT_MAX_Q32              ((int64_t)1 << 24u)
+/* Maximum difference of the offsets of two Syncs, drift is not estimated over larger steps [ns] */
+#define FILT_STEP_MAX_NS                ((int64_t)1 << 30u)
+/* Maximum time between two Syncs of the window [ns], ~2.1 s */
+#define FILT_GAP_MAX_NS                 ((int64_t)1 << 31u)
+/* Maximum time span of the window [ns], ~68.7 s */
+#define FILT_SPAN_MAX_NS                ((int64_t)1 << 36u)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static int64_t GPTP_FILT_Select(int64_t as64Values[],
+                                uint8_t u8Count,
+                                uint8_t u8Rank);
+static bool GPTP_FILT_PhaseAt(const gptp_def_ofs_filt_t *prFilt,
+                              int64_t s64RxNs,
+                              int32_t s32FreqAdjPpb,
+                              int64_t *ps64PhaseNs);
+static void GPTP_FILT_Drift(gptp_def_ofs_filt_t *prFilt);
+static uint8_t GPTP_FILT_Predict(const gptp_def_ofs_filt_t *prFilt,
+                                 int64_t s64RxRawNs,
+                                 int64_t as64Pred[GPTP_DEF_OFS_FILT_WIN_MAX]);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/*!
+ * @brief The function returns the value of the requested rank, as if the values were sorted.
+ *
+ * @details Quickselect with a three-way partition, linear on average also
+ *          for a window of equal values. The values are reordered, the ones
+ *          before the rank are not greater than the returned value.
+ *
+ * @param[in,out] as64Values Values, reordered.
+ * @param[in] u8Count Count of values, not 0.
+ * @param[in] u8Rank Rank of the value, 0 for the minimum.
+ * @return Value of the rank.
+ */
+static int64_t GPTP_FILT_Select(int64_t as64Values[],
+                                uint8_t u8Count,
+                                uint8_t u8Rank)
+{
+    int64_t s64Pivot;
+    int64_t s64Value;
+    uint8_t u8Low;
+    uint8_t u8High;
+    uint8_t u8Less;
+    uint8_t u8Greater;
+    uint8_t u8Idx;
+
+    u8Low = 0u;
+    u8High = (uint8_t)(u8Count - 1u);
+
+    while (u8Low < u8High)
+    {
+        /* Values below the pivot to the front, above it to the back */
+        s64Pivot = as64Values[u8Low + ((u8High - u8Low) / 2u)];
+        u8Less = u8Low;
+        u8Greater = u8High;
+        u8Idx = u8Low;
+        while (u8Idx <= u8Greater)
+        {
+            s64Value = as64Values[u8Idx];
+            if (s64Value < s64Pivot)
+            {
+                as64Values[u8Idx] = as64Values[u8Less];
+                as64Values[u8Less] = s64Value;
+                u8Less++;
+                u8Idx++;
+            }
+            else if (s64Value > s64Pivot)
+            {
+                as64Values[u8Idx] = as64Values[u8Greater];
+                as64Values[u8Greater] = s64Value;
+                u8Greater--;
+            }
+            else
+            {
+                u8Idx++;
+            }
+        }
+
+        if (u8Rank < u8Less)
+        {
+            u8High = (uint8_t)(u8Less - 1u);
+        }
+        else if (u8Rank > u8Greater)
+        {
+            u8Low = (uint8_t)(u8Greater + 1u);
+        }
+        else
+        {
+            /* The rank is among the values equal to the pivot */
+            u8Low = u8Rank;
+            u8High = u8Rank;
+        }
+    }
+
+    return as64Values[u8Rank];
+}
+
+/*!
+ * @brief The function integrates the frequency correction since the newest Sync.
+ *
+ * @param[in] prFilt Pointer to the filter window.
+ * @param[in] s64RxNs Sync receipt time on the local clock [ns].
+ * @param[in] s32FreqAdjPpb Frequency correction since the newest Sync [ppb].
+ * @param[out] ps64PhaseNs Corrected minus uncorrected local time at s64RxNs [ns].
+ * @return true if the Sync continues the window, false otherwise.
+ */
+static bool GPTP_FILT_PhaseAt(const gptp_def_ofs_filt_t *prFilt,
+                              int64_t s64RxNs,
+                              int32_t s32FreqAdjPpb,
+                              int64_t *ps64PhaseNs)
+{
+    int64_t s64Elapsed;
+    uint8_t u8Newest;
+    bool    bContinues;
+
+    bContinues = false;
+
+    if (0u != prFilt->u8Count)
+    {
+        u8Newest = (uint8_t)((prFilt->u8Head + prFilt->u8Count - 1u) % GPTP_DEF_OFS_FILT_WIN_MAX);
+        s64Elapsed = s64RxNs - (prFilt->as64RxRawNs[u8Newest] + prFilt->s64PhaseNs);
+        if ((0 < s64Elapsed) && (FILT_GAP_MAX_NS > s64Elapsed))
+        {
+            *ps64PhaseNs = prFilt->s64PhaseNs + (((int64_t)s32FreqAdjPpb * s64Elapsed) / (int64_t)GPTP_DEF_NS_IN_SECONDS);
+            bContinues = true;
+        }
+    }
+
+    return bContinues;
+}
+
+/*!
+ * @brief The function updates the drift of the window.
+ *
+ * @details The drift is the median of the drifts between all pairs of Syncs
+ *          in the window (Theil-Sen), pairs far apart dilute the delay of a Sync.
+ *          It is calculated once per added Sync and shared by the output and
+ *          the outlier fences of the next Sync.
+ *
+ * @param[in,out] prFilt Pointer to the filter window.
+ */
+static void GPTP_FILT_Drift(gptp_def_ofs_filt_t *prFilt)
+{
+    int64_t as64Drift[(GPTP_DEF_OFS_FILT_WIN_MAX * (GPTP_DEF_OFS_FILT_WIN_MAX - 1u)) / 2u];
+    int64_t s64DriftQ32;
+    int64_t s64Step;
+    int64_t s64Elapsed;
+    uint8_t u8Drifts;
+    uint8_t u8Idx;
+    uint8_t u8Cur;
+    uint8_t u8Next;
+    uint8_t u8Pair;
+
+    u8Drifts = 0u;
+    for (u8Idx = 0u; u8Idx < prFilt->u8Count; u8Idx++)
+    {
+        u8Cur = (uint8_t)((prFilt->u8Head + u8Idx) % GPTP_DEF_OFS_FILT_WIN_MAX);
+        for (u8Pair = (uint8_t)(u8Idx + 1u); u8Pair < prFilt->u8Count; u8Pair++)
+        {
+            u8Next = (uint8_t)((prFilt->u8Head + u8Pair) % GPTP_DEF_OFS_FILT_WIN_MAX);
+            s64Step = prFilt->as64RawOffsetNs[u8Next] - prFilt->as64RawOffsetNs[u8Cur];
+            s64Elapsed = prFilt->as64RxRawNs[u8Next] - prFilt->as64RxRawNs[u8Cur];
+            if ((FILT_STEP_MAX_NS > (int64_t)GPTP_INTERNAL_AbsInt64ToUint64(s64Step)) && (0 < s64Elapsed))
+            {
+                as64Drift[u8Drifts] = (s64Step * ((int64_t)1 << FILT_DRIFT_Q32_SHIFT)) / s64Elapsed;
+                u8Drifts++;
+            }
+        }
+    }
+
+    s64DriftQ32 = 0;
+    if (0u != u8Drifts)
+    {
+        s64DriftQ32 = GPTP_FILT_Select(as64Drift, u8Drifts, (uint8_t)(u8Drifts / 2u));
+        if (FILT_DRIFT_MAX_Q32 < (int64_t)GPTP_INTERNAL_AbsInt64ToUint64(s64DriftQ32))
+        {
+            /* Out of any oscillator tolerance, the Syncs are not moved */
+            s64DriftQ32 = 0;
+        }
+    }
+
+    prFilt->s64DriftQ32 = s64DriftQ32;
+}
+
+/*!
+ * @brief The function moves every Sync of the window to the requested time
+ *        along the drift of the window.
+ *
+ * @param[in] prFilt Pointer to the filter window.
+ * @param[in] s64RxRawNs Time on the uncorrected local clock [ns].
+ * @param[out] as64Pred GM minus uncorrected local time at s64RxRawNs, in the window order [ns].
+ * @return Count of Syncs.
+ */
+static uint8_t GPTP_FILT_Predict(const gptp_def_ofs_filt_t *prFilt,
+                                 int64_t s64RxRawNs,
+                                 int64_t as64Pred[GPTP_DEF_OFS_FILT_WIN_MAX])
+{
+    int64_t s64Elapsed;
+    uint8_t u8Idx;
+    uint8_t u8Cur;
+
+    u8Cur = prFilt->u8Head;
+    for (u8Idx = 0u; u8Idx < prFilt->u8Count; u8Idx++)
+    {
+        s64Elapsed = s64RxRawNs - prFilt->as64RxRawNs[u8Cur];
+        as64Pred[u8Idx] = prFilt->as64RawOffsetNs[u8Cur] + ((prFilt->s64DriftQ32 * s64Elapsed) / ((int64_t)1 << FILT_DRIFT_Q32_SHIFT));
+        u8Cur = (uint8_t)((u8Cur + 1u) % GPTP_DEF_OFS_FILT_WIN_MAX);
+    }
+
+    return prFilt->u8Count;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*!
+ * @brief   This function empties the Sync offset filter window.
+ *
+ * @param[out] prFilt Pointer to the filter window (one per domain).
+ */
+void GPTP_FILT_Reset(gptp_def_ofs_filt_t *prFilt)
+{
+    prFilt->u8Head = 0u;
+    prFilt->u8Count = 0u;
+    prFilt->s64PhaseNs = 0;
+    prFilt->s64DriftQ32 = 0;
+}
+
+/*!
+ * @brief   This function adds the Sync to the window, the oldest one is dropped
+ *          when the window is full.
+ *
+ * @details The frequency correction applied since the previous Sync is
+ *          integrated, so the window keeps GM minus uncorrected local time,
+ *          which the servo does not change. The window restarts if the receipt
+ *          time does not advance or the Syncs are too far apart.
+ *
+ * @param[in,out] prFilt Pointer to the filter window.
+ * @param[in] u8Window Count of Syncs in the window.
+ * @param[in] s64RxNs Sync receipt time on the local clock [ns].
+ * @param[in] s64OffsetNs GM minus local time at the Sync receipt [ns].
+ * @param[in] s32FreqAdjPpb Frequency correction of the local clock since the previous Sync [ppb].
+ */
+void GPTP_FILT_Add(gptp_def_ofs_filt_t *prFilt,
+                   uint8_t u8Window,
+                   int64_t s64RxNs,
+                   int64_t s64OffsetNs,
+                   int32_t s32FreqAdjPpb)
+{
+    int64_t s64PhaseNs;
+    int64_t s64RxRawNs;
+    uint8_t u8Newest;
+
+    if ((0u == u8Window) || (GPTP_DEF_OFS_FILT_WIN_MAX < u8Window))
+    {
+        u8Window = GPTP_DEF_OFS_FILT_WIN_MAX;
+    }
+
+    if (false == GPTP_FILT_PhaseAt(prFilt, s64RxNs, s32FreqAdjPpb, &s64PhaseNs))
+    {
+        /* The uncorrected local time starts at the first Sync */
+        GPTP_FILT_Reset(prFilt);
+        s64PhaseNs = 0;
+    }
+
+    s64RxRawNs = s64RxNs - s64PhaseNs;
+
+    /* Drop the oldest Syncs, out of the window length or time span */
+    while ((0u != prFilt->u8Count) && \
+           ((u8Window <= prFilt->u8Count) || (FILT_SPAN_MAX_NS <= (s64RxRawNs - prFilt->as64RxRawNs[prFilt->u8Head]))))
+    {
+        prFilt->u8Head = (uint8_t)((prFilt->u8Head + 1u) % GPTP_DEF_OFS_FILT_WIN_MAX);
+        prFilt->u8Count--;
+    }
+
+    u8Newest = (uint8_t)((prFilt->u8Head + prFilt->u8Count) % GPTP_DEF_OFS_FILT_WIN_MAX);
+    prFilt->as64RxRawNs[u8Newest] = s64RxRawNs;
+    prFilt->as64RawOffsetNs[u8Newest] = s64OffsetNs + s64PhaseNs;
+    prFilt->s64PhaseNs = s64PhaseNs;
+    prFilt->u8Count++;
+
+    GPTP_FILT_Drift(prFilt);
+}
+
+/*!
+ * @brief   This function returns the filtered offset at the newest Sync receipt.
+ *
+ * @details Every Sync of the window is moved to the newest receipt time along
+ *          the median drift of the window, so the filter does not delay the
+ *          servo loop. The median or the least delayed Sync (the maximum of
+ *          GM minus local time, queuing only delays the Sync) is returned,
+ *          the newest Sync for GPTP_DEF_OFS_FILT_NONE.
+ *
+ * @param[in] prFilt Pointer to the filter window.
+ * @param[in] eType Filter type.
+ * @param[out] ps64OffsetNs Filtered GM minus local time [ns].
+ * @return true if the window is not empty, false otherwise.
+ */
+bool GPTP_FILT_Output(const gptp_def_ofs_filt_t *prFilt,
+                      gptp_def_ofs_filt_type_t eType,
+                      int64_t *ps64OffsetNs)
+{
+    int64_t as64Pred[GPTP_DEF_OFS_FILT_WIN_MAX];
+    int64_t s64RawOffsetNs;
+    int64_t s64LowerNs;
+    uint8_t u8Count;
+    uint8_t u8Idx;
+    bool    bValid;
+
+    bValid = false;
+
+    if (0u != prFilt->u8Count)
+    {
+        u8Idx = (uint8_t)((prFilt->u8Head + prFilt->u8Count - 1u) % GPTP_DEF_OFS_FILT_WIN_MAX);
+        u8Count = GPTP_FILT_Predict(prFilt, prFilt->as64RxRawNs[u8Idx], as64Pred);
+
+        switch (eType)
+        {
+            case GPTP_DEF_OFS_FILT_MEDIAN:
+                s64RawOffsetNs = GPTP_FILT_Select(as64Pred, u8Count, (uint8_t)(u8Count / 2u));
+                if (0u == (u8Count & 1u))
+                {
+                    /* The lower middle value is the maximum of the values before the rank */
+                    s64LowerNs = as64Pred[0];
+                    for (u8Idx = 1u; u8Idx < (u8Count / 2u); u8Idx++)
+                    {
+                        if (as64Pred[u8Idx] > s64LowerNs)
+                        {
+                            s64LowerNs = as64Pred[u8Idx];
+                        }
+                    }
+                    s64RawOffsetNs = s64LowerNs + ((s64RawOffsetNs - s64LowerNs) / 2);
+                }
+                break;
+
+            case GPTP_DEF_OFS_FILT_MIN_DELAY:
+                s64RawOffsetNs = as64Pred[0];
+                for (u8Idx = 1u; u8Idx < u8Count; u8Idx++)
+                {
+                    if (as64Pred[u8Idx] > s64RawOffsetNs)
+                    {
+                        s64RawOffsetNs = as64Pred[u8Idx];
+                    }
+                }
+                break;
+
+            default:
+                s64RawOffsetNs = as64Pred[u8Count - 1u];
+                break;
+        }
+
+        *ps64OffsetNs = s64RawOffsetNs - prFilt->s64PhaseNs;
+        bValid = true;
+    }
+
+    return bValid;
+}
+
+/*!
+ * @brief   This function calculates the adaptive outlier fences for the next Sync.
+ *
+ * @details The offset below Q1 - k * IQR or above Q3 + k * IQR is an outlier,
+ *          where Q1 and Q3 are the quartiles of the window moved to the receipt
+ *          time and IQR = Q3 - Q1. The margin k * IQR has a floor, so a window
+ *          of equal offsets does not reject every new one.
+ *
+ * @param[in] prFilt Pointer to the filter window.
+ * @param[in] u8Gain Multiple k of the interquartile range.
+ * @param[in] s64RxNs Sync receipt time on the local clock [ns].
+ * @param[in] s32FreqAdjPpb Frequency correction of the local clock since the previous Sync [ppb].
+ * @param[out] ps64LowNs Lower fence of GM minus local time [ns].
+ * @param[out] ps64HighNs Upper fence of GM minus local time [ns].
+ * @return true if the window holds enough Syncs for the quartiles, false otherwise.
+ */
+bool GPTP_FILT_IqrFences(const gptp_def_ofs_filt_t *prFilt,
+                         uint8_t u8Gain,
+                         int64_t s64RxNs,
+                         int32_t s32FreqAdjPpb,
+                         int64_t *ps64LowNs,
+                         int64_t *ps64HighNs)
+{
+    int64_t as64Pred[GPTP_DEF_OFS_FILT_WIN_MAX];
+    int64_t s64PhaseNs;
+    int64_t s64Q1;
+    int64_t s64Q3;
+    int64_t s64Margin;
+    uint8_t u8Count;
+    bool    bReady;
+
+    bReady = false;
+
+    if ((FILT_IQR_MIN_SAMPLES <= prFilt->u8Count) && \
+        (true == GPTP_FILT_PhaseAt(prFilt, s64RxNs, s32FreqAdjPpb, &s64PhaseNs)))
+    {
+        u8Count = GPTP_FILT_Predict(prFilt, s64RxNs - s64PhaseNs, as64Pred);
+        s64Q1 = GPTP_FILT_Select(as64Pred, u8Count, (uint8_t)(u8Count / 4u));
+        s64Q3 = GPTP_FILT_Select(as64Pred, u8Count, (uint8_t)((3u * (uint32_t)u8Count) / 4u));
+
+        s64Margin = (int64_t)u8Gain * (s64Q3 - s64Q1);
+        if (FILT_IQR_MIN_MARGIN_NS > s64Margin)
+        {
+            s64Margin = FILT_IQR_MIN_MARGIN_NS;
+        }
+
+        *ps64LowNs = (s64Q1 - s64Margin) - s64PhaseNs;
+        *ps64HighNs = (s64Q3 + s64Margin) - s64PhaseNs;
+        bReady = true;
+    }
+
+    return bReady;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
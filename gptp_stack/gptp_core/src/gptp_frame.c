@@ -15,11 +15,13 @@
  *
  */
 
+#include <string.h>
 #include "gptp_def.h"
 #include "gptp_err.h"
 #include "gptp_frame.h"
 #include "gptp_port.h"
 #include "gptp_internal.h"
+#include "gptp_fxp.h"
 
 /*******************************************************************************
  * Prototypes
@@ -60,6 +62,20 @@ static uint64_t GPTP_MD_ArrayToUint48(const uint8_t au8In[6]);
 
 static uint64_t GPTP_MD_ArrayToUint64(const uint8_t au8In[8]);
 
+static uint32_t GPTP_FRAME_CsRateRatio(float64_t f64RateRatio);
+
+static void GPTP_FRAME_FrameBuild(const gptp_def_data_t *prGptp,
+                                  gptp_def_tx_data_t *ptxData,
+                                  const uint8_t u8Domain,
+                                  const uint8_t u8Port);
+
+#ifdef GPTP_TX_TEMPLATES
+static void GPTP_FRAME_TemplatePatch(const gptp_def_data_t *prGptp,
+                                     const gptp_def_tx_data_t *ptxData,
+                                     const uint8_t u8Domain,
+                                     const uint8_t u8Port);
+#endif /* GPTP_TX_TEMPLATES */
+
 /*******************************************************************************
  * Local Functions
  ******************************************************************************/
@@ -98,9 +114,16 @@ static uint8_t GPTP_MD_Uint16ToArray(uint8_t au8Out[2],
                                      uint8_t u8Offset)
 {
     uint8_t OffsetOut;
+#ifdef GPTP_PORT_HTON16
+    uint16_t u16Word;
 
+    /* Single store of the swapped value, memcpy() keeps it safe for any alignment */
+    u16Word = GPTP_PORT_HTON16(u16Input);
+    (void)memcpy(au8Out, &u16Word, sizeof(u16Word));
+#else
     au8Out[0] = (uint8_t)((u16Input >> 8u) & (uint16_t)GPTP_DEF_BIT_MASK_24L_8H);
     au8Out[1] = (uint8_t)((u16Input) & (uint16_t)GPTP_DEF_BIT_MASK_24L_8H);
+#endif /* GPTP_PORT_HTON16 */
 
     /* Increment the offset by 2 */
     OffsetOut = u8Offset + 2u;
@@ -144,11 +167,18 @@ static uint8_t GPTP_MD_Uint32ToArray(uint8_t au8Out[4],
                               uint8_t u8Offset)
 {
     uint8_t OffsetOut;
+#ifdef GPTP_PORT_HTON32
+    uint32_t u32Word;
 
+    /* Single store of the swapped value, memcpy() keeps it safe for any alignment */
+    u32Word = GPTP_PORT_HTON32(u32Input);
+    (void)memcpy(au8Out, &u32Word, sizeof(u32Word));
+#else
     au8Out[0] = (uint8_t)((u32Input >> 24u) & (uint32_t)GPTP_DEF_BIT_MASK_24L_8H);
     au8Out[1] = (uint8_t)((u32Input >> 16u) & (uint32_t)GPTP_DEF_BIT_MASK_24L_8H);
     au8Out[2] = (uint8_t)((u32Input >> 8u) & (uint32_t)GPTP_DEF_BIT_MASK_24L_8H);
     au8Out[3] = (uint8_t)((u32Input) & (uint32_t)GPTP_DEF_BIT_MASK_24L_8H);
+#endif /* GPTP_PORT_HTON32 */
 
     /* Increment the offset by 4 */
     OffsetOut = u8Offset + 4u;
@@ -169,13 +199,23 @@ static uint8_t GPTP_MD_Uint48ToArray(uint8_t au8Out[6],
                                      uint8_t u8Offset)
 {
     uint8_t OffsetOut;
-
+#if defined(GPTP_PORT_HTON16) && defined(GPTP_PORT_HTON32)
+    uint16_t u16Word;
+    uint32_t u32Word;
+
+    /* Upper 16 bits and lower 32 bits stored separately */
+    u16Word = GPTP_PORT_HTON16((uint16_t)(u64Input >> 32u));
+    u32Word = GPTP_PORT_HTON32((uint32_t)u64Input);
+    (void)memcpy(&au8Out[0], &u16Word, sizeof(u16Word));
+    (void)memcpy(&au8Out[2], &u32Word, sizeof(u32Word));
+#else
     au8Out[0] = (uint8_t)((u64Input >> 40u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[1] = (uint8_t)((u64Input >> 32u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[2] = (uint8_t)((u64Input >> 24u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[3] = (uint8_t)((u64Input >> 16u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[4] = (uint8_t)((u64Input >> 8u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[5] = (uint8_t)((u64Input) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
+#endif
 
     /* Increment the offset by 6 */
     OffsetOut = u8Offset + 6u;
@@ -195,7 +235,13 @@ static uint8_t GPTP_MD_Uint64ToArray(uint8_t au8Out[8],
                                      uint8_t u8Offset)
 {
     uint8_t OffsetOut;
+#ifdef GPTP_PORT_HTON64
+    uint64_t u64Word;
 
+    /* Single store of the swapped value, memcpy() keeps it safe for any alignment */
+    u64Word = GPTP_PORT_HTON64(u64Input);
+    (void)memcpy(au8Out, &u64Word, sizeof(u64Word));
+#else
     au8Out[0] = (uint8_t)((u64Input >> 56u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[1] = (uint8_t)((u64Input >> 48u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[2] = (uint8_t)((u64Input >> 40u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
@@ -204,6 +250,7 @@ static uint8_t GPTP_MD_Uint64ToArray(uint8_t au8Out[8],
     au8Out[5] = (uint8_t)((u64Input >> 16u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[6] = (uint8_t)((u64Input >> 8u) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
     au8Out[7] = (uint8_t)((u64Input) & (uint64_t)GPTP_DEF_BIT_MASK_56L_8H);
+#endif /* GPTP_PORT_HTON64 */
 
     /* Increment the offset by 8 */
     OffsetOut = u8Offset + 8u;
@@ -249,9 +296,16 @@ static int8_t GPTP_MD_ArrayToSint8(const uint8_t au8In[1])
 static uint16_t GPTP_MD_ArrayToUint16(const uint8_t au8In[2])
 {
     uint16_t u16Out;
+#ifdef GPTP_PORT_HTON16
+
+    /* Single load of the value, swapped into the host order */
+    (void)memcpy(&u16Out, au8In, sizeof(u16Out));
+    u16Out = GPTP_PORT_HTON16(u16Out);
+#else
 
     u16Out = ((uint16_t)(((uint16_t)au8In[0]) << 8u) | \
                           (uint16_t)au8In[1]);
+#endif /* GPTP_PORT_HTON16 */
 
     return u16Out;
 }
@@ -265,11 +319,18 @@ static uint16_t GPTP_MD_ArrayToUint16(const uint8_t au8In[2])
 static uint32_t GPTP_MD_ArrayToUint32(const uint8_t au8In[4])
 {
     uint32_t u32Out;
+#ifdef GPTP_PORT_HTON32
+
+    /* Single load of the value, swapped into the host order */
+    (void)memcpy(&u32Out, au8In, sizeof(u32Out));
+    u32Out = GPTP_PORT_HTON32(u32Out);
+#else
 
     u32Out = (uint32_t)((((uint32_t)au8In[0]) << 24u) | \
                         (((uint32_t)au8In[1]) << 16u) | \
                         (((uint32_t)au8In[2]) << 8u)  | \
                          ((uint32_t)au8In[3]));
+#endif /* GPTP_PORT_HTON32 */
 
     return u32Out;
 }
@@ -284,6 +345,15 @@ static uint32_t GPTP_MD_ArrayToUint32(const uint8_t au8In[4])
 static uint64_t GPTP_MD_ArrayToUint48(const uint8_t au8In[6])
 {
     uint64_t u48Out;
+#if defined(GPTP_PORT_HTON16) && defined(GPTP_PORT_HTON32)
+    uint16_t u16Word;
+    uint32_t u32Word;
+
+    /* Upper 16 bits and lower 32 bits loaded separately */
+    (void)memcpy(&u16Word, &au8In[0], sizeof(u16Word));
+    (void)memcpy(&u32Word, &au8In[2], sizeof(u32Word));
+    u48Out = ((uint64_t)GPTP_PORT_HTON16(u16Word) << 32u) | (uint64_t)GPTP_PORT_HTON32(u32Word);
+#else
 
     u48Out = (uint64_t)((((uint64_t)au8In[0]) << 40u) | \
                         (((uint64_t)au8In[1]) << 32u) | \
@@ -291,6 +361,7 @@ static uint64_t GPTP_MD_ArrayToUint48(const uint8_t au8In[6])
                         (((uint64_t)au8In[3]) << 16u) | \
                         (((uint64_t)au8In[4]) << 8u)  | \
                          ((uint64_t)au8In[5]));
+#endif
 
     return u48Out;
 }
@@ -304,6 +375,12 @@ static uint64_t GPTP_MD_ArrayToUint48(const uint8_t au8In[6])
 static uint64_t GPTP_MD_ArrayToUint64(const uint8_t au8In[8])
 {
     uint64_t u64Out;
+#ifdef GPTP_PORT_HTON64
+
+    /* Single load of the value, swapped into the host order */
+    (void)memcpy(&u64Out, au8In, sizeof(u64Out));
+    u64Out = GPTP_PORT_HTON64(u64Out);
+#else
 
     u64Out = (uint64_t)((((uint64_t)au8In[0]) << 56u) | \
                         (((uint64_t)au8In[1]) << 48u) | \
@@ -313,13 +390,112 @@ static uint64_t GPTP_MD_ArrayToUint64(const uint8_t au8In[8])
                         (((uint64_t)au8In[5]) << 16u) | \
                         (((uint64_t)au8In[6]) << 8u)  | \
                          ((uint64_t)au8In[7]));
+#endif /* GPTP_PORT_HTON64 */
 
     return u64Out;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : GPTP_FRAME_CsRateRatio
+ * Description   : The function converts the rate ratio into the cumulative
+ *                 scaled rate offset of the Follow up TLV.
+ *
+ *END**************************************************************************/
+static uint32_t GPTP_FRAME_CsRateRatio(float64_t f64RateRatio)
+{
+#ifdef GPTP_FIXED_POINT
+    return (uint32_t)((int32_t)((GPTP_FXP_Float64ToQ32(f64RateRatio) - GPTP_FXP_Q32_ONE) * GPTP_FXP_CS_RATE_SCALE));
+#else
+    float64_t f64Temp;
+
+    f64Temp = (f64RateRatio - 1.0) * (float64_t)GPTP_DEF_POW_2_41;
+
+    return (uint32_t)((int32_t)f64Temp);
+#endif /* GPTP_FIXED_POINT */
+}
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
+/*!
+ * @brief The function decodes the PTP common header.
+ *
+ * All fields of the 34 byte header are read in one pass.
+ *
+ * @param[in] cpu8Hdr Pointer to the first byte of the PTP header, no alignment required
+ * @param[out] prHdr Decoded header
+ */
+void GPTP_FRAME_HdrDecode(const uint8_t *cpu8Hdr,
+                          gptp_frame_hdr_t *prHdr)
+{
+    uint32_t u32Word;
+
+    /* Transport specific, message type, version and message length */
+    u32Word = GPTP_MD_ArrayToUint32(&cpu8Hdr[GPTP_FR_MSG_ID_OFFSET]);
+    prHdr->u8MsgIdTs = (uint8_t)(u32Word >> 24u);
+    prHdr->u8Version = (uint8_t)((u32Word >> 16u) & (uint32_t)GPTP_DEF_BIT_MASK_24L_8H);
+    prHdr->u16MsgLength = (uint16_t)(u32Word & (uint32_t)GPTP_DEF_BIT_MASK_48L_16H);
+
+    /* Domain number, reserved and flags */
+    u32Word = GPTP_MD_ArrayToUint32(&cpu8Hdr[GPTP_FR_DOMAIN_NUM]);
+    prHdr->u8DomainNum = (uint8_t)(u32Word >> 24u);
+    prHdr->u16Flags = (uint16_t)(u32Word & (uint32_t)GPTP_DEF_BIT_MASK_48L_16H);
+
+    prHdr->u64Correction = GPTP_MD_ArrayToUint64(&cpu8Hdr[GPTP_FR_CORR_OFFSET]);
+    prHdr->u64SrcClockId = GPTP_MD_ArrayToUint64(&cpu8Hdr[GPTP_FR_SC_CLK_ID_OFFSET]);
+
+    /* Source port id and sequence id */
+    u32Word = GPTP_MD_ArrayToUint32(&cpu8Hdr[GPTP_FR_SC_PORT_ID_OFFSET]);
+    prHdr->u16SrcPortId = (uint16_t)(u32Word >> 16u);
+    prHdr->u16SequenceId = (uint16_t)(u32Word & (uint32_t)GPTP_DEF_BIT_MASK_48L_16H);
+
+    prHdr->u8Control = GPTP_MD_ArrayToUint8(&cpu8Hdr[GPTP_FR_CONTROL_OFFSET]);
+    prHdr->s8LogMsgPeriod = GPTP_MD_ArrayToSint8(&cpu8Hdr[GPTP_FR_MSG_PER_LOG_OFFSET]);
+}
+
+/*!
+ * @brief The function encodes the PTP common header.
+ *
+ * All 34 bytes of the header, reserved fields included, are written in one pass.
+ *
+ * @param[out] pu8Hdr Pointer to the first byte of the PTP header, no alignment required
+ * @param[in] cprHdr Header to be encoded
+ */
+void GPTP_FRAME_HdrEncode(uint8_t *pu8Hdr,
+                          const gptp_frame_hdr_t *cprHdr)
+{
+    uint8_t u8Offset;
+
+    u8Offset = GPTP_FR_MSG_ID_OFFSET;
+
+    /* Transport specific, message type, version and message length */
+    u8Offset = GPTP_MD_Uint32ToArray(&pu8Hdr[u8Offset], (((uint32_t)cprHdr->u8MsgIdTs << 24u) | \
+                                                        ((uint32_t)cprHdr->u8Version << 16u) | \
+                                                         (uint32_t)cprHdr->u16MsgLength), u8Offset);
+
+    /* Domain number, reserved and flags */
+    u8Offset = GPTP_MD_Uint32ToArray(&pu8Hdr[u8Offset], (((uint32_t)cprHdr->u8DomainNum << 24u) | \
+                                                         (uint32_t)cprHdr->u16Flags), u8Offset);
+
+    /* Correction field */
+    u8Offset = GPTP_MD_Uint64ToArray(&pu8Hdr[u8Offset], cprHdr->u64Correction, u8Offset);
+
+    /* Reserved */
+    u8Offset = GPTP_MD_Uint32ToArray(&pu8Hdr[u8Offset], 0u, u8Offset);
+
+    /* Source clock identity */
+    u8Offset = GPTP_MD_Uint64ToArray(&pu8Hdr[u8Offset], cprHdr->u64SrcClockId, u8Offset);
+
+    /* Source port identity and sequence id */
+    u8Offset = GPTP_MD_Uint32ToArray(&pu8Hdr[u8Offset], (((uint32_t)cprHdr->u16SrcPortId << 16u) | \
+                                                         (uint32_t)cprHdr->u16SequenceId), u8Offset);
+
+    /* Control and log message period */
+    (void)GPTP_MD_Uint16ToArray(&pu8Hdr[u8Offset], (uint16_t)(((uint16_t)cprHdr->u8Control << 8u) | \
+                                                             (uint16_t)(uint8_t)cprHdr->s8LogMsgPeriod), u8Offset);
+}
+
 /*!
  * @brief The function parses received PTP ethernet frame.
  *
@@ -353,8 +529,8 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
     uint32_t                       u32OrganizationSubType;
     gptp_err_type_t                eError;
     gptp_def_msg_type_t            rTempMsgId;
-    uint8_t                        u8Seek;
     uint8_t                        u8DomainNum;
+    uint8_t                        u8DomainIndex;
     uint8_t                        u8SyncMachineId = 0u;
     bool                           bDomainFound;
     bool                           bMachineFound;
@@ -363,6 +539,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
     gptp_def_pdelay_t              *prPdelayMachine;
     uint16_t                       u16VlanTci;
     uint16_t                       u16EthType;
+    gptp_frame_hdr_t               rHdr;
 
     /* Initialization of variable, before it's used (will be loaded with correct address later) */
     prDomain = &prGptp->prPerDomainParams[0];
@@ -389,13 +566,13 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
         /* If VLAN ETH type */
         if (GPTP_FR_ETH_TYPE_VLAN == u16EthType)
         {
-            /* Store the TCI */
+            /* Store the TCI and the encapsulated ETH type following it */
             u16VlanTci = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset]);
+            u16EthType = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + 2u]);
             /* Increment the offset */
             u8HdrOffset = u8HdrOffset + GPTP_DEF_ETH_VLAN_LEN;
 
             /* If not PTP ETH type, register error don't allow to process the frame */
-            u16EthType = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset]);
             if (GPTP_FR_ETH_TYPE_PTP != u16EthType)
             {
                 GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_NO_ETH_TYPE_PTP, 0u);
@@ -431,10 +608,13 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
         /* Default error */
         eError = GPTP_ERR_M_MESSAGE_ID_INVALID;
 
+        /* Decode the whole PTP header at once, the message specific fields are read below */
+        GPTP_FRAME_HdrDecode(&(rRxData.cpu8RxData)[u8HdrOffset], &rHdr);
+
         /* Temporary asignment of the Message ID to distinguish which message is going to be processed */
-        rTempMsgId = (gptp_def_msg_type_t)(GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & 0x0Fu);
+        rTempMsgId = (gptp_def_msg_type_t)(rHdr.u8MsgIdTs & 0x0Fu);
         /* Get transport specific byte (nibble) */
-        u8TransportSpecific = (GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & 0xF0u);
+        u8TransportSpecific = (rHdr.u8MsgIdTs & 0xF0u);
 
         *prMessageTypeRcvd = GPTP_DEF_MSG_TYPE_UNKNOWN;
         *pu8DomainRcvd = 255u;
@@ -452,52 +632,31 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     eError = GPTP_ERR_OK;
 
                     /* Get domain number on wire */
-                    u8DomainNum = GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_DOMAIN_NUM]);
+                    u8DomainNum = rHdr.u8DomainNum;
                     /* Translate domain number on wire to logical domains of the gPTP stack */
-                    bDomainFound = false;
-                    /* Search for respective domain */
-                    for (u8Seek = 0u; u8Seek < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Seek++)
-                    {
-                        if (false == bDomainFound)
-                        {
-                            prDomain = &prGptp->prPerDomainParams[u8Seek];
-                            if (u8DomainNum == prDomain->u8DomainNumber)
-                            {
-                                bDomainFound = true;
-                                /* Save domain index into the domain number (temporary) */
-                                u8DomainNum = u8Seek;
-                            }
-                        }
-                    }
+                    bDomainFound = GPTP_INTERNAL_DomainLookup(prGptp, u8DomainNum, &u8DomainIndex);
 
                     if (true == bDomainFound)
                     {
-                        /* Find, to which sync machine the message belongs, by searching for the gPTP port */
-                        bMachineFound = false;
-                        /* Search for respective machine */
-                        for (u8Seek = 0u; u8Seek < prDomain->u8NumberOfSyncsPerDom; u8Seek++)
-                        {
-                            if (false == bMachineFound)
-                            {
-                                prSyncMachine = &prDomain->prSyncMachines[u8Seek];
-                                if (rRxData.u8PtpPort == prSyncMachine->u8GptpPort)
-                                {
-                                    bMachineFound = true;
-                                    u8SyncMachineId = u8Seek;
-                                }
-                            }
-                        }
+                        prDomain = &prGptp->prPerDomainParams[u8DomainIndex];
+                        /* Save domain index into the domain number (temporary) */
+                        u8DomainNum = u8DomainIndex;
+
+                        /* Find, to which sync machine the message belongs, by the gPTP port */
+                        bMachineFound = GPTP_INTERNAL_SyncMachineLookup(prDomain, rRxData.u8PtpPort, &u8SyncMachineId);
 
                         if (true == bMachineFound)
                         {
+                            prSyncMachine = &prDomain->prSyncMachines[u8SyncMachineId];
+
                             /* Parse the data from the Sync message and store into the RxData structure */
-                            prSyncMachine->rSyncMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & 0x0Fu);
+                            prSyncMachine->rSyncMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(rHdr.u8MsgIdTs & 0x0Fu);
                             /* Used for all outgoing messages */
-                            prSyncMachine->rSyncMsgRx.rHeader.u64CorrectionSubNs = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_CORR_OFFSET]);
-                            prSyncMachine->rSyncMsgRx.rHeader.u16SequenceId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]);
-                            prSyncMachine->rSyncMsgRx.rHeader.u16SourcePortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_PORT_ID_OFFSET]) - 1u;
-                            prSyncMachine->rSyncMsgRx.rHeader.u64SourceClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_CLK_ID_OFFSET]);
-                            prSyncMachine->rSyncMsgRx.rHeader.s8MessagePeriodLog = GPTP_MD_ArrayToSint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_PER_LOG_OFFSET]);
+                            prSyncMachine->rSyncMsgRx.rHeader.u64CorrectionSubNs = rHdr.u64Correction;
+                            prSyncMachine->rSyncMsgRx.rHeader.u16SequenceId = rHdr.u16SequenceId;
+                            prSyncMachine->rSyncMsgRx.rHeader.u16SourcePortId = rHdr.u16SrcPortId - 1u;
+                            prSyncMachine->rSyncMsgRx.rHeader.u64SourceClockId = rHdr.u64SrcClockId;
+                            prSyncMachine->rSyncMsgRx.rHeader.s8MessagePeriodLog = rHdr.s8LogMsgPeriod;
                             prSyncMachine->rSyncMsgRx.rSyncRxTs.u32TimeStampNs = rRxData.u32TsNsec;
                             prSyncMachine->rSyncMsgRx.rSyncRxTs.u64TimeStampS = rRxData.u32TsSec;
                             prSyncMachine->rSyncMsgRx.u16VlanTci = u16VlanTci;
@@ -516,7 +675,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         else
                         {
                             GPTP_ERR_Register(u8SyncMachineId, u8DomainNum, GPTP_ERR_M_SYNC_MACHINE_UNKNOWN, \
-                                              GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                              rHdr.u16SequenceId);
                             eError = GPTP_ERR_M_SYNC_MACHINE_UNKNOWN;
 #ifdef GPTP_COUNTERS
                             GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -527,7 +686,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     else
                     {
                         GPTP_ERR_Register(u8SyncMachineId, u8DomainNum, GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN, \
-                                          GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                          rHdr.u16SequenceId);
                         eError = GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN;
 #ifdef GPTP_COUNTERS
                         GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -540,7 +699,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     /* Discard the message */
                     /* Log the error into the error log */
                     GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_TRANSPORT_SPECIFIC, \
-                                      GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                      rHdr.u16SequenceId);
                     eError = GPTP_ERR_M_TRANSPORT_SPECIFIC;
 #ifdef GPTP_COUNTERS
                     GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -560,15 +719,15 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         prPdelayMachine = &prGptp->prPdelayMachines[rRxData.u8PtpPort];
 
                         /* Parse the data from the Propagation delay request message and store into the RxData structure */
-                        prPdelayMachine->rPdReqMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & 0x0Fu);
-                        prPdelayMachine->rPdReqMsgRx.rHeader.u16SequenceId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]);
-                        prPdelayMachine->rPdReqMsgRx.rHeader.u16SourcePortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_PORT_ID_OFFSET]) - 1u;
-                        prPdelayMachine->rPdReqMsgRx.rHeader.u64SourceClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_CLK_ID_OFFSET]);
-                        prPdelayMachine->rPdReqMsgRx.rHeader.s8MessagePeriodLog = GPTP_MD_ArrayToSint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_PER_LOG_OFFSET]);
+                        prPdelayMachine->rPdReqMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(rHdr.u8MsgIdTs & 0x0Fu);
+                        prPdelayMachine->rPdReqMsgRx.rHeader.u16SequenceId = rHdr.u16SequenceId;
+                        prPdelayMachine->rPdReqMsgRx.rHeader.u16SourcePortId = rHdr.u16SrcPortId - 1u;
+                        prPdelayMachine->rPdReqMsgRx.rHeader.u64SourceClockId = rHdr.u64SrcClockId;
+                        prPdelayMachine->rPdReqMsgRx.rHeader.s8MessagePeriodLog = rHdr.s8LogMsgPeriod;
                         prPdelayMachine->rPdReqMsgRx.rT2Ts.u32TimeStampNs = rRxData.u32TsNsec;
                         prPdelayMachine->rPdReqMsgRx.rT2Ts.u64TimeStampS = rRxData.u32TsSec;
                         prPdelayMachine->rPdReqMsgRx.u8MajorSdoId = (u8TransportSpecific >> 4u);
-                        prPdelayMachine->rPdReqMsgRx.u8SubdomainNum = GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_DOMAIN_NUM]);
+                        prPdelayMachine->rPdReqMsgRx.u8SubdomainNum = rHdr.u8DomainNum;
                         prPdelayMachine->rPdReqMsgRx.u16VlanTci = u16VlanTci;
 
                         *pu8MachineRcvd = rRxData.u8PtpPort;
@@ -585,7 +744,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     else
                     {
                         GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_PDEL_MACHINE_UNKNOWN, \
-                                          GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                          rHdr.u16SequenceId);
                         eError = GPTP_ERR_M_PDEL_MACHINE_UNKNOWN;
 #ifdef GPTP_COUNTERS
                         GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -598,7 +757,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     /* Discard the message */
                     /* Log the error into the error log */
                     GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_TRANSPORT_SPECIFIC, \
-                                      GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                      rHdr.u16SequenceId);
                     eError = GPTP_ERR_M_TRANSPORT_SPECIFIC;
 #ifdef GPTP_COUNTERS
                     GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -617,7 +776,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     if (rRxData.u8PtpPort < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines)
                     {
                         /* Temporary sequence Id assignment */
-                        u16TempSeqId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]);
+                        u16TempSeqId = rHdr.u16SequenceId;
 
                         prPdelayMachine = &prGptp->prPdelayMachines[rRxData.u8PtpPort];
 
@@ -625,11 +784,11 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         if (prPdelayMachine->rPdReqMsgRx.rHeader.u16SequenceId != u16TempSeqId)
                         {
                             /* Parse the data from the propagation delay response message and store into the RxData structure */
-                            prPdelayMachine->rPdRespMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & 0x0Fu);
-                            prPdelayMachine->rPdRespMsgRx.rHeader.u16SequenceId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]);
-                            prPdelayMachine->rPdRespMsgRx.rHeader.u16SourcePortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_PORT_ID_OFFSET]) - 1u;
-                            prPdelayMachine->rPdRespMsgRx.rHeader.u64SourceClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_CLK_ID_OFFSET]);
-                            prPdelayMachine->rPdRespMsgRx.rHeader.s8MessagePeriodLog = GPTP_MD_ArrayToSint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_PER_LOG_OFFSET]);
+                            prPdelayMachine->rPdRespMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(rHdr.u8MsgIdTs & 0x0Fu);
+                            prPdelayMachine->rPdRespMsgRx.rHeader.u16SequenceId = rHdr.u16SequenceId;
+                            prPdelayMachine->rPdRespMsgRx.rHeader.u16SourcePortId = rHdr.u16SrcPortId - 1u;
+                            prPdelayMachine->rPdRespMsgRx.rHeader.u64SourceClockId = rHdr.u64SrcClockId;
+                            prPdelayMachine->rPdRespMsgRx.rHeader.s8MessagePeriodLog = rHdr.s8LogMsgPeriod;
                             prPdelayMachine->rPdRespMsgRx.rRequestingId.u64ClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_RQ_CLK_ID_OFFSET]);
                             prPdelayMachine->rPdRespMsgRx.rRequestingId.u16PortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_RQ_PORT_ID_OFFSET]) - 1u;
                             prPdelayMachine->rPdRespMsgRx.rT2Ts.u64TimeStampS = GPTP_MD_ArrayToUint48(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_TS_S_OFFSET]);
@@ -651,7 +810,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         {
                             /* Log the error into the error log */
                             GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_PDEL_RESP_DBL_RCVD, \
-                                              GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                              rHdr.u16SequenceId);
                             eError = GPTP_ERR_M_PDEL_RESP_DBL_RCVD;
 #ifdef GPTP_COUNTERS
                             GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -662,7 +821,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     else
                     {
                         GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_PDEL_MACHINE_UNKNOWN, \
-                                          GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                          rHdr.u16SequenceId);
                         eError = GPTP_ERR_M_PDEL_MACHINE_UNKNOWN;
 #ifdef GPTP_COUNTERS
                         GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -675,7 +834,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     /* Discard the message */
                     /* Log the error into the error log */
                     GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_TRANSPORT_SPECIFIC, \
-                                      GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                      rHdr.u16SequenceId);
                     eError = GPTP_ERR_M_TRANSPORT_SPECIFIC;
 #ifdef GPTP_COUNTERS
                     GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -692,57 +851,43 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     eError = GPTP_ERR_OK;
 
                     /* Get domain number on wire */
-                    u8DomainNum = GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_DOMAIN_NUM]);
+                    u8DomainNum = rHdr.u8DomainNum;
                     /* Translate domain number on wire to logical domains of the gPTP stack */
-                    bDomainFound = false;
-                    /* Search for respective domain */
-                    for (u8Seek = 0u; u8Seek < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Seek++)
-                    {
-                        if (false == bDomainFound)
-                        {
-                            prDomain = &prGptp->prPerDomainParams[u8Seek];
-                            if (u8DomainNum == prDomain->u8DomainNumber)
-                            {
-                                bDomainFound = true;
-                                /* Save domain index into the domain number (temporary) */
-                                u8DomainNum = u8Seek;
-                            }
-                        }
-                    }
+                    bDomainFound = GPTP_INTERNAL_DomainLookup(prGptp, u8DomainNum, &u8DomainIndex);
 
                     if (true == bDomainFound)
                     {
-                        /* Find, to which sync machine the message belongs, by searching for the gPTP port */
-                        bMachineFound = false;
-                        /* Search for respective machine */
-                        for (u8Seek = 0u; u8Seek < prDomain->u8NumberOfSyncsPerDom; u8Seek++)
-                        {
-                            if (false == bMachineFound)
-                            {
-                                prSyncMachine = &prDomain->prSyncMachines[u8Seek];
-                                if (rRxData.u8PtpPort == prSyncMachine->u8GptpPort)
-                                {
-                                    bMachineFound = true;
-                                    u8SyncMachineId = u8Seek;
-                                }
-                            }
-                        }
+                        prDomain = &prGptp->prPerDomainParams[u8DomainIndex];
+                        /* Save domain index into the domain number (temporary) */
+                        u8DomainNum = u8DomainIndex;
+
+                        /* Find, to which sync machine the message belongs, by the gPTP port */
+                        bMachineFound = GPTP_INTERNAL_SyncMachineLookup(prDomain, rRxData.u8PtpPort, &u8SyncMachineId);
 
                         if (true == bMachineFound)
                         {
+                            prSyncMachine = &prDomain->prSyncMachines[u8SyncMachineId];
+
                             /* Parse the data from the follow up message and store into the RxData structure */
-                            prSyncMachine->rFupMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & 0x0Fu);
-                            prSyncMachine->rFupMsgRx.rHeader.u64CorrectionSubNs = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_CORR_OFFSET]);
-                            prSyncMachine->rFupMsgRx.rHeader.u16SequenceId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]);
-                            prSyncMachine->rFupMsgRx.rHeader.u16SourcePortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_PORT_ID_OFFSET]) - 1u;
-                            prSyncMachine->rFupMsgRx.rHeader.u64SourceClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_CLK_ID_OFFSET]);
-                            prSyncMachine->rFupMsgRx.rHeader.s8MessagePeriodLog = GPTP_MD_ArrayToSint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_PER_LOG_OFFSET]);
+                            prSyncMachine->rFupMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(rHdr.u8MsgIdTs & 0x0Fu);
+                            prSyncMachine->rFupMsgRx.rHeader.u64CorrectionSubNs = rHdr.u64Correction;
+                            prSyncMachine->rFupMsgRx.rHeader.u16SequenceId = rHdr.u16SequenceId;
+                            prSyncMachine->rFupMsgRx.rHeader.u16SourcePortId = rHdr.u16SrcPortId - 1u;
+                            prSyncMachine->rFupMsgRx.rHeader.u64SourceClockId = rHdr.u64SrcClockId;
+                            prSyncMachine->rFupMsgRx.rHeader.s8MessagePeriodLog = rHdr.s8LogMsgPeriod;
                             prSyncMachine->rFupMsgRx.rSyncTxTs.u64TimeStampS = GPTP_MD_ArrayToUint48(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_TS_S_OFFSET]);
                             prSyncMachine->rFupMsgRx.rSyncTxTs.u32TimeStampNs = GPTP_MD_ArrayToUint32(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_TS_NS_OFFSET]);
+#ifdef GPTP_FIXED_POINT
+                            /* calculate the rate ratio from cumulative scaled rate (2^-41 units rescaled to Q32.32) */
+                            prSyncMachine->rFupMsgRx.f64RateRatio = GPTP_FXP_Q32ToFloat64(GPTP_FXP_Q32_ONE + \
+                                                                    ((int64_t)((int32_t)GPTP_MD_ArrayToUint32(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_CS_RATE_RATIO_OFFSET])) / \
+                                                                     GPTP_FXP_CS_RATE_SCALE));
+#else
                             prSyncMachine->rFupMsgRx.f64RateRatio = (float64_t)((int32_t)GPTP_MD_ArrayToUint32(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_CS_RATE_RATIO_OFFSET]));
 
                             /* calculate the rate ratio from cumulative scaled rate */
                             prSyncMachine->rFupMsgRx.f64RateRatio = (prSyncMachine->rFupMsgRx.f64RateRatio * GPTP_DEF_POW_2_M41) + 1.0 ;
+#endif /* GPTP_FIXED_POINT */
 
                             /* Update GM Time Base Indicator */
                             prDomain->u16GmTimeBaseIndicator = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_GM_TIME_BASE_INDIC]);
@@ -768,7 +913,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         else
                         {
                             GPTP_ERR_Register(u8SyncMachineId, u8DomainNum, GPTP_ERR_M_SYNC_MACHINE_UNKNOWN, \
-                                              GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                              rHdr.u16SequenceId);
                             eError = GPTP_ERR_M_SYNC_MACHINE_UNKNOWN;
 #ifdef GPTP_COUNTERS
                             GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -779,7 +924,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     else
                     {
                         GPTP_ERR_Register(u8SyncMachineId, u8DomainNum, GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN, \
-                                          GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                          rHdr.u16SequenceId);
                         eError = GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN;
 #ifdef GPTP_COUNTERS
                         GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -792,7 +937,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     /* Discard the message */
                     /* Log the error into the error log */
                     GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_TRANSPORT_SPECIFIC, \
-                                      GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                      rHdr.u16SequenceId);
                     eError = GPTP_ERR_M_TRANSPORT_SPECIFIC;
 #ifdef GPTP_COUNTERS
                     GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -814,11 +959,11 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         prPdelayMachine = &prGptp->prPdelayMachines[rRxData.u8PtpPort];
 
                         /* Parse the data from the propagation delay follow up message and store into the RxData structure */
-                        prPdelayMachine->rPdRespFupMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_ID_OFFSET]) & (uint8_t)0x0Fu);
-                        prPdelayMachine->rPdRespFupMsgRx.rHeader.u16SequenceId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]);
-                        prPdelayMachine->rPdRespFupMsgRx.rHeader.u16SourcePortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_PORT_ID_OFFSET]) - 1u;
-                        prPdelayMachine->rPdRespFupMsgRx.rHeader.u64SourceClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SC_CLK_ID_OFFSET]);
-                        prPdelayMachine->rPdRespFupMsgRx.rHeader.s8MessagePeriodLog = GPTP_MD_ArrayToSint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_MSG_PER_LOG_OFFSET]);
+                        prPdelayMachine->rPdRespFupMsgRx.rHeader.eMsgId = (gptp_def_msg_type_t)(rHdr.u8MsgIdTs & (uint8_t)0x0Fu);
+                        prPdelayMachine->rPdRespFupMsgRx.rHeader.u16SequenceId = rHdr.u16SequenceId;
+                        prPdelayMachine->rPdRespFupMsgRx.rHeader.u16SourcePortId = rHdr.u16SrcPortId - 1u;
+                        prPdelayMachine->rPdRespFupMsgRx.rHeader.u64SourceClockId = rHdr.u64SrcClockId;
+                        prPdelayMachine->rPdRespFupMsgRx.rHeader.s8MessagePeriodLog = rHdr.s8LogMsgPeriod;
                         prPdelayMachine->rPdRespFupMsgRx.rRequestingId.u64ClockId = GPTP_MD_ArrayToUint64(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_RQ_CLK_ID_OFFSET]);
                         prPdelayMachine->rPdRespFupMsgRx.rRequestingId.u16PortId = GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_RQ_PORT_ID_OFFSET]) - 1u;
                         prPdelayMachine->rPdRespFupMsgRx.rT3Ts.u64TimeStampS = GPTP_MD_ArrayToUint48(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_TS_S_OFFSET]);
@@ -836,7 +981,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     else
                     {
                         GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_PDEL_MACHINE_UNKNOWN, \
-                                          GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                          rHdr.u16SequenceId);
                         eError = GPTP_ERR_M_PDEL_MACHINE_UNKNOWN;
 #ifdef GPTP_COUNTERS
                         GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -850,7 +995,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     /* Discard the message */
                     /* Log the error into the error log */
                     GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_TRANSPORT_SPECIFIC, \
-                                      GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                      rHdr.u16SequenceId);
                     eError = GPTP_ERR_M_TRANSPORT_SPECIFIC;
 #ifdef GPTP_COUNTERS
                     GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -878,45 +1023,24 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     u32OrganizationSubType = GPTP_MD_ArrayToUint32(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SIG_ORG_SUBTYPE_OFFSET]) & GPTP_DEF_BIT_MASK_8L_24H;
 
                     /* Get domain number on wire */
-                    u8DomainNum = GPTP_MD_ArrayToUint8(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_DOMAIN_NUM]);
+                    u8DomainNum = rHdr.u8DomainNum;
 
                     /* Determine machine id from the Domain number and port */
-                    bDomainFound = false;
-                    /* Search for respective domain */
-                    for (u8Seek = 0u; u8Seek < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Seek++)
-                    {
-                        if (false == bDomainFound)
-                        {
-                            prDomain = &prGptp->prPerDomainParams[u8Seek];
-                            if (u8DomainNum == prDomain->u8DomainNumber)
-                            {
-                                bDomainFound = true;
-                                /* Save domain index into the domain number (temporary) */
-                                u8DomainNum = u8Seek;
-                            }
-                        }
-                    }
+                    bDomainFound = GPTP_INTERNAL_DomainLookup(prGptp, u8DomainNum, &u8DomainIndex);
 
                     if (true == bDomainFound)
                     {
-                        /* Find, to which signaling machine the message belongs, by searching for the gPTP port */
-                        bMachineFound = false;
-                        /* Search for respective machine */
-                        for (u8Seek = 0u; u8Seek < prDomain->u8NumberOfSyncsPerDom; u8Seek++)
-                        {
-                            if (false == bMachineFound)
-                            {
-                                prSyncMachine = &prDomain->prSyncMachines[u8Seek];
-                                if (rRxData.u8PtpPort == prSyncMachine->u8GptpPort)
-                                {
-                                    bMachineFound = true;
-                                    u8SyncMachineId = u8Seek;
-                                }
-                            }
-                        }
+                        prDomain = &prGptp->prPerDomainParams[u8DomainIndex];
+                        /* Save domain index into the domain number (temporary) */
+                        u8DomainNum = u8DomainIndex;
+
+                        /* Find, to which signaling machine the message belongs, by the gPTP port */
+                        bMachineFound = GPTP_INTERNAL_SyncMachineLookup(prDomain, rRxData.u8PtpPort, &u8SyncMachineId);
 
                         if (true == bMachineFound)
                         {
+                            prSyncMachine = &prDomain->prSyncMachines[u8SyncMachineId];
+
                             switch (u32OrganizationSubType)
                             {
                                 /* Mesage interval request TLV */
@@ -951,7 +1075,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                         else
                         {
                             GPTP_ERR_Register(u8SyncMachineId, u8DomainNum, GPTP_ERR_M_SYNC_MACHINE_UNKNOWN, \
-                                              GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                              rHdr.u16SequenceId);
                             eError = GPTP_ERR_M_SYNC_MACHINE_UNKNOWN;
 #ifdef GPTP_COUNTERS
                             GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -962,7 +1086,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     else
                     {
                         GPTP_ERR_Register(rRxData.u8PtpPort, u8DomainNum, GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN, \
-                                          GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                          rHdr.u16SequenceId);
                         eError = GPTP_ERR_M_SYNC_DOMAIN_UNKNOWN;
 #ifdef GPTP_COUNTERS
                         GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -975,7 +1099,7 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
                     /* Discard the message */
                     /* Log the error into the error log */
                     GPTP_ERR_Register(rRxData.u8PtpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_M_TRANSPORT_SPECIFIC, \
-                                      GPTP_MD_ArrayToUint16(&(rRxData.cpu8RxData)[u8HdrOffset + (uint8_t)GPTP_FR_SEQ_ID_OFFSET]));
+                                      rHdr.u16SequenceId);
                     eError = GPTP_ERR_M_TRANSPORT_SPECIFIC;
 #ifdef GPTP_COUNTERS
                 GPTP_INTERNAL_IncrementPortStats(prGptp, rRxData.u8PtpPort, ieee8021AsPortStatRxPTPPacketDiscard);
@@ -1007,37 +1131,25 @@ gptp_err_type_t GPTP_FRAME_ParseRx(gptp_def_rx_data_t rRxData,
 }
 
 /*!
- * @brief The function builds PTP ethernet frame to send
+ * @brief The function builds the complete PTP ethernet frame
  *
- * The function builds PTP ethernet frame to send
+ * All fields of the Ethernet, VLAN and PTP headers and of the message body
+ * are written.
  *
  * @param[in] prGptp Pointer to global data structure
  * @param[in] ptxData Pointer to tx data buffer
  * @param[in] u8Domain Domain number
  * @param[in] u8Port gPTP port number
- *
- * @ requirements 529199
- * @ requirements 529211
- * @ requirements 152451
- * @ requirements 152455
- * @ requirements 162145
- * @ requirements 120467
- * @ requirements 120456
- * @ requirements 162147
  */
-void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
-                        gptp_def_tx_data_t *ptxData,
-                        const uint8_t u8Domain,
-                        const uint8_t u8Port)
+static void GPTP_FRAME_FrameBuild(const gptp_def_data_t *prGptp,
+                                  gptp_def_tx_data_t *ptxData,
+                                  const uint8_t u8Domain,
+                                  const uint8_t u8Port)
 {
+    gptp_frame_hdr_t rHdr;
     uint8_t      u8FrameOffset;
-    uint8_t      u8TransportSpecOffset;
-    uint8_t      u8FlagsOffset;
-    uint8_t      u8MsgLengthOffset;
-    uint8_t      u8DomainNumOffset;
-    uint8_t      u8CorrectionOffset;
+    uint8_t      u8HdrOffset;
     uint8_t      u8VlanMsgLenAdd;
-    float64_t    f64Temp;
 
     /* Frame Eth II */
     u8FrameOffset = 0x00u;
@@ -1070,54 +1182,46 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
     /* uint16_t Eth type PTP*/
     u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], ((uint16_t)GPTP_FR_ETH_TYPE_PTP & (uint16_t)GPTP_DEF_BIT_MASK_48L_16H), u8FrameOffset);
 
-    /* Frame PTP header*/
+    /* Frame PTP header - encoded at once after the message specific fields are known */
+    u8HdrOffset = u8FrameOffset;
+    u8FrameOffset = u8FrameOffset + GPTP_FR_HDR_LEN;
+
     /* Mix two 4bit information into one 8bit. Upper nibble - Transport Specific, Lower nibble - Msg Id */
-    u8TransportSpecOffset = u8FrameOffset;
-    u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], ((uint8_t)(0x1u << 4u) | (uint8_t)ptxData->eMsgId), u8FrameOffset);
+    rHdr.u8MsgIdTs = ((uint8_t)(0x1u << 4u) | (uint8_t)ptxData->eMsgId);
 
     /* Mix two 4bit information into one 8bit. Upper nibble - Reserved, Lower nibble - Version PTP */
-    u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t)(0u | 0x2u), u8FrameOffset);
+    rHdr.u8Version = (uint8_t)(0u | 0x2u);
 
-    /* Message Length - message specific, offset saved and used later. */
-    u8MsgLengthOffset = u8FrameOffset;
-    u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
+    /* Message Length and Flags - message specific */
+    rHdr.u16MsgLength = 0u;
+    rHdr.u16Flags = 0u;
 
     /* Domain number - 0  for Pdelay (as initiator), variable for Sync/Fup and Pdelay responses */
-    u8DomainNumOffset = u8FrameOffset;
-    u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
-
-    /* Reserved */
-    u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
-
-    /* Flags - message specific. The value is updated for each message */
-    u8FlagsOffset = u8FrameOffset;
-    u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
+    rHdr.u8DomainNum = 0u;
 
-    /* Correction field */
-    u8CorrectionOffset = u8FrameOffset;
-    u8FrameOffset = GPTP_MD_Uint64ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint64_t)0u, u8FrameOffset);
-
-    /* Reserved */
-    u8FrameOffset = GPTP_MD_Uint32ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
-
-    /* Source clock identity */
-    u8FrameOffset = GPTP_MD_Uint64ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], ptxData->rSrcPortID.u64ClockId, u8FrameOffset);
+    /* Correction field - used only by the Follow up */
+    rHdr.u64Correction = 0u;
 
     /* Source port identity */
-    u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], ptxData->rSrcPortID.u16PortId, u8FrameOffset);
+    rHdr.u64SrcClockId = ptxData->rSrcPortID.u64ClockId;
+    rHdr.u16SrcPortId = ptxData->rSrcPortID.u16PortId;
 
     /* Sequence id */
-    u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], ptxData->u16SequenceId, u8FrameOffset);
+    rHdr.u16SequenceId = ptxData->u16SequenceId;
+
+    /* Control and Log message period - message specific */
+    rHdr.u8Control = (uint8_t)GPTP_FR_CONTROL_OTHER;
+    rHdr.s8LogMsgPeriod = (int8_t)GPTP_FR_LOG_MSG_PERIOD_STOP;
 
     /* Mesage type specific data */
     switch (ptxData->eMsgId)
     {
         case GPTP_DEF_MSG_TYPE_SYNC:
             /* Msg header continue - Control */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) GPTP_FR_CONTROL_SYNC, u8FrameOffset);
+            rHdr.u8Control = (uint8_t)GPTP_FR_CONTROL_SYNC;
 
             /* Log message period */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) ptxData->s8LogMessagePeriod, u8FrameOffset);
+            rHdr.s8LogMsgPeriod = ptxData->s8LogMessagePeriod;
 
             /* Message type specific content outside of the PTP header */
             /* Timestamp Seconds - In the Sync message always 0 (defined as reserved) */
@@ -1126,36 +1230,33 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
             /* Timestamp Nanoseconds - In the Sync message always 0 (defined as reserved */
             u8FrameOffset = GPTP_MD_Uint32ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
 
-            /* Update Flags value */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FlagsOffset], (uint16_t) GPTP_DEF_SYNC_FLAGS, u8FrameOffset);
+            /* Flags value */
+            rHdr.u16Flags = (uint16_t)GPTP_DEF_SYNC_FLAGS;
 
-            /* Save the message length to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8MsgLengthOffset], (uint16_t) GPTP_DEF_SYNC_MSG_LEN, u8FrameOffset);
+            /* Message length */
+            rHdr.u16MsgLength = (uint16_t)GPTP_DEF_SYNC_MSG_LEN;
 
-            /* Save the domain number to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8DomainNumOffset], prGptp->prPerDomainParams[u8Domain].u8DomainNumber, u8FrameOffset);
+            /* Domain number */
+            rHdr.u8DomainNum = prGptp->prPerDomainParams[u8Domain].u8DomainNumber;
 
             /* Save message length for port interface */
             ptxData->u8FrameLength = GPTP_DEF_SYNC_MSG_LEN + GPTP_DEF_ETH_II_LEN + u8VlanMsgLenAdd;
         break;
 
         case GPTP_DEF_MSG_TYPE_PD_REQ:
-            /* Msg header continue - Control */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t)GPTP_FR_CONTROL_OTHER, u8FrameOffset);
-
             /* Log message period */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) ptxData->s8LogMessagePeriod, u8FrameOffset);
+            rHdr.s8LogMsgPeriod = ptxData->s8LogMessagePeriod;
 
             /* Clear Reserved fields in the Pdelay request body */
             u8FrameOffset = GPTP_MD_Uint64ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
             u8FrameOffset = GPTP_MD_Uint64ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
             u8FrameOffset = GPTP_MD_Uint32ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0u, u8FrameOffset);
 
-            /* Update Flags value */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FlagsOffset], (uint16_t) GPTP_DEF_PDELAY_REQ_FLAGS, u8FrameOffset);
+            /* Flags value */
+            rHdr.u16Flags = (uint16_t)GPTP_DEF_PDELAY_REQ_FLAGS;
 
-            /* Save the message length to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8MsgLengthOffset], (uint16_t) GPTP_DEF_PDELAY_REQ_MSG_LEN, u8FrameOffset);
+            /* Message length */
+            rHdr.u16MsgLength = (uint16_t)GPTP_DEF_PDELAY_REQ_MSG_LEN;
 
             /* Save message length for port interface */
             ptxData->u8FrameLength = GPTP_DEF_PDELAY_REQ_MSG_LEN + GPTP_DEF_ETH_II_LEN + u8VlanMsgLenAdd;
@@ -1163,12 +1264,6 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
         break;
 
         case GPTP_DEF_MSG_TYPE_PD_RESP:
-            /* Msg header continue - Control */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t)GPTP_FR_CONTROL_OTHER, u8FrameOffset);
-
-            /* Log message period */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) GPTP_FR_LOG_MSG_PERIOD_STOP, u8FrameOffset);
-
             /* Timestamp Seconds */
             u8FrameOffset = GPTP_MD_Uint48ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (ptxData->rTs.u64TimeStampS & (uint64_t)GPTP_DEF_BIT_MASK_16L_48H), u8FrameOffset);
 
@@ -1184,18 +1279,17 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
             /* Update transport specific (MajorSdoID) to the value, as received in the pdelay request */
             if (true == prGptp->rPerDeviceParams.bSdoIdCompatibilityMode)
             {
-                u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8TransportSpecOffset], ((uint8_t)(prGptp->prPdelayMachines[u8Port].rPdReqMsgRx.u8MajorSdoId << 4u) | \
-                                    (uint8_t)ptxData->eMsgId), u8FrameOffset);
+                rHdr.u8MsgIdTs = ((uint8_t)(prGptp->prPdelayMachines[u8Port].rPdReqMsgRx.u8MajorSdoId << 4u) | (uint8_t)ptxData->eMsgId);
             }
 
-            /* Update Flags value */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FlagsOffset], (uint16_t) GPTP_DEF_PDELAY_RESP_FLAGS, u8FrameOffset);
+            /* Flags value */
+            rHdr.u16Flags = (uint16_t)GPTP_DEF_PDELAY_RESP_FLAGS;
 
-            /* Save the message length to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8MsgLengthOffset], (uint16_t) GPTP_DEF_PDELAY_RESP_MSG_LEN, u8FrameOffset);
+            /* Message length */
+            rHdr.u16MsgLength = (uint16_t)GPTP_DEF_PDELAY_RESP_MSG_LEN;
 
-            /* Save the domain number to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8DomainNumOffset], ptxData->u8SubdomainNumber, u8FrameOffset);
+            /* Domain number */
+            rHdr.u8DomainNum = ptxData->u8SubdomainNumber;
 
             /* Save message length for port interface */
             ptxData->u8FrameLength = GPTP_DEF_PDELAY_RESP_MSG_LEN + GPTP_DEF_ETH_II_LEN + u8VlanMsgLenAdd;
@@ -1203,10 +1297,10 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
 
         case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
             /* Msg header continue - Control */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t)GPTP_FR_CONTROL_FOLLOW_UP, u8FrameOffset);
+            rHdr.u8Control = (uint8_t)GPTP_FR_CONTROL_FOLLOW_UP;
 
             /* Log message period */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) ptxData->s8LogMessagePeriod, u8FrameOffset);
+            rHdr.s8LogMsgPeriod = ptxData->s8LogMessagePeriod;
 
             /* Message type specific content outside of the PTP header */
             /* Timestamp Seconds - In the Sync message always 0 (defined as reserved) */
@@ -1229,8 +1323,7 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
             u8FrameOffset = GPTP_MD_Uint24ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint32_t)(GPTP_FR_FUP_TLV_ORG_SUB_TYPE), u8FrameOffset);
 
             /* Cumulative scale rate ratio */
-            f64Temp = (ptxData->f64RateRatio - 1.0) * (float64_t)GPTP_DEF_POW_2_41;
-            u8FrameOffset = GPTP_MD_Uint32ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint32_t)((int32_t)f64Temp), u8FrameOffset);
+            u8FrameOffset = GPTP_MD_Uint32ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], GPTP_FRAME_CsRateRatio(ptxData->f64RateRatio), u8FrameOffset);
 
             /* GM Time Base Indicator */
             u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], prGptp->prPerDomainParams[u8Domain].u16GmTimeBaseIndicator, u8FrameOffset);
@@ -1242,29 +1335,23 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
             /* Scaled last GM frequency change */
             u8FrameOffset = GPTP_MD_Uint32ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], prGptp->prPerDomainParams[u8Domain].u32ScaledLastGmFreqChange, u8FrameOffset);
 
-            /* Update Flags value */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FlagsOffset], (uint16_t) GPTP_DEF_FUP_FLAGS, u8FrameOffset);
+            /* Flags value */
+            rHdr.u16Flags = (uint16_t)GPTP_DEF_FUP_FLAGS;
 
             /* Correction field */
-            u8FrameOffset = GPTP_MD_Uint64ToArray(&ptxData->pau8TxBuffPtr[u8CorrectionOffset], ptxData->u64CorrectionSubNs, u8FrameOffset);
+            rHdr.u64Correction = ptxData->u64CorrectionSubNs;
 
-            /* Save the message length to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8MsgLengthOffset], (uint16_t) GPTP_DEF_FOLLOW_UP_MSG_LEN, u8FrameOffset);
+            /* Message length */
+            rHdr.u16MsgLength = (uint16_t)GPTP_DEF_FOLLOW_UP_MSG_LEN;
 
-            /* Save the domain number to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8DomainNumOffset], prGptp->prPerDomainParams[u8Domain].u8DomainNumber, u8FrameOffset);
+            /* Domain number */
+            rHdr.u8DomainNum = prGptp->prPerDomainParams[u8Domain].u8DomainNumber;
 
             /* Save message length for port interface */
             ptxData->u8FrameLength = GPTP_DEF_FOLLOW_UP_MSG_LEN + GPTP_DEF_ETH_II_LEN + u8VlanMsgLenAdd;
         break;
 
         case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
-            /* Msg header continue - Control */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t)GPTP_FR_CONTROL_OTHER, u8FrameOffset);
-
-            /* Log message period */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) GPTP_FR_LOG_MSG_PERIOD_STOP, u8FrameOffset);
-
             /* Message type specific content outside of the PTP header */
             /* Timestamp Seconds - In the Sync message always 0 (defined as reserved) */
             u8FrameOffset = GPTP_MD_Uint48ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (ptxData->rTs.u64TimeStampS & (uint64_t)
@@ -1282,18 +1369,17 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
             /* Update transport specific (MajorSdoID) to the value, as received in the pdelay request */
             if (true == prGptp->rPerDeviceParams.bSdoIdCompatibilityMode)
             {
-                u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8TransportSpecOffset], ((uint8_t)(prGptp->prPdelayMachines[u8Port].rPdReqMsgRx.u8MajorSdoId << 4u) | \
-                                    (uint8_t)ptxData->eMsgId), u8FrameOffset);
+                rHdr.u8MsgIdTs = ((uint8_t)(prGptp->prPdelayMachines[u8Port].rPdReqMsgRx.u8MajorSdoId << 4u) | (uint8_t)ptxData->eMsgId);
             }
 
-            /* Update Flags value */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FlagsOffset], (uint16_t) GPTP_DEF_PDELAY_RESP_FUP_FLAGS, u8FrameOffset);
+            /* Flags value */
+            rHdr.u16Flags = (uint16_t)GPTP_DEF_PDELAY_RESP_FUP_FLAGS;
 
-            /* Save the message length to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8MsgLengthOffset], (uint16_t) GPTP_DEF_PDELAY_FUP_MSG_LEN, u8FrameOffset);
+            /* Message length */
+            rHdr.u16MsgLength = (uint16_t)GPTP_DEF_PDELAY_FUP_MSG_LEN;
 
-            /* Save the domain number to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8DomainNumOffset], ptxData->u8SubdomainNumber, u8FrameOffset);
+            /* Domain number */
+            rHdr.u8DomainNum = ptxData->u8SubdomainNumber;
 
             /* Save message length for port interface */
             ptxData->u8FrameLength = GPTP_DEF_PDELAY_FUP_MSG_LEN + GPTP_DEF_ETH_II_LEN + u8VlanMsgLenAdd;
@@ -1301,12 +1387,6 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
 
         /* Signaling message */
         case GPTP_DEF_MSG_TYPE_SIGNALING:
-            /* Msg header continue - Control */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t)GPTP_FR_CONTROL_OTHER, u8FrameOffset);
-
-            /* Log message period */
-            u8FrameOffset = GPTP_MD_Uint8ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint8_t) GPTP_FR_LOG_MSG_PERIOD_STOP, u8FrameOffset);
-
             /* Message type specific content outside of the PTP header */
             /* Target Port Identity - 10 Bytes */
             u8FrameOffset = GPTP_MD_Uint64ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], 0xFFFFFFFFFFFFFFFFu, u8FrameOffset);
@@ -1340,11 +1420,11 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
             /* Reserved */
             u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FrameOffset], (uint16_t) 0u, u8FrameOffset);
 
-            /* Update Flags value */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8FlagsOffset], (uint16_t) GPTP_DEF_SIGNALING_FLAGS, u8FrameOffset);
+            /* Flags value */
+            rHdr.u16Flags = (uint16_t)GPTP_DEF_SIGNALING_FLAGS;
 
-            /* Save the message length to the gPTP frame header */
-            u8FrameOffset = GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[u8MsgLengthOffset], (uint16_t) GPTP_DEF_SIGNALING_MSG_LEN, u8FrameOffset);
+            /* Message length */
+            rHdr.u16MsgLength = (uint16_t)GPTP_DEF_SIGNALING_MSG_LEN;
 
             /* Save message length for port interface */
             ptxData->u8FrameLength = GPTP_DEF_SIGNALING_MSG_LEN + GPTP_DEF_ETH_II_LEN + u8VlanMsgLenAdd;
@@ -1353,7 +1433,211 @@ void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
         default:
         break;
     }
+
+    /* Write the PTP header */
+    GPTP_FRAME_HdrEncode(&ptxData->pau8TxBuffPtr[u8HdrOffset], &rHdr);
+}
+
+#ifdef GPTP_TX_TEMPLATES
+/*!
+ * @brief The function patches the volatile fields of the frame template
+ *
+ * The TX buffer already holds the complete frame of the same message type,
+ * built by GPTP_FRAME_FrameBuild. Only the fields, which may differ between
+ * two transmissions of the machine, are rewritten.
+ *
+ * @param[in] prGptp Pointer to global data structure
+ * @param[in] ptxData Pointer to tx data buffer
+ * @param[in] u8Domain Domain number
+ * @param[in] u8Port gPTP port number
+ */
+static void GPTP_FRAME_TemplatePatch(const gptp_def_data_t *prGptp,
+                                     const gptp_def_tx_data_t *ptxData,
+                                     const uint8_t u8Domain,
+                                     const uint8_t u8Port)
+{
+    uint8_t      *pu8Hdr;
+    uint8_t      u8MsgIdTs;
+
+    /* Destination MAC address - the Pdelay responses may be sent as unicast */
+    (void)GPTP_MD_Uint48ToArray(ptxData->pau8TxBuffPtr, ptxData->u64DestMac, 0u);
+
+    /* If VLAN enabled */
+    if (true == prGptp->rPerDeviceParams.bVlanEnabled)
+    {
+        /* VLAN ID follows the VLAN Eth type */
+        (void)GPTP_MD_Uint16ToArray(&ptxData->pau8TxBuffPtr[GPTP_FR_ETH_TYPE_OFFSET + 2u], ptxData->u16VlanTci, 0u);
+        pu8Hdr = &ptxData->pau8TxBuffPtr[GPTP_DEF_ETH_II_LEN + GPTP_DEF_ETH_VLAN_LEN];
+    }
+
+    else
+    {
+        pu8Hdr = &ptxData->pau8TxBuffPtr[GPTP_DEF_ETH_II_LEN];
+    }
+
+    /* Source port identity, sequence id */
+    (void)GPTP_MD_Uint64ToArray(&pu8Hdr[GPTP_FR_SC_CLK_ID_OFFSET], ptxData->rSrcPortID.u64ClockId, 0u);
+    (void)GPTP_MD_Uint32ToArray(&pu8Hdr[GPTP_FR_SC_PORT_ID_OFFSET], \
+                                (((uint32_t)ptxData->rSrcPortID.u16PortId << 16u) | (uint32_t)ptxData->u16SequenceId), 0u);
+
+    /* Mesage type specific data */
+    switch (ptxData->eMsgId)
+    {
+        case GPTP_DEF_MSG_TYPE_SYNC:
+        case GPTP_DEF_MSG_TYPE_PD_REQ:
+            /* Log message period */
+            (void)GPTP_MD_Uint8ToArray(&pu8Hdr[GPTP_FR_MSG_PER_LOG_OFFSET], (uint8_t)ptxData->s8LogMessagePeriod, 0u);
+        break;
+
+        case GPTP_DEF_MSG_TYPE_FOLLOW_UP:
+            /* Log message period */
+            (void)GPTP_MD_Uint8ToArray(&pu8Hdr[GPTP_FR_MSG_PER_LOG_OFFSET], (uint8_t)ptxData->s8LogMessagePeriod, 0u);
+
+            /* Correction field */
+            (void)GPTP_MD_Uint64ToArray(&pu8Hdr[GPTP_FR_CORR_OFFSET], ptxData->u64CorrectionSubNs, 0u);
+
+            /* Precise origin timestamp */
+            (void)GPTP_MD_Uint48ToArray(&pu8Hdr[GPTP_FR_TS_S_OFFSET], (ptxData->rTs.u64TimeStampS & (uint64_t)GPTP_DEF_BIT_MASK_16L_48H), 0u);
+            (void)GPTP_MD_Uint32ToArray(&pu8Hdr[GPTP_FR_TS_NS_OFFSET], ptxData->rTs.u32TimeStampNs, 0u);
+
+            /* Follow up TLV - rate ratio and the GM change information */
+            (void)GPTP_MD_Uint32ToArray(&pu8Hdr[GPTP_FR_CS_RATE_RATIO_OFFSET], GPTP_FRAME_CsRateRatio(ptxData->f64RateRatio), 0u);
+            (void)GPTP_MD_Uint16ToArray(&pu8Hdr[GPTP_FR_GM_TIME_BASE_INDIC], prGptp->prPerDomainParams[u8Domain].u16GmTimeBaseIndicator, 0u);
+            (void)GPTP_MD_Uint32ToArray(&pu8Hdr[GPTP_FR_LAST_GM_PHASE_CHANGE_H], (uint32_t)prGptp->prPerDomainParams[u8Domain].u32LastGmPhaseChangeH, 0u);
+            (void)GPTP_MD_Uint64ToArray(&pu8Hdr[GPTP_FR_LAST_GM_PHASE_CHANGE_L], (uint64_t)prGptp->prPerDomainParams[u8Domain].u64LastGmPhaseChangeL, 0u);
+            (void)GPTP_MD_Uint32ToArray(&pu8Hdr[GPTP_FR_SCALED_LAST_GM_F_CHANGE], prGptp->prPerDomainParams[u8Domain].u32ScaledLastGmFreqChange, 0u);
+        break;
+
+        case GPTP_DEF_MSG_TYPE_PD_RESP:
+        case GPTP_DEF_MSG_TYPE_PD_RESP_FUP:
+            /* Transport specific (MajorSdoID) follows the received Pdelay request in the compatibility mode */
+            if (true == prGptp->rPerDeviceParams.bSdoIdCompatibilityMode)
+            {
+                u8MsgIdTs = ((uint8_t)(prGptp->prPdelayMachines[u8Port].rPdReqMsgRx.u8MajorSdoId << 4u) | (uint8_t)ptxData->eMsgId);
+            }
+
+            else
+            {
+                u8MsgIdTs = ((uint8_t)(0x1u << 4u) | (uint8_t)ptxData->eMsgId);
+            }
+
+            (void)GPTP_MD_Uint8ToArray(&pu8Hdr[GPTP_FR_MSG_ID_OFFSET], u8MsgIdTs, 0u);
+
+            /* Domain number - subdomain of the Pdelay request */
+            (void)GPTP_MD_Uint8ToArray(&pu8Hdr[GPTP_FR_DOMAIN_NUM], ptxData->u8SubdomainNumber, 0u);
+
+            /* Timestamp, requesting port identity */
+            (void)GPTP_MD_Uint48ToArray(&pu8Hdr[GPTP_FR_TS_S_OFFSET], (ptxData->rTs.u64TimeStampS & (uint64_t)GPTP_DEF_BIT_MASK_16L_48H), 0u);
+            (void)GPTP_MD_Uint32ToArray(&pu8Hdr[GPTP_FR_TS_NS_OFFSET], ptxData->rTs.u32TimeStampNs, 0u);
+            (void)GPTP_MD_Uint64ToArray(&pu8Hdr[GPTP_FR_RQ_CLK_ID_OFFSET], ptxData->rRequesting.u64ClockId, 0u);
+            (void)GPTP_MD_Uint16ToArray(&pu8Hdr[GPTP_FR_RQ_PORT_ID_OFFSET], (ptxData->rRequesting.u16PortId + 1u), 0u);
+        break;
+
+        case GPTP_DEF_MSG_TYPE_SIGNALING:
+            /* Source MAC address - the template of the domain is sent from its current slave port */
+            (void)GPTP_MD_Uint48ToArray(&ptxData->pau8TxBuffPtr[GPTP_FR_SRC_MAC_OFFSET], prGptp->prPerPortParams[u8Port].rSourceMac.u48Mac, 0u);
+
+            /* Time synchronization interval of the Message interval request TLV */
+            (void)GPTP_MD_Uint8ToArray(&pu8Hdr[GPTP_FR_SIG_TIME_SYNC_OFFSET], (uint8_t)ptxData->s8LogMessagePeriod, 0u);
+        break;
+
+        default:
+        break;
+    }
+}
+#endif /* GPTP_TX_TEMPLATES */
+
+/*!
+ * @brief The function builds PTP ethernet frame to send
+ *
+ * The function builds PTP ethernet frame to send. With GPTP_TX_TEMPLATES
+ * defined, the complete frame is built only once into the machine TX buffer,
+ * the following calls patch just the fields which differ between transmissions.
+ *
+ * @param[in] prGptp Pointer to global data structure
+ * @param[in] ptxData Pointer to tx data buffer
+ * @param[in] u8Domain Domain number
+ * @param[in] u8Port gPTP port number
+ *
+ * @ requirements 529199
+ * @ requirements 529211
+ * @ requirements 152451
+ * @ requirements 152455
+ * @ requirements 162145
+ * @ requirements 120467
+ * @ requirements 120456
+ * @ requirements 162147
+ */
+void GPTP_FRAME_BuildTx(const gptp_def_data_t *prGptp,
+                        gptp_def_tx_data_t *ptxData,
+                        const uint8_t u8Domain,
+                        const uint8_t u8Port)
+{
+#ifdef GPTP_TX_TEMPLATES
+    if (true == ptxData->bTemplateValid)
+    {
+        GPTP_FRAME_TemplatePatch(prGptp, ptxData, u8Domain, u8Port);
+    }
+
+    else
+    {
+        GPTP_FRAME_FrameBuild(prGptp, ptxData, u8Domain, u8Port);
+        ptxData->bTemplateValid = true;
+    }
+#else
+    GPTP_FRAME_FrameBuild(prGptp, ptxData, u8Domain, u8Port);
+#endif /* GPTP_TX_TEMPLATES */
+}
+
+#ifdef GPTP_TX_TEMPLATES
+/*!
+ * @brief The function invalidates the TX frame templates of the gPTP port
+ *
+ * Templates of the Pdelay machine of the port, of all Sync machines on the port
+ * and the Signaling templates of all domains are rebuilt on the next transmission.
+ *
+ * @param[in] prGptp Pointer to global data structure
+ * @param[in] u8Port gPTP port number
+ */
+void GPTP_FRAME_TemplatesInvalidate(const gptp_def_data_t *prGptp,
+                                    const uint8_t u8Port)
+{
+    gptp_def_domain_t   *prDomain;
+    gptp_def_sync_t     *prSyncMachine;
+    gptp_def_pdelay_t   *prPdelayMachine;
+    uint8_t             u8Domain;
+    uint8_t             u8Machine;
+
+    /* Pdelay */
+    if (u8Port < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines)
+    {
+        prPdelayMachine = &prGptp->prPdelayMachines[u8Port];
+        prPdelayMachine->rTxDataReq.bTemplateValid = false;
+        prPdelayMachine->rTxDataResp.bTemplateValid = false;
+        prPdelayMachine->rTxDataReFu.bTemplateValid = false;
+    }
+
+    for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+    {
+        prDomain = &prGptp->prPerDomainParams[u8Domain];
+
+        /* Signaling is sent from the slave port of the domain */
+        prDomain->rTxDataSig.bTemplateValid = false;
+
+        /* Sync */
+        for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
+        {
+            prSyncMachine = &prDomain->prSyncMachines[u8Machine];
+
+            if (u8Port == prSyncMachine->u8GptpPort)
+            {
+                prSyncMachine->rTxDataSyn.bTemplateValid = false;
+                prSyncMachine->rTxDataFup.bTemplateValid = false;
+            }
+        }
+    }
 }
+#endif /* GPTP_TX_TEMPLATES */
 
 /*******************************************************************************
  * EOF
@@ -0,0 +1,319 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+#include "gptp_internal.h"
+#include "gptp_fxp.h"
+
+#ifdef GPTP_FIXED_POINT
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Lower 32 bits mask */
+#define FXP_MASK_32L                    0x00000000FFFFFFFFu
+/* Count of bits processed in one step of the long division */
+#define FXP_DIV_STEP_BITS               16u
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static int64_t GPTP_FXP_Float64ToFixed(float64_t f64Value, float64_t f64Scale);
+static uint64_t GPTP_FXP_UDivQ32(uint64_t u64Numerator, uint64_t u64Denominator);
+static uint64_t GPTP_FXP_UMulQ32(uint64_t u64Value, uint64_t u64Ratio);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/*!
+ * @brief The function converts float64_t to the fixed-point format.
+ *
+ * @param[in] f64Value Value to be converted.
+ * @param[in] f64Scale Value of 1.0 in the target format.
+ * @return Rounded fixed-point value.
+ */
+static int64_t GPTP_FXP_Float64ToFixed(float64_t f64Value,
+                                       float64_t f64Scale)
+{
+    float64_t f64Scaled;
+
+    f64Scaled = f64Value * f64Scale;
+
+    if (0.0 > f64Scaled)
+    {
+        f64Scaled -= 0.5;
+    }
+    else
+    {
+        f64Scaled += 0.5;
+    }
+
+    return (int64_t)f64Scaled;
+}
+
+/*!
+ * @brief The function calculates (u64Numerator << 32) / u64Denominator.
+ *
+ * @details The 96-bit dividend never exists, the division runs in two 16-bit
+ *          steps over the remainder, so the denominator must be below 2^48.
+ *
+ * @param[in] u64Numerator Numerator.
+ * @param[in] u64Denominator Denominator.
+ * @return Truncated quotient.
+ */
+static uint64_t GPTP_FXP_UDivQ32(uint64_t u64Numerator,
+                                 uint64_t u64Denominator)
+{
+    uint64_t u64Quotient;
+    uint64_t u64Remainder;
+    uint8_t  u8Step;
+
+    u64Quotient = u64Numerator / u64Denominator;
+    u64Remainder = u64Numerator % u64Denominator;
+
+    for (u8Step = 0u; u8Step < (GPTP_FXP_Q32_FRAC_BITS / FXP_DIV_STEP_BITS); u8Step++)
+    {
+        u64Remainder <<= FXP_DIV_STEP_BITS;
+        u64Quotient = (u64Quotient << FXP_DIV_STEP_BITS) | (u64Remainder / u64Denominator);
+        u64Remainder = u64Remainder % u64Denominator;
+    }
+
+    return u64Quotient;
+}
+
+/*!
+ * @brief The function calculates (u64Value * u64Ratio) >> 32.
+ *
+ * @details The 128-bit product is assembled from 32-bit partial products.
+ *
+ * @param[in] u64Value Value.
+ * @param[in] u64Ratio Ratio in Q32.32.
+ * @return Rounded product.
+ */
+static uint64_t GPTP_FXP_UMulQ32(uint64_t u64Value,
+                                 uint64_t u64Ratio)
+{
+    uint64_t u64LoLo;
+    uint64_t u64LoHi;
+    uint64_t u64HiLo;
+    uint64_t u64Mid;
+    uint64_t u64Hi;
+
+    u64LoLo = (u64Value & FXP_MASK_32L) * (u64Ratio & FXP_MASK_32L);
+    u64LoHi = (u64Value & FXP_MASK_32L) * (u64Ratio >> 32u);
+    u64HiLo = (u64Value >> 32u) * (u64Ratio & FXP_MASK_32L);
+    u64Hi = (u64Value >> 32u) * (u64Ratio >> 32u);
+
+    /* Bits 32..95 of the product, the carry of the middle column goes up */
+    u64Mid = (u64LoLo >> 32u) + (u64LoHi & FXP_MASK_32L) + (u64HiLo & FXP_MASK_32L);
+    u64Hi += (u64LoHi >> 32u) + (u64HiLo >> 32u) + (u64Mid >> 32u);
+
+    /* Round by the highest dropped bit */
+    return (u64Hi << 32u) + (u64Mid & FXP_MASK_32L) + ((u64LoLo >> 31u) & 1u);
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*!
+ * @brief   This function converts float64_t to Q32.32.
+ *
+ * @param[in] f64Value Value to be converted.
+ * @return Value rounded to the nearest Q32.32 step.
+ */
+int64_t GPTP_FXP_Float64ToQ32(float64_t f64Value)
+{
+    return GPTP_FXP_Float64ToFixed(f64Value, (float64_t)GPTP_FXP_Q32_ONE);
+}
+
+/*!
+ * @brief   This function converts Q32.32 to float64_t.
+ *
+ * @param[in] s64Value Value in Q32.32.
+ * @return Exact float64_t image of the value.
+ */
+float64_t GPTP_FXP_Q32ToFloat64(int64_t s64Value)
+{
+    return (float64_t)s64Value / (float64_t)GPTP_FXP_Q32_ONE;
+}
+
+/*!
+ * @brief   This function converts float64_t to Q48.16.
+ *
+ * @param[in] f64Value Value to be converted.
+ * @return Value rounded to the nearest Q48.16 step.
+ */
+int64_t GPTP_FXP_Float64ToQ16(float64_t f64Value)
+{
+    return GPTP_FXP_Float64ToFixed(f64Value, (float64_t)GPTP_FXP_Q16_ONE);
+}
+
+/*!
+ * @brief   This function converts Q48.16 to float64_t.
+ *
+ * @param[in] s64Value Value in Q48.16.
+ * @return Exact float64_t image of the value.
+ */
+float64_t GPTP_FXP_Q16ToFloat64(int64_t s64Value)
+{
+    return (float64_t)s64Value / (float64_t)GPTP_FXP_Q16_ONE;
+}
+
+/*!
+ * @brief   This function converts the averaging weight to Q16.
+ *
+ * @details The weight is clamped to the <0.0, 1.0> range.
+ *
+ * @param[in] f64Weight Weight of the previous average.
+ * @return Weight in Q16.
+ */
+uint32_t GPTP_FXP_Float64ToWeight(float64_t f64Weight)
+{
+    uint32_t u32Weight;
+
+    if (0.0 >= f64Weight)
+    {
+        u32Weight = 0u;
+    }
+    else if (1.0 <= f64Weight)
+    {
+        u32Weight = (uint32_t)GPTP_FXP_Q16_ONE;
+    }
+    else
+    {
+        u32Weight = (uint32_t)GPTP_FXP_Float64ToFixed(f64Weight, (float64_t)GPTP_FXP_Q16_ONE);
+    }
+
+    return u32Weight;
+}
+
+/*!
+ * @brief   This function calculates ratio of two intervals.
+ *
+ * @param[in] u64Numerator Numerator interval [ns].
+ * @param[in] u64Denominator Denominator interval [ns], must be non-zero and
+ *            below 2^47.
+ * @return u64Numerator / u64Denominator in Q32.32, truncated.
+ */
+int64_t GPTP_FXP_RatioCalc(uint64_t u64Numerator,
+                           uint64_t u64Denominator)
+{
+    return (int64_t)GPTP_FXP_UDivQ32(u64Numerator, u64Denominator);
+}
+
+/*!
+ * @brief   This function multiplies a value by the rate ratio.
+ *
+ * @param[in] s64Value Value in any fixed-point format.
+ * @param[in] s64Ratio Rate ratio in Q32.32.
+ * @return s64Value * s64Ratio in the format of s64Value, rounded.
+ */
+int64_t GPTP_FXP_RatioMul(int64_t s64Value,
+                          int64_t s64Ratio)
+{
+    uint64_t u64Result;
+    bool     bNegative;
+
+    bNegative = ((0 > s64Value) != (0 > s64Ratio));
+    u64Result = GPTP_FXP_UMulQ32(GPTP_INTERNAL_AbsInt64ToUint64(s64Value), GPTP_INTERNAL_AbsInt64ToUint64(s64Ratio));
+
+    return (true == bNegative) ? -((int64_t)u64Result) : (int64_t)u64Result;
+}
+
+/*!
+ * @brief   This function divides a value by the rate ratio.
+ *
+ * @param[in] s64Value Value in any fixed-point format.
+ * @param[in] s64Ratio Rate ratio in Q32.32, must be non-zero and its absolute
+ *            value below 2^47.
+ * @return s64Value / s64Ratio in the format of s64Value, truncated.
+ */
+int64_t GPTP_FXP_RatioDiv(int64_t s64Value,
+                          int64_t s64Ratio)
+{
+    uint64_t u64Result;
+    bool     bNegative;
+
+    bNegative = ((0 > s64Value) != (0 > s64Ratio));
+    u64Result = GPTP_FXP_UDivQ32(GPTP_INTERNAL_AbsInt64ToUint64(s64Value), GPTP_INTERNAL_AbsInt64ToUint64(s64Ratio));
+
+    return (true == bNegative) ? -((int64_t)u64Result) : (int64_t)u64Result;
+}
+
+/*!
+ * @brief   This function applies exponential averaging.
+ *
+ * @details Result is (w * s64Average) + ((1 - w) * s64Sample) computed as
+ *          s64Average + ((1 - w) * (s64Sample - s64Average)).
+ *
+ * @param[in] s64Average Previous average in any fixed-point format.
+ * @param[in] s64Sample New sample in the same format.
+ * @param[in] u32WeightQ16 Weight of the previous average in Q16.
+ * @return New average, rounded.
+ */
+int64_t GPTP_FXP_Average(int64_t s64Average,
+                         int64_t s64Sample,
+                         uint32_t u32WeightQ16)
+{
+    int64_t s64Step;
+
+    s64Step = (s64Sample - s64Average) * ((int64_t)GPTP_FXP_Q16_ONE - (int64_t)u32WeightQ16);
+
+    /* Round half away from zero, so the average is symmetric for both signs */
+    if (0 > s64Step)
+    {
+        s64Step = -((-s64Step + (GPTP_FXP_Q16_ONE / 2)) / GPTP_FXP_Q16_ONE);
+    }
+    else
+    {
+        s64Step = (s64Step + (GPTP_FXP_Q16_ONE / 2)) / GPTP_FXP_Q16_ONE;
+    }
+
+    return s64Average + s64Step;
+}
+
+/*!
+ * @brief   This function multiplies a value by the Q16 gain.
+ *
+ * @param[in] s32Value Value to be multiplied.
+ * @param[in] s64GainQ16 Gain in Q16, its absolute value must be below 2^32.
+ * @return s32Value * s64GainQ16 rounded towards zero and saturated to int32_t.
+ */
+int32_t GPTP_FXP_GainMul(int32_t s32Value,
+                         int64_t s64GainQ16)
+{
+    int64_t s64Result;
+
+    s64Result = ((int64_t)s32Value * s64GainQ16) / GPTP_FXP_Q16_ONE;
+
+    if (s64Result <= (int64_t)GPTP_DEF_INT32_MIN)
+    {
+        s64Result = (int64_t)GPTP_DEF_INT32_MIN;
+    }
+    else if (s64Result >= (int64_t)GPTP_DEF_INT32_MAX)
+    {
+        s64Result = (int64_t)GPTP_DEF_INT32_MAX;
+    }
+    else
+    {
+        /* Inside of the range */
+    }
+
+    return (int32_t)s64Result;
+}
+
+#endif /* GPTP_FIXED_POINT */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,501 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+#include "gptp_internal.h"
+#include "gptp_hold.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Count of samples needed for the fit, two are left for the residual variance */
+#define HOLD_MIN_SAMPLES                4u
+/* Average of the frequency correction is kept in Q8 */
+#define HOLD_FREQ_Q8_ONE                256
+/* Bound is three standard errors of the fit */
+#define HOLD_BOUND_SIGMAS               3.0
+/* Value of an unknown or unlimited time [ns] */
+#define HOLD_TIME_INF                   0xFFFFFFFFFFFFFFFFu
+/* Largest time converted from float64_t, below the HOLD_TIME_INF [ns] */
+#define HOLD_TIME_MAX_F64               1.8e19
+/* Nanoseconds in one second */
+#define HOLD_NS_IN_SECOND               1000000000.0
+/* Seconds in one hour */
+#define HOLD_S_IN_HOUR                  3600.0
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static float64_t GPTP_HOLD_Sqrt(float64_t f64Value);
+static uint64_t GPTP_HOLD_ToNs(float64_t f64Value);
+static float64_t GPTP_HOLD_RelS(const gptp_def_holdover_t *cprHold,
+                                uint64_t u64TimeNs);
+static float64_t GPTP_HOLD_Bound(const gptp_def_holdover_t *cprHold,
+                                 float64_t f64FromS,
+                                 float64_t f64ToS,
+                                 uint64_t u64OffsetNs);
+static void GPTP_HOLD_Fit(gptp_def_holdover_t *prHold);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/*!
+ * @brief The function calculates the square root.
+ *
+ * @details Newton iteration, it runs once per averaging interval only.
+ *
+ * @param[in] f64Value Non-negative value.
+ * @return Square root of the value, 0 for the negative value.
+ */
+static float64_t GPTP_HOLD_Sqrt(float64_t f64Value)
+{
+    float64_t f64Root;
+    float64_t f64Prev;
+    uint8_t   u8Iter;
+
+    f64Root = 0.0;
+    if (0.0 < f64Value)
+    {
+        f64Root = (1.0 < f64Value) ? f64Value : 1.0;
+        for (u8Iter = 0u; u8Iter < 128u; u8Iter++)
+        {
+            f64Prev = f64Root;
+            f64Root = 0.5 * (f64Root + (f64Value / f64Root));
+            if (!(f64Root < f64Prev))
+            {
+                break;
+            }
+        }
+    }
+
+    return f64Root;
+}
+
+/*!
+ * @brief The function converts the time to the unsigned integer.
+ *
+ * @param[in] f64Value Time [ns].
+ * @return Time saturated to 0 and HOLD_TIME_INF [ns].
+ */
+static uint64_t GPTP_HOLD_ToNs(float64_t f64Value)
+{
+    uint64_t u64Result;
+
+    if (!(0.0 < f64Value))
+    {
+        u64Result = 0u;
+    }
+    else if (HOLD_TIME_MAX_F64 < f64Value)
+    {
+        u64Result = HOLD_TIME_INF;
+    }
+    else
+    {
+        u64Result = (uint64_t)f64Value;
+    }
+
+    return u64Result;
+}
+
+/*!
+ * @brief The function returns the time relative to the reference of the fit.
+ *
+ * @param[in] cprHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Free running time [ns].
+ * @return Time from the reference of the fit [s].
+ */
+static float64_t GPTP_HOLD_RelS(const gptp_def_holdover_t *cprHold,
+                                uint64_t u64TimeNs)
+{
+    float64_t f64RelS;
+
+    if (u64TimeNs >= cprHold->u64FitRefNs)
+    {
+        f64RelS = (float64_t)(u64TimeNs - cprHold->u64FitRefNs) / HOLD_NS_IN_SECOND;
+    }
+    else
+    {
+        f64RelS = -((float64_t)(cprHold->u64FitRefNs - u64TimeNs) / HOLD_NS_IN_SECOND);
+    }
+
+    return f64RelS;
+}
+
+/*!
+ * @brief The function estimates the bound of the time error accumulated in the holdover.
+ *
+ * @details The frequency error is the error of the fitted frequency plus the
+ *          error of the fitted drift times the time from the reference, its
+ *          integral over the holdover is the time error.
+ *
+ * @param[in] cprHold Pointer to the holdover model.
+ * @param[in] f64FromS Holdover start relative to the reference of the fit [s].
+ * @param[in] f64ToS Holdover end relative to the reference of the fit [s].
+ * @param[in] u64OffsetNs Absolute offset to the GM at the holdover start [ns].
+ * @return Time error bound [ns].
+ */
+static float64_t GPTP_HOLD_Bound(const gptp_def_holdover_t *cprHold,
+                                 float64_t f64FromS,
+                                 float64_t f64ToS,
+                                 uint64_t u64OffsetNs)
+{
+    float64_t f64Quad;
+
+    f64Quad = ((f64ToS * f64ToS) - (f64FromS * f64FromS)) / 2.0;
+    f64Quad = (0.0 > f64Quad) ? -f64Quad : f64Quad;
+
+    return (float64_t)u64OffsetNs + (HOLD_BOUND_SIGMAS * ((cprHold->f64FreqSdPpb * (f64ToS - f64FromS)) +
+                                                         (cprHold->f64AgingSdPpbS * f64Quad)));
+}
+
+/*!
+ * @brief The function fits the frequency correction and its drift over the history.
+ *
+ * @details Least-squares line over the sample times, the reference is the mean
+ *          time of the samples, where the errors of the frequency and the drift
+ *          are not correlated.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ */
+static void GPTP_HOLD_Fit(gptp_def_holdover_t *prHold)
+{
+    uint64_t  u64NewestNs;
+    float64_t f64MeanT;
+    float64_t f64MeanY;
+    float64_t f64Sxx;
+    float64_t f64Sxy;
+    float64_t f64Ssr;
+    float64_t f64T;
+    float64_t f64Y;
+    float64_t f64Slope;
+    float64_t f64Count;
+    uint8_t   u8Idx;
+    uint8_t   u8Cur;
+
+    prHold->bFitValid = false;
+
+    if (HOLD_MIN_SAMPLES <= prHold->u8Count)
+    {
+        u64NewestNs = prHold->au64TimeNs[(prHold->u8Head + prHold->u8Count - 1u) % GPTP_DEF_HOLD_HIST_LEN];
+        f64Count = (float64_t)prHold->u8Count;
+
+        /* Times relative to the newest sample keep the precision */
+        f64MeanT = 0.0;
+        f64MeanY = 0.0;
+        for (u8Idx = 0u; u8Idx < prHold->u8Count; u8Idx++)
+        {
+            u8Cur = (uint8_t)((prHold->u8Head + u8Idx) % GPTP_DEF_HOLD_HIST_LEN);
+            f64MeanT -= (float64_t)(u64NewestNs - prHold->au64TimeNs[u8Cur]) / HOLD_NS_IN_SECOND;
+            f64MeanY += (float64_t)prHold->as32FreqQ8[u8Cur] / (float64_t)HOLD_FREQ_Q8_ONE;
+        }
+        f64MeanT /= f64Count;
+        f64MeanY /= f64Count;
+
+        f64Sxx = 0.0;
+        f64Sxy = 0.0;
+        for (u8Idx = 0u; u8Idx < prHold->u8Count; u8Idx++)
+        {
+            u8Cur = (uint8_t)((prHold->u8Head + u8Idx) % GPTP_DEF_HOLD_HIST_LEN);
+            f64T = (-((float64_t)(u64NewestNs - prHold->au64TimeNs[u8Cur]) / HOLD_NS_IN_SECOND)) - f64MeanT;
+            f64Y = ((float64_t)prHold->as32FreqQ8[u8Cur] / (float64_t)HOLD_FREQ_Q8_ONE) - f64MeanY;
+            f64Sxx += f64T * f64T;
+            f64Sxy += f64T * f64Y;
+        }
+
+        if (0.0 < f64Sxx)
+        {
+            f64Slope = f64Sxy / f64Sxx;
+
+            /* Residual variance of the line */
+            f64Ssr = 0.0;
+            for (u8Idx = 0u; u8Idx < prHold->u8Count; u8Idx++)
+            {
+                u8Cur = (uint8_t)((prHold->u8Head + u8Idx) % GPTP_DEF_HOLD_HIST_LEN);
+                f64T = (-((float64_t)(u64NewestNs - prHold->au64TimeNs[u8Cur]) / HOLD_NS_IN_SECOND)) - f64MeanT;
+                f64Y = (((float64_t)prHold->as32FreqQ8[u8Cur] / (float64_t)HOLD_FREQ_Q8_ONE) - f64MeanY) - (f64Slope * f64T);
+                f64Ssr += f64Y * f64Y;
+            }
+            f64Ssr /= (f64Count - 2.0);
+
+            prHold->u64FitRefNs = u64NewestNs - (uint64_t)(-f64MeanT * HOLD_NS_IN_SECOND);
+            prHold->f64FreqPpb = f64MeanY;
+            prHold->f64AgingPpbS = f64Slope;
+            prHold->f64FreqSdPpb = GPTP_HOLD_Sqrt(f64Ssr / f64Count);
+            prHold->f64AgingSdPpbS = GPTP_HOLD_Sqrt(f64Ssr / f64Sxx);
+            prHold->bFitValid = true;
+        }
+    }
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*!
+ * @brief   This function initializes the holdover frequency model.
+ *
+ * @param[out] prHold Pointer to the holdover model.
+ * @param[in] u8SampleS Averaging interval of the history [s], 0 for GPTP_DEF_HOLD_SAMPLE_S_DEF.
+ * @param[in] u32SpecNs Time error specification of the holdover [ns], 0 for no check.
+ */
+void GPTP_HOLD_Init(gptp_def_holdover_t *prHold,
+                    uint8_t u8SampleS,
+                    uint32_t u32SpecNs)
+{
+    prHold->u64SampleNs = (uint64_t)((0u == u8SampleS) ? GPTP_DEF_HOLD_SAMPLE_S_DEF : u8SampleS) * (uint64_t)GPTP_DEF_NS_IN_SECONDS;
+    prHold->u32SpecNs = u32SpecNs;
+    prHold->u8Head = 0u;
+    prHold->u8Count = 0u;
+    prHold->u32AvgCnt = 0u;
+    prHold->s64AvgSumPpb = 0;
+    prHold->u64AvgStartNs = 0u;
+    prHold->u64AvgLastNs = 0u;
+    prHold->bFitValid = false;
+    prHold->u64FitRefNs = 0u;
+    prHold->f64FreqPpb = 0.0;
+    prHold->f64AgingPpbS = 0.0;
+    prHold->f64FreqSdPpb = 0.0;
+    prHold->f64AgingSdPpbS = 0.0;
+    prHold->s32LastPpb = 0;
+    prHold->bActive = false;
+    prHold->bSpecReported = false;
+    prHold->u64EntryNs = 0u;
+    prHold->u64EntryOffsetNs = 0u;
+    prHold->u64LastApplyNs = 0u;
+}
+
+/*!
+ * @brief   This function records the frequency correction applied to the local clock.
+ *
+ * @details Any correction ends the holdover. Only corrections of the synchronized
+ *          clock are averaged into the history, each full averaging interval
+ *          refits the frequency and its drift.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @param[in] s32Ppb Applied frequency correction [ppb].
+ * @param[in] bSynced The clock is synchronized and the correction is not a clock step.
+ */
+void GPTP_HOLD_Track(gptp_def_holdover_t *prHold,
+                     uint64_t u64TimeNs,
+                     int32_t s32Ppb,
+                     bool bSynced)
+{
+    uint8_t u8Tail;
+    int64_t s64MeanQ8;
+
+    prHold->bActive = false;
+    prHold->s32LastPpb = s32Ppb;
+
+    /* The running average restarts after the clock loses the lock or after a gap */
+    if ((false == bSynced) || (u64TimeNs < prHold->u64AvgLastNs) ||
+        ((u64TimeNs - prHold->u64AvgLastNs) > (2u * prHold->u64SampleNs)))
+    {
+        prHold->u32AvgCnt = 0u;
+    }
+
+    if (true == bSynced)
+    {
+        if (0u == prHold->u32AvgCnt)
+        {
+            prHold->u64AvgStartNs = u64TimeNs;
+            prHold->s64AvgSumPpb = 0;
+        }
+        prHold->s64AvgSumPpb += (int64_t)s32Ppb;
+        prHold->u32AvgCnt++;
+        prHold->u64AvgLastNs = u64TimeNs;
+
+        if ((u64TimeNs - prHold->u64AvgStartNs) >= prHold->u64SampleNs)
+        {
+            /* The oldest sample is overwritten by the full history */
+            if (GPTP_DEF_HOLD_HIST_LEN == prHold->u8Count)
+            {
+                prHold->u8Head = (uint8_t)((prHold->u8Head + 1u) % GPTP_DEF_HOLD_HIST_LEN);
+                prHold->u8Count--;
+            }
+            u8Tail = (uint8_t)((prHold->u8Head + prHold->u8Count) % GPTP_DEF_HOLD_HIST_LEN);
+            s64MeanQ8 = (prHold->s64AvgSumPpb * HOLD_FREQ_Q8_ONE) / (int64_t)prHold->u32AvgCnt;
+            prHold->as32FreqQ8[u8Tail] = (int32_t)(((int64_t)GPTP_DEF_INT32_MAX < s64MeanQ8) ? (int64_t)GPTP_DEF_INT32_MAX :
+                                                   (((int64_t)GPTP_DEF_INT32_MIN > s64MeanQ8) ? (int64_t)GPTP_DEF_INT32_MIN : s64MeanQ8));
+            prHold->au64TimeNs[u8Tail] = prHold->u64AvgStartNs + ((u64TimeNs - prHold->u64AvgStartNs) / 2u);
+            prHold->u8Count++;
+            prHold->u32AvgCnt = 0u;
+
+            GPTP_HOLD_Fit(prHold);
+        }
+    }
+}
+
+/*!
+ * @brief   This function returns the frequency correction to be applied in the holdover.
+ *
+ * @details The first call after the last correction starts the holdover.
+ *          Without the fitted model, the fallback correction is returned.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @param[in] s32FallbackPpb Correction applied without the fitted model [ppb].
+ * @param[in] u64OffsetNs Absolute offset to the GM at the holdover start [ns].
+ * @return Frequency correction [ppb].
+ */
+int32_t GPTP_HOLD_Enter(gptp_def_holdover_t *prHold,
+                        uint64_t u64TimeNs,
+                        int32_t s32FallbackPpb,
+                        uint64_t u64OffsetNs)
+{
+    if (false == prHold->bActive)
+    {
+        prHold->bActive = true;
+        prHold->bSpecReported = false;
+        prHold->u64EntryNs = u64TimeNs;
+        prHold->u64EntryOffsetNs = u64OffsetNs;
+        prHold->u32AvgCnt = 0u;
+    }
+    prHold->u64LastApplyNs = u64TimeNs;
+
+    prHold->s32LastPpb = s32FallbackPpb;
+    if (true == prHold->bFitValid)
+    {
+        /* Frequency extrapolated along the fitted drift */
+        prHold->s32LastPpb = GPTP_INTERNAL_Float64ToInt32(prHold->f64FreqPpb + (prHold->f64AgingPpbS * GPTP_HOLD_RelS(prHold, u64TimeNs)));
+    }
+
+    return prHold->s32LastPpb;
+}
+
+/*!
+ * @brief   This function checks whether the holdover correction is to be updated.
+ *
+ * @param[in] cprHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @return true in the holdover with the fitted model, once per averaging interval.
+ */
+bool GPTP_HOLD_ApplyDue(const gptp_def_holdover_t *cprHold,
+                        uint64_t u64TimeNs)
+{
+    return (bool)((true == cprHold->bActive) && (true == cprHold->bFitValid) &&
+                  (u64TimeNs >= cprHold->u64LastApplyNs) &&
+                  ((u64TimeNs - cprHold->u64LastApplyNs) >= cprHold->u64SampleNs));
+}
+
+/*!
+ * @brief   This function checks the time error bound against the specification.
+ *
+ * @details Without the fitted model the bound is not known, so it is reported
+ *          as exceeded.
+ *
+ * @param[in,out] prHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @return true once per holdover, when the bound exceeds the specification.
+ */
+bool GPTP_HOLD_SpecExceeded(gptp_def_holdover_t *prHold,
+                            uint64_t u64TimeNs)
+{
+    bool bExceeded;
+
+    bExceeded = false;
+    if ((true == prHold->bActive) && (false == prHold->bSpecReported) && (0u != prHold->u32SpecNs))
+    {
+        bExceeded = true;
+        if (true == prHold->bFitValid)
+        {
+            bExceeded = (bool)((float64_t)prHold->u32SpecNs < GPTP_HOLD_Bound(prHold, GPTP_HOLD_RelS(prHold, prHold->u64EntryNs),
+                                                                              GPTP_HOLD_RelS(prHold, u64TimeNs), prHold->u64EntryOffsetNs));
+        }
+        prHold->bSpecReported = bExceeded;
+    }
+
+    return bExceeded;
+}
+
+/*!
+ * @brief   This function provides the holdover status.
+ *
+ * @param[in] cprHold Pointer to the holdover model.
+ * @param[in] u64TimeNs Current free running time [ns].
+ * @param[out] prInfo Pointer to the holdover status.
+ */
+void GPTP_HOLD_InfoGet(const gptp_def_holdover_t *cprHold,
+                       uint64_t u64TimeNs,
+                       gptp_def_holdover_info_t *prInfo)
+{
+    float64_t f64FromS;
+    float64_t f64NowS;
+    float64_t f64DurS;
+    float64_t f64A;
+    float64_t f64B;
+    float64_t f64C;
+    float64_t f64LimitS;
+    uint64_t  u64OffsetNs;
+
+    prInfo->bActive = cprHold->bActive;
+    prInfo->bModelValid = cprHold->bFitValid;
+    prInfo->u64DurationNs = 0u;
+    prInfo->s32FreqPpb = cprHold->s32LastPpb;
+    prInfo->s32AgingPpbPerHour = 0;
+    prInfo->u64TimeErrorBoundNs = HOLD_TIME_INF;
+    prInfo->u64WithinSpecNs = 0u;
+
+    if ((true == cprHold->bActive) && (u64TimeNs >= cprHold->u64EntryNs))
+    {
+        prInfo->u64DurationNs = u64TimeNs - cprHold->u64EntryNs;
+    }
+
+    if (true == cprHold->bFitValid)
+    {
+        f64NowS = GPTP_HOLD_RelS(cprHold, u64TimeNs);
+        prInfo->s32FreqPpb = GPTP_INTERNAL_Float64ToInt32(cprHold->f64FreqPpb + (cprHold->f64AgingPpbS * f64NowS));
+        prInfo->s32AgingPpbPerHour = GPTP_INTERNAL_Float64ToInt32(cprHold->f64AgingPpbS * HOLD_S_IN_HOUR);
+
+        /* Synchronized clock reports a holdover starting now */
+        f64FromS = f64NowS;
+        u64OffsetNs = 0u;
+        if (true == cprHold->bActive)
+        {
+            f64FromS = GPTP_HOLD_RelS(cprHold, cprHold->u64EntryNs);
+            u64OffsetNs = cprHold->u64EntryOffsetNs;
+        }
+        f64DurS = f64NowS - f64FromS;
+        prInfo->u64TimeErrorBoundNs = GPTP_HOLD_ToNs(GPTP_HOLD_Bound(cprHold, f64FromS, f64NowS, u64OffsetNs));
+
+        if (0u != cprHold->u32SpecNs)
+        {
+            /* Bound(x) = spec for the holdover duration x: A * x^2 + B * x + C = 0 */
+            f64FromS = (0.0 > f64FromS) ? 0.0 : f64FromS;
+            f64A = (HOLD_BOUND_SIGMAS / 2.0) * cprHold->f64AgingSdPpbS;
+            f64B = HOLD_BOUND_SIGMAS * (cprHold->f64FreqSdPpb + (cprHold->f64AgingSdPpbS * f64FromS));
+            f64C = (float64_t)u64OffsetNs - (float64_t)cprHold->u32SpecNs;
+
+            if (!(0.0 > f64C))
+            {
+                f64LimitS = 0.0;
+            }
+            else if (0.0 < f64A)
+            {
+                f64LimitS = (GPTP_HOLD_Sqrt((f64B * f64B) - ((4.0 * f64A) * f64C)) - f64B) / (2.0 * f64A);
+            }
+            else if (0.0 < f64B)
+            {
+                f64LimitS = -f64C / f64B;
+            }
+            else
+            {
+                f64LimitS = HOLD_TIME_MAX_F64;
+            }
+            prInfo->u64WithinSpecNs = GPTP_HOLD_ToNs((f64LimitS - f64DurS) * HOLD_NS_IN_SECOND);
+        }
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -22,11 +22,19 @@
 #include "gptp_port.h"
 #include "gptp.h"
 #include "gptp_internal.h"
+#include "gptp_pi.h"
+#include "gptp_kf.h"
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 static float64_t GPTP_INTERNAL_AbsValue(float64_t f64Input);
+#ifdef GPTP_COUNTERS
+static void GPTP_INTERNAL_HistogramAdd(gptp_def_histogram_t *prHist,
+                                       uint64_t u64StartNs,
+                                       uint64_t u64EndNs);
+static void GPTP_INTERNAL_HistogramClear(gptp_def_histogram_t *prHist);
+#endif /* GPTP_COUNTERS */
 
 /*******************************************************************************
  * Variables
@@ -52,6 +60,79 @@ static gptp_def_counters_t au8PortCntrLookUp[GPTP_COUNTERS_PORT_CNT] =
  ******************************************************************************/
 #ifdef GPTP_COUNTERS
 
+/*!
+ * @brief Latency histogram update function.
+ *
+ * The bin is the position of the most significant bit of the latency, found in
+ * the fixed count of steps, so the update can run from the interrupt context.
+ * Latency with the end before the start is not counted.
+ *
+ * @param[in,out] prHist Pointer to the histogram.
+ * @param[in] u64StartNs Start of the latency [ns].
+ * @param[in] u64EndNs End of the latency [ns].
+ */
+static void GPTP_INTERNAL_HistogramAdd(gptp_def_histogram_t *prHist,
+                                       uint64_t u64StartNs,
+                                       uint64_t u64EndNs)
+{
+    uint64_t    u64LatencyNs;
+    uint64_t    u64Rest;
+    uint8_t     u8Msb;
+    uint8_t     u8Shift;
+    uint8_t     u8Bin;
+
+    if (u64EndNs >= u64StartNs)
+    {
+        u64LatencyNs = u64EndNs - u64StartNs;
+        u8Bin = 0u;
+
+        if ((u64LatencyNs >> GPTP_DEF_HIST_FIRST_SHIFT) != 0u)
+        {
+            /* Binary search of the most significant bit, six steps */
+            u64Rest = u64LatencyNs;
+            u8Msb = 0u;
+            for (u8Shift = 32u; 0u < u8Shift; u8Shift >>= 1u)
+            {
+                if ((u64Rest >> u8Shift) != 0u)
+                {
+                    u64Rest >>= u8Shift;
+                    u8Msb += u8Shift;
+                }
+            }
+
+            u8Bin = (uint8_t)(u8Msb - GPTP_DEF_HIST_FIRST_SHIFT + 1u);
+            if (GPTP_DEF_HIST_BINS <= u8Bin)
+            {
+                u8Bin = (uint8_t)(GPTP_DEF_HIST_BINS - 1u);
+            }
+        }
+
+        prHist->au32Bins[u8Bin] = prHist->au32Bins[u8Bin] + 1u;
+        prHist->u32Count = prHist->u32Count + 1u;
+        if (u64LatencyNs > prHist->u64MaxNs)
+        {
+            prHist->u64MaxNs = u64LatencyNs;
+        }
+    }
+}
+
+/*!
+ * @brief Latency histogram clear function.
+ *
+ * @param[out] prHist Pointer to the histogram.
+ */
+static void GPTP_INTERNAL_HistogramClear(gptp_def_histogram_t *prHist)
+{
+    uint8_t u8Bin;
+
+    for (u8Bin = 0u; u8Bin < GPTP_DEF_HIST_BINS; u8Bin++)
+    {
+        prHist->au32Bins[u8Bin] = 0u;
+    }
+    prHist->u32Count = 0u;
+    prHist->u64MaxNs = 0u;
+}
+
 /*!
  * @brief Port counter increment function.
  *
@@ -162,7 +243,6 @@ gptp_err_type_t GPTP_INTERNAL_GetStatsValue(const gptp_def_data_t *prGptp,
     uint8_t                     u8Cntr;
     uint8_t                     u8CntrLookUp;
     uint8_t                     u8Domain;
-    uint8_t                     u8DomainLookup;
     uint8_t                     u8DomainIndex;
     bool                        bDomainFound;
     bool                        bCntrFound;
@@ -220,18 +300,10 @@ gptp_err_type_t GPTP_INTERNAL_GetStatsValue(const gptp_def_data_t *prGptp,
     else
     {
         u8Domain = (uint8_t)u16Domain;
-        bDomainFound = false;
         u8DomainIndex = 0u;
 
         /* Find the domain index by domain number */
-        for (u8DomainLookup = 0u; u8DomainLookup < prGptp->rPerDeviceParams.u8NumberOfDomains; u8DomainLookup++)
-        {
-            if (u8Domain == prGptp->prPerDomainParams[u8DomainLookup].u8DomainNumber)
-            {
-                u8DomainIndex = u8DomainLookup;
-                bDomainFound = true;
-            }
-        }
+        bDomainFound = GPTP_INTERNAL_DomainLookup(prGptp, u8Domain, &u8DomainIndex);
 
         /* If the domain index found by the domain number */
         if (true == bDomainFound)
@@ -336,6 +408,182 @@ void GPTP_INTERNAL_ClearStats(const gptp_def_data_t *prGptp)
     }
 }
 
+/*!
+ * @brief Port latency histogram update function.
+ *
+ * This function adds the latency into the port histogram.
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ * @param[in] u8Port Respective gPTP port.
+ * @param[in] eHist Port histogram to update.
+ * @param[in] u64StartNs Start of the latency [ns].
+ * @param[in] u64EndNs End of the latency [ns].
+ */
+void GPTP_INTERNAL_PortHistAdd(const gptp_def_data_t *prGptp,
+                               uint8_t u8Port,
+                               gptp_def_hist_id_t eHist,
+                               uint64_t u64StartNs,
+                               uint64_t u64EndNs)
+{
+    if ((u8Port < prGptp->rPerDeviceParams.u8PortsCount) && (GPTP_DEF_HIST_PORT_CNT > (uint32_t)eHist))
+    {
+        GPTP_INTERNAL_HistogramAdd(&prGptp->prCntrsPort[u8Port].arHistPort[eHist], u64StartNs, u64EndNs);
+    }
+}
+
+/*!
+ * @brief Sync residence time histogram update function.
+ *
+ * This function adds the residence time into the histogram of the sync machine.
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ * @param[in] u8Domain Respective gPTP domain index.
+ * @param[in] u8Machine Respective sync machine of the domain.
+ * @param[in] u64StartNs Start of the residence [ns].
+ * @param[in] u64EndNs End of the residence [ns].
+ */
+void GPTP_INTERNAL_DomainHistAdd(const gptp_def_data_t *prGptp,
+                                 uint8_t u8Domain,
+                                 uint8_t u8Machine,
+                                 uint64_t u64StartNs,
+                                 uint64_t u64EndNs)
+{
+    if (u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains)
+    {
+        if (u8Machine < prGptp->prPerDomainParams[u8Domain].u8NumberOfSyncsPerDom)
+        {
+            GPTP_INTERNAL_HistogramAdd(&prGptp->prPerDomainParams[u8Domain].prCntrsDom[u8Machine].rHistResidence, u64StartNs, u64EndNs);
+        }
+    }
+}
+
+/*!
+ *
+ * @brief       This function gets the latency histogram.
+ *
+ * @details     Port histograms are read with the domain 0xFFFF, the residence
+ *              time histogram is read by the domain number and the sync machine.
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ * @param[in] u16Domain Domain number (uint16). Value 0xFFFF reads port histogram.
+ * @param[in] u8Port Port number or sync machine of the domain.
+ * @param[in] eHist gPTP latency histogram.
+ * @param[out] prHist Pointer to the histogram copy.
+ */
+gptp_err_type_t GPTP_INTERNAL_GetHistogram(const gptp_def_data_t *prGptp,
+                                           uint16_t u16Domain,
+                                           uint8_t u8Port,
+                                           gptp_def_hist_id_t eHist,
+                                           gptp_def_histogram_t *prHist)
+{
+    gptp_err_type_t             eError;
+    uint8_t                     u8DomainIndex;
+
+    eError = GPTP_ERR_OK;
+
+    /* Reading of Port histograms */
+    if (u16Domain == 0xFFFFu)
+    {
+        if (u8Port >= prGptp->rPerDeviceParams.u8PortsCount)
+        {
+            eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+            GPTP_ERR_Register(u8Port, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_API_ILLEGAL_PORT_NUM, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+        else if (GPTP_DEF_HIST_PORT_CNT <= (uint32_t)eHist)
+        {
+            eError = GPTP_ERR_API_ILLEGAL_CNTR_ID;
+            GPTP_ERR_Register(u8Port, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_API_ILLEGAL_CNTR_ID, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+        else
+        {
+            *prHist = prGptp->prCntrsPort[u8Port].arHistPort[eHist];
+        }
+    }
+
+    /* Reading of Domain histograms */
+    else
+    {
+        u8DomainIndex = 0u;
+
+        if (false == GPTP_INTERNAL_DomainLookup(prGptp, (uint8_t)u16Domain, &u8DomainIndex))
+        {
+            eError = GPTP_ERR_API_UNKNOWN_DOMAIN;
+            GPTP_ERR_Register(u8Port, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_API_UNKNOWN_DOMAIN, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+        else if (u8Port >= prGptp->prPerDomainParams[u8DomainIndex].u8NumberOfSyncsPerDom)
+        {
+            eError = GPTP_ERR_API_ILLEGAL_MACHINE_ID;
+            GPTP_ERR_Register(u8Port, u8DomainIndex, GPTP_ERR_API_ILLEGAL_MACHINE_ID, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+        else if (GPTP_DEF_HIST_RESIDENCE != eHist)
+        {
+            eError = GPTP_ERR_API_ILLEGAL_CNTR_ID;
+            GPTP_ERR_Register(u8Port, u8DomainIndex, GPTP_ERR_API_ILLEGAL_CNTR_ID, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+        else
+        {
+            *prHist = prGptp->prPerDomainParams[u8DomainIndex].prCntrsDom[u8Port].rHistResidence;
+        }
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief Histograms clear
+ *
+ * This function clears all the gPTP latency histograms
+ *
+ * @param[in] prGptp Pointer to global gPTP data structure.
+ */
+void GPTP_INTERNAL_ClearHistograms(const gptp_def_data_t *prGptp)
+{
+    uint8_t u8Hist;
+    uint8_t u8Port;
+    uint8_t u8Domain;
+
+    for (u8Port = 0u; u8Port < prGptp->rPerDeviceParams.u8PortsCount; u8Port++)
+    {
+        for (u8Hist = 0u; u8Hist < GPTP_DEF_HIST_PORT_CNT; u8Hist++)
+        {
+            GPTP_INTERNAL_HistogramClear(&prGptp->prCntrsPort[u8Port].arHistPort[u8Hist]);
+        }
+    }
+
+    for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+    {
+        for (u8Port = 0u; u8Port < prGptp->prPerDomainParams[u8Domain].u8NumberOfSyncsPerDom; u8Port++)
+        {
+            GPTP_INTERNAL_HistogramClear(&prGptp->prPerDomainParams[u8Domain].prCntrsDom[u8Port].rHistResidence);
+        }
+    }
+}
+
+/*!
+ * @brief Clock step notification function.
+ *
+ * This function is called by the port layer after a time step of the local
+ * clock. The latencies against the hardware timestamps are not measured until
+ * the corrected time leaves the interval made ambiguous by the step.
+ *
+ * @param[in,out] prGptp Pointer to global gPTP data structure.
+ * @param[in] s64StepNs Applied time step [ns].
+ */
+void GPTP_INTERNAL_ClockStepped(gptp_def_data_t *prGptp,
+                                int64_t s64StepNs)
+{
+    uint64_t u64NowNs;
+
+    u64NowNs = GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_CORRECTED));
+
+    /* The times before a backward step are passed once more */
+    prGptp->rPerDeviceParams.u64StepValidFromNs = u64NowNs;
+    if (s64StepNs < 0)
+    {
+        prGptp->rPerDeviceParams.u64StepValidFromNs += GPTP_INTERNAL_AbsInt64ToUint64(s64StepNs);
+    }
+}
+
 #endif /* GPTP_COUNTERS */
 
 #ifdef GPTP_USE_PRINTF
@@ -1011,6 +1259,11 @@ void GPTP_INTERNAL_LinkUp(const uint8_t u8Port,
         prGptp->prPerPortParams[u8Port].bPortEnabled = true;
     }
 
+#ifdef GPTP_TX_TEMPLATES
+    /* Frame templates of the port are rebuilt upon the next transmission */
+    GPTP_FRAME_TemplatesInvalidate(prGptp, u8Port);
+#endif /* GPTP_TX_TEMPLATES */
+
         /* Pdelay */
     if (u8Port < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines)
     {
@@ -1060,6 +1313,12 @@ void GPTP_INTERNAL_LinkUp(const uint8_t u8Port,
                 prSyncMachine->s8SyncIntervalLog = prSyncMachine->s8InitSyncIntervalLog;
                 prSyncMachine->s8OperSyncIntervalLog = prSyncMachine->s8InitSyncIntervalLog;
                 prSyncMachine->bTimerSyncEnabled = true;
+
+                /* Check the sync due again with the initial interval */
+                if (GPTP_DEF_PTP_MASTER == prSyncMachine->bSyncRole)
+                {
+                    GPTP_TIMER_TimerArm(&prSyncMachine->rTimerSyncSend, prSyncMachine->u64TimerSyncSendDue);
+                }
             }
         }
     }
@@ -1128,6 +1387,7 @@ void GPTP_INTERNAL_LinkDown(const uint8_t u8Port,
                 {
                     /* Force to call GPTP_INTERNAL_LosHandle function within the following GPTP_TIMER_TimerPeriodic function */
                     prDomain->u64TimerSyncReceiptTimeoutDue = 1u;
+                    GPTP_TIMER_TimerArm(&prDomain->rTimerReceiptTimeout, prDomain->u64TimerSyncReceiptTimeoutDue);
                 }
             }
         }
@@ -1267,6 +1527,146 @@ uint64_t GPTP_INTERNAL_AbsInt64ToUint64(int64_t s64Number)
     return (s64Number < 0LL) ? ((uint64_t)(-s64Number)) : ((uint64_t)s64Number);
 }
 
+/*!
+ * @brief The function finds domain index by the domain number.
+ *
+ * This function translates domain number on wire to the domain index using
+ * the lookup table built at the initialization.
+ *
+ * @param[in] cprGptp Pointer to global gPTP data structure.
+ * @param[in] u8DomainNumber Domain number on wire.
+ * @param[out] pu8DomainIndex Pointer to the domain index.
+ * @return    true in case the domain is found.
+ */
+bool GPTP_INTERNAL_DomainLookup(const gptp_def_data_t *cprGptp,
+                                uint8_t u8DomainNumber,
+                                uint8_t *pu8DomainIndex)
+{
+    uint8_t u8DomainIndex;
+    bool    bFound;
+
+    bFound = false;
+    u8DomainIndex = cprGptp->rPerDeviceParams.au8DomainLookup[u8DomainNumber];
+
+    if (u8DomainIndex < cprGptp->rPerDeviceParams.u8NumberOfDomains)
+    {
+        *pu8DomainIndex = u8DomainIndex;
+        bFound = true;
+    }
+
+    return bFound;
+}
+
+/*!
+ * @brief The function finds sync machine of the domain by the gPTP port.
+ *
+ * This function finds sync machine index of the domain running on the gPTP
+ * port using the lookup table built at the initialization.
+ *
+ * @param[in] cprDomain Pointer to respective domain structure.
+ * @param[in] u8Port gPTP port.
+ * @param[out] pu8Machine Pointer to the sync machine index.
+ * @return    true in case the sync machine is found.
+ */
+bool GPTP_INTERNAL_SyncMachineLookup(const gptp_def_domain_t *cprDomain,
+                                     uint8_t u8Port,
+                                     uint8_t *pu8Machine)
+{
+    uint8_t u8Machine;
+    bool    bFound;
+
+    bFound = false;
+
+    if (u8Port < GPTP_DEF_PORTS_MAX)
+    {
+        u8Machine = cprDomain->au8SyncMachineLookup[u8Port];
+        if (u8Machine < cprDomain->u8NumberOfSyncsPerDom)
+        {
+            *pu8Machine = u8Machine;
+            bFound = true;
+        }
+    }
+
+    return bFound;
+}
+
+/*!
+ * @brief The function clears the clock servo of the domain.
+ *
+ * This function clears the PI Controller or the Kalman servo, the one
+ * selected for the domain.
+ *
+ * @param[in,out] prDomain Pointer to respective domain structure.
+ */
+void GPTP_INTERNAL_ServoClear(gptp_def_domain_t *prDomain)
+{
+    if (GPTP_DEF_SERVO_KALMAN == prDomain->eServoType)
+    {
+        GPTP_KF_Clear(&prDomain->rKf);
+    }
+    else
+    {
+        GPTP_PI_Clear(&prDomain->rPi);
+    }
+}
+
+/*!
+ * @brief The function updates the clock servo of the domain.
+ *
+ * This function passes the error to the PI Controller or the Kalman servo,
+ * the one selected for the domain.
+ *
+ * @param[in,out] prDomain Pointer to respective domain structure.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @return    New correction value [PPB].
+ */
+int32_t GPTP_INTERNAL_ServoUpdate(gptp_def_domain_t *prDomain,
+                                  int8_t s8SyncInterval,
+                                  int32_t s32ErrorNs)
+{
+    int32_t s32Ppb;
+
+    if (GPTP_DEF_SERVO_KALMAN == prDomain->eServoType)
+    {
+        s32Ppb = GPTP_KF_Update(&prDomain->rKf, s8SyncInterval, s32ErrorNs);
+    }
+    else
+    {
+        s32Ppb = GPTP_PI_Update(&prDomain->rPi, s8SyncInterval, s32ErrorNs);
+    }
+
+    return s32Ppb;
+}
+
+/*!
+ * @brief The function keeps the clock servo of the domain not steering the clock.
+ *
+ * This function aligns the PI Controller or the Kalman servo, the one
+ * selected for the domain, to the correction applied by the servo of
+ * the domain steering the clock, so the switchover to this domain continues
+ * from the current frequency of the clock.
+ *
+ * @param[in,out] prDomain Pointer to respective domain structure.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @param[in] s32AppliedPpb Correction applied to the local clock [PPB].
+ */
+void GPTP_INTERNAL_ServoTrack(gptp_def_domain_t *prDomain,
+                              int8_t s8SyncInterval,
+                              int32_t s32ErrorNs,
+                              int32_t s32AppliedPpb)
+{
+    if (GPTP_DEF_SERVO_KALMAN == prDomain->eServoType)
+    {
+        (void)GPTP_KF_Track(&prDomain->rKf, s8SyncInterval, s32ErrorNs, s32AppliedPpb);
+    }
+    else
+    {
+        (void)GPTP_PI_Track(&prDomain->rPi, s32ErrorNs, s32AppliedPpb);
+    }
+}
+
 /*******************************************************************************
  * EOF
  ******************************************************************************/
@@ -0,0 +1,432 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+#include "gptp_internal.h"
+#include "gptp_fxp.h"
+#include "gptp_kf.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Normalized covariance of the two-point estimate: the phase, phase x frequency and frequency */
+#define KF_P00_INIT                     1
+#define KF_P01_INIT                     1
+#define KF_P11_INIT                     2
+#ifdef GPTP_FIXED_POINT
+/* Limit of the normalized covariance and process noise, keeps the Q32 products and divisions in range */
+#define KF_P_MAX                        16384.0
+/* Limit of the normalized covariance and process noise in Q32 */
+#define KF_P_MAX_Q32                    ((int64_t)16384 * GPTP_FXP_Q32_ONE)
+#endif /* GPTP_FIXED_POINT */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+#ifdef GPTP_FIXED_POINT
+static int64_t GPTP_KF_Limit(int64_t s64ValueQ32);
+static int32_t GPTP_KF_Q16ToPpb(int64_t s64ValueQ16);
+#endif /* GPTP_FIXED_POINT */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#ifdef GPTP_FIXED_POINT
+/*!
+ * @brief The function limits the normalized covariance.
+ *
+ * @param[in] s64ValueQ32 Normalized covariance in Q32.
+ * @return Value limited to +-KF_P_MAX_Q32.
+ */
+static int64_t GPTP_KF_Limit(int64_t s64ValueQ32)
+{
+    int64_t s64Result;
+
+    s64Result = s64ValueQ32;
+    if (KF_P_MAX_Q32 < s64Result)
+    {
+        s64Result = KF_P_MAX_Q32;
+    }
+    else if (-KF_P_MAX_Q32 > s64Result)
+    {
+        s64Result = -KF_P_MAX_Q32;
+    }
+    else
+    {
+        /* In range */
+    }
+
+    return s64Result;
+}
+
+/*!
+ * @brief The function converts the Q16 value to the servo output.
+ *
+ * @param[in] s64ValueQ16 Value in Q16 [ppb].
+ * @return Value rounded to the nearest integer and saturated to int32_t [ppb].
+ */
+static int32_t GPTP_KF_Q16ToPpb(int64_t s64ValueQ16)
+{
+    int64_t s64Result;
+
+    s64Result = (0 > s64ValueQ16) ? -((-s64ValueQ16 + (GPTP_FXP_Q16_ONE / 2)) / GPTP_FXP_Q16_ONE) :
+                                     ((s64ValueQ16 + (GPTP_FXP_Q16_ONE / 2)) / GPTP_FXP_Q16_ONE);
+    if ((int64_t)GPTP_DEF_INT32_MAX < s64Result)
+    {
+        s64Result = (int64_t)GPTP_DEF_INT32_MAX;
+    }
+    else if ((int64_t)GPTP_DEF_INT32_MIN > s64Result)
+    {
+        s64Result = (int64_t)GPTP_DEF_INT32_MIN;
+    }
+    else
+    {
+        /* In range */
+    }
+
+    return (int32_t)s64Result;
+}
+#endif /* GPTP_FIXED_POINT */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*!
+ * @brief   This function checks the Kalman servo configuration.
+ *
+ * @param[in] prConfiguration Pointer to the Kalman servo configuration structure.
+ * @return true if the configuration can be used by GPTP_KF_Init.
+ */
+bool GPTP_KF_ConfigValid(const gptp_def_kf_conf_t *prConfiguration)
+{
+    return (bool)((0.0 < prConfiguration->f64MeasNoise) &&
+                  (0.0 <= prConfiguration->f64PhaseNoise) &&
+                  (0.0 <= prConfiguration->f64FreqNoise) &&
+                  (0.0 < prConfiguration->f64PhaseGain) &&
+                  (1.0 >= prConfiguration->f64PhaseGain));
+}
+
+/*!
+ *
+ * @brief   This function initializes the Kalman servo.
+ *
+ * @details This function initializes the Kalman servo and cleans all variables.
+ *
+ * @param[out] prKf Pointer to the Kalman servo context (one per domain).
+ * @param[in] prConfiguration Pointer to the Kalman servo configuration structure,
+ *            NULL leaves the servo unconfigured.
+ */
+void GPTP_KF_Init(gptp_def_kf_t *prKf,
+                  const gptp_def_kf_conf_t *prConfiguration)
+{
+#ifdef GPTP_FIXED_POINT
+    float64_t f64Noise;
+#endif /* GPTP_FIXED_POINT */
+
+    prKf->prConfiguration = prConfiguration;
+#ifdef GPTP_FIXED_POINT
+    prKf->s64Q0Q32 = 0;
+    prKf->s64Q1Q32 = 0;
+    prKf->s64PhaseGainQ32 = 0;
+
+    /* The noise is normalized here, once, the update scales it by the Sync interval */
+    if (NULL != prConfiguration)
+    {
+        f64Noise = prConfiguration->f64PhaseNoise / prConfiguration->f64MeasNoise;
+        prKf->s64Q0Q32 = GPTP_FXP_Float64ToQ32((KF_P_MAX < f64Noise) ? KF_P_MAX : f64Noise);
+        f64Noise = prConfiguration->f64FreqNoise / prConfiguration->f64MeasNoise;
+        prKf->s64Q1Q32 = GPTP_FXP_Float64ToQ32((KF_P_MAX < f64Noise) ? KF_P_MAX : f64Noise);
+        prKf->s64PhaseGainQ32 = GPTP_FXP_Float64ToQ32(prConfiguration->f64PhaseGain);
+    }
+#endif /* GPTP_FIXED_POINT */
+    GPTP_KF_Clear(prKf);
+}
+
+/*!
+ *
+ * @brief   This function cleans the state of the Kalman servo.
+ *
+ * @details The phase and frequency are estimated again from the next two
+ *          measurements.
+ *
+ * @param[in,out] prKf Pointer to the Kalman servo context.
+ */
+void GPTP_KF_Clear(gptp_def_kf_t *prKf)
+{
+    prKf->s32error = 0;
+    prKf->s32calculated = 0;
+    prKf->u8Samples = 0u;
+#ifdef GPTP_FIXED_POINT
+    prKf->s64PhaseQ16 = 0;
+    prKf->s64FreqQ16 = 0;
+    prKf->s64P00Q32 = 0;
+    prKf->s64P01Q32 = 0;
+    prKf->s64P11Q32 = 0;
+#else
+    prKf->f64Phase = 0.0;
+    prKf->f64Freq = 0.0;
+    prKf->f64P00 = 0.0;
+    prKf->f64P01 = 0.0;
+    prKf->f64P11 = 0.0;
+#endif /* GPTP_FIXED_POINT */
+}
+
+/*!
+ *
+ * @brief   This function calculates correction value as PPB to reach the setpoint.
+ *
+ * @details The phase and frequency error are estimated by a two-state Kalman
+ *          filter, the previous output is the known control input of the model.
+ *          The output cancels the estimated frequency error and removes the
+ *          configured part of the estimated phase error in one Sync interval.
+ *          The interface matches GPTP_PI_Update.
+ *
+ * @param[in,out] prKf Pointer to the Kalman servo context.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @return New correction value [PPB].
+ */
+int32_t GPTP_KF_Update(gptp_def_kf_t *prKf,
+                       int8_t s8SyncInterval,
+                       int32_t s32ErrorNs)
+{
+#ifdef GPTP_FIXED_POINT
+    /* Period of the synchronization interval in Q32 [s] */
+    int64_t   s64DtQ32;
+    /* Measured phase error in Q16 [ns] */
+    int64_t   s64ZQ16;
+    /* Normalized process noise of the phase and frequency for this interval in Q32 */
+    int64_t   s64Q0Q32;
+    int64_t   s64Q1Q32;
+    /* Innovation in Q16 [ns] */
+    int64_t   s64InnovQ16;
+    /* Innovation variance and Kalman gains in Q32 */
+    int64_t   s64SQ32;
+    int64_t   s64K0Q32;
+    int64_t   s64K1Q32;
+    int64_t   s64LimitQ16;
+#else
+    /* Period of the synchronization interval [s] */
+    float64_t f64Dt;
+    /* Normalized process noise of the phase and frequency for this interval */
+    float64_t f64Q0;
+    float64_t f64Q1;
+    float64_t f64Innov;
+    /* Innovation variance and Kalman gains */
+    float64_t f64S;
+    float64_t f64K0;
+    float64_t f64K1;
+    float64_t f64Limit;
+#endif /* GPTP_FIXED_POINT */
+
+    if (NULL != prKf->prConfiguration)
+    {
+#ifdef GPTP_FIXED_POINT
+        s64DtQ32 = GPTP_FXP_RatioCalc(GPTP_INTERNAL_Log2Ns(s8SyncInterval), GPTP_DEF_NS_IN_SECONDS);
+
+        if (0 != s64DtQ32)
+        {
+            s64ZQ16 = (int64_t)s32ErrorNs * GPTP_FXP_Q16_ONE;
+
+            if (0u == prKf->u8Samples)
+            {
+                /* The first measurement gives the phase only */
+                prKf->s64PhaseQ16 = s64ZQ16;
+                prKf->s64FreqQ16 = 0;
+                prKf->u8Samples = 1u;
+            }
+            else if (1u == prKf->u8Samples)
+            {
+                /* Two-point estimate, the frequency is the phase change plus the applied correction */
+                prKf->s64FreqQ16 = GPTP_FXP_RatioDiv(s64ZQ16 - prKf->s64PhaseQ16, s64DtQ32) +
+                                   ((int64_t)prKf->s32calculated * GPTP_FXP_Q16_ONE);
+                prKf->s64PhaseQ16 = s64ZQ16;
+                prKf->s64P00Q32 = (int64_t)KF_P00_INIT * GPTP_FXP_Q32_ONE;
+                prKf->s64P01Q32 = (int64_t)KF_P01_INIT * GPTP_FXP_Q32_ONE;
+                prKf->s64P11Q32 = (int64_t)KF_P11_INIT * GPTP_FXP_Q32_ONE;
+                prKf->u8Samples = 2u;
+            }
+            else
+            {
+                /* Process noise of this interval: phase noise * dt, frequency noise * dt^3 */
+                s64Q0Q32 = GPTP_FXP_RatioMul(prKf->s64Q0Q32, s64DtQ32);
+                s64Q1Q32 = GPTP_FXP_RatioMul(GPTP_FXP_RatioMul(GPTP_FXP_RatioMul(prKf->s64Q1Q32, s64DtQ32), s64DtQ32), s64DtQ32);
+
+                /* Prediction, the phase moves by the frequency error left after the applied correction */
+                prKf->s64PhaseQ16 += GPTP_FXP_RatioMul(prKf->s64FreqQ16 - ((int64_t)prKf->s32calculated * GPTP_FXP_Q16_ONE), s64DtQ32);
+                prKf->s64P00Q32 = GPTP_KF_Limit(prKf->s64P00Q32 + (2 * prKf->s64P01Q32) + prKf->s64P11Q32 + s64Q0Q32 + (s64Q1Q32 / 3));
+                prKf->s64P01Q32 = GPTP_KF_Limit(prKf->s64P01Q32 + prKf->s64P11Q32 + (s64Q1Q32 / 2));
+                prKf->s64P11Q32 = GPTP_KF_Limit(prKf->s64P11Q32 + s64Q1Q32);
+
+                /* Correction, the measurement noise is 1 after the normalization */
+                s64SQ32 = GPTP_FXP_Q32_ONE + prKf->s64P00Q32;
+                s64K0Q32 = GPTP_FXP_RatioDiv(prKf->s64P00Q32, s64SQ32);
+                s64K1Q32 = GPTP_FXP_RatioDiv(prKf->s64P01Q32, s64SQ32);
+                s64InnovQ16 = s64ZQ16 - prKf->s64PhaseQ16;
+                prKf->s64PhaseQ16 += GPTP_FXP_RatioMul(s64InnovQ16, s64K0Q32);
+                prKf->s64FreqQ16 += GPTP_FXP_RatioDiv(GPTP_FXP_RatioMul(s64InnovQ16, s64K1Q32), s64DtQ32);
+                prKf->s64P11Q32 -= GPTP_FXP_RatioMul(prKf->s64P01Q32, s64K1Q32);
+                prKf->s64P11Q32 = (0 > prKf->s64P11Q32) ? 0 : prKf->s64P11Q32;
+                prKf->s64P00Q32 = s64K0Q32;
+                prKf->s64P01Q32 = s64K1Q32;
+            }
+
+            /* If frequency limit is configured (avoids overshooting) */
+            if (0U != prKf->prConfiguration->u32FreqLimit)
+            {
+                s64LimitQ16 = (int64_t)prKf->prConfiguration->u32FreqLimit * GPTP_FXP_Q16_ONE;
+                if (prKf->s64FreqQ16 > s64LimitQ16)
+                {
+                    prKf->s64FreqQ16 = s64LimitQ16;
+                }
+                else if (prKf->s64FreqQ16 < -s64LimitQ16)
+                {
+                    prKf->s64FreqQ16 = -s64LimitQ16;
+                }
+                else
+                {
+                    /* In range */
+                }
+            }
+
+            /* Cancel the frequency error and remove the part of the phase error in the next interval */
+            prKf->s32calculated = GPTP_KF_Q16ToPpb(prKf->s64FreqQ16 +
+                                                   GPTP_FXP_RatioDiv(GPTP_FXP_RatioMul(prKf->s64PhaseQ16, prKf->s64PhaseGainQ32), s64DtQ32));
+        }
+        else
+        {
+            /* Register error -  can't divide by 0 */
+            GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_A_DIV_BY_0_ATTEMPT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+#else
+        f64Dt = (float64_t)GPTP_INTERNAL_Log2Ns(s8SyncInterval) / 1000000000.0;
+
+        if ((0.0 > f64Dt) || (0.0 < f64Dt))
+        {
+            if (0u == prKf->u8Samples)
+            {
+                /* The first measurement gives the phase only */
+                prKf->f64Phase = (float64_t)s32ErrorNs;
+                prKf->f64Freq = 0.0;
+                prKf->u8Samples = 1u;
+            }
+            else if (1u == prKf->u8Samples)
+            {
+                /* Two-point estimate, the frequency is the phase change plus the applied correction */
+                prKf->f64Freq = (((float64_t)s32ErrorNs - prKf->f64Phase) / f64Dt) + (float64_t)prKf->s32calculated;
+                prKf->f64Phase = (float64_t)s32ErrorNs;
+                prKf->f64P00 = (float64_t)KF_P00_INIT;
+                prKf->f64P01 = (float64_t)KF_P01_INIT;
+                prKf->f64P11 = (float64_t)KF_P11_INIT;
+                prKf->u8Samples = 2u;
+            }
+            else
+            {
+                /* Process noise of this interval: phase noise * dt, frequency noise * dt^3 */
+                f64Q0 = (prKf->prConfiguration->f64PhaseNoise * f64Dt) / prKf->prConfiguration->f64MeasNoise;
+                f64Q1 = (prKf->prConfiguration->f64FreqNoise * (f64Dt * f64Dt * f64Dt)) / prKf->prConfiguration->f64MeasNoise;
+
+                /* Prediction, the phase moves by the frequency error left after the applied correction */
+                prKf->f64Phase += (prKf->f64Freq - (float64_t)prKf->s32calculated) * f64Dt;
+                prKf->f64P00 += (2.0 * prKf->f64P01) + prKf->f64P11 + f64Q0 + (f64Q1 / 3.0);
+                prKf->f64P01 += prKf->f64P11 + (f64Q1 / 2.0);
+                prKf->f64P11 += f64Q1;
+
+                /* Correction, the measurement noise is 1 after the normalization */
+                f64S = 1.0 + prKf->f64P00;
+                f64K0 = prKf->f64P00 / f64S;
+                f64K1 = prKf->f64P01 / f64S;
+                f64Innov = (float64_t)s32ErrorNs - prKf->f64Phase;
+                prKf->f64Phase += f64K0 * f64Innov;
+                prKf->f64Freq += (f64K1 * f64Innov) / f64Dt;
+                prKf->f64P11 -= f64K1 * prKf->f64P01;
+                prKf->f64P00 = f64K0;
+                prKf->f64P01 = f64K1;
+            }
+
+            /* If frequency limit is configured (avoids overshooting) */
+            if (0U != prKf->prConfiguration->u32FreqLimit)
+            {
+                f64Limit = (float64_t)prKf->prConfiguration->u32FreqLimit;
+                if (prKf->f64Freq > f64Limit)
+                {
+                    prKf->f64Freq = f64Limit;
+                }
+                else if (prKf->f64Freq < -f64Limit)
+                {
+                    prKf->f64Freq = -f64Limit;
+                }
+                else
+                {
+                    /* In range */
+                }
+            }
+
+            /* Cancel the frequency error and remove the part of the phase error in the next interval */
+            prKf->s32calculated = GPTP_INTERNAL_Float64ToInt32(prKf->f64Freq +
+                                                               ((prKf->prConfiguration->f64PhaseGain * prKf->f64Phase) / f64Dt));
+        }
+        else
+        {
+            /* Register error -  can't divide by 0 */
+            GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_A_DIV_BY_0_ATTEMPT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+#endif /* GPTP_FIXED_POINT */
+
+        /* Store current error */
+        prKf->s32error = s32ErrorNs;
+    }
+    else
+    {
+        /* Register error -  missing configuration */
+        GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_PI_KF_INCORRECT_CFG, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+    }
+
+    /* Return calculated value in PPB format */
+    return prKf->s32calculated;
+}
+
+/*!
+ *
+ * @brief   This function runs the Kalman servo on the correction applied by another servo.
+ *
+ * @details The applied correction is the control input of the model instead of
+ *          the own output, so the phase and frequency estimates stay valid and
+ *          the servo continues from the current frequency of the clock once its
+ *          output is applied.
+ *
+ * @param[in,out] prKf Pointer to the Kalman servo context.
+ * @param[in] s8SyncInterval Current Sync interval.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @param[in] s32AppliedPpb Correction applied to the clock [PPB].
+ * @return Applied correction value [PPB].
+ */
+int32_t GPTP_KF_Track(gptp_def_kf_t *prKf,
+                      int8_t s8SyncInterval,
+                      int32_t s32ErrorNs,
+                      int32_t s32AppliedPpb)
+{
+    /* The correction applied during the last interval moved the phase */
+    prKf->s32calculated = s32AppliedPpb;
+    (void)GPTP_KF_Update(prKf, s8SyncInterval, s32ErrorNs);
+
+    /* The own output is not applied, the clock keeps the applied correction */
+    prKf->s32calculated = s32AppliedPpb;
+
+    /* Return calculated value in PPB format */
+    return prKf->s32calculated;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,365 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+#include "gptp_internal.h"
+#include "gptp_fxp.h"
+#include "gptp_nrr.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Local time of the samples is kept in units of 2^12 ns (4.096 us) */
+#define NRR_X_SHIFT                     12u
+/* Maximum time span of the window [2^12 ns], ~68.7 s */
+#define NRR_X_SPAN_MAX                  ((int64_t)1 << 24u)
+/* Maximum deviation of (t3 - t4) from the window mean [ns], ~268 ms */
+#define NRR_Y_DEV_MAX                   ((int64_t)1 << 28u)
+/* Slope of the line in Q32 to the ns per local time unit, 2^(32 - NRR_X_SHIFT) */
+#define NRR_SLOPE_SCALE                 ((int64_t)1 << 20u)
+/* Count of samples needed for the first ratio */
+#define NRR_MIN_SAMPLES                 3u
+/* Residual above the gain times the average residual is an outlier */
+#define NRR_OUTLIER_GAIN                4u
+/* Residual below this value is never an outlier [ns] */
+#define NRR_OUTLIER_MIN_NS              250u
+/* Count of consecutive outliers restarting the estimator */
+#define NRR_OUTLIER_RESTART             3u
+/* Weight of the new residual in the residual average, as power of two */
+#define NRR_RESID_AVG_SHIFT             3u
+#ifdef GPTP_FIXED_POINT
+/* Denominator limit of GPTP_FXP_RatioCalc */
+#define NRR_DEN_MAX                     ((uint64_t)1 << 47u)
+#endif /* GPTP_FIXED_POINT */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void GPTP_NRR_SampleRemove(gptp_def_nrr_lsq_t *prLsq,
+                                  uint8_t u8Window);
+static void GPTP_NRR_SampleAdd(gptp_def_nrr_lsq_t *prLsq,
+                               uint8_t u8Window,
+                               int64_t s64X,
+                               int64_t s64Y);
+static void GPTP_NRR_Recenter(gptp_def_nrr_lsq_t *prLsq);
+static void GPTP_NRR_Fit(gptp_def_nrr_lsq_t *prLsq);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/*!
+ * @brief The function removes the oldest sample from the window.
+ *
+ * @param[in,out] prLsq Pointer to the estimator context.
+ * @param[in] u8Window Count of samples in the window.
+ */
+static void GPTP_NRR_SampleRemove(gptp_def_nrr_lsq_t *prLsq,
+                                  uint8_t u8Window)
+{
+    int64_t s64Dx;
+    int64_t s64Dy;
+
+    s64Dx = prLsq->as64X[prLsq->u8Head] - prLsq->s64AnchorX;
+    s64Dy = prLsq->as64Y[prLsq->u8Head] - prLsq->s64AnchorY;
+
+    prLsq->s64SumX -= s64Dx;
+    prLsq->s64SumY -= s64Dy;
+    prLsq->s64SumXX -= s64Dx * s64Dx;
+    prLsq->s64SumXY -= s64Dx * s64Dy;
+
+    prLsq->u8Head = (uint8_t)((prLsq->u8Head + 1u) % u8Window);
+    prLsq->u8Count--;
+}
+
+/*!
+ * @brief The function adds the newest sample to the window.
+ *
+ * @param[in,out] prLsq Pointer to the estimator context.
+ * @param[in] u8Window Count of samples in the window.
+ * @param[in] s64X Local time of the sample [2^12 ns].
+ * @param[in] s64Y Neighbor minus local time of the sample [ns].
+ */
+static void GPTP_NRR_SampleAdd(gptp_def_nrr_lsq_t *prLsq,
+                               uint8_t u8Window,
+                               int64_t s64X,
+                               int64_t s64Y)
+{
+    int64_t s64Dx;
+    int64_t s64Dy;
+    uint8_t u8Tail;
+
+    if (0u == prLsq->u8Count)
+    {
+        prLsq->s64AnchorX = s64X;
+        prLsq->s64AnchorY = s64Y;
+    }
+
+    u8Tail = (uint8_t)((prLsq->u8Head + prLsq->u8Count) % u8Window);
+    prLsq->as64X[u8Tail] = s64X;
+    prLsq->as64Y[u8Tail] = s64Y;
+
+    s64Dx = s64X - prLsq->s64AnchorX;
+    s64Dy = s64Y - prLsq->s64AnchorY;
+
+    prLsq->s64SumX += s64Dx;
+    prLsq->s64SumY += s64Dy;
+    prLsq->s64SumXX += s64Dx * s64Dx;
+    prLsq->s64SumXY += s64Dx * s64Dy;
+
+    prLsq->u8Count++;
+}
+
+/*!
+ * @brief The function moves the anchor of the sums to the window mean.
+ *
+ * @details The sums stay small, so the products of the fit do not overflow
+ *          and no precision is lost, however long the estimator runs.
+ *
+ * @param[in,out] prLsq Pointer to the estimator context.
+ */
+static void GPTP_NRR_Recenter(gptp_def_nrr_lsq_t *prLsq)
+{
+    int64_t s64N;
+    int64_t s64Mx;
+    int64_t s64My;
+
+    if (0u != prLsq->u8Count)
+    {
+        s64N = (int64_t)prLsq->u8Count;
+        s64Mx = prLsq->s64SumX / s64N;
+        s64My = prLsq->s64SumY / s64N;
+
+        prLsq->s64SumXX -= (2 * s64Mx * prLsq->s64SumX) - (s64N * s64Mx * s64Mx);
+        prLsq->s64SumXY -= ((s64My * prLsq->s64SumX) + (s64Mx * prLsq->s64SumY)) - (s64N * s64Mx * s64My);
+        prLsq->s64SumX -= s64N * s64Mx;
+        prLsq->s64SumY -= s64N * s64My;
+
+        prLsq->s64AnchorX += s64Mx;
+        prLsq->s64AnchorY += s64My;
+    }
+}
+
+/*!
+ * @brief The function fits the line over the window.
+ *
+ * @details Slopes of 0.4 % and more are out of any Ethernet oscillator
+ *          tolerance, the ratio is not valid for them.
+ *
+ * @param[in,out] prLsq Pointer to the estimator context.
+ */
+static void GPTP_NRR_Fit(gptp_def_nrr_lsq_t *prLsq)
+{
+    int64_t   s64N;
+    int64_t   s64Num;
+    int64_t   s64Den;
+#ifdef GPTP_FIXED_POINT
+    uint64_t  u64Num;
+    uint64_t  u64Den;
+#else
+    float64_t f64Slope;
+#endif /* GPTP_FIXED_POINT */
+
+    prLsq->bRatioValid = false;
+
+    if (NRR_MIN_SAMPLES <= prLsq->u8Count)
+    {
+        s64N = (int64_t)prLsq->u8Count;
+        s64Num = (s64N * prLsq->s64SumXY) - (prLsq->s64SumX * prLsq->s64SumY);
+        s64Den = (s64N * prLsq->s64SumXX) - (prLsq->s64SumX * prLsq->s64SumX);
+
+        if ((0 < s64Den) && ((GPTP_INTERNAL_AbsInt64ToUint64(s64Num) >> 4u) < (uint64_t)s64Den))
+        {
+#ifdef GPTP_FIXED_POINT
+            u64Num = GPTP_INTERNAL_AbsInt64ToUint64(s64Num);
+            u64Den = (uint64_t)s64Den;
+            while (NRR_DEN_MAX <= u64Den)
+            {
+                u64Num >>= 1u;
+                u64Den >>= 1u;
+            }
+
+            prLsq->s64SlopeQ32 = GPTP_FXP_RatioCalc(u64Num, u64Den) / ((int64_t)1 << NRR_X_SHIFT);
+            if (0 > s64Num)
+            {
+                prLsq->s64SlopeQ32 = -prLsq->s64SlopeQ32;
+            }
+
+            prLsq->f64RateRatio = GPTP_FXP_Q32ToFloat64(GPTP_FXP_Q32_ONE + prLsq->s64SlopeQ32);
+#else
+            f64Slope = (float64_t)s64Num / ((float64_t)s64Den * (float64_t)((int64_t)1 << NRR_X_SHIFT));
+            prLsq->s64SlopeQ32 = (int64_t)(f64Slope * (float64_t)GPTP_FXP_Q32_ONE);
+            prLsq->f64RateRatio = 1.0 + f64Slope;
+#endif /* GPTP_FIXED_POINT */
+            prLsq->bRatioValid = true;
+        }
+    }
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*!
+ * @brief   This function restarts the least-squares neighbor rate ratio estimator.
+ *
+ * @details All samples are dropped, the ratio is not valid until the window
+ *          collects enough samples again.
+ *
+ * @param[out] prLsq Pointer to the estimator context (one per Pdelay machine).
+ */
+void GPTP_NRR_Reset(gptp_def_nrr_lsq_t *prLsq)
+{
+    prLsq->u8Head = 0u;
+    prLsq->u8Count = 0u;
+    prLsq->u8Rejected = 0u;
+    prLsq->s64AnchorX = 0;
+    prLsq->s64AnchorY = 0;
+    prLsq->s64SumX = 0;
+    prLsq->s64SumY = 0;
+    prLsq->s64SumXX = 0;
+    prLsq->s64SumXY = 0;
+    prLsq->s64SlopeQ32 = 0;
+    prLsq->u32ResidAvgNs = 0u;
+    prLsq->f64RateRatio = 1.0;
+    prLsq->bRatioValid = false;
+}
+
+/*!
+ * @brief   This function adds one pair of Pdelay response timestamps to the estimator.
+ *
+ * @details The line (t3 - t4) = a + b * t4 is fitted over the sliding window,
+ *          the neighbor rate ratio is 1 + b. The sums of the fit are kept
+ *          centered around the window mean, so a sample is added and the
+ *          oldest one removed in constant time with exact integer arithmetic.
+ *          A sample far from the current line is not added. Several such
+ *          samples in a row restart the estimator, as the neighbor clock has
+ *          most likely stepped.
+ *
+ * @param[in,out] prLsq Pointer to the estimator context.
+ * @param[in] u8Window Count of samples in the window.
+ * @param[in] u64T4Ns Pdelay response receipt time (local clock) [ns].
+ * @param[in] u64T3Ns Pdelay response origin time (neighbor clock) [ns].
+ * @return GPTP_ERR_P_RRATIO_OUTLIER if the sample has been rejected,
+ *         GPTP_ERR_OK otherwise.
+ */
+gptp_err_type_t GPTP_NRR_Update(gptp_def_nrr_lsq_t *prLsq,
+                                uint8_t u8Window,
+                                uint64_t u64T4Ns,
+                                uint64_t u64T3Ns)
+{
+    gptp_err_type_t eErr;
+    int64_t         s64X;
+    int64_t         s64Y;
+    int64_t         s64Pred;
+    uint64_t        u64Resid;
+    uint64_t        u64Thr;
+    bool            bAccept;
+
+    eErr = GPTP_ERR_OK;
+
+    if ((NRR_MIN_SAMPLES > u8Window) || (GPTP_DEF_RRATIO_LSQ_WIN_MAX < u8Window))
+    {
+        u8Window = GPTP_DEF_RRATIO_LSQ_WIN_MAX;
+    }
+
+    /* The local time must grow, the window restarts otherwise */
+    if ((0u != prLsq->u8Count) && (u64T4Ns <= prLsq->u64LastLocalNs))
+    {
+        GPTP_NRR_Reset(prLsq);
+    }
+
+    /* Samples too old for the window */
+    while ((0u != prLsq->u8Count) && \
+           (NRR_X_SPAN_MAX <= ((int64_t)((u64T4Ns - prLsq->u64OriginLocalNs) >> NRR_X_SHIFT) - prLsq->as64X[prLsq->u8Head])))
+    {
+        GPTP_NRR_SampleRemove(prLsq, u8Window);
+    }
+
+    /* Drained window, e.g. after a link down, nothing of the old line is valid */
+    if (0u == prLsq->u8Count)
+    {
+        GPTP_NRR_Reset(prLsq);
+        prLsq->u64OriginLocalNs = u64T4Ns;
+        prLsq->s64OriginOffsetNs = (int64_t)(u64T3Ns - u64T4Ns);
+    }
+
+    s64X = (int64_t)((u64T4Ns - prLsq->u64OriginLocalNs) >> NRR_X_SHIFT);
+    s64Y = (int64_t)(u64T3Ns - u64T4Ns) - prLsq->s64OriginOffsetNs;
+
+    /* Residual of the sample to the current line */
+    if (true == prLsq->bRatioValid)
+    {
+        s64Pred = prLsq->s64AnchorY + ((prLsq->s64SlopeQ32 * (s64X - prLsq->s64AnchorX)) / NRR_SLOPE_SCALE);
+        u64Resid = GPTP_INTERNAL_AbsInt64ToUint64(s64Y - s64Pred);
+        u64Thr = ((uint64_t)NRR_OUTLIER_GAIN * (uint64_t)prLsq->u32ResidAvgNs) + (uint64_t)NRR_OUTLIER_MIN_NS;
+        bAccept = (u64Resid <= u64Thr);
+    }
+    else
+    {
+        u64Resid = 0u;
+        bAccept = true;
+    }
+
+    /* The sums are bounded only for samples close to the window */
+    if (GPTP_INTERNAL_AbsInt64ToUint64(s64Y - prLsq->s64AnchorY) >= (uint64_t)NRR_Y_DEV_MAX)
+    {
+        bAccept = false;
+    }
+
+    if (true == bAccept)
+    {
+        prLsq->u8Rejected = 0u;
+
+        if (true == prLsq->bRatioValid)
+        {
+            /* Exponential average of the absolute residual */
+            prLsq->u32ResidAvgNs = (uint32_t)((int64_t)prLsq->u32ResidAvgNs + \
+                                              (((int64_t)u64Resid - (int64_t)prLsq->u32ResidAvgNs) / ((int64_t)1 << NRR_RESID_AVG_SHIFT)));
+        }
+    }
+    else
+    {
+        prLsq->u8Rejected++;
+
+        if (NRR_OUTLIER_RESTART <= prLsq->u8Rejected)
+        {
+            /* The line does not describe the clocks any more, start over from this sample */
+            GPTP_NRR_Reset(prLsq);
+            prLsq->u64OriginLocalNs = u64T4Ns;
+            prLsq->s64OriginOffsetNs = (int64_t)(u64T3Ns - u64T4Ns);
+            s64X = 0;
+            s64Y = 0;
+            bAccept = true;
+        }
+
+        eErr = GPTP_ERR_P_RRATIO_OUTLIER;
+    }
+
+    if (true == bAccept)
+    {
+        if (u8Window <= prLsq->u8Count)
+        {
+            GPTP_NRR_SampleRemove(prLsq, u8Window);
+        }
+
+        GPTP_NRR_SampleAdd(prLsq, u8Window, s64X, s64Y);
+        GPTP_NRR_Recenter(prLsq);
+        GPTP_NRR_Fit(prLsq);
+        prLsq->u64LastLocalNs = u64T4Ns;
+    }
+
+    return eErr;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
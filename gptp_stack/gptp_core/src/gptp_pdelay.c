@@ -23,10 +23,137 @@
 #include "gptp.h"
 #include "gptp_internal.h"
 #include "gptp_pdelay.h"
+#include "gptp_fxp.h"
+#include "gptp_nrr.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void GPTP_PDELAY_RratioLsqUpdate(const gptp_def_data_t *prGptp,
+                                        gptp_def_pdelay_t *prPdelMachine);
+static void GPTP_PDELAY_NvmUpdateCheck(const gptp_def_data_t *prGptp,
+                                       gptp_def_pdelay_t *prPdelMachine,
+                                       gptp_def_nvm_data_t eNvmDataType);
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
+/*!
+ * @brief The function updates the least-squares neighbor rate ratio estimator.
+ *
+ * @details The estimator is restarted together with the averager, the estimated
+ *          ratio is used without further averaging.
+ *
+ * @param[in] prGptp Pointer to global gPTP structure.
+ * @param[in] prPdelMachine Pointer to Pdelay state machine structure.
+ */
+static void GPTP_PDELAY_RratioLsqUpdate(const gptp_def_data_t *prGptp,
+                                        gptp_def_pdelay_t *prPdelMachine)
+{
+    gptp_err_type_t eErr;
+
+    if (false == prPdelMachine->bRatioAveragerInitialized)
+    {
+        GPTP_NRR_Reset(&prPdelMachine->rRratioLsq);
+        prPdelMachine->bRatioAveragerInitialized = true;
+    }
+
+    eErr = GPTP_NRR_Update(&prPdelMachine->rRratioLsq,
+                           prGptp->rPerDeviceParams.u8RratioLsqWindow,
+                           GPTP_INTERNAL_TsToU64(prPdelMachine->rPdRespMsgRx.rT4Ts),
+                           GPTP_INTERNAL_TsToU64(prPdelMachine->rPdRespFupMsgRx.rT3Ts));
+    if (GPTP_ERR_OK != eErr)
+    {
+        /* Register error - timestamps far from the estimated ratio */
+        GPTP_ERR_Register(prPdelMachine->u8GptpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, eErr, prPdelMachine->rPdRespMsgRx.rHeader.u16SequenceId);
+    }
+
+    if (true == prPdelMachine->rRratioLsq.bRatioValid)
+    {
+        prPdelMachine->f64TempRateRatioCurrent = prPdelMachine->rRratioLsq.f64RateRatio;
+
+        /* Check if the rate ratio is inside of the limit */
+        prPdelMachine->bNeighborRateRatioValidCurrent = GPTP_INTERNAL_RateRratioCheck(prGptp->rPerDeviceParams.f64RratioMaxDev, &prPdelMachine->f64TempRateRatioCurrent);
+
+        if (true == prPdelMachine->bNeighborRateRatioValidCurrent)
+        {
+            prPdelMachine->f64NeighborRateRatioCurrent = prPdelMachine->f64TempRateRatioCurrent;
+
+            if (false == prPdelMachine->bNeighborRateRatioValid)
+            {
+                prPdelMachine->f64NeighborRateRatio = prPdelMachine->f64NeighborRateRatioCurrent;
+            }
+        }
+    }
+    else
+    {
+        /* Not enough samples in the window yet */
+        prPdelMachine->bNeighborRateRatioValidCurrent = false;
+    }
+}
+
+/*!
+ * @brief The function compares the stabilized measurement with the value stored in the NVM.
+ *
+ * @details The NVM update is requested when the write threshold is exceeded. While the
+ *          asynchronous read of the stored value is pending, the comparison is left to
+ *          its completion.
+ *
+ * @param[in] prGptp Pointer to global gPTP structure.
+ * @param[in] prPdelMachine Pointer to Pdelay state machine structure.
+ * @param[in] eNvmDataType NVM data type to compare.
+ */
+static void GPTP_PDELAY_NvmUpdateCheck(const gptp_def_data_t *prGptp,
+                                       gptp_def_pdelay_t *prPdelMachine,
+                                       gptp_def_nvm_data_t eNvmDataType)
+{
+    switch (eNvmDataType)
+    {
+        case GPTP_DEF_NVM_RRATIO:
+            if (GPTP_DEF_MEM_READ_PENDING == prPdelMachine->rRratioNvmReadStat)
+            {
+                /* Nothing to do */
+            }
+            /* If write threshold is not exceeded */
+            else if (((prPdelMachine->f64NeighborRateRatioCurrent + prGptp->rPerDeviceParams.f64RratioNvmWriteThr) > prPdelMachine->f64RratioNvm) && \
+                     ((prPdelMachine->f64NeighborRateRatioCurrent - prGptp->rPerDeviceParams.f64RratioNvmWriteThr) < prPdelMachine->f64RratioNvm))
+            {
+                /* Nothing to do */
+            }
+            /* Threshold exceeded, NVM update */
+            else
+            {
+                prPdelMachine->f64RratioToWrite = prPdelMachine->f64NeighborRateRatioCurrent;
+                prPdelMachine->f64RratioNvm = prPdelMachine->f64NeighborRateRatioCurrent;
+                prPdelMachine->rRratioNvmWriteStat = GPTP_DEF_MEM_WRITE_INIT;
+            }
+            break;
+
+        case GPTP_DEF_NVM_PDELAY:
+            if (GPTP_DEF_MEM_READ_PENDING == prPdelMachine->rPdelayNvmReadStat)
+            {
+                /* Nothing to do */
+            }
+            /* If write threshold is not exceeded */
+            else if (((prPdelMachine->f64NeighborPropDelayCurrent + prGptp->rPerDeviceParams.f64PdelayNvmWriteThr) > prPdelMachine->f64PdelayNvm) && \
+                     ((prPdelMachine->f64NeighborPropDelayCurrent - prGptp->rPerDeviceParams.f64PdelayNvmWriteThr) < prPdelMachine->f64PdelayNvm))
+            {
+                /* Nothing to do */
+            }
+            /* Threshold exceeded, NVM update */
+            else
+            {
+                prPdelMachine->f64PdelayToWrite = prPdelMachine->f64NeighborPropDelayCurrent;
+                prPdelMachine->f64PdelayNvm = prPdelMachine->f64NeighborPropDelayCurrent;
+                prPdelMachine->rPdelayNvmWriteStat = GPTP_DEF_MEM_WRITE_INIT;
+            }
+            break;
+
+        default:
+        break;
+    }
+}
+
 /*!
  * @brief Pdelay state machine main function
  *
@@ -173,7 +300,9 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                         prPdelMachine->rTxDataReq.eMsgId = GPTP_DEF_MSG_TYPE_PD_REQ;
                         prPdelMachine->rTxDataReq.u16SequenceId = prPdelMachine->u16SequenceId;
                         prPdelMachine->rTxDataReq.s8LogMessagePeriod = prPdelMachine->s8PdelayIntervalLog;
+#ifndef GPTP_TX_ZERO_COPY
                         prPdelMachine->rTxDataReq.pau8TxBuffPtr = prPdelMachine->au8SendBuffPdelReq;
+#endif /* GPTP_TX_ZERO_COPY */
                         prPdelMachine->rTxDataReq.bTsRequested = true;
                         prPdelMachine->rTxDataReq.u16VlanTci = prGptp->rPerDeviceParams.u16VlanTci;
 
@@ -199,6 +328,7 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                         /* Transmit message, Timestamp required */
                         GPTP_MsgTransmit(&prPdelMachine->rTxDataReq, prPdelMachine->u8GptpPort, prPdelMachine->u8GptpPort, 0u);
                         prPdelMachine->u64TurnaroundMeasStartPtpNsInit = GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING));
+                        GPTP_TIMER_TimerArm(&prPdelMachine->rTimerTurnaroundInit, prPdelMachine->u64TurnaroundMeasStartPtpNsInit + GPTP_DEF_10_MS_IN_NS + 1u);
                         /* The next pdelay initiator state is Waiting for pdelay response */
                         prPdelMachine->ePdelayInitiatorState = GPTP_DEF_WAITING_FOR_PD_RESP;
                     break;
@@ -271,7 +401,13 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
 
                                 /* Check if the actual timestamps T1 and T2 have higher value than timestamps from previous calculation */
                                 bTempResult = GPTP_INTERNAL_TsAboveTs(prPdelMachine->rPdRespMsgRx.rT2Ts, prPdelMachine->rNeighborCalcPrevT2);
-                                if ((true == GPTP_INTERNAL_TsAboveTs(prPdelMachine->rT1Ts, prPdelMachine->rNeighborCalcPrevT1)) && (true == bTempResult))
+                                if (GPTP_DEF_RRATIO_ESTIM_LSQ == prGptp->rPerDeviceParams.eRratioEstimator)
+                                {
+                                    /* Line fit over the window of timestamps */
+                                    GPTP_PDELAY_RratioLsqUpdate(prGptp, prPdelMachine);
+                                }
+
+                                else if ((true == GPTP_INTERNAL_TsAboveTs(prPdelMachine->rT1Ts, prPdelMachine->rNeighborCalcPrevT1)) && (true == bTempResult))
                                 {
                                     /* Calculate subtract of current T2 timestamp and previous T2 timestamp */
                                     rTempTs2 = GPTP_INTERNAL_TsMinTs(prPdelMachine->rPdRespMsgRx.rT2Ts, prPdelMachine->rNeighborCalcPrevT2);
@@ -292,7 +428,11 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
 
                                     else
                                     {
+#ifdef GPTP_FIXED_POINT
+                                        prPdelMachine->f64TempRateRatioCurrent = GPTP_FXP_Q32ToFloat64(GPTP_FXP_RatioCalc(u64TempT2, u64TempT1));
+#else
                                         prPdelMachine->f64TempRateRatioCurrent = (float64_t)u64TempT2 / (float64_t)u64TempT1;
+#endif /* GPTP_FIXED_POINT */
                                     }
 
                                     /* Check if the rate ratio is inside of the limit */
@@ -306,8 +446,14 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                                             /* Store the neighbor propagation delay from previous measurement into temp variable */
                                             f64TempRatio = prPdelMachine->f64NeighborRateRatioCurrent;
                                             /* Apply exponential averaging filter */
+#ifdef GPTP_FIXED_POINT
+                                            prPdelMachine->f64NeighborRateRatioCurrent = GPTP_FXP_Q32ToFloat64(GPTP_FXP_Average(GPTP_FXP_Float64ToQ32(f64TempRatio), \
+                                                                                                                                GPTP_FXP_Float64ToQ32(prPdelMachine->f64TempRateRatioCurrent), \
+                                                                                                                                prGptp->rPerDeviceParams.u32RratioAvgWeightQ16));
+#else
                                             prPdelMachine->f64NeighborRateRatioCurrent = ((prGptp->rPerDeviceParams.f64RratioAvgWeight * f64TempRatio) + \
                                                                                        ((1.0 - prGptp->rPerDeviceParams.f64RratioAvgWeight) * prPdelMachine->f64TempRateRatioCurrent));
+#endif /* GPTP_FIXED_POINT */
                                         }
 
                                         /* If averager is not initialized */
@@ -349,6 +495,10 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                                 rTmpSigTs2.s64TimeStampS = (int64_t)prPdelMachine->rT1Ts.u64TimeStampS;
                                 rTempTs1Sig = GPTP_INTERNAL_TsMinTsSig(rTmpSigTs1, rTmpSigTs2);
                                 u64Turnaroud = (uint64_t)GPTP_INTERNAL_TsToS64(rTempTs1Sig);
+#ifdef GPTP_COUNTERS
+                                GPTP_INTERNAL_PortHistAdd(prGptp, prPdelMachine->u8GptpPort, GPTP_DEF_HIST_TURNAROUND_INIT,
+                                                          GPTP_INTERNAL_TsToU64(prPdelMachine->rT1Ts), GPTP_INTERNAL_TsToU64(prPdelMachine->rPdRespMsgRx.rT4Ts));
+#endif /* GPTP_COUNTERS */
 
                                 /* Calculate subtract of T3 and T2 timestamps */
                                 rTmpSigTs1.s32TimeStampNs = (int32_t)prPdelMachine->rPdRespFupMsgRx.rT3Ts.u32TimeStampNs;
@@ -362,7 +512,13 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                                 s64TempT1 = GPTP_INTERNAL_TsToS64(GPTP_INTERNAL_TsMinTsSig(rTempTs1Sig, rTempTs2Sig));
 
                                 /* Calculate current Pdelay using neighbor rate ratio and previous result */
+#ifdef GPTP_FIXED_POINT
+                                /* Halving is folded into the conversion of the result to Q16 */
+                                f64CurrentDelay = GPTP_FXP_Q16ToFloat64(GPTP_FXP_RatioMul(s64TempT1 * (GPTP_FXP_Q16_ONE / 2), \
+                                                                                          GPTP_FXP_Float64ToQ32(prPdelMachine->f64NeighborRateRatio)));
+#else
                                 f64CurrentDelay = (prPdelMachine->f64NeighborRateRatio * (float64_t)s64TempT1) / 2.0;
+#endif /* GPTP_FIXED_POINT */
 
                                 /* If measuring turnaround (measurement not ended in the periodic function */
                                 if (0u != prPdelMachine->u64TurnaroundMeasStartPtpNsInit)
@@ -387,8 +543,14 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                                         /* Store the neighbor propagation delay from previous measurement into temp variable */
                                         f64TempDelay = prPdelMachine->f64NeighborPropDelayCurrent;
                                         /* Apply exponential averaging filter */
+#ifdef GPTP_FIXED_POINT
+                                        prPdelMachine->f64NeighborPropDelayCurrent = GPTP_FXP_Q16ToFloat64(GPTP_FXP_Average(GPTP_FXP_Float64ToQ16(f64TempDelay), \
+                                                                                                                            GPTP_FXP_Float64ToQ16(f64CurrentDelay), \
+                                                                                                                            prGptp->rPerDeviceParams.u32PdelAvgWeightQ16));
+#else
                                         prPdelMachine->f64NeighborPropDelayCurrent = ((prGptp->rPerDeviceParams.f64PdelAvgWeight * f64TempDelay) + \
                                                                                    ((1.0 - prGptp->rPerDeviceParams.f64PdelAvgWeight) * f64CurrentDelay));
+#endif /* GPTP_FIXED_POINT */
                                     }
 
                                     else
@@ -434,38 +596,14 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                                         /* Update next pdelay due */
                                         GPTP_TIMER_PdelayDueUpdate(prPdelMachine);
 
-                                        /* Read rate ratio from the NVM */
-                                        GPTP_PORT_ValueNvmRead(prPdelMachine, GPTP_DEF_NVM_RRATIO, prGptp);
-                                        /* If write threshold is not exceeded */
-                                        if (((prPdelMachine->f64NeighborRateRatioCurrent + prGptp->rPerDeviceParams.f64RratioNvmWriteThr) > prPdelMachine->f64NeighborRateRatio) && \
-                                            ((prPdelMachine->f64NeighborRateRatioCurrent - prGptp->rPerDeviceParams.f64RratioNvmWriteThr) < prPdelMachine->f64NeighborRateRatio))
-                                        {
-                                            /* Nothing to do */
-                                        }
-                                        /* Threshold exceeded, NVM update */
-                                        else
-                                        {
-                                            prPdelMachine->f64RratioToWrite = prPdelMachine->f64NeighborRateRatioCurrent;
-                                            prPdelMachine->rRratioNvmWriteStat = GPTP_DEF_MEM_WRITE_INIT;
-                                        }
+                                        /* Compare rate ratio with the value stored in the NVM */
+                                        GPTP_PDELAY_NvmUpdateCheck(prGptp, prPdelMachine, GPTP_DEF_NVM_RRATIO);
                                         /* Update Rate ratio value from the current measurement */
                                         prPdelMachine->f64NeighborRateRatio = prPdelMachine->f64NeighborRateRatioCurrent;
                                         prPdelMachine->bNeighborRateRatioValid = true;
 
-                                        /* Read Pdelay value from the NVM */
-                                        GPTP_PORT_ValueNvmRead(prPdelMachine, GPTP_DEF_NVM_PDELAY, prGptp);
-                                        /* If write threshold is not exceeded */
-                                        if (((prPdelMachine->f64NeighborPropDelayCurrent + prGptp->rPerDeviceParams.f64PdelayNvmWriteThr) > prPdelMachine->f64NeighborPropDelay) && \
-                                            ((prPdelMachine->f64NeighborPropDelayCurrent - prGptp->rPerDeviceParams.f64PdelayNvmWriteThr) < prPdelMachine->f64NeighborPropDelay))
-                                        {
-                                            /* Nothing to do */
-                                        }
-                                        /* Threshold exceeded, NVM update */
-                                        else
-                                        {
-                                            prPdelMachine->f64PdelayToWrite = prPdelMachine->f64NeighborPropDelayCurrent;
-                                            prPdelMachine->rPdelayNvmWriteStat = GPTP_DEF_MEM_WRITE_INIT;
-                                        }
+                                        /* Compare Pdelay value with the value stored in the NVM */
+                                        GPTP_PDELAY_NvmUpdateCheck(prGptp, prPdelMachine, GPTP_DEF_NVM_PDELAY);
                                         /* Update Pdelay value from the current measurement */
                                         prPdelMachine->f64NeighborPropDelay = prPdelMachine->f64NeighborPropDelayCurrent;
                                         prPdelMachine->bPdelayValueValid = true;
@@ -593,13 +731,16 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                         prPdelMachine->rTxDataResp.rTs.u32TimeStampNs = prPdelMachine->rPdReqMsgRx.rT2Ts.u32TimeStampNs;
                         /* Start turnaround time measurement */ 
                         prPdelMachine->u64TurnaroundMeasStartPtpNsResp = GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING));
+                        GPTP_TIMER_TimerArm(&prPdelMachine->rTimerTurnaroundResp, prPdelMachine->u64TurnaroundMeasStartPtpNsResp + GPTP_DEF_10_MS_IN_NS + 1u);
                         /* Copy requesting clock Id and requesting port Id from received Pdelay request message into the Pdelay response message */
                         prPdelMachine->rTxDataResp.rRequesting.u64ClockId = prPdelMachine->rPdReqMsgRx.rHeader.u64SourceClockId;
                         prPdelMachine->rTxDataResp.rRequesting.u16PortId = prPdelMachine->rPdReqMsgRx.rHeader.u16SourcePortId;
                         /* Respond with subdomain number, as in the pdelay request */
                         prPdelMachine->rTxDataResp.u8SubdomainNumber = prPdelMachine->rPdReqMsgRx.u8SubdomainNum;
                         /* TX data buffer provide */
+#ifndef GPTP_TX_ZERO_COPY
                         prPdelMachine->rTxDataResp.pau8TxBuffPtr = prPdelMachine->au8SendBuffPdelResp;
+#endif /* GPTP_TX_ZERO_COPY */
                         prPdelMachine->rTxDataResp.bTsRequested = true;
                         prPdelMachine->rTxDataResp.u16VlanTci = prPdelMachine->rPdReqMsgRx.u16VlanTci;
                         /* Use clockID and portID from device configuration */
@@ -655,6 +796,10 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
 
                             /* Calculate responder turnaround time */
                             u64Turnaroud = GPTP_INTERNAL_TsToU64(prPdelMachine->rT3Ts) - GPTP_INTERNAL_TsToU64(prPdelMachine->rPdReqMsgRx.rT2Ts);
+#ifdef GPTP_COUNTERS
+                            GPTP_INTERNAL_PortHistAdd(prGptp, prPdelMachine->u8GptpPort, GPTP_DEF_HIST_TURNAROUND_RESP,
+                                                      GPTP_INTERNAL_TsToU64(prPdelMachine->rPdReqMsgRx.rT2Ts), GPTP_INTERNAL_TsToU64(prPdelMachine->rT3Ts));
+#endif /* GPTP_COUNTERS */
 
                             /* Check if turneround time measurement is still active */
                             if (0u != prPdelMachine->u64TurnaroundMeasStartPtpNsResp)
@@ -676,7 +821,9 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
                             /* Respond with subdomain number, as in the pdelay request */
                             prPdelMachine->rTxDataReFu.u8SubdomainNumber = prPdelMachine->rPdReqMsgRx.u8SubdomainNum;
                             /* Provide TX buffer pointer */
+#ifndef GPTP_TX_ZERO_COPY
                             prPdelMachine->rTxDataReFu.pau8TxBuffPtr = prPdelMachine->au8SendBuffPdelRespFup;
+#endif /* GPTP_TX_ZERO_COPY */
                             prPdelMachine->rTxDataReFu.bTsRequested = false;
                             prPdelMachine->rTxDataReFu.u16VlanTci = prPdelMachine->rPdReqMsgRx.u16VlanTci;
                             /* Copy clockID and portID from last PD response */
@@ -747,6 +894,84 @@ void GPTP_PDELAY_PdelayMachine(const gptp_def_data_t *prGptp,
     }
 }
 
+/*!
+ * @brief NVM read completion function
+ *
+ * This function takes over the value delivered by the asynchronous NVM read. Until the
+ * Pdelay measurement is stabilized, the valid stored value replaces the default one the
+ * machine runs with. The stabilized measurement is compared with the stored value instead.
+ *
+ * @param[in] prGptp Pointer to global gPTP structure.
+ * @param[in] prPdelMachine Pointer to Pdelay state machine structure.
+ * @param[in] eNvmDataType NVM data type read.
+ * @param[in] f64Value Value read from the NVM, NaN if the read failed.
+ */
+void GPTP_PDELAY_NvmReadDone(const gptp_def_data_t *prGptp,
+                             gptp_def_pdelay_t *prPdelMachine,
+                             gptp_def_nvm_data_t eNvmDataType,
+                             float64_t f64Value)
+{
+    float64_t f64RateRatio;
+    bool      bStabilized;
+
+    bStabilized = (bool)(prPdelMachine->u16PdelayResponsesCnt > prPdelMachine->u16MsmtsTillSlowDown);
+
+    switch (eNvmDataType)
+    {
+        case GPTP_DEF_NVM_PDELAY:
+            if (GPTP_DEF_MEM_READ_PENDING == prPdelMachine->rPdelayNvmReadStat)
+            {
+                prPdelMachine->rPdelayNvmReadStat = GPTP_DEF_MEM_READ_IDLE;
+                prPdelMachine->f64PdelayNvm = f64Value;
+
+                if (true == bStabilized)
+                {
+                    GPTP_PDELAY_NvmUpdateCheck(prGptp, prPdelMachine, GPTP_DEF_NVM_PDELAY);
+                }
+                /* Value from NVM is below the threshold */
+                else if (true == GPTP_INTERNAL_PdelayCheck(prPdelMachine->u8GptpPort, \
+                                                           (float64_t)prPdelMachine->u64NeighborPropDelayThreshNs, \
+                                                           f64Value))
+                {
+                    prPdelMachine->f64NeighborPropDelay = f64Value;
+                    prPdelMachine->bPdelayValueValid = true;
+                }
+                else
+                {
+                    /* Nothing to do */
+                }
+            }
+            break;
+
+        case GPTP_DEF_NVM_RRATIO:
+            if (GPTP_DEF_MEM_READ_PENDING == prPdelMachine->rRratioNvmReadStat)
+            {
+                prPdelMachine->rRratioNvmReadStat = GPTP_DEF_MEM_READ_IDLE;
+                prPdelMachine->f64RratioNvm = f64Value;
+                f64RateRatio = f64Value;
+
+                if (true == bStabilized)
+                {
+                    GPTP_PDELAY_NvmUpdateCheck(prGptp, prPdelMachine, GPTP_DEF_NVM_RRATIO);
+                }
+                /* Rate ratio from NVM is within the limit */
+                else if (true == GPTP_INTERNAL_RateRratioCheck(prGptp->rPerDeviceParams.f64RratioMaxDev, &f64RateRatio))
+                {
+                    prPdelMachine->f64NeighborRateRatio = f64RateRatio;
+                    prPdelMachine->bNeighborRateRatioValid = true;
+                }
+                else
+                {
+                    /* Nothing to do */
+                }
+            }
+            break;
+
+        default:
+        break;
+    }
+}
+
 /*******************************************************************************
  * EOF
  ******************************************************************************/
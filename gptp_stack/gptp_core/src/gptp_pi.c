@@ -14,6 +14,7 @@
 #include "gptp_pi.h"
 #include "gptp_err.h"
 #include "gptp_internal.h"
+#include "gptp_fxp.h"
 
 /*******************************************************************************
  * Definitions
@@ -22,17 +23,12 @@
 #define PI_NARROW_BAND_THRESHOLD              100.0
 /* PI ratio */
 #define PI_PI_RATIO                           3.141592
-
-/*******************************************************************************
- * Variables
- ******************************************************************************/
-static gptp_pi_controller_t rGptpPi =
-{
-    .s32proportional = 0,
-    .s32integrational = 0,
-    .s32calculated = 0,
-    .prConfiguration = NULL,
-};
+#ifdef GPTP_FIXED_POINT
+/* Minimal natural frequency for the narrow band in Q16 */
+#define PI_NARROW_BAND_MIN_W_Q16              ((int64_t)6 * GPTP_FXP_Q16_ONE)
+/* Nanoseconds in one second */
+#define PI_NS_IN_SECOND                       1000000000.0
+#endif /* GPTP_FIXED_POINT */
 
 /*******************************************************************************
  * Code
@@ -43,15 +39,39 @@ static gptp_pi_controller_t rGptpPi =
  *
  * @details This function initializes PI Controller and cleans all variables.
  *
+ * @param[out] prPi Pointer to the PI controller context (one per domain).
  * @param[in] prConfiguration Pointer to the PI controller configuration structure.
  *
  * @ requirements 529199
  * @ requirements 539904
  */
-void GPTP_PI_Init(const gptp_def_pi_controller_conf_t *prConfiguration)
+void GPTP_PI_Init(gptp_def_pi_controller_t *prPi,
+                  const gptp_def_pi_controller_conf_t *prConfiguration)
 {
-    rGptpPi.prConfiguration = prConfiguration;
-    GPTP_PI_Clear();
+    prPi->prConfiguration = prConfiguration;
+#ifdef GPTP_FIXED_POINT
+    prPi->s64KpQ16 = 0;
+    prPi->s64KiDtQ16 = 0;
+    prPi->s64WDtQ16 = 0;
+    prPi->s64WDtNsQ16 = 0;
+    prPi->s64Damping2Q16 = 0;
+
+    /* The natural frequency is inversely proportional to the sync interval, so
+       w * dt is constant and all floating point work is done here, once */
+    if (NULL != prConfiguration)
+    {
+        if ((0.0 > prConfiguration->f64NatFreqRatio) || (0.0 < prConfiguration->f64NatFreqRatio))
+        {
+            prPi->s64WDtQ16 = GPTP_FXP_Float64ToQ16((2.0 * PI_PI_RATIO) / prConfiguration->f64NatFreqRatio);
+            prPi->s64WDtNsQ16 = GPTP_FXP_Float64ToQ16(((2.0 * PI_PI_RATIO) * PI_NS_IN_SECOND) / prConfiguration->f64NatFreqRatio);
+        }
+        prPi->s64Damping2Q16 = GPTP_FXP_Float64ToQ16(2.0 * prConfiguration->f64DampingRatio);
+    }
+#else
+    prPi->f64Kp = 0.0;
+    prPi->f64Ki = 0.0;
+#endif /* GPTP_FIXED_POINT */
+    GPTP_PI_Clear(prPi);
 }
 
 /*!
@@ -59,19 +79,21 @@ void GPTP_PI_Init(const gptp_def_pi_controller_conf_t *prConfiguration)
  * @brief   This function initializes PI Controller.
  *
  * @details This function initializes PI Controller and cleans all variables.
+ *          The sync lock is not touched, it is up to the caller to reset it
+ *          for the domain updating the local clock.
+ *
+ * @param[in,out] prPi Pointer to the PI controller context.
  *
  * @ requirements 529199
  * @ requirements 539905
  */
-void GPTP_PI_Clear(void)
+void GPTP_PI_Clear(gptp_def_pi_controller_t *prPi)
 {
-    rGptpPi.s32proportional = 0;
-    rGptpPi.s32integrational = 0;
-    rGptpPi.s32calculated = 0;
-    rGptpPi.s32error = 0;
-
-    /* Reset sync lock and report to the app. */
-    GPTP_INTERNAL_ResetSyncLock(GPTP_GetMainStrPtr());
+    prPi->s32proportional = 0;
+    prPi->s32integrational = 0;
+    prPi->s32calculated = 0;
+    prPi->s32error = 0;
+    prPi->bNarrowBand = false;
 }
 
 /*!
@@ -82,6 +104,7 @@ void GPTP_PI_Clear(void)
  *          then correction based on proportional and integral terms of controller is applied.
  *          
  * 
+ * @param[in,out] prPi Pointer to the PI controller context.
  * @param[in] s8SyncInterval Current Sync interval.
  * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
  * @return New correction value [PPB].
@@ -89,28 +112,76 @@ void GPTP_PI_Clear(void)
  * @ requirements 529199
  * @ requirements 539906
  */
-int32_t GPTP_PI_Update(int8_t s8SyncInterval,
+int32_t GPTP_PI_Update(gptp_def_pi_controller_t *prPi,
+                       int8_t s8SyncInterval,
                        int32_t s32ErrorNs)
 {
+#ifdef GPTP_FIXED_POINT
+    /* Period of the synchronization interval [ns] */
+    int64_t        s64DtNs;
+    /* Natural frequency of the system in Q16 [rad*s-1] */
+    int64_t        s64WQ16 = GPTP_FXP_Q16_ONE;
+    /* Natural frequency multiplied by the period in Q16 [rad] */
+    int64_t        s64WDtQ16;
+#else
     /* Period of the synchronization interval [s] */
     float64_t      f64Dt;
     /* Natural frequency of the system [rad*s-1] */
     float64_t      f64W = 1.0;
+#endif /* GPTP_FIXED_POINT */
     /* Absolute error value */
     const uint32_t u32absError = (s32ErrorNs < 0) ? (uint32_t)-s32ErrorNs : (uint32_t)s32ErrorNs;
 
-    if (NULL != rGptpPi.prConfiguration)
+    if (NULL != prPi->prConfiguration)
     {
+#ifdef GPTP_FIXED_POINT
+        /* Calculate sampling period from the current synchronization interval index */
+        s64DtNs = (int64_t)GPTP_INTERNAL_Log2Ns(s8SyncInterval);
+        /* Natural frequency 1.0 unless the configuration says otherwise */
+        s64WDtQ16 = (s64DtNs * GPTP_FXP_Q16_ONE) / (int64_t)GPTP_DEF_NS_IN_SECONDS;
+
+        if ((0 != s64DtNs) && (0 != prPi->s64WDtNsQ16))
+        {
+            /* Calculate natural frequency from sampling frequency(converted to angle frequency) divided by frequency ratio */
+            s64WQ16 = prPi->s64WDtNsQ16 / s64DtNs;
+            s64WDtQ16 = prPi->s64WDtQ16;
+
+            /* Narrow band for decreasing the oscillation in steady state of the PI controller */
+            prPi->bNarrowBand = (bool)(u32absError < (uint32_t)PI_NARROW_BAND_THRESHOLD) && (bool)(s64WQ16 > PI_NARROW_BAND_MIN_W_Q16);
+            if (true == prPi->bNarrowBand)
+            {
+                /* Decreasing natural frequency also brings decreasing the gain of P and I terms */
+                s64WQ16 /= 2;
+                s64WDtQ16 /= 2;
+            }
+        }
+        else
+        {
+            /* Register error -  can't divide by 0 */
+            GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_A_DIV_BY_0_ATTEMPT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+
+        /* Calculate proportional gain of controller */
+        prPi->s64KpQ16 = (prPi->s64Damping2Q16 * s64WQ16) / GPTP_FXP_Q16_ONE;
+
+        /* Calculate integrational gain of controller multiplied by the period (w^2 * dt) */
+        prPi->s64KiDtQ16 = (s64WQ16 * s64WDtQ16) / GPTP_FXP_Q16_ONE;
+
+        /* Calculate action intervention as PI controller output */
+        prPi->s32proportional = GPTP_FXP_GainMul(s32ErrorNs, prPi->s64KpQ16);
+        prPi->s32integrational += GPTP_FXP_GainMul(s32ErrorNs, prPi->s64KiDtQ16);
+#else
         /* Calculate sampling period from the current synchronization interval index */
         f64Dt = (float64_t)GPTP_INTERNAL_Log2Ns(s8SyncInterval) / 1000000000.0;
 
-        if (((0.0 > f64Dt) || (0.0 < f64Dt)) && ((0.0 > rGptpPi.prConfiguration->f64NatFreqRatio) || (0.0 < rGptpPi.prConfiguration->f64NatFreqRatio)))
+        if (((0.0 > f64Dt) || (0.0 < f64Dt)) && ((0.0 > prPi->prConfiguration->f64NatFreqRatio) || (0.0 < prPi->prConfiguration->f64NatFreqRatio)))
         {
             /* Calculate natural frequency from sampling frequency(converted to angle frequency) divided by frequency ratio */
-            f64W = ((2.0 * PI_PI_RATIO) / f64Dt) / rGptpPi.prConfiguration->f64NatFreqRatio;
+            f64W = ((2.0 * PI_PI_RATIO) / f64Dt) / prPi->prConfiguration->f64NatFreqRatio;
 
             /* Narrow band for decreasing the oscillation in steady state of the PI controller */
-            if ((bool)(u32absError < (uint32_t)PI_NARROW_BAND_THRESHOLD) && (bool)(f64W > 6.0))
+            prPi->bNarrowBand = (bool)(u32absError < (uint32_t)PI_NARROW_BAND_THRESHOLD) && (bool)(f64W > 6.0);
+            if (true == prPi->bNarrowBand)
             {
                 /* Decreasing natural frequency also brings decreasing the gain of P and I terms */
                 f64W /= 2.0;
@@ -123,32 +194,33 @@ int32_t GPTP_PI_Update(int8_t s8SyncInterval,
         }
 
         /* Calculate proportional gain of controller */
-        rGptpPi.f64Kp = (2.0 * rGptpPi.prConfiguration->f64DampingRatio) * f64W;
+        prPi->f64Kp = (2.0 * prPi->prConfiguration->f64DampingRatio) * f64W;
 
         /* Calculate integrational gain of controller */
-        rGptpPi.f64Ki = f64W * f64W;
+        prPi->f64Ki = f64W * f64W;
         
         /* Calculate action intervention as PI controller output */
-        rGptpPi.s32proportional = GPTP_INTERNAL_Float64ToInt32((float64_t)s32ErrorNs * rGptpPi.f64Kp);
-        rGptpPi.s32integrational += GPTP_INTERNAL_Float64ToInt32((float64_t)s32ErrorNs * (rGptpPi.f64Ki * f64Dt));
+        prPi->s32proportional = GPTP_INTERNAL_Float64ToInt32((float64_t)s32ErrorNs * prPi->f64Kp);
+        prPi->s32integrational += GPTP_INTERNAL_Float64ToInt32((float64_t)s32ErrorNs * (prPi->f64Ki * f64Dt));
+#endif /* GPTP_FIXED_POINT */
 
         /* If windup limit is configured (avoids overshooting) */
-        if (0U != rGptpPi.prConfiguration->u32IntegralWindupLimit)
+        if (0U != prPi->prConfiguration->u32IntegralWindupLimit)
         {
-            if (rGptpPi.s32integrational > (int32_t)rGptpPi.prConfiguration->u32IntegralWindupLimit)
+            if (prPi->s32integrational > (int32_t)prPi->prConfiguration->u32IntegralWindupLimit)
             {
-                rGptpPi.s32integrational = (int32_t)rGptpPi.prConfiguration->u32IntegralWindupLimit;
+                prPi->s32integrational = (int32_t)prPi->prConfiguration->u32IntegralWindupLimit;
             }
-            else if (rGptpPi.s32integrational < (-((int32_t)rGptpPi.prConfiguration->u32IntegralWindupLimit)))
+            else if (prPi->s32integrational < (-((int32_t)prPi->prConfiguration->u32IntegralWindupLimit)))
             {
-                rGptpPi.s32integrational = (-((int32_t)rGptpPi.prConfiguration->u32IntegralWindupLimit));
+                prPi->s32integrational = (-((int32_t)prPi->prConfiguration->u32IntegralWindupLimit));
             }
         }
 
-        rGptpPi.s32calculated = rGptpPi.s32proportional + rGptpPi.s32integrational;
+        prPi->s32calculated = prPi->s32proportional + prPi->s32integrational;
 
         /* Store current error */
-        rGptpPi.s32error = s32ErrorNs;
+        prPi->s32error = s32ErrorNs;
     }
     else
     {
@@ -157,7 +229,31 @@ int32_t GPTP_PI_Update(int8_t s8SyncInterval,
     }
 
     /* Return calculated value in PPB format */
-    return rGptpPi.s32calculated;
+    return prPi->s32calculated;
+}
+
+/*!
+ * @brief   This function aligns PI Controller to the correction applied by another servo.
+ * @details The integrational part takes over the applied correction, so the controller
+ *          continues from the current frequency of the clock once its output is applied.
+ *          The error is only stored, it is measured against the clock steered by the other servo.
+ * @param[in,out] prPi Pointer to the PI controller context.
+ * @param[in] s32ErrorNs Current error value (difference between setpoint and measurement) [ns].
+ * @param[in] s32AppliedPpb Correction applied to the clock [PPB].
+ * @return Applied correction value [PPB].
+ */
+int32_t GPTP_PI_Track(gptp_def_pi_controller_t *prPi,
+                      int32_t s32ErrorNs,
+                      int32_t s32AppliedPpb)
+{
+    prPi->s32proportional = 0;
+    prPi->s32integrational = s32AppliedPpb;
+    prPi->s32calculated = s32AppliedPpb;
+    prPi->s32error = s32ErrorNs;
+    prPi->bNarrowBand = false;
+
+    /* Return calculated value in PPB format */
+    return prPi->s32calculated;
 }
 
 /*******************************************************************************
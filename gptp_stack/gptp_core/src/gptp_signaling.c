@@ -101,6 +101,9 @@ void GPTP_SIGNALING_RxSignaling(const gptp_def_data_t *prGptp,
                     GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_I_SYNC_INTERVAL_OOR, GPTP_ERR_SEQ_ID_NOT_SPECIF);
                 }
             }
+
+            /* Check the sync due again with the updated interval */
+            GPTP_TIMER_TimerArm(&rSync->rTimerSyncSend, rSync->u64TimerSyncSendDue);
         }
         /* If the port is slave, ignore signaling message - don't change pdelay interval */
     }
@@ -140,7 +143,9 @@ void GPTP_SIGNALING_SendSignaling(const gptp_def_data_t *prGptp,
     prDomain->rTxDataSig.eMsgId = GPTP_DEF_MSG_TYPE_SIGNALING;
     prDomain->rTxDataSig.s8LogMessagePeriod = s8Interval;
 
+#ifndef GPTP_TX_ZERO_COPY
     prDomain->rTxDataSig.pau8TxBuffPtr = prDomain->au8SendBuffSig;
+#endif /* GPTP_TX_ZERO_COPY */
     prDomain->rTxDataSig.bTsRequested = false;
     prDomain->rTxDataSig.u16VlanTci = prDomain->u16VlanTci;
 
@@ -23,6 +23,8 @@
 #include "gptp.h"
 #include "gptp_internal.h"
 #include "gptp_sync.h"
+#include "gptp_fxp.h"
+#include "gptp_filt.h"
 
 /*******************************************************************************
  * Prototypes
@@ -34,6 +36,20 @@ static void GPTP_SYNC_CalculateOffset(const gptp_def_timestamp_t *rUpstreamTime,
 
 static void GPTP_SYNC_SyncedGmCalculate(gptp_def_sync_t *prMachine);
 
+static bool GPTP_SYNC_OutlierThrCheck(const gptp_def_data_t *prGptp,
+                                      const gptp_def_domain_t *prDomain,
+                                      const gptp_def_sync_t *prMachine,
+                                      int64_t s64OffsetNs,
+                                      uint64_t u64SyncDeviation);
+
+static void GPTP_SYNC_OffsetFilter(const gptp_def_data_t *prGptp,
+                                   gptp_def_domain_t *prDomain,
+                                   const gptp_def_sync_t *prMachine,
+                                   gptp_def_timestamp_sig_t *prOffset,
+                                   bool *pbNegative,
+                                   int64_t s64OffsetNs,
+                                   bool bRestart);
+
 /*******************************************************************************
  * Local Functions
  ******************************************************************************/
@@ -142,8 +158,8 @@ static void GPTP_SYNC_CalculateOffset(const gptp_def_timestamp_t *rUpstreamTime,
 
 static void GPTP_SYNC_SyncedGmCalculate(gptp_def_sync_t *prMachine)
 {
-    static gptp_def_timestamp_t rFreeRunClk;
-    static gptp_def_timestamp_t rCorrectedClk;
+    gptp_def_timestamp_t        rFreeRunClk;
+    gptp_def_timestamp_t        rCorrectedClk;
     uint64_t                    u64FreeRunClk;
     uint64_t                    u64CorrClk;
     uint64_t                    u64TsTs;
@@ -174,6 +190,82 @@ static void GPTP_SYNC_SyncedGmCalculate(gptp_def_sync_t *prMachine)
     }
 }
 
+/**
+ * @brief The function checks the Sync against the outlier threshold.
+ *
+ * The adaptive fences of the offset filter window are used if configured and
+ * the window is filled enough, the fixed threshold of the GM time deviation otherwise.
+ * Offsets stepping the clock are always checked against the fixed threshold.
+ *
+ * @return true if the Sync is not an outlier, false otherwise.
+ */
+static bool GPTP_SYNC_OutlierThrCheck(const gptp_def_data_t *prGptp,
+                                      const gptp_def_domain_t *prDomain,
+                                      const gptp_def_sync_t *prMachine,
+                                      int64_t s64OffsetNs,
+                                      uint64_t u64SyncDeviation)
+{
+    int64_t s64LowNs;
+    int64_t s64HighNs;
+    bool    bWithinThr;
+
+    /* The applied correction slows the local clock down */
+    if ((0u != prDomain->u8OfsFiltIqrGain) && \
+        (GPTP_INTERNAL_AbsInt64ToUint64(s64OffsetNs) <= prGptp->rPerDeviceParams.u64PIControllerMaxThreshold) && \
+        (true == GPTP_FILT_IqrFences(&prDomain->rOfsFilt, prDomain->u8OfsFiltIqrGain, (int64_t)GPTP_INTERNAL_TsToU64(prMachine->rTrTs), \
+                                     -prGptp->rPerDeviceParams.s32ClockAdjPpb, &s64LowNs, &s64HighNs)))
+    {
+        bWithinThr = ((s64LowNs <= s64OffsetNs) && (s64OffsetNs <= s64HighNs));
+    }
+
+    else
+    {
+        bWithinThr = (u64SyncDeviation < prDomain->u32SyncOutlierThrNs);
+    }
+
+    return bWithinThr;
+}
+
+/**
+ * @brief The function adds the Sync to the offset filter window and replaces the offset by the filter output.
+ *
+ * Offsets stepping the clock restart the window and are not replaced. The window
+ * also restarts when the GM time is not continuous with the window.
+ */
+static void GPTP_SYNC_OffsetFilter(const gptp_def_data_t *prGptp,
+                                   gptp_def_domain_t *prDomain,
+                                   const gptp_def_sync_t *prMachine,
+                                   gptp_def_timestamp_sig_t *prOffset,
+                                   bool *pbNegative,
+                                   int64_t s64OffsetNs,
+                                   bool bRestart)
+{
+    int64_t s64FilteredNs;
+
+    if ((true == bRestart) || \
+        (GPTP_INTERNAL_AbsInt64ToUint64(s64OffsetNs) > prGptp->rPerDeviceParams.u64PIControllerMaxThreshold))
+    {
+        GPTP_FILT_Reset(&prDomain->rOfsFilt);
+    }
+
+    if (GPTP_INTERNAL_AbsInt64ToUint64(s64OffsetNs) <= prGptp->rPerDeviceParams.u64PIControllerMaxThreshold)
+    {
+        /* The applied correction slows the local clock down. It is the one of the
+           domain steering the clock, zero if no domain steers it. */
+        GPTP_FILT_Add(&prDomain->rOfsFilt, prDomain->u8OfsFiltWindow, (int64_t)GPTP_INTERNAL_TsToU64(prMachine->rTrTs), \
+                      s64OffsetNs, -prGptp->rPerDeviceParams.s32ClockAdjPpb);
+
+        if ((GPTP_DEF_OFS_FILT_NONE != prDomain->eOfsFiltType) && \
+            (true == GPTP_FILT_Output(&prDomain->rOfsFilt, prDomain->eOfsFiltType, &s64FilteredNs)) && \
+            ((uint64_t)GPTP_DEF_NS_IN_SECONDS > GPTP_INTERNAL_AbsInt64ToUint64(s64FilteredNs)))
+        {
+            *pbNegative = (0 > s64FilteredNs);
+            prOffset->s64TimeStampS = 0;
+            prOffset->s32TimeStampNs = (int32_t)GPTP_INTERNAL_AbsInt64ToUint64(s64FilteredNs);
+        }
+    }
+}
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
@@ -210,8 +302,8 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                            const uint8_t u8Machine,
                            const gptp_def_sm_call_type_t eCallType)
 {
-    static gptp_def_timestamp_sig_t    rSyncOffset;
-    static gptp_def_timestamp_t        rGmTimePlusCorr;
+    gptp_def_timestamp_sig_t           rSyncOffset;
+    gptp_def_timestamp_t               rGmTimePlusCorr;
     gptp_def_timestamp_t               rGmTimePlusCorrExpected;
     gptp_def_timestamp_t               rSinceLastValidElapsed;
 
@@ -219,21 +311,27 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
     gptp_def_timestamp_sig_t           rGmTimePlusCorrSig;
 
     int64_t                            s64SyncDeviation;
+    int64_t                            s64OffsetNs;
 
-    static bool                        bNegativeOffset;
+    bool                               bNegativeOffset;
     const gptp_def_domain_t            *prSyncGmRefDomain;
     const gptp_def_sync_t              *prSlaveMachine;
 
+#ifndef GPTP_FIXED_POINT
     float64_t                          f64Temp;
+#endif /* GPTP_FIXED_POINT */
     uint32_t                           u32CorrectionNs;
     uint32_t                           u32CorrectionS;
     uint64_t                           u64CorrectionNs;
+    uint64_t                           u64ResidenceEndNs;
 
     gptp_def_domain_t                  *prDomain;
     gptp_def_sync_t                    *prMachine;
     gptp_def_sync_t                    *prMasterMachine;
     uint8_t                            u8SlaveId;
+#ifndef GPTP_FIXED_POINT
     float64_t                          f64MeanPropDelay;
+#endif /* GPTP_FIXED_POINT */
     gptp_err_type_t                    eErr;
     uint8_t                            u8MasterMachines;
 
@@ -318,7 +416,9 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                         /* Log message period */
                         prMachine->rTxDataSyn.s8LogMessagePeriod = prMachine->s8SyncIntervalLog;
                         /* Provide TX buffer pointer */
+#ifndef GPTP_TX_ZERO_COPY
                         prMachine->rTxDataSyn.pau8TxBuffPtr = prMachine->au8SendBuffSync;
+#endif /* GPTP_TX_ZERO_COPY */
                         prMachine->rTxDataSyn.bTsRequested = true;
                         prMachine->rTxDataSyn.bSyncActingGm = prDomain->bSyncActingGm;
                         prMachine->rTxDataSyn.u16VlanTci = prDomain->u16VlanTci;
@@ -393,6 +493,7 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                                 {
                                     /* Get current time */
                                     prMasterMachine->u64ResidenceMeasStartPtpNs = GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING));
+                                    GPTP_TIMER_TimerArm(&prMasterMachine->rTimerResidence, prMasterMachine->u64ResidenceMeasStartPtpNs + GPTP_DEF_10_MS_IN_NS + 1u);
                                 }
                             }
                         }
@@ -423,10 +524,16 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                             {
                                 /* Calculate mean propagation delay */
                                 /* Delay asymetry is 0 */
+#ifdef GPTP_FIXED_POINT
+                                prMachine->u32MeanPropDelay = (uint32_t)(GPTP_FXP_RatioDiv(GPTP_FXP_Float64ToQ16(*prMachine->pf64NeighborPropDelay) + \
+                                                                                           ((int64_t)*prMachine->ps16DelayAsymmetry * GPTP_FXP_Q16_ONE), \
+                                                                                           GPTP_FXP_Float64ToQ32(*prMachine->pf64NeighborRateRatio)) / GPTP_FXP_Q16_ONE);
+#else
                                 f64MeanPropDelay = ((*prMachine->pf64NeighborPropDelay + ((float64_t)*prMachine->ps16DelayAsymmetry)) / (*prMachine->pf64NeighborRateRatio)) + \
                                                    (0.0 / prMachine->f64RateRatio);
                                 /* Convert mean propagation delay into uint32 type */
                                 prMachine->u32MeanPropDelay = (uint32_t)f64MeanPropDelay;
+#endif /* GPTP_FIXED_POINT */
                             }
 
                             /* If dNeighborRateRation or f64RateRatio is equal to 0.0 */
@@ -512,7 +619,17 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                                         s64SyncDeviation = s64SyncDeviation * (-1);
                                     }
 
-                                    if ((((uint64_t)s64SyncDeviation < prDomain->u32SyncOutlierThrNs) || (prDomain->u8OutlierIgnoreCnt <= prDomain->u8OutlierCnt)) || \
+                                    /* Calculate offset between upstream Tx time and grandmaster time */
+                                    GPTP_SYNC_CalculateOffset(&prMachine->rUpstreamTxTime, &rGmTimePlusCorr, &rSyncOffset, &bNegativeOffset);
+
+                                    s64OffsetNs = GPTP_INTERNAL_TsToS64(rSyncOffset);
+                                    if (true == bNegativeOffset)
+                                    {
+                                        s64OffsetNs = -s64OffsetNs;
+                                    }
+
+                                    if (((true == GPTP_SYNC_OutlierThrCheck(prGptp, prDomain, prMachine, s64OffsetNs, (uint64_t)s64SyncDeviation)) || \
+                                         (prDomain->u8OutlierIgnoreCnt <= prDomain->u8OutlierCnt)) || \
                                         (false == prDomain->bRcvdSyncUsedForLocalClk))
                                     {
 #ifdef GPTP_USE_PRINTF
@@ -523,8 +640,12 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                                         }
                                         bUpdateStateBeforeUpdate = prDomain->bRcvdSyncUsedForLocalClk;
 #endif  /* GPTP_USE_PRINTF */
-                                        /* Calculate offset between upstream Tx time and grandmaster time */
-                                        GPTP_SYNC_CalculateOffset(&prMachine->rUpstreamTxTime, &rGmTimePlusCorr, &rSyncOffset, &bNegativeOffset);
+                                        /* Robust pre-filter, the window restarts after the outliers have been ignored */
+                                        if ((GPTP_DEF_OFS_FILT_NONE != prDomain->eOfsFiltType) || (0u != prDomain->u8OfsFiltIqrGain))
+                                        {
+                                            GPTP_SYNC_OffsetFilter(prGptp, prDomain, prMachine, &rSyncOffset, &bNegativeOffset, s64OffsetNs, \
+                                                                   ((prDomain->u8OutlierIgnoreCnt <= prDomain->u8OutlierCnt) || (false == prDomain->bRcvdSyncUsedForLocalClk)));
+                                        }
 
                                         /* Update synchronization lock. */
                                         GPTP_INTERNAL_UpdateSyncLock(prGptp, rSyncOffset);
@@ -701,7 +822,9 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                 /* Copy the calculated rate ratio into the Sync follow up message content */
                 prMachine->rTxDataFup.f64RateRatio = prMachine->f64RateRatio;
                 /* Provide TX buffer pointer */
+#ifndef GPTP_TX_ZERO_COPY
                 prMachine->rTxDataFup.pau8TxBuffPtr = prMachine->au8SendBuffFup;
+#endif /* GPTP_TX_ZERO_COPY */
                 /* Time stamp is not requested */
                 prMachine->rTxDataFup.bTsRequested = false;
 
@@ -712,10 +835,17 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                     if (false == prMachine->bSyncActingGm)
                     {
                         /* Partial correction field calculation */
+#ifdef GPTP_FIXED_POINT
+                        /* Correction field calculation, residence time is converted to sub-nanoseconds before scaling */
+                        prMachine->u64CorrectionSubNs = prSlaveMachine->u64CorrectionSubNs + \
+                                                        (uint64_t)GPTP_FXP_RatioMul((int64_t)GPTP_INTERNAL_TsToU64(GPTP_INTERNAL_TsMinTs(prMachine->rTsTs, prSlaveMachine->rUpstreamTxTime)) * GPTP_FXP_Q16_ONE, \
+                                                                                    GPTP_FXP_Float64ToQ32(prMachine->f64RateRatio));
+#else
                         f64Temp = (float64_t)GPTP_INTERNAL_TsToU64(GPTP_INTERNAL_TsMinTs(prMachine->rTsTs, prSlaveMachine->rUpstreamTxTime));
                         f64Temp *= prMachine->f64RateRatio;
                         /* Correction field calculation */
                         prMachine->u64CorrectionSubNs = prSlaveMachine->u64CorrectionSubNs + (((uint64_t)f64Temp) << 16u);
+#endif /* GPTP_FIXED_POINT */
                         /* In case of Bridge functionality */
                         /* As non GM, use received timestamp from the slave port */
                         prMachine->rTxDataFup.rTs.u64TimeStampS = prSlaveMachine->rPrecOrigTsRcvd.u64TimeStampS;
@@ -805,7 +935,11 @@ void GPTP_SYNC_SyncMachine(gptp_def_data_t *prGptp,
                 {
                     if (0u != prMachine->u64ResidenceMeasStartPtpNs)
                     {
-                        if (GPTP_DEF_10_MS_IN_NS < ((GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING))) - prMachine->u64ResidenceMeasStartPtpNs))
+                        u64ResidenceEndNs = GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING));
+#ifdef GPTP_COUNTERS
+                        GPTP_INTERNAL_DomainHistAdd(prGptp, u8Domain, u8Machine, prMachine->u64ResidenceMeasStartPtpNs, u64ResidenceEndNs);
+#endif /* GPTP_COUNTERS */
+                        if (GPTP_DEF_10_MS_IN_NS < (u64ResidenceEndNs - prMachine->u64ResidenceMeasStartPtpNs))
                         {
                             /* Register error - residence time too long */
                             GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_L_TOO_LONG_RESIDENCE, prMachine->u16SequenceId);
@@ -23,6 +23,584 @@
 #include "gptp_signaling.h"
 #include "gptp_port.h"
 #include "gptp_internal.h"
+#include "gptp_hold.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void GPTP_TIMER_TimerUnlink(gptp_def_timer_t *prTimer);
+
+static void GPTP_TIMER_TimerLink(gptp_def_timer_t *prTimer,
+                                 gptp_def_timer_t **pprHead);
+
+static void GPTP_TIMER_TimerBind(gptp_def_timer_wheel_t *prWheel,
+                                 gptp_def_timer_t *prTimer,
+                                 const gptp_def_timer_type_t eType,
+                                 const uint8_t u8Index,
+                                 const uint8_t u8Machine);
+
+static void GPTP_TIMER_WheelAdvance(gptp_def_timer_wheel_t *prWheel,
+                                    const uint64_t u64CurrentTimeNs);
+
+static void GPTP_TIMER_SyncSendNonGmMachine(gptp_def_data_t *prGptp,
+                                            gptp_def_domain_t *prDomain,
+                                            const uint8_t u8Machine,
+                                            const uint64_t u64CurrentTimeNs,
+                                            const gptp_def_sm_call_type_t rCallType);
+
+static void GPTP_TIMER_SyncIntervalCheck(gptp_def_data_t *prGptp,
+                                         gptp_def_domain_t *prDomain);
+
+static void GPTP_TIMER_SyncStatCalc(gptp_def_data_t *prGptp);
+
+static void GPTP_TIMER_TimerExpired(gptp_def_data_t *prGptp,
+                                    const gptp_def_timer_t *prTimer,
+                                    const uint64_t u64CurrentTimeNs);
+
+/*******************************************************************************
+ * Local Functions
+ ******************************************************************************/
+
+/*!
+ * @brief The function removes timer entry from the list it is linked in.
+ *
+ * @param[in] Pointer to the timer entry.
+ */
+static void GPTP_TIMER_TimerUnlink(gptp_def_timer_t *prTimer)
+{
+    if (NULL != prTimer->pprPrev)
+    {
+        *prTimer->pprPrev = prTimer->prNext;
+        if (NULL != prTimer->prNext)
+        {
+            prTimer->prNext->pprPrev = prTimer->pprPrev;
+        }
+
+        prTimer->prNext = NULL;
+        prTimer->pprPrev = NULL;
+    }
+}
+
+/*!
+ * @brief The function inserts timer entry to the head of a list.
+ *
+ * @param[in] Pointer to the timer entry.
+ * @param[in] Pointer to the list head.
+ */
+static void GPTP_TIMER_TimerLink(gptp_def_timer_t *prTimer,
+                                 gptp_def_timer_t **pprHead)
+{
+    prTimer->prNext = *pprHead;
+    if (NULL != prTimer->prNext)
+    {
+        prTimer->prNext->pprPrev = &prTimer->prNext;
+    }
+
+    *pprHead = prTimer;
+    prTimer->pprPrev = pprHead;
+}
+
+/*!
+ * @brief The function assigns timer entry to the wheel and its owner.
+ *
+ * @param[in] Pointer to the timer wheel.
+ * @param[in] Pointer to the timer entry.
+ * @param[in] Timer type.
+ * @param[in] Port or domain index of the owner.
+ * @param[in] Sync machine index of the owner.
+ */
+static void GPTP_TIMER_TimerBind(gptp_def_timer_wheel_t *prWheel,
+                                 gptp_def_timer_t *prTimer,
+                                 const gptp_def_timer_type_t eType,
+                                 const uint8_t u8Index,
+                                 const uint8_t u8Machine)
+{
+    prTimer->prNext = NULL;
+    prTimer->pprPrev = NULL;
+    prTimer->prWheel = prWheel;
+    prTimer->u64WakeNs = 0u;
+    prTimer->eType = eType;
+    prTimer->u8Index = u8Index;
+    prTimer->u8Machine = u8Machine;
+}
+
+/*!
+ * @brief The function moves all expired entries from the wheel to the ready lists.
+ *
+ * @details Only the slots passed since the previous call are visited. The slot of
+ *          the current tick is visited again in the next call, because it may hold
+ *          entries which expire later within the tick.
+ *
+ * @param[in] Pointer to the timer wheel.
+ * @param[in] Current time (freerunning timebase).
+ */
+static void GPTP_TIMER_WheelAdvance(gptp_def_timer_wheel_t *prWheel,
+                                    const uint64_t u64CurrentTimeNs)
+{
+    gptp_def_timer_t            *prTimer;
+    gptp_def_timer_t            *prNext;
+    uint64_t                    u64Tick;
+    uint64_t                    u64CurrentTick;
+    uint32_t                    u32Visited;
+
+    u64CurrentTick = u64CurrentTimeNs >> GPTP_DEF_TIMER_WHEEL_SHIFT;
+    u64Tick = prWheel->u64NextTick;
+    u32Visited = 0u;
+
+    /* Each slot is visited once at most, even if the wheel has not been advanced for a full turn */
+    while ((u64Tick <= u64CurrentTick) && (u32Visited < GPTP_DEF_TIMER_WHEEL_SLOTS))
+    {
+        prTimer = prWheel->aprSlots[u64Tick & (GPTP_DEF_TIMER_WHEEL_SLOTS - 1u)];
+
+        while (NULL != prTimer)
+        {
+            prNext = prTimer->prNext;
+
+            /* The slot is shared by all the turns of the wheel, check the wake-up time */
+            if (prTimer->u64WakeNs <= u64CurrentTimeNs)
+            {
+                GPTP_TIMER_TimerUnlink(prTimer);
+                GPTP_TIMER_TimerLink(prTimer, &prWheel->aprReady[prTimer->eType]);
+            }
+
+            prTimer = prNext;
+        }
+
+        u64Tick++;
+        u32Visited++;
+    }
+
+    prWheel->u64NextTick = u64CurrentTick;
+}
+
+/*!
+ * @brief The function schedules sync of one master machine of non GM domain.
+ *
+ * @param[in] Pointer to general gPTP data structure.
+ * @param[in] Pointer to the respective domain structure.
+ * @param[in] Sync machine index.
+ * @param[in] Current time (freerunning timebase).
+ * @param[in] Call type
+ */
+static void GPTP_TIMER_SyncSendNonGmMachine(gptp_def_data_t *prGptp,
+                                            gptp_def_domain_t *prDomain,
+                                            const uint8_t u8Machine,
+                                            const uint64_t u64CurrentTimeNs,
+                                            const gptp_def_sm_call_type_t rCallType)
+{
+    gptp_def_sync_t             *prSync;
+    uint64_t                    u64MasterIntervalNs;
+    uint64_t                    u64SyncLossNs;
+    uint64_t                    u64WakeNs;
+
+    prSync = &prDomain->prSyncMachines[u8Machine];
+
+    /* Function call type - from periodic function and True acting GM - sync never received*/
+    if ((GPTP_DEF_CALL_INITIATE == rCallType) && (false == prDomain->bValidSyncReceived))
+    {
+        if (prSync->u64TimerSyncSendDue <= u64CurrentTimeNs)
+        {
+            if (true == prSync->bTimerSyncEnabled)
+            {
+                prDomain->bSyncActingGm = true;
+                GPTP_SYNC_SyncMachine(prGptp, prDomain->u8DomainIndex, u8Machine, GPTP_DEF_CALL_INITIATE);
+#ifdef GPTP_USE_PRINTF
+                if (false == prDomain->bActingGmReported)
+                {
+                    GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_STATE, ("gptp: Domain %u acting Grand Master. \n", prDomain->u8DomainNumber));
+                    prDomain->bActingGmReported = true;
+                }
+#endif /* GPTP_USE_PRINTF */
+            }
+            prSync->u64TimerSyncSendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
+        }
+    }
+
+    /* Syncs are sent upon the reception, unless the upstream is lost */
+    else
+    {
+        /* Sync interval for the respective master sync machine */
+        u64MasterIntervalNs = GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
+        /* If the current time is > 125% sync interval */
+        if (u64CurrentTimeNs > (prDomain->u64TimerLastSyncRcvd + (u64MasterIntervalNs + (u64MasterIntervalNs / 4u))))
+        {
+            if (prSync->u64TimerSyncSendDue <= u64CurrentTimeNs)
+            {
+                if (true == prSync->bTimerSyncEnabled)
+                {
+                    prDomain->bSyncActingGm = false;
+                    GPTP_SYNC_SyncMachine(prGptp, prDomain->u8DomainIndex, u8Machine, GPTP_DEF_CALL_INITIATE);
+                }
+                prSync->u64TimerSyncSendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
+            }
+        }
+
+    }
+
+    /* Next check from the periodic function - at the due, once the upstream sync is lost when it is received */
+    u64WakeNs = prSync->u64TimerSyncSendDue;
+    if (true == prDomain->bValidSyncReceived)
+    {
+        u64MasterIntervalNs = GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
+        u64SyncLossNs = prDomain->u64TimerLastSyncRcvd + (u64MasterIntervalNs + (u64MasterIntervalNs / 4u));
+        if (u64WakeNs <= u64SyncLossNs)
+        {
+            u64WakeNs = u64SyncLossNs + 1u;
+        }
+    }
+
+    GPTP_TIMER_TimerArm(&prSync->rTimerSyncSend, u64WakeNs);
+}
+
+/*!
+ * @brief The function checks sync intervals of non GM domain for signaling.
+ *
+ * @param[in] Pointer to general gPTP data structure.
+ * @param[in] Pointer to the respective domain structure.
+ */
+static void GPTP_TIMER_SyncIntervalCheck(gptp_def_data_t *prGptp,
+                                         gptp_def_domain_t *prDomain)
+{
+    gptp_def_sync_t             *prSync;
+    uint8_t                     u8Machine;
+    int8_t                      s8SyncIntervalMinimum;
+    bool                        bMorePorts;
+    bool                        bSendSigMsg;
+
+    s8SyncIntervalMinimum = GPTP_DEF_LOG_SYNC_INT_MAX;
+    bMorePorts = false;
+    bSendSigMsg = false;
+
+    /* Endpoint role - one port */
+    if (1u == prDomain->u8NumberOfSyncsPerDom)
+    {
+        prSync = &prDomain->prSyncMachines[0u];
+        /* If the operating sync interval is not equal to the current ingress sync interval */
+        if (prSync->s8OperSyncIntervalLog != prSync->s8SyncIntervalLog)
+        {
+            s8SyncIntervalMinimum = prSync->s8OperSyncIntervalLog;
+            bSendSigMsg = true;
+        }
+    }
+    /* Bridge role - more master ports */
+    else {
+        /* Find the shortest sync interval */
+        for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
+        {
+            prSync = &prDomain->prSyncMachines[u8Machine];
+            /* Each enabled port but the slave port */
+            if ((u8Machine != prDomain->u8SlaveMachineId) && (true == *(prSync->pbPortEnabled)))
+            {
+                bMorePorts = true;
+                if (s8SyncIntervalMinimum > prSync->s8SyncIntervalLog)
+                {
+                    s8SyncIntervalMinimum = prSync->s8SyncIntervalLog;
+                }
+            }
+        }
+
+        /* If the found minimum is not equal to the current ingress sync interval */
+        if ((s8SyncIntervalMinimum != prDomain->prSyncMachines[prDomain->u8SlaveMachineId].s8SyncIntervalLog) && (true == bMorePorts))
+        {
+            bSendSigMsg = true;
+        }
+    }
+
+    if (true == bSendSigMsg)
+    {
+        /* Send signaling message */
+        GPTP_SIGNALING_SendSignaling(prGptp, prDomain->u8DomainIndex, s8SyncIntervalMinimum);
+    }
+}
+
+/*!
+ * @brief The function calculates the synchronization status (Offset to GM).
+ *
+ * @param[in] Pointer to general gPTP data structure.
+ */
+static void GPTP_TIMER_SyncStatCalc(gptp_def_data_t *prGptp)
+{
+    gptp_def_timestamp_t                rFreeRunningClock;
+    gptp_def_timestamp_t                rCorrectedClock;
+    gptp_def_timestamp_sig_t            rFreeRunningClockSig;
+    gptp_def_timestamp_sig_t            rCorrectedClockSig;
+    gptp_def_timestamp_sig_t            rClockOffsetSig;
+    uint64_t                            u64Elapsed;
+    int32_t                             s32Compensation;
+    gptp_err_type_t                     eErr;
+
+    if (true == prGptp->rPerDeviceParams.bEverUpdated)
+    {
+        eErr = GPTP_PORT_GetSwitchTimes(&rFreeRunningClock, &rCorrectedClock);
+        if (GPTP_ERR_OK != eErr)
+        {
+            rFreeRunningClock.u32TimeStampNs = 0u;
+            rFreeRunningClock.u64TimeStampS = 0u;
+            rCorrectedClock.u32TimeStampNs = 0u;
+            rCorrectedClock.u64TimeStampS = 0u;
+        }
+
+        u64Elapsed = GPTP_INTERNAL_TsToU64(GPTP_INTERNAL_TsMinTs(rFreeRunningClock, prGptp->rPerDeviceParams.rLastFreeRunRef));
+
+        s32Compensation = (int32_t)(((int64_t)(((float64_t)u64Elapsed) * prGptp->rPerDeviceParams.f64CorrClockRateRatio)) - (int64_t)u64Elapsed);
+
+        rFreeRunningClockSig.s32TimeStampNs = (int32_t)rFreeRunningClock.u32TimeStampNs;
+        rFreeRunningClockSig.s64TimeStampS = (int64_t)rFreeRunningClock.u64TimeStampS;
+        rCorrectedClockSig.s32TimeStampNs = (int32_t)rCorrectedClock.u32TimeStampNs;
+        rCorrectedClockSig.s64TimeStampS = (int64_t)rCorrectedClock.u64TimeStampS;
+
+        if (rCorrectedClockSig.s32TimeStampNs >= s32Compensation)
+        {
+            rCorrectedClockSig.s32TimeStampNs -= s32Compensation;
+        }
+        else
+        {
+            rCorrectedClockSig.s32TimeStampNs -= s32Compensation;
+            rCorrectedClockSig.s32TimeStampNs *= -1;
+            rCorrectedClockSig.s32TimeStampNs = ((int32_t)GPTP_DEF_NS_IN_SECONDS) - rCorrectedClockSig.s32TimeStampNs;
+            rCorrectedClockSig.s64TimeStampS -= 1;
+        }
+
+        rClockOffsetSig = GPTP_INTERNAL_TsMinTsSig(rFreeRunningClockSig, rCorrectedClockSig);
+        if (0 > rClockOffsetSig.s32TimeStampNs)
+        {
+            rClockOffsetSig.s32TimeStampNs *= -1;
+            rClockOffsetSig.s64TimeStampS *= -1;
+        }
+
+        prGptp->rPerDeviceParams.rEstimGmOffset = GPTP_INTERNAL_TsMinTsSig(rClockOffsetSig, prGptp->rPerDeviceParams.rReportedOffset);
+        prGptp->rPerDeviceParams.bEstimGmOffsetCalculated = true;
+
+        GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_SYNC, ("gptp: Estimated offset to GM:"));
+        GPTP_PRINTF_TIME_SIG(GPTP_DEBUG_MSGTYPE_SYNC, prGptp->rPerDeviceParams.rEstimGmOffset);
+    }
+
+    else
+    {
+        GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_SYNC, ("gptp: Local clock not updated yet \n"));
+    }
+}
+
+/*!
+ * @brief The function handles expired timer entry.
+ *
+ * @details The entry wake-up time is never later than the time its condition may
+ *          be met, so the original condition is evaluated again here and the entry
+ *          is armed for the next due if it is still needed.
+ *
+ * @param[in] Pointer to general gPTP data structure.
+ * @param[in] Pointer to the expired timer entry.
+ * @param[in] Current time (freerunning timebase).
+ */
+static void GPTP_TIMER_TimerExpired(gptp_def_data_t *prGptp,
+                                    const gptp_def_timer_t *prTimer,
+                                    const uint64_t u64CurrentTimeNs)
+{
+    gptp_def_domain_t                   *prDomain;
+    gptp_def_sync_t                     *prSync;
+    gptp_def_pdelay_t                   *prPdelay;
+
+    switch (prTimer->eType)
+    {
+        /* Pdelay scheduling */
+        case GPTP_DEF_TIMER_PDELAY_SEND:
+            prPdelay = &prGptp->prPdelayMachines[prTimer->u8Index];
+
+            /* Disabled initiator is armed again upon the link up */
+            if (true == prPdelay->bPdelayInitiatorEnabled)
+            {
+                if (prPdelay->u64TimerPdelaySendDue <= u64CurrentTimeNs)
+                {
+                    if (true ==  prPdelay->bTimerPdelayTimerEnabled)
+                    {
+                        GPTP_PDELAY_PdelayMachine(prGptp, prPdelay, GPTP_DEF_CALL_INITIATE);
+                    }
+
+                    prPdelay->u64TimerPdelaySendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns( prPdelay->s8PdelayIntervalLog);
+                }
+
+                GPTP_TIMER_TimerArm(&prPdelay->rTimerPdelaySend, prPdelay->u64TimerPdelaySendDue);
+            }
+            break;
+
+        /* Sync scheduling */
+        case GPTP_DEF_TIMER_SYNC_SEND:
+            prDomain = &prGptp->prPerDomainParams[prTimer->u8Index];
+            prSync = &prDomain->prSyncMachines[prTimer->u8Machine];
+
+            /* For GM domain */
+            if (true == prDomain->bDomainIsGm)
+            {
+                /* If current time equals to the sync send due */
+                if (prSync->u64TimerSyncSendDue <= u64CurrentTimeNs)
+                {
+                    if (true == prSync->bTimerSyncEnabled)
+                    {
+                        GPTP_SYNC_SyncMachine(prGptp, prDomain->u8DomainIndex, prTimer->u8Machine, GPTP_DEF_CALL_INITIATE);
+                    }
+                    prSync->u64TimerSyncSendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
+                }
+
+                GPTP_TIMER_TimerArm(&prSync->rTimerSyncSend, prSync->u64TimerSyncSendDue);
+            }
+
+            /* For non GM domain (Bridge) */
+            else
+            {
+                GPTP_TIMER_SyncSendNonGmMachine(prGptp, prDomain, prTimer->u8Machine, u64CurrentTimeNs, GPTP_DEF_CALL_INITIATE);
+            }
+            break;
+
+        /* Sync interval check - once per 1.5 second (signalling to the upstream) */
+        case GPTP_DEF_TIMER_SYNC_CHECK:
+            prDomain = &prGptp->prPerDomainParams[prTimer->u8Index];
+
+            if (prDomain->u64TimerSyncCheckDue <= u64CurrentTimeNs)
+            {
+                GPTP_TIMER_SyncIntervalCheck(prGptp, prDomain);
+
+                /* schedule the next due in 1.5s */
+                prDomain->u64TimerSyncCheckDue = u64CurrentTimeNs + (uint64_t)GPTP_DEF_1S5_IN_NS;
+            }
+
+            GPTP_TIMER_TimerArm(&prDomain->rTimerSyncCheck, prDomain->u64TimerSyncCheckDue);
+            break;
+
+        /* Pdelay initiator turnaround time check */
+        case GPTP_DEF_TIMER_TURNAROUND_INIT:
+            prPdelay = &prGptp->prPdelayMachines[prTimer->u8Index];
+
+            if (0u != prPdelay->u64TurnaroundMeasStartPtpNsInit)
+            {
+                /* Not expired yet - the measurement has been restarted */
+                if (GPTP_DEF_10_MS_IN_NS >= (u64CurrentTimeNs - prPdelay->u64TurnaroundMeasStartPtpNsInit))
+                {
+                    GPTP_TIMER_TimerArm(&prPdelay->rTimerTurnaroundInit, prPdelay->u64TurnaroundMeasStartPtpNsInit + GPTP_DEF_10_MS_IN_NS + 1u);
+                }
+
+                /* If turnaround time is too long, register error */
+                else if (true == prPdelay->bPdelayInitiatorEnabled)
+                {
+                    GPTP_ERR_Register(prPdelay->u8GptpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_L_TOO_LONG_TURN_INIT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+                    /* Don't measure next time */
+                    prPdelay->u64TurnaroundMeasStartPtpNsInit = 0u;
+                }
+
+                /* Check in the next period while the initiator is disabled */
+                else
+                {
+                    GPTP_TIMER_TimerArm(&prPdelay->rTimerTurnaroundInit, u64CurrentTimeNs);
+                }
+            }
+            break;
+
+        /* Pdelay responder turnaround time check */
+        case GPTP_DEF_TIMER_TURNAROUND_RESP:
+            prPdelay = &prGptp->prPdelayMachines[prTimer->u8Index];
+
+            if (0u != prPdelay->u64TurnaroundMeasStartPtpNsResp)
+            {
+                /* Not expired yet - the measurement has been restarted */
+                if (GPTP_DEF_10_MS_IN_NS >= (u64CurrentTimeNs - prPdelay->u64TurnaroundMeasStartPtpNsResp))
+                {
+                    GPTP_TIMER_TimerArm(&prPdelay->rTimerTurnaroundResp, prPdelay->u64TurnaroundMeasStartPtpNsResp + GPTP_DEF_10_MS_IN_NS + 1u);
+                }
+
+                /* If turnaround time is too long, register error */
+                else if (true == prPdelay->bPdelayResponderEnabled)
+                {
+                    /* Report turnaround time error */
+                    GPTP_ERR_Register(prPdelay->u8GptpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_L_TOO_LONG_TURN_RESP, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+                    /* Don't measure next time */
+                    prPdelay->u64TurnaroundMeasStartPtpNsResp = 0u;
+                }
+
+                /* Check in the next period while the responder is disabled */
+                else
+                {
+                    GPTP_TIMER_TimerArm(&prPdelay->rTimerTurnaroundResp, u64CurrentTimeNs);
+                }
+            }
+            break;
+
+        /* Sync residence time check */
+        case GPTP_DEF_TIMER_RESIDENCE:
+            prDomain = &prGptp->prPerDomainParams[prTimer->u8Index];
+            prSync = &prDomain->prSyncMachines[prTimer->u8Machine];
+
+            /* If residence time start value is not 0, the measurement is in progress (not sync forward finished */
+            if (0u != prSync->u64ResidenceMeasStartPtpNs)
+            {
+                /* Not expired yet - the measurement has been restarted */
+                if (GPTP_DEF_10_MS_IN_NS >= (u64CurrentTimeNs - prSync->u64ResidenceMeasStartPtpNs))
+                {
+                    GPTP_TIMER_TimerArm(&prSync->rTimerResidence, prSync->u64ResidenceMeasStartPtpNs + GPTP_DEF_10_MS_IN_NS + 1u);
+                }
+
+                /* If residence time above 10ms, raise error - only for master machines of non GM domain */
+                else if ((false == prDomain->bDomainIsGm) && (GPTP_DEF_PTP_MASTER == prSync->bSyncRole) && (0u == prSync->u8SkippedSyncs))
+                {
+                    GPTP_ERR_Register(prTimer->u8Machine, prTimer->u8Index, GPTP_ERR_L_TOO_LONG_RESIDENCE, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+                    /* While the residence time is already reported too long, no need to check again */
+                    prSync->u64ResidenceMeasStartPtpNs = 0u;
+                }
+
+                /* Check in the next period */
+                else
+                {
+                    GPTP_TIMER_TimerArm(&prSync->rTimerResidence, u64CurrentTimeNs);
+                }
+            }
+            break;
+
+        /* Sync receipt timeout check */
+        case GPTP_DEF_TIMER_RECEIPT_TIMEOUT:
+            prDomain = &prGptp->prPerDomainParams[prTimer->u8Index];
+
+            /* Check non GM (Bridge) domains */
+            if ((false == prDomain->bDomainIsGm) && (0u != prDomain->u64TimerSyncReceiptTimeoutDue))
+            {
+                /* If sync receipt timeout due, report error */
+                if (prDomain->u64TimerSyncReceiptTimeoutDue <= u64CurrentTimeNs)
+                {
+                    GPTP_ERR_Register(prDomain->u8SlaveMachineId, prTimer->u8Index, GPTP_ERR_S_RECEIPT_TIMEOUT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+                    GPTP_INTERNAL_LosHandle(prGptp, prDomain, prDomain->u8SlaveMachineId, GPTP_ERR_SEQ_ID_NOT_SPECIF);
+                    prDomain->u64TimerSyncReceiptTimeoutDue = 0u;
+
+#ifdef GPTP_COUNTERS
+                    GPTP_INTERNAL_IncrementPortStats(prGptp, prDomain->u8SlaveMachineId, ieee8021AsPortStatRxSyncReceiptTimeouts);
+                    GPTP_INTERNAL_IncrementDomainStats(prGptp, prTimer->u8Index, prDomain->u8SlaveMachineId, ieee8021AsPortStatRxSyncReceiptTimeouts);
+#endif /* GPTP_COUNTERS */
+                }
+
+                else
+                {
+                    GPTP_TIMER_TimerArm(&prDomain->rTimerReceiptTimeout, prDomain->u64TimerSyncReceiptTimeoutDue);
+                }
+            }
+            break;
+
+        /* Print synchronization status (Offset to GM) */
+        case GPTP_DEF_TIMER_SYNC_STAT:
+            if (true == prGptp->bLocClkToUpdate)
+            {
+                if (prGptp->u64SyncStatCalcDue <= u64CurrentTimeNs)
+                {
+                    GPTP_TIMER_SyncStatCalc(prGptp);
+
+                    /* Report Synchronization status periodically with given period */
+                    prGptp->u64SyncStatCalcDue = u64CurrentTimeNs + GPTP_DEF_CALC_PERIOD_100_MS;
+                }
+
+                GPTP_TIMER_TimerArm(&prGptp->rTimerSyncStat, prGptp->u64SyncStatCalcDue);
+            }
+            break;
+
+        default:
+            /* Unknown timer type - not armed again */
+            break;
+    }
+}
 
 /*******************************************************************************
  * Code
@@ -49,6 +627,7 @@ void GPTP_TIMER_LastValidSyncReg(gptp_def_domain_t *prDomain)
     prDomain->u64TimerLastSyncRcvd = u64CurrentTimeNs;
 
     prDomain->u64TimerSyncReceiptTimeoutDue = u64CurrentTimeNs + (GPTP_INTERNAL_Log2Ns(prDomain->prSyncMachines[prDomain->u8SlaveMachineId].s8SyncIntervalLog) * (uint64_t)prDomain->u8SyncReceiptTimeoutCnt);
+    GPTP_TIMER_TimerArm(&prDomain->rTimerReceiptTimeout, prDomain->u64TimerSyncReceiptTimeoutDue);
 
     /* Consider sync message valid */
     prDomain->bValidSyncReceived = true;
@@ -91,6 +670,7 @@ void GPTP_TIMER_PdelayDueUpdate(gptp_def_pdelay_t *prPdelay)
 
     /* Update Pdelay request due */
     prPdelay->u64TimerPdelaySendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns( prPdelay->s8PdelayIntervalLog);
+    GPTP_TIMER_TimerArm(&prPdelay->rTimerPdelaySend, prPdelay->u64TimerPdelaySendDue);
 }
 
 /*!
@@ -112,50 +692,11 @@ void GPTP_TIMER_SyncsSendNonGm(gptp_def_data_t *prGptp,
     int8_t                      s8SlaveIntLog;
     int8_t                      s8IntervLogDiff;
     uint8_t                     u8Gap;
-    uint64_t                    u64MasterIntervalNs;
     gptp_def_timestamp_t        rCurrentTimeTs;
     uint64_t                    u64CurrentTimeNs;
 
-#ifdef GPTP_USE_PRINTF
-    static bool                 bActingGmReported = false;
-#endif /* GPTP_USE_PRINTF */
-
-    rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
-    u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
-
-    /* Function call type - from periodic function and True acting GM - sync never received*/
-    if ((GPTP_DEF_CALL_INITIATE == rCallType) && (false == prDomain->bValidSyncReceived))
-    {
-        /* For all sync machines */
-        for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
-        {
-            prSync = &prDomain->prSyncMachines[u8Machine];
-
-            /* Except of the slave */
-            if (u8Machine != prDomain->u8SlaveMachineId)
-            {
-                if (prSync->u64TimerSyncSendDue <= u64CurrentTimeNs)
-                {
-                    if (true == prSync->bTimerSyncEnabled)
-                    {
-                        prDomain->bSyncActingGm = true;
-                        GPTP_SYNC_SyncMachine(prGptp, prDomain->u8DomainIndex, u8Machine, GPTP_DEF_CALL_INITIATE);
-#ifdef GPTP_USE_PRINTF
-                        if (false == bActingGmReported)
-                        {
-                            GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_STATE, ("gptp: Domain %u acting Grand Master. \n", prDomain->u8DomainNumber));
-                            bActingGmReported = true;
-                        }
-#endif /* GPTP_USE_PRINTF */
-                    }
-                    prSync->u64TimerSyncSendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
-                }
-            }
-        }
-    }
-
     /* Function call type - from the FUP reception and valid sync received */
-    else if ((GPTP_DEF_CALL_PTP_RECEIVED == rCallType) && (true == prDomain->bValidSyncReceived))
+    if ((GPTP_DEF_CALL_PTP_RECEIVED == rCallType) && (true == prDomain->bValidSyncReceived))
     {
         /* Load the sync interval of slave machine */
         s8SlaveIntLog = prDomain->prSyncMachines[prDomain->u8SlaveMachineId].s8SyncIntervalLog;
@@ -201,27 +742,15 @@ void GPTP_TIMER_SyncsSendNonGm(gptp_def_data_t *prGptp,
     /* Call from periodic function */
     else
     {
+        rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
+        u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
+
         for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
         {
             /* But the slave */
             if (u8Machine != prDomain->u8SlaveMachineId)
             {
-                prSync = &prDomain->prSyncMachines[u8Machine];
-                /* Sync interval for the respective master sync machine */
-                u64MasterIntervalNs = GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
-                /* If the current time is > 125% sync interval */
-                if (u64CurrentTimeNs > (prDomain->u64TimerLastSyncRcvd + (u64MasterIntervalNs + (u64MasterIntervalNs / 4u))))
-                {
-                    if (prSync->u64TimerSyncSendDue <= u64CurrentTimeNs)
-                    {
-                        if (true == prSync->bTimerSyncEnabled)
-                        {
-                            prDomain->bSyncActingGm = false;
-                            GPTP_SYNC_SyncMachine(prGptp, prDomain->u8DomainIndex, u8Machine, GPTP_DEF_CALL_INITIATE);
-                        }
-                        prSync->u64TimerSyncSendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
-                    }
-                }
+                GPTP_TIMER_SyncSendNonGmMachine(prGptp, prDomain, u8Machine, u64CurrentTimeNs, rCallType);
             }
         }
     }
@@ -243,19 +772,38 @@ void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp)
     gptp_def_domain_t           *prDomain;
     gptp_def_sync_t             *prSync;
     gptp_def_pdelay_t           *prPdelay;
+    gptp_def_timer_wheel_t      *prWheel;
     gptp_def_timestamp_t        rCurrentTimeTs;
     uint64_t                    u64CurrentTimeNs;
+    uint32_t                    u32Idx;
 
     rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
     u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
 
+    /* Empty timer wheel */
+    prWheel = &prGptp->rTimerWheel;
+    for (u32Idx = 0u; u32Idx < GPTP_DEF_TIMER_WHEEL_SLOTS; u32Idx++)
+    {
+        prWheel->aprSlots[u32Idx] = NULL;
+    }
+    for (u32Idx = 0u; u32Idx < (uint32_t)GPTP_DEF_TIMER_TYPES_CNT; u32Idx++)
+    {
+        prWheel->aprReady[u32Idx] = NULL;
+    }
+    prWheel->u64NextTick = u64CurrentTimeNs >> GPTP_DEF_TIMER_WHEEL_SHIFT;
+
     /* Init Pdelay timers for each port */
     for (u8Port = 0u; u8Port < prGptp->rPerDeviceParams.u8PortsCount; u8Port++)
     {
         prPdelay = &prGptp->prPdelayMachines[u8Port];
 
+        GPTP_TIMER_TimerBind(prWheel, &prPdelay->rTimerPdelaySend, GPTP_DEF_TIMER_PDELAY_SEND, u8Port, 0u);
+        GPTP_TIMER_TimerBind(prWheel, &prPdelay->rTimerTurnaroundInit, GPTP_DEF_TIMER_TURNAROUND_INIT, u8Port, 0u);
+        GPTP_TIMER_TimerBind(prWheel, &prPdelay->rTimerTurnaroundResp, GPTP_DEF_TIMER_TURNAROUND_RESP, u8Port, 0u);
+
         /* Schedule the first Pdelay due */
         prPdelay->u64TimerPdelaySendDue = u64CurrentTimeNs;
+        GPTP_TIMER_TimerArm(&prPdelay->rTimerPdelaySend, prPdelay->u64TimerPdelaySendDue);
 
         /* If the pdelay value is not 127 */
         if (GPTP_DEF_SIG_TLV_STOP_SENDING != prPdelay->s8PdelayIntervalLog)
@@ -279,15 +827,31 @@ void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp)
     {
         prDomain = &prGptp->prPerDomainParams[u8Domain];
 
+        GPTP_TIMER_TimerBind(prWheel, &prDomain->rTimerSyncCheck, GPTP_DEF_TIMER_SYNC_CHECK, u8Domain, 0u);
+        GPTP_TIMER_TimerBind(prWheel, &prDomain->rTimerReceiptTimeout, GPTP_DEF_TIMER_RECEIPT_TIMEOUT, u8Domain, 0u);
+
+        for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
+        {
+            prSync = &prDomain->prSyncMachines[u8Machine];
+
+            GPTP_TIMER_TimerBind(prWheel, &prSync->rTimerSyncSend, GPTP_DEF_TIMER_SYNC_SEND, u8Domain, u8Machine);
+            GPTP_TIMER_TimerBind(prWheel, &prSync->rTimerResidence, GPTP_DEF_TIMER_RESIDENCE, u8Domain, u8Machine);
+        }
+
         /* If domain is not GM (Bridge) */
         if (false == prDomain->bDomainIsGm)
         {
             /* Schedule sync receipt timeout error */
             prDomain->u64TimerSyncReceiptTimeoutDue = u64CurrentTimeNs + (GPTP_INTERNAL_Log2Ns(prDomain->prSyncMachines[prDomain->\
                                                       u8SlaveMachineId].s8SyncIntervalLog) * (uint64_t)prDomain->u8SyncReceiptTimeoutCnt);
+            GPTP_TIMER_TimerArm(&prDomain->rTimerReceiptTimeout, prDomain->u64TimerSyncReceiptTimeoutDue);
 
             /* Check sync period for signaling */
             prDomain->u64TimerSyncCheckDue = u64CurrentTimeNs;
+            if (true == prGptp->rPerDeviceParams.bSignalingEnabled)
+            {
+                GPTP_TIMER_TimerArm(&prDomain->rTimerSyncCheck, prDomain->u64TimerSyncCheckDue);
+            }
 
             /* Last sync received */
             prDomain->u64TimerLastSyncRcvd = 0u;
@@ -303,6 +867,7 @@ void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp)
                     /* Sync send due is after the startup timeout (if no sync received) */
                     /* Syncs when acting GM */
                     prSync->u64TimerSyncSendDue = u64CurrentTimeNs + ((uint64_t)prDomain->u8StartupTimeoutS * (uint64_t)GPTP_DEF_NS_IN_SECONDS);
+                    GPTP_TIMER_TimerArm(&prSync->rTimerSyncSend, prSync->u64TimerSyncSendDue);
 
                     prSync->u8SkippedSyncs = 0u;
 
@@ -331,6 +896,7 @@ void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp)
                 prSync = &prDomain->prSyncMachines[u8Machine];
 
                 prSync->u64TimerSyncSendDue = u64CurrentTimeNs;
+                GPTP_TIMER_TimerArm(&prSync->rTimerSyncSend, prSync->u64TimerSyncSendDue);
 
                 /* Enable sync timer only if the sync interval is not equal 127 */
                 if (GPTP_DEF_SIG_TLV_STOP_SENDING != prSync->s8SyncIntervalLog)
@@ -349,11 +915,54 @@ void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp)
     }
 
     prGptp->u64SyncStatCalcDue = u64CurrentTimeNs + GPTP_DEF_CALC_PERIOD_100_MS;
+    GPTP_TIMER_TimerBind(prWheel, &prGptp->rTimerSyncStat, GPTP_DEF_TIMER_SYNC_STAT, 0u, 0u);
+    if (true == prGptp->bLocClkToUpdate)
+    {
+        GPTP_TIMER_TimerArm(&prGptp->rTimerSyncStat, prGptp->u64SyncStatCalcDue);
+    }
+}
+
+/*!
+ * @brief The function arms internal timer.
+ *
+ * @details The entry is removed from the list it is currently linked in, so
+ *          arming already armed entry moves its wake-up time. Wake-up time in
+ *          the past expires within the next periodic call.
+ *
+ * @param[in] Pointer to the timer entry.
+ * @param[in] Wake-up time (freerunning timebase).
+ */
+void GPTP_TIMER_TimerArm(gptp_def_timer_t *prTimer,
+                         const uint64_t u64WakeNs)
+{
+    gptp_def_timer_wheel_t      *prWheel;
+    uint64_t                    u64Tick;
+
+    prWheel = prTimer->prWheel;
+
+    /* Timers are bound to the wheel within the timers initialization */
+    if (NULL != prWheel)
+    {
+        GPTP_TIMER_TimerUnlink(prTimer);
+
+        prTimer->u64WakeNs = u64WakeNs;
+
+        /* Already passed ticks are not visited again */
+        u64Tick = u64WakeNs >> GPTP_DEF_TIMER_WHEEL_SHIFT;
+        if (u64Tick < prWheel->u64NextTick)
+        {
+            u64Tick = prWheel->u64NextTick;
+        }
+
+        GPTP_TIMER_TimerLink(prTimer, &prWheel->aprSlots[u64Tick & (GPTP_DEF_TIMER_WHEEL_SLOTS - 1u)]);
+    }
 }
 
 /*!
  * @brief The function checks internal timers periodically.
  *
+ * @details Only the timers expired since the previous call are handled.
+ *
  * @param[in] Pointer to general gPTP data structure.
  *
  * @ requirements 529199
@@ -366,314 +975,46 @@ void GPTP_TIMER_TimerInit(gptp_def_data_t *prGptp)
  */
 void GPTP_TIMER_TimerPeriodic(gptp_def_data_t *prGptp)
 {
-    static gptp_def_timestamp_t         rFreeRunningClock;
-    static gptp_def_timestamp_t         rCorrectedClock;
-    gptp_def_domain_t                   *prDomain;
-    gptp_def_sync_t                     *prSync;
-    gptp_def_pdelay_t                   *prPdelay;
+    gptp_def_timer_wheel_t              *prWheel;
+    gptp_def_timer_t                    *prTimer;
     gptp_def_timestamp_t                rCurrentTimeTs;
-    gptp_def_timestamp_sig_t            rFreeRunningClockSig;
-    gptp_def_timestamp_sig_t            rCorrectedClockSig;
-    gptp_def_timestamp_sig_t            rClockOffsetSig;
-    uint8_t                             u8Port;
-    uint8_t                             u8Machine;
-    uint8_t                             u8Domain;
-    int8_t                              s8SyncIntervalMinimum;
     uint64_t                            u64CurrentTimeNs;
-    uint64_t                            u64Elapsed;
-    int32_t                             s32Compensation;
-    gptp_err_type_t                     eErr;
-    bool                                bMorePorts;
-    bool                                bSendSigMsg;
-
-    /* Update current time */
-    rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
-    u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
-
-    /* Pdelay scheduling */
-    for (u8Port = 0u; u8Port < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines; u8Port++)
-    {
-        prPdelay = &prGptp->prPdelayMachines[u8Port];
-
-        if (true == prPdelay->bPdelayInitiatorEnabled)
-        {
-            if (prPdelay->u64TimerPdelaySendDue <= u64CurrentTimeNs)
-            {
-                if (true ==  prPdelay->bTimerPdelayTimerEnabled)
-                {
-                    GPTP_PDELAY_PdelayMachine(prGptp, prPdelay, GPTP_DEF_CALL_INITIATE);
-                }
-
-                 prPdelay->u64TimerPdelaySendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns( prPdelay->s8PdelayIntervalLog);
-            }
-        }
-    }
-
-    rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
-    u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
-
-    /* Sync scheduling */
-    for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
-    {
-        prDomain = &prGptp->prPerDomainParams[u8Domain];
-
-        /* For GM domain */
-        if (true == prDomain->bDomainIsGm)
-        {
-            /* Check for each machine */
-            for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
-            {
-                prSync = &prDomain->prSyncMachines[u8Machine];
-
-                /* If current time equals to the sync send due */
-                if (prSync->u64TimerSyncSendDue <= u64CurrentTimeNs)
-                {
-                    if (true == prSync->bTimerSyncEnabled)
-                    {
-                        GPTP_SYNC_SyncMachine(prGptp, prDomain->u8DomainIndex, u8Machine, GPTP_DEF_CALL_INITIATE);
-                    }
-                    prSync->u64TimerSyncSendDue = u64CurrentTimeNs + GPTP_INTERNAL_Log2Ns(prSync->s8SyncIntervalLog);
-                }
-            }
-        }
-
-        /* For non GM domain (Bridge) */
-        else
-        {
-            GPTP_TIMER_SyncsSendNonGm(prGptp, prDomain, GPTP_DEF_CALL_INITIATE);
-        }
-    }
-
-    if (true == prGptp->rPerDeviceParams.bSignalingEnabled)
-    {
-        /* Update current time */
-        rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
-        u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
-
-        /* Regular period sync intervals check */
-        for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
-        {
-            prDomain = &prGptp->prPerDomainParams[u8Domain];
-
-            /* Check only for non GM domains */
-            if (false == prDomain->bDomainIsGm)
-            {
-                /* Sync interval check - once per second (signalling to the upstream) */
-                if (prDomain->u64TimerSyncCheckDue <= u64CurrentTimeNs)
-                {
-                    s8SyncIntervalMinimum = GPTP_DEF_LOG_SYNC_INT_MAX;
-                    bMorePorts = false;
-                    bSendSigMsg = false;
-
-                    /* Endpoint role - one port */
-                    if (1u == prDomain->u8NumberOfSyncsPerDom)
-                    {
-                        prSync = &prDomain->prSyncMachines[0u];
-                        /* If the operating sync interval is not equal to the current ingress sync interval */
-                        if (prSync->s8OperSyncIntervalLog != prSync->s8SyncIntervalLog)
-                        {
-                            s8SyncIntervalMinimum = prSync->s8OperSyncIntervalLog;
-                            bSendSigMsg = true;
-                        }
-                    }
-                    /* Bridge role - more master ports */
-                    else {
-                        /* Find the shortest sync interval */
-                        for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
-                        {
-                            prSync = &prDomain->prSyncMachines[u8Machine];
-                            /* Each enabled port but the slave port */
-                            if ((u8Machine != prDomain->u8SlaveMachineId) && (true == *(prSync->pbPortEnabled)))
-                            {
-                                bMorePorts = true;
-                                if (s8SyncIntervalMinimum > prSync->s8SyncIntervalLog)
-                                {
-                                    s8SyncIntervalMinimum = prSync->s8SyncIntervalLog;
-                                }
-                            }
-                        }
-
-                        /* If the found minimum is not equal to the current ingress sync interval */
-                        if ((s8SyncIntervalMinimum != prDomain->prSyncMachines[prGptp->prPerDomainParams[u8Domain].u8SlaveMachineId].s8SyncIntervalLog) && (true == bMorePorts))
-                        {
-                            bSendSigMsg = true;
-                        }
-                    }
-
-                    if (true == bSendSigMsg)
-                    {
-                        /* Send signaling message */
-                        GPTP_SIGNALING_SendSignaling(prGptp, u8Domain, s8SyncIntervalMinimum);
-                    }
-
-                    /* schedule the next due in 1.5s */
-                    prDomain->u64TimerSyncCheckDue = u64CurrentTimeNs + (uint64_t)GPTP_DEF_1S5_IN_NS;
-                }
-            }
-        }
-    }
+    uint32_t                            u32Type;
 
     /* Update current time */
     rCurrentTimeTs = GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING);
     u64CurrentTimeNs = GPTP_INTERNAL_TsToU64(rCurrentTimeTs);
 
-    /* Pdelay turnaround time check */
-    for (u8Port = 0u; u8Port < prGptp->rPerDeviceParams.u8NumberOfPdelayMachines; u8Port++)
-    {
-        prPdelay = &prGptp->prPdelayMachines[u8Port];
-
-        /* check for each pdelay initiator */
-        if (true == prPdelay->bPdelayInitiatorEnabled)
-        {
-            if (0u != prPdelay->u64TurnaroundMeasStartPtpNsInit)
-            {
-                /* If turnaround time is too long, register error */
-                if (GPTP_DEF_10_MS_IN_NS < (u64CurrentTimeNs - prPdelay->u64TurnaroundMeasStartPtpNsInit))
-                {
-                    GPTP_ERR_Register(prPdelay->u8GptpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_L_TOO_LONG_TURN_INIT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
-                    /* Don't measure next time */
-                    prPdelay->u64TurnaroundMeasStartPtpNsInit = 0u;
-                }
-            }
-        }
+    prWheel = &prGptp->rTimerWheel;
 
-        /* check for each pdelay responder */
-        if (true == prPdelay->bPdelayResponderEnabled)
-        {
-            if (0u != prPdelay->u64TurnaroundMeasStartPtpNsResp)
-            {
-                /* If turnaround time is too long, register error */
-                if (GPTP_DEF_10_MS_IN_NS < (u64CurrentTimeNs - prPdelay->u64TurnaroundMeasStartPtpNsResp))
-                {
-                    /* Report turnaround time error */
-                    GPTP_ERR_Register(prPdelay->u8GptpPort, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_L_TOO_LONG_TURN_RESP, GPTP_ERR_SEQ_ID_NOT_SPECIF);
-                    /* Don't measure next time */
-                    prPdelay->u64TurnaroundMeasStartPtpNsResp = 0u;
-                }
-            }
-        }
-    }
+    /* Collect expired timers only */
+    GPTP_TIMER_WheelAdvance(prWheel, u64CurrentTimeNs);
 
-    /* Sync residence time check for each non GM domain */
-    for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+    /* Handle expired timers in the order of the timer types: pdelay, sync, signaling, turnaround, residence, receipt timeout, status */
+    for (u32Type = 0u; u32Type < (uint32_t)GPTP_DEF_TIMER_TYPES_CNT; u32Type++)
     {
-        prDomain = &prGptp->prPerDomainParams[u8Domain];
-
-        /* Check only non GM domains */
-        if (false == prDomain->bDomainIsGm)
+        prTimer = prWheel->aprReady[u32Type];
+        while (NULL != prTimer)
         {
-            /* Check all the sync machines under the domain */
-            for (u8Machine = 0u; u8Machine < prDomain->u8NumberOfSyncsPerDom; u8Machine++)
-            {
-                prSync = &prDomain->prSyncMachines[u8Machine];
+            /* The handler may arm the entry again */
+            GPTP_TIMER_TimerUnlink(prTimer);
+            GPTP_TIMER_TimerExpired(prGptp, prTimer, u64CurrentTimeNs);
 
-                /* Check only for master sync machines */
-                if (GPTP_DEF_PTP_MASTER == prSync->bSyncRole)
-                {
-                    /* If residence time start value is not 0, the measurement is in progress (not sync forward finished */
-                    if (0u != prSync->u64ResidenceMeasStartPtpNs)
-                    {
-                        /* If residence time above 10ms, raise error */
-                        if (GPTP_DEF_10_MS_IN_NS < (u64CurrentTimeNs - prSync->u64ResidenceMeasStartPtpNs))
-                        {
-                            if (0u == prSync->u8SkippedSyncs)
-                            {
-                                GPTP_ERR_Register(u8Machine, u8Domain, GPTP_ERR_L_TOO_LONG_RESIDENCE, GPTP_ERR_SEQ_ID_NOT_SPECIF);
-                                /* While the residence time is already reported too long, no need to check again */
-                                prSync->u64ResidenceMeasStartPtpNs = 0u;
-                            }
-                        }
-                    }
-                }
-            }
+            prTimer = prWheel->aprReady[u32Type];
         }
     }
 
-    /* Sync receipt timeout check */
-    for (u8Domain = 0u; u8Domain < prGptp->rPerDeviceParams.u8NumberOfDomains; u8Domain++)
+    /* Holdover follows the fitted frequency drift */
+    if (true == GPTP_HOLD_ApplyDue(&prGptp->rPerDeviceParams.rHoldover, u64CurrentTimeNs))
     {
-        prDomain = &prGptp->prPerDomainParams[u8Domain];
-
-        /* Check non GM (Bridge) domains */
-        if (false == prDomain->bDomainIsGm)
+        if (GPTP_ERR_OK != GPTP_PORT_FixLocalClock(&prGptp->rPerDeviceParams.f64CorrClockRateRatio))
         {
-            if (0u != prDomain->u64TimerSyncReceiptTimeoutDue)
-            {
-                /* If sync receipt timeout due, report error */
-                if (prDomain->u64TimerSyncReceiptTimeoutDue <= u64CurrentTimeNs)
-                {
-                    GPTP_ERR_Register(prDomain->u8SlaveMachineId, u8Domain, GPTP_ERR_S_RECEIPT_TIMEOUT, GPTP_ERR_SEQ_ID_NOT_SPECIF);
-                    GPTP_INTERNAL_LosHandle(prGptp, prDomain, prDomain->u8SlaveMachineId, GPTP_ERR_SEQ_ID_NOT_SPECIF);
-                    prDomain->u64TimerSyncReceiptTimeoutDue = 0u;
-
-#ifdef GPTP_COUNTERS
-                    GPTP_INTERNAL_IncrementPortStats(prGptp, prDomain->u8SlaveMachineId, ieee8021AsPortStatRxSyncReceiptTimeouts);
-                    GPTP_INTERNAL_IncrementDomainStats(prGptp, u8Domain, prDomain->u8SlaveMachineId, ieee8021AsPortStatRxSyncReceiptTimeouts);
-#endif /* GPTP_COUNTERS */
-                }
-            }
+            GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_F_UPDATE_PTP, GPTP_ERR_SEQ_ID_NOT_SPECIF);
         }
     }
-
-    if (true == prGptp->bLocClkToUpdate)
+    if (true == GPTP_HOLD_SpecExceeded(&prGptp->rPerDeviceParams.rHoldover, u64CurrentTimeNs))
     {
-        /* Print synchronization status (Offset to GM) */
-        if (prGptp->u64SyncStatCalcDue <= u64CurrentTimeNs)
-        {
-            if (true == prGptp->rPerDeviceParams.bEverUpdated)
-            {
-                eErr = GPTP_PORT_GetSwitchTimes(&rFreeRunningClock, &rCorrectedClock);
-                if (GPTP_ERR_OK != eErr)
-                {
-                    rFreeRunningClock.u32TimeStampNs = 0u;
-                    rFreeRunningClock.u64TimeStampS = 0u;
-                    rCorrectedClock.u32TimeStampNs = 0u;
-                    rCorrectedClock.u64TimeStampS = 0u;
-                }
-
-                u64Elapsed = GPTP_INTERNAL_TsToU64(GPTP_INTERNAL_TsMinTs(rFreeRunningClock, prGptp->rPerDeviceParams.rLastFreeRunRef));
-
-                s32Compensation = (int32_t)(((int64_t)(((float64_t)u64Elapsed) * prGptp->rPerDeviceParams.f64CorrClockRateRatio)) - (int64_t)u64Elapsed);
-
-                rFreeRunningClockSig.s32TimeStampNs = (int32_t)rFreeRunningClock.u32TimeStampNs;
-                rFreeRunningClockSig.s64TimeStampS = (int64_t)rFreeRunningClock.u64TimeStampS;
-                rCorrectedClockSig.s32TimeStampNs = (int32_t)rCorrectedClock.u32TimeStampNs;
-                rCorrectedClockSig.s64TimeStampS = (int64_t)rCorrectedClock.u64TimeStampS;
-
-                if (rCorrectedClockSig.s32TimeStampNs >= s32Compensation)
-                {
-                    rCorrectedClockSig.s32TimeStampNs -= s32Compensation;
-                }
-                else
-                {
-                    rCorrectedClockSig.s32TimeStampNs -= s32Compensation;
-                    rCorrectedClockSig.s32TimeStampNs *= -1;
-                    rCorrectedClockSig.s32TimeStampNs = ((int32_t)GPTP_DEF_NS_IN_SECONDS) - rCorrectedClockSig.s32TimeStampNs;
-                    rCorrectedClockSig.s64TimeStampS -= 1;
-                }
-
-                rClockOffsetSig = GPTP_INTERNAL_TsMinTsSig(rFreeRunningClockSig, rCorrectedClockSig);
-                if (0 > rClockOffsetSig.s32TimeStampNs)
-                {
-                    rClockOffsetSig.s32TimeStampNs *= -1;
-                    rClockOffsetSig.s64TimeStampS *= -1;
-                }
-
-                prGptp->rPerDeviceParams.rEstimGmOffset = GPTP_INTERNAL_TsMinTsSig(rClockOffsetSig, prGptp->rPerDeviceParams.rReportedOffset);
-                prGptp->rPerDeviceParams.bEstimGmOffsetCalculated = true;
-
-                GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_SYNC, ("gptp: Estimated offset to GM:"));
-                GPTP_PRINTF_TIME_SIG(GPTP_DEBUG_MSGTYPE_SYNC, prGptp->rPerDeviceParams.rEstimGmOffset);
-            }
-
-            else
-            {
-                GPTP_PRINTF(GPTP_DEBUG_MSGTYPE_SYNC, ("gptp: Local clock not updated yet \n"));
-            }
-
-            /* Report Synchronization status periodically with given period */
-            prGptp->u64SyncStatCalcDue = u64CurrentTimeNs + GPTP_DEF_CALC_PERIOD_100_MS;
-        }
+        GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF, GPTP_ERR_DOMAIN_NOT_SPECIF, GPTP_ERR_S_HOLDOVER_OUT_OF_SPEC, GPTP_ERR_SEQ_ID_NOT_SPECIF);
     }
 
     /* Call platfofm specific part of the Periodic functionality */
@@ -0,0 +1,568 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+#include "gptp_def.h"
+#include "gptp_err.h"
+#include "gptp_internal.h"
+#include "gptp_port.h"
+#include "gptp.h"
+#include "gptp_trace.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Offsets within the common record header */
+#define TRACE_OFS_TYPE                  0u
+#define TRACE_OFS_PORT                  1u
+#define TRACE_OFS_EXT_LEN               2u
+#define TRACE_OFS_FREE_RUN              4u
+#define TRACE_OFS_TS_SEC                12u
+#define TRACE_OFS_TS_NSEC               16u
+/* Offsets within the stream header */
+#define TRACE_OFS_MAGIC                 0u
+#define TRACE_OFS_VERSION               4u
+#define TRACE_OFS_REC_LEN               6u
+/* Offsets within the received frame extension */
+#define TRACE_OFS_ETH_TYPE              0u
+#define TRACE_OFS_SRC_MAC               2u
+/* Offsets within the egress timestamp extension */
+#define TRACE_OFS_TX_BUFF               0u
+#define TRACE_OFS_TX_MSG_TYPE           4u
+#define TRACE_OFS_TX_DOMAIN             5u
+#define TRACE_OFS_TX_SEQ_ID             6u
+/* Length of the MAC address */
+#define TRACE_MAC_LEN                   6u
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint64_t GPTP_TRACE_Get(const uint8_t *cpu8Src,
+                               uint8_t u8Bytes);
+static const gptp_def_tx_data_t *GPTP_TRACE_TxData(const gptp_def_data_t *cprGptp,
+                                                   uint8_t u8Port,
+                                                   uint16_t u16Item,
+                                                   uint8_t *pu8DomainNumber);
+#ifdef GPTP_TRACE_CAPTURE
+static void GPTP_TRACE_Put(uint8_t *pu8Dst,
+                           uint64_t u64Value,
+                           uint8_t u8Bytes);
+static bool GPTP_TRACE_Traced(const gptp_def_data_t *cprGptp);
+static uint16_t GPTP_TRACE_RecHeader(gptp_def_trace_rec_type_t eType,
+                                     uint8_t u8Port,
+                                     uint16_t u16ExtLength,
+                                     uint32_t u32TsSec,
+                                     uint32_t u32TsNsec);
+static void GPTP_TRACE_TxIdentify(const gptp_def_data_t *cprGptp,
+                                  uint8_t u8Port,
+                                  uint32_t u32BufferIndex,
+                                  gptp_def_trace_rec_t *prRec);
+#endif /* GPTP_TRACE_CAPTURE */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#ifdef GPTP_TRACE_CAPTURE
+/* Trace stream writer, NULL when the capture is stopped */
+static gptp_trace_write_callback_t  spfTraceWrite;
+/* Traced stack instance, NULL for the default instance */
+static const gptp_def_data_t        *scprTraceGptp;
+/* Record being built, the largest is the received frame */
+static uint8_t                      sau8TraceRec[GPTP_DEF_TRACE_REC_LEN + GPTP_DEF_TRACE_RX_LEN + GPTP_DEF_TRACE_PAYLOAD_MAX];
+#endif /* GPTP_TRACE_CAPTURE */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/*!
+ * @brief The function reads the value stored in the little endian byte order.
+ *
+ * @param[in] cpu8Src Pointer to the source.
+ * @param[in] u8Bytes Count of the read bytes.
+ * @return Read value.
+ */
+static uint64_t GPTP_TRACE_Get(const uint8_t *cpu8Src,
+                               uint8_t u8Bytes)
+{
+    uint64_t u64Value;
+    uint8_t  u8Byte;
+
+    u64Value = 0u;
+    for (u8Byte = 0u; u8Byte < u8Bytes; u8Byte++)
+    {
+        u64Value |= ((uint64_t)cpu8Src[u8Byte]) << (8u * u8Byte);
+    }
+
+    return u64Value;
+}
+
+/*!
+ * @brief The function returns the TX data of a frame with the egress timestamp.
+ *
+ * @details The TX data of the gPTP port are numbered in the order of the Pdelay
+ *          request, the Pdelay response and the Sync machines of the port
+ *          by domains.
+ *
+ * @param[in] cprGptp Pointer to the stack instance.
+ * @param[in] u8Port gPTP port.
+ * @param[in] u16Item Number of the TX data.
+ * @param[out] pu8DomainNumber Domain number of the Sync machine, 0 for the Pdelay machine.
+ * @return Pointer to the TX data, NULL after the last one.
+ */
+static const gptp_def_tx_data_t *GPTP_TRACE_TxData(const gptp_def_data_t *cprGptp,
+                                                   uint8_t u8Port,
+                                                   uint16_t u16Item,
+                                                   uint8_t *pu8DomainNumber)
+{
+    const gptp_def_tx_data_t *cprTxData;
+    const gptp_def_domain_t  *cprDomain;
+    uint16_t                 u16Sync;
+    uint8_t                  u8Domain;
+    uint8_t                  u8Machine;
+
+    cprTxData = NULL;
+    *pu8DomainNumber = 0u;
+
+    if ((true == cprGptp->bGptpInitialized) && (u8Port < cprGptp->rPerDeviceParams.u8PortsCount))
+    {
+        if (0u == u16Item)
+        {
+            cprTxData = &cprGptp->prPdelayMachines[u8Port].rTxDataReq;
+        }
+        else if (1u == u16Item)
+        {
+            cprTxData = &cprGptp->prPdelayMachines[u8Port].rTxDataResp;
+        }
+        else
+        {
+            u16Sync = 2u;
+            for (u8Domain = 0u; (NULL == cprTxData) && (u8Domain < cprGptp->rPerDeviceParams.u8NumberOfDomains); u8Domain++)
+            {
+                cprDomain = &cprGptp->prPerDomainParams[u8Domain];
+                for (u8Machine = 0u; (NULL == cprTxData) && (u8Machine < cprDomain->u8NumberOfSyncsPerDom); u8Machine++)
+                {
+                    if (cprDomain->prSyncMachines[u8Machine].u8GptpPort == u8Port)
+                    {
+                        if (u16Sync == u16Item)
+                        {
+                            cprTxData = &cprDomain->prSyncMachines[u8Machine].rTxDataSyn;
+                            *pu8DomainNumber = cprDomain->u8DomainNumber;
+                        }
+                        u16Sync++;
+                    }
+                }
+            }
+        }
+    }
+
+    return cprTxData;
+}
+
+/*!
+ * @brief   This function returns the buffer index of the frame transmitted by the instance.
+ *
+ * @param[in] cprGptp Pointer to the stack instance.
+ * @param[in] cprRec Pointer to the egress timestamp record.
+ * @return Buffer index of the latest frame of the record port, message type,
+ *         domain number and sequence ID, GPTP_DEF_BUFF_INDEX_CLOSED if there is none.
+ */
+uint32_t GPTP_TRACE_TxBufferIndex(const gptp_def_data_t *cprGptp,
+                                  const gptp_def_trace_rec_t *cprRec)
+{
+    const gptp_def_tx_data_t *cprTxData;
+    uint32_t                 u32BufferIndex;
+    uint16_t                 u16Item;
+    uint8_t                  u8DomainNumber;
+
+    u32BufferIndex = GPTP_DEF_BUFF_INDEX_CLOSED;
+
+    if ((NULL != cprGptp) && (NULL != cprRec) && (GPTP_DEF_MSG_TYPE_UNKNOWN != cprRec->eMsgType))
+    {
+        u16Item = 0u;
+        cprTxData = GPTP_TRACE_TxData(cprGptp, cprRec->u8PtpPort, u16Item, &u8DomainNumber);
+        while ((NULL != cprTxData) && (GPTP_DEF_BUFF_INDEX_CLOSED == u32BufferIndex))
+        {
+            if ((cprTxData->eMsgId == cprRec->eMsgType) && (cprTxData->u16SequenceId == cprRec->u16SequenceId) &&
+                (u8DomainNumber == cprRec->u8DomainNumber) && (NULL != cprTxData->prFrameMap))
+            {
+                u32BufferIndex = cprTxData->prFrameMap->u32BufferIndex;
+            }
+            u16Item++;
+            cprTxData = GPTP_TRACE_TxData(cprGptp, cprRec->u8PtpPort, u16Item, &u8DomainNumber);
+        }
+    }
+
+    return u32BufferIndex;
+}
+
+#ifdef GPTP_TRACE_CAPTURE
+/*!
+ * @brief The function stores the value in the little endian byte order.
+ *
+ * @param[out] pu8Dst Pointer to the destination.
+ * @param[in] u64Value Value to be stored.
+ * @param[in] u8Bytes Count of the stored bytes.
+ */
+static void GPTP_TRACE_Put(uint8_t *pu8Dst,
+                           uint64_t u64Value,
+                           uint8_t u8Bytes)
+{
+    uint8_t u8Byte;
+
+    for (u8Byte = 0u; u8Byte < u8Bytes; u8Byte++)
+    {
+        pu8Dst[u8Byte] = (uint8_t)(u64Value >> (8u * u8Byte));
+    }
+}
+
+/*!
+ * @brief The function checks whether the events of the instance are recorded.
+ *
+ * @param[in] cprGptp Pointer to the stack instance.
+ * @return true if the capture runs and the instance is the traced one.
+ */
+static bool GPTP_TRACE_Traced(const gptp_def_data_t *cprGptp)
+{
+    return (NULL != spfTraceWrite) &&
+           ((cprGptp == scprTraceGptp) || ((NULL == scprTraceGptp) && (cprGptp == GPTP_GetMainStrPtr())));
+}
+
+/*!
+ * @brief The function builds the common record header.
+ *
+ * @param[in] eType Record type.
+ * @param[in] u8Port gPTP port of the record.
+ * @param[in] u16ExtLength Length of the record following the common header.
+ * @param[in] u32TsSec Timestamp - seconds.
+ * @param[in] u32TsNsec Timestamp - nano seconds.
+ * @return Length of the whole record.
+ */
+static uint16_t GPTP_TRACE_RecHeader(gptp_def_trace_rec_type_t eType,
+                                     uint8_t u8Port,
+                                     uint16_t u16ExtLength,
+                                     uint32_t u32TsSec,
+                                     uint32_t u32TsNsec)
+{
+    sau8TraceRec[TRACE_OFS_TYPE] = (uint8_t)eType;
+    sau8TraceRec[TRACE_OFS_PORT] = u8Port;
+    GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_EXT_LEN], u16ExtLength, 2u);
+    GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_FREE_RUN],
+                   GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING)), 8u);
+    GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_TS_SEC], u32TsSec, 4u);
+    GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_TS_NSEC], u32TsNsec, 4u);
+
+    return (uint16_t)(GPTP_DEF_TRACE_REC_LEN + u16ExtLength);
+}
+
+/*!
+ * @brief The function identifies the frame of the egress timestamp.
+ *
+ * @param[in] cprGptp Pointer to the transmitting stack instance.
+ * @param[in] u8Port gPTP port transmitted the frame.
+ * @param[in] u32BufferIndex Index of the frame buffer.
+ * @param[out] prRec Pointer to the record, message type, domain number and
+ *             sequence ID are filled, GPTP_DEF_MSG_TYPE_UNKNOWN if not identified.
+ */
+static void GPTP_TRACE_TxIdentify(const gptp_def_data_t *cprGptp,
+                                  uint8_t u8Port,
+                                  uint32_t u32BufferIndex,
+                                  gptp_def_trace_rec_t *prRec)
+{
+    const gptp_def_tx_data_t *cprTxData;
+    uint16_t                 u16Item;
+    uint8_t                  u8DomainNumber;
+
+    prRec->eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
+    prRec->u8DomainNumber = 0u;
+    prRec->u16SequenceId = 0u;
+
+    u16Item = 0u;
+    cprTxData = GPTP_TRACE_TxData(cprGptp, u8Port, u16Item, &u8DomainNumber);
+    while ((NULL != cprTxData) && (GPTP_DEF_MSG_TYPE_UNKNOWN == prRec->eMsgType))
+    {
+        if ((NULL != cprTxData->prFrameMap) && (cprTxData->prFrameMap->u32BufferIndex == u32BufferIndex))
+        {
+            prRec->eMsgType = cprTxData->eMsgId;
+            prRec->u8DomainNumber = u8DomainNumber;
+            prRec->u16SequenceId = cprTxData->u16SequenceId;
+        }
+        u16Item++;
+        cprTxData = GPTP_TRACE_TxData(cprGptp, u8Port, u16Item, &u8DomainNumber);
+    }
+}
+
+/*!
+ * @brief   This function starts the trace capture.
+ *
+ * @param[in] cprGptp Pointer to the traced stack instance, NULL for the default instance.
+ * @param[in] pfWrite Callback writing the trace stream, NULL stops the capture.
+ */
+void GPTP_TRACE_Start(const gptp_def_data_t *cprGptp,
+                      gptp_trace_write_callback_t pfWrite)
+{
+    uint16_t u16Length;
+
+    scprTraceGptp = cprGptp;
+    spfTraceWrite = pfWrite;
+
+    if (NULL != spfTraceWrite)
+    {
+        GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_MAGIC], GPTP_DEF_TRACE_MAGIC, 4u);
+        GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_VERSION], GPTP_DEF_TRACE_VERSION, 2u);
+        GPTP_TRACE_Put(&sau8TraceRec[TRACE_OFS_REC_LEN], GPTP_DEF_TRACE_REC_LEN, 2u);
+        spfTraceWrite(sau8TraceRec, (uint16_t)GPTP_DEF_TRACE_HDR_LEN);
+
+        u16Length = GPTP_TRACE_RecHeader(GPTP_DEF_TRACE_REC_START, 0u, 0u, 0u, 0u);
+        spfTraceWrite(sau8TraceRec, u16Length);
+    }
+}
+
+/*!
+ * @brief   This function stops the trace capture.
+ */
+void GPTP_TRACE_Stop(void)
+{
+    spfTraceWrite = NULL;
+}
+
+/*!
+ * @brief   This function records the received gPTP frame.
+ *
+ * @param[in] cprGptp Pointer to the receiving stack instance.
+ * @param[in] cprRxData Pointer to the received data as passed to the stack.
+ * @param[in] u16Length Length of the received gPTP data.
+ */
+void GPTP_TRACE_Rx(const gptp_def_data_t *cprGptp,
+                   const gptp_def_rx_data_t *cprRxData,
+                   uint16_t u16Length)
+{
+    uint8_t  *pu8Ext;
+    uint16_t u16RecLength;
+    uint16_t u16Byte;
+
+    if (true == GPTP_TRACE_Traced(cprGptp))
+    {
+        if (u16Length > GPTP_DEF_TRACE_PAYLOAD_MAX)
+        {
+            u16Length = (uint16_t)GPTP_DEF_TRACE_PAYLOAD_MAX;
+        }
+
+        u16RecLength = GPTP_TRACE_RecHeader(GPTP_DEF_TRACE_REC_RX, cprRxData->u8PtpPort,
+                                            (uint16_t)(GPTP_DEF_TRACE_RX_LEN + u16Length),
+                                            cprRxData->u32TsSec, cprRxData->u32TsNsec);
+
+        pu8Ext = &sau8TraceRec[GPTP_DEF_TRACE_REC_LEN];
+        GPTP_TRACE_Put(&pu8Ext[TRACE_OFS_ETH_TYPE], cprRxData->u16EthType, 2u);
+        for (u16Byte = 0u; u16Byte < TRACE_MAC_LEN; u16Byte++)
+        {
+            /* Network byte order, as in the frame. */
+            pu8Ext[TRACE_OFS_SRC_MAC + u16Byte] = (uint8_t)(cprRxData->u64SourceMac >> (8u * (TRACE_MAC_LEN - 1u - u16Byte)));
+        }
+        for (u16Byte = 0u; u16Byte < u16Length; u16Byte++)
+        {
+            pu8Ext[GPTP_DEF_TRACE_RX_LEN + u16Byte] = cprRxData->cpu8RxData[u16Byte];
+        }
+
+        spfTraceWrite(sau8TraceRec, u16RecLength);
+    }
+}
+
+/*!
+ * @brief   This function records the egress timestamp.
+ *
+ * @param[in] cprGptp Pointer to the transmitting stack instance.
+ * @param[in] u8Port gPTP port transmitted the frame.
+ * @param[in] u32BufferIndex Index of the frame buffer.
+ * @param[in] u32TsSeconds Egress time stamp - seconds.
+ * @param[in] u32TsNanoseconds Egress time stamp - nano seconds.
+ */
+void GPTP_TRACE_Tx(const gptp_def_data_t *cprGptp,
+                   uint8_t u8Port,
+                   uint32_t u32BufferIndex,
+                   uint32_t u32TsSeconds,
+                   uint32_t u32TsNanoseconds)
+{
+    gptp_def_trace_rec_t rRec;
+    uint8_t              *pu8Ext;
+    uint16_t             u16RecLength;
+
+    if (true == GPTP_TRACE_Traced(cprGptp))
+    {
+        GPTP_TRACE_TxIdentify(cprGptp, u8Port, u32BufferIndex, &rRec);
+
+        u16RecLength = GPTP_TRACE_RecHeader(GPTP_DEF_TRACE_REC_TX, u8Port, (uint16_t)GPTP_DEF_TRACE_TX_LEN,
+                                            u32TsSeconds, u32TsNanoseconds);
+        pu8Ext = &sau8TraceRec[GPTP_DEF_TRACE_REC_LEN];
+        GPTP_TRACE_Put(&pu8Ext[TRACE_OFS_TX_BUFF], u32BufferIndex, 4u);
+        pu8Ext[TRACE_OFS_TX_MSG_TYPE] = (uint8_t)rRec.eMsgType;
+        pu8Ext[TRACE_OFS_TX_DOMAIN] = rRec.u8DomainNumber;
+        GPTP_TRACE_Put(&pu8Ext[TRACE_OFS_TX_SEQ_ID], rRec.u16SequenceId, 2u);
+
+        spfTraceWrite(sau8TraceRec, u16RecLength);
+    }
+}
+
+/*!
+ * @brief   This function records the call of the periodic function.
+ *
+ * @param[in] cprGptp Pointer to the stack instance.
+ */
+void GPTP_TRACE_Tick(const gptp_def_data_t *cprGptp)
+{
+    uint16_t u16RecLength;
+
+    if (true == GPTP_TRACE_Traced(cprGptp))
+    {
+        u16RecLength = GPTP_TRACE_RecHeader(GPTP_DEF_TRACE_REC_TICK, 0u, 0u, 0u, 0u);
+
+        spfTraceWrite(sau8TraceRec, u16RecLength);
+    }
+}
+#endif /* GPTP_TRACE_CAPTURE */
+
+/*!
+ * @brief   This function checks the trace stream header.
+ *
+ * @param[in] cpu8Trace Pointer to the trace stream.
+ * @param[in] u32Length Length of the trace stream.
+ * @return Error status.
+ */
+gptp_err_type_t GPTP_TRACE_HeaderCheck(const uint8_t *cpu8Trace,
+                                       uint32_t u32Length)
+{
+    gptp_err_type_t eError;
+
+    if (NULL == cpu8Trace)
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else if ((u32Length < GPTP_DEF_TRACE_HDR_LEN) ||
+             (GPTP_DEF_TRACE_MAGIC != GPTP_TRACE_Get(&cpu8Trace[TRACE_OFS_MAGIC], 4u)) ||
+             (GPTP_DEF_TRACE_VERSION != GPTP_TRACE_Get(&cpu8Trace[TRACE_OFS_VERSION], 2u)) ||
+             (GPTP_DEF_TRACE_REC_LEN != GPTP_TRACE_Get(&cpu8Trace[TRACE_OFS_REC_LEN], 2u)))
+    {
+        eError = GPTP_ERR_M_MESSAGE_ID_INVALID;
+    }
+    else
+    {
+        eError = GPTP_ERR_OK;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief   This function decodes the next trace record.
+ *
+ * @param[in] cpu8Trace Pointer to the trace stream.
+ * @param[in] u32Length Length of the trace stream.
+ * @param[in,out] pu32Offset Offset of the record, moved to the next record.
+ * @param[out] prRec Pointer to the decoded record.
+ * @return Error status.
+ */
+gptp_err_type_t GPTP_TRACE_Decode(const uint8_t *cpu8Trace,
+                                  uint32_t u32Length,
+                                  uint32_t *pu32Offset,
+                                  gptp_def_trace_rec_t *prRec)
+{
+    gptp_err_type_t eError;
+    const uint8_t   *cpu8Rec;
+    const uint8_t   *cpu8Ext;
+    uint32_t        u32ExtLength;
+    uint8_t         u8Byte;
+    bool            bDecoded;
+
+    eError = GPTP_ERR_M_MESSAGE_ID_INVALID;
+    bDecoded = false;
+
+    if ((NULL == cpu8Trace) || (NULL == pu32Offset) || (NULL == prRec))
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+        bDecoded = true;
+    }
+
+    while ((false == bDecoded) && (*pu32Offset < u32Length) &&
+           ((u32Length - *pu32Offset) >= GPTP_DEF_TRACE_REC_LEN))
+    {
+        cpu8Rec = &cpu8Trace[*pu32Offset];
+        cpu8Ext = &cpu8Rec[GPTP_DEF_TRACE_REC_LEN];
+        u32ExtLength = (uint32_t)GPTP_TRACE_Get(&cpu8Rec[TRACE_OFS_EXT_LEN], 2u);
+
+        if ((u32Length - *pu32Offset - GPTP_DEF_TRACE_REC_LEN) < u32ExtLength)
+        {
+            /* Truncated record. */
+            break;
+        }
+        *pu32Offset += GPTP_DEF_TRACE_REC_LEN + u32ExtLength;
+
+        prRec->eType = (gptp_def_trace_rec_type_t)cpu8Rec[TRACE_OFS_TYPE];
+        prRec->u8PtpPort = cpu8Rec[TRACE_OFS_PORT];
+        prRec->u64FreeRunNs = GPTP_TRACE_Get(&cpu8Rec[TRACE_OFS_FREE_RUN], 8u);
+        prRec->u32TsSec = (uint32_t)GPTP_TRACE_Get(&cpu8Rec[TRACE_OFS_TS_SEC], 4u);
+        prRec->u32TsNsec = (uint32_t)GPTP_TRACE_Get(&cpu8Rec[TRACE_OFS_TS_NSEC], 4u);
+        prRec->u32BufferIndex = GPTP_DEF_BUFF_INDEX_CLOSED;
+        prRec->eMsgType = GPTP_DEF_MSG_TYPE_UNKNOWN;
+        prRec->u8DomainNumber = 0u;
+        prRec->u16SequenceId = 0u;
+        prRec->u16EthType = 0u;
+        prRec->u64SourceMac = 0u;
+        prRec->u16Length = 0u;
+        prRec->cpu8Data = NULL;
+
+        switch (prRec->eType)
+        {
+            case GPTP_DEF_TRACE_REC_START:
+            case GPTP_DEF_TRACE_REC_TICK:
+                bDecoded = true;
+                break;
+
+            case GPTP_DEF_TRACE_REC_RX:
+                if (u32ExtLength >= GPTP_DEF_TRACE_RX_LEN)
+                {
+                    prRec->u16EthType = (uint16_t)GPTP_TRACE_Get(&cpu8Ext[TRACE_OFS_ETH_TYPE], 2u);
+                    for (u8Byte = 0u; u8Byte < TRACE_MAC_LEN; u8Byte++)
+                    {
+                        prRec->u64SourceMac = (prRec->u64SourceMac << 8u) | (uint64_t)cpu8Ext[TRACE_OFS_SRC_MAC + u8Byte];
+                    }
+                    prRec->u16Length = (uint16_t)(u32ExtLength - GPTP_DEF_TRACE_RX_LEN);
+                    prRec->cpu8Data = &cpu8Ext[GPTP_DEF_TRACE_RX_LEN];
+                    bDecoded = true;
+                }
+                break;
+
+            case GPTP_DEF_TRACE_REC_TX:
+                if (u32ExtLength >= GPTP_DEF_TRACE_TX_LEN)
+                {
+                    prRec->u32BufferIndex = (uint32_t)GPTP_TRACE_Get(&cpu8Ext[TRACE_OFS_TX_BUFF], 4u);
+                    prRec->eMsgType = (gptp_def_msg_type_t)cpu8Ext[TRACE_OFS_TX_MSG_TYPE];
+                    prRec->u8DomainNumber = cpu8Ext[TRACE_OFS_TX_DOMAIN];
+                    prRec->u16SequenceId = (uint16_t)GPTP_TRACE_Get(&cpu8Ext[TRACE_OFS_TX_SEQ_ID], 2u);
+                    bDecoded = true;
+                }
+                break;
+
+            default:
+                /* Unknown record type - skipped. */
+                break;
+        }
+
+        if (true == bDecoded)
+        {
+            eError = GPTP_ERR_OK;
+        }
+    }
+
+    return eError;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
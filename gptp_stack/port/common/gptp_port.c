@@ -13,6 +13,12 @@
  /**
  * @file gptp_port.c
  *
+ * @details Hardware independent part of the port layer, shared by
+ *          the platforms. The hardware is accessed by the primitives of
+ *          gptp_port_hw.h, implemented by the gptp_port_platform.c of
+ *          the platform together with the frame transmission. Kept out of
+ *          the platform directories, so gptp_port_platform.h is resolved
+ *          by the include path of the build.
  */
 
 /*******************************************************************************
@@ -27,103 +33,28 @@
 #include "gptp_frame.h"
 #include "gptp_pi.h"
 #include "gptp_internal.h"
-#include "Eth_43_GMAC.h"
-#include "EthTrcv.h"
+#include "gptp_fxp.h"
+#include "gptp_hold.h"
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 
-/*! Index of ethernet controller which manage clock timer frequency. */
-#define GPTP_PORT_ETH_CTRL_IDX          (0u)
 /*! Decimal weight coefficient used for calculation of PPB adjustment average (0.1 = 10%). */
 #define GPTP_PORT_NEW_PPB_WEIGHT        (0.1)
+#ifdef GPTP_FIXED_POINT
+/*! Weight of the PPB average (1.0 - GPTP_PORT_NEW_PPB_WEIGHT) in Q16. */
+#define GPTP_PORT_OLD_PPB_WEIGHT_Q16    (58982u)
+#endif /* GPTP_FIXED_POINT */
 /*! Ethernet header offset. */
 #define GPTP_PORT_ETH_II_OFST           (0u)
 /*! Float number comparison precision. */
 #define GPTP_PORT_EPSILON               (0.00000001)
 
-/*******************************************************************************
- * Data types
- ******************************************************************************/
-
-/*!
- * @brief PTP time base information.
- */
-typedef struct
-{
-    /* Time base is incremented evertime the PTP CLK slave changes its phase
-       or frequency. */
-    uint16_t u16TimeBaseIndicator;
-    /* Change of phase during the last time base indicator increment (i.e.,
-       current time offset between local (corrected) clock
-       and the Grand Master). */
-    gptp_def_timestamp_sig_t rLastPhaseChange;
-    /* The last phase change had positive/negative offset. */
-    bool bNegativePhase;
-    /* Fractional frequency change (i.e., frequency change expressed as a pure
-       fraction) during the last time base indicator increment. */
-    float64_t f64LastFreqChange;
-} gptp_port_ptp_tb_info_t;
-
-/*******************************************************************************
- * Prototypes
- ******************************************************************************/
-
-static Eth_RateRatioType GPTP_PORT_PPBToPseudoRatio(int32_t i32PPB);
-
-/*******************************************************************************
- * Variables
- ******************************************************************************/
-
-static gptp_def_map_info_t     srPortMap;
-static int32_t                 si32PPBadjustmentAverage;
-static gptp_port_ptp_tb_info_t srTimeBaseInfo;
-
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
-/*!
- * @brief           This function converts PPB to pseudo ratio
-*                  (frequency ratio).
- *
- * @details         This function converts PPB to pseudo ratio which is used for
- *                  clock timer frequency adjustment by ETH driver.
- *
- * @param[in]       i32PPB Parts per billion.
- *
- * @return          Eth_RateRatioType as a pseudo ratio.
- *
- * @ requirements 529199
- * @ requirements 539908
-*/
-static Eth_RateRatioType GPTP_PORT_PPBToPseudoRatio(int32_t i32PPB)
-{
-    Eth_RateRatioType rPseudoRatio;
-
-    rPseudoRatio.IngressTimeStampDelta.diff.seconds = 1u;
-    rPseudoRatio.IngressTimeStampDelta.diff.secondsHi = 0u;
-    rPseudoRatio.IngressTimeStampDelta.sign = true;
-
-    rPseudoRatio.OriginTimeStampDelta.diff.seconds = 1u;
-    rPseudoRatio.OriginTimeStampDelta.diff.secondsHi = 0u;
-    rPseudoRatio.OriginTimeStampDelta.sign = true;
-
-    if (0 < i32PPB)
-    {
-        rPseudoRatio.IngressTimeStampDelta.diff.nanoseconds = (uint32_t)i32PPB;
-        rPseudoRatio.OriginTimeStampDelta.diff.nanoseconds = 0u;
-    }
-    else
-    {
-        rPseudoRatio.OriginTimeStampDelta.diff.nanoseconds = (uint32_t)(GPTP_INTERNAL_AbsInt64ToUint64((int64_t)i32PPB));
-        rPseudoRatio.IngressTimeStampDelta.diff.nanoseconds = 0u;
-    }
-
-    return rPseudoRatio;
-}
-
 /*!
  * @brief           This function finds gPTP port number in the port map.
  *
@@ -148,23 +79,20 @@ gptp_err_type_t GPTP_PORT_PortLookup(uint8_t *pu8GptpPort,
 {
     (void)u8Sw;
 
+    gptp_port_ctx_t *prCtx;
     gptp_err_type_t eError;
-    uint8_t         u8PortLookUp;
 
+    prCtx = GPTP_PORT_CtxGet();
     eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
 
     if (NULL != pu8GptpPort)
     {
-        for (u8PortLookUp = 0u; u8PortLookUp < srPortMap.u8NumOfGptpPorts; u8PortLookUp++)
+        if ((u8PortOnSw < GPTP_PORT_CTRL_MAX) &&
+            (GPTP_DEF_LOOKUP_NONE != prCtx->au8GptpPortLookup[u8PortOnSw]))
         {
-            if (srPortMap.prMapTable[u8PortLookUp].u8SwitchPort == u8PortOnSw)
-            {
-                /* Store found port. */
-                *pu8GptpPort = u8PortLookUp;
-                eError = GPTP_ERR_OK;
-                /* Port has been found, stop the search loop. */
-                break;
-            }
+            /* Store found port. */
+            *pu8GptpPort = prCtx->au8GptpPortLookup[u8PortOnSw];
+            eError = GPTP_ERR_OK;
         }
     }
     else
@@ -175,28 +103,6 @@ gptp_err_type_t GPTP_PORT_PortLookup(uint8_t *pu8GptpPort,
     return eError;
 }
 
-/*!
- * @brief           This function registers multicast MAC.
- *
- * @details         This function provides interface to register MAC in
- *                  the Ethernet module so the multicast MAC is forwarded.
- *
- * @param[in]       cpu8MacAddr Pointer to multicast MAC address.
- *
- * @ requirements 529199
- * @ requirements 529251
-*/
-void GPTP_PORT_MulticastForward(const uint8_t *cpu8MacAddr)
-{
-    uint8_t u8CtrlIdx;
-
-    for (u8CtrlIdx = 0u; u8CtrlIdx < ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED; u8CtrlIdx++)
-    {
-        (void)Eth_43_GMAC_UpdatePhysAddrFilter(u8CtrlIdx, cpu8MacAddr,
-                                               ETH_ADD_TO_FILTER);
-    }
-}
-
 /*!
  * @brief           This function initializes port module.
  *
@@ -212,8 +118,32 @@ void GPTP_PORT_MulticastForward(const uint8_t *cpu8MacAddr)
 void GPTP_PORT_PortMapInit(const gptp_def_map_table_t *cprPortTable,
                            uint8_t u8NumOfPorts)
 {
-    srPortMap.u8NumOfGptpPorts = u8NumOfPorts;
-    srPortMap.prMapTable = cprPortTable;
+    gptp_port_ctx_t *prCtx;
+    uint8_t         u8CtrlIdx;
+    uint8_t         u8Port;
+
+    /* The port layer serves the instance being initialized. */
+    prCtx = GPTP_PORT_CtxGet();
+    prCtx->prGptp = GPTP_GetMainStrPtr();
+    prCtx->rPortMap.u8NumOfGptpPorts = u8NumOfPorts;
+    prCtx->rPortMap.prMapTable = cprPortTable;
+
+    /* Build the reverse lookup, the first gPTP port mapped to the controller
+       is used. */
+    for (u8CtrlIdx = 0u; u8CtrlIdx < GPTP_PORT_CTRL_MAX; u8CtrlIdx++)
+    {
+        prCtx->au8GptpPortLookup[u8CtrlIdx] = GPTP_DEF_LOOKUP_NONE;
+    }
+
+    for (u8Port = 0u; u8Port < u8NumOfPorts; u8Port++)
+    {
+        u8CtrlIdx = cprPortTable[u8Port].u8SwitchPort;
+        if ((u8CtrlIdx < GPTP_PORT_CTRL_MAX) &&
+            (GPTP_DEF_LOOKUP_NONE == prCtx->au8GptpPortLookup[u8CtrlIdx]))
+        {
+            prCtx->au8GptpPortLookup[u8CtrlIdx] = u8Port;
+        }
+    }
 }
 
 /*!
@@ -243,16 +173,19 @@ void GPTP_PORT_TimeBaseInfoGet(uint16_t *pu16GmTimeBaseIndicator,
                                uint64_t *pu64LastGmPhaseChangeL,
                                uint32_t *pu32ScaledLastGmFreqChange)
 {
-    uint64_t  u64Seconds;
-    uint64_t  au64Input[6];
-    uint64_t  au64Output[6];
-    float64_t f64Temp;
+    gptp_port_ctx_t *prCtx;
+    uint64_t        u64Seconds;
+    uint64_t        au64Input[6];
+    uint64_t        au64Output[6];
+    float64_t       f64Temp;
+
+    prCtx = GPTP_PORT_CtxGet();
 
     /* GM time base indicator. */
-    *pu16GmTimeBaseIndicator = srTimeBaseInfo.u16TimeBaseIndicator;
+    *pu16GmTimeBaseIndicator = prCtx->rTimeBaseInfo.u16TimeBaseIndicator;
 
     /* Last GM phase change high and low. */
-    u64Seconds = GPTP_INTERNAL_AbsInt64ToUint64(GPTP_INTERNAL_TsToS64(srTimeBaseInfo.rLastPhaseChange));
+    u64Seconds = GPTP_INTERNAL_AbsInt64ToUint64(GPTP_INTERNAL_TsToS64(prCtx->rTimeBaseInfo.rLastPhaseChange));
     for (uint16_t u16Cycle = 0u; u16Cycle < 6u; u16Cycle++)
     {
         /* Get lower 16 bits from seconds. */
@@ -264,7 +197,7 @@ void GPTP_PORT_TimeBaseInfoGet(uint16_t *pu16GmTimeBaseIndicator,
         if (0u == u16Cycle)
         {
             /* Add value form the time timestamp. */
-            au64Input[u16Cycle] = au64Input[u16Cycle] + GPTP_INTERNAL_AbsInt64ToUint64((int64_t)srTimeBaseInfo.rLastPhaseChange.s32TimeStampNs);
+            au64Input[u16Cycle] = au64Input[u16Cycle] + GPTP_INTERNAL_AbsInt64ToUint64((int64_t)prCtx->rTimeBaseInfo.rLastPhaseChange.s32TimeStampNs);
         }
         /* Other cycles. */
         else
@@ -290,7 +223,7 @@ void GPTP_PORT_TimeBaseInfoGet(uint16_t *pu16GmTimeBaseIndicator,
                                (((uint32_t)au64Output[4] & (uint32_t)GPTP_DEF_BIT_MASK_48L_16H) << 16u));
 
     /* Negative phase. */
-    if (true == srTimeBaseInfo.bNegativePhase)
+    if (true == prCtx->rTimeBaseInfo.bNegativePhase)
     {
         /* Multiplication by -1 using integer manipulation on number represented
            by two's complement (i.e., bitwise NOT changes the number's sign
@@ -300,7 +233,7 @@ void GPTP_PORT_TimeBaseInfoGet(uint16_t *pu16GmTimeBaseIndicator,
     }
 
     /* Scaled last GM frequency change. */
-    f64Temp = srTimeBaseInfo.f64LastFreqChange * (float64_t)GPTP_DEF_POW_2_41;
+    f64Temp = prCtx->rTimeBaseInfo.f64LastFreqChange * (float64_t)GPTP_DEF_POW_2_41;
     *pu32ScaledLastGmFreqChange = (uint32_t)((int32_t)f64Temp);
 }
 
@@ -370,6 +303,9 @@ void GPTP_PORT_ValueNvmWrite(gptp_def_pdelay_t *prPdelMachine,
  * @brief           This function reads data from the NVM.
  *
  * @details         This function reads data from the NVM using flash driver.
+ *                  With the asynchronous read callback configured, the value
+ *                  is marked as not available (NaN) and the stored one is
+ *                  delivered later by GPTP_NvmReadDone.
  *
  * @param[in]       prPdelMachine Pointer to respective Pdelay machine.
  * @param[in]       eNvmDataType NVM data type to access.
@@ -383,22 +319,30 @@ void GPTP_PORT_ValueNvmRead(gptp_def_pdelay_t *prPdelMachine,
                             gptp_def_nvm_data_t eNvmDataType,
                             const gptp_def_data_t *cprGptp)
 {
-    gptp_err_type_t eError;
-    float64_t       *pf64Value;
+    gptp_err_type_t        eError;
+    float64_t              *pf64Value;
+    float64_t              *pf64Stored;
+    gptp_def_mem_read_stat *peReadStat;
 
     switch (eNvmDataType)
     {
         /* PropagationDelay read request. */
         case GPTP_DEF_NVM_PDELAY:
             pf64Value = &(prPdelMachine->f64NeighborPropDelay);
+            pf64Stored = &(prPdelMachine->f64PdelayNvm);
+            peReadStat = &(prPdelMachine->rPdelayNvmReadStat);
             break;
         /* NeighbourRateRatio read request. */
         case GPTP_DEF_NVM_RRATIO:
             pf64Value = &(prPdelMachine->f64NeighborRateRatio);
+            pf64Stored = &(prPdelMachine->f64RratioNvm);
+            peReadStat = &(prPdelMachine->rRratioNvmReadStat);
             break;
         /* Undefined read request. */
         default:
             pf64Value = NULL;
+            pf64Stored = NULL;
+            peReadStat = NULL;
             GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF,
                               GPTP_ERR_DOMAIN_NOT_SPECIF,
                               GPTP_ERR_N_UNABLE_NVM_READ,
@@ -406,8 +350,25 @@ void GPTP_PORT_ValueNvmRead(gptp_def_pdelay_t *prPdelMachine,
             break;
     }
 
-    if ((NULL != cprGptp->rPtpStackCallBacks.pfNvmReadCB) &&
+    if ((NULL != cprGptp->rPtpStackCallBacks.pfNvmReadReqCB) &&
         (NULL != pf64Value))
+    {
+        /* The value is not available until the read completes. */
+        *pf64Value = ((float64_t)0.0f / (float64_t)0.0f);
+        *peReadStat = GPTP_DEF_MEM_READ_PENDING;
+        eError = (gptp_err_type_t)cprGptp->rPtpStackCallBacks.pfNvmReadReqCB(prPdelMachine->u8GptpPort,
+                                                                             eNvmDataType);
+        if (GPTP_ERR_OK != eError)
+        {
+            *peReadStat = GPTP_DEF_MEM_READ_IDLE;
+            GPTP_ERR_Register(GPTP_ERR_PORT_NOT_SPECIF,
+                              GPTP_ERR_DOMAIN_NOT_SPECIF,
+                              GPTP_ERR_N_UNABLE_NVM_READ,
+                              GPTP_ERR_SEQ_ID_NOT_SPECIF);
+        }
+    }
+    else if ((NULL != cprGptp->rPtpStackCallBacks.pfNvmReadCB) &&
+             (NULL != pf64Value))
     {
         eError = (gptp_err_type_t)cprGptp->rPtpStackCallBacks.pfNvmReadCB(prPdelMachine->u8GptpPort,
                                                                           eNvmDataType,
@@ -421,126 +382,39 @@ void GPTP_PORT_ValueNvmRead(gptp_def_pdelay_t *prPdelMachine,
                               GPTP_ERR_N_UNABLE_NVM_READ,
                               GPTP_ERR_SEQ_ID_NOT_SPECIF);
         }
+        *pf64Stored = *pf64Value;
     }
 }
 
 /*!
- * @brief           This function sends PTP message.
+ * @brief           This function stores the metadata of the transmitted
+ *                  frame waiting for its egress timestamp.
  *
- * @details         This function sends PTP message using the ENET driver.
+ * @details         Only the frames with the egress timestamp requested by
+ *                  the stack are tracked. The timestamp is inserted in
+ *                  the metadata by GPTP_PORT_TxConfirmation.
  *
- * @param[in]       u8Port gPTP port on which the PTP message is transmitted.
- * @param[in]       u8FramePrio Eth frame priority.
- * @param[in]       cprTxData Pointer to the structure containing data to send.
+ * @param[in]       cprTxData Pointer to the transmitted data.
  * @param[in]       u8FrameId Frame ID of the transmitted message.
- *
- * @return          Error status,
- * @retval          GPTP_ERR_OK: The frame was successfully transmitted.
- * @retval          GPTP_ERR_V_NULL_PTR: Empty or invalid input arguments.
- * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: Transmit buffer was not
- *                  provided by eth driver.
- * @retval          GPTP_ERR_F_FRAME_SEND: The frame was not successfully
- *                  transmitted.
- *
- * @ requirements 529199
- * @ requirements 529256
+ * @param[in]       u32BufferIndex Index of the transmit buffer.
 */
-gptp_err_type_t GPTP_PORT_MsgSend(uint8_t u8Port,
-                                  uint8_t u8FramePrio,
-                                  const gptp_def_tx_data_t *cprTxData,
-                                  uint8_t u8FrameId)
+void GPTP_PORT_FrameMapStore(const gptp_def_tx_data_t *cprTxData,
+                             uint8_t u8FrameId,
+                             uint32_t u32BufferIndex)
 {
-    Std_ReturnType        eStatus;
-    BufReq_ReturnType     eBufStatus;
-    gptp_err_type_t       eError;
-    static Eth_BufIdxType seBuffIdx;
-    static uint8_t        *spu8Buffer;
-    static uint16_t       su16BufferLength;
-    uint16_t              u16PTPFramePayloadLength;
-    uint8_t               u8PhyPort;
-
-    /* Error initial value. */
-    spu8Buffer = NULL;
-    eError = GPTP_ERR_OK;
-
-    /* Check input arguments. */
-    if ((NULL != cprTxData) && (cprTxData->u8FrameLength > GPTP_DEF_ETH_II_LEN))
+    if ((true == cprTxData->bTsRequested) && (NULL != cprTxData->prFrameMap))
     {
-        /* Get real port ID from map table. */
-        u8PhyPort = srPortMap.prMapTable[u8Port].u8SwitchPort;
-
-        /* Payload length calculation of the gPTP frame (without eth header). */
-        u16PTPFramePayloadLength = ((uint16_t)cprTxData->u8FrameLength - GPTP_DEF_ETH_II_LEN);
-        su16BufferLength = u16PTPFramePayloadLength;
-
-        /* Get transmit buffer to store gPTP frame payload. */
-        eBufStatus = Eth_43_GMAC_ProvideTxBuffer(u8PhyPort, u8FramePrio,
-                                                 &seBuffIdx, &spu8Buffer,
-                                                 &su16BufferLength);
-
-        /* The buffer is provided with desired length. */
-        if ((BUFREQ_OK == eBufStatus) &&
-            (NULL != spu8Buffer) &&
-            (su16BufferLength >= u16PTPFramePayloadLength))
-        {
-            /* Copy only payload of the gPTP generated frame to buffer provided
-               by Eth_43 driver. */
-            for (uint16_t i = 0u; i < u16PTPFramePayloadLength; i++)
-            {
-                spu8Buffer[i] = cprTxData->pau8TxBuffPtr[GPTP_DEF_ETH_II_LEN + i];
-            }
-
-            /* If timestmp for this frame is requested by the gPTP stack. */
-            if (true == cprTxData->bTsRequested)
-            {
-                /* Instruct the Ethernet driver to capture timestamp of egress
-                   ethernet frame associated with buffIdx. */
-                Eth_43_GMAC_EnableEgressTimeStamp(u8PhyPort, seBuffIdx);
-
-                /* Only store frame metadata if egress timestamp is required
-                   by stack. */
-                if (NULL != cprTxData->prFrameMap)
-                {
-                    /* Store frame metadata before transmission.
-                       Timestamp in metadata is inserted in TxConfirmation. */
-                    cprTxData->prFrameMap->u8PtpFrameId = u8FrameId;
-                    cprTxData->prFrameMap->u32BufferIndex = seBuffIdx;
-                    cprTxData->prFrameMap->eTsEntryStatus = GPTP_DEF_TS_MAP_ENTRY_ENQUEUED;
-                }
-            }
-
-            /* Enable transmission, destination MAC address is taken from
-               generated PTP frame, which contains full eth header. */
-            eStatus = Eth_43_GMAC_Transmit(u8PhyPort, seBuffIdx,
-                                           GPTP_FR_ETH_TYPE_PTP, true,
-                                           u16PTPFramePayloadLength,
-                                           &cprTxData->pau8TxBuffPtr[0]);
-            if ((Std_ReturnType)E_OK != eStatus)
-            {
-                /* Transmission falied. */
-                eError = GPTP_ERR_F_FRAME_SEND;
-            }
-        }
-        else
-        {
-            /* No Tx buffer. */
-            eError = GPTP_ERR_M_MSG_BUFF_PTR_NULL;
-        }
+        cprTxData->prFrameMap->u8PtpFrameId = u8FrameId;
+        cprTxData->prFrameMap->u32BufferIndex = u32BufferIndex;
+        cprTxData->prFrameMap->eTsEntryStatus = GPTP_DEF_TS_MAP_ENTRY_ENQUEUED;
     }
-    else
-    {
-        /* Invalid input arguments. */
-        eError = GPTP_ERR_V_NULL_PTR;
-    }
-
-    return eError;
 }
 
 /*!
  * @brief           This function reads current link status of the gPTP port.
  *
  * @details         This function reads current link status of the gPTP port
- *                  using Switch driver.
+ *                  from the controller mapped to the port.
  *
  * @param[in]       u8Port gPTP port number.
  * @param[out]      pbStat Pointer to the status variable, updated in
@@ -557,33 +431,20 @@ gptp_err_type_t GPTP_PORT_MsgSend(uint8_t u8Port,
 gptp_err_type_t GPTP_PORT_GetLinkStatus(uint8_t u8Port,
                                         bool *pbStat)
 {
-    gptp_err_type_t              eError;
-    uint8_t                      u8TrcvIdx;
-    static EthTrcv_LinkStateType seLinkState;
+    gptp_port_ctx_t *prCtx;
+    gptp_err_type_t eError;
 
-    /* Get real port ID from map table. */
-    u8TrcvIdx = srPortMap.prMapTable[u8Port].u8SwitchPort;
     /* Init variables. */
+    prCtx = GPTP_PORT_CtxGet();
     eError = GPTP_ERR_V_NULL_PTR;
 
     /* Check pointer validity. */
     if (NULL != pbStat)
     {
-        /* Read link state. */
-        if ((Std_ReturnType)E_OK == EthTrcv_GetLinkState(u8TrcvIdx, &seLinkState))
+        if (u8Port < prCtx->rPortMap.u8NumOfGptpPorts)
         {
-            eError = GPTP_ERR_OK;
-
-            if (ETHTRCV_LINK_STATE_ACTIVE == seLinkState)
-            {
-                /* Link is up. */
-                *pbStat = true;
-            }
-            else
-            {
-                /* Link is down. */
-                *pbStat = false;
-            }
+            /* Read link state of the real port from map table. */
+            eError = GPTP_PORT_HwLinkGet(prCtx->rPortMap.prMapTable[u8Port].u8SwitchPort, pbStat);
         }
         else
         {
@@ -598,8 +459,8 @@ gptp_err_type_t GPTP_PORT_GetLinkStatus(uint8_t u8Port,
 /*!
  * @brief           This function gets current Time Stamp time.
  *
- * @details         This function gets current Time Stamp time from the Switch
- *                  driver.
+ * @details         This function gets current Time Stamp time from
+ *                  the FreeRunning timer or the PTP clock.
  *
  * @param[in]       eTsType Type of the Time Stamp (free-running of corrected).
  *
@@ -610,31 +471,19 @@ gptp_err_type_t GPTP_PORT_GetLinkStatus(uint8_t u8Port,
 */
 gptp_def_timestamp_t GPTP_PORT_CurrentTimeGet(gptp_def_ts_type_t eTsType)
 {
-    static Eth_TimeStampQualType seTimeStampQuality;
-    static Eth_TimeStampType     srEthTimestamp;
-    Std_ReturnType               eStatus;
-    gptp_def_timestamp_t         rTimeStamp;
-    uint64_t                     u64FreeRunningCapture;
+    gptp_def_timestamp_t rTimeStamp;
+    uint64_t             u64FreeRunningCapture;
 
     switch (eTsType)
     {
         case GPTP_DEF_TS_FREERUNNING:
             u64FreeRunningCapture = GPTP_PORT_GetFreeRunningTimer();
             rTimeStamp.u64TimeStampS = u64FreeRunningCapture / (uint64_t)GPTP_DEF_NS_IN_SECONDS;
-            rTimeStamp.u32TimeStampNs = (uint32_t)((uint64)u64FreeRunningCapture % (uint64)GPTP_DEF_NS_IN_SECONDS);
+            rTimeStamp.u32TimeStampNs = (uint32_t)(u64FreeRunningCapture % (uint64_t)GPTP_DEF_NS_IN_SECONDS);
             break;
 
         case GPTP_DEF_TS_CORRECTED:
-            eStatus = Eth_43_GMAC_GetCurrentTime(GPTP_PORT_ETH_CTRL_IDX,
-                                                 &seTimeStampQuality,
-                                                 &srEthTimestamp);
-            if (((Std_ReturnType)E_OK == eStatus) &&
-                (ETH_VALID == seTimeStampQuality))
-            {
-                rTimeStamp.u64TimeStampS = (((uint64_t)srEthTimestamp.secondsHi & (uint64_t)GPTP_DEF_BIT_MASK_16L_16H) << 32u) | (uint64_t)srEthTimestamp.seconds;
-                rTimeStamp.u32TimeStampNs = srEthTimestamp.nanoseconds;
-            }
-            else
+            if (GPTP_ERR_OK != GPTP_PORT_HwClockGet(&rTimeStamp))
             {
                 rTimeStamp.u64TimeStampS = 0u;
                 rTimeStamp.u32TimeStampNs = 0u;
@@ -653,8 +502,8 @@ gptp_def_timestamp_t GPTP_PORT_CurrentTimeGet(gptp_def_ts_type_t eTsType)
 /*!
  * @brief           This function reads MAC Address of the gPTP port.
  *
- * @details         This function reads MAC Address of the gPTP port using
- *                  the Switch driver.
+ * @details         This function reads MAC Address of the gPTP port from
+ *                  the controller mapped to the port.
  *
  * @param[in]       u8Port gPTP port number.
  * @param[out]      pu64Mac Pointer to the MAC Address variable, updated in
@@ -673,14 +522,17 @@ gptp_def_timestamp_t GPTP_PORT_CurrentTimeGet(gptp_def_ts_type_t eTsType)
 gptp_err_type_t GPTP_PORT_ObtainPortMac(uint8_t u8Port,
                                         uint64_t *pu64Mac)
 {
+    gptp_port_ctx_t *prCtx;
     gptp_err_type_t eError;
 
+    prCtx = GPTP_PORT_CtxGet();
+
     if (NULL != pu64Mac)
     {
-        if (u8Port < srPortMap.u8NumOfGptpPorts)
+        if (u8Port < prCtx->rPortMap.u8NumOfGptpPorts)
         {
-            Eth_43_GMAC_GetPhysAddr(srPortMap.prMapTable[u8Port].u8SwitchPort,
-                                    (uint8_t *)pu64Mac);
+            GPTP_PORT_HwMacGet(prCtx->rPortMap.prMapTable[u8Port].u8SwitchPort,
+                               (uint8_t *)pu64Mac);
             eError = GPTP_ERR_OK;
         }
         else
@@ -700,7 +552,7 @@ gptp_err_type_t GPTP_PORT_ObtainPortMac(uint8_t u8Port,
  * @brief           This function provides time synchronization information.
  *
  * @details         This function provides time synchronization information
- *                  received from the Grand Master to the Switch driver.
+ *                  received from the Grand Master to the PTP clock.
  *
  * @param[in]       prGptp Pointer to global gPTP structure.
  * @param[in]       cu8DomainNumber Domain number of the received Follow Up
@@ -728,40 +580,50 @@ gptp_err_type_t GPTP_PORT_UpdateLocalClock(gptp_def_data_t *prGptp,
                                            const int8_t ci8SyncIntervalLog,
                                            bool *pbUpdated)
 {
+    gptp_port_ctx_t                 *prCtx;
     gptp_err_type_t                 eError;
-    static gptp_def_timestamp_sig_t srOffsetTmp;
+    gptp_def_timestamp_sig_t        rOffsetTmp;
     /* Holds time offset when applying time offset correction. */
-    static Eth_TimeIntDiffType      srTimeStampDiff;
-    static Eth_RateRatioType        srPseudoRatio;
+    int64_t                         s64TimeStepNs;
     /* Placeholder for gPTP stack computed rate ratio. */
-    static float64_t                sf64sRateRatio;
-    static bool                     sbNegativeOfst;
-    static int8_t                   si8SyncIntLog;
-    static float64_t                f64RatioOld;
+    float64_t                       f64RateRatio;
+    bool                            bNegativeOfst;
+    int8_t                          s8SyncIntLog;
+    float64_t                       f64RatioOld;
     float64_t                       f64RatioNew;
     int64_t                         i64PtpClkOffset;
     bool                            bUpdateClock;
     uint64_t                        u64Offset;
     int32_t                         i32PPBAdjustment;
     int32_t                         i32timeErrorNs;
+    gptp_def_domain_t               *prDomain;
+    uint8_t                         u8DomainIndex;
 
     /* Local variable initialization with default value. */
-    sf64sRateRatio = *cpf64RateRatio;
-    sbNegativeOfst = cbNegative;
+    prCtx = GPTP_PORT_CtxGet();
+    f64RateRatio = *cpf64RateRatio;
+    bNegativeOfst = cbNegative;
     bUpdateClock = false;
-    si8SyncIntLog = ci8SyncIntervalLog;
-    srOffsetTmp = crOffset;
+    s8SyncIntLog = ci8SyncIntervalLog;
+    rOffsetTmp = crOffset;
     eError = GPTP_ERR_OK;
     f64RatioOld = 0.0;
+    prDomain = NULL;
+
+    /* Each domain runs its own servo, the PI controller or the Kalman filter. */
+    if (true == GPTP_INTERNAL_DomainLookup(prGptp, cu8DomainNumber, &u8DomainIndex))
+    {
+        prDomain = &prGptp->prPerDomainParams[u8DomainIndex];
+    }
 
     /* Call domain selection callback if configured. */
     if (NULL != prGptp->rPtpStackCallBacks.pfDomSelectionCB)
     {
         bUpdateClock = prGptp->rPtpStackCallBacks.pfDomSelectionCB(cu8DomainNumber,
-                                                                   &sf64sRateRatio,
-                                                                   &srOffsetTmp,
-                                                                   &sbNegativeOfst,
-                                                                   &si8SyncIntLog);
+                                                                   &f64RateRatio,
+                                                                   &rOffsetTmp,
+                                                                   &bNegativeOfst,
+                                                                   &s8SyncIntLog);
     }
     else
     {
@@ -777,7 +639,7 @@ gptp_err_type_t GPTP_PORT_UpdateLocalClock(gptp_def_data_t *prGptp,
         /* Store the reported offset to device params. */
         prGptp->rPerDeviceParams.rReportedOffset = crOffset;
         prGptp->rPerDeviceParams.bReportedOffsetNeg = cbNegative;
-        prGptp->rPerDeviceParams.f64CorrClockRateRatio = sf64sRateRatio;
+        prGptp->rPerDeviceParams.f64CorrClockRateRatio = f64RateRatio;
 
         u64Offset = GPTP_INTERNAL_AbsInt64ToUint64(crOffset.s64TimeStampS * (int64_t)GPTP_DEF_NS_IN_SECONDS);
         u64Offset += GPTP_INTERNAL_AbsInt64ToUint64((int64_t)crOffset.s32TimeStampNs);
@@ -786,50 +648,77 @@ gptp_err_type_t GPTP_PORT_UpdateLocalClock(gptp_def_data_t *prGptp,
         if (u64Offset > prGptp->rPerDeviceParams.u64PIControllerMaxThreshold)
         {
             /* Calculate absolute time correction. */
-            srTimeStampDiff.diff.secondsHi = (uint16_t)((uint32_t)(((uint64_t)crOffset.s64TimeStampS & (uint64_t)GPTP_DEF_BIT_MASK_32H_32L) >> 32u ) & (uint32_t)GPTP_DEF_BIT_MASK_16L_16H);
-            srTimeStampDiff.diff.seconds = (uint32_t)((uint64_t)crOffset.s64TimeStampS & (uint64_t)GPTP_DEF_BIT_MASK_32L_32H);
-            srTimeStampDiff.diff.nanoseconds = (uint32_t)crOffset.s32TimeStampNs;
-            srTimeStampDiff.sign = !cbNegative;
+            s64TimeStepNs = (int64_t)u64Offset;
+            if (true == cbNegative)
+            {
+                s64TimeStepNs = -s64TimeStepNs;
+            }
 
             /* Calculate relative PPB correction from rateRatio reported by
                gPTP stack. */
-            i32PPBAdjustment = GPTP_INTERNAL_Float64ToInt32((1.0 - sf64sRateRatio) * (float64_t)GPTP_DEF_NS_IN_SECONDS);
+#ifdef GPTP_FIXED_POINT
+            i32PPBAdjustment = (int32_t)GPTP_FXP_RatioMul((int64_t)GPTP_DEF_NS_IN_SECONDS, GPTP_FXP_Q32_ONE - GPTP_FXP_Float64ToQ32(f64RateRatio));
+#else
+            i32PPBAdjustment = GPTP_INTERNAL_Float64ToInt32((1.0 - f64RateRatio) * (float64_t)GPTP_DEF_NS_IN_SECONDS);
+#endif /* GPTP_FIXED_POINT */
 
             /* Origin of average calculation. */
-            si32PPBadjustmentAverage = i32PPBAdjustment;
+            prCtx->s32PpbAdjustmentAverage = i32PPBAdjustment;
+
+            if (NULL != prDomain)
+            {
+                GPTP_INTERNAL_ServoClear(prDomain);
+            }
 
-            GPTP_PI_Clear();
+            /* Reset sync lock and report to the app. */
+            GPTP_INTERNAL_ResetSyncLock(prGptp);
         }
         /* PI controller mode adjusting oscilator PPM in range +-50 PPM from
            reference frequency. */
         else
         {
             /* Must be cleared (does not need to adjust absolute time offset). */
-            srTimeStampDiff.diff.nanoseconds = 0u;
-            srTimeStampDiff.diff.seconds = 0u;
-            srTimeStampDiff.diff.secondsHi = 0u;
-            srTimeStampDiff.sign = true;
+            s64TimeStepNs = 0;
 
             /* Convert crOffset to signed integer. */
             i32timeErrorNs = cbNegative ? crOffset.s32TimeStampNs : -crOffset.s32TimeStampNs;
 
-            /* Calculate the PI Controller output for this control loop cycle. */
-            i32PPBAdjustment = GPTP_PI_Update(ci8SyncIntervalLog,
-                                              i32timeErrorNs);
+            /* Calculate the servo output for this control loop cycle. */
+            i32PPBAdjustment = 0;
+            if (NULL != prDomain)
+            {
+                i32PPBAdjustment = GPTP_INTERNAL_ServoUpdate(prDomain, ci8SyncIntervalLog,
+                                                             i32timeErrorNs);
+            }
 
             /* Calculate weighted average. */
-            si32PPBadjustmentAverage = GPTP_INTERNAL_Float64ToInt32(((1.0 - GPTP_PORT_NEW_PPB_WEIGHT) * (float64_t)si32PPBadjustmentAverage) + (GPTP_PORT_NEW_PPB_WEIGHT * (float64_t)i32PPBAdjustment));
+#ifdef GPTP_FIXED_POINT
+            prCtx->s32PpbAdjustmentAverage = (int32_t)GPTP_FXP_Average((int64_t)prCtx->s32PpbAdjustmentAverage, (int64_t)i32PPBAdjustment, GPTP_PORT_OLD_PPB_WEIGHT_Q16);
+#else
+            prCtx->s32PpbAdjustmentAverage = GPTP_INTERNAL_Float64ToInt32(((1.0 - GPTP_PORT_NEW_PPB_WEIGHT) * (float64_t)prCtx->s32PpbAdjustmentAverage) + (GPTP_PORT_NEW_PPB_WEIGHT * (float64_t)i32PPBAdjustment));
+#endif /* GPTP_FIXED_POINT */
         }
 
-        /* Covert PPB to pseudo ratio. */
-        srPseudoRatio = GPTP_PORT_PPBToPseudoRatio(i32PPBAdjustment);
+        /* Frequency history of the holdover, the clock steps are not tracked. */
+        GPTP_HOLD_Track(&prGptp->rPerDeviceParams.rHoldover,
+                        GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING)),
+                        i32PPBAdjustment,
+                        (bool)((true == prGptp->rPerDeviceParams.bSynced) &&
+                               (u64Offset <= prGptp->rPerDeviceParams.u64PIControllerMaxThreshold)));
 
-        /* Apply time and frequency correction to the GMAC timer. */
-        if ((Std_ReturnType)E_OK == Eth_43_GMAC_SetCorrectionTime(GPTP_PORT_ETH_CTRL_IDX, &srTimeStampDiff, &srPseudoRatio))
+        /* Apply time and frequency correction to the PTP clock. */
+        if (GPTP_ERR_OK == GPTP_PORT_HwClockCorrect(s64TimeStepNs, i32PPBAdjustment))
         {
             /* Notification to gPTP stack, clock was successfully updated. */
             *pbUpdated = true;
             prGptp->rPerDeviceParams.bEverUpdated = true;
+            prGptp->rPerDeviceParams.s32ClockAdjPpb = i32PPBAdjustment;
+#ifdef GPTP_COUNTERS
+            if (0 != s64TimeStepNs)
+            {
+                GPTP_INTERNAL_ClockStepped(prGptp, s64TimeStepNs);
+            }
+#endif /* GPTP_COUNTERS */
         }
         else
         {
@@ -841,20 +730,44 @@ gptp_err_type_t GPTP_PORT_UpdateLocalClock(gptp_def_data_t *prGptp,
 
         /* Update time base info structure. */
         f64RatioNew = ((float64_t)i32PPBAdjustment / 1000000000.0);
-        i64PtpClkOffset = GPTP_INTERNAL_TsToS64(srOffsetTmp);
+        i64PtpClkOffset = GPTP_INTERNAL_TsToS64(rOffsetTmp);
         /* The offset has changed or the old and new ratios are not the same. */
         if ((0 != i64PtpClkOffset) ||
             !(((f64RatioOld - f64RatioNew) < GPTP_PORT_EPSILON) &&
               ((f64RatioNew - f64RatioOld) < GPTP_PORT_EPSILON)))
         {
-            srTimeBaseInfo.u16TimeBaseIndicator++;
-            srTimeBaseInfo.rLastPhaseChange = srOffsetTmp;
-            srTimeBaseInfo.bNegativePhase = sbNegativeOfst;
-            srTimeBaseInfo.f64LastFreqChange = f64RatioNew;
+            prCtx->rTimeBaseInfo.u16TimeBaseIndicator++;
+            prCtx->rTimeBaseInfo.rLastPhaseChange = rOffsetTmp;
+            prCtx->rTimeBaseInfo.bNegativePhase = bNegativeOfst;
+            prCtx->rTimeBaseInfo.f64LastFreqChange = f64RatioNew;
         }
 
         f64RatioOld = f64RatioNew;
     }
+    /* Domain not selected for the clock update (e.g. hot standby) measures
+       the clock steered by the selected domain. Its servo follows the applied
+       correction, so the switchover continues from the current frequency
+       instead of the output of a servo running open-loop. */
+    else if (NULL != prDomain)
+    {
+        u64Offset = GPTP_INTERNAL_AbsInt64ToUint64(crOffset.s64TimeStampS * (int64_t)GPTP_DEF_NS_IN_SECONDS);
+        u64Offset += GPTP_INTERNAL_AbsInt64ToUint64((int64_t)crOffset.s32TimeStampNs);
+
+        if (u64Offset > prGptp->rPerDeviceParams.u64PIControllerMaxThreshold)
+        {
+            GPTP_INTERNAL_ServoClear(prDomain);
+        }
+        else
+        {
+            i32timeErrorNs = cbNegative ? crOffset.s32TimeStampNs : -crOffset.s32TimeStampNs;
+            GPTP_INTERNAL_ServoTrack(prDomain, ci8SyncIntervalLog, i32timeErrorNs,
+                                     prGptp->rPerDeviceParams.s32ClockAdjPpb);
+        }
+    }
+    else
+    {
+        /* Unknown domain, nothing to track. */
+    }
 
     return eError;
 }
@@ -863,9 +776,9 @@ gptp_err_type_t GPTP_PORT_UpdateLocalClock(gptp_def_data_t *prGptp,
  * @brief           This function stabilizes the local clock.
  *
  * @details         This function stabilizes the local clock running.
- *                  The stabilized clock runs at the current rate ratio.
- *                  It prevents clock from drifting, in case of Grand Master
- *                  loss.
+ *                  The stabilized clock runs at the frequency extrapolated
+ *                  by the holdover model. It prevents clock from drifting,
+ *                  in case of Grand Master loss.
  *
  * @param[in]       cpf64RateRatio Rate Ratio.
  *
@@ -880,27 +793,28 @@ gptp_err_type_t GPTP_PORT_FixLocalClock(const float64_t *cpf64RateRatio)
 {
     (void)*cpf64RateRatio;
 
-    gptp_err_type_t            eError;
-    static Eth_TimeIntDiffType srTimeStampDiff;
-    static Eth_RateRatioType   srPseudoRatio;
-
-    /* Local variable initialization with default value. */
-    srTimeStampDiff.diff.nanoseconds = 0u;
-    srTimeStampDiff.diff.seconds = 0u;
-    srTimeStampDiff.diff.secondsHi = 0u;
-    srTimeStampDiff.sign = true;
-
-    /* Use current average value of PI Controller instead of RateRatio. */
-    srPseudoRatio = GPTP_PORT_PPBToPseudoRatio(si32PPBadjustmentAverage);
-
-    /* Adjust only the frequency of local GMAC timer. */
-    if ((Std_ReturnType)E_OK == Eth_43_GMAC_SetCorrectionTime(GPTP_PORT_ETH_CTRL_IDX, &srTimeStampDiff, &srPseudoRatio))
-    {
-        eError = GPTP_ERR_OK;
-    }
-    else
+    gptp_port_ctx_t *prCtx;
+    gptp_err_type_t eError;
+    gptp_def_data_t *prGptp;
+    uint64_t        u64Offset;
+    int32_t         i32PPBAdjustment;
+
+    prCtx = GPTP_PORT_CtxGet();
+    prGptp = GPTP_GetMainStrPtr();
+
+    u64Offset = GPTP_INTERNAL_AbsInt64ToUint64(prGptp->rPerDeviceParams.rReportedOffset.s64TimeStampS * (int64_t)GPTP_DEF_NS_IN_SECONDS);
+    u64Offset += GPTP_INTERNAL_AbsInt64ToUint64((int64_t)prGptp->rPerDeviceParams.rReportedOffset.s32TimeStampNs);
+
+    /* Use the frequency extrapolated by the holdover model instead of RateRatio,
+       current average value of PI Controller until the model is fitted, and
+       adjust only the frequency of the PTP clock. */
+    i32PPBAdjustment = GPTP_HOLD_Enter(&prGptp->rPerDeviceParams.rHoldover,
+                                       GPTP_INTERNAL_TsToU64(GPTP_PORT_CurrentTimeGet(GPTP_DEF_TS_FREERUNNING)),
+                                       prCtx->s32PpbAdjustmentAverage, u64Offset);
+    eError = GPTP_PORT_HwClockCorrect(0, i32PPBAdjustment);
+    if (GPTP_ERR_OK == eError)
     {
-        eError = GPTP_ERR_F_UPDATE_PTP;
+        prGptp->rPerDeviceParams.s32ClockAdjPpb = i32PPBAdjustment;
     }
 
     return eError;
@@ -918,7 +832,10 @@ gptp_err_type_t GPTP_PORT_FixLocalClock(const float64_t *cpf64RateRatio)
  * @param[out]      prCorrectedClk Pointer to the corrected clock variable,
  *                  updated in the function.
  *
- * @return          GPTP_ERR_OK in case the time is successfully read.
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The time is successfully read.
+ * @retval          GPTP_ERR_I_COUNTERS_NULL_PTR: Empty input arguments.
+ * @retval          GPTP_ERR_F_TIME_READ: The PTP clock cannot be read.
  *
  * @ requirements 529199
  * @ requirements 529263
@@ -926,38 +843,21 @@ gptp_err_type_t GPTP_PORT_FixLocalClock(const float64_t *cpf64RateRatio)
 gptp_err_type_t GPTP_PORT_GetSwitchTimes(gptp_def_timestamp_t *prFreeRunClk,
                                          gptp_def_timestamp_t *prCorrectedClk)
 {
-    static Eth_TimeStampQualType seTimeStampQuality;
-    static Eth_TimeStampType     srTimeStamp;
-    gptp_err_type_t              eError;
-    Std_ReturnType               eStatus;
-
-    /* Capture HW GMAC timer timestamp. */
-    eStatus = Eth_43_GMAC_GetCurrentTime(GPTP_PORT_ETH_CTRL_IDX,
-                                         &seTimeStampQuality, &srTimeStamp);
-    if (((Std_ReturnType)E_OK == eStatus) && (ETH_VALID == seTimeStampQuality))
-    {
-        /* Check address of destination buffers. */
-        if ((NULL != prFreeRunClk) && (NULL != prCorrectedClk))
-        {
-            /* Calculate corrected timestamp. */
-            prCorrectedClk->u64TimeStampS = (((uint64_t)srTimeStamp.secondsHi & (uint64_t)GPTP_DEF_BIT_MASK_16L_16H) << 32u) | (uint64_t)srTimeStamp.seconds;
-            prCorrectedClk->u32TimeStampNs = srTimeStamp.nanoseconds;
+    gptp_err_type_t eError;
 
-            /* S32K3 does not have freeRunning HW timer, so use the corrected
-               one from GMAC. */
-            prFreeRunClk->u64TimeStampS = prCorrectedClk->u64TimeStampS;
-            prFreeRunClk->u32TimeStampNs = prCorrectedClk->u32TimeStampNs;
+    /* Check address of destination buffers. */
+    if ((NULL != prFreeRunClk) && (NULL != prCorrectedClk))
+    {
+        /* Capture PTP clock timestamp. */
+        eError = GPTP_PORT_HwClockGet(prCorrectedClk);
 
-            eError = GPTP_ERR_OK;
-        }
-        else
-        {
-            eError = GPTP_ERR_I_COUNTERS_NULL_PTR;
-        }
+        /* S32K3 does not have freeRunning HW timer, so the freeRunning
+           value is taken from the corrected clock. */
+        *prFreeRunClk = *prCorrectedClk;
     }
     else
     {
-        eError = GPTP_ERR_F_TIME_READ;
+        eError = GPTP_ERR_I_COUNTERS_NULL_PTR;
     }
 
     return eError;
@@ -984,10 +884,10 @@ void GPTP_PORT_ProcessMapEntry(gptp_def_tx_frame_map_t *prFrameMap)
             {
                 /* Pass the egress timestamp to gPTP stack together with
                    previously assigned frame id. */
-                GPTP_TimeStampHandler(prFrameMap->u8EgressPort,
-                                      prFrameMap->u32EgressTimeStampSeconds,
-                                      prFrameMap->u32EgressTimeStampNanoseconds,
-                                      prFrameMap->u8PtpFrameId);
+                GPTP_TimeStampHandlerInst(GPTP_GetMainStrPtr(), prFrameMap->u8EgressPort,
+                                          prFrameMap->u32EgressTimeStampSeconds,
+                                          prFrameMap->u32EgressTimeStampNanoseconds,
+                                          prFrameMap->u8PtpFrameId);
 
                 /* Set flag in buffer if and frame id as closed. */
                 prFrameMap->u32BufferIndex = GPTP_DEF_BUFF_INDEX_CLOSED;
@@ -25,7 +25,24 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
-/* None */
+/*
+ * Conversion between the host and the network (big-endian) byte order, used
+ * by the frame serialization to access the frame fields as whole words. With
+ * the macros undefined (or GPTP_PORT_NO_BSWAP defined) the fields are
+ * serialized byte by byte.
+ */
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && !defined(GPTP_PORT_NO_BSWAP)
+    #if (__ORDER_LITTLE_ENDIAN__ == __BYTE_ORDER__)
+        /* Single REV instruction on the Cortex-M7, BSWAP on the x86 */
+        #define GPTP_PORT_HTON16(u16Value)      __builtin_bswap16(u16Value)
+        #define GPTP_PORT_HTON32(u32Value)      __builtin_bswap32(u32Value)
+        #define GPTP_PORT_HTON64(u64Value)      __builtin_bswap64(u64Value)
+    #elif (__ORDER_BIG_ENDIAN__ == __BYTE_ORDER__)
+        #define GPTP_PORT_HTON16(u16Value)      (u16Value)
+        #define GPTP_PORT_HTON32(u32Value)      (u32Value)
+        #define GPTP_PORT_HTON64(u64Value)      (u64Value)
+    #endif
+#endif
 
 /*******************************************************************************
  * Data Types
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_port_hw.h
+ *
+ * @details Hardware primitives of the port layer. The hardware independent
+ *          part of the port layer (common/gptp_port.c) is shared by
+ *          the platforms, each platform implements these primitives in its
+ *          gptp_port_platform.c, which also transmits the frames.
+ *          Included by gptp_port_platform.h after it defines
+ *          GPTP_PORT_CTRL_MAX.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef GPTP_PORT_HW_H
+#define GPTP_PORT_HW_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#ifndef GPTP_PORT_CTRL_MAX
+#error "GPTP_PORT_CTRL_MAX has to be defined by gptp_port_platform.h"
+#endif /* GPTP_PORT_CTRL_MAX */
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief PTP time base information.
+ */
+typedef struct
+{
+    /* Time base is incremented evertime the PTP CLK slave changes its phase
+       or frequency. */
+    uint16_t u16TimeBaseIndicator;
+    /* Change of phase during the last time base indicator increment (i.e.,
+       current time offset between local (corrected) clock
+       and the Grand Master). */
+    gptp_def_timestamp_sig_t rLastPhaseChange;
+    /* The last phase change had positive/negative offset. */
+    bool bNegativePhase;
+    /* Fractional frequency change (i.e., frequency change expressed as a pure
+       fraction) during the last time base indicator increment. */
+    float64_t f64LastFreqChange;
+} gptp_port_ptp_tb_info_t;
+
+/*!
+ * @brief Port layer data of one stack instance.
+ */
+typedef struct
+{
+    /*! Stack instance served by the port layer, set by GPTP_PORT_PortMapInit. */
+    gptp_def_data_t                     *prGptp;
+    /*! Port map provided by GPTP_PORT_PortMapInit. */
+    gptp_def_map_info_t                 rPortMap;
+    /*! gPTP port by the controller index. */
+    uint8_t                             au8GptpPortLookup[GPTP_PORT_CTRL_MAX];
+    /*! Average of the applied frequency adjustments [ppb]. */
+    int32_t                             s32PpbAdjustmentAverage;
+    /*! Time base information reported to the stack. */
+    gptp_port_ptp_tb_info_t             rTimeBaseInfo;
+}gptp_port_ctx_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns the port layer data of the stack
+ *                  instance in use.
+ *
+ * @return          Pointer to the port layer data.
+*/
+gptp_port_ctx_t *GPTP_PORT_CtxGet(void);
+
+/*!
+ * @brief           This function reads the link state of the controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller.
+ * @param[out]      pbUp Pointer to the link state placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The link state was read.
+ * @retval          GPTP_ERR_I_NO_LINK_STATUS: Failed to read link state.
+*/
+gptp_err_type_t GPTP_PORT_HwLinkGet(uint8_t u8CtrlIdx,
+                                    bool *pbUp);
+
+/*!
+ * @brief           This function reads the MAC address of the controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller.
+ * @param[out]      pu8Mac Pointer to the MAC address placeholder.
+*/
+void GPTP_PORT_HwMacGet(uint8_t u8CtrlIdx,
+                        uint8_t *pu8Mac);
+
+/*!
+ * @brief           This function reads the PTP (corrected) clock.
+ *
+ * @param[out]      prTime Pointer to the time placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The clock was read.
+ * @retval          GPTP_ERR_F_TIME_READ: Failed to read the clock.
+*/
+gptp_err_type_t GPTP_PORT_HwClockGet(gptp_def_timestamp_t *prTime);
+
+/*!
+ * @brief           This function corrects the PTP (corrected) clock.
+ *
+ * @param[in]       s64StepNs Time step applied to the clock [ns].
+ * @param[in]       s32AdjustmentPpb Frequency adjustment of the clock
+ *                  relative to its oscillator [ppb].
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The clock was corrected.
+ * @retval          GPTP_ERR_F_UPDATE_PTP: Failed to correct the clock.
+*/
+gptp_err_type_t GPTP_PORT_HwClockCorrect(int64_t s64StepNs,
+                                         int32_t s32AdjustmentPpb);
+
+/*!
+ * @brief           This function stores the metadata of the transmitted
+ *                  frame waiting for its egress timestamp.
+ *
+ * @details         Called by the platform GPTP_PORT_MsgSend before
+ *                  the transmission can be confirmed.
+ *
+ * @param[in]       cprTxData Pointer to the transmitted data.
+ * @param[in]       u8FrameId Frame ID of the transmitted message.
+ * @param[in]       u32BufferIndex Index of the transmit buffer.
+*/
+void GPTP_PORT_FrameMapStore(const gptp_def_tx_data_t *cprTxData,
+                             uint8_t u8FrameId,
+                             uint32_t u32BufferIndex);
+
+/*******************************************************************************
+ * Guard End
+ ******************************************************************************/
+
+#endif /* GPTP_PORT_HW_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -21,11 +21,32 @@
 
 #include "gptp_port_platform.h"
 #include "gptp_port.h"
+#include "gptp_trace.h"
+#include "gptp_frame.h"
+#include "gptp_internal.h"
+#include "EthTrcv.h"
+#ifdef GPTP_PORT_STM_TIMEBASE
+#include "Stm_Ip.h"
+#endif /* GPTP_PORT_STM_TIMEBASE */
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
-/* None */
+
+/*! Index of ethernet controller which manage clock timer frequency. */
+#define GPTP_PORT_ETH_CTRL_IDX          (0u)
+
+/*! Debug Exception and Monitor Control Register and its trace enable bit. */
+#define GPTP_PORT_DEMCR                 (*(volatile uint32_t *)0xE000EDFCu)
+#define GPTP_PORT_DEMCR_TRCENA          (0x01000000u)
+/*! DWT control register and its cycle counter enable bit. */
+#define GPTP_PORT_DWT_CTRL              (*(volatile uint32_t *)0xE0001000u)
+#define GPTP_PORT_DWT_CTRL_CYCCNTENA    (0x00000001u)
+/*! DWT cycle counter. */
+#define GPTP_PORT_DWT_CYCCNT            (*(volatile uint32_t *)0xE0001004u)
+/*! DWT lock access register of Cortex-M7 and its unlock key. */
+#define GPTP_PORT_DWT_LAR               (*(volatile uint32_t *)0xE0001FB0u)
+#define GPTP_PORT_DWT_LAR_KEY           (0xC5ACCE55u)
 
 /*******************************************************************************
  * Data types
@@ -35,18 +56,550 @@
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
-/* None */
+
+static Eth_RateRatioType GPTP_PORT_PPBToPseudoRatio(int32_t i32PPB);
+#ifdef GPTP_PORT_STM_TIMEBASE
+static void GPTP_PORT_StmSample(void);
+#endif /* GPTP_PORT_STM_TIMEBASE */
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 
  static volatile uint64_t svu64FreeRunningGptpTimer;
+/* Port layer data of the stack instance. */
+static gptp_port_ctx_t          srPortCtx;
+
+#ifdef GPTP_PORT_STM_TIMEBASE
+/* STM counter value seen by the previous sample. */
+static uint32_t                 su32StmLastCount;
+/* STM ticks elapsed since GPTP_PORT_StmTimebaseInit. */
+static uint64_t                 su64StmTicks;
+/* STM keeps counting while the core is halted by debugger, no prescaler. */
+static const Stm_Ip_InstanceConfigType scrStmConfig =
+{
+    FALSE,
+#if (STM_IP_SET_CLOCK_MODE == STD_ON)
+    0u,
+#endif
+    0u
+};
+#endif /* GPTP_PORT_STM_TIMEBASE */
 
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
+#ifdef GPTP_PORT_STM_TIMEBASE
+/*!
+ * @brief           This function extends the STM counter to 64 bits.
+ *
+ * @details         The 32-bit difference to the previous sample is correct
+ *                  across a single counter wrap, the ticks are converted to
+ *                  nanoseconds from the accumulated value, so no rounding
+ *                  error builds up.
+*/
+static void GPTP_PORT_StmSample(void)
+{
+    uint32_t u32Count;
+
+    u32Count = Stm_Ip_GetCounterValue(GPTP_PORT_STM_INSTANCE);
+    su64StmTicks += (uint64_t)(uint32_t)(u32Count - su32StmLastCount);
+    su32StmLastCount = u32Count;
+
+    svu64FreeRunningGptpTimer = ((su64StmTicks / (uint64_t)GPTP_PORT_STM_FREQ_HZ) * (uint64_t)GPTP_DEF_NS_IN_SECONDS) + \
+                                (((su64StmTicks % (uint64_t)GPTP_PORT_STM_FREQ_HZ) * (uint64_t)GPTP_DEF_NS_IN_SECONDS) / (uint64_t)GPTP_PORT_STM_FREQ_HZ);
+}
+
+/*!
+ * @brief           This function starts the STM counter used as
+ *                  the FreeRunning time base.
+ *
+ * @details         Must be called before GPTP_GptpInit. The STM driver has
+ *                  to be enabled in the configuration (STM_IP_USED).
+*/
+void GPTP_PORT_StmTimebaseInit(void)
+{
+    Stm_Ip_Init(GPTP_PORT_STM_INSTANCE, &scrStmConfig);
+
+    su32StmLastCount = Stm_Ip_GetCounterValue(GPTP_PORT_STM_INSTANCE);
+    su64StmTicks = 0u;
+    svu64FreeRunningGptpTimer = 0u;
+}
+#endif /* GPTP_PORT_STM_TIMEBASE */
+
+/*!
+ * @brief           This function converts PPB to pseudo ratio
+*                  (frequency ratio).
+ *
+ * @details         This function converts PPB to pseudo ratio which is used for
+ *                  clock timer frequency adjustment by ETH driver.
+ *
+ * @param[in]       i32PPB Parts per billion.
+ *
+ * @return          Eth_RateRatioType as a pseudo ratio.
+ *
+ * @ requirements 529199
+ * @ requirements 539908
+*/
+static Eth_RateRatioType GPTP_PORT_PPBToPseudoRatio(int32_t i32PPB)
+{
+    Eth_RateRatioType rPseudoRatio;
+
+    rPseudoRatio.IngressTimeStampDelta.diff.seconds = 1u;
+    rPseudoRatio.IngressTimeStampDelta.diff.secondsHi = 0u;
+    rPseudoRatio.IngressTimeStampDelta.sign = true;
+
+    rPseudoRatio.OriginTimeStampDelta.diff.seconds = 1u;
+    rPseudoRatio.OriginTimeStampDelta.diff.secondsHi = 0u;
+    rPseudoRatio.OriginTimeStampDelta.sign = true;
+
+    if (0 < i32PPB)
+    {
+        rPseudoRatio.IngressTimeStampDelta.diff.nanoseconds = (uint32_t)i32PPB;
+        rPseudoRatio.OriginTimeStampDelta.diff.nanoseconds = 0u;
+    }
+    else
+    {
+        rPseudoRatio.OriginTimeStampDelta.diff.nanoseconds = (uint32_t)(GPTP_INTERNAL_AbsInt64ToUint64((int64_t)i32PPB));
+        rPseudoRatio.IngressTimeStampDelta.diff.nanoseconds = 0u;
+    }
+
+    return rPseudoRatio;
+}
+
+/*!
+ * @brief           This function returns the port layer data of the stack
+ *                  instance.
+ *
+ * @return          Pointer to the port layer data.
+*/
+gptp_port_ctx_t *GPTP_PORT_CtxGet(void)
+{
+    return &srPortCtx;
+}
+
+/*!
+ * @brief           This function reads the link state of the controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the transceiver.
+ * @param[out]      pbUp Pointer to the link state placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The link state was read.
+ * @retval          GPTP_ERR_I_NO_LINK_STATUS: Failed to read link state.
+*/
+gptp_err_type_t GPTP_PORT_HwLinkGet(uint8_t u8CtrlIdx,
+                                    bool *pbUp)
+{
+    static EthTrcv_LinkStateType seLinkState;
+    gptp_err_type_t              eError;
+
+    if ((Std_ReturnType)E_OK == EthTrcv_GetLinkState(u8CtrlIdx, &seLinkState))
+    {
+        *pbUp = (bool)(ETHTRCV_LINK_STATE_ACTIVE == seLinkState);
+        eError = GPTP_ERR_OK;
+    }
+    else
+    {
+        eError = GPTP_ERR_I_NO_LINK_STATUS;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function reads the MAC address of the controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller.
+ * @param[out]      pu8Mac Pointer to the MAC address placeholder.
+*/
+void GPTP_PORT_HwMacGet(uint8_t u8CtrlIdx,
+                        uint8_t *pu8Mac)
+{
+    Eth_43_GMAC_GetPhysAddr(u8CtrlIdx, pu8Mac);
+}
+
+/*!
+ * @brief           This function reads the PTP (corrected) clock.
+ *
+ * @param[out]      prTime Pointer to the time placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The GMAC timer was read.
+ * @retval          GPTP_ERR_F_TIME_READ: Failed to read the GMAC timer.
+*/
+gptp_err_type_t GPTP_PORT_HwClockGet(gptp_def_timestamp_t *prTime)
+{
+    static Eth_TimeStampQualType seTimeStampQuality;
+    static Eth_TimeStampType     srEthTimestamp;
+    gptp_err_type_t              eError;
+    Std_ReturnType               eStatus;
+
+    eStatus = Eth_43_GMAC_GetCurrentTime(GPTP_PORT_ETH_CTRL_IDX,
+                                         &seTimeStampQuality,
+                                         &srEthTimestamp);
+    if (((Std_ReturnType)E_OK == eStatus) &&
+        (ETH_VALID == seTimeStampQuality))
+    {
+        prTime->u64TimeStampS = (((uint64_t)srEthTimestamp.secondsHi & (uint64_t)GPTP_DEF_BIT_MASK_16L_16H) << 32u) | (uint64_t)srEthTimestamp.seconds;
+        prTime->u32TimeStampNs = srEthTimestamp.nanoseconds;
+        eError = GPTP_ERR_OK;
+    }
+    else
+    {
+        eError = GPTP_ERR_F_TIME_READ;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function corrects the PTP (corrected) clock.
+ *
+ * @param[in]       s64StepNs Time step applied to the clock [ns].
+ * @param[in]       s32AdjustmentPpb Frequency adjustment of the clock
+ *                  relative to its oscillator [ppb].
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The GMAC timer was corrected.
+ * @retval          GPTP_ERR_F_UPDATE_PTP: Failed to correct the GMAC timer.
+*/
+gptp_err_type_t GPTP_PORT_HwClockCorrect(int64_t s64StepNs,
+                                         int32_t s32AdjustmentPpb)
+{
+    static Eth_TimeIntDiffType srTimeStampDiff;
+    static Eth_RateRatioType   srPseudoRatio;
+    gptp_err_type_t            eError;
+    uint64_t                   u64StepNs;
+    uint64_t                   u64StepS;
+
+    /* Absolute time offset correction. */
+    u64StepNs = GPTP_INTERNAL_AbsInt64ToUint64(s64StepNs);
+    u64StepS = u64StepNs / (uint64_t)GPTP_DEF_NS_IN_SECONDS;
+    srTimeStampDiff.diff.secondsHi = (uint16_t)((uint32_t)((u64StepS & (uint64_t)GPTP_DEF_BIT_MASK_32H_32L) >> 32u) & (uint32_t)GPTP_DEF_BIT_MASK_16L_16H);
+    srTimeStampDiff.diff.seconds = (uint32_t)(u64StepS & (uint64_t)GPTP_DEF_BIT_MASK_32L_32H);
+    srTimeStampDiff.diff.nanoseconds = (uint32_t)(u64StepNs % (uint64_t)GPTP_DEF_NS_IN_SECONDS);
+    srTimeStampDiff.sign = (bool)(s64StepNs >= 0);
+
+    /* Covert PPB to pseudo ratio. */
+    srPseudoRatio = GPTP_PORT_PPBToPseudoRatio(s32AdjustmentPpb);
+
+    /* Apply time and frequency correction to the GMAC timer. */
+    if ((Std_ReturnType)E_OK == Eth_43_GMAC_SetCorrectionTime(GPTP_PORT_ETH_CTRL_IDX, &srTimeStampDiff, &srPseudoRatio))
+    {
+        eError = GPTP_ERR_OK;
+    }
+    else
+    {
+        eError = GPTP_ERR_F_UPDATE_PTP;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function registers multicast MAC.
+ *
+ * @details         This function provides interface to register MAC in
+ *                  the Ethernet module so the multicast MAC is forwarded.
+ *
+ * @param[in]       cpu8MacAddr Pointer to multicast MAC address.
+ *
+ * @ requirements 529199
+ * @ requirements 529251
+*/
+void GPTP_PORT_MulticastForward(const uint8_t *cpu8MacAddr)
+{
+    uint8_t u8CtrlIdx;
+
+    for (u8CtrlIdx = 0u; u8CtrlIdx < ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED; u8CtrlIdx++)
+    {
+        (void)Eth_43_GMAC_UpdatePhysAddrFilter(u8CtrlIdx, cpu8MacAddr,
+                                               ETH_ADD_TO_FILTER);
+    }
+}
+
+#ifdef GPTP_TX_ZERO_COPY
+/*!
+ * @brief           This function provides driver TX buffer for the PTP message.
+ *
+ * @details         This function requests TX buffer from the ENET driver,
+ *                  so the frame builder serializes the frame directly into
+ *                  the descriptor buffer. Eth_43_GMAC provides pointer to
+ *                  the payload and keeps the Ethernet header space in front
+ *                  of it, the header is filled in by Eth_43_GMAC_Transmit.
+ *                  The returned frame pointer therefore points to that
+ *                  header space, whatever the stack writes there is
+ *                  overwritten by the driver.
+ *
+ * @param[in]       u8Port gPTP port on which the PTP message is to be
+ *                  transmitted.
+ * @param[in]       u8FramePrio Eth frame priority.
+ * @param[in]       u16FrameLength Requested frame length including
+ *                  the Ethernet header.
+ * @param[out]      ppu8Frame Pointer to the frame start placeholder.
+ * @param[out]      pu32BufferIndex Pointer to the driver buffer index
+ *                  placeholder.
+ *
+ * @return          Error status,
+ * @retval          GPTP_ERR_OK: The buffer was provided.
+ * @retval          GPTP_ERR_V_NULL_PTR: Empty or invalid input arguments.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: Transmit buffer was not
+ *                  provided by eth driver.
+*/
+gptp_err_type_t GPTP_PORT_MsgBufferGet(uint8_t u8Port,
+                                       uint8_t u8FramePrio,
+                                       uint16_t u16FrameLength,
+                                       uint8_t **ppu8Frame,
+                                       uint32_t *pu32BufferIndex)
+{
+    BufReq_ReturnType     eBufStatus;
+    gptp_err_type_t       eError;
+    Eth_BufIdxType        eBuffIdx;
+    uint8_t               *pu8Buffer;
+    uint16_t              u16BufferLength;
+    uint16_t              u16PTPFramePayloadLength;
+    uint8_t               u8PhyPort;
+
+    pu8Buffer = NULL;
+    eError = GPTP_ERR_OK;
+
+    /* Check input arguments. */
+    if ((NULL != ppu8Frame) && (NULL != pu32BufferIndex) &&
+        (u16FrameLength > GPTP_DEF_ETH_II_LEN))
+    {
+        /* Get real port ID from map table. */
+        u8PhyPort = srPortCtx.rPortMap.prMapTable[u8Port].u8SwitchPort;
+
+        /* Payload length of the gPTP frame (without eth header). */
+        u16PTPFramePayloadLength = (u16FrameLength - GPTP_DEF_ETH_II_LEN);
+        u16BufferLength = u16PTPFramePayloadLength;
+
+        /* Get transmit buffer to build the gPTP frame in. */
+        eBufStatus = Eth_43_GMAC_ProvideTxBuffer(u8PhyPort, u8FramePrio,
+                                                 &eBuffIdx, &pu8Buffer,
+                                                 &u16BufferLength);
+
+        /* The buffer is provided with desired length. */
+        if ((BUFREQ_OK == eBufStatus) &&
+            (NULL != pu8Buffer) &&
+            (u16BufferLength >= u16PTPFramePayloadLength))
+        {
+            /* Frame builder writes the Eth header in front of the payload. */
+            *ppu8Frame = &pu8Buffer[0] - GPTP_DEF_ETH_II_LEN;
+            *pu32BufferIndex = eBuffIdx;
+        }
+        else
+        {
+            /* No Tx buffer. */
+            eError = GPTP_ERR_M_MSG_BUFF_PTR_NULL;
+        }
+    }
+    else
+    {
+        /* Invalid input arguments. */
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function sends PTP message.
+ *
+ * @details         This function hands the PTP message built in the buffer
+ *                  provided by GPTP_PORT_MsgBufferGet over to the ENET driver.
+ *
+ * @param[in]       u8Port gPTP port on which the PTP message is transmitted.
+ * @param[in]       u8FramePrio Eth frame priority.
+ * @param[in]       cprTxData Pointer to the structure containing data to send.
+ * @param[in]       u8FrameId Frame ID of the transmitted message.
+ *
+ * @return          Error status,
+ * @retval          GPTP_ERR_OK: The frame was successfully transmitted.
+ * @retval          GPTP_ERR_V_NULL_PTR: Empty or invalid input arguments.
+ * @retval          GPTP_ERR_F_FRAME_SEND: The frame was not successfully
+ *                  transmitted.
+ *
+ * @ requirements 529199
+ * @ requirements 529256
+*/
+gptp_err_type_t GPTP_PORT_MsgSend(uint8_t u8Port,
+                                  uint8_t u8FramePrio,
+                                  const gptp_def_tx_data_t *cprTxData,
+                                  uint8_t u8FrameId)
+{
+    (void)u8FramePrio;
+
+    Std_ReturnType        eStatus;
+    gptp_err_type_t       eError;
+    Eth_BufIdxType        eBuffIdx;
+    uint8_t               au8DestMac[GPTP_DEF_MAC_ADDR_LEN];
+    uint16_t              u16PTPFramePayloadLength;
+    uint8_t               u8PhyPort;
+
+    eError = GPTP_ERR_OK;
+
+    /* Check input arguments. */
+    if ((NULL != cprTxData) && (NULL != cprTxData->pau8TxBuffPtr) &&
+        (cprTxData->u8FrameLength > GPTP_DEF_ETH_II_LEN))
+    {
+        /* Get real port ID from map table. */
+        u8PhyPort = srPortCtx.rPortMap.prMapTable[u8Port].u8SwitchPort;
+        eBuffIdx = (Eth_BufIdxType)cprTxData->u32BufferIndex;
+
+        /* Payload length calculation of the gPTP frame (without eth header). */
+        u16PTPFramePayloadLength = ((uint16_t)cprTxData->u8FrameLength - GPTP_DEF_ETH_II_LEN);
+
+        /* Destination MAC is taken out of the header space before the driver
+           overwrites it. */
+        for (uint8_t i = 0u; i < GPTP_DEF_MAC_ADDR_LEN; i++)
+        {
+            au8DestMac[i] = cprTxData->pau8TxBuffPtr[i];
+        }
+
+        /* If timestmp for this frame is requested by the gPTP stack. */
+        if (true == cprTxData->bTsRequested)
+        {
+            /* Instruct the Ethernet driver to capture timestamp of egress
+               ethernet frame associated with buffIdx. */
+            Eth_43_GMAC_EnableEgressTimeStamp(u8PhyPort, eBuffIdx);
+
+        }
+
+        /* Store frame metadata before transmission.
+           Timestamp in metadata is inserted in TxConfirmation. */
+        GPTP_PORT_FrameMapStore(cprTxData, u8FrameId, eBuffIdx);
+
+        /* Enable transmission, the payload is already in the buffer. */
+        eStatus = Eth_43_GMAC_Transmit(u8PhyPort, eBuffIdx,
+                                       GPTP_FR_ETH_TYPE_PTP, true,
+                                       u16PTPFramePayloadLength,
+                                       au8DestMac);
+        if ((Std_ReturnType)E_OK != eStatus)
+        {
+            /* Transmission falied. */
+            eError = GPTP_ERR_F_FRAME_SEND;
+        }
+    }
+    else
+    {
+        /* Invalid input arguments. */
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+
+    return eError;
+}
+#else
+/*!
+ * @brief           This function sends PTP message.
+ *
+ * @details         This function sends PTP message using the ENET driver.
+ *
+ * @param[in]       u8Port gPTP port on which the PTP message is transmitted.
+ * @param[in]       u8FramePrio Eth frame priority.
+ * @param[in]       cprTxData Pointer to the structure containing data to send.
+ * @param[in]       u8FrameId Frame ID of the transmitted message.
+ *
+ * @return          Error status,
+ * @retval          GPTP_ERR_OK: The frame was successfully transmitted.
+ * @retval          GPTP_ERR_V_NULL_PTR: Empty or invalid input arguments.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: Transmit buffer was not
+ *                  provided by eth driver.
+ * @retval          GPTP_ERR_F_FRAME_SEND: The frame was not successfully
+ *                  transmitted.
+ *
+ * @ requirements 529199
+ * @ requirements 529256
+*/
+gptp_err_type_t GPTP_PORT_MsgSend(uint8_t u8Port,
+                                  uint8_t u8FramePrio,
+                                  const gptp_def_tx_data_t *cprTxData,
+                                  uint8_t u8FrameId)
+{
+    Std_ReturnType        eStatus;
+    BufReq_ReturnType     eBufStatus;
+    gptp_err_type_t       eError;
+    static Eth_BufIdxType seBuffIdx;
+    static uint8_t        *spu8Buffer;
+    static uint16_t       su16BufferLength;
+    uint16_t              u16PTPFramePayloadLength;
+    uint8_t               u8PhyPort;
+
+    /* Error initial value. */
+    spu8Buffer = NULL;
+    eError = GPTP_ERR_OK;
+
+    /* Check input arguments. */
+    if ((NULL != cprTxData) && (cprTxData->u8FrameLength > GPTP_DEF_ETH_II_LEN))
+    {
+        /* Get real port ID from map table. */
+        u8PhyPort = srPortCtx.rPortMap.prMapTable[u8Port].u8SwitchPort;
+
+        /* Payload length calculation of the gPTP frame (without eth header). */
+        u16PTPFramePayloadLength = ((uint16_t)cprTxData->u8FrameLength - GPTP_DEF_ETH_II_LEN);
+        su16BufferLength = u16PTPFramePayloadLength;
+
+        /* Get transmit buffer to store gPTP frame payload. */
+        eBufStatus = Eth_43_GMAC_ProvideTxBuffer(u8PhyPort, u8FramePrio,
+                                                 &seBuffIdx, &spu8Buffer,
+                                                 &su16BufferLength);
+
+        /* The buffer is provided with desired length. */
+        if ((BUFREQ_OK == eBufStatus) &&
+            (NULL != spu8Buffer) &&
+            (su16BufferLength >= u16PTPFramePayloadLength))
+        {
+            /* Copy only payload of the gPTP generated frame to buffer provided
+               by Eth_43 driver. */
+            for (uint16_t i = 0u; i < u16PTPFramePayloadLength; i++)
+            {
+                spu8Buffer[i] = cprTxData->pau8TxBuffPtr[GPTP_DEF_ETH_II_LEN + i];
+            }
+
+            /* If timestmp for this frame is requested by the gPTP stack. */
+            if (true == cprTxData->bTsRequested)
+            {
+                /* Instruct the Ethernet driver to capture timestamp of egress
+                   ethernet frame associated with buffIdx. */
+                Eth_43_GMAC_EnableEgressTimeStamp(u8PhyPort, seBuffIdx);
+
+            }
+
+            /* Store frame metadata before transmission.
+               Timestamp in metadata is inserted in TxConfirmation. */
+            GPTP_PORT_FrameMapStore(cprTxData, u8FrameId, seBuffIdx);
+
+            /* Enable transmission, destination MAC address is taken from
+               generated PTP frame, which contains full eth header. */
+            eStatus = Eth_43_GMAC_Transmit(u8PhyPort, seBuffIdx,
+                                           GPTP_FR_ETH_TYPE_PTP, true,
+                                           u16PTPFramePayloadLength,
+                                           &cprTxData->pau8TxBuffPtr[0]);
+            if ((Std_ReturnType)E_OK != eStatus)
+            {
+                /* Transmission falied. */
+                eError = GPTP_ERR_F_FRAME_SEND;
+            }
+        }
+        else
+        {
+            /* No Tx buffer. */
+            eError = GPTP_ERR_M_MSG_BUFF_PTR_NULL;
+        }
+    }
+    else
+    {
+        /* Invalid input arguments. */
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+
+    return eError;
+}
+#endif /* GPTP_TX_ZERO_COPY */
+
+
 /*!
  * @brief           This function processes egress timestamp.
  *
@@ -85,6 +638,11 @@ void GPTP_PORT_TxConfirmation(uint8_t u8CtrlIdx,
             {
                 /* Timestamp captured correctly, to be used and passed to
                    the gPTP stack. Eth_43 driver not provides secondsHi. */
+#ifdef GPTP_TRACE_CAPTURE
+                GPTP_TRACE_Tx(GPTP_GetMainStrPtr(), su8GptpPort, u32BufferIndex,
+                              srEgressTimeStamp.seconds,
+                              srEgressTimeStamp.nanoseconds);
+#endif /* GPTP_TRACE_CAPTURE */
                 GPTP_UpdateTimestampEntry(su8GptpPort, u32BufferIndex,
                                           srEgressTimeStamp.seconds,
                                           srEgressTimeStamp.nanoseconds);
@@ -133,7 +691,9 @@ void GPTP_PORT_RxIndication(uint8 u8CtrlIdx,
                             uint16 u16LenByte)
 {
     (void)bIsBroadcast;
+#ifndef GPTP_TRACE_CAPTURE
     (void)u16LenByte;
+#endif /* GPTP_TRACE_CAPTURE */
 
     static Eth_TimeStampQualType seTimeStampQuality;
     static Eth_TimeStampType     srIngressTimeStamp;
@@ -174,6 +734,9 @@ void GPTP_PORT_RxIndication(uint8 u8CtrlIdx,
                         (((uint64_t)cpu8PhysAddr[4]) << 8u)  | \
                         ((uint64_t)cpu8PhysAddr[5]));
         rRxData.u64SourceMac = u64MacAddress;
+#ifdef GPTP_TRACE_CAPTURE
+        GPTP_TRACE_Rx(GPTP_GetMainStrPtr(), &rRxData, (uint16_t)u16LenByte);
+#endif /* GPTP_TRACE_CAPTURE */
         GPTP_MsgReceive(rRxData);
     }
 }
@@ -189,7 +752,12 @@ void GPTP_PORT_RxIndication(uint8 u8CtrlIdx,
 */
 void GPTP_PORT_IncFreeRunningTimer(uint64_t u64Ellapsed)
 {
+#ifdef GPTP_PORT_STM_TIMEBASE
+    (void)u64Ellapsed;
+    GPTP_PORT_StmSample();
+#else
     svu64FreeRunningGptpTimer += u64Ellapsed;
+#endif /* GPTP_PORT_STM_TIMEBASE */
 }
 
 /*!
@@ -202,7 +770,42 @@ void GPTP_PORT_IncFreeRunningTimer(uint64_t u64Ellapsed)
 */
 uint64_t GPTP_PORT_GetFreeRunningTimer(void)
 {
-    return svu64FreeRunningGptpTimer;
+    uint64_t u64Timer;
+
+#ifdef GPTP_PORT_STM_TIMEBASE
+    GPTP_PORT_StmSample();
+    u64Timer = svu64FreeRunningGptpTimer;
+#else
+    /* The increment may preempt the read of the two halves, read again
+       until both reads agree. */
+    do
+    {
+        u64Timer = svu64FreeRunningGptpTimer;
+    } while (u64Timer != svu64FreeRunningGptpTimer);
+#endif /* GPTP_PORT_STM_TIMEBASE */
+
+    return u64Timer;
+}
+
+/*!
+ * @brief           This function starts the DWT cycle counter.
+*/
+void GPTP_PORT_CycleCounterInit(void)
+{
+    GPTP_PORT_DEMCR |= GPTP_PORT_DEMCR_TRCENA;
+    GPTP_PORT_DWT_LAR = GPTP_PORT_DWT_LAR_KEY;
+    GPTP_PORT_DWT_CYCCNT = 0u;
+    GPTP_PORT_DWT_CTRL |= GPTP_PORT_DWT_CTRL_CYCCNTENA;
+}
+
+/*!
+ * @brief           This function returns the DWT cycle counter.
+ *
+ * @return          Core clock cycles.
+*/
+uint32_t GPTP_PORT_CycleCounterGet(void)
+{
+    return GPTP_PORT_DWT_CYCCNT;
 }
 
 /*******************************************************************************
@@ -27,7 +27,25 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
-/* None */
+
+#ifdef GPTP_PORT_STM_TIMEBASE
+#ifndef GPTP_PORT_STM_INSTANCE
+/*! STM instance used as the FreeRunning time base. */
+#define GPTP_PORT_STM_INSTANCE          (0u)
+#endif /* GPTP_PORT_STM_INSTANCE */
+#ifndef GPTP_PORT_STM_FREQ_HZ
+/*! Frequency of the STM counter in Hz (AIPS_PLAT_CLK, no prescaler). */
+#define GPTP_PORT_STM_FREQ_HZ           (80000000u)
+#endif /* GPTP_PORT_STM_FREQ_HZ */
+#endif /* GPTP_PORT_STM_TIMEBASE */
+#ifndef GPTP_PORT_CYCLE_FREQ_HZ
+/*! Frequency of the DWT cycle counter in Hz (CORE_CLK). */
+#define GPTP_PORT_CYCLE_FREQ_HZ         (160000000u)
+#endif /* GPTP_PORT_CYCLE_FREQ_HZ */
+/*! Number of the controllers served by the port layer. */
+#define GPTP_PORT_CTRL_MAX              ETH_43_GMAC_MAX_CTRLIDX_SUPPORTED
+
+#include "gptp_port_hw.h"
 
 /*******************************************************************************
  * Data Types
@@ -89,10 +107,25 @@ void GPTP_PORT_RxIndication(uint8 u8CtrlIdx,
                             const Eth_DataType *cpu8Data,
                             uint16 u16LenByte);
 
+#ifdef GPTP_PORT_STM_TIMEBASE
+/*!
+ * @brief           This function starts the STM counter used as
+ *                  the FreeRunning time base.
+ *
+ * @details         Must be called before GPTP_GptpInit. The STM driver has
+ *                  to be enabled in the configuration (STM_IP_USED).
+*/
+void GPTP_PORT_StmTimebaseInit(void);
+#endif /* GPTP_PORT_STM_TIMEBASE */
+
 /*!
 * @brief            This function increments the internal FreeRunning timer
 *                   value.
 *
+* @details          With GPTP_PORT_STM_TIMEBASE defined, the argument is not
+*                   used and the call only samples the STM counter. It has to
+*                   be called at least once per STM counter wrap period.
+*
 * @param[in]        u64Ellapsed Ellapsed time from previous call.
 */
 void GPTP_PORT_IncFreeRunningTimer(uint64_t u64Ellapsed);
@@ -100,10 +133,34 @@ void GPTP_PORT_IncFreeRunningTimer(uint64_t u64Ellapsed);
 /*!
  * @brief           This function returns the internal FreeRunning timer value.
  *
+ * @details         With GPTP_PORT_STM_TIMEBASE defined, the value is derived
+ *                  from the STM counter extended to 64 bits. Not reentrant,
+ *                  call it from a single context only. Otherwise it is safe
+ *                  to call from a context preempted by
+ *                  GPTP_PORT_IncFreeRunningTimer.
+ *
  * @return          FreeRunning timer current value - uint64_t.
 */
 uint64_t GPTP_PORT_GetFreeRunningTimer(void);
 
+/*!
+ * @brief           This function starts the DWT cycle counter.
+ *
+ * @details         The counter is used for the execution time measurements
+ *                  only, not for the gPTP time.
+*/
+void GPTP_PORT_CycleCounterInit(void);
+
+/*!
+ * @brief           This function returns the DWT cycle counter.
+ *
+ * @details         The counter wraps, only differences of two readings less
+ *                  than one wrap period apart are meaningful.
+ *
+ * @return          Core clock cycles, GPTP_PORT_CYCLE_FREQ_HZ per second.
+*/
+uint32_t GPTP_PORT_CycleCounterGet(void);
+
 /*******************************************************************************
  * Guard End
  ******************************************************************************/
@@ -0,0 +1,1105 @@
+/*
+ * Copyright 2023-2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_port_platform.c
+ *
+ * @details Simulated platform for running the unchanged gPTP core on a Linux
+ *          host. The Eth_43_GMAC driver is replaced by a virtual nanosecond
+ *          clock and in-memory frame queues, the Fee driver by an in-memory
+ *          NVM. The time advances only by GPTP_PORT_IncFreeRunningTimer, so
+ *          every run is repeatable.
+ *
+ *          All the simulated state belongs to a node, see gptp_port_sim_node_t.
+ *          Single instance applications use the default node, several stack
+ *          instances (GPTP_GptpInitInst) in one process each use their own.
+ *
+ *          Build together with the core sources, this directory must precede
+ *          the generic port directory in the include path:
+ *
+ *          gcc -std=c99 -Igptp_stack/port/linux -Igptp_stack/port
+ *              -Igptp_stack/gptp_core/include gptp_stack/gptp_core/src/(*).c
+ *              gptp_stack/port/common/gptp_port.c gptp_stack/port/linux/(*).c
+ *              <application>.c
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+/* clock_gettime of the cycle counter. */
+#define _POSIX_C_SOURCE 199309L
+
+#include <time.h>
+#include "gptp_port_platform.h"
+#include "gptp_port.h"
+#include "gptp_trace.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Source MAC address offset in the Ethernet header. */
+#define GPTP_PORT_SIM_SRC_MAC_OFST      (6u)
+/*! Ethertype offset in the Ethernet header. */
+#define GPTP_PORT_SIM_ETH_TYPE_OFST     (12u)
+/*! Length of the MAC address. */
+#define GPTP_PORT_SIM_MAC_LEN           (6u)
+/*! Default MAC address base, locally administered. */
+#define GPTP_PORT_SIM_MAC_BASE          (0x020000000000u)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static int64_t GPTP_PORT_SimPtpNs(const gptp_port_sim_node_t *cprNode);
+static void GPTP_PORT_SimClockRebase(gptp_port_sim_node_t *prNode);
+static gptp_def_timestamp_t GPTP_PORT_SimNsToTs(int64_t s64Ns);
+static gptp_port_sim_frame_t *GPTP_PORT_SimQueueTail(gptp_port_sim_queue_t *prQueue);
+static bool GPTP_PORT_SimQueuePop(gptp_port_sim_queue_t *prQueue,
+                                  gptp_port_sim_frame_t *prFrame);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Node of the single instance applications. */
+static gptp_port_sim_node_t     srSimNodeDefault;
+/* Node the simulator API acts on. */
+static gptp_port_sim_node_t     *sprSimNode = &srSimNodeDefault;
+
+/*******************************************************************************
+ * Local Functions
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns the simulated PTP clock in ns.
+ *
+ * @details         The PTP clock runs at (1 + drift) / (1 + adjustment) of
+ *                  the FreeRunning timer, same as the GMAC timer addend.
+ *
+ * @param[in]       cprNode Pointer to the node.
+ *
+ * @return          Current simulated PTP time in nanoseconds.
+*/
+static int64_t GPTP_PORT_SimPtpNs(const gptp_port_sim_node_t *cprNode)
+{
+    uint64_t  u64Elapsed;
+    float64_t f64Rate;
+
+    u64Elapsed = cprNode->u64FreeRunNs - cprNode->rClock.u64RefFreeRunNs;
+    f64Rate = (1.0 + ((float64_t)cprNode->rClock.s32DriftPpb / (float64_t)GPTP_DEF_NS_IN_SECONDS)) /
+              (1.0 + ((float64_t)cprNode->rClock.s32AdjustmentPpb / (float64_t)GPTP_DEF_NS_IN_SECONDS));
+
+    return cprNode->rClock.s64RefPtpNs + (int64_t)((float64_t)u64Elapsed * f64Rate);
+}
+
+/*!
+ * @brief           This function moves the clock reference to the current time.
+ *
+ * @details         Must be called before the clock rate is changed, so that
+ *                  the time elapsed so far is accounted with the old rate.
+ *
+ * @param[in,out]   prNode Pointer to the node.
+*/
+static void GPTP_PORT_SimClockRebase(gptp_port_sim_node_t *prNode)
+{
+    prNode->rClock.s64RefPtpNs = GPTP_PORT_SimPtpNs(prNode);
+    prNode->rClock.u64RefFreeRunNs = prNode->u64FreeRunNs;
+}
+
+/*!
+ * @brief           This function converts nanoseconds to the timestamp.
+ *
+ * @param[in]       s64Ns Time in nanoseconds, negative values are saturated.
+ *
+ * @return          gptp_def_timestamp_t representation.
+*/
+static gptp_def_timestamp_t GPTP_PORT_SimNsToTs(int64_t s64Ns)
+{
+    gptp_def_timestamp_t rTs;
+    uint64_t             u64Ns;
+
+    u64Ns = (0 > s64Ns) ? 0u : (uint64_t)s64Ns;
+    rTs.u64TimeStampS = u64Ns / (uint64_t)GPTP_DEF_NS_IN_SECONDS;
+    rTs.u32TimeStampNs = (uint32_t)(u64Ns % (uint64_t)GPTP_DEF_NS_IN_SECONDS);
+
+    return rTs;
+}
+
+/*!
+ * @brief           This function reserves a new entry at the queue tail.
+ *
+ * @param[in]       prQueue Pointer to the queue.
+ *
+ * @return          Pointer to the reserved entry or NULL if the queue is full.
+*/
+static gptp_port_sim_frame_t *GPTP_PORT_SimQueueTail(gptp_port_sim_queue_t *prQueue)
+{
+    gptp_port_sim_frame_t *prFrame;
+
+    prFrame = NULL;
+
+    if (prQueue->u8Count < GPTP_PORT_SIM_QUEUE_LEN)
+    {
+        prFrame = &prQueue->arFrames[(prQueue->u8Head + prQueue->u8Count) % GPTP_PORT_SIM_QUEUE_LEN];
+        prQueue->u8Count++;
+    }
+
+    return prFrame;
+}
+
+/*!
+ * @brief           This function removes the oldest entry from the queue.
+ *
+ * @param[in]       prQueue Pointer to the queue.
+ * @param[out]      prFrame Pointer to the frame placeholder.
+ *
+ * @return          true in case a frame was available.
+*/
+static bool GPTP_PORT_SimQueuePop(gptp_port_sim_queue_t *prQueue,
+                                  gptp_port_sim_frame_t *prFrame)
+{
+    bool bPopped;
+
+    bPopped = false;
+
+    if ((0u != prQueue->u8Count) && (NULL != prFrame))
+    {
+        *prFrame = prQueue->arFrames[prQueue->u8Head];
+        prQueue->u8Head = (uint8_t)((prQueue->u8Head + 1u) % GPTP_PORT_SIM_QUEUE_LEN);
+        prQueue->u8Count--;
+        bPopped = true;
+    }
+
+    return bPopped;
+}
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function selects the simulated node.
+ *
+ * @param[in]       prNode Pointer to the node, NULL for the default node.
+ *
+ * @return          Previously selected node.
+*/
+gptp_port_sim_node_t *GPTP_PORT_SimNodeSelect(gptp_port_sim_node_t *prNode)
+{
+    gptp_port_sim_node_t *prPrevious;
+
+    prPrevious = sprSimNode;
+    sprSimNode = (NULL == prNode) ? &srSimNodeDefault : prNode;
+
+    return prPrevious;
+}
+
+/*!
+ * @brief           This function returns the simulated node in use.
+ *
+ * @details         The stack instance being processed determines the node,
+ *                  the selected node is used outside the stack calls and for
+ *                  the instances initialized without the node.
+ *
+ * @return          Pointer to the node.
+*/
+gptp_port_sim_node_t *GPTP_PORT_SimNodeGet(void)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = (gptp_port_sim_node_t *)GPTP_GetMainStrPtr()->pvPortCtx;
+    if (NULL == prNode)
+    {
+        prNode = sprSimNode;
+    }
+
+    return prNode;
+}
+
+/*!
+ * @brief           This function processes egress timestamp.
+ *
+ * @details         This function processes captured egress timestamp.
+ *                  Called from GPTP_PORT_SimPoll for every confirmed frame.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller which transmitted
+ *                  the frame.
+ * @param[in]       u32BufferIndex Index of the transmitted data buffer.
+ * @param[in]       crEgressTs Captured egress timestamp.
+*/
+void GPTP_PORT_TxConfirmation(uint8_t u8CtrlIdx,
+                              uint32_t u32BufferIndex,
+                              const gptp_def_timestamp_t crEgressTs)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8GptpPort;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    /* Get gPTP port ID from map table. */
+    if (GPTP_ERR_OK == GPTP_PORT_PortLookup(&u8GptpPort, u8CtrlIdx, 0u))
+    {
+#ifdef GPTP_TRACE_CAPTURE
+        GPTP_TRACE_Tx(prNode->rPortCtx.prGptp, u8GptpPort, u32BufferIndex,
+                      (uint32_t)crEgressTs.u64TimeStampS,
+                      crEgressTs.u32TimeStampNs);
+#endif /* GPTP_TRACE_CAPTURE */
+        /* Eth_43 driver does not provide secondsHi, keep the same width. */
+        GPTP_UpdateTimestampEntryInst(prNode->rPortCtx.prGptp, u8GptpPort, u32BufferIndex,
+                                      (uint32_t)crEgressTs.u64TimeStampS,
+                                      crEgressTs.u32TimeStampNs);
+    }
+}
+
+/*!
+ * @brief           This function processes the timestamp of a received frames.
+ *
+ * @details         This function passes the received frame together with its
+ *                  ingress timestamp to the gPTP stack.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller which received the frame.
+ * @param[in]       u16FrameType The received frame Ethertype
+ *                  (from the frame header).
+ * @param[in]       cpu8PhysAddr Pointer to received frame source MAC address
+ *                  (6 bytes).
+ * @param[in]       cpu8Data Data buffer containing the received Ethernet frame
+ *                  payload.
+ * @param[in]       u16LenByte Length of the data in the buffer cpu8Data.
+ * @param[in]       crIngressTs Captured ingress timestamp.
+*/
+void GPTP_PORT_RxIndication(uint8_t u8CtrlIdx,
+                            uint16_t u16FrameType,
+                            const uint8_t *cpu8PhysAddr,
+                            const uint8_t *cpu8Data,
+                            uint16_t u16LenByte,
+                            const gptp_def_timestamp_t crIngressTs)
+{
+    gptp_port_sim_node_t *prNode;
+    gptp_def_rx_data_t   rRxData;
+    uint8_t              u8GptpPort;
+    uint64_t             u64MacAddress;
+    uint8_t              u8Byte;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    rRxData.cpu8RxData = cpu8Data;
+    rRxData.u16EthType = u16FrameType;
+    rRxData.u32TsSec = (uint32_t)crIngressTs.u64TimeStampS;
+    rRxData.u32TsNsec = crIngressTs.u32TimeStampNs;
+
+    /* Get gPTP port ID from map table. */
+    if (GPTP_ERR_OK == GPTP_PORT_PortLookup(&u8GptpPort, u8CtrlIdx, 0u))
+    {
+        u64MacAddress = 0u;
+        for (u8Byte = 0u; u8Byte < GPTP_PORT_SIM_MAC_LEN; u8Byte++)
+        {
+            u64MacAddress = (u64MacAddress << 8u) | (uint64_t)cpu8PhysAddr[u8Byte];
+        }
+
+        rRxData.u8PtpPort = u8GptpPort;
+        rRxData.u64SourceMac = u64MacAddress;
+#ifdef GPTP_TRACE_CAPTURE
+        GPTP_TRACE_Rx(prNode->rPortCtx.prGptp, &rRxData, u16LenByte);
+#else
+        (void)u16LenByte;
+#endif /* GPTP_TRACE_CAPTURE */
+        GPTP_MsgReceiveInst(prNode->rPortCtx.prGptp, rRxData);
+    }
+}
+
+/*!
+ * @brief           This function increments the internal FreeRunning timer
+ *                  value.
+ *
+ * @param[in]       u64Ellapsed Ellapsed time from previous call.
+*/
+void GPTP_PORT_IncFreeRunningTimer(uint64_t u64Ellapsed)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    prNode->u64FreeRunNs += u64Ellapsed;
+}
+
+/*!
+ * @brief           This function returns the internal FreeRunning timer value.
+ *
+ * @return          FreeRunning timer current value - uint64_t.
+*/
+uint64_t GPTP_PORT_GetFreeRunningTimer(void)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    return prNode->u64FreeRunNs;
+}
+
+/*!
+ * @brief           This function starts the cycle counter.
+ *
+ * @details         The host monotonic clock always runs.
+*/
+void GPTP_PORT_CycleCounterInit(void)
+{
+}
+
+/*!
+ * @brief           This function returns the cycle counter.
+ *
+ * @return          Host monotonic clock [ns].
+*/
+uint32_t GPTP_PORT_CycleCounterGet(void)
+{
+    struct timespec rNow;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &rNow);
+
+    return (uint32_t)(((uint64_t)rNow.tv_sec * (uint64_t)GPTP_DEF_NS_IN_SECONDS) + (uint64_t)rNow.tv_nsec);
+}
+
+/*!
+ * @brief           This function returns the port layer data of the stack
+ *                  instance in use.
+ *
+ * @return          Pointer to the port layer data of the node in use.
+*/
+gptp_port_ctx_t *GPTP_PORT_CtxGet(void)
+{
+    return &GPTP_PORT_SimNodeGet()->rPortCtx;
+}
+
+/*!
+ * @brief           This function reads the link state of the controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[out]      pbUp Pointer to the link state placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The link state was read.
+*/
+gptp_err_type_t GPTP_PORT_HwLinkGet(uint8_t u8CtrlIdx,
+                                    bool *pbUp)
+{
+    *pbUp = GPTP_PORT_SimLinkGet(u8CtrlIdx);
+
+    return GPTP_ERR_OK;
+}
+
+/*!
+ * @brief           This function reads the MAC address of the controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[out]      pu8Mac Pointer to the MAC address placeholder.
+*/
+void GPTP_PORT_HwMacGet(uint8_t u8CtrlIdx,
+                        uint8_t *pu8Mac)
+{
+    GPTP_PORT_SimMacGet(u8CtrlIdx, pu8Mac);
+}
+
+/*!
+ * @brief           This function reads the PTP (corrected) clock.
+ *
+ * @param[out]      prTime Pointer to the time placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The simulated clock was read.
+*/
+gptp_err_type_t GPTP_PORT_HwClockGet(gptp_def_timestamp_t *prTime)
+{
+    *prTime = GPTP_PORT_SimClockGet();
+
+    return GPTP_ERR_OK;
+}
+
+/*!
+ * @brief           This function corrects the PTP (corrected) clock.
+ *
+ * @param[in]       s64StepNs Time step applied to the clock [ns].
+ * @param[in]       s32AdjustmentPpb Frequency adjustment of the clock
+ *                  relative to its oscillator [ppb].
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The simulated clock was corrected.
+*/
+gptp_err_type_t GPTP_PORT_HwClockCorrect(int64_t s64StepNs,
+                                         int32_t s32AdjustmentPpb)
+{
+    GPTP_PORT_SimClockCorrect(s64StepNs, s32AdjustmentPpb);
+
+    return GPTP_ERR_OK;
+}
+
+/*!
+ * @brief           This function registers multicast MAC.
+ *
+ * @details         This function provides interface to register MAC in
+ *                  the Ethernet module so the multicast MAC is forwarded.
+ *                  The simulated controller accepts all frames, so there is
+ *                  no filter to update.
+ *
+ * @param[in]       cpu8MacAddr Pointer to multicast MAC address.
+ *
+ * @ requirements 529199
+ * @ requirements 529251
+*/
+void GPTP_PORT_MulticastForward(const uint8_t *cpu8MacAddr)
+{
+    (void)cpu8MacAddr;
+}
+
+#ifdef GPTP_TX_ZERO_COPY
+/*!
+ * @brief           This function provides TX buffer for the PTP message.
+ *
+ * @details         The simulated controller owns one descriptor buffer per
+ *                  controller, the frame is built there including
+ *                  the Ethernet header.
+ *
+ * @param[in]       u8Port gPTP port on which the PTP message is to be
+ *                  transmitted.
+ * @param[in]       u8FramePrio Eth frame priority.
+ * @param[in]       u16FrameLength Requested frame length including
+ *                  the Ethernet header.
+ * @param[out]      ppu8Frame Pointer to the frame start placeholder.
+ * @param[out]      pu32BufferIndex Pointer to the buffer index placeholder.
+ *
+ * @return          Error status,
+ * @retval          GPTP_ERR_OK: The buffer was provided.
+ * @retval          GPTP_ERR_V_NULL_PTR: Empty or invalid input arguments.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: The frame does not fit
+ *                  the simulated buffer.
+*/
+gptp_err_type_t GPTP_PORT_MsgBufferGet(uint8_t u8Port,
+                                       uint8_t u8FramePrio,
+                                       uint16_t u16FrameLength,
+                                       uint8_t **ppu8Frame,
+                                       uint32_t *pu32BufferIndex)
+{
+    (void)u8FramePrio;
+
+    gptp_port_sim_node_t *prNode;
+    gptp_err_type_t      eError;
+    uint8_t              u8PhyPort;
+
+    prNode = GPTP_PORT_SimNodeGet();
+    eError = GPTP_ERR_OK;
+
+    /* Check input arguments. */
+    if ((NULL != ppu8Frame) && (NULL != pu32BufferIndex) &&
+        (u16FrameLength > GPTP_DEF_ETH_II_LEN))
+    {
+        /* Get real port ID from map table. */
+        u8PhyPort = prNode->rPortCtx.rPortMap.prMapTable[u8Port].u8SwitchPort;
+
+        if ((u8PhyPort < GPTP_PORT_SIM_CTRL_MAX) &&
+            (u16FrameLength <= GPTP_PORT_SIM_FRAME_LEN_MAX))
+        {
+            *ppu8Frame = prNode->au8TxBuffer[u8PhyPort];
+            *pu32BufferIndex = u8PhyPort;
+        }
+        else
+        {
+            /* No Tx buffer. */
+            eError = GPTP_ERR_M_MSG_BUFF_PTR_NULL;
+        }
+    }
+    else
+    {
+        /* Invalid input arguments. */
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+
+    return eError;
+}
+
+#endif /* GPTP_TX_ZERO_COPY */
+
+/*!
+ * @brief           This function sends PTP message.
+ *
+ * @details         This function sends PTP message using the simulated
+ *                  controller.
+ *
+ * @param[in]       u8Port gPTP port on which the PTP message is transmitted.
+ * @param[in]       u8FramePrio Eth frame priority.
+ * @param[in]       cprTxData Pointer to the structure containing data to send.
+ * @param[in]       u8FrameId Frame ID of the transmitted message.
+ *
+ * @return          Error status,
+ * @retval          GPTP_ERR_OK: The frame was successfully transmitted.
+ * @retval          GPTP_ERR_V_NULL_PTR: Empty or invalid input arguments.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: Transmit queue of
+ *                  the simulated controller is full.
+ *
+ * @ requirements 529199
+ * @ requirements 529256
+*/
+gptp_err_type_t GPTP_PORT_MsgSend(uint8_t u8Port,
+                                  uint8_t u8FramePrio,
+                                  const gptp_def_tx_data_t *cprTxData,
+                                  uint8_t u8FrameId)
+{
+    (void)u8FramePrio;
+
+    gptp_port_sim_node_t *prNode;
+    gptp_err_type_t      eError;
+    uint32_t             u32BuffIdx;
+    uint8_t              u8PhyPort;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    /* Check input arguments. */
+    if ((NULL != cprTxData) && (cprTxData->u8FrameLength > GPTP_DEF_ETH_II_LEN))
+    {
+        /* Get real port ID from map table. */
+        u8PhyPort = prNode->rPortCtx.rPortMap.prMapTable[u8Port].u8SwitchPort;
+
+        /* Simulated controller keeps the whole frame including
+           the Ethernet header generated by the stack. */
+        eError = GPTP_PORT_SimTxEnqueue(u8PhyPort, cprTxData->pau8TxBuffPtr,
+                                        (uint16_t)cprTxData->u8FrameLength,
+                                        cprTxData->bTsRequested, &u32BuffIdx);
+
+        /* Store frame metadata before transmission confirmation.
+           Timestamp in metadata is inserted in TxConfirmation. */
+        if (GPTP_ERR_OK == eError)
+        {
+            GPTP_PORT_FrameMapStore(cprTxData, u8FrameId, u32BuffIdx);
+        }
+    }
+    else
+    {
+        /* Invalid input arguments. */
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function resets the simulated platform.
+ *
+ * @details         Clears the virtual clocks, frame queues, link states and
+ *                  the in-memory NVM of the node in use. Must be called
+ *                  before GPTP_GptpInit.
+*/
+void GPTP_PORT_SimInit(void)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8Ctrl;
+    uint8_t u8Type;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    prNode->u64FreeRunNs = 0u;
+    prNode->rClock.u64RefFreeRunNs = 0u;
+    prNode->rClock.s64RefPtpNs = 0;
+    prNode->rClock.s32DriftPpb = 0;
+    prNode->rClock.s32AdjustmentPpb = 0;
+
+    prNode->rTxQueue.u8Head = 0u;
+    prNode->rTxQueue.u8Count = 0u;
+    prNode->rRxQueue.u8Head = 0u;
+    prNode->rRxQueue.u8Count = 0u;
+    prNode->u8ConfirmHead = 0u;
+    prNode->u8ConfirmCount = 0u;
+    prNode->u32NextBufferIndex = 0u;
+
+    for (u8Ctrl = 0u; u8Ctrl < GPTP_PORT_SIM_CTRL_MAX; u8Ctrl++)
+    {
+        prNode->abLinkUp[u8Ctrl] = true;
+        prNode->au64Mac[u8Ctrl] = GPTP_PORT_SIM_MAC_BASE + (uint64_t)u8Ctrl + 1u;
+
+        for (u8Type = 0u; u8Type < GPTP_PORT_SIM_NVM_TYPES; u8Type++)
+        {
+            prNode->af64Nvm[u8Ctrl][u8Type] = 0.0;
+            prNode->abNvmReadPending[u8Ctrl][u8Type] = false;
+        }
+    }
+}
+
+/*!
+ * @brief           This function sets frequency error of the local oscillator.
+ *
+ * @param[in]       s32DriftPpb Oscillator error in parts per billion. Positive
+ *                  value makes the simulated PTP clock run faster.
+*/
+void GPTP_PORT_SimClockDriftSet(int32_t s32DriftPpb)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    GPTP_PORT_SimClockRebase(prNode);
+    prNode->rClock.s32DriftPpb = s32DriftPpb;
+}
+
+/*!
+ * @brief           This function returns the simulated PTP clock.
+ *
+ * @return          Current value of the simulated (corrected) PTP clock.
+*/
+gptp_def_timestamp_t GPTP_PORT_SimClockGet(void)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    return GPTP_PORT_SimNsToTs(GPTP_PORT_SimPtpNs(prNode));
+}
+
+/*!
+ * @brief           This function applies time and frequency correction to
+ *                  the simulated PTP clock.
+ *
+ * @param[in]       s64OffsetNs Signed time step in nanoseconds.
+ * @param[in]       s32AdjustmentPpb Frequency adjustment in parts per billion.
+*/
+void GPTP_PORT_SimClockCorrect(int64_t s64OffsetNs,
+                               int32_t s32AdjustmentPpb)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    GPTP_PORT_SimClockRebase(prNode);
+    prNode->rClock.s64RefPtpNs += s64OffsetNs;
+    prNode->rClock.s32AdjustmentPpb = s32AdjustmentPpb;
+}
+
+/*!
+ * @brief           This function sets link state of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[in]       bLinkUp Link state.
+*/
+void GPTP_PORT_SimLinkSet(uint8_t u8CtrlIdx,
+                          bool bLinkUp)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    if (u8CtrlIdx < GPTP_PORT_SIM_CTRL_MAX)
+    {
+        prNode->abLinkUp[u8CtrlIdx] = bLinkUp;
+    }
+}
+
+/*!
+ * @brief           This function reads link state of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ *
+ * @return          Link state, false for the unknown controller.
+*/
+bool GPTP_PORT_SimLinkGet(uint8_t u8CtrlIdx)
+{
+    gptp_port_sim_node_t *prNode;
+    bool bLinkUp;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    bLinkUp = false;
+
+    if (u8CtrlIdx < GPTP_PORT_SIM_CTRL_MAX)
+    {
+        bLinkUp = prNode->abLinkUp[u8CtrlIdx];
+    }
+
+    return bLinkUp;
+}
+
+/*!
+ * @brief           This function sets MAC address of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[in]       u64Mac MAC address stored in the lower 48 bits.
+*/
+void GPTP_PORT_SimMacSet(uint8_t u8CtrlIdx,
+                         uint64_t u64Mac)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    if (u8CtrlIdx < GPTP_PORT_SIM_CTRL_MAX)
+    {
+        prNode->au64Mac[u8CtrlIdx] = u64Mac & GPTP_DEF_BIT_MASK_16L_48H;
+    }
+}
+
+/*!
+ * @brief           This function reads MAC address of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[out]      pu8Mac Pointer to the 6 bytes long MAC address buffer.
+*/
+void GPTP_PORT_SimMacGet(uint8_t u8CtrlIdx,
+                         uint8_t *pu8Mac)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8Byte;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    if ((u8CtrlIdx < GPTP_PORT_SIM_CTRL_MAX) && (NULL != pu8Mac))
+    {
+        /* Network byte order, same as Eth_43_GMAC_GetPhysAddr. */
+        for (u8Byte = 0u; u8Byte < GPTP_PORT_SIM_MAC_LEN; u8Byte++)
+        {
+            pu8Mac[u8Byte] = (uint8_t)(prNode->au64Mac[u8CtrlIdx] >> (8u * ((GPTP_PORT_SIM_MAC_LEN - 1u) - u8Byte)));
+        }
+    }
+}
+
+/*!
+ * @brief           This function enqueues frame for transmission.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[in]       cpu8Frame Full Ethernet frame.
+ * @param[in]       u16Length Frame length.
+ * @param[in]       bTsRequested Egress timestamp is requested.
+ * @param[out]      pu32BufferIndex Assigned buffer index.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The frame was enqueued.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: No free buffer.
+*/
+gptp_err_type_t GPTP_PORT_SimTxEnqueue(uint8_t u8CtrlIdx,
+                                       const uint8_t *cpu8Frame,
+                                       uint16_t u16Length,
+                                       bool bTsRequested,
+                                       uint32_t *pu32BufferIndex)
+{
+    gptp_port_sim_node_t    *prNode;
+    gptp_err_type_t         eError;
+    gptp_port_sim_frame_t   *prFrame;
+    gptp_port_sim_confirm_t *prConfirm;
+    uint16_t                u16Byte;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    eError = GPTP_ERR_M_MSG_BUFF_PTR_NULL;
+
+    if ((u16Length <= GPTP_PORT_SIM_FRAME_LEN_MAX) &&
+        (prNode->u8ConfirmCount < GPTP_PORT_SIM_QUEUE_LEN))
+    {
+        prFrame = GPTP_PORT_SimQueueTail(&prNode->rTxQueue);
+        if (NULL != prFrame)
+        {
+            prFrame->u8CtrlIdx = u8CtrlIdx;
+            prFrame->u32BufferIndex = prNode->u32NextBufferIndex;
+            prFrame->u16Length = u16Length;
+            prFrame->rTimeStamp = GPTP_PORT_SimClockGet();
+            for (u16Byte = 0u; u16Byte < u16Length; u16Byte++)
+            {
+                prFrame->au8Data[u16Byte] = cpu8Frame[u16Byte];
+            }
+
+            /* Egress timestamp is captured at once, the confirmation is
+               delivered by the next poll as with the real driver. */
+            if (true == bTsRequested)
+            {
+                prConfirm = &prNode->arConfirm[(prNode->u8ConfirmHead + prNode->u8ConfirmCount) % GPTP_PORT_SIM_QUEUE_LEN];
+                prConfirm->u8CtrlIdx = u8CtrlIdx;
+                prConfirm->u32BufferIndex = prNode->u32NextBufferIndex;
+                prConfirm->rEgressTs = prFrame->rTimeStamp;
+                prNode->u8ConfirmCount++;
+            }
+
+            *pu32BufferIndex = prNode->u32NextBufferIndex;
+
+            /* Skip the value reserved for closed map entries. */
+            prNode->u32NextBufferIndex++;
+            if (GPTP_DEF_BUFF_INDEX_CLOSED == prNode->u32NextBufferIndex)
+            {
+                prNode->u32NextBufferIndex = 0u;
+            }
+
+            eError = GPTP_ERR_OK;
+        }
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function takes the oldest transmitted frame from
+ *                  the simulated wire.
+ *
+ * @param[out]      prFrame Pointer to the frame placeholder.
+ *
+ * @return          true in case a frame was available.
+*/
+bool GPTP_PORT_SimTxPop(gptp_port_sim_frame_t *prFrame)
+{
+    gptp_port_sim_node_t *prNode;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    return GPTP_PORT_SimQueuePop(&prNode->rTxQueue, prFrame);
+}
+
+/*!
+ * @brief           This function takes the oldest pending TX confirmation
+ *                  without passing it to the stack.
+ *
+ * @param[out]      prConfirm Pointer to the confirmation placeholder.
+ *
+ * @return          true in case a confirmation was pending.
+*/
+bool GPTP_PORT_SimConfirmPop(gptp_port_sim_confirm_t *prConfirm)
+{
+    gptp_port_sim_node_t *prNode;
+    bool                 bPopped;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    bPopped = false;
+    if (0u != prNode->u8ConfirmCount)
+    {
+        *prConfirm = prNode->arConfirm[prNode->u8ConfirmHead];
+        prNode->u8ConfirmHead = (uint8_t)((prNode->u8ConfirmHead + 1u) % GPTP_PORT_SIM_QUEUE_LEN);
+        prNode->u8ConfirmCount--;
+        bPopped = true;
+    }
+
+    return bPopped;
+}
+
+/*!
+ * @brief           This function puts a frame to the receive queue of
+ *                  the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the receiving controller.
+ * @param[in]       cpu8Frame Full Ethernet frame.
+ * @param[in]       u16Length Frame length.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The frame was enqueued.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: Receive queue is full.
+*/
+gptp_err_type_t GPTP_PORT_SimRxPush(uint8_t u8CtrlIdx,
+                                    const uint8_t *cpu8Frame,
+                                    uint16_t u16Length)
+{
+    gptp_port_sim_node_t  *prNode;
+    gptp_err_type_t       eError;
+    gptp_port_sim_frame_t *prFrame;
+    uint16_t              u16Byte;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    if ((NULL == cpu8Frame) || (u16Length <= GPTP_DEF_ETH_II_LEN) ||
+        (u16Length > GPTP_PORT_SIM_FRAME_LEN_MAX))
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else
+    {
+        prFrame = GPTP_PORT_SimQueueTail(&prNode->rRxQueue);
+        if (NULL != prFrame)
+        {
+            prFrame->u8CtrlIdx = u8CtrlIdx;
+            prFrame->u32BufferIndex = GPTP_DEF_BUFF_INDEX_CLOSED;
+            prFrame->u16Length = u16Length;
+            prFrame->rTimeStamp = GPTP_PORT_SimClockGet();
+            for (u16Byte = 0u; u16Byte < u16Length; u16Byte++)
+            {
+                prFrame->au8Data[u16Byte] = cpu8Frame[u16Byte];
+            }
+            eError = GPTP_ERR_OK;
+        }
+        else
+        {
+            eError = GPTP_ERR_M_MSG_BUFF_PTR_NULL;
+        }
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function polls the simulated controllers.
+ *
+ * @details         Counterpart of Eth_43_GMAC_Receive and
+ *                  Eth_43_GMAC_TxConfirmation. Delivers queued frames and
+ *                  egress timestamps to the stack.
+*/
+void GPTP_PORT_SimPoll(void)
+{
+    gptp_port_sim_node_t         *prNode;
+    gptp_port_sim_frame_t        rRxFrame;
+    gptp_port_sim_confirm_t      rConfirm;
+    uint16_t                     u16FrameType;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    /* Receive path. */
+    while (true == GPTP_PORT_SimQueuePop(&prNode->rRxQueue, &rRxFrame))
+    {
+        if (true == GPTP_PORT_SimLinkGet(rRxFrame.u8CtrlIdx))
+        {
+            u16FrameType = (uint16_t)(((uint16_t)rRxFrame.au8Data[GPTP_PORT_SIM_ETH_TYPE_OFST] << 8u) |
+                                      (uint16_t)rRxFrame.au8Data[GPTP_PORT_SIM_ETH_TYPE_OFST + 1u]);
+
+            GPTP_PORT_RxIndication(rRxFrame.u8CtrlIdx, u16FrameType,
+                                   &rRxFrame.au8Data[GPTP_PORT_SIM_SRC_MAC_OFST],
+                                   &rRxFrame.au8Data[GPTP_DEF_ETH_II_LEN],
+                                   (uint16_t)(rRxFrame.u16Length - GPTP_DEF_ETH_II_LEN),
+                                   rRxFrame.rTimeStamp);
+        }
+    }
+
+    /* Transmit confirmation path. */
+    while (true == GPTP_PORT_SimConfirmPop(&rConfirm))
+    {
+        GPTP_PORT_TxConfirmation(rConfirm.u8CtrlIdx, rConfirm.u32BufferIndex,
+                                 rConfirm.rEgressTs);
+    }
+}
+
+/*!
+ * @brief           NVM write callback backed by the simulated memory.
+ *
+ * @param[in]       u8PdelayMachine Pdelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ * @param[in]       f64Value Value to be stored.
+ * @param[in,out]   peWriteStat Pointer to the write status.
+ *
+ * @return          0 on success.
+*/
+uint8_t GPTP_PORT_SimNvmWriteCB(uint8_t u8PdelayMachine,
+                                gptp_def_nvm_data_t eNvmDataType,
+                                float64_t f64Value,
+                                gptp_def_mem_write_stat *peWriteStat)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8Status;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    u8Status = 1u;
+
+    if ((u8PdelayMachine < GPTP_PORT_SIM_CTRL_MAX) &&
+        ((uint32_t)eNvmDataType < GPTP_PORT_SIM_NVM_TYPES))
+    {
+        if (GPTP_DEF_MEM_WRITE_INIT == *peWriteStat)
+        {
+            prNode->af64Nvm[u8PdelayMachine][eNvmDataType] = f64Value;
+            *peWriteStat = GPTP_DEF_MEM_WRITE_FINISH;
+        }
+        u8Status = 0u;
+    }
+
+    return u8Status;
+}
+
+/*!
+ * @brief           NVM read callback backed by the simulated memory.
+ *
+ * @param[in]       u8PdelayMachine Pdelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ * @param[out]      pf64Value Pointer to the value placeholder.
+ *
+ * @return          0 on success.
+*/
+uint8_t GPTP_PORT_SimNvmReadCB(uint8_t u8PdelayMachine,
+                               gptp_def_nvm_data_t eNvmDataType,
+                               float64_t *pf64Value)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8Status;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    u8Status = 1u;
+
+    if ((u8PdelayMachine < GPTP_PORT_SIM_CTRL_MAX) &&
+        ((uint32_t)eNvmDataType < GPTP_PORT_SIM_NVM_TYPES))
+    {
+        *pf64Value = prNode->af64Nvm[u8PdelayMachine][eNvmDataType];
+        u8Status = 0u;
+    }
+
+    return u8Status;
+}
+
+/*!
+ * @brief           Asynchronous NVM read request callback backed by the
+ *                  simulated memory.
+ *
+ * @details         The request is completed by GPTP_PORT_SimNvmReadService.
+ *
+ * @param[in]       u8PdelayMachine Pdelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ *
+ * @return          0 on success.
+*/
+uint8_t GPTP_PORT_SimNvmReadReqCB(uint8_t u8PdelayMachine,
+                                  gptp_def_nvm_data_t eNvmDataType)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8Status;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    u8Status = 1u;
+
+    if ((u8PdelayMachine < GPTP_PORT_SIM_CTRL_MAX) &&
+        ((uint32_t)eNvmDataType < GPTP_PORT_SIM_NVM_TYPES))
+    {
+        prNode->abNvmReadPending[u8PdelayMachine][eNvmDataType] = true;
+        u8Status = 0u;
+    }
+
+    return u8Status;
+}
+
+/*!
+ * @brief           This function completes the pending NVM reads.
+ *
+ * @details         Counterpart of the flash driver main function, delivers
+ *                  the stored values to the stack by GPTP_NvmReadDone.
+*/
+void GPTP_PORT_SimNvmReadService(void)
+{
+    gptp_port_sim_node_t *prNode;
+    uint8_t u8Ctrl;
+    uint8_t u8Type;
+
+    prNode = GPTP_PORT_SimNodeGet();
+
+    for (u8Ctrl = 0u; u8Ctrl < GPTP_PORT_SIM_CTRL_MAX; u8Ctrl++)
+    {
+        for (u8Type = 0u; u8Type < GPTP_PORT_SIM_NVM_TYPES; u8Type++)
+        {
+            if (true == prNode->abNvmReadPending[u8Ctrl][u8Type])
+            {
+                prNode->abNvmReadPending[u8Ctrl][u8Type] = false;
+                (void)GPTP_NvmReadDoneInst(prNode->rPortCtx.prGptp, u8Ctrl, (gptp_def_nvm_data_t)u8Type,
+                                           prNode->af64Nvm[u8Ctrl][u8Type], true);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,459 @@
+/*
+ * Copyright 2023-2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef GPTP_PORT_PLATFORM_H
+#define GPTP_PORT_PLATFORM_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Number of simulated Ethernet controllers. */
+#ifndef GPTP_PORT_SIM_CTRL_MAX
+#define GPTP_PORT_SIM_CTRL_MAX          (4u)
+#endif
+/*! Depth of each simulated frame queue (at most 255). */
+#ifndef GPTP_PORT_SIM_QUEUE_LEN
+#define GPTP_PORT_SIM_QUEUE_LEN         (32u)
+#endif
+/*! Maximal length of a simulated frame including the Ethernet header. */
+#define GPTP_PORT_SIM_FRAME_LEN_MAX     (256u)
+/*! Count of NVM data types stored per port. */
+#define GPTP_PORT_SIM_NVM_TYPES         (2u)
+/*! Frequency of the cycle counter in Hz, the host monotonic clock in ns. */
+#define GPTP_PORT_CYCLE_FREQ_HZ         (1000000000u)
+/*! Number of the controllers served by the port layer. */
+#define GPTP_PORT_CTRL_MAX              GPTP_PORT_SIM_CTRL_MAX
+
+#include "gptp_port_hw.h"
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Frame passed through the simulated Ethernet controller.
+ */
+typedef struct
+{
+    /*! Index of the controller which transmitted/received the frame. */
+    uint8_t                             u8CtrlIdx;
+    /*! Index of the TX buffer assigned by the simulated driver. */
+    uint32_t                            u32BufferIndex;
+    /*! Length of the frame including the Ethernet header. */
+    uint16_t                            u16Length;
+    /*! Egress/ingress timestamp in the simulated PTP clock. */
+    gptp_def_timestamp_t                rTimeStamp;
+    /*! Full Ethernet frame. */
+    uint8_t                             au8Data[GPTP_PORT_SIM_FRAME_LEN_MAX];
+}gptp_port_sim_frame_t;
+
+/*!
+ * @brief Simulated frame queue.
+ */
+typedef struct
+{
+    gptp_port_sim_frame_t               arFrames[GPTP_PORT_SIM_QUEUE_LEN];
+    uint8_t                             u8Head;
+    uint8_t                             u8Count;
+}gptp_port_sim_queue_t;
+
+/*!
+ * @brief Pending TX confirmation.
+ */
+typedef struct
+{
+    uint8_t                             u8CtrlIdx;
+    uint32_t                            u32BufferIndex;
+    gptp_def_timestamp_t                rEgressTs;
+}gptp_port_sim_confirm_t;
+
+/*!
+ * @brief Simulated PTP clock.
+ */
+typedef struct
+{
+    /* FreeRunning time of the last rate change. */
+    uint64_t                            u64RefFreeRunNs;
+    /* PTP time of the last rate change. */
+    int64_t                             s64RefPtpNs;
+    /* Oscillator error. */
+    int32_t                             s32DriftPpb;
+    /* Frequency adjustment applied by the port layer. */
+    int32_t                             s32AdjustmentPpb;
+}gptp_port_sim_clock_t;
+
+/*!
+ * @brief Simulated node - platform and port layer data of one stack instance.
+ *
+ * @details Several nodes run in one process, each serving its own stack
+ *          instance. The node is passed to GPTP_GptpInitInst as pvPortCtx.
+ */
+typedef struct
+{
+    /*! Port layer data, shared by the platforms. */
+    gptp_port_ctx_t                     rPortCtx;
+    /*! FreeRunning timer [ns]. */
+    uint64_t                            u64FreeRunNs;
+    /*! Simulated PTP clock. */
+    gptp_port_sim_clock_t               rClock;
+    /*! Frames transmitted to the simulated wire. */
+    gptp_port_sim_queue_t               rTxQueue;
+    /*! Frames received from the simulated wire. */
+    gptp_port_sim_queue_t               rRxQueue;
+    /*! Pending TX confirmations. */
+    gptp_port_sim_confirm_t             arConfirm[GPTP_PORT_SIM_QUEUE_LEN];
+    uint8_t                             u8ConfirmHead;
+    uint8_t                             u8ConfirmCount;
+    /*! Next TX buffer index assigned by the simulated driver. */
+    uint32_t                            u32NextBufferIndex;
+    bool                                abLinkUp[GPTP_PORT_SIM_CTRL_MAX];
+    uint64_t                            au64Mac[GPTP_PORT_SIM_CTRL_MAX];
+    /*! In-memory NVM. */
+    float64_t                           af64Nvm[GPTP_PORT_SIM_CTRL_MAX][GPTP_PORT_SIM_NVM_TYPES];
+    bool                                abNvmReadPending[GPTP_PORT_SIM_CTRL_MAX][GPTP_PORT_SIM_NVM_TYPES];
+#ifdef GPTP_TX_ZERO_COPY
+    /*! Simulated descriptor buffers, one per controller. */
+    uint8_t                             au8TxBuffer[GPTP_PORT_SIM_CTRL_MAX][GPTP_PORT_SIM_FRAME_LEN_MAX];
+#endif /* GPTP_TX_ZERO_COPY */
+}gptp_port_sim_node_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function selects the simulated node.
+ *
+ * @details         The simulator API acts on the selected node. Within the
+ *                  calls of a stack instance initialized with a node as
+ *                  pvPortCtx, the port layer and the simulator API act on
+ *                  the node of the instance instead.
+ *
+ * @param[in]       prNode Pointer to the node, NULL for the default node.
+ *
+ * @return          Previously selected node.
+*/
+gptp_port_sim_node_t *GPTP_PORT_SimNodeSelect(gptp_port_sim_node_t *prNode);
+
+/*!
+ * @brief           This function returns the simulated node in use.
+ *
+ * @return          Node of the stack instance being processed, otherwise
+ *                  the selected node.
+*/
+gptp_port_sim_node_t *GPTP_PORT_SimNodeGet(void);
+
+/*!
+ * @brief           This function processes egress timestamp.
+ *
+ * @details         This function processes captured egress timestamp.
+ *                  Called from GPTP_PORT_SimPoll for every confirmed frame.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller which transmitted
+ *                  the frame.
+ * @param[in]       u32BufferIndex Index of the transmitted data buffer.
+ * @param[in]       crEgressTs Captured egress timestamp.
+*/
+void GPTP_PORT_TxConfirmation(uint8_t u8CtrlIdx,
+                              uint32_t u32BufferIndex,
+                              const gptp_def_timestamp_t crEgressTs);
+
+/*!
+ * @brief           This function processes the timestamp of a received frames.
+ *
+ * @details         This function passes the received frame together with its
+ *                  ingress timestamp to the gPTP stack.
+ *
+ * @note            The passed data buffer is no longer valid after the function
+ *                  is exited.
+ *
+ * @param[in]       u8CtrlIdx Index of the controller which received the frame.
+ * @param[in]       u16FrameType The received frame Ethertype
+ *                  (from the frame header).
+ * @param[in]       cpu8PhysAddr Pointer to received frame source MAC address
+ *                  (6 bytes).
+ * @param[in]       cpu8Data Data buffer containing the received Ethernet frame
+ *                  payload.
+ * @param[in]       u16LenByte Length of the data in the buffer cpu8Data.
+ * @param[in]       crIngressTs Captured ingress timestamp.
+*/
+void GPTP_PORT_RxIndication(uint8_t u8CtrlIdx,
+                            uint16_t u16FrameType,
+                            const uint8_t *cpu8PhysAddr,
+                            const uint8_t *cpu8Data,
+                            uint16_t u16LenByte,
+                            const gptp_def_timestamp_t crIngressTs);
+
+/*!
+* @brief            This function increments the internal FreeRunning timer
+*                   value.
+*
+* @details          The simulated PTP clock is derived from the FreeRunning
+*                   timer, so this function is the only way the simulated
+*                   time advances.
+*
+* @param[in]        u64Ellapsed Ellapsed time from previous call.
+*/
+void GPTP_PORT_IncFreeRunningTimer(uint64_t u64Ellapsed);
+
+/*!
+ * @brief           This function returns the internal FreeRunning timer value.
+ *
+ * @return          FreeRunning timer current value - uint64_t.
+*/
+uint64_t GPTP_PORT_GetFreeRunningTimer(void);
+
+/*!
+ * @brief           This function starts the cycle counter.
+ *
+ * @details         Counterpart of the DWT cycle counter of the target, backed
+ *                  by the host monotonic clock. Used for the execution time
+ *                  measurements only, the simulated time is not affected.
+*/
+void GPTP_PORT_CycleCounterInit(void);
+
+/*!
+ * @brief           This function returns the cycle counter.
+ *
+ * @details         The counter wraps, only differences of two readings less
+ *                  than one wrap period apart are meaningful.
+ *
+ * @return          Host monotonic clock [ns], GPTP_PORT_CYCLE_FREQ_HZ per second.
+*/
+uint32_t GPTP_PORT_CycleCounterGet(void);
+
+/*!
+ * @brief           This function resets the simulated platform.
+ *
+ * @details         Clears the virtual clocks, frame queues, link states and
+ *                  the in-memory NVM of the node in use. Must be called
+ *                  before GPTP_GptpInit.
+*/
+void GPTP_PORT_SimInit(void);
+
+/*!
+ * @brief           This function sets frequency error of the local oscillator.
+ *
+ * @param[in]       s32DriftPpb Oscillator error in parts per billion. Positive
+ *                  value makes the simulated PTP clock run faster.
+*/
+void GPTP_PORT_SimClockDriftSet(int32_t s32DriftPpb);
+
+/*!
+ * @brief           This function returns the simulated PTP clock.
+ *
+ * @return          Current value of the simulated (corrected) PTP clock.
+*/
+gptp_def_timestamp_t GPTP_PORT_SimClockGet(void);
+
+/*!
+ * @brief           This function applies time and frequency correction to
+ *                  the simulated PTP clock.
+ *
+ * @details         Mirrors the Eth_43_GMAC_SetCorrectionTime behavior.
+ *                  The offset is added to the current time, the frequency
+ *                  adjustment replaces the previous one (positive PPB value
+ *                  slows the clock down).
+ *
+ * @param[in]       s64OffsetNs Signed time step in nanoseconds.
+ * @param[in]       s32AdjustmentPpb Frequency adjustment in parts per billion.
+*/
+void GPTP_PORT_SimClockCorrect(int64_t s64OffsetNs,
+                               int32_t s32AdjustmentPpb);
+
+/*!
+ * @brief           This function sets link state of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[in]       bLinkUp Link state.
+*/
+void GPTP_PORT_SimLinkSet(uint8_t u8CtrlIdx,
+                          bool bLinkUp);
+
+/*!
+ * @brief           This function reads link state of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ *
+ * @return          Link state, false for the unknown controller.
+*/
+bool GPTP_PORT_SimLinkGet(uint8_t u8CtrlIdx);
+
+/*!
+ * @brief           This function sets MAC address of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[in]       u64Mac MAC address stored in the lower 48 bits.
+*/
+void GPTP_PORT_SimMacSet(uint8_t u8CtrlIdx,
+                         uint64_t u64Mac);
+
+/*!
+ * @brief           This function reads MAC address of the simulated controller.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[out]      pu8Mac Pointer to the 6 bytes long MAC address buffer.
+*/
+void GPTP_PORT_SimMacGet(uint8_t u8CtrlIdx,
+                         uint8_t *pu8Mac);
+
+/*!
+ * @brief           This function enqueues frame for transmission.
+ *
+ * @details         Called by the port layer instead of Eth_43_GMAC_Transmit.
+ *                  The egress timestamp is captured immediately and
+ *                  the confirmation is queued for GPTP_PORT_SimPoll.
+ *
+ * @param[in]       u8CtrlIdx Index of the simulated controller.
+ * @param[in]       cpu8Frame Full Ethernet frame.
+ * @param[in]       u16Length Frame length.
+ * @param[in]       bTsRequested Egress timestamp is requested.
+ * @param[out]      pu32BufferIndex Assigned buffer index.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The frame was enqueued.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: No free buffer.
+*/
+gptp_err_type_t GPTP_PORT_SimTxEnqueue(uint8_t u8CtrlIdx,
+                                       const uint8_t *cpu8Frame,
+                                       uint16_t u16Length,
+                                       bool bTsRequested,
+                                       uint32_t *pu32BufferIndex);
+
+/*!
+ * @brief           This function takes the oldest transmitted frame from
+ *                  the simulated wire.
+ *
+ * @param[out]      prFrame Pointer to the frame placeholder.
+ *
+ * @return          true in case a frame was available.
+*/
+bool GPTP_PORT_SimTxPop(gptp_port_sim_frame_t *prFrame);
+
+/*!
+ * @brief           This function takes the oldest pending TX confirmation
+ *                  without passing it to the stack.
+ *
+ * @details         Used instead of GPTP_PORT_SimPoll when the egress
+ *                  timestamps come from elsewhere, e.g. a replayed trace.
+ *
+ * @param[out]      prConfirm Pointer to the confirmation placeholder.
+ *
+ * @return          true in case a confirmation was pending.
+*/
+bool GPTP_PORT_SimConfirmPop(gptp_port_sim_confirm_t *prConfirm);
+
+/*!
+ * @brief           This function puts a frame to the receive queue of
+ *                  the simulated controller.
+ *
+ * @details         The ingress timestamp is captured immediately from
+ *                  the simulated PTP clock, the frame is passed to the stack
+ *                  by GPTP_PORT_SimPoll.
+ *
+ * @param[in]       u8CtrlIdx Index of the receiving controller.
+ * @param[in]       cpu8Frame Full Ethernet frame.
+ * @param[in]       u16Length Frame length.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The frame was enqueued.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_M_MSG_BUFF_PTR_NULL: Receive queue is full.
+*/
+gptp_err_type_t GPTP_PORT_SimRxPush(uint8_t u8CtrlIdx,
+                                    const uint8_t *cpu8Frame,
+                                    uint16_t u16Length);
+
+/*!
+ * @brief           This function polls the simulated controllers.
+ *
+ * @details         Counterpart of Eth_43_GMAC_Receive and
+ *                  Eth_43_GMAC_TxConfirmation. Delivers queued frames and
+ *                  egress timestamps to the stack.
+*/
+void GPTP_PORT_SimPoll(void);
+
+/*!
+ * @brief           NVM write callback backed by the simulated memory.
+ *
+ * @param[in]       u8PdelayMachine Pdelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ * @param[in]       f64Value Value to be stored.
+ * @param[in,out]   peWriteStat Pointer to the write status.
+ *
+ * @return          0 on success.
+*/
+uint8_t GPTP_PORT_SimNvmWriteCB(uint8_t u8PdelayMachine,
+                                gptp_def_nvm_data_t eNvmDataType,
+                                float64_t f64Value,
+                                gptp_def_mem_write_stat *peWriteStat);
+
+/*!
+ * @brief           NVM read callback backed by the simulated memory.
+ *
+ * @param[in]       u8PdelayMachine Pdelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ * @param[out]      pf64Value Pointer to the value placeholder.
+ *
+ * @return          0 on success.
+*/
+uint8_t GPTP_PORT_SimNvmReadCB(uint8_t u8PdelayMachine,
+                               gptp_def_nvm_data_t eNvmDataType,
+                               float64_t *pf64Value);
+
+/*!
+ * @brief           Asynchronous NVM read request callback backed by the
+ *                  simulated memory.
+ *
+ * @details         The request is completed by GPTP_PORT_SimNvmReadService.
+ *
+ * @param[in]       u8PdelayMachine Pdelay machine index.
+ * @param[in]       eNvmDataType NVM data type to access.
+ *
+ * @return          0 on success.
+*/
+uint8_t GPTP_PORT_SimNvmReadReqCB(uint8_t u8PdelayMachine,
+                                  gptp_def_nvm_data_t eNvmDataType);
+
+/*!
+ * @brief           This function completes the pending NVM reads.
+ *
+ * @details         Counterpart of the flash driver main function, delivers
+ *                  the stored values to the stack by GPTP_NvmReadDone.
+*/
+void GPTP_PORT_SimNvmReadService(void);
+
+/*******************************************************************************
+ * Guard End
+ ******************************************************************************/
+
+#endif /* GPTP_PORT_PLATFORM_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_port_replay.c
+ *
+ * @details Replays the trace captured by GPTP_TRACE_Start (GPTP_TRACE_CAPTURE
+ *          build of the target or of the simulator) into a stack instance on
+ *          the simulated platform.
+ *
+ *          The stack sees the recorded frames and timestamps at the recorded
+ *          FreeRunning times and GPTP_TimerPeriodic at the recorded ticks,
+ *          so given the same configuration it takes the same decisions as
+ *          the traced one. The replay is repeatable, servo changes can be
+ *          compared on identical input.
+ *
+ *          The simulated driver assigns its own buffer indexes to the frames
+ *          transmitted during the replay. The recorded egress timestamps are
+ *          mapped onto them by the port, message type, domain number and
+ *          sequence ID of the frame, so a replay diverging from the trace
+ *          drops the timestamp instead of confirming another frame.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp_port_replay.h"
+#include "gptp_port.h"
+#include "gptp_trace.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void GPTP_PORT_ReplayTimeSet(uint64_t u64FreeRunNs);
+static void GPTP_PORT_ReplayDrain(void);
+
+/*******************************************************************************
+ * Local Functions
+ ******************************************************************************/
+
+/*!
+ * @brief           This function moves the FreeRunning timer to the record time.
+ *
+ * @details         The timer never goes backwards.
+ *
+ * @param[in]       u64FreeRunNs FreeRunning time of the record [ns].
+*/
+static void GPTP_PORT_ReplayTimeSet(uint64_t u64FreeRunNs)
+{
+    uint64_t u64NowNs;
+
+    u64NowNs = GPTP_PORT_GetFreeRunningTimer();
+    if (u64FreeRunNs > u64NowNs)
+    {
+        GPTP_PORT_IncFreeRunningTimer(u64FreeRunNs - u64NowNs);
+    }
+}
+
+/*!
+ * @brief           This function drains the simulated controllers.
+ *
+ * @details         Discards the transmitted frames and their confirmations,
+ *                  the egress timestamps come from the trace.
+*/
+static void GPTP_PORT_ReplayDrain(void)
+{
+    gptp_port_sim_frame_t   rFrame;
+    gptp_port_sim_confirm_t rConfirm;
+
+    while (true == GPTP_PORT_SimTxPop(&rFrame))
+    {
+        /* Nothing to deliver to. */
+    }
+
+    while (true == GPTP_PORT_SimConfirmPop(&rConfirm))
+    {
+        /* Confirmed by the trace. */
+    }
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function opens the trace for the replay.
+ *
+ * @param[out]      prReplay Pointer to the replay context.
+ * @param[in]       cpu8Trace Pointer to the trace stream.
+ * @param[in]       u32Length Length of the trace stream.
+ *
+ * @return          Error status.
+*/
+gptp_err_type_t GPTP_PORT_ReplayOpen(gptp_port_replay_t *prReplay,
+                                     const uint8_t *cpu8Trace,
+                                     uint32_t u32Length)
+{
+    gptp_err_type_t      eError;
+    gptp_def_trace_rec_t rRec;
+
+    if (NULL == prReplay)
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else
+    {
+        eError = GPTP_TRACE_HeaderCheck(cpu8Trace, u32Length);
+    }
+
+    if (GPTP_ERR_OK == eError)
+    {
+        prReplay->cpu8Trace = cpu8Trace;
+        prReplay->u32Length = u32Length;
+        prReplay->u32Offset = GPTP_DEF_TRACE_HDR_LEN;
+        prReplay->rStats.u32Rx = 0u;
+        prReplay->rStats.u32Tx = 0u;
+        prReplay->rStats.u32Ticks = 0u;
+        prReplay->rStats.u32Unmatched = 0u;
+
+        eError = GPTP_TRACE_Decode(cpu8Trace, u32Length, &prReplay->u32Offset, &rRec);
+        if ((GPTP_ERR_OK == eError) && (GPTP_DEF_TRACE_REC_START != rRec.eType))
+        {
+            eError = GPTP_ERR_M_MESSAGE_ID_INVALID;
+        }
+    }
+
+    if (GPTP_ERR_OK == eError)
+    {
+        GPTP_PORT_ReplayTimeSet(rRec.u64FreeRunNs);
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function replays the trace records.
+ *
+ * @param[in,out]   prReplay Pointer to the replay context.
+ * @param[in]       prGptp Pointer to the replayed stack instance.
+ * @param[in]       u32Records Count of the records to replay, 0 for all.
+ *
+ * @return          Count of the replayed records.
+*/
+uint32_t GPTP_PORT_ReplayRun(gptp_port_replay_t *prReplay,
+                             gptp_def_data_t *prGptp,
+                             uint32_t u32Records)
+{
+    gptp_port_sim_node_t *prNodePrev;
+    gptp_def_trace_rec_t rRec;
+    gptp_def_rx_data_t   rRxData;
+    uint32_t             u32BufferIndex;
+    uint32_t             u32Replayed;
+
+    u32Replayed = 0u;
+
+    if ((NULL != prReplay) && (NULL != prGptp))
+    {
+        /* The simulator API outside the stack calls acts on the node of the instance. */
+        prNodePrev = GPTP_PORT_SimNodeSelect((gptp_port_sim_node_t *)prGptp->pvPortCtx);
+
+        while (((0u == u32Records) || (u32Replayed < u32Records)) &&
+               (GPTP_ERR_OK == GPTP_TRACE_Decode(prReplay->cpu8Trace, prReplay->u32Length,
+                                                 &prReplay->u32Offset, &rRec)))
+        {
+            /* Frames transmitted since the previous record. */
+            GPTP_PORT_ReplayDrain();
+            GPTP_PORT_ReplayTimeSet(rRec.u64FreeRunNs);
+
+            switch (rRec.eType)
+            {
+                case GPTP_DEF_TRACE_REC_RX:
+                    rRxData.u8PtpPort = rRec.u8PtpPort;
+                    rRxData.u32TsSec = rRec.u32TsSec;
+                    rRxData.u32TsNsec = rRec.u32TsNsec;
+                    rRxData.cpu8RxData = rRec.cpu8Data;
+                    rRxData.u16EthType = rRec.u16EthType;
+                    rRxData.u64SourceMac = rRec.u64SourceMac;
+                    GPTP_MsgReceiveInst(prGptp, rRxData);
+                    prReplay->rStats.u32Rx++;
+                    break;
+
+                case GPTP_DEF_TRACE_REC_TX:
+                    u32BufferIndex = GPTP_TRACE_TxBufferIndex(prGptp, &rRec);
+                    if (GPTP_DEF_BUFF_INDEX_CLOSED != u32BufferIndex)
+                    {
+                        GPTP_UpdateTimestampEntryInst(prGptp, rRec.u8PtpPort, u32BufferIndex,
+                                                      rRec.u32TsSec, rRec.u32TsNsec);
+                    }
+                    else
+                    {
+                        prReplay->rStats.u32Unmatched++;
+                    }
+                    prReplay->rStats.u32Tx++;
+                    break;
+
+                case GPTP_DEF_TRACE_REC_TICK:
+                    GPTP_TimerPeriodicInst(prGptp);
+                    prReplay->rStats.u32Ticks++;
+                    break;
+
+                default:
+                    /* Restarted capture, nothing to replay. */
+                    break;
+            }
+
+            u32Replayed++;
+        }
+
+        (void)GPTP_PORT_SimNodeSelect(prNodePrev);
+    }
+
+    return u32Replayed;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef GPTP_PORT_REPLAY_H
+#define GPTP_PORT_REPLAY_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+#include "gptp_port_platform.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Replay statistics.
+ */
+typedef struct
+{
+    /*! Replayed received frames. */
+    uint32_t                            u32Rx;
+    /*! Replayed egress timestamps. */
+    uint32_t                            u32Tx;
+    /*! Replayed calls of GPTP_TimerPeriodic. */
+    uint32_t                            u32Ticks;
+    /*! Egress timestamps of frames not transmitted by the replayed stack,
+        matched by the port, message type, domain number and sequence ID. */
+    uint32_t                            u32Unmatched;
+}gptp_port_replay_stats_t;
+
+/*!
+ * @brief Replay context.
+ *
+ * @details Provided by the application, filled by GPTP_PORT_ReplayOpen.
+ */
+typedef struct
+{
+    /*! Trace stream being replayed. */
+    const uint8_t                       *cpu8Trace;
+    uint32_t                            u32Length;
+    /*! Offset of the next record. */
+    uint32_t                            u32Offset;
+    gptp_port_replay_stats_t            rStats;
+}gptp_port_replay_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function opens the trace for the replay.
+ *
+ * @details         Checks the trace stream and moves the FreeRunning timer
+ *                  of the node in use to the start of the trace. Call after
+ *                  GPTP_PORT_SimInit and before the initialization of
+ *                  the replayed instance, which must use the configuration
+ *                  and the NVM content of the traced one.
+ *
+ * @param[out]      prReplay Pointer to the replay context.
+ * @param[in]       cpu8Trace Pointer to the trace stream, must stay valid
+ *                  during the replay.
+ * @param[in]       u32Length Length of the trace stream.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The trace is ready for the replay.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_M_MESSAGE_ID_INVALID: Unknown trace format or
+ *                  the trace does not begin with the start record.
+*/
+gptp_err_type_t GPTP_PORT_ReplayOpen(gptp_port_replay_t *prReplay,
+                                     const uint8_t *cpu8Trace,
+                                     uint32_t u32Length);
+
+/*!
+ * @brief           This function replays the trace records.
+ *
+ * @details         Records are replayed in the trace order. The FreeRunning
+ *                  timer is moved to the record time, then the received
+ *                  frame is passed by GPTP_MsgReceive, the egress timestamp
+ *                  by GPTP_UpdateTimestampEntry and the tick calls
+ *                  GPTP_TimerPeriodic. Frames transmitted by the replayed
+ *                  stack are discarded. The recorded egress timestamp is
+ *                  passed with the buffer index of the replayed frame of the
+ *                  same port, message type, domain number and sequence ID,
+ *                  it is dropped if the replayed stack did not transmit
+ *                  such a frame.
+ *
+ * @param[in,out]   prReplay Pointer to the replay context.
+ * @param[in]       prGptp Pointer to the replayed stack instance.
+ * @param[in]       u32Records Count of the records to replay, 0 for all.
+ *
+ * @return          Count of the replayed records, less than requested
+ *                  at the end of the trace.
+*/
+uint32_t GPTP_PORT_ReplayRun(gptp_port_replay_t *prReplay,
+                             gptp_def_data_t *prGptp,
+                             uint32_t u32Records);
+
+#endif /* GPTP_PORT_REPLAY_H */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,894 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_port_simnet.c
+ *
+ * @details Discrete-event network of simulated gPTP nodes. Every node is
+ *          a stack instance on its own simulated platform
+ *          (gptp_port_sim_node_t), the controllers of the nodes are connected
+ *          by full duplex links with propagation delay, asymmetry, jitter
+ *          and frame loss.
+ *
+ *          The simulator keeps the true time. The FreeRunning timers of all
+ *          nodes follow it, the PTP clock of every node runs with its own
+ *          oscillator frequency offset and wander. Since both PTP clocks are
+ *          read at the same true time, the reported time error is the real
+ *          one, not the offset estimated by the stack.
+ *
+ *          Frames are timestamped on egress when the stack transmits them
+ *          and on ingress when they arrive at the link peer. A node runs
+ *          GPTP_TimerPeriodic periodically and whenever a frame arrives it
+ *          polls its simulated controllers, so the stack sees
+ *          the GPTP_PORT_RxIndication and GPTP_PORT_TxConfirmation sequence
+ *          of the real driver. The random numbers come from a seeded
+ *          generator, so every run is repeatable.
+ *
+ *          Needs the math library (-lm).
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <math.h>
+#include "gptp_port_simnet.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! MAC address base of the network nodes, locally administered. */
+#define GPTP_PORT_SIMNET_MAC_BASE       (0x020000010000u)
+/*! Count of the link directions. */
+#define GPTP_PORT_SIMNET_DIRS           (2u)
+/*! Frame loss probability scale [ppm]. */
+#define GPTP_PORT_SIMNET_PPM            (1000000u)
+/*! Marks the free event slot in the heap. */
+#define GPTP_PORT_SIMNET_NO_EVENT       (0xFFFFu)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Simulated network event type.
+ */
+typedef enum
+{
+    GPTP_PORT_SIMNET_EV_DELIVER = 0u,
+    GPTP_PORT_SIMNET_EV_TIMER,
+    GPTP_PORT_SIMNET_EV_SAMPLE,
+    GPTP_PORT_SIMNET_EV_WANDER
+}gptp_port_simnet_ev_type_t;
+
+/*!
+ * @brief Simulated network event.
+ */
+typedef struct
+{
+    /*! True time of the event [ns]. */
+    uint64_t                            u64TimeNs;
+    /*! Order of scheduling, keeps the simultaneous events in order. */
+    uint32_t                            u32Seq;
+    gptp_port_simnet_ev_type_t          eType;
+    /*! Receiving node and controller of the frame or node of the timer. */
+    uint8_t                             u8Node;
+    uint8_t                             u8Ctrl;
+    uint16_t                            u16Length;
+    uint8_t                             au8Data[GPTP_PORT_SIM_FRAME_LEN_MAX];
+}gptp_port_simnet_event_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint64_t GPTP_PORT_SimNetRand(void);
+static float64_t GPTP_PORT_SimNetGauss(void);
+static int64_t GPTP_PORT_SimNetClockNs(gptp_port_simnet_node_t *prNode);
+static bool GPTP_PORT_SimNetEarlier(uint16_t u16EventA,
+                                    uint16_t u16EventB);
+static gptp_port_simnet_event_t *GPTP_PORT_SimNetEventNew(uint64_t u64TimeNs,
+                                                          gptp_port_simnet_ev_type_t eType,
+                                                          uint8_t u8Node);
+static uint16_t GPTP_PORT_SimNetEventPop(void);
+static void GPTP_PORT_SimNetTransmit(uint8_t u8Node,
+                                     const gptp_port_sim_frame_t *cprFrame);
+static void GPTP_PORT_SimNetService(uint8_t u8Node);
+static void GPTP_PORT_SimNetSample(void);
+static void GPTP_PORT_SimNetWander(void);
+static void GPTP_PORT_SimNetProcess(uint16_t u16Event);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static gptp_port_simnet_conf_t      srConf;
+/* True time [ns]. */
+static uint64_t                     su64NowNs;
+static uint64_t                     su64RandState;
+static uint32_t                     su32Seq;
+static uint32_t                     su32Lost;
+
+static gptp_port_simnet_node_t      *saprNodes[GPTP_PORT_SIMNET_NODES_MAX];
+static uint8_t                      su8Nodes;
+
+static gptp_port_simnet_link_t      sarLinks[GPTP_PORT_SIMNET_LINKS_MAX];
+/* Arrival of the last frame per link direction, keeps the frames in order. */
+static uint64_t                     sau64LastArrivalNs[GPTP_PORT_SIMNET_LINKS_MAX][GPTP_PORT_SIMNET_DIRS];
+static uint8_t                      su8Links;
+
+/* Event pool, the heap and the free list hold indices into it. */
+static gptp_port_simnet_event_t     sarEvents[GPTP_PORT_SIMNET_EVENTS_MAX];
+static uint16_t                     sau16Heap[GPTP_PORT_SIMNET_EVENTS_MAX];
+static uint16_t                     sau16Free[GPTP_PORT_SIMNET_EVENTS_MAX];
+static uint16_t                     su16HeapCount;
+static uint16_t                     su16FreeCount;
+
+/*******************************************************************************
+ * Local Functions
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns the next pseudo-random number.
+ *
+ * @return          Uniformly distributed 64 bit number (xorshift64*).
+*/
+static uint64_t GPTP_PORT_SimNetRand(void)
+{
+    su64RandState ^= su64RandState >> 12u;
+    su64RandState ^= su64RandState << 25u;
+    su64RandState ^= su64RandState >> 27u;
+
+    return su64RandState * 0x2545F4914F6CDD1Du;
+}
+
+/*!
+ * @brief           This function returns a normally distributed number.
+ *
+ * @return          Standard normal number (Box-Muller transform).
+*/
+static float64_t GPTP_PORT_SimNetGauss(void)
+{
+    float64_t f64U1;
+    float64_t f64U2;
+
+    /* Uniform in (0, 1], 53 bits. */
+    f64U1 = ((float64_t)(GPTP_PORT_SimNetRand() >> 11u) + 1.0) / 9007199254740992.0;
+    f64U2 = (float64_t)(GPTP_PORT_SimNetRand() >> 11u) / 9007199254740992.0;
+
+    return sqrt(-2.0 * log(f64U1)) * cos(2.0 * 3.14159265358979323846 * f64U2);
+}
+
+/*!
+ * @brief           This function reads the PTP clock of the node.
+ *
+ * @param[in]       prNode Pointer to the node.
+ *
+ * @return          PTP time [ns].
+*/
+static int64_t GPTP_PORT_SimNetClockNs(gptp_port_simnet_node_t *prNode)
+{
+    gptp_port_sim_node_t *prPrevious;
+    gptp_def_timestamp_t rTs;
+
+    prPrevious = GPTP_PORT_SimNodeSelect(&prNode->rSim);
+    rTs = GPTP_PORT_SimClockGet();
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+
+    return ((int64_t)rTs.u64TimeStampS * (int64_t)GPTP_DEF_NS_IN_SECONDS) + (int64_t)rTs.u32TimeStampNs;
+}
+
+/*!
+ * @brief           This function compares two scheduled events.
+ *
+ * @param[in]       u16EventA Pool index of the first event.
+ * @param[in]       u16EventB Pool index of the second event.
+ *
+ * @return          true if the first event is to be processed first.
+*/
+static bool GPTP_PORT_SimNetEarlier(uint16_t u16EventA,
+                                    uint16_t u16EventB)
+{
+    const gptp_port_simnet_event_t *cprA;
+    const gptp_port_simnet_event_t *cprB;
+
+    cprA = &sarEvents[u16EventA];
+    cprB = &sarEvents[u16EventB];
+
+    return (cprA->u64TimeNs < cprB->u64TimeNs) ||
+           ((cprA->u64TimeNs == cprB->u64TimeNs) && (cprA->u32Seq < cprB->u32Seq));
+}
+
+/*!
+ * @brief           This function schedules a new event.
+ *
+ * @param[in]       u64TimeNs True time of the event [ns].
+ * @param[in]       eType Event type.
+ * @param[in]       u8Node Node of the event.
+ *
+ * @return          Pointer to the event to be completed or NULL if the event
+ *                  pool is exhausted.
+*/
+static gptp_port_simnet_event_t *GPTP_PORT_SimNetEventNew(uint64_t u64TimeNs,
+                                                          gptp_port_simnet_ev_type_t eType,
+                                                          uint8_t u8Node)
+{
+    gptp_port_simnet_event_t *prEvent;
+    uint16_t u16Event;
+    uint16_t u16Pos;
+    uint16_t u16Parent;
+
+    prEvent = NULL;
+
+    if (0u != su16FreeCount)
+    {
+        su16FreeCount--;
+        u16Event = sau16Free[su16FreeCount];
+        prEvent = &sarEvents[u16Event];
+        prEvent->u64TimeNs = u64TimeNs;
+        prEvent->u32Seq = su32Seq++;
+        prEvent->eType = eType;
+        prEvent->u8Node = u8Node;
+        prEvent->u8Ctrl = 0u;
+        prEvent->u16Length = 0u;
+
+        /* Sift up. */
+        u16Pos = su16HeapCount;
+        su16HeapCount++;
+        while (0u != u16Pos)
+        {
+            u16Parent = (uint16_t)((u16Pos - 1u) / 2u);
+            if (false == GPTP_PORT_SimNetEarlier(u16Event, sau16Heap[u16Parent]))
+            {
+                break;
+            }
+            sau16Heap[u16Pos] = sau16Heap[u16Parent];
+            u16Pos = u16Parent;
+        }
+        sau16Heap[u16Pos] = u16Event;
+    }
+
+    return prEvent;
+}
+
+/*!
+ * @brief           This function removes the earliest event from the heap.
+ *
+ * @details         The event stays valid until the next event is scheduled.
+ *
+ * @return          Pool index of the event or GPTP_PORT_SIMNET_NO_EVENT.
+*/
+static uint16_t GPTP_PORT_SimNetEventPop(void)
+{
+    uint16_t u16Event;
+    uint16_t u16Last;
+    uint16_t u16Pos;
+    uint16_t u16Child;
+
+    u16Event = GPTP_PORT_SIMNET_NO_EVENT;
+
+    if (0u != su16HeapCount)
+    {
+        u16Event = sau16Heap[0u];
+        su16HeapCount--;
+        u16Last = sau16Heap[su16HeapCount];
+
+        /* Sift down. */
+        u16Pos = 0u;
+        u16Child = 1u;
+        while (u16Child < su16HeapCount)
+        {
+            if (((u16Child + 1u) < su16HeapCount) &&
+                (true == GPTP_PORT_SimNetEarlier(sau16Heap[u16Child + 1u], sau16Heap[u16Child])))
+            {
+                u16Child++;
+            }
+            if (false == GPTP_PORT_SimNetEarlier(sau16Heap[u16Child], u16Last))
+            {
+                break;
+            }
+            sau16Heap[u16Pos] = sau16Heap[u16Child];
+            u16Pos = u16Child;
+            u16Child = (uint16_t)((2u * u16Pos) + 1u);
+        }
+        if (0u != su16HeapCount)
+        {
+            sau16Heap[u16Pos] = u16Last;
+        }
+
+        sau16Free[su16FreeCount] = u16Event;
+        su16FreeCount++;
+    }
+
+    return u16Event;
+}
+
+/*!
+ * @brief           This function puts a transmitted frame on the link.
+ *
+ * @details         Frames of the unconnected controllers are dropped.
+ *                  The jitter never reorders the frames of a link direction.
+ *
+ * @param[in]       u8Node Transmitting node.
+ * @param[in]       cprFrame Pointer to the transmitted frame.
+*/
+static void GPTP_PORT_SimNetTransmit(uint8_t u8Node,
+                                     const gptp_port_sim_frame_t *cprFrame)
+{
+    const gptp_port_simnet_link_t *cprLink;
+    gptp_port_simnet_event_t      *prEvent;
+    uint8_t                       u8Link;
+    uint8_t                       u8Dir;
+    int64_t                       s64DelayNs;
+    uint64_t                      u64ArrivalNs;
+    uint16_t                      u16Byte;
+
+    for (u8Link = 0u; u8Link < su8Links; u8Link++)
+    {
+        cprLink = &sarLinks[u8Link];
+
+        if ((u8Node == cprLink->u8NodeA) && (cprFrame->u8CtrlIdx == cprLink->u8CtrlA))
+        {
+            u8Dir = 0u;
+            s64DelayNs = (int64_t)cprLink->u32DelayNs + ((int64_t)cprLink->s32AsymmetryNs / 2);
+        }
+        else if ((u8Node == cprLink->u8NodeB) && (cprFrame->u8CtrlIdx == cprLink->u8CtrlB))
+        {
+            u8Dir = 1u;
+            s64DelayNs = (int64_t)cprLink->u32DelayNs - ((int64_t)cprLink->s32AsymmetryNs / 2);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (0u != cprLink->u32JitterNs)
+        {
+            s64DelayNs += (int64_t)(GPTP_PORT_SimNetRand() % ((uint64_t)cprLink->u32JitterNs + 1u));
+        }
+        if (0 > s64DelayNs)
+        {
+            s64DelayNs = 0;
+        }
+
+        if ((0u != cprLink->u32LossPpm) &&
+            ((GPTP_PORT_SimNetRand() % GPTP_PORT_SIMNET_PPM) < cprLink->u32LossPpm))
+        {
+            su32Lost++;
+            break;
+        }
+
+        u64ArrivalNs = su64NowNs + (uint64_t)s64DelayNs;
+        if (u64ArrivalNs < sau64LastArrivalNs[u8Link][u8Dir])
+        {
+            u64ArrivalNs = sau64LastArrivalNs[u8Link][u8Dir];
+        }
+
+        prEvent = GPTP_PORT_SimNetEventNew(u64ArrivalNs, GPTP_PORT_SIMNET_EV_DELIVER,
+                                           (0u == u8Dir) ? cprLink->u8NodeB : cprLink->u8NodeA);
+        if (NULL == prEvent)
+        {
+            su32Lost++;
+        }
+        else
+        {
+            sau64LastArrivalNs[u8Link][u8Dir] = u64ArrivalNs;
+            prEvent->u8Ctrl = (0u == u8Dir) ? cprLink->u8CtrlB : cprLink->u8CtrlA;
+            prEvent->u16Length = cprFrame->u16Length;
+            for (u16Byte = 0u; u16Byte < cprFrame->u16Length; u16Byte++)
+            {
+                prEvent->au8Data[u16Byte] = cprFrame->au8Data[u16Byte];
+            }
+        }
+        break;
+    }
+}
+
+/*!
+ * @brief           This function polls the node until it goes quiet.
+ *
+ * @details         Delivers the received frames and the TX confirmations to
+ *                  the stack and puts the transmitted frames on the links.
+ *
+ * @param[in]       u8Node Node index.
+*/
+static void GPTP_PORT_SimNetService(uint8_t u8Node)
+{
+    gptp_port_sim_frame_t rFrame;
+    bool bTransmitted;
+
+    (void)GPTP_PORT_SimNodeSelect(&saprNodes[u8Node]->rSim);
+
+    do
+    {
+        GPTP_PORT_SimPoll();
+
+        bTransmitted = false;
+        while (true == GPTP_PORT_SimTxPop(&rFrame))
+        {
+            GPTP_PORT_SimNetTransmit(u8Node, &rFrame);
+            bTransmitted = true;
+        }
+    } while (true == bTransmitted);
+}
+
+/*!
+ * @brief           This function samples the true time error of all nodes.
+*/
+static void GPTP_PORT_SimNetSample(void)
+{
+    gptp_port_simnet_node_t  *prNode;
+    gptp_port_simnet_stats_t *prStats;
+    int64_t                  s64ErrNs;
+    uint8_t                  u8Node;
+
+    for (u8Node = 0u; u8Node < su8Nodes; u8Node++)
+    {
+        prNode = saprNodes[u8Node];
+        prStats = &prNode->rStats;
+        s64ErrNs = GPTP_PORT_SimNetTimeErrorGet(u8Node);
+
+        if ((0u == prStats->u32Samples) || (s64ErrNs < prStats->s64MinNs))
+        {
+            prStats->s64MinNs = s64ErrNs;
+        }
+        if ((0u == prStats->u32Samples) || (s64ErrNs > prStats->s64MaxNs))
+        {
+            prStats->s64MaxNs = s64ErrNs;
+        }
+        prStats->u32Samples++;
+        prStats->s64LastNs = s64ErrNs;
+        prNode->f64ErrSum += (float64_t)s64ErrNs;
+        prNode->f64ErrSumSq += (float64_t)s64ErrNs * (float64_t)s64ErrNs;
+    }
+}
+
+/*!
+ * @brief           This function updates the oscillator wander of all nodes.
+ *
+ * @details         The frequency makes a random walk step scaled to
+ *                  the wander update period.
+*/
+static void GPTP_PORT_SimNetWander(void)
+{
+    gptp_port_simnet_node_t *prNode;
+    float64_t               f64Scale;
+    uint8_t                 u8Node;
+
+    f64Scale = sqrt((float64_t)srConf.u32WanderPeriodNs / (float64_t)GPTP_DEF_NS_IN_SECONDS);
+
+    for (u8Node = 0u; u8Node < su8Nodes; u8Node++)
+    {
+        prNode = saprNodes[u8Node];
+
+        if (0.0 < prNode->rOsc.f64WanderPpb)
+        {
+            prNode->f64WanderPpb += GPTP_PORT_SimNetGauss() * prNode->rOsc.f64WanderPpb * f64Scale;
+
+            (void)GPTP_PORT_SimNodeSelect(&prNode->rSim);
+            GPTP_PORT_SimClockDriftSet(prNode->rOsc.s32FreqOffsetPpb + (int32_t)lround(prNode->f64WanderPpb));
+        }
+    }
+}
+
+/*!
+ * @brief           This function processes an event at its true time.
+ *
+ * @param[in]       u16Event Pool index of the event.
+*/
+static void GPTP_PORT_SimNetProcess(uint16_t u16Event)
+{
+    const gptp_port_simnet_event_t *cprEvent;
+    gptp_port_simnet_node_t        *prNode;
+    uint64_t                       u64TimeNs;
+    uint8_t                        u8Node;
+
+    cprEvent = &sarEvents[u16Event];
+    u64TimeNs = cprEvent->u64TimeNs;
+    u8Node = cprEvent->u8Node;
+    prNode = saprNodes[u8Node];
+
+    switch (cprEvent->eType)
+    {
+        case GPTP_PORT_SIMNET_EV_DELIVER:
+            /* Ingress timestamp is captured on the push. */
+            (void)GPTP_PORT_SimNodeSelect(&prNode->rSim);
+            if (GPTP_ERR_OK != GPTP_PORT_SimRxPush(cprEvent->u8Ctrl, cprEvent->au8Data,
+                                                   cprEvent->u16Length))
+            {
+                su32Lost++;
+            }
+            GPTP_PORT_SimNetService(u8Node);
+            break;
+
+        case GPTP_PORT_SIMNET_EV_TIMER:
+            (void)GPTP_PORT_SimNodeSelect(&prNode->rSim);
+            GPTP_TimerPeriodicInst(&prNode->rGptp);
+            if (false == srConf.bNvmReadByApp)
+            {
+                GPTP_PORT_SimNvmReadService();
+            }
+            GPTP_PORT_SimNetService(u8Node);
+            (void)GPTP_PORT_SimNetEventNew(u64TimeNs + srConf.u32TimerPeriodNs,
+                                           GPTP_PORT_SIMNET_EV_TIMER, u8Node);
+            break;
+
+        case GPTP_PORT_SIMNET_EV_SAMPLE:
+            GPTP_PORT_SimNetSample();
+            (void)GPTP_PORT_SimNetEventNew(u64TimeNs + srConf.u32SamplePeriodNs,
+                                           GPTP_PORT_SIMNET_EV_SAMPLE, 0u);
+            break;
+
+        case GPTP_PORT_SIMNET_EV_WANDER:
+            GPTP_PORT_SimNetWander();
+            (void)GPTP_PORT_SimNetEventNew(u64TimeNs + srConf.u32WanderPeriodNs,
+                                           GPTP_PORT_SIMNET_EV_WANDER, 0u);
+            break;
+
+        default:
+            /* Unknown event - ignored. */
+            break;
+    }
+}
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes the simulated network.
+ *
+ * @param[in]       cprConf Pointer to the configuration, NULL for defaults.
+*/
+void GPTP_PORT_SimNetInit(const gptp_port_simnet_conf_t *cprConf)
+{
+    uint16_t u16Event;
+
+    if (NULL == cprConf)
+    {
+        srConf.u64Seed = 0u;
+        srConf.u32TimerPeriodNs = 0u;
+        srConf.u32SamplePeriodNs = 0u;
+        srConf.u32WanderPeriodNs = 0u;
+        srConf.u8RefNode = 0u;
+        srConf.bNvmReadByApp = false;
+    }
+    else
+    {
+        srConf = *cprConf;
+    }
+
+    if (0u == srConf.u32TimerPeriodNs)
+    {
+        srConf.u32TimerPeriodNs = GPTP_PORT_SIMNET_TIMER_NS_DEF;
+    }
+    if (0u == srConf.u32SamplePeriodNs)
+    {
+        srConf.u32SamplePeriodNs = GPTP_PORT_SIMNET_SAMPLE_NS_DEF;
+    }
+    if (0u == srConf.u32WanderPeriodNs)
+    {
+        srConf.u32WanderPeriodNs = GPTP_PORT_SIMNET_WANDER_NS_DEF;
+    }
+
+    su64RandState = (0u == srConf.u64Seed) ? 1u : srConf.u64Seed;
+    su64NowNs = 0u;
+    su32Seq = 0u;
+    su32Lost = 0u;
+    su8Nodes = 0u;
+    su8Links = 0u;
+
+    su16HeapCount = 0u;
+    su16FreeCount = 0u;
+    for (u16Event = 0u; u16Event < GPTP_PORT_SIMNET_EVENTS_MAX; u16Event++)
+    {
+        sau16Free[su16FreeCount] = (uint16_t)(GPTP_PORT_SIMNET_EVENTS_MAX - 1u - u16Event);
+        su16FreeCount++;
+    }
+
+    (void)GPTP_PORT_SimNetEventNew(srConf.u32SamplePeriodNs, GPTP_PORT_SIMNET_EV_SAMPLE, 0u);
+    (void)GPTP_PORT_SimNetEventNew(srConf.u32WanderPeriodNs, GPTP_PORT_SIMNET_EV_WANDER, 0u);
+}
+
+/*!
+ * @brief           This function adds a node to the simulated network.
+ *
+ * @param[out]      prNode Pointer to the node placeholder.
+ * @param[in]       cprOsc Pointer to the oscillator, NULL for an ideal one.
+ * @param[in]       cprInit Pointer to the stack initialization parameters.
+ * @param[out]      pu8NodeIdx Pointer to the node index placeholder or NULL.
+ *
+ * @return          Error status.
+*/
+gptp_err_type_t GPTP_PORT_SimNetNodeAdd(gptp_port_simnet_node_t *prNode,
+                                        const gptp_port_simnet_osc_t *cprOsc,
+                                        const gptp_def_init_params_t *cprInit,
+                                        uint8_t *pu8NodeIdx)
+{
+    gptp_port_sim_node_t   *prPrevious;
+    gptp_def_init_params_t rInit;
+    gptp_err_type_t        eError;
+    uint8_t                u8Node;
+    uint8_t                u8Ctrl;
+
+    if ((NULL == prNode) || (NULL == cprInit))
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else if (su8Nodes >= GPTP_PORT_SIMNET_NODES_MAX)
+    {
+        eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+    }
+    else
+    {
+        u8Node = su8Nodes;
+
+        if (NULL == cprOsc)
+        {
+            prNode->rOsc.s32FreqOffsetPpb = 0;
+            prNode->rOsc.f64WanderPpb = 0.0;
+            prNode->rOsc.s64InitOffsetNs = 0;
+        }
+        else
+        {
+            prNode->rOsc = *cprOsc;
+        }
+        prNode->f64WanderPpb = 0.0;
+        prNode->f64ErrSum = 0.0;
+        prNode->f64ErrSumSq = 0.0;
+        prNode->rStats.u32Samples = 0u;
+
+        /* The node joins at the current true time. */
+        prPrevious = GPTP_PORT_SimNodeSelect(&prNode->rSim);
+        GPTP_PORT_SimInit();
+        GPTP_PORT_IncFreeRunningTimer(su64NowNs);
+        GPTP_PORT_SimClockDriftSet(prNode->rOsc.s32FreqOffsetPpb);
+        GPTP_PORT_SimClockCorrect(prNode->rOsc.s64InitOffsetNs, 0);
+        for (u8Ctrl = 0u; u8Ctrl < GPTP_PORT_SIM_CTRL_MAX; u8Ctrl++)
+        {
+            GPTP_PORT_SimMacSet(u8Ctrl, GPTP_PORT_SIMNET_MAC_BASE + ((uint64_t)u8Node << 8u) +
+                                (uint64_t)u8Ctrl + 1u);
+        }
+
+        rInit = *cprInit;
+        rInit.pvPortCtx = &prNode->rSim;
+        eError = GPTP_GptpInitInst(&prNode->rGptp, &rInit);
+
+        if (GPTP_ERR_OK == eError)
+        {
+            saprNodes[u8Node] = prNode;
+            su8Nodes++;
+            if (NULL != pu8NodeIdx)
+            {
+                *pu8NodeIdx = u8Node;
+            }
+
+            /* Spread the timer phases of the nodes. */
+            (void)GPTP_PORT_SimNetEventNew(su64NowNs + (((uint64_t)srConf.u32TimerPeriodNs * u8Node) /
+                                                        GPTP_PORT_SIMNET_NODES_MAX),
+                                           GPTP_PORT_SIMNET_EV_TIMER, u8Node);
+
+            /* Initialization frames. */
+            GPTP_PORT_SimNetService(u8Node);
+        }
+        (void)GPTP_PORT_SimNodeSelect(prPrevious);
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function connects two node controllers by a link.
+ *
+ * @param[in]       cprLink Pointer to the link parameters.
+ *
+ * @return          Error status.
+*/
+gptp_err_type_t GPTP_PORT_SimNetLinkAdd(const gptp_port_simnet_link_t *cprLink)
+{
+    gptp_err_type_t eError;
+    uint8_t         u8Link;
+
+    if (NULL == cprLink)
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else if ((su8Links >= GPTP_PORT_SIMNET_LINKS_MAX) ||
+             (cprLink->u8NodeA >= su8Nodes) || (cprLink->u8NodeB >= su8Nodes) ||
+             (cprLink->u8CtrlA >= GPTP_PORT_SIM_CTRL_MAX) || (cprLink->u8CtrlB >= GPTP_PORT_SIM_CTRL_MAX) ||
+             ((cprLink->u8NodeA == cprLink->u8NodeB) && (cprLink->u8CtrlA == cprLink->u8CtrlB)))
+    {
+        eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+    }
+    else
+    {
+        eError = GPTP_ERR_OK;
+
+        /* A controller has a single link. */
+        for (u8Link = 0u; u8Link < su8Links; u8Link++)
+        {
+            if (((cprLink->u8NodeA == sarLinks[u8Link].u8NodeA) && (cprLink->u8CtrlA == sarLinks[u8Link].u8CtrlA)) ||
+                ((cprLink->u8NodeA == sarLinks[u8Link].u8NodeB) && (cprLink->u8CtrlA == sarLinks[u8Link].u8CtrlB)) ||
+                ((cprLink->u8NodeB == sarLinks[u8Link].u8NodeA) && (cprLink->u8CtrlB == sarLinks[u8Link].u8CtrlA)) ||
+                ((cprLink->u8NodeB == sarLinks[u8Link].u8NodeB) && (cprLink->u8CtrlB == sarLinks[u8Link].u8CtrlB)))
+            {
+                eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+            }
+        }
+
+        if (GPTP_ERR_OK == eError)
+        {
+            sarLinks[su8Links] = *cprLink;
+            sau64LastArrivalNs[su8Links][0u] = 0u;
+            sau64LastArrivalNs[su8Links][1u] = 0u;
+            su8Links++;
+        }
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function runs the simulated network.
+ *
+ * @param[in]       u64DurationNs Duration to run [ns].
+*/
+void GPTP_PORT_SimNetRun(uint64_t u64DurationNs)
+{
+    gptp_port_sim_node_t *prPrevious;
+    uint64_t             u64EndNs;
+    uint64_t             u64StepNs;
+    uint16_t             u16Event;
+    uint8_t              u8Node;
+
+    prPrevious = GPTP_PORT_SimNodeSelect(NULL);
+    u64EndNs = su64NowNs + u64DurationNs;
+
+    while (su64NowNs < u64EndNs)
+    {
+        /* Next event or the end of the run. */
+        u64StepNs = u64EndNs;
+        if ((0u != su16HeapCount) && (sarEvents[sau16Heap[0u]].u64TimeNs < u64EndNs))
+        {
+            u64StepNs = sarEvents[sau16Heap[0u]].u64TimeNs;
+        }
+
+        if (u64StepNs > su64NowNs)
+        {
+            for (u8Node = 0u; u8Node < su8Nodes; u8Node++)
+            {
+                (void)GPTP_PORT_SimNodeSelect(&saprNodes[u8Node]->rSim);
+                GPTP_PORT_IncFreeRunningTimer(u64StepNs - su64NowNs);
+            }
+            su64NowNs = u64StepNs;
+        }
+
+        /* All the events due now, including those scheduled meanwhile. */
+        while ((0u != su16HeapCount) && (sarEvents[sau16Heap[0u]].u64TimeNs <= su64NowNs) &&
+               (su64NowNs < u64EndNs))
+        {
+            u16Event = GPTP_PORT_SimNetEventPop();
+            GPTP_PORT_SimNetProcess(u16Event);
+        }
+    }
+
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+}
+
+/*!
+ * @brief           This function returns the true time.
+ *
+ * @return          Time since GPTP_PORT_SimNetInit [ns].
+*/
+uint64_t GPTP_PORT_SimNetTimeGet(void)
+{
+    return su64NowNs;
+}
+
+/*!
+ * @brief           This function returns the current true time error.
+ *
+ * @param[in]       u8Node Node index.
+ *
+ * @return          Time error [ns], 0 for the unknown node.
+*/
+int64_t GPTP_PORT_SimNetTimeErrorGet(uint8_t u8Node)
+{
+    int64_t s64ErrNs;
+
+    s64ErrNs = 0;
+
+    if ((u8Node < su8Nodes) && (srConf.u8RefNode < su8Nodes))
+    {
+        s64ErrNs = GPTP_PORT_SimNetClockNs(saprNodes[u8Node]) -
+                   GPTP_PORT_SimNetClockNs(saprNodes[srConf.u8RefNode]);
+    }
+
+    return s64ErrNs;
+}
+
+/*!
+ * @brief           This function provides the sampled time error statistics.
+ *
+ * @param[in]       u8Node Node index.
+ * @param[out]      prStats Pointer to the statistics placeholder.
+ *
+ * @return          Error status.
+*/
+gptp_err_type_t GPTP_PORT_SimNetStatsGet(uint8_t u8Node,
+                                         gptp_port_simnet_stats_t *prStats)
+{
+    const gptp_port_simnet_node_t *cprNode;
+    gptp_err_type_t               eError;
+    float64_t                     f64Samples;
+
+    if (NULL == prStats)
+    {
+        eError = GPTP_ERR_V_NULL_PTR;
+    }
+    else if (u8Node >= su8Nodes)
+    {
+        eError = GPTP_ERR_API_ILLEGAL_PORT_NUM;
+    }
+    else
+    {
+        cprNode = saprNodes[u8Node];
+        *prStats = cprNode->rStats;
+        prStats->f64MeanNs = 0.0;
+        prStats->f64RmsNs = 0.0;
+
+        if (0u != cprNode->rStats.u32Samples)
+        {
+            f64Samples = (float64_t)cprNode->rStats.u32Samples;
+            prStats->f64MeanNs = cprNode->f64ErrSum / f64Samples;
+            prStats->f64RmsNs = sqrt(cprNode->f64ErrSumSq / f64Samples);
+        }
+        else
+        {
+            prStats->s64MinNs = 0;
+            prStats->s64MaxNs = 0;
+        }
+        eError = GPTP_ERR_OK;
+    }
+
+    return eError;
+}
+
+/*!
+ * @brief           This function clears the time error statistics of all nodes.
+*/
+void GPTP_PORT_SimNetStatsClear(void)
+{
+    uint8_t u8Node;
+
+    for (u8Node = 0u; u8Node < su8Nodes; u8Node++)
+    {
+        saprNodes[u8Node]->rStats.u32Samples = 0u;
+        saprNodes[u8Node]->f64ErrSum = 0.0;
+        saprNodes[u8Node]->f64ErrSumSq = 0.0;
+    }
+}
+
+/*!
+ * @brief           This function returns count of the frames lost on links.
+ *
+ * @return          Count of the lost frames.
+*/
+uint32_t GPTP_PORT_SimNetLostGet(void)
+{
+    return su32Lost;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
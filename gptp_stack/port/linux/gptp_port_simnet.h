@@ -0,0 +1,266 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef GPTP_PORT_SIMNET_H
+#define GPTP_PORT_SIMNET_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+#include "gptp_port_platform.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Maximal count of the simulated network nodes. */
+#ifndef GPTP_PORT_SIMNET_NODES_MAX
+#define GPTP_PORT_SIMNET_NODES_MAX      (32u)
+#endif
+/*! Maximal count of the simulated links. */
+#ifndef GPTP_PORT_SIMNET_LINKS_MAX
+#define GPTP_PORT_SIMNET_LINKS_MAX      (64u)
+#endif
+/*! Maximal count of the pending events (frames in flight and timers). */
+#ifndef GPTP_PORT_SIMNET_EVENTS_MAX
+#define GPTP_PORT_SIMNET_EVENTS_MAX     (1024u)
+#endif
+/*! Default period of GPTP_TimerPeriodic of every node [ns]. */
+#define GPTP_PORT_SIMNET_TIMER_NS_DEF   (1000000u)
+/*! Default period of the time error sampling [ns]. */
+#define GPTP_PORT_SIMNET_SAMPLE_NS_DEF  (10000000u)
+/*! Default period of the oscillator wander update [ns]. */
+#define GPTP_PORT_SIMNET_WANDER_NS_DEF  (100000000u)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Simulated network configuration.
+ */
+typedef struct
+{
+    /*! Seed of the pseudo-random jitter, loss and wander, 0 selects 1. */
+    uint64_t                            u64Seed;
+    /*! Period of GPTP_TimerPeriodic of every node [ns], 0 for the default. */
+    uint32_t                            u32TimerPeriodNs;
+    /*! Period of the time error sampling [ns], 0 for the default. */
+    uint32_t                            u32SamplePeriodNs;
+    /*! Period of the oscillator wander update [ns], 0 for the default. */
+    uint32_t                            u32WanderPeriodNs;
+    /*! Node the time errors are measured against (typically the GM). */
+    uint8_t                             u8RefNode;
+    /*! The application completes the asynchronous NVM reads by
+        GPTP_PORT_SimNvmReadService, otherwise they are completed in
+        the next timer period. */
+    bool                                bNvmReadByApp;
+}gptp_port_simnet_conf_t;
+
+/*!
+ * @brief Oscillator of the simulated node.
+ */
+typedef struct
+{
+    /*! Constant frequency offset [ppb], positive runs faster. */
+    int32_t                             s32FreqOffsetPpb;
+    /*! Random walk of the frequency, standard deviation per second [ppb]. */
+    float64_t                           f64WanderPpb;
+    /*! Offset of the PTP clock to the true time at the start [ns]. */
+    int64_t                             s64InitOffsetNs;
+}gptp_port_simnet_osc_t;
+
+/*!
+ * @brief Simulated full duplex link between two controllers.
+ */
+typedef struct
+{
+    /*! Node and controller of the A end. */
+    uint8_t                             u8NodeA;
+    uint8_t                             u8CtrlA;
+    /*! Node and controller of the B end. */
+    uint8_t                             u8NodeB;
+    uint8_t                             u8CtrlB;
+    /*! Mean propagation delay [ns]. */
+    uint32_t                            u32DelayNs;
+    /*! Delay A to B minus delay B to A [ns]. */
+    int32_t                             s32AsymmetryNs;
+    /*! Maximal random delay added to every frame [ns], uniform. */
+    uint32_t                            u32JitterNs;
+    /*! Probability of a frame loss [ppm]. */
+    uint32_t                            u32LossPpm;
+}gptp_port_simnet_link_t;
+
+/*!
+ * @brief True time error statistics of a node.
+ */
+typedef struct
+{
+    /*! Count of samples since the last clear. */
+    uint32_t                            u32Samples;
+    /*! Last sampled time error [ns]. */
+    int64_t                             s64LastNs;
+    int64_t                             s64MinNs;
+    int64_t                             s64MaxNs;
+    /*! Mean and RMS of the sampled time errors [ns]. */
+    float64_t                           f64MeanNs;
+    float64_t                           f64RmsNs;
+}gptp_port_simnet_stats_t;
+
+/*!
+ * @brief Simulated network node.
+ *
+ * @details Provided by the application, must stay valid while the network
+ *          runs. Filled by GPTP_PORT_SimNetNodeAdd.
+ */
+typedef struct
+{
+    /*! Stack instance of the node. */
+    gptp_def_data_t                     rGptp;
+    /*! Simulated platform of the node. */
+    gptp_port_sim_node_t                rSim;
+    gptp_port_simnet_osc_t              rOsc;
+    /*! Current random walk part of the frequency offset [ppb]. */
+    float64_t                           f64WanderPpb;
+    /* Sums of the sampled time errors. */
+    float64_t                           f64ErrSum;
+    float64_t                           f64ErrSumSq;
+    gptp_port_simnet_stats_t            rStats;
+}gptp_port_simnet_node_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function initializes the simulated network.
+ *
+ * @details         Removes all nodes and links and sets the true time to 0.
+ *
+ * @param[in]       cprConf Pointer to the configuration, NULL for defaults.
+*/
+void GPTP_PORT_SimNetInit(const gptp_port_simnet_conf_t *cprConf);
+
+/*!
+ * @brief           This function adds a node to the simulated network.
+ *
+ * @details         Resets the simulated platform of the node, assigns unique
+ *                  MAC addresses, applies the oscillator and initializes
+ *                  the stack instance with the node as pvPortCtx. The node
+ *                  index is the order of addition.
+ *
+ * @param[out]      prNode Pointer to the node placeholder.
+ * @param[in]       cprOsc Pointer to the oscillator, NULL for an ideal one.
+ * @param[in]       cprInit Pointer to the stack initialization parameters.
+ * @param[out]      pu8NodeIdx Pointer to the node index placeholder or NULL.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The node was added.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_API_ILLEGAL_PORT_NUM: No free node.
+ * @retval          Other: Error of GPTP_GptpInitInst.
+*/
+gptp_err_type_t GPTP_PORT_SimNetNodeAdd(gptp_port_simnet_node_t *prNode,
+                                        const gptp_port_simnet_osc_t *cprOsc,
+                                        const gptp_def_init_params_t *cprInit,
+                                        uint8_t *pu8NodeIdx);
+
+/*!
+ * @brief           This function connects two node controllers by a link.
+ *
+ * @param[in]       cprLink Pointer to the link parameters.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The link was added.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_API_ILLEGAL_PORT_NUM: Unknown node or controller,
+ *                  controller already connected or no free link.
+*/
+gptp_err_type_t GPTP_PORT_SimNetLinkAdd(const gptp_port_simnet_link_t *cprLink);
+
+/*!
+ * @brief           This function runs the simulated network.
+ *
+ * @details         Processes all the events due within the duration in
+ *                  the time order. Every transmitted frame is timestamped
+ *                  on egress and delivered to the link peer after the link
+ *                  delay, where it is timestamped on ingress and passed to
+ *                  the stack by GPTP_PORT_RxIndication. The egress timestamps
+ *                  are confirmed by GPTP_PORT_TxConfirmation.
+ *
+ * @param[in]       u64DurationNs Duration to run [ns].
+*/
+void GPTP_PORT_SimNetRun(uint64_t u64DurationNs);
+
+/*!
+ * @brief           This function returns the true time.
+ *
+ * @return          Time since GPTP_PORT_SimNetInit [ns].
+*/
+uint64_t GPTP_PORT_SimNetTimeGet(void);
+
+/*!
+ * @brief           This function returns the current true time error.
+ *
+ * @details         The PTP clock of the node minus the PTP clock of
+ *                  the reference node at the same true time.
+ *
+ * @param[in]       u8Node Node index.
+ *
+ * @return          Time error [ns], 0 for the unknown node.
+*/
+int64_t GPTP_PORT_SimNetTimeErrorGet(uint8_t u8Node);
+
+/*!
+ * @brief           This function provides the sampled time error statistics.
+ *
+ * @param[in]       u8Node Node index.
+ * @param[out]      prStats Pointer to the statistics placeholder.
+ *
+ * @return          Error status.
+ * @retval          GPTP_ERR_OK: The statistics were provided.
+ * @retval          GPTP_ERR_V_NULL_PTR: Invalid input arguments.
+ * @retval          GPTP_ERR_API_ILLEGAL_PORT_NUM: Unknown node.
+*/
+gptp_err_type_t GPTP_PORT_SimNetStatsGet(uint8_t u8Node,
+                                         gptp_port_simnet_stats_t *prStats);
+
+/*!
+ * @brief           This function clears the time error statistics of all nodes.
+ *
+ * @details         Typically called after the network has converged.
+*/
+void GPTP_PORT_SimNetStatsClear(void);
+
+/*!
+ * @brief           This function returns count of the frames lost on links.
+ *
+ * @return          Frames dropped by the loss probability or by a full
+ *                  event queue since GPTP_PORT_SimNetInit.
+*/
+uint32_t GPTP_PORT_SimNetLostGet(void);
+
+#endif /* GPTP_PORT_SIMNET_H */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,299 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_frame.c
+ *
+ * @details Host test of the TX frame templates (GPTP_TX_TEMPLATES). Every
+ *          message type is built repeatedly into one TX buffer, which after
+ *          the first transmission only patches the template, and into
+ *          a buffer built completely by each transmission. Between
+ *          the transmissions the fields, which the stack changes for
+ *          the same machine, are set to pseudo-random values: sequence ID,
+ *          intervals, timestamps, correction, rate ratio, GM change
+ *          information, requesting port, VLAN TCI and destination MAC.
+ *          The Signaling template of the domain also moves between
+ *          the ports with the slave port.
+ *
+ *          A scenario fails when any pair of the frames differs in its length
+ *          or content. The scenarios run with and without VLAN, with and
+ *          without the SdoId compatibility mode.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -DGPTP_TX_TEMPLATES -Igptp_stack/port/linux
+ *              -Igptp_stack/port -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c
+ *              gptp_stack/test/gptp_test_frame.c -o gptp_test_frame -lm
+ *
+ *          Usage: gptp_test_frame [-n transmissions] [-s seed]
+ *
+ *          Exits with EXIT_FAILURE if any scenario fails.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gptp_def.h"
+#include "gptp_frame.h"
+
+#ifndef GPTP_TX_TEMPLATES
+#error "gptp_test_frame needs the GPTP_TX_TEMPLATES build"
+#endif /* GPTP_TX_TEMPLATES */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Default count of the transmissions per scenario. */
+#define GPTP_TEST_FRAME_TX_DEF          (10000u)
+/*! Count of the gPTP ports. */
+#define GPTP_TEST_FRAME_PORTS           (2u)
+/*! Size of the TX buffers, the largest frame with VLAN. */
+#define GPTP_TEST_FRAME_BUF_LEN         (GPTP_DEF_TX_BUF_LEN_FUP)
+/*! Fill of the buffer built completely, no byte may be left. */
+#define GPTP_TEST_FRAME_FILL            (0xA5u)
+/*! Count of the tested message types. */
+#define GPTP_TEST_FRAME_MSG_TYPES       (6u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Tested message type.
+ */
+typedef struct
+{
+    const char                          *pcName;
+    gptp_def_msg_type_t                 eMsgId;
+}gptp_test_frame_msg_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint64_t GPTP_TEST_FRAME_Rand(void);
+static void GPTP_TEST_FRAME_Randomize(gptp_def_tx_data_t *prTxData,
+                                      gptp_def_domain_t *prDomain,
+                                      gptp_def_pdelay_t *prPdelay,
+                                      uint8_t *pu8Port);
+static bool GPTP_TEST_FRAME_Scenario(const gptp_test_frame_msg_t *cprMsg,
+                                     bool bVlan,
+                                     bool bSdoCompat,
+                                     uint32_t u32Tx);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint64_t                         su64Seed = 1u;
+
+static const gptp_test_frame_msg_t      scarMsgs[GPTP_TEST_FRAME_MSG_TYPES] =
+{
+    {"sync", GPTP_DEF_MSG_TYPE_SYNC},
+    {"follow up", GPTP_DEF_MSG_TYPE_FOLLOW_UP},
+    {"pdelay request", GPTP_DEF_MSG_TYPE_PD_REQ},
+    {"pdelay response", GPTP_DEF_MSG_TYPE_PD_RESP},
+    {"pdelay response follow up", GPTP_DEF_MSG_TYPE_PD_RESP_FUP},
+    {"signaling", GPTP_DEF_MSG_TYPE_SIGNALING}
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns a pseudo-random number.
+ * @return          64-bit number (xorshift64*).
+*/
+static uint64_t GPTP_TEST_FRAME_Rand(void)
+{
+    su64Seed ^= su64Seed >> 12u;
+    su64Seed ^= su64Seed << 25u;
+    su64Seed ^= su64Seed >> 27u;
+
+    return su64Seed * 2685821657736338717ull;
+}
+
+/*!
+ * @brief           This function sets the fields changed between
+ *                  the transmissions to pseudo-random values.
+ * @param[in,out]   prTxData Pointer to the TX data.
+ * @param[in,out]   prDomain Pointer to the domain.
+ * @param[in,out]   prPdelay Pointer to the Pdelay machines.
+ * @param[in,out]   pu8Port gPTP port of the transmission, changed for
+ *                  the Signaling only.
+*/
+static void GPTP_TEST_FRAME_Randomize(gptp_def_tx_data_t *prTxData,
+                                      gptp_def_domain_t *prDomain,
+                                      gptp_def_pdelay_t *prPdelay,
+                                      uint8_t *pu8Port)
+{
+    if (GPTP_DEF_MSG_TYPE_SIGNALING == prTxData->eMsgId)
+    {
+        *pu8Port = (uint8_t)(GPTP_TEST_FRAME_Rand() % GPTP_TEST_FRAME_PORTS);
+    }
+
+    prTxData->rSrcPortID.u64ClockId = GPTP_TEST_FRAME_Rand();
+    prTxData->rSrcPortID.u16PortId = (uint16_t)(*pu8Port + 1u);
+    prTxData->u16SequenceId = (uint16_t)GPTP_TEST_FRAME_Rand();
+    prTxData->s8LogMessagePeriod = (int8_t)((int64_t)(GPTP_TEST_FRAME_Rand() % 17u) - 8);
+    prTxData->u16VlanTci = (uint16_t)GPTP_TEST_FRAME_Rand();
+    prTxData->u64DestMac = GPTP_TEST_FRAME_Rand() & 0xFFFFFFFFFFFFull;
+    prTxData->rTs.u64TimeStampS = GPTP_TEST_FRAME_Rand() & 0xFFFFFFFFFFFFull;
+    prTxData->rTs.u32TimeStampNs = (uint32_t)(GPTP_TEST_FRAME_Rand() % GPTP_DEF_NS_IN_SECONDS);
+    prTxData->u64CorrectionSubNs = GPTP_TEST_FRAME_Rand() >> 8u;
+    prTxData->f64RateRatio = 1.0 + ((float64_t)((int64_t)(GPTP_TEST_FRAME_Rand() % 200001u) - 100000) * 1.0e-9);
+    prTxData->rRequesting.u64ClockId = GPTP_TEST_FRAME_Rand();
+    prTxData->rRequesting.u16PortId = (uint16_t)GPTP_TEST_FRAME_Rand();
+    prTxData->u8SubdomainNumber = (uint8_t)GPTP_TEST_FRAME_Rand();
+
+    prDomain->u16GmTimeBaseIndicator = (uint16_t)GPTP_TEST_FRAME_Rand();
+    prDomain->u32LastGmPhaseChangeH = (uint32_t)GPTP_TEST_FRAME_Rand();
+    prDomain->u64LastGmPhaseChangeL = GPTP_TEST_FRAME_Rand();
+    prDomain->u32ScaledLastGmFreqChange = (uint32_t)GPTP_TEST_FRAME_Rand();
+
+    prPdelay[*pu8Port].rPdReqMsgRx.u8MajorSdoId = (uint8_t)(GPTP_TEST_FRAME_Rand() & 0x0Fu);
+}
+
+/*!
+ * @brief           This function runs one scenario.
+ * @param[in]       cprMsg Pointer to the tested message type.
+ * @param[in]       bVlan VLAN enabled.
+ * @param[in]       bSdoCompat SdoId compatibility mode enabled.
+ * @param[in]       u32Tx Count of the transmissions.
+ * @return          true if the scenario passed.
+*/
+static bool GPTP_TEST_FRAME_Scenario(const gptp_test_frame_msg_t *cprMsg,
+                                     bool bVlan,
+                                     bool bSdoCompat,
+                                     uint32_t u32Tx)
+{
+    static gptp_def_port_t   arPort[GPTP_TEST_FRAME_PORTS];
+    static gptp_def_pdelay_t arPdelay[GPTP_TEST_FRAME_PORTS];
+    static gptp_def_domain_t rDomain;
+    gptp_def_data_t          rGptp;
+    gptp_def_tx_data_t       rTemplate;
+    gptp_def_tx_data_t       rFull;
+    uint8_t                  au8Template[GPTP_TEST_FRAME_BUF_LEN];
+    uint8_t                  au8Full[GPTP_TEST_FRAME_BUF_LEN];
+    uint32_t                 u32Idx;
+    uint32_t                 u32Failed;
+    uint8_t                  u8Port;
+
+    memset(&rGptp, 0, sizeof(rGptp));
+    memset(arPort, 0, sizeof(arPort));
+    memset(arPdelay, 0, sizeof(arPdelay));
+    memset(&rDomain, 0, sizeof(rDomain));
+    arPort[0].rSourceMac.u48Mac = 0x0004A3000001ull;
+    arPort[1].rSourceMac.u48Mac = 0x0004A3000002ull;
+    rDomain.u8DomainNumber = 3u;
+    rGptp.rPerDeviceParams.bVlanEnabled = bVlan;
+    rGptp.rPerDeviceParams.bSdoIdCompatibilityMode = bSdoCompat;
+    rGptp.prPerPortParams = arPort;
+    rGptp.prPdelayMachines = arPdelay;
+    rGptp.prPerDomainParams = &rDomain;
+
+    memset(&rTemplate, 0, sizeof(rTemplate));
+    memset(au8Template, 0, sizeof(au8Template));
+    rTemplate.eMsgId = cprMsg->eMsgId;
+    rTemplate.pau8TxBuffPtr = au8Template;
+    rTemplate.bTemplateValid = false;
+    u8Port = 1u;
+    u32Failed = 0u;
+
+    for (u32Idx = 0u; u32Idx < u32Tx; u32Idx++)
+    {
+        GPTP_TEST_FRAME_Randomize(&rTemplate, &rDomain, arPdelay, &u8Port);
+        GPTP_FRAME_BuildTx(&rGptp, &rTemplate, 0u, u8Port);
+
+        /* The same fields into a buffer built completely */
+        rFull = rTemplate;
+        memset(au8Full, GPTP_TEST_FRAME_FILL, sizeof(au8Full));
+        rFull.pau8TxBuffPtr = au8Full;
+        rFull.bTemplateValid = false;
+        GPTP_FRAME_BuildTx(&rGptp, &rFull, 0u, u8Port);
+
+        if ((rTemplate.u8FrameLength != rFull.u8FrameLength) || \
+            (0 != memcmp(au8Template, au8Full, rFull.u8FrameLength)))
+        {
+            if (0u == u32Failed)
+            {
+                printf("  transmission %u, port %u differs\n", u32Idx, u8Port);
+            }
+            u32Failed++;
+        }
+    }
+
+    printf("%s, %s VLAN, %s SdoId compatibility: %s\n", cprMsg->pcName, bVlan ? "with" : "without",
+           bSdoCompat ? "with" : "without", (0u == u32Failed) ? "pass" : "FAIL");
+
+    return (0u == u32Failed);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t u32Tx;
+    uint32_t u32Failed;
+    uint8_t  u8Msg;
+    uint8_t  u8Mode;
+    int      sOpt;
+
+    u32Tx = GPTP_TEST_FRAME_TX_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "n:s:")))
+    {
+        switch (sOpt)
+        {
+            case 'n':
+                u32Tx = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 's':
+                su64Seed = strtoull(optarg, NULL, 0);
+                su64Seed = (0u == su64Seed) ? 1u : su64Seed;
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n transmissions] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    u32Failed = 0u;
+    for (u8Mode = 0u; u8Mode < 4u; u8Mode++)
+    {
+        for (u8Msg = 0u; u8Msg < GPTP_TEST_FRAME_MSG_TYPES; u8Msg++)
+        {
+            if (false == GPTP_TEST_FRAME_Scenario(&scarMsgs[u8Msg], (0u != (u8Mode & 1u)), (0u != (u8Mode & 2u)), u32Tx))
+            {
+                u32Failed++;
+            }
+        }
+    }
+
+    printf("%u scenario(s) failed\n", u32Failed);
+
+    return (0u == u32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,445 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_fxp.c
+ *
+ * @details Host test of the fixed-point arithmetic (gptp_fxp.h) against
+ *          the long double references. The interval division (UDivQ32) is
+ *          reached through GPTP_FXP_RatioCalc and GPTP_FXP_RatioDiv,
+ *          the ratio multiplication (UMulQ32) through GPTP_FXP_RatioMul.
+ *          Every kernel runs the edge inputs (zero and maximal operands,
+ *          negative values and gains) and pseudo-random inputs in the range
+ *          used by the stack.
+ *
+ *          A case fails when the result is further from the reference than
+ *          the rounding of the kernel allows or when the error exceeds 1 ns,
+ *          for the rate ratios 1 ns per second of the measured interval.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -DGPTP_FIXED_POINT -Igptp_stack/port/linux
+ *              -Igptp_stack/port -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c
+ *              gptp_stack/test/gptp_test_fxp.c -o gptp_test_fxp -lm
+ *
+ *          Usage: gptp_test_fxp [-n random cases] [-s seed]
+ *
+ *          Exits with EXIT_FAILURE if any case fails.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "gptp_def.h"
+#include "gptp_fxp.h"
+
+#ifndef GPTP_FIXED_POINT
+#error "gptp_test_fxp needs the GPTP_FIXED_POINT build"
+#endif /* GPTP_FIXED_POINT */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Default count of the pseudo-random cases per kernel. */
+#define GPTP_TEST_FXP_CASES_DEF         (1000000u)
+/*! Maximal allowed error [ns]. */
+#define GPTP_TEST_FXP_MAX_ERR_NS        (1.0L)
+/*! Tolerance of the long double reference [steps]. */
+#define GPTP_TEST_FXP_REF_EPS           (1.0e-3L)
+/*! Nanoseconds in one second. */
+#define GPTP_TEST_FXP_NS_IN_S           (1000000000.0L)
+/*! Maximal denominator of the interval division. */
+#define GPTP_TEST_FXP_DEN_MAX           ((1ull << 47u) - 1u)
+/*! Maximal absolute gain of the gain multiplication in Q16. */
+#define GPTP_TEST_FXP_GAIN_MAX          (((int64_t)1 << 32u) - 1)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Results of a tested kernel.
+ */
+typedef struct
+{
+    const char                          *pcName;
+    uint32_t                            u32Cases;
+    uint32_t                            u32Failed;
+    /*! Maximal error [ns]. */
+    long double                         f80MaxErrNs;
+}gptp_test_fxp_result_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint64_t GPTP_TEST_FXP_Rand(void);
+static int64_t GPTP_TEST_FXP_RandRange(int64_t s64Min,
+                                       int64_t s64Max);
+static void GPTP_TEST_FXP_Check(gptp_test_fxp_result_t *prResult,
+                                long double f80ErrSteps,
+                                long double f80AllowedSteps,
+                                long double f80ErrNs,
+                                const char *pcCase);
+static void GPTP_TEST_FXP_RatioCalc(gptp_test_fxp_result_t *prResult,
+                                    uint64_t u64Numerator,
+                                    uint64_t u64Denominator);
+static void GPTP_TEST_FXP_RatioMul(gptp_test_fxp_result_t *prResult,
+                                   int64_t s64ValueQ16,
+                                   int64_t s64Ratio);
+static void GPTP_TEST_FXP_RatioDiv(gptp_test_fxp_result_t *prResult,
+                                   int64_t s64ValueQ16,
+                                   int64_t s64Ratio);
+static void GPTP_TEST_FXP_Average(gptp_test_fxp_result_t *prResult,
+                                  int64_t s64AverageQ16,
+                                  int64_t s64SampleQ16,
+                                  uint32_t u32WeightQ16);
+static void GPTP_TEST_FXP_GainMul(gptp_test_fxp_result_t *prResult,
+                                  int32_t s32Value,
+                                  int64_t s64GainQ16);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint64_t                         su64Seed = 1u;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns a pseudo-random number.
+ * @return          64-bit number (xorshift64*).
+*/
+static uint64_t GPTP_TEST_FXP_Rand(void)
+{
+    su64Seed ^= su64Seed >> 12u;
+    su64Seed ^= su64Seed << 25u;
+    su64Seed ^= su64Seed >> 27u;
+
+    return su64Seed * 2685821657736338717ull;
+}
+
+/*!
+ * @brief           This function returns a pseudo-random number in the range.
+ * @param[in]       s64Min Minimal value.
+ * @param[in]       s64Max Maximal value.
+ * @return          Number in the range s64Min - s64Max.
+*/
+static int64_t GPTP_TEST_FXP_RandRange(int64_t s64Min,
+                                       int64_t s64Max)
+{
+    return s64Min + (int64_t)(GPTP_TEST_FXP_Rand() % ((uint64_t)(s64Max - s64Min) + 1u));
+}
+
+/*!
+ * @brief           This function evaluates one case.
+ * @param[in,out]   prResult Pointer to the kernel results.
+ * @param[in]       f80ErrSteps Absolute error in the steps of the result format.
+ * @param[in]       f80AllowedSteps Error allowed by the rounding of the kernel.
+ * @param[in]       f80ErrNs Absolute error [ns].
+ * @param[in]       pcCase Case description printed on the failure.
+*/
+static void GPTP_TEST_FXP_Check(gptp_test_fxp_result_t *prResult,
+                                long double f80ErrSteps,
+                                long double f80AllowedSteps,
+                                long double f80ErrNs,
+                                const char *pcCase)
+{
+    prResult->u32Cases++;
+
+    if (f80ErrNs > prResult->f80MaxErrNs)
+    {
+        prResult->f80MaxErrNs = f80ErrNs;
+    }
+
+    if ((f80ErrSteps > (f80AllowedSteps + GPTP_TEST_FXP_REF_EPS)) || (f80ErrNs > GPTP_TEST_FXP_MAX_ERR_NS))
+    {
+        if (prResult->u32Failed < 10u)
+        {
+            fprintf(stderr, "%s: %s, error %.6Lf steps %.6Lf ns\n", prResult->pcName, pcCase,
+                    f80ErrSteps, f80ErrNs);
+        }
+        prResult->u32Failed++;
+    }
+}
+
+/*!
+ * @brief           This function tests the rate ratio of two intervals.
+ * @details         The result is truncated, the error of the ratio is
+ *                  converted to ns per second of the interval.
+ * @param[in,out]   prResult Pointer to the kernel results.
+ * @param[in]       u64Numerator Numerator interval [ns].
+ * @param[in]       u64Denominator Denominator interval [ns].
+*/
+static void GPTP_TEST_FXP_RatioCalc(gptp_test_fxp_result_t *prResult,
+                                    uint64_t u64Numerator,
+                                    uint64_t u64Denominator)
+{
+    char        acCase[96];
+    long double f80Ref;
+    long double f80Err;
+    int64_t     s64Ratio;
+
+    s64Ratio = GPTP_FXP_RatioCalc(u64Numerator, u64Denominator);
+    f80Ref = ((long double)u64Numerator / (long double)u64Denominator) * (long double)GPTP_FXP_Q32_ONE;
+    f80Err = f80Ref - (long double)s64Ratio;
+
+    (void)snprintf(acCase, sizeof(acCase), "%llu / %llu",
+                   (unsigned long long)u64Numerator, (unsigned long long)u64Denominator);
+    /* Truncated, the reference is never below the result */
+    GPTP_TEST_FXP_Check(prResult, (0.0L > f80Err) ? (1.0L - f80Err) : f80Err, 1.0L,
+                        ((0.0L > f80Err) ? -f80Err : f80Err) * (GPTP_TEST_FXP_NS_IN_S / (long double)GPTP_FXP_Q32_ONE),
+                        acCase);
+}
+
+/*!
+ * @brief           This function tests the multiplication by the rate ratio.
+ * @param[in,out]   prResult Pointer to the kernel results.
+ * @param[in]       s64ValueQ16 Value in Q48.16 [ns].
+ * @param[in]       s64Ratio Rate ratio in Q32.32.
+*/
+static void GPTP_TEST_FXP_RatioMul(gptp_test_fxp_result_t *prResult,
+                                   int64_t s64ValueQ16,
+                                   int64_t s64Ratio)
+{
+    char        acCase[96];
+    long double f80Ref;
+    long double f80Err;
+
+    f80Ref = ((long double)s64ValueQ16 * (long double)s64Ratio) / (long double)GPTP_FXP_Q32_ONE;
+    f80Err = f80Ref - (long double)GPTP_FXP_RatioMul(s64ValueQ16, s64Ratio);
+    f80Err = (0.0L > f80Err) ? -f80Err : f80Err;
+
+    (void)snprintf(acCase, sizeof(acCase), "%lld * %lld",
+                   (long long)s64ValueQ16, (long long)s64Ratio);
+    GPTP_TEST_FXP_Check(prResult, f80Err, 0.5L, f80Err / (long double)GPTP_FXP_Q16_ONE, acCase);
+}
+
+/*!
+ * @brief           This function tests the division by the rate ratio.
+ * @param[in,out]   prResult Pointer to the kernel results.
+ * @param[in]       s64ValueQ16 Value in Q48.16 [ns].
+ * @param[in]       s64Ratio Rate ratio in Q32.32.
+*/
+static void GPTP_TEST_FXP_RatioDiv(gptp_test_fxp_result_t *prResult,
+                                   int64_t s64ValueQ16,
+                                   int64_t s64Ratio)
+{
+    char        acCase[96];
+    long double f80Ref;
+    long double f80Err;
+
+    f80Ref = ((long double)s64ValueQ16 / (long double)s64Ratio) * (long double)GPTP_FXP_Q32_ONE;
+    f80Err = f80Ref - (long double)GPTP_FXP_RatioDiv(s64ValueQ16, s64Ratio);
+    f80Err = (0.0L > f80Err) ? -f80Err : f80Err;
+
+    (void)snprintf(acCase, sizeof(acCase), "%lld / %lld",
+                   (long long)s64ValueQ16, (long long)s64Ratio);
+    /* Truncated towards zero */
+    GPTP_TEST_FXP_Check(prResult, f80Err, 1.0L, f80Err / (long double)GPTP_FXP_Q16_ONE, acCase);
+}
+
+/*!
+ * @brief           This function tests the exponential averaging.
+ * @param[in,out]   prResult Pointer to the kernel results.
+ * @param[in]       s64AverageQ16 Previous average in Q48.16 [ns].
+ * @param[in]       s64SampleQ16 New sample in Q48.16 [ns].
+ * @param[in]       u32WeightQ16 Weight of the previous average in Q16.
+*/
+static void GPTP_TEST_FXP_Average(gptp_test_fxp_result_t *prResult,
+                                  int64_t s64AverageQ16,
+                                  int64_t s64SampleQ16,
+                                  uint32_t u32WeightQ16)
+{
+    char        acCase[96];
+    long double f80Weight;
+    long double f80Ref;
+    long double f80Err;
+
+    f80Weight = (long double)u32WeightQ16 / (long double)GPTP_FXP_Q16_ONE;
+    f80Ref = (f80Weight * (long double)s64AverageQ16) + ((1.0L - f80Weight) * (long double)s64SampleQ16);
+    f80Err = f80Ref - (long double)GPTP_FXP_Average(s64AverageQ16, s64SampleQ16, u32WeightQ16);
+    f80Err = (0.0L > f80Err) ? -f80Err : f80Err;
+
+    (void)snprintf(acCase, sizeof(acCase), "avg %lld sample %lld weight %u",
+                   (long long)s64AverageQ16, (long long)s64SampleQ16, u32WeightQ16);
+    GPTP_TEST_FXP_Check(prResult, f80Err, 0.5L, f80Err / (long double)GPTP_FXP_Q16_ONE, acCase);
+}
+
+/*!
+ * @brief           This function tests the multiplication by the gain.
+ * @details         The reference is truncated towards zero and saturated the same
+ *                  way, the value is in ns (PI error) or ppb (servo output).
+ * @param[in,out]   prResult Pointer to the kernel results.
+ * @param[in]       s32Value Value to be multiplied.
+ * @param[in]       s64GainQ16 Gain in Q16.
+*/
+static void GPTP_TEST_FXP_GainMul(gptp_test_fxp_result_t *prResult,
+                                  int32_t s32Value,
+                                  int64_t s64GainQ16)
+{
+    char        acCase[96];
+    long double f80Ref;
+    long double f80Err;
+
+    f80Ref = ((long double)s32Value * (long double)s64GainQ16) / (long double)GPTP_FXP_Q16_ONE;
+    if ((long double)GPTP_DEF_INT32_MAX < f80Ref)
+    {
+        f80Ref = (long double)GPTP_DEF_INT32_MAX;
+    }
+    else if ((long double)GPTP_DEF_INT32_MIN > f80Ref)
+    {
+        f80Ref = (long double)GPTP_DEF_INT32_MIN;
+    }
+    else
+    {
+        /* In range */
+    }
+    f80Err = f80Ref - (long double)GPTP_FXP_GainMul(s32Value, s64GainQ16);
+    f80Err = (0.0L > f80Err) ? -f80Err : f80Err;
+
+    (void)snprintf(acCase, sizeof(acCase), "%d * %lld", (int)s32Value, (long long)s64GainQ16);
+    GPTP_TEST_FXP_Check(prResult, f80Err, 1.0L, f80Err, acCase);
+}
+
+int main(int argc, char *argv[])
+{
+    gptp_test_fxp_result_t arResults[5] = {{"ratio_calc", 0u, 0u, 0.0L}, {"ratio_mul", 0u, 0u, 0.0L},
+                                           {"ratio_div", 0u, 0u, 0.0L}, {"average", 0u, 0u, 0.0L},
+                                           {"gain_mul", 0u, 0u, 0.0L}};
+    uint64_t               u64Den;
+    int64_t                s64Ratio;
+    int64_t                s64Value;
+    uint32_t               u32Cases;
+    uint32_t               u32Case;
+    uint32_t               u32Failed;
+    uint8_t                u8Kernel;
+    int                    sOpt;
+
+    u32Cases = GPTP_TEST_FXP_CASES_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "n:s:")))
+    {
+        switch (sOpt)
+        {
+            case 'n':
+                u32Cases = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 's':
+                su64Seed = strtoull(optarg, NULL, 0);
+                su64Seed = (0u == su64Seed) ? 1u : su64Seed;
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n random cases] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    /* Interval division, edge inputs */
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 0u, 1u);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 0u, GPTP_TEST_FXP_DEN_MAX);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 1u, GPTP_TEST_FXP_DEN_MAX);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], GPTP_TEST_FXP_DEN_MAX, GPTP_TEST_FXP_DEN_MAX);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], GPTP_TEST_FXP_DEN_MAX - 1u, GPTP_TEST_FXP_DEN_MAX);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 0x7FFFFFFFu, 1u);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 1u, 3u);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 1000000001u, 1000000000u);
+    GPTP_TEST_FXP_RatioCalc(&arResults[0], 999999999u, 1000000000u);
+
+    /* Ratio multiplication, edge inputs */
+    GPTP_TEST_FXP_RatioMul(&arResults[1], 0, GPTP_FXP_Q32_ONE);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], INT64_MAX, 0);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], INT64_MAX, GPTP_FXP_Q32_ONE);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], -INT64_MAX, GPTP_FXP_Q32_ONE);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], INT64_MAX, GPTP_FXP_Q32_ONE - 1);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], INT64_MAX, -(GPTP_FXP_Q32_ONE / 2));
+    GPTP_TEST_FXP_RatioMul(&arResults[1], 1, 1);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], -1, GPTP_FXP_Q32_ONE / 2);
+    GPTP_TEST_FXP_RatioMul(&arResults[1], (int64_t)1 << 40u, INT64_MAX >> 10u);
+
+    /* Ratio division, edge inputs */
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], 0, GPTP_FXP_Q32_ONE);
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], 0, (int64_t)GPTP_TEST_FXP_DEN_MAX);
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], INT64_MAX >> 16u, (int64_t)GPTP_TEST_FXP_DEN_MAX);
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], 0x7FFFFFFF, GPTP_FXP_Q32_ONE);
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], -0x7FFFFFFF, GPTP_FXP_Q32_ONE + 1);
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], 1, -GPTP_FXP_Q32_ONE);
+    GPTP_TEST_FXP_RatioDiv(&arResults[2], -((int64_t)1 << 46u), -(int64_t)GPTP_TEST_FXP_DEN_MAX);
+
+    /* Averaging, edge inputs */
+    GPTP_TEST_FXP_Average(&arResults[3], 0, 0, 0u);
+    GPTP_TEST_FXP_Average(&arResults[3], 0, (int64_t)1 << 46u, 0u);
+    GPTP_TEST_FXP_Average(&arResults[3], (int64_t)1 << 46u, 0, (uint32_t)GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_Average(&arResults[3], -((int64_t)1 << 46u), (int64_t)1 << 46u, (uint32_t)GPTP_FXP_Q16_ONE / 2u);
+    GPTP_TEST_FXP_Average(&arResults[3], (int64_t)1 << 46u, -((int64_t)1 << 46u), 1u);
+    GPTP_TEST_FXP_Average(&arResults[3], -1, 1, (uint32_t)GPTP_FXP_Q16_ONE - 1u);
+    GPTP_TEST_FXP_Average(&arResults[3], 12345, 12345, 58982u);
+
+    /* Gain multiplication, edge inputs including the saturation */
+    GPTP_TEST_FXP_GainMul(&arResults[4], 0, GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MAX, 0);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MAX, GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MIN, GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MAX, 2 * GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MAX, -2 * GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MIN, -GPTP_FXP_Q16_ONE);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MIN, GPTP_TEST_FXP_GAIN_MAX);
+    GPTP_TEST_FXP_GainMul(&arResults[4], GPTP_DEF_INT32_MAX, -GPTP_TEST_FXP_GAIN_MAX);
+    GPTP_TEST_FXP_GainMul(&arResults[4], -1, 1);
+    GPTP_TEST_FXP_GainMul(&arResults[4], 100000, -3);
+
+    for (u32Case = 0u; u32Case < u32Cases; u32Case++)
+    {
+        /* Intervals up to 2^47 ns, rate ratios within +-1000 ppm */
+        u64Den = (uint64_t)GPTP_TEST_FXP_RandRange(1, (int64_t)GPTP_TEST_FXP_DEN_MAX);
+        s64Value = GPTP_TEST_FXP_RandRange(-1000000, 1000000);
+        GPTP_TEST_FXP_RatioCalc(&arResults[0], u64Den,
+                                (uint64_t)((long double)u64Den * (1.0L + ((long double)s64Value * 1.0e-9L))) + 1u);
+
+        s64Ratio = GPTP_FXP_Q32_ONE + GPTP_TEST_FXP_RandRange(-(GPTP_FXP_Q32_ONE / 1000), GPTP_FXP_Q32_ONE / 1000);
+        s64Value = GPTP_TEST_FXP_RandRange(-((int64_t)1 << 46u), (int64_t)1 << 46u);
+        GPTP_TEST_FXP_RatioMul(&arResults[1], s64Value, s64Ratio);
+        GPTP_TEST_FXP_RatioDiv(&arResults[2], s64Value, s64Ratio);
+
+        GPTP_TEST_FXP_Average(&arResults[3], s64Value, GPTP_TEST_FXP_RandRange(-((int64_t)1 << 46u), (int64_t)1 << 46u),
+                              (uint32_t)GPTP_TEST_FXP_RandRange(0, GPTP_FXP_Q16_ONE));
+
+        GPTP_TEST_FXP_GainMul(&arResults[4], (int32_t)GPTP_TEST_FXP_RandRange(GPTP_DEF_INT32_MIN, GPTP_DEF_INT32_MAX),
+                              GPTP_TEST_FXP_RandRange(-(int64_t)64 * GPTP_FXP_Q16_ONE, (int64_t)64 * GPTP_FXP_Q16_ONE));
+    }
+
+    u32Failed = 0u;
+    for (u8Kernel = 0u; u8Kernel < 5u; u8Kernel++)
+    {
+        printf("%-12s cases %8u failed %u max error %.6Lf ns\n", arResults[u8Kernel].pcName,
+               arResults[u8Kernel].u32Cases, arResults[u8Kernel].u32Failed, arResults[u8Kernel].f80MaxErrNs);
+        u32Failed += arResults[u8Kernel].u32Failed;
+    }
+
+    return (0u == u32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
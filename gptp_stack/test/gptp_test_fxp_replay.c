@@ -0,0 +1,591 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_fxp_replay.c
+ *
+ * @details Host test of the fixed-point build (GPTP_FIXED_POINT) against
+ *          the floating-point build on the same recorded input. The two
+ *          builds can not share one binary, the test is built as both and
+ *          exchanges a reference file (gptp_trace.h, gptp_port_replay.h).
+ *
+ *          With -w, a GM and a slave are connected by one link on
+ *          the simulated network (gptp_port_simnet.h), the slave starts with
+ *          the given offset to the GM. The run of the slave is traced for
+ *          each servo type, the trace is replayed into a fresh instance and
+ *          the estimated GM offset and the filtered Pdelay of the replayed
+ *          instance are sampled at every call of GPTP_TimerPeriodic. The
+ *          traces and the samples are written to the reference file.
+ *
+ *          With -r, every trace of the reference file is replayed and
+ *          sampled the same way. A scenario fails when the GM offset or
+ *          the Pdelay differs from the reference by more than
+ *          GPTP_TEST_FXP_REPLAY_MAX_ERR_NS at any sample, when the counts
+ *          of the samples differ or when an egress timestamp of the trace
+ *          was not matched to a frame transmitted by the replayed instance.
+ *
+ *          Build, the floating-point and the fixed-point binary:
+ *
+ *          gcc -std=gnu99 -O2 -DGPTP_TRACE_CAPTURE [-DGPTP_FIXED_POINT]
+ *              -Igptp_stack/port/linux -Igptp_stack/port
+ *              -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c gptp_stack/test/gptp_test_node.c
+ *              gptp_stack/test/gptp_test_fxp_replay.c -o gptp_test_fxp_replay -lm
+ *
+ *          Usage: gptp_test_fxp_replay -w reference [-o initial offset ns] [-t seconds]
+ *                 gptp_test_fxp_replay -r reference
+ *
+ *          Typically the floating-point binary writes the reference and
+ *          the fixed-point binary reads it. Exits with EXIT_FAILURE if any
+ *          scenario fails or the reference file can not be used.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gptp.h"
+#include "gptp_def.h"
+#include "gptp_trace.h"
+#include "gptp_port_platform.h"
+#include "gptp_port_replay.h"
+#include "gptp_port_simnet.h"
+#include "gptp_test_node.h"
+
+#ifndef GPTP_TRACE_CAPTURE
+#error "gptp_test_fxp_replay needs the GPTP_TRACE_CAPTURE build"
+#endif /* GPTP_TRACE_CAPTURE */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Nodes of the run, the GM and the traced slave. */
+#define GPTP_TEST_FXP_REPLAY_NODES      (2u)
+/*! Clock identity base of the nodes. */
+#define GPTP_TEST_FXP_REPLAY_CLOCK_ID   (0x020000FFFE040000u)
+/*! Default initial offset of the slave to the GM [ns]. */
+#define GPTP_TEST_FXP_REPLAY_OFFSET_DEF (300000000)
+/*! Default run time [s]. */
+#define GPTP_TEST_FXP_REPLAY_TIME_S_DEF (60u)
+/*! Capacity of the trace stream [bytes]. */
+#define GPTP_TEST_FXP_REPLAY_TRACE_MAX  (16u * 1024u * 1024u)
+/*! Capacity of the samples, one per call of GPTP_TimerPeriodic. */
+#define GPTP_TEST_FXP_REPLAY_SAMPLES_MAX (800000u)
+/*! Frequency offset of the slave oscillator, the replayed node gets the same [ppb]. */
+#define GPTP_TEST_FXP_REPLAY_SLAVE_PPB  (20000)
+/*! Maximal difference of the GM offset and of the Pdelay [ns]. */
+#define GPTP_TEST_FXP_REPLAY_MAX_ERR_NS (1.0)
+/*! Count of the scenarios, one per servo type. */
+#define GPTP_TEST_FXP_REPLAY_SCENARIOS  (2u)
+/*! Identification of the reference file. */
+#define GPTP_TEST_FXP_REPLAY_MAGIC      (0x46585052u)
+#define GPTP_TEST_FXP_REPLAY_NS_IN_S    (1000000000u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Outputs of the replayed instance at the call of GPTP_TimerPeriodic.
+ */
+typedef struct
+{
+    /*! Estimated GM offset [ns]. */
+    int64_t                             s64OffsetNs;
+    /*! Filtered Pdelay [ns]. */
+    float64_t                           f64PathDelayNs;
+}gptp_test_fxp_replay_sample_t;
+
+/*!
+ * @brief Scenario header of the reference file, followed by the trace and
+ *        the samples.
+ */
+typedef struct
+{
+    uint32_t                            u32Magic;
+    uint32_t                            u32Servo;
+    uint32_t                            u32TraceLength;
+    uint32_t                            u32SampleCount;
+    /*! Initial offset of the traced slave clock [ns]. */
+    int64_t                             s64InitOffsetNs;
+    /*! Addresses of the traced slave. */
+    uint64_t                            au64Mac[GPTP_PORT_SIM_CTRL_MAX];
+}gptp_test_fxp_replay_hdr_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void GPTP_TEST_FXP_REPLAY_RecordWrite(const uint8_t *cpu8Data,
+                                             uint16_t u16Length);
+static void GPTP_TEST_FXP_REPLAY_SampleWrite(const uint8_t *cpu8Data,
+                                             uint16_t u16Length);
+static bool GPTP_TEST_FXP_REPLAY_Replay(const gptp_test_fxp_replay_hdr_t *cprHdr);
+static bool GPTP_TEST_FXP_REPLAY_Record(gptp_def_servo_type_t eServo,
+                                        int64_t s64OffsetNs,
+                                        uint32_t u32TimeS);
+static bool GPTP_TEST_FXP_REPLAY_Compare(const gptp_test_fxp_replay_sample_t *cprRef,
+                                         uint32_t u32RefCount);
+static int GPTP_TEST_FXP_REPLAY_Write(const char *cpcPath,
+                                      int64_t s64OffsetNs,
+                                      uint32_t u32TimeS);
+static int GPTP_TEST_FXP_REPLAY_Read(const char *cpcPath);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static gptp_test_node_t                 sarNodes[GPTP_TEST_FXP_REPLAY_NODES];
+/* Node of the replayed instance, not part of the simulated network */
+static gptp_test_node_t                 srReplayNode;
+
+/* Trace stream of the run */
+static uint8_t                          sau8Trace[GPTP_TEST_FXP_REPLAY_TRACE_MAX];
+static uint32_t                         su32TraceLength;
+static bool                             sbOverflow;
+
+/* Instance being sampled by the trace writer of the replay */
+static gptp_def_data_t                  *sprSampled;
+/* Samples of the replay and the reference samples */
+static gptp_test_fxp_replay_sample_t    sarSamples[GPTP_TEST_FXP_REPLAY_SAMPLES_MAX];
+static uint32_t                         su32SampleCount;
+static gptp_test_fxp_replay_sample_t    sarReference[GPTP_TEST_FXP_REPLAY_SAMPLES_MAX];
+
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           Trace writer of the run, stores the stream.
+ * @param[in]       cpu8Data Pointer to the record.
+ * @param[in]       u16Length Length of the record.
+*/
+static void GPTP_TEST_FXP_REPLAY_RecordWrite(const uint8_t *cpu8Data,
+                                             uint16_t u16Length)
+{
+    if ((su32TraceLength + u16Length) > GPTP_TEST_FXP_REPLAY_TRACE_MAX)
+    {
+        sbOverflow = true;
+    }
+    else
+    {
+        memcpy(&sau8Trace[su32TraceLength], cpu8Data, u16Length);
+        su32TraceLength += u16Length;
+    }
+}
+
+/*!
+ * @brief           Trace writer of the replay, samples the replayed
+ *                  instance at every tick record.
+ * @param[in]       cpu8Data Pointer to the record.
+ * @param[in]       u16Length Length of the record.
+*/
+static void GPTP_TEST_FXP_REPLAY_SampleWrite(const uint8_t *cpu8Data,
+                                             uint16_t u16Length)
+{
+    gptp_test_fxp_replay_sample_t *prSample;
+
+    /* The stream header is shorter than any record */
+    if ((u16Length >= GPTP_DEF_TRACE_REC_LEN) && ((uint8_t)GPTP_DEF_TRACE_REC_TICK == cpu8Data[0u]))
+    {
+        if (su32SampleCount < GPTP_TEST_FXP_REPLAY_SAMPLES_MAX)
+        {
+            prSample = &sarSamples[su32SampleCount];
+            prSample->s64OffsetNs = (sprSampled->rPerDeviceParams.rEstimGmOffset.s64TimeStampS * (int64_t)GPTP_TEST_FXP_REPLAY_NS_IN_S) +
+                                    (int64_t)sprSampled->rPerDeviceParams.rEstimGmOffset.s32TimeStampNs;
+            prSample->f64PathDelayNs = sprSampled->prPdelayMachines[0u].f64NeighborPropDelay;
+            su32SampleCount++;
+        }
+        else
+        {
+            sbOverflow = true;
+        }
+    }
+}
+
+/*!
+ * @brief           This function replays the trace into a fresh instance of
+ *                  the slave and samples its outputs.
+ * @param[in]       cprHdr Pointer to the scenario header.
+ * @return          true if the whole trace was replayed.
+*/
+static bool GPTP_TEST_FXP_REPLAY_Replay(const gptp_test_fxp_replay_hdr_t *cprHdr)
+{
+    gptp_port_replay_t   rReplay;
+    gptp_port_sim_node_t *prPrevious;
+    gptp_port_sim_node_t *prSim;
+    bool                 bPassed;
+    uint8_t              u8Ctrl;
+
+    bPassed = true;
+    GPTP_TEST_NODE_Setup(&srReplayNode, GPTP_TEST_FXP_REPLAY_CLOCK_ID + 1u, 1u, false,
+                         (gptp_def_servo_type_t)cprHdr->u32Servo);
+    prSim = &srReplayNode.rNet.rSim;
+    srReplayNode.rInit.pvPortCtx = prSim;
+
+    /* Same clock and addresses as the traced node, the NVM content is the initial one of both */
+    prPrevious = GPTP_PORT_SimNodeSelect(prSim);
+    GPTP_PORT_SimInit();
+    GPTP_PORT_SimClockDriftSet(GPTP_TEST_FXP_REPLAY_SLAVE_PPB);
+    GPTP_PORT_SimClockCorrect(cprHdr->s64InitOffsetNs, 0);
+    for (u8Ctrl = 0u; u8Ctrl < GPTP_PORT_SIM_CTRL_MAX; u8Ctrl++)
+    {
+        GPTP_PORT_SimMacSet(u8Ctrl, cprHdr->au64Mac[u8Ctrl]);
+    }
+
+    su32SampleCount = 0u;
+    sbOverflow = false;
+    if (GPTP_ERR_OK != GPTP_PORT_ReplayOpen(&rReplay, sau8Trace, su32TraceLength))
+    {
+        printf("  trace not accepted\n");
+        bPassed = false;
+    }
+    else
+    {
+        /* The replayed instance is traced only to sample it at its ticks */
+        sprSampled = &srReplayNode.rNet.rGptp;
+        GPTP_TRACE_Start(sprSampled, GPTP_TEST_FXP_REPLAY_SampleWrite);
+
+        if (GPTP_ERR_OK != GPTP_GptpInitInst(sprSampled, &srReplayNode.rInit))
+        {
+            printf("  replayed instance not initialized\n");
+            bPassed = false;
+        }
+        else
+        {
+            (void)GPTP_PORT_ReplayRun(&rReplay, sprSampled, 0u);
+        }
+        GPTP_TRACE_Stop();
+
+        printf("  replay rx=%u tx=%u ticks=%u unmatched=%u\n", rReplay.rStats.u32Rx,
+               rReplay.rStats.u32Tx, rReplay.rStats.u32Ticks, rReplay.rStats.u32Unmatched);
+
+        if ((0u == rReplay.rStats.u32Rx) || (0u == rReplay.rStats.u32Tx) ||
+            (0u != rReplay.rStats.u32Unmatched) || (true == sbOverflow))
+        {
+            bPassed = false;
+        }
+    }
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+
+    return bPassed;
+}
+
+/*!
+ * @brief           This function traces the run of the slave.
+ * @param[in]       eServo Servo type of the slave.
+ * @param[in]       s64OffsetNs Initial offset of the slave to the GM [ns].
+ * @param[in]       u32TimeS Run time [s].
+ * @return          true if the slave synchronized and the trace is complete.
+*/
+static bool GPTP_TEST_FXP_REPLAY_Record(gptp_def_servo_type_t eServo,
+                                        int64_t s64OffsetNs,
+                                        uint32_t u32TimeS)
+{
+    gptp_port_simnet_osc_t  arOsc[GPTP_TEST_FXP_REPLAY_NODES];
+    gptp_port_simnet_link_t rLink;
+    gptp_port_sim_node_t    *prPrevious;
+    uint8_t                 u8Node;
+
+    su32TraceLength = 0u;
+    sbOverflow = false;
+    GPTP_PORT_SimNetInit(NULL);
+
+    for (u8Node = 0u; u8Node < GPTP_TEST_FXP_REPLAY_NODES; u8Node++)
+    {
+        GPTP_TEST_NODE_Setup(&sarNodes[u8Node], GPTP_TEST_FXP_REPLAY_CLOCK_ID + u8Node, 1u,
+                             (0u == u8Node), eServo);
+    }
+
+    /* The capture starts before the initialization, at the time the node joins */
+    prPrevious = GPTP_PORT_SimNodeSelect(&sarNodes[1u].rNet.rSim);
+    GPTP_PORT_SimInit();
+    GPTP_TRACE_Start(&sarNodes[1u].rNet.rGptp, GPTP_TEST_FXP_REPLAY_RecordWrite);
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+
+    arOsc[0u].s32FreqOffsetPpb = 0;
+    arOsc[0u].f64WanderPpb = 0.0;
+    arOsc[0u].s64InitOffsetNs = 0;
+    arOsc[1u].s32FreqOffsetPpb = GPTP_TEST_FXP_REPLAY_SLAVE_PPB;
+    arOsc[1u].f64WanderPpb = 0.0;
+    arOsc[1u].s64InitOffsetNs = s64OffsetNs;
+    for (u8Node = 0u; u8Node < GPTP_TEST_FXP_REPLAY_NODES; u8Node++)
+    {
+        if (GPTP_ERR_OK != GPTP_PORT_SimNetNodeAdd(&sarNodes[u8Node].rNet, &arOsc[u8Node], &sarNodes[u8Node].rInit, NULL))
+        {
+            GPTP_TRACE_Stop();
+            printf("  setup failed\n");
+            return false;
+        }
+    }
+
+    memset(&rLink, 0, sizeof(rLink));
+    rLink.u8NodeA = 0u;
+    rLink.u8CtrlA = 0u;
+    rLink.u8NodeB = 1u;
+    rLink.u8CtrlB = 0u;
+    rLink.u32DelayNs = 500u;
+    rLink.u32JitterNs = 40u;
+    if (GPTP_ERR_OK != GPTP_PORT_SimNetLinkAdd(&rLink))
+    {
+        GPTP_TRACE_Stop();
+        printf("  setup failed\n");
+        return false;
+    }
+
+    GPTP_PORT_SimNetRun((uint64_t)u32TimeS * GPTP_TEST_FXP_REPLAY_NS_IN_S);
+    GPTP_TRACE_Stop();
+
+    printf("  recorded %u bytes\n", su32TraceLength);
+
+    return (false == sbOverflow) && (true == sarNodes[1u].rNet.rGptp.rPerDeviceParams.bSynced);
+}
+
+/*!
+ * @brief           This function compares the samples of the replay with
+ *                  the reference.
+ * @param[in]       cprRef Pointer to the reference samples.
+ * @param[in]       u32RefCount Count of the reference samples.
+ * @return          true if every sample is within the allowed difference.
+*/
+static bool GPTP_TEST_FXP_REPLAY_Compare(const gptp_test_fxp_replay_sample_t *cprRef,
+                                         uint32_t u32RefCount)
+{
+    float64_t f64OffsetErr;
+    float64_t f64DelayErr;
+    float64_t f64MaxOffsetErr;
+    float64_t f64MaxDelayErr;
+    uint32_t  u32Sample;
+    uint32_t  u32Mismatches;
+
+    f64MaxOffsetErr = 0.0;
+    f64MaxDelayErr = 0.0;
+    u32Mismatches = 0u;
+
+    for (u32Sample = 0u; (u32Sample < su32SampleCount) && (u32Sample < u32RefCount); u32Sample++)
+    {
+        f64OffsetErr = (float64_t)(sarSamples[u32Sample].s64OffsetNs - cprRef[u32Sample].s64OffsetNs);
+        f64OffsetErr = (f64OffsetErr < 0.0) ? -f64OffsetErr : f64OffsetErr;
+        f64DelayErr = sarSamples[u32Sample].f64PathDelayNs - cprRef[u32Sample].f64PathDelayNs;
+        f64DelayErr = (f64DelayErr < 0.0) ? -f64DelayErr : f64DelayErr;
+
+        f64MaxOffsetErr = (f64OffsetErr > f64MaxOffsetErr) ? f64OffsetErr : f64MaxOffsetErr;
+        f64MaxDelayErr = (f64DelayErr > f64MaxDelayErr) ? f64DelayErr : f64MaxDelayErr;
+
+        if ((f64OffsetErr > GPTP_TEST_FXP_REPLAY_MAX_ERR_NS) || (f64DelayErr > GPTP_TEST_FXP_REPLAY_MAX_ERR_NS))
+        {
+            if (0u == u32Mismatches)
+            {
+                printf("  first mismatch at tick %u: offset %lld/%lld ns, pdelay %.3f/%.3f ns\n", u32Sample,
+                       (long long)sarSamples[u32Sample].s64OffsetNs, (long long)cprRef[u32Sample].s64OffsetNs,
+                       sarSamples[u32Sample].f64PathDelayNs, cprRef[u32Sample].f64PathDelayNs);
+            }
+            u32Mismatches++;
+        }
+    }
+
+    printf("  %u ticks, max difference offset %.3f ns, pdelay %.3f ns, mismatches %u\n",
+           su32SampleCount, f64MaxOffsetErr, f64MaxDelayErr, u32Mismatches);
+
+    if (su32SampleCount != u32RefCount)
+    {
+        printf("  %u ticks in the reference\n", u32RefCount);
+    }
+
+    return (0u == u32Mismatches) && (su32SampleCount == u32RefCount);
+}
+
+/*!
+ * @brief           This function records the scenarios and writes
+ *                  the reference file.
+ * @param[in]       cpcPath Path of the reference file.
+ * @param[in]       s64OffsetNs Initial offset of the slave to the GM [ns].
+ * @param[in]       u32TimeS Run time [s].
+ * @return          EXIT_SUCCESS if all scenarios were written.
+*/
+static int GPTP_TEST_FXP_REPLAY_Write(const char *cpcPath,
+                                      int64_t s64OffsetNs,
+                                      uint32_t u32TimeS)
+{
+    gptp_test_fxp_replay_hdr_t rHdr;
+    FILE                       *prFile;
+    uint32_t                   u32Scenario;
+    bool                       bPassed;
+
+    prFile = fopen(cpcPath, "wb");
+    if (NULL == prFile)
+    {
+        printf("%s can not be written\n", cpcPath);
+        return EXIT_FAILURE;
+    }
+
+    bPassed = true;
+    for (u32Scenario = 0u; (u32Scenario < GPTP_TEST_FXP_REPLAY_SCENARIOS) && (true == bPassed); u32Scenario++)
+    {
+        printf("%s servo, initial offset %lld ns\n", (GPTP_DEF_SERVO_PI == (gptp_def_servo_type_t)u32Scenario) ? "PI" : "Kalman",
+               (long long)s64OffsetNs);
+
+        bPassed = GPTP_TEST_FXP_REPLAY_Record((gptp_def_servo_type_t)u32Scenario, s64OffsetNs, u32TimeS);
+
+        if (true == bPassed)
+        {
+            memset(&rHdr, 0, sizeof(rHdr));
+            rHdr.u32Magic = GPTP_TEST_FXP_REPLAY_MAGIC;
+            rHdr.u32Servo = u32Scenario;
+            rHdr.u32TraceLength = su32TraceLength;
+            rHdr.s64InitOffsetNs = s64OffsetNs;
+            memcpy(rHdr.au64Mac, sarNodes[1u].rNet.rSim.au64Mac, sizeof(rHdr.au64Mac));
+            bPassed = GPTP_TEST_FXP_REPLAY_Replay(&rHdr);
+        }
+
+        if (true == bPassed)
+        {
+            rHdr.u32SampleCount = su32SampleCount;
+            bPassed = (1u == fwrite(&rHdr, sizeof(rHdr), 1u, prFile)) &&
+                      (1u == fwrite(sau8Trace, su32TraceLength, 1u, prFile)) &&
+                      (su32SampleCount == fwrite(sarSamples, sizeof(sarSamples[0u]), su32SampleCount, prFile));
+        }
+
+        printf("  %s\n", bPassed ? "written" : "FAIL");
+    }
+
+    if (0 != fclose(prFile))
+    {
+        bPassed = false;
+    }
+
+    return (true == bPassed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*!
+ * @brief           This function replays the scenarios of the reference file
+ *                  and compares them with the reference.
+ * @param[in]       cpcPath Path of the reference file.
+ * @return          EXIT_SUCCESS if all scenarios passed.
+*/
+static int GPTP_TEST_FXP_REPLAY_Read(const char *cpcPath)
+{
+    gptp_test_fxp_replay_hdr_t rHdr;
+    FILE                       *prFile;
+    uint32_t                   u32Scenarios;
+    uint32_t                   u32Failed;
+    bool                       bPassed;
+
+    prFile = fopen(cpcPath, "rb");
+    if (NULL == prFile)
+    {
+        printf("%s can not be read\n", cpcPath);
+        return EXIT_FAILURE;
+    }
+
+    u32Scenarios = 0u;
+    u32Failed = 0u;
+    while (1u == fread(&rHdr, sizeof(rHdr), 1u, prFile))
+    {
+        if ((GPTP_TEST_FXP_REPLAY_MAGIC != rHdr.u32Magic) || (GPTP_TEST_FXP_REPLAY_TRACE_MAX < rHdr.u32TraceLength) ||
+            (GPTP_TEST_FXP_REPLAY_SAMPLES_MAX < rHdr.u32SampleCount) ||
+            (1u != fread(sau8Trace, rHdr.u32TraceLength, 1u, prFile)) ||
+            (rHdr.u32SampleCount != fread(sarReference, sizeof(sarReference[0u]), rHdr.u32SampleCount, prFile)))
+        {
+            printf("%s is not a reference file\n", cpcPath);
+            u32Failed++;
+            break;
+        }
+
+        printf("%s servo\n", (GPTP_DEF_SERVO_PI == (gptp_def_servo_type_t)rHdr.u32Servo) ? "PI" : "Kalman");
+        su32TraceLength = rHdr.u32TraceLength;
+
+        bPassed = GPTP_TEST_FXP_REPLAY_Replay(&rHdr) &&
+                  GPTP_TEST_FXP_REPLAY_Compare(sarReference, rHdr.u32SampleCount);
+        printf("  %s\n", bPassed ? "pass" : "FAIL");
+
+        u32Scenarios++;
+        if (false == bPassed)
+        {
+            u32Failed++;
+        }
+    }
+    (void)fclose(prFile);
+
+    if (0u == u32Scenarios)
+    {
+        printf("%s holds no scenario\n", cpcPath);
+        u32Failed++;
+    }
+
+    printf("%u scenario(s) failed\n", u32Failed);
+
+    return (0u == u32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *cpcWrite;
+    const char *cpcRead;
+    int64_t    s64OffsetNs;
+    uint32_t   u32TimeS;
+    int        sOpt;
+
+    cpcWrite = NULL;
+    cpcRead = NULL;
+    s64OffsetNs = GPTP_TEST_FXP_REPLAY_OFFSET_DEF;
+    u32TimeS = GPTP_TEST_FXP_REPLAY_TIME_S_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "w:r:o:t:")))
+    {
+        switch (sOpt)
+        {
+            case 'w':
+                cpcWrite = optarg;
+            break;
+
+            case 'r':
+                cpcRead = optarg;
+            break;
+
+            case 'o':
+                s64OffsetNs = (int64_t)strtoll(optarg, NULL, 0);
+            break;
+
+            case 't':
+                u32TimeS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            default:
+                cpcWrite = NULL;
+                cpcRead = NULL;
+            break;
+        }
+    }
+
+    if ((NULL == cpcWrite) == (NULL == cpcRead))
+    {
+        fprintf(stderr, "usage: %s -w reference [-o initial offset ns] [-t seconds]\n"
+                        "       %s -r reference\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return (NULL != cpcWrite) ? GPTP_TEST_FXP_REPLAY_Write(cpcWrite, s64OffsetNs, u32TimeS) :
+                                GPTP_TEST_FXP_REPLAY_Read(cpcRead);
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
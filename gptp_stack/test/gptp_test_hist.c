@@ -0,0 +1,278 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_hist.c
+ *
+ * @details Host test of the latency histograms measured against the hardware
+ *          timestamps (GPTP_DEF_HIST_RX_DISPATCH, GPTP_DEF_HIST_TX_EGRESS)
+ *          across the clock steps, on the simulated network
+ *          (gptp_port_simnet.h). A GM and a slave are connected by one link.
+ *          The slave starts with the given offset to the GM, steps its clock
+ *          at the first synchronization and, once locked, its PTP clock is
+ *          moved by the opposite offset and stepped back by the stack.
+ *
+ *          Every scenario fails when no latency was measured on a node or
+ *          when any measured latency exceeds GPTP_TEST_HIST_MAX_NS. The
+ *          histograms are read by the instance API, the error of the illegal
+ *          read has to be logged by the node's own instance only.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -DGPTP_COUNTERS -Igptp_stack/port/linux
+ *              -Igptp_stack/port -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c gptp_stack/test/gptp_test_node.c
+ *              gptp_stack/test/gptp_test_hist.c -o gptp_test_hist -lm
+ *
+ *          Usage: gptp_test_hist [-o initial offset ns] [-t seconds]
+ *
+ *          Exits with EXIT_FAILURE if any scenario fails.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gptp.h"
+#include "gptp_def.h"
+#include "gptp_port_platform.h"
+#include "gptp_port_simnet.h"
+#include "gptp_test_node.h"
+
+#ifndef GPTP_COUNTERS
+#error "gptp_test_hist needs the GPTP_COUNTERS build"
+#endif /* GPTP_COUNTERS */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Nodes of the test, the GM and the slave. */
+#define GPTP_TEST_HIST_NODES            (2u)
+/*! Clock identity base of the nodes. */
+#define GPTP_TEST_HIST_CLOCK_ID         (0x020000FFFE020000u)
+/*! Default initial offset of the slave to the GM [ns]. */
+#define GPTP_TEST_HIST_OFFSET_NS_DEF    (300000000)
+/*! Default run time before and after the step of the locked slave [s]. */
+#define GPTP_TEST_HIST_TIME_S_DEF       (30u)
+/*! Maximal plausible latency on the simulated network [ns]. */
+#define GPTP_TEST_HIST_MAX_NS           (10000000u)
+#define GPTP_TEST_HIST_NS_IN_S          (1000000000u)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static bool GPTP_TEST_HIST_Check(uint8_t u8Node);
+static bool GPTP_TEST_HIST_Scenario(int64_t s64OffsetNs,
+                                    uint32_t u32TimeS);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const char *const scapcHistNames[GPTP_DEF_HIST_PORT_CNT] =
+{
+    "turnaround_init", "turnaround_resp", "rx_dispatch", "tx_egress"
+};
+
+static gptp_test_node_t                 sarNodes[GPTP_TEST_HIST_NODES];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function checks the port histograms of a node.
+ * @param[in]       u8Node Node index.
+ * @return          true if the latencies against the hardware timestamps
+ *                  were measured and all are plausible.
+*/
+static bool GPTP_TEST_HIST_Check(uint8_t u8Node)
+{
+    gptp_def_histogram_t    rHist;
+    gptp_def_data_t         *prGptp;
+    gptp_def_data_t         *prOther;
+    bool                    bPassed;
+    uint16_t                u16OtherErrs;
+    uint8_t                 u8Hist;
+
+    bPassed = true;
+    prGptp = &sarNodes[u8Node].rNet.rGptp;
+    prOther = &sarNodes[(0u == u8Node) ? 1u : 0u].rNet.rGptp;
+
+    for (u8Hist = 0u; u8Hist < GPTP_DEF_HIST_PORT_CNT; u8Hist++)
+    {
+        if (GPTP_ERR_OK != GPTP_GetHistogramInst(prGptp, 0xFFFFu, 0u, (gptp_def_hist_id_t)u8Hist, &rHist))
+        {
+            printf("  node %u %-16s read failed\n", u8Node, scapcHistNames[u8Hist]);
+            bPassed = false;
+            continue;
+        }
+        printf("  node %u %-16s n=%-6u max=%llu ns\n", u8Node, scapcHistNames[u8Hist],
+               rHist.u32Count, (unsigned long long)rHist.u64MaxNs);
+
+        if (rHist.u64MaxNs > GPTP_TEST_HIST_MAX_NS)
+        {
+            bPassed = false;
+        }
+        if (((GPTP_DEF_HIST_RX_DISPATCH == (gptp_def_hist_id_t)u8Hist) ||
+             (GPTP_DEF_HIST_TX_EGRESS == (gptp_def_hist_id_t)u8Hist)) &&
+            (0u == rHist.u32Count))
+        {
+            bPassed = false;
+        }
+    }
+
+    /* The illegal read is logged by the node's instance, not by the other one */
+    u16OtherErrs = GPTP_ErrLogCountGetInst(prOther);
+    (void)GPTP_ErrReadIndexInst(prOther, 0u);
+    if ((GPTP_ERR_API_ILLEGAL_PORT_NUM != GPTP_GetHistogramInst(prGptp, 0xFFFFu, 1u, GPTP_DEF_HIST_RX_DISPATCH, &rHist)) ||
+        (GPTP_ERR_API_ILLEGAL_PORT_NUM != GPTP_ErrReadIndexInst(prGptp, 0u).eErrorType) ||
+        (u16OtherErrs != GPTP_ErrLogCountGetInst(prOther)) ||
+        (true == GPTP_ErrReadIndexInst(prOther, 0u).bFreshLog))
+    {
+        printf("  node %u error not logged by its instance\n", u8Node);
+        bPassed = false;
+    }
+
+    return bPassed;
+}
+
+/*!
+ * @brief           This function runs one scenario.
+ * @param[in]       s64OffsetNs Initial offset of the slave to the GM [ns].
+ * @param[in]       u32TimeS Run time before and after the step of the
+ *                  locked slave [s].
+ * @return          true if the scenario passed.
+*/
+static bool GPTP_TEST_HIST_Scenario(int64_t s64OffsetNs,
+                                    uint32_t u32TimeS)
+{
+    gptp_port_simnet_osc_t  rOsc;
+    gptp_port_simnet_link_t rLink;
+    gptp_port_sim_node_t    *prPrevious;
+    gptp_port_sim_node_t    *prSim;
+    bool                    bPassed;
+    uint8_t                 u8Node;
+
+    printf("initial offset %lld ns\n", (long long)s64OffsetNs);
+
+    bPassed = true;
+    GPTP_PORT_SimNetInit(NULL);
+
+    for (u8Node = 0u; u8Node < GPTP_TEST_HIST_NODES; u8Node++)
+    {
+        GPTP_TEST_NODE_Setup(&sarNodes[u8Node], GPTP_TEST_HIST_CLOCK_ID + u8Node, 1u,
+                             (0u == u8Node), GPTP_DEF_SERVO_PI);
+        rOsc.s32FreqOffsetPpb = (0u == u8Node) ? 0 : 20000;
+        rOsc.f64WanderPpb = 0.0;
+        rOsc.s64InitOffsetNs = (0u == u8Node) ? 0 : s64OffsetNs;
+        if (GPTP_ERR_OK != GPTP_PORT_SimNetNodeAdd(&sarNodes[u8Node].rNet, &rOsc, &sarNodes[u8Node].rInit, NULL))
+        {
+            bPassed = false;
+        }
+    }
+
+    memset(&rLink, 0, sizeof(rLink));
+    rLink.u8NodeA = 0u;
+    rLink.u8CtrlA = 0u;
+    rLink.u8NodeB = 1u;
+    rLink.u8CtrlB = 0u;
+    rLink.u32DelayNs = 500u;
+    if ((false == bPassed) || (GPTP_ERR_OK != GPTP_PORT_SimNetLinkAdd(&rLink)))
+    {
+        printf("  setup failed\n");
+        return false;
+    }
+
+    GPTP_PORT_SimNetRun((uint64_t)u32TimeS * GPTP_TEST_HIST_NS_IN_S);
+
+    /* Move the PTP clock of the locked slave back by the initial offset */
+    prSim = &sarNodes[1u].rNet.rSim;
+    prPrevious = GPTP_PORT_SimNodeSelect(prSim);
+    GPTP_PORT_SimClockCorrect(-s64OffsetNs, prSim->rClock.s32AdjustmentPpb);
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+
+    GPTP_PORT_SimNetRun((uint64_t)u32TimeS * GPTP_TEST_HIST_NS_IN_S);
+
+    for (u8Node = 0u; u8Node < GPTP_TEST_HIST_NODES; u8Node++)
+    {
+        if (false == GPTP_TEST_HIST_Check(u8Node))
+        {
+            bPassed = false;
+        }
+    }
+    if (false == sarNodes[1u].rNet.rGptp.rPerDeviceParams.bSynced)
+    {
+        printf("  slave not synchronized\n");
+        bPassed = false;
+    }
+
+    printf("  %s\n", bPassed ? "pass" : "FAIL");
+
+    return bPassed;
+}
+
+int main(int argc, char *argv[])
+{
+    int64_t  s64OffsetNs;
+    uint32_t u32TimeS;
+    uint32_t u32Failed;
+    int      sOpt;
+
+    s64OffsetNs = GPTP_TEST_HIST_OFFSET_NS_DEF;
+    u32TimeS = GPTP_TEST_HIST_TIME_S_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "o:t:")))
+    {
+        switch (sOpt)
+        {
+            case 'o':
+                s64OffsetNs = (int64_t)strtoll(optarg, NULL, 0);
+            break;
+
+            case 't':
+                u32TimeS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-o initial offset ns] [-t seconds]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    /* Backward step first, then the forward one */
+    u32Failed = 0u;
+    if (false == GPTP_TEST_HIST_Scenario(s64OffsetNs, u32TimeS))
+    {
+        u32Failed++;
+    }
+    if (false == GPTP_TEST_HIST_Scenario(-s64OffsetNs, u32TimeS))
+    {
+        u32Failed++;
+    }
+
+    printf("%u scenario(s) failed\n", u32Failed);
+
+    return (0u == u32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
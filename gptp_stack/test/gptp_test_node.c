@@ -0,0 +1,137 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_node.c
+ *
+ * @details Stack configuration of a simulated network node, built together
+ *          with the host tests and the chain benchmark.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "gptp_test_node.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const gptp_def_pi_controller_conf_t scrPiConf = {100000u, 1.0, 12.0};
+static const gptp_def_kf_conf_t scrKfConf = {1.0, 1.0, 100.0, 0.5, 100000u};
+static const gptp_def_map_table_t scarMapTable[GPTP_TEST_NODE_PORTS_MAX] = {{0u, 0u}, {1u, 0u}};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function fills the stack configuration of a node.
+ *
+ * @details         The GM has the master port 0 only, the last node of
+ *                  a chain the slave port only. The counters are attached in
+ *                  the GPTP_COUNTERS build.
+ *
+ * @param[out]      prNode Pointer to the node.
+ * @param[in]       u64ClockId Clock identity of the node.
+ * @param[in]       u8Ports Count of gPTP ports, at most
+ *                  GPTP_TEST_NODE_PORTS_MAX.
+ * @param[in]       bGm The node is the GM.
+ * @param[in]       eServo Clock servo of the node.
+*/
+void GPTP_TEST_NODE_Setup(gptp_test_node_t *prNode,
+                          uint64_t u64ClockId,
+                          uint8_t u8Ports,
+                          bool bGm,
+                          gptp_def_servo_type_t eServo)
+{
+    gptp_def_init_params_pdel_t   *prPdel;
+    gptp_def_init_params_domain_t *prDom;
+    gptp_def_init_params_sync_t   *prSync;
+    gptp_def_init_params_t        *prInit;
+    uint8_t                       u8Port;
+
+    memset(prNode, 0, sizeof(*prNode));
+
+    for (u8Port = 0u; u8Port < u8Ports; u8Port++)
+    {
+        prPdel = &prNode->arPdelayInit[u8Port];
+        prPdel->bPdelayInitiatorEnabled = true;
+        prPdel->s8PdelIntervalLogInit = -3;
+        prPdel->s8PdelIntervalLogOper = 0;
+        prPdel->u64NeighborPropDelayThreshNs = 20000u;
+        prPdel->u16MeasurementsTillSlowDown = 50u;
+        prPdel->u16PdelLostReponsesAllowedCnt = 3u;
+        prPdel->u64ClockId = u64ClockId;
+        prPdel->prFrameMapReq = &prNode->arMapReq[u8Port];
+        prPdel->prFrameMapResp = &prNode->arMapResp[u8Port];
+        prPdel->prFrameMapReFu = &prNode->arMapReFu[u8Port];
+
+        prSync = &prNode->arSyncInit[u8Port];
+        prSync->u8GptpPort = u8Port;
+        prSync->bMachineRole = (true == bGm) || (0u != u8Port);
+        prSync->s8SyncIntervalLog = -3;
+        prSync->prFrameMapSync = &prNode->arMapSync[u8Port];
+        prSync->prFrameMapFup = &prNode->arMapFup[u8Port];
+    }
+
+    prDom = &prNode->rDomainInit;
+    prDom->u8DomainNumber = 0u;
+    prDom->u8NumberOfSyncMachines = u8Ports;
+    prDom->u8RefDomForSynced = 0u;
+    prDom->u8StartupTimeoutS = 10u;
+    prDom->u8SyncReceiptTimeoutCnt = 3u;
+    prDom->u32SyncOutlierThrNs = 100000u;
+    prDom->u8OutlierIgnoreCnt = 2u;
+    prDom->bDomainIsGm = bGm;
+    prDom->eServoType = eServo;
+    prDom->pcrDomainSyncMachinesPtr = prNode->arSyncInit;
+    prDom->prSync = prNode->arSync;
+#ifdef GPTP_COUNTERS
+    prDom->prCntrsDom = prNode->arCntrsDom;
+#endif /* GPTP_COUNTERS */
+
+    prInit = &prNode->rInit;
+    prInit->u8EthFramePrio = 7u;
+    prInit->u8GptpDomainsCount = 1u;
+    prInit->u8GptpPortsCount = u8Ports;
+    prInit->pcrPortMapTable = scarMapTable;
+    prInit->pcrPdelayMachinesParam = prNode->arPdelayInit;
+    prInit->pcrDomainsSyncsParam = &prNode->rDomainInit;
+    prInit->rSynLockParam.i64SynTrigOfst = 60;
+    prInit->rSynLockParam.i64UnsTrigOfst = 100;
+    prInit->rSynLockParam.u16SynTrigCnt = 2u;
+    prInit->rSynLockParam.u16UnsTrigCnt = 4u;
+    prInit->f64PdelAvgWeight = 0.9;
+    prInit->f64RratioAvgWeight = 0.9;
+    prInit->f64RratioMaxDev = 0.01;
+    prInit->f64PdelayNvmWriteThr = 40.0;
+    prInit->f64RratioNvmWriteThr = 0.0000001;
+    prInit->paPort = prNode->arPort;
+    prInit->paDomain = &prNode->rDomain;
+    prInit->paPdelay = prNode->arPdelay;
+    prInit->rPIControllerConfig = scrPiConf;
+    prInit->rKalmanConfig = scrKfConf;
+    prInit->u64PIControllerMaxThreshold = 50000u;
+    prInit->rPtpStackCallBacks.pfNvmWriteCB = GPTP_PORT_SimNvmWriteCB;
+    prInit->rPtpStackCallBacks.pfNvmReadCB = GPTP_PORT_SimNvmReadCB;
+#ifdef GPTP_COUNTERS
+    prInit->prCntrsPort = prNode->arCntrsPort;
+#endif /* GPTP_COUNTERS */
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
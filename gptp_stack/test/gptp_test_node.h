@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_node.h
+ *
+ * @details Stack configuration of a node of the simulated network
+ *          (gptp_port_simnet.h), shared by the host tests and the chain
+ *          benchmark. Port 0 is the slave port, port 1 the master port.
+ */
+
+/*******************************************************************************
+ * Guard Begin
+ ******************************************************************************/
+
+#ifndef GPTP_TEST_NODE_H
+#define GPTP_TEST_NODE_H
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include "gptp.h"
+#include "gptp_def.h"
+#include "gptp_port_simnet.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Maximal count of the gPTP ports of a node. */
+#define GPTP_TEST_NODE_PORTS_MAX        (2u)
+
+/*******************************************************************************
+ * Data Types
+ ******************************************************************************/
+
+/*!
+ * @brief Configuration and run-time data of a test node.
+ */
+typedef struct
+{
+    gptp_port_simnet_node_t             rNet;
+    gptp_def_port_t                     arPort[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_domain_t                   rDomain;
+    gptp_def_pdelay_t                   arPdelay[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_sync_t                     arSync[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_tx_frame_map_t             arMapSync[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_tx_frame_map_t             arMapFup[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_tx_frame_map_t             arMapReq[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_tx_frame_map_t             arMapResp[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_tx_frame_map_t             arMapReFu[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_init_params_sync_t         arSyncInit[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_init_params_domain_t       rDomainInit;
+    gptp_def_init_params_pdel_t         arPdelayInit[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_init_params_t              rInit;
+#ifdef GPTP_COUNTERS
+    gptp_def_countes_port_t             arCntrsPort[GPTP_TEST_NODE_PORTS_MAX];
+    gptp_def_countes_dom_t              arCntrsDom[GPTP_TEST_NODE_PORTS_MAX];
+#endif /* GPTP_COUNTERS */
+}gptp_test_node_t;
+
+/*******************************************************************************
+ * Externs
+ ******************************************************************************/
+/* None */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/*!
+ * @brief           This function fills the stack configuration of a node.
+ *
+ * @details         The GM has the master port 0 only, the last node of
+ *                  a chain the slave port only. The counters are attached in
+ *                  the GPTP_COUNTERS build.
+ *
+ * @param[out]      prNode Pointer to the node.
+ * @param[in]       u64ClockId Clock identity of the node.
+ * @param[in]       u8Ports Count of gPTP ports, at most
+ *                  GPTP_TEST_NODE_PORTS_MAX.
+ * @param[in]       bGm The node is the GM.
+ * @param[in]       eServo Clock servo of the node.
+*/
+void GPTP_TEST_NODE_Setup(gptp_test_node_t *prNode,
+                          uint64_t u64ClockId,
+                          uint8_t u8Ports,
+                          bool bGm,
+                          gptp_def_servo_type_t eServo);
+
+/*******************************************************************************
+ * Guard End
+ ******************************************************************************/
+
+#endif /* GPTP_TEST_NODE_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,290 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_nrr.c
+ *
+ * @details Host test of the least-squares neighbor rate ratio estimator
+ *          (gptp_nrr.h) across a gap in the Pdelay responses, e.g. a link
+ *          down. The estimator is fed by one response per second for
+ *          the given time, long enough for the neighbor minus local time to
+ *          drift far from its value at the first response. After a gap
+ *          longer than the time span of the window, the neighbor clock has
+ *          stepped and/or changed its rate, the window drains and
+ *          the estimator has to start over from the next response.
+ *
+ *          A scenario fails when a response after the gap is rejected as
+ *          an outlier, when the ratio is not valid again after the minimal
+ *          count of responses or when it is further than
+ *          GPTP_TEST_NRR_MAX_ERR from the new rate ratio of the neighbor.
+ *          Both the floating-point and the GPTP_FIXED_POINT builds apply.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -Igptp_stack/port/linux -Igptp_stack/port
+ *              -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c
+ *              gptp_stack/test/gptp_test_nrr.c -o gptp_test_nrr -lm
+ *
+ *          Usage: gptp_test_nrr [-b seconds before the gap] [-g gap seconds]
+ *                               [-w window]
+ *
+ *          Exits with EXIT_FAILURE if any scenario fails.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gptp_def.h"
+#include "gptp_nrr.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Default time of the responses before the gap [s], 0.36 s of drift at 50 ppm. */
+#define GPTP_TEST_NRR_BEFORE_S_DEF      (7200u)
+/*! Default gap in the responses [s], longer than the window span (~68.7 s). */
+#define GPTP_TEST_NRR_GAP_S_DEF         (80u)
+/*! Default count of samples in the window. */
+#define GPTP_TEST_NRR_WINDOW_DEF        (8u)
+/*! Responses fed after the gap. */
+#define GPTP_TEST_NRR_RESPONSES         (20u)
+/*! Count of responses the ratio needs to be valid. */
+#define GPTP_TEST_NRR_MIN_SAMPLES       (3u)
+/*! Maximal error of the estimated rate ratio. */
+#define GPTP_TEST_NRR_MAX_ERR           (1.0e-9)
+/*! Local time of the first response [ns]. */
+#define GPTP_TEST_NRR_START_NS          (1000000000000ull)
+#define GPTP_TEST_NRR_NS_IN_S           (1000000000ull)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Neighbor clock relative to the local clock.
+ */
+typedef struct
+{
+    /*! Neighbor minus local time at GPTP_TEST_NRR_START_NS [ns]. */
+    long double                         f80OffsetNs;
+    /*! Neighbor rate ratio, offset from 1 [ppb]. */
+    long double                         f80RatePpb;
+}gptp_test_nrr_clock_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static uint64_t GPTP_TEST_NRR_NeighborNs(const gptp_test_nrr_clock_t *cprClock,
+                                         uint64_t u64LocalNs);
+static bool GPTP_TEST_NRR_Feed(gptp_def_nrr_lsq_t *prLsq,
+                               uint8_t u8Window,
+                               const gptp_test_nrr_clock_t *cprClock,
+                               uint64_t *pu64LocalNs,
+                               uint32_t u32Responses);
+static bool GPTP_TEST_NRR_Scenario(const char *cpcName,
+                                   uint8_t u8Window,
+                                   uint32_t u32BeforeS,
+                                   uint32_t u32GapS,
+                                   const gptp_test_nrr_clock_t *cprBefore,
+                                   const gptp_test_nrr_clock_t *cprAfter);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function returns the neighbor time of a local time.
+ * @param[in]       cprClock Pointer to the neighbor clock.
+ * @param[in]       u64LocalNs Local time [ns].
+ * @return          Neighbor time [ns].
+*/
+static uint64_t GPTP_TEST_NRR_NeighborNs(const gptp_test_nrr_clock_t *cprClock,
+                                         uint64_t u64LocalNs)
+{
+    long double f80ElapsedNs;
+
+    f80ElapsedNs = (long double)(u64LocalNs - GPTP_TEST_NRR_START_NS);
+
+    return (uint64_t)((long double)u64LocalNs + cprClock->f80OffsetNs +
+                      ((f80ElapsedNs * cprClock->f80RatePpb) * 1.0e-9L));
+}
+
+/*!
+ * @brief           This function feeds one response per second to the estimator.
+ * @details         Every response has to be accepted and the ratio valid
+ *                  from GPTP_TEST_NRR_MIN_SAMPLES responses on.
+ * @param[in,out]   prLsq Pointer to the estimator.
+ * @param[in]       u8Window Count of samples in the window.
+ * @param[in]       cprClock Pointer to the neighbor clock.
+ * @param[in,out]   pu64LocalNs Local time of the next response [ns].
+ * @param[in]       u32Responses Count of the responses.
+ * @return          true if the responses were processed as expected and
+ *                  the final ratio matches the neighbor.
+*/
+static bool GPTP_TEST_NRR_Feed(gptp_def_nrr_lsq_t *prLsq,
+                               uint8_t u8Window,
+                               const gptp_test_nrr_clock_t *cprClock,
+                               uint64_t *pu64LocalNs,
+                               uint32_t u32Responses)
+{
+    gptp_err_type_t eErr;
+    float64_t       f64Expected;
+    bool            bPassed;
+    uint32_t        u32Resp;
+
+    bPassed = true;
+    f64Expected = 1.0 + (float64_t)(cprClock->f80RatePpb * 1.0e-9L);
+
+    for (u32Resp = 0u; u32Resp < u32Responses; u32Resp++)
+    {
+        eErr = GPTP_NRR_Update(prLsq, u8Window, *pu64LocalNs,
+                               GPTP_TEST_NRR_NeighborNs(cprClock, *pu64LocalNs));
+        *pu64LocalNs += GPTP_TEST_NRR_NS_IN_S;
+
+        if (GPTP_ERR_OK != eErr)
+        {
+            printf("  response %u rejected\n", u32Resp);
+            bPassed = false;
+        }
+        if (((u32Resp + 1u) >= GPTP_TEST_NRR_MIN_SAMPLES) && (false == prLsq->bRatioValid))
+        {
+            printf("  response %u ratio not valid\n", u32Resp);
+            bPassed = false;
+        }
+    }
+
+    printf("  ratio %.12f expected %.12f\n", prLsq->f64RateRatio, f64Expected);
+    if ((false == prLsq->bRatioValid) ||
+        (GPTP_TEST_NRR_MAX_ERR < ((prLsq->f64RateRatio > f64Expected) ? (prLsq->f64RateRatio - f64Expected) :
+                                                                          (f64Expected - prLsq->f64RateRatio))))
+    {
+        bPassed = false;
+    }
+
+    return bPassed;
+}
+
+/*!
+ * @brief           This function runs one scenario.
+ * @param[in]       cpcName Name of the scenario.
+ * @param[in]       u8Window Count of samples in the window.
+ * @param[in]       u32BeforeS Time of the responses before the gap [s].
+ * @param[in]       u32GapS Gap in the responses [s].
+ * @param[in]       cprBefore Pointer to the neighbor clock before the gap.
+ * @param[in]       cprAfter Pointer to the neighbor clock after the gap.
+ * @return          true if the scenario passed.
+*/
+static bool GPTP_TEST_NRR_Scenario(const char *cpcName,
+                                   uint8_t u8Window,
+                                   uint32_t u32BeforeS,
+                                   uint32_t u32GapS,
+                                   const gptp_test_nrr_clock_t *cprBefore,
+                                   const gptp_test_nrr_clock_t *cprAfter)
+{
+    gptp_def_nrr_lsq_t rLsq;
+    uint64_t           u64LocalNs;
+    bool               bPassed;
+
+    printf("%s, gap %u s after %u s\n", cpcName, u32GapS, u32BeforeS);
+
+    memset(&rLsq, 0, sizeof(rLsq));
+    GPTP_NRR_Reset(&rLsq);
+    u64LocalNs = GPTP_TEST_NRR_START_NS;
+
+    bPassed = GPTP_TEST_NRR_Feed(&rLsq, u8Window, cprBefore, &u64LocalNs, u32BeforeS);
+
+    /* No responses during the gap, the window drains with the next one */
+    u64LocalNs += (uint64_t)u32GapS * GPTP_TEST_NRR_NS_IN_S;
+    if (false == GPTP_TEST_NRR_Feed(&rLsq, u8Window, cprAfter, &u64LocalNs, GPTP_TEST_NRR_RESPONSES))
+    {
+        bPassed = false;
+    }
+
+    printf("  %s\n", bPassed ? "pass" : "FAIL");
+
+    return bPassed;
+}
+
+int main(int argc, char *argv[])
+{
+    const gptp_test_nrr_clock_t crBase = {1500.0L, 50000.0L};
+    const gptp_test_nrr_clock_t crStepped = {-400000000.0L, 50000.0L};
+    const gptp_test_nrr_clock_t crRate = {1500.0L, -30000.0L};
+    const gptp_test_nrr_clock_t crBoth = {250000000.0L, -80000.0L};
+    uint32_t u32BeforeS;
+    uint32_t u32GapS;
+    uint32_t u32Failed;
+    uint8_t  u8Window;
+    int      sOpt;
+
+    u32BeforeS = GPTP_TEST_NRR_BEFORE_S_DEF;
+    u32GapS = GPTP_TEST_NRR_GAP_S_DEF;
+    u8Window = GPTP_TEST_NRR_WINDOW_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "b:g:w:")))
+    {
+        switch (sOpt)
+        {
+            case 'b':
+                u32BeforeS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'g':
+                u32GapS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'w':
+                u8Window = (uint8_t)strtoul(optarg, NULL, 0);
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-b seconds before the gap] [-g gap seconds] [-w window]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    u32Failed = 0u;
+    if (false == GPTP_TEST_NRR_Scenario("neighbor unchanged", u8Window, u32BeforeS, u32GapS, &crBase, &crBase))
+    {
+        u32Failed++;
+    }
+    if (false == GPTP_TEST_NRR_Scenario("neighbor stepped", u8Window, u32BeforeS, u32GapS, &crBase, &crStepped))
+    {
+        u32Failed++;
+    }
+    if (false == GPTP_TEST_NRR_Scenario("neighbor rate changed", u8Window, u32BeforeS, u32GapS, &crBase, &crRate))
+    {
+        u32Failed++;
+    }
+    if (false == GPTP_TEST_NRR_Scenario("neighbor stepped and rate changed", u8Window, u32BeforeS, u32GapS, &crBase, &crBoth))
+    {
+        u32Failed++;
+    }
+
+    printf("%u scenario(s) failed\n", u32Failed);
+
+    return (0u == u32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,444 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be
+ * used strictly in accordance with the applicable license terms. By expressly
+ * accepting such terms or by downloading, installing, activating and/or otherwise
+ * using the software, you are agreeing that you have read, and that you agree to
+ * comply with and are bound by, such license terms.  If you do not agree to be
+ * bound by the applicable license terms, then you may not retain, install,
+ * activate or otherwise use the software.
+ */
+
+/**
+ * @file gptp_test_replay.c
+ *
+ * @details Host test of the trace capture and the deterministic replay
+ *          (gptp_trace.h, gptp_port_replay.h) on the simulated network
+ *          (gptp_port_simnet.h). A GM and a slave are connected by one link,
+ *          the slave starts with the given offset to the GM. The run of one
+ *          node is traced, then the trace is replayed into a fresh instance
+ *          of the same configuration. The local clock is not part of the
+ *          trace, the node of the replayed instance gets the oscillator of
+ *          the traced one, which therefore has no random wander.
+ *
+ *          The outputs of the traced instance are sampled at every call of
+ *          GPTP_TimerPeriodic, both during the run and during the replay:
+ *          the estimated GM offset, the clock frequency adjustment, the
+ *          synchronized flag, the filtered Pdelay and neighbor rate ratio
+ *          and the count of the logged errors. Every scenario fails when the
+ *          replayed samples differ from the recorded ones in any bit, when
+ *          their counts differ or when an egress timestamp of the trace was
+ *          not matched to a frame transmitted by the replayed instance.
+ *
+ *          Build:
+ *
+ *          gcc -std=gnu99 -O2 -DGPTP_TRACE_CAPTURE -Igptp_stack/port/linux
+ *              -Igptp_stack/port -Igptp_stack/gptp_core/include
+ *              gptp_stack/gptp_core/src/(*).c gptp_stack/port/common/gptp_port.c
+ *              gptp_stack/port/linux/(*).c gptp_stack/test/gptp_test_node.c
+ *              gptp_stack/test/gptp_test_replay.c -o gptp_test_replay -lm
+ *
+ *          Usage: gptp_test_replay [-o initial offset ns] [-t seconds]
+ *
+ *          Exits with EXIT_FAILURE if any scenario fails.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gptp.h"
+#include "gptp_def.h"
+#include "gptp_trace.h"
+#include "gptp_port_platform.h"
+#include "gptp_port_replay.h"
+#include "gptp_port_simnet.h"
+#include "gptp_test_node.h"
+
+#ifndef GPTP_TRACE_CAPTURE
+#error "gptp_test_replay needs the GPTP_TRACE_CAPTURE build"
+#endif /* GPTP_TRACE_CAPTURE */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Nodes of the test, the GM and the slave. */
+#define GPTP_TEST_REPLAY_NODES          (2u)
+/*! Clock identity base of the nodes. */
+#define GPTP_TEST_REPLAY_CLOCK_ID       (0x020000FFFE030000u)
+/*! Default initial offset of the slave to the GM [ns]. */
+#define GPTP_TEST_REPLAY_OFFSET_NS_DEF  (300000000)
+/*! Default run time [s]. */
+#define GPTP_TEST_REPLAY_TIME_S_DEF     (30u)
+/*! Capacity of the trace stream [bytes]. */
+#define GPTP_TEST_REPLAY_TRACE_MAX      (16u * 1024u * 1024u)
+/*! Capacity of the recorded samples, one per call of GPTP_TimerPeriodic. */
+#define GPTP_TEST_REPLAY_SAMPLES_MAX    (400000u)
+#define GPTP_TEST_REPLAY_NS_IN_S        (1000000000u)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+
+/*!
+ * @brief Outputs of the traced instance at the call of GPTP_TimerPeriodic.
+ */
+typedef struct
+{
+    gptp_def_timestamp_sig_t            rEstimGmOffset;
+    float64_t                           f64NeighborPropDelay;
+    float64_t                           f64NeighborRateRatio;
+    int32_t                             s32ClockAdjPpb;
+    uint16_t                            u16ErrCount;
+    bool                                bSynced;
+}gptp_test_replay_sample_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void GPTP_TEST_REPLAY_Sample(gptp_test_replay_sample_t *prSample);
+static bool GPTP_TEST_REPLAY_SampleEqual(const gptp_test_replay_sample_t *cprA,
+                                         const gptp_test_replay_sample_t *cprB);
+static void GPTP_TEST_REPLAY_RecordWrite(const uint8_t *cpu8Data,
+                                         uint16_t u16Length);
+static void GPTP_TEST_REPLAY_ReplayWrite(const uint8_t *cpu8Data,
+                                         uint16_t u16Length);
+static bool GPTP_TEST_REPLAY_Replay(uint8_t u8Traced,
+                                    const gptp_port_simnet_osc_t *cprOsc);
+static bool GPTP_TEST_REPLAY_Scenario(uint8_t u8Traced,
+                                      int64_t s64OffsetNs,
+                                      uint32_t u32TimeS);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static gptp_test_node_t                 sarNodes[GPTP_TEST_REPLAY_NODES];
+/* Node of the replayed instance, not part of the simulated network */
+static gptp_test_node_t                 srReplayNode;
+
+/* Trace stream of the run */
+static uint8_t                          sau8Trace[GPTP_TEST_REPLAY_TRACE_MAX];
+static uint32_t                         su32TraceLength;
+static bool                             sbTraceOverflow;
+
+/* Instance being sampled by the trace writers */
+static gptp_def_data_t                  *sprSampled;
+/* Samples of the run and the progress of their comparison by the replay */
+static gptp_test_replay_sample_t        sarSamples[GPTP_TEST_REPLAY_SAMPLES_MAX];
+static uint32_t                         su32SampleCount;
+static uint32_t                         su32Compared;
+static uint32_t                         su32Mismatches;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * @brief           This function samples the outputs of the sampled instance.
+ * @param[out]      prSample Pointer to the sample.
+*/
+static void GPTP_TEST_REPLAY_Sample(gptp_test_replay_sample_t *prSample)
+{
+    prSample->rEstimGmOffset = sprSampled->rPerDeviceParams.rEstimGmOffset;
+    prSample->f64NeighborPropDelay = sprSampled->prPdelayMachines[0u].f64NeighborPropDelay;
+    prSample->f64NeighborRateRatio = sprSampled->prPdelayMachines[0u].f64NeighborRateRatio;
+    prSample->s32ClockAdjPpb = sprSampled->rPerDeviceParams.s32ClockAdjPpb;
+    prSample->u16ErrCount = GPTP_ErrLogCountGetInst(sprSampled);
+    prSample->bSynced = sprSampled->rPerDeviceParams.bSynced;
+}
+
+/*!
+ * @brief           This function compares two samples bit by bit.
+ * @param[in]       cprA Pointer to the first sample.
+ * @param[in]       cprB Pointer to the second sample.
+ * @return          true if the samples are equal.
+*/
+static bool GPTP_TEST_REPLAY_SampleEqual(const gptp_test_replay_sample_t *cprA,
+                                         const gptp_test_replay_sample_t *cprB)
+{
+    return (cprA->rEstimGmOffset.s64TimeStampS == cprB->rEstimGmOffset.s64TimeStampS) &&
+           (cprA->rEstimGmOffset.s32TimeStampNs == cprB->rEstimGmOffset.s32TimeStampNs) &&
+           (0 == memcmp(&cprA->f64NeighborPropDelay, &cprB->f64NeighborPropDelay, sizeof(float64_t))) &&
+           (0 == memcmp(&cprA->f64NeighborRateRatio, &cprB->f64NeighborRateRatio, sizeof(float64_t))) &&
+           (cprA->s32ClockAdjPpb == cprB->s32ClockAdjPpb) &&
+           (cprA->u16ErrCount == cprB->u16ErrCount) &&
+           (cprA->bSynced == cprB->bSynced);
+}
+
+/*!
+ * @brief           Trace writer of the run, stores the stream and samples
+ *                  the traced instance at every tick record.
+ * @param[in]       cpu8Data Pointer to the record.
+ * @param[in]       u16Length Length of the record.
+*/
+static void GPTP_TEST_REPLAY_RecordWrite(const uint8_t *cpu8Data,
+                                         uint16_t u16Length)
+{
+    if ((su32TraceLength + u16Length) > GPTP_TEST_REPLAY_TRACE_MAX)
+    {
+        sbTraceOverflow = true;
+    }
+    else
+    {
+        memcpy(&sau8Trace[su32TraceLength], cpu8Data, u16Length);
+        su32TraceLength += u16Length;
+    }
+
+    /* The stream header is shorter than any record */
+    if ((u16Length >= GPTP_DEF_TRACE_REC_LEN) && ((uint8_t)GPTP_DEF_TRACE_REC_TICK == cpu8Data[0u]))
+    {
+        if (su32SampleCount < GPTP_TEST_REPLAY_SAMPLES_MAX)
+        {
+            GPTP_TEST_REPLAY_Sample(&sarSamples[su32SampleCount]);
+            su32SampleCount++;
+        }
+        else
+        {
+            sbTraceOverflow = true;
+        }
+    }
+}
+
+/*!
+ * @brief           Trace writer of the replay, compares the replayed
+ *                  instance with the recorded samples at every tick record.
+ * @param[in]       cpu8Data Pointer to the record.
+ * @param[in]       u16Length Length of the record.
+*/
+static void GPTP_TEST_REPLAY_ReplayWrite(const uint8_t *cpu8Data,
+                                         uint16_t u16Length)
+{
+    gptp_test_replay_sample_t rSample;
+
+    if ((u16Length >= GPTP_DEF_TRACE_REC_LEN) && ((uint8_t)GPTP_DEF_TRACE_REC_TICK == cpu8Data[0u]))
+    {
+        GPTP_TEST_REPLAY_Sample(&rSample);
+        if ((su32Compared >= su32SampleCount) ||
+            (false == GPTP_TEST_REPLAY_SampleEqual(&rSample, &sarSamples[su32Compared])))
+        {
+            if (0u == su32Mismatches)
+            {
+                printf("  first mismatch at tick %u\n", su32Compared);
+            }
+            su32Mismatches++;
+        }
+        su32Compared++;
+    }
+}
+
+/*!
+ * @brief           This function replays the trace of the run into a fresh
+ *                  instance and compares its outputs with the recorded ones.
+ * @param[in]       u8Traced Index of the traced node.
+ * @param[in]       cprOsc Pointer to the oscillator of the traced node.
+ * @return          true if the replay reproduced the run.
+*/
+static bool GPTP_TEST_REPLAY_Replay(uint8_t u8Traced,
+                                    const gptp_port_simnet_osc_t *cprOsc)
+{
+    gptp_port_replay_t   rReplay;
+    gptp_port_sim_node_t *prPrevious;
+    gptp_port_sim_node_t *prSim;
+    bool                 bPassed;
+    uint8_t              u8Ctrl;
+
+    bPassed = true;
+    GPTP_TEST_NODE_Setup(&srReplayNode, GPTP_TEST_REPLAY_CLOCK_ID + u8Traced, 1u,
+                         (0u == u8Traced), GPTP_DEF_SERVO_PI);
+    prSim = &srReplayNode.rNet.rSim;
+    srReplayNode.rInit.pvPortCtx = prSim;
+
+    /* Same clock and addresses as the traced node, the NVM content is the initial one of both */
+    prPrevious = GPTP_PORT_SimNodeSelect(prSim);
+    GPTP_PORT_SimInit();
+    GPTP_PORT_SimClockDriftSet(cprOsc->s32FreqOffsetPpb);
+    GPTP_PORT_SimClockCorrect(cprOsc->s64InitOffsetNs, 0);
+    for (u8Ctrl = 0u; u8Ctrl < GPTP_PORT_SIM_CTRL_MAX; u8Ctrl++)
+    {
+        GPTP_PORT_SimMacSet(u8Ctrl, sarNodes[u8Traced].rNet.rSim.au64Mac[u8Ctrl]);
+    }
+
+    if (GPTP_ERR_OK != GPTP_PORT_ReplayOpen(&rReplay, sau8Trace, su32TraceLength))
+    {
+        printf("  trace not accepted\n");
+        bPassed = false;
+    }
+    else
+    {
+        /* The replayed instance is traced only to sample it at its ticks */
+        sprSampled = &srReplayNode.rNet.rGptp;
+        su32Compared = 0u;
+        su32Mismatches = 0u;
+        GPTP_TRACE_Start(sprSampled, GPTP_TEST_REPLAY_ReplayWrite);
+
+        if (GPTP_ERR_OK != GPTP_GptpInitInst(sprSampled, &srReplayNode.rInit))
+        {
+            printf("  replayed instance not initialized\n");
+            bPassed = false;
+        }
+        else
+        {
+            (void)GPTP_PORT_ReplayRun(&rReplay, sprSampled, 0u);
+        }
+        GPTP_TRACE_Stop();
+
+        printf("  replay rx=%u tx=%u ticks=%u unmatched=%u mismatches=%u\n",
+               rReplay.rStats.u32Rx, rReplay.rStats.u32Tx, rReplay.rStats.u32Ticks,
+               rReplay.rStats.u32Unmatched, su32Mismatches);
+
+        if ((0u == rReplay.rStats.u32Rx) || (0u == rReplay.rStats.u32Tx) ||
+            (0u != rReplay.rStats.u32Unmatched) || (0u != su32Mismatches) ||
+            (su32Compared != su32SampleCount))
+        {
+            bPassed = false;
+        }
+    }
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+
+    return bPassed;
+}
+
+/*!
+ * @brief           This function runs one scenario.
+ * @param[in]       u8Traced Index of the traced node.
+ * @param[in]       s64OffsetNs Initial offset of the slave to the GM [ns].
+ * @param[in]       u32TimeS Run time [s].
+ * @return          true if the scenario passed.
+*/
+static bool GPTP_TEST_REPLAY_Scenario(uint8_t u8Traced,
+                                      int64_t s64OffsetNs,
+                                      uint32_t u32TimeS)
+{
+    gptp_port_simnet_osc_t  arOsc[GPTP_TEST_REPLAY_NODES];
+    gptp_port_simnet_link_t rLink;
+    gptp_port_sim_node_t    *prPrevious;
+    bool                    bPassed;
+    uint8_t                 u8Node;
+
+    printf("traced %s, initial offset %lld ns\n", (0u == u8Traced) ? "GM" : "slave", (long long)s64OffsetNs);
+
+    bPassed = true;
+    su32TraceLength = 0u;
+    sbTraceOverflow = false;
+    su32SampleCount = 0u;
+    GPTP_PORT_SimNetInit(NULL);
+
+    for (u8Node = 0u; u8Node < GPTP_TEST_REPLAY_NODES; u8Node++)
+    {
+        GPTP_TEST_NODE_Setup(&sarNodes[u8Node], GPTP_TEST_REPLAY_CLOCK_ID + u8Node, 1u,
+                             (0u == u8Node), GPTP_DEF_SERVO_PI);
+    }
+
+    /* The capture starts before the initialization, at the time the node joins */
+    sprSampled = &sarNodes[u8Traced].rNet.rGptp;
+    prPrevious = GPTP_PORT_SimNodeSelect(&sarNodes[u8Traced].rNet.rSim);
+    GPTP_PORT_SimInit();
+    GPTP_TRACE_Start(sprSampled, GPTP_TEST_REPLAY_RecordWrite);
+    (void)GPTP_PORT_SimNodeSelect(prPrevious);
+
+    for (u8Node = 0u; u8Node < GPTP_TEST_REPLAY_NODES; u8Node++)
+    {
+        arOsc[u8Node].s32FreqOffsetPpb = (0u == u8Node) ? 0 : 20000;
+        arOsc[u8Node].f64WanderPpb = 0.0;
+        arOsc[u8Node].s64InitOffsetNs = (0u == u8Node) ? 0 : s64OffsetNs;
+        if (GPTP_ERR_OK != GPTP_PORT_SimNetNodeAdd(&sarNodes[u8Node].rNet, &arOsc[u8Node], &sarNodes[u8Node].rInit, NULL))
+        {
+            bPassed = false;
+        }
+    }
+
+    memset(&rLink, 0, sizeof(rLink));
+    rLink.u8NodeA = 0u;
+    rLink.u8CtrlA = 0u;
+    rLink.u8NodeB = 1u;
+    rLink.u8CtrlB = 0u;
+    rLink.u32DelayNs = 500u;
+    rLink.u32JitterNs = 40u;
+    if ((false == bPassed) || (GPTP_ERR_OK != GPTP_PORT_SimNetLinkAdd(&rLink)))
+    {
+        GPTP_TRACE_Stop();
+        printf("  setup failed\n");
+        return false;
+    }
+
+    GPTP_PORT_SimNetRun((uint64_t)u32TimeS * GPTP_TEST_REPLAY_NS_IN_S);
+    GPTP_TRACE_Stop();
+
+    printf("  recorded %u bytes, %u ticks\n", su32TraceLength, su32SampleCount);
+    if (true == sbTraceOverflow)
+    {
+        printf("  trace buffer overflow\n");
+        bPassed = false;
+    }
+    if (false == sarNodes[1u].rNet.rGptp.rPerDeviceParams.bSynced)
+    {
+        printf("  slave not synchronized\n");
+        bPassed = false;
+    }
+
+    if ((true == bPassed) && (false == GPTP_TEST_REPLAY_Replay(u8Traced, &arOsc[u8Traced])))
+    {
+        bPassed = false;
+    }
+
+    printf("  %s\n", bPassed ? "pass" : "FAIL");
+
+    return bPassed;
+}
+
+int main(int argc, char *argv[])
+{
+    int64_t  s64OffsetNs;
+    uint32_t u32TimeS;
+    uint32_t u32Failed;
+    uint8_t  u8Traced;
+    int      sOpt;
+
+    s64OffsetNs = GPTP_TEST_REPLAY_OFFSET_NS_DEF;
+    u32TimeS = GPTP_TEST_REPLAY_TIME_S_DEF;
+
+    while (-1 != (sOpt = getopt(argc, argv, "o:t:")))
+    {
+        switch (sOpt)
+        {
+            case 'o':
+                s64OffsetNs = (int64_t)strtoll(optarg, NULL, 0);
+            break;
+
+            case 't':
+                u32TimeS = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            default:
+                fprintf(stderr, "usage: %s [-o initial offset ns] [-t seconds]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    /* The slave replays the Sync reception, the GM the Sync transmission */
+    u32Failed = 0u;
+    for (u8Traced = GPTP_TEST_REPLAY_NODES; u8Traced > 0u; u8Traced--)
+    {
+        if (false == GPTP_TEST_REPLAY_Scenario(u8Traced - 1u, s64OffsetNs, u32TimeS))
+        {
+            u32Failed++;
+        }
+    }
+
+    printf("%u scenario(s) failed\n", u32Failed);
+
+    return (0u == u32Failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/